@@ -0,0 +1,284 @@
+/*--------------------------------------------------------------*/
+/* 								*/
+/*		update_soil_spinup					*/
+/*								*/
+/*								*/
+/*	NAME							*/
+/*	update_soil_spinup - moves the litter and soil carbon	*/
+/*		and nitrogen pools of each patch to the steady	*/
+/*		state of its last climate cycle			*/
+/*								*/
+/*	SYNOPSIS						*/
+/*	void accumulate_soil_spinup_pools(			*/
+/*			struct patch_object *)			*/
+/*	void accumulate_soil_spinup_fluxes(			*/
+/*			struct patch_object *)			*/
+/*	void update_soil_spinup(				*/
+/*			struct world_object *,			*/
+/*			struct command_line_object *,		*/
+/*			struct date)				*/
+/*								*/
+/*	OPTIONS							*/
+/*	-soilspinup <years> [<tolerance>]			*/
+/*								*/
+/*	DESCRIPTION						*/
+/*								*/
+/*	patch_daily_F calls accumulate_soil_spinup_pools before	*/
+/*	update_decomp and accumulate_soil_spinup_fluxes after	*/
+/*	the dissolved organic losses, summing for each of the	*/
+/*	eight pools (litr1c-litr4c, soil1c-soil4c) its size, its	*/
+/*	losses (respired, passed on, lost as DOC) and what it	*/
+/*	passes on to the next pool:				*/
+/*								*/
+/*		litr1c -> soil1c -> soil2c -> soil3c -> soil4c	*/
+/*		litr3c -> litr2c -> soil2c			*/
+/*		litr4c -> soil3c				*/
+/*								*/
+/*	update_soil_spinup is called by execute_tec each year	*/
+/*	end.  After a climate cycle (<years> whole calendar	*/
+/*	years; the run's first, partial year is not used) it	*/
+/*	gives each pool the mean decay rate r (losses over	*/
+/*	summed size), the fraction f of its losses passed on,	*/
+/*	and the mean input I from outside the cascade (litter	*/
+/*	fall, cwd decay, ...; its change plus its losses less	*/
+/*	what the pools above passed on).  With these the pools	*/
+/*	are linear and their steady state is found pool by	*/
+/*	pool down the cascade:					*/
+/*								*/
+/*		x = (I + sum of f r x of the pools above) / r	*/
+/*								*/
+/*	A patch whose litter and soil carbon changed by more	*/
+/*	than <tolerance> of its total over the cycle is set to	*/
+/*	that steady state; soil nitrogen follows at the fixed	*/
+/*	soil C:N, litter nitrogen at the litter's C:N.  Its	*/
+/*	next cycle is simulated as usual and checks the drift	*/
+/*	again: rates depend a little on the pools (N limitation) */
+/*	so a patch may be set again, each time closer.		*/
+/*								*/
+/*	PROGRAMMER NOTES					*/
+/*								*/
+/*	the cycle should be the length of the climate repeated	*/
+/*	with -climrepeat					*/
+/*	pools that hold no carbon or do not decay over the	*/
+/*	cycle are left as they are, passing on what they did	*/
+/*	mineral N and the patch N balance are not adjusted	*/
+/*	held patches (-vegspinupfreeze) are not simulated and	*/
+/*	are left as they are					*/
+/*--------------------------------------------------------------*/
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "rhessys.h"
+#include "phys_constants.h"
+
+#define L1 0
+#define L2 1
+#define L3 2
+#define L4 3
+#define S1 4
+#define S2 5
+#define S3 6
+#define S4 7
+
+/* pool each one passes carbon on to (-1 respired only) */
+static const int next_pool[NUM_SOIL_SPINUP_POOLS] = {S1, S2, L2, S3, S2, S3, S4, -1};
+/* down the cascade: each pool after those that feed it */
+static const int solve_order[NUM_SOIL_SPINUP_POOLS] = {L1, L3, L4, L2, S1, S2, S3, S4};
+
+static void get_pools(struct patch_object *patch, double *c)
+{
+	c[L1] = patch[0].litter_cs.litr1c;
+	c[L2] = patch[0].litter_cs.litr2c;
+	c[L3] = patch[0].litter_cs.litr3c;
+	c[L4] = patch[0].litter_cs.litr4c;
+	c[S1] = patch[0].soil_cs.soil1c;
+	c[S2] = patch[0].soil_cs.soil2c;
+	c[S3] = patch[0].soil_cs.soil3c;
+	c[S4] = patch[0].soil_cs.soil4c;
+}
+
+/*--------------------------------------------------------------*/
+/*	new litter N at the pool's C:N (a default for an empty pool) */
+/*--------------------------------------------------------------*/
+static double litter_n(double c_old, double n_old, double c_new, double cn)
+{
+	if ((c_old > ZERO) && (n_old > ZERO))
+		return(n_old * c_new / c_old);
+	return(c_new / cn);
+}
+
+static void set_pools(struct patch_object *patch, double *c)
+{
+	struct litter_c_object *cs_litr;
+	struct litter_n_object *ns_litr;
+
+	cs_litr = &(patch[0].litter_cs);
+	ns_litr = &(patch[0].litter_ns);
+	ns_litr->litr1n = litter_n(cs_litr->litr1c, ns_litr->litr1n, c[L1], LIVELAB_CN);
+	ns_litr->litr2n = litter_n(cs_litr->litr2c, ns_litr->litr2n, c[L2], CEL_CN);
+	ns_litr->litr3n = litter_n(cs_litr->litr3c, ns_litr->litr3n, c[L3], LIG_CN);
+	ns_litr->litr4n = litter_n(cs_litr->litr4c, ns_litr->litr4n, c[L4], LIG_CN);
+	cs_litr->litr1c = c[L1];
+	cs_litr->litr2c = c[L2];
+	cs_litr->litr3c = c[L3];
+	cs_litr->litr4c = c[L4];
+	patch[0].soil_cs.soil1c = c[S1];
+	patch[0].soil_cs.soil2c = c[S2];
+	patch[0].soil_cs.soil3c = c[S3];
+	patch[0].soil_cs.soil4c = c[S4];
+	patch[0].soil_ns.soil1n = c[S1] / SOIL1_CN;
+	patch[0].soil_ns.soil2n = c[S2] / SOIL2_CN;
+	patch[0].soil_ns.soil3n = c[S3] / SOIL3_CN;
+	patch[0].soil_ns.soil4n = c[S4] / SOIL4_CN;
+}
+
+void accumulate_soil_spinup_pools(struct patch_object *patch)
+{
+	struct soil_spinup_object *spinup;
+	double c[NUM_SOIL_SPINUP_POOLS];
+	int j;
+
+	spinup = &(patch[0].soil_spinup);
+	get_pools(patch, c);
+	if (spinup[0].days == 0.0)
+		memcpy(spinup[0].start_c, c, sizeof(c));
+	for (j=0; j<NUM_SOIL_SPINUP_POOLS; j++)
+		spinup[0].pool_c[j] += max(c[j], 0.0);
+	spinup[0].days += 1.0;
+}
+
+void accumulate_soil_spinup_fluxes(struct patch_object *patch)
+{
+	struct soil_spinup_object *spinup;
+	struct cdayflux_patch_struct *cdf;
+
+	spinup = &(patch[0].soil_spinup);
+	cdf = &(patch[0].cdf);
+	spinup[0].transfer_c[L1] += cdf->litr1c_to_soil1c;
+	spinup[0].transfer_c[L2] += cdf->litr2c_to_soil2c;
+	spinup[0].transfer_c[L3] += cdf->litr3c_to_litr2c;
+	spinup[0].transfer_c[L4] += cdf->litr4c_to_soil3c;
+	spinup[0].transfer_c[S1] += cdf->soil1c_to_soil2c;
+	spinup[0].transfer_c[S2] += cdf->soil2c_to_soil3c;
+	spinup[0].transfer_c[S3] += cdf->soil3c_to_soil4c;
+	spinup[0].loss_c[L1] += cdf->litr1c_hr + cdf->litr1c_to_soil1c + cdf->do_litr1c_loss;
+	spinup[0].loss_c[L2] += cdf->litr2c_hr + cdf->litr2c_to_soil2c + cdf->do_litr2c_loss;
+	spinup[0].loss_c[L3] += cdf->litr3c_hr + cdf->litr3c_to_litr2c + cdf->do_litr3c_loss;
+	spinup[0].loss_c[L4] += cdf->litr4c_hr + cdf->litr4c_to_soil3c + cdf->do_litr4c_loss;
+	spinup[0].loss_c[S1] += cdf->soil1c_hr + cdf->soil1c_to_soil2c + cdf->do_soil1c_loss;
+	spinup[0].loss_c[S2] += cdf->soil2c_hr + cdf->soil2c_to_soil3c + cdf->do_soil2c_loss;
+	spinup[0].loss_c[S3] += cdf->soil3c_hr + cdf->soil3c_to_soil4c + cdf->do_soil3c_loss;
+	spinup[0].loss_c[S4] += cdf->soil4c_hr + cdf->do_soil4c_loss;
+}
+
+/*--------------------------------------------------------------*/
+/*	steady state of the cycle's budget; returns the drift	*/
+/*--------------------------------------------------------------*/
+static double solve_soil_spinup(struct patch_object *patch, double *steady)
+{
+	struct soil_spinup_object *spinup;
+	double c[NUM_SOIL_SPINUP_POOLS], input[NUM_SOIL_SPINUP_POOLS];
+	double rate[NUM_SOIL_SPINUP_POOLS], passed[NUM_SOIL_SPINUP_POOLS];
+	double total_start, total_end, days;
+	int i, j, k;
+
+	spinup = &(patch[0].soil_spinup);
+	days = spinup[0].days;
+	get_pools(patch, c);
+
+	/*--------------------------------------------------------------*/
+	/*	input from outside the cascade: change + losses - passed in */
+	/*--------------------------------------------------------------*/
+	total_start = 0.0;
+	total_end = 0.0;
+	for (j=0; j<NUM_SOIL_SPINUP_POOLS; j++) {
+		input[j] = c[j] - spinup[0].start_c[j] + spinup[0].loss_c[j];
+		total_start += spinup[0].start_c[j];
+		total_end += c[j];
+	}
+	for (i=0; i<NUM_SOIL_SPINUP_POOLS; i++)
+		if (next_pool[i] >= 0)
+			input[next_pool[i]] -= spinup[0].transfer_c[i];
+
+	/*--------------------------------------------------------------*/
+	/*	down the cascade: x = (I + passed in) / r (per day)	*/
+	/*--------------------------------------------------------------*/
+	for (k=0; k<NUM_SOIL_SPINUP_POOLS; k++) {
+		j = solve_order[k];
+		input[j] = max(input[j], 0.0) / days;
+		for (i=0; i<NUM_SOIL_SPINUP_POOLS; i++)
+			if (next_pool[i] == j)
+				input[j] += passed[i];
+		if ((spinup[0].pool_c[j] > ZERO) && (spinup[0].loss_c[j] > ZERO)) {
+			rate[j] = spinup[0].loss_c[j] / spinup[0].pool_c[j];
+			steady[j] = input[j] / rate[j];
+			passed[j] = steady[j] * rate[j]
+				* spinup[0].transfer_c[j] / spinup[0].loss_c[j];
+		}
+		else {
+			steady[j] = c[j];
+			passed[j] = spinup[0].transfer_c[j] / days;
+		}
+	}
+
+	if (total_end <= ZERO)
+		return(0.0);
+	return(fabs(total_end - total_start) / total_end);
+}
+
+void update_soil_spinup(
+						struct world_object *world,
+						struct command_line_object *command_line,
+						struct date current_date)
+{
+	/*--------------------------------------------------------------*/
+	/*	Local variable definition.									*/
+	/*--------------------------------------------------------------*/
+	int	b, h, z, p;
+	int	num_patches, num_steady, num_set;
+	double	drift, max_drift;
+	double	steady[NUM_SOIL_SPINUP_POOLS];
+	struct	patch_object	*patch;
+	struct	soil_spinup_object	*spinup;
+
+	num_patches = 0;
+	num_steady = 0;
+	num_set = 0;
+	max_drift = 0.0;
+	for (b=0; b<world[0].num_basin_files; b++)
+	for (h=0; h<world[0].basins[b][0].num_hillslopes; h++)
+	for (z=0; z<world[0].basins[b][0].hillslopes[h][0].num_zones; z++)
+	for (p=0; p<world[0].basins[b][0].hillslopes[h][0].zones[z][0].num_patches; p++) {
+		patch = world[0].basins[b][0].hillslopes[h][0].zones[z][0].patches[p];
+		spinup = &(patch[0].soil_spinup);
+		/*--------------------------------------------------------------*/
+		/*	not simulated, or the run's first, partial year		*/
+		/*--------------------------------------------------------------*/
+		if ((spinup[0].days == 0.0) || (patch[0].frozen == 1)
+			|| ((spinup[0].years == 0) && (spinup[0].days < 365.0))) {
+			memset(spinup, 0, sizeof(struct soil_spinup_object));
+			continue;
+		}
+		spinup[0].years += 1;
+		if (spinup[0].years < command_line[0].soilspinup_years)
+			continue;
+
+		num_patches++;
+		drift = solve_soil_spinup(patch, steady);
+		max_drift = max(max_drift, drift);
+		if (drift <= command_line[0].soilspinup_tolerance)
+			num_steady++;
+		else {
+			set_pools(patch, steady);
+			num_set++;
+		}
+		memset(spinup, 0, sizeof(struct soil_spinup_object));
+	}
+
+	if (num_patches > 0)
+		printf("\nSoil spinup YEAR %ld: %d of %d patches within %g drift (largest %g), %d set to steady state\n",
+			current_date.year, num_steady, num_patches,
+			command_line[0].soilspinup_tolerance, max_drift, num_set);
+	return;
+} /*end update_soil_spinup*/
@@ -64,6 +64,14 @@ void	basin_daily_F(
 		struct	command_line_object *, 
 		struct	tec_entry *,
 		struct	date );
+
+	void	reset_hillslope_queues(
+		struct hillslope_schedule_object *);
+
+	int	next_scheduled_hillslope(
+		struct hillslope_schedule_object *,
+		int,
+		double *);
 	/*--------------------------------------------------------------*/
 	/* this part has been moved to basin_hourly			*/
 	/*--------------------------------------------------------------*/
@@ -74,8 +82,8 @@ void	basin_daily_F(
 	
 	double	compute_stream_routing(
 		struct command_line_object *,
-		struct stream_network_object *,
-		int, struct	date);
+		struct stream_list_object *,
+		struct	date);
 
 	void	update_basin_patch_accumulator(
 		struct command_line_object *command_line,
@@ -85,6 +93,12 @@ void	basin_daily_F(
 	void	update_hillslope_accumulator(
 		struct command_line_object *command_line,
 		struct basin_object *basin);
+
+	void	update_objective(
+		struct basin_object *,
+		struct objective_object *,
+		struct command_line_object *,
+		struct date);
 	/*--------------------------------------------------------------*/
 	/*  Local variable definition.                                  */
 	/*--------------------------------------------------------------*/
@@ -106,15 +120,20 @@ void	basin_daily_F(
 	/*--------------------------------------------------------------*/
 	/*	Simulate the hillslopes in this basin for the whole day		*/
 	/*--------------------------------------------------------------*/
-    #pragma omp parallel for                                                     //160627LML schedule(dynamic) num_threads(4)
-    for (int h = 0 ; h < basin[0].num_hillslopes; h ++ ){
-		hillslope_daily_F(	day,
-			world,
-			basin,
-			basin[0].hillslopes[h],
-			command_line, 
-			event,
-			current_date );
+	reset_hillslope_queues(&(basin[0].schedule));
+    #pragma omp parallel
+    {
+		int h = -1;
+		double start;
+		while ((h = next_scheduled_hillslope(&(basin[0].schedule), h, &start)) >= 0) {
+			hillslope_daily_F(	day,
+				world,
+				basin,
+				basin[0].hillslopes[h],
+				command_line, 
+				event,
+				current_date );
+		}
     }
 
         hillslope = basin[0].hillslopes[0];
@@ -141,8 +160,7 @@ void	basin_daily_F(
 	/*--------------------------------------------------------------*/
     	if ( command_line[0].stream_routing_flag == 1) {
 		 basin[0].stream_list.streamflow=compute_stream_routing(command_line,
-			basin[0].stream_list.stream_network,
-			basin[0].stream_list.num_reaches,
+			&(basin[0].stream_list),
                         current_date);
 	}
 
@@ -159,5 +177,13 @@ void	basin_daily_F(
     update_hillslope_accumulator(command_line,
                     basin);
 
+	/*--------------------------------------------------------------*/
+	/* streamflow objective functions (-objective)			*/
+	/*--------------------------------------------------------------*/
+	if ((world[0].objective != NULL)
+		&& (basin[0].ID == world[0].objective[0].basin_ID))
+		update_objective(basin, world[0].objective, command_line,
+			current_date);
+
 	return;
 } /*end basin_daily_F*/
@@ -44,6 +44,7 @@
 /*--------------------------------------------------------------*/
 #include <stdio.h>
 #include <math.h>
+#include <omp.h>
 #include "rhessys.h"
 #include "phys_constants.h"
 
@@ -66,6 +67,14 @@ void		basin_daily_I(
 		struct	command_line_object *,
 		struct	tec_entry *,
 		struct	date );
+
+	void	update_hillslope_schedule(
+		struct hillslope_schedule_object *);
+
+	int	next_scheduled_hillslope(
+		struct hillslope_schedule_object *,
+		int,
+		double *);
 	
 	/*--------------------------------------------------------------*/
 	/*  Local variable definition.                                  */
@@ -99,17 +108,23 @@ void		basin_daily_I(
 	basin[0].theta_noon =  basin[0].latitude*DtoR - world[0].declin;
 	/*--------------------------------------------------------------*/
 	/*	Simulate the hillslopes in this basin for the whole day		*/
+	/*	hillslopes are split among threads on yesterday's cost	*/
 	/*--------------------------------------------------------------*/
-    #pragma omp parallel for
-    for (int hillslope = 0 ; hillslope < basin[0].num_hillslopes; hillslope ++ ){
-		hillslope_daily_I(
-			day,
-			world,
-			basin,
-			basin[0].hillslopes[hillslope],
-			command_line,
-			event,
-			current_date );
+	update_hillslope_schedule(&(basin[0].schedule));
+    #pragma omp parallel
+    {
+		int h = -1;
+		double start;
+		while ((h = next_scheduled_hillslope(&(basin[0].schedule), h, &start)) >= 0) {
+			hillslope_daily_I(
+				day,
+				world,
+				basin,
+				basin[0].hillslopes[h],
+				command_line,
+				event,
+				current_date );
+		}
 	}
 	return;
 } /*end basin_daily_I.c*/
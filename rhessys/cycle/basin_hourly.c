@@ -33,6 +33,8 @@
 /*--------------------------------------------------------------*/
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <omp.h>
 #include "rhessys.h"
 
 void	basin_hourly(
@@ -53,7 +55,14 @@ void	basin_hourly(
 		struct tec_entry *,
 		struct date);
 	
-	void	*alloc(	size_t, char *, char *);
+
+	void	reset_hillslope_queues(
+		struct hillslope_schedule_object *);
+
+	int	next_scheduled_hillslope(
+		struct hillslope_schedule_object *,
+		int,
+		double *);
 
 	void    compute_subsurface_routing_hourly(
 		struct command_line_object *command_line,
@@ -78,8 +87,10 @@ void	basin_hourly(
 	hillslope_p = basin[0].hillslopes[0];
 	zone_p = hillslope_p[0].zones[0];
 	
-	basin[0].hourly = (struct basin_hourly_object * ) alloc(
-		sizeof( struct basin_hourly_object),"hourly","basin_hourly");
+	/*--------------------------------------------------------------*/
+	/*	Reset the basin hourly object (allocated in construct_basin)*/
+	/*--------------------------------------------------------------*/
+	memset(basin[0].hourly, 0, sizeof(struct basin_hourly_object));
 	/*--------------------------------------------------------------*/
 	/*	Compute basin hourly forcings.								*/
 	/*--------------------------------------------------------------*/
@@ -161,24 +172,24 @@ void	basin_hourly(
 	/*	Note that solar geometry except for cos_sza may be garbage	*/
 	/*	if cos_sza < 0 (no daylight).								*/
 	/*--------------------------------------------------------------*/
-    #pragma omp parallel for
-    for (int hillslope=0 ; hillslope < basin[0].num_hillslopes ;hillslope++ ){
-		hillslope_hourly(
-			world,
-			basin,
-			basin[0].hillslopes[hillslope],
-			command_line,
-			event,
-			current_date);
+	reset_hillslope_queues(&(basin[0].schedule));
+    #pragma omp parallel
+    {
+		int h = -1;
+		double start;
+		while ((h = next_scheduled_hillslope(&(basin[0].schedule), h, &start)) >= 0) {
+			hillslope_hourly(
+				world,
+				basin,
+				basin[0].hillslopes[h],
+				command_line,
+				event,
+				current_date);
+		}
 	}
 	
 
 
-	
-	/*--------------------------------------------------------------*/
-	/*	Destroy the basin hourly parameter arrayu.					*/
-	/*--------------------------------------------------------------*/
-	free( basin[0].hourly );
 
 	/*--------------------------------------------------------------*/
 	/*	do subsurface routing					*/
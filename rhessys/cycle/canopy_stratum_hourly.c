@@ -30,8 +30,10 @@
 /*	PROGRAMMER NOTES											*/
 /*																*/
 /*																*/
-/*																*/
+/*	the hourly object is allocated with the stratum and only	*/
+/*	reset here													*/
 /*--------------------------------------------------------------*/
+#include <string.h>
 #include "rhessys.h"
 void	canopy_stratum_hourly(
 							  struct world_object *world,
@@ -47,7 +49,6 @@ void	canopy_stratum_hourly(
 	/*--------------------------------------------------------------*/
 	/*	Local Function Declaration				*/
 	/*--------------------------------------------------------------*/
-	void	*alloc(	size_t, char *, char *);
 
 	double compute_hourly_rain_stored(
 		int,
@@ -66,11 +67,9 @@ void	canopy_stratum_hourly(
 	NO3_throughfall=0;
 
 	/*--------------------------------------------------------------*/
-	/*	Create canopy stratum hourly object.						*/
+	/*	Reset canopy stratum hourly object.							*/
 	/*--------------------------------------------------------------*/
-	stratum[0].hourly = (struct canopy_strata_hourly_object*)
-		alloc(1 * sizeof(struct canopy_strata_hourly_object),
-		"hourly","canopy_stratum_hourly");
+	memset(stratum[0].hourly, 0, sizeof(struct canopy_strata_hourly_object));
 	rain_throughfall = patch[0].hourly[0].rain_throughfall;
 	if ((zone[0].hourly_rain_flag == 1) && ( rain_throughfall > 0.0)) {
 		stratum[0].rain_stored = compute_hourly_rain_stored(
@@ -118,10 +117,5 @@ void	canopy_stratum_hourly(
 		* stratum[0].cover_fraction;
 	stratum[0].NO3_stored = NO3_stored;
 
-	
-	/*--------------------------------------------------------------*/
-	/*	Destroy the canopy stratum hourly object.					*/
-	/*--------------------------------------------------------------*/
-	free( stratum[0].hourly );
 	return;
 } /*end canopy_stratum_hourly.c*/
@@ -36,6 +36,7 @@
 /*--------------------------------------------------------------*/
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include "rhessys.h"
 
 void		hillslope_hourly(
@@ -67,13 +68,10 @@ void		hillslope_hourly(
 	struct patch_object *patch;
 	
 	/*--------------------------------------------------------------*/
-	/*	Allocate the hillslope houly parameter array.				*/
+	/*	Reset the hillslope hourly parameter array (allocated in	*/
+	/*	construct_hillslope).										*/
 	/*--------------------------------------------------------------*/
-	if ( (hillslope[0].hourly = (struct hillslope_hourly_object *)
-		calloc(1,sizeof(struct hillslope_hourly_object))) == NULL ){
-		fprintf(stderr,"FATAL ERROR: in hillslope_hourly\n");
-		exit(EXIT_FAILURE);
-	}
+	memset(hillslope[0].hourly, 0, sizeof(struct hillslope_hourly_object));
 	/*--------------------------------------------------------------*/
 	/* do redistribution of saturated zone at patch level based on 	*/
 	/* previous time steps hillslope level soilwater 				*/
@@ -101,10 +99,6 @@ void		hillslope_hourly(
 			event,
 			current_date );
 	}
-	/*--------------------------------------------------------------*/
-	/*	Destroy the hillslope hourloy object.						*/
-	/*--------------------------------------------------------------*/
-	free( hillslope[0].hourly );
 	/*----------------------------------------------------------------------*/
 	/*	compute groundwater losses					*/
 	/*	this part is transplanted from hillslope_daily_F.c	    	*/
@@ -246,6 +246,9 @@ void		patch_daily_F(
 		struct cdayflux_patch_struct *,
 		struct ndayflux_patch_struct *,
 		struct patch_object *);
+
+	void	accumulate_soil_spinup_pools(struct patch_object *);
+	void	accumulate_soil_spinup_fluxes(struct patch_object *);
 	
 	int	update_dissolved_organic_losses(
 		struct	date,
@@ -526,17 +529,14 @@ void		patch_daily_F(
 	/*	Set the patch rain and snow throughfall equivalent to the	*/
 	/*	rain and snow coming down over the zone.					*/
 	/* check to see if there are base station inputs 		*/
+	/*	(their cursors are moved to the current day in		*/
+	/*	world_daily_I, see advance_clim_events)			*/
 	/*--------------------------------------------------------------*/
 
 	if (patch[0].base_stations != NULL) {
 		inx = patch[0].base_stations[0][0].dated_input[0].irrigation.inx;
 		if (inx > -999) {
 			clim_event = patch[0].base_stations[0][0].dated_input[0].irrigation.seq[inx];
-			while (julday(clim_event.edate) < julday(current_date)) {
-				patch[0].base_stations[0][0].dated_input[0].irrigation.inx += 1;
-				inx = patch[0].base_stations[0][0].dated_input[0].irrigation.inx;
-				clim_event = patch[0].base_stations[0][0].dated_input[0].irrigation.seq[inx];
-				}
 			if ((clim_event.edate.year != 0) && ( julday(clim_event.edate) == julday(current_date)) ) {
 				irrigation = clim_event.value;
 				}
@@ -585,11 +585,6 @@ void		patch_daily_F(
 		inx = patch[0].base_stations[0][0].dated_input[0].snow_melt_input.inx;
 		if (inx > -999) {
 			clim_event = patch[0].base_stations[0][0].dated_input[0].snow_melt_input.seq[inx];
-			while (julday(clim_event.edate) < julday(current_date)) {
-				patch[0].base_stations[0][0].dated_input[0].snow_melt_input.inx += 1;
-				inx = patch[0].base_stations[0][0].dated_input[0].snow_melt_input.inx;
-				clim_event = patch[0].base_stations[0][0].dated_input[0].snow_melt_input.seq[inx];
-				}
 			if ((clim_event.edate.year != 0) && ( julday(clim_event.edate) == julday(current_date)) ) {
 				snow_melt_input = clim_event.value;
 				}
@@ -607,11 +602,6 @@ void		patch_daily_F(
 		inx = patch[0].base_stations[0][0].dated_input[0].biomass_removal_percent.inx;
 		if (inx > -999) {
 			clim_event = patch[0].base_stations[0][0].dated_input[0].biomass_removal_percent.seq[inx];
-			while (julday(clim_event.edate) < julday(current_date)) {
-				patch[0].base_stations[0][0].dated_input[0].biomass_removal_percent.inx += 1;
-				inx = patch[0].base_stations[0][0].dated_input[0].biomass_removal_percent.inx;
-				clim_event = patch[0].base_stations[0][0].dated_input[0].biomass_removal_percent.seq[inx];
-				}
 			if ((clim_event.edate.year != 0) && ( julday(clim_event.edate) == julday(current_date)) ) {
 					biomass_removal_percent = clim_event.value;
 					mort.mort_cpool=biomass_removal_percent;
@@ -1202,11 +1192,6 @@ void		patch_daily_F(
 		inx = patch[0].base_stations[0][0].dated_input[0].fertilizer_NO3.inx;
 		if (inx > -999) {
 			clim_event = patch[0].base_stations[0][0].dated_input[0].fertilizer_NO3.seq[inx];
-			while (julday(clim_event.edate) < julday(current_date)) {
-				patch[0].base_stations[0][0].dated_input[0].fertilizer_NO3.inx += 1;
-				inx = patch[0].base_stations[0][0].dated_input[0].fertilizer_NO3.inx;
-				clim_event = patch[0].base_stations[0][0].dated_input[0].fertilizer_NO3.seq[inx];
-				}
 			if ((clim_event.edate.year != 0) && ( julday(clim_event.edate) == julday(current_date)) ) {
 				fertilizer_NO3 = clim_event.value;
 				}
@@ -1220,11 +1205,6 @@ void		patch_daily_F(
 		inx = patch[0].base_stations[0][0].dated_input[0].fertilizer_NH4.inx;
 		if (inx > -999) {
 			clim_event = patch[0].base_stations[0][0].dated_input[0].fertilizer_NH4.seq[inx];
-			while (julday(clim_event.edate) < julday(current_date)) {
-				patch[0].base_stations[0][0].dated_input[0].fertilizer_NH4.inx += 1;
-				inx = patch[0].base_stations[0][0].dated_input[0].fertilizer_NH4.inx;
-				clim_event = patch[0].base_stations[0][0].dated_input[0].fertilizer_NH4.seq[inx];
-				}
 			if ((clim_event.edate.year != 0) && ( julday(clim_event.edate) == julday(current_date)) ) {
 				fertilizer_NH4 = clim_event.value;
 				}
@@ -1276,11 +1256,6 @@ void		patch_daily_F(
 		inx = patch[0].base_stations[0][0].dated_input[0].PH.inx;
 		if (inx > -999) {
 			clim_event = patch[0].base_stations[0][0].dated_input[0].PH.seq[inx];
-			while (julday(clim_event.edate) < julday(current_date)) {
-				patch[0].base_stations[0][0].dated_input[0].PH.inx += 1;
-				inx = patch[0].base_stations[0][0].dated_input[0].PH.inx;
-				clim_event = patch[0].base_stations[0][0].dated_input[0].PH.seq[inx];
-				}
 			if ((clim_event.edate.year != 0) && ( julday(clim_event.edate) == julday(current_date)) ) {
 				patch[0].PH = clim_event.value;
 				}
@@ -2017,6 +1992,9 @@ void		patch_daily_F(
 	/* 	and any septic losses							*/
 	/*------------------------------------------------------------------------*/
 	if ((command_line[0].grow_flag > 0) && (vegtype == 1)) {
+
+		if (command_line[0].soilspinup_flag == 1)
+			accumulate_soil_spinup_pools(patch);
 		
 		if ( update_decomp(
 			current_date,
@@ -2051,6 +2029,9 @@ void		patch_daily_F(
 				 patch[0].ndf.do_litr4n_loss);
 		}
 
+		if (command_line[0].soilspinup_flag == 1)
+			accumulate_soil_spinup_fluxes(patch);
+
 		if ( update_nitrif(
 			&(patch[0].soil_cs),
 			&(patch[0].soil_ns),
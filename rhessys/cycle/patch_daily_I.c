@@ -397,16 +397,12 @@ void		patch_daily_I(
 
 	/*-----------------------------------------------------*/
 	/* 	Check for any grazing activity from a land use default file			*/
+	/*	(the cursor is moved to the current day in world_daily_I)	*/
 	/*-----------------------------------------------------*/
 	if (patch[0].base_stations != NULL) {
 		inx = patch[0].base_stations[0][0].dated_input[0].grazing_Closs.inx;
 		if (inx > -999) {
 			clim_event = patch[0].base_stations[0][0].dated_input[0].grazing_Closs.seq[inx];
-			while (julday(clim_event.edate) < julday(current_date)) {
-				patch[0].base_stations[0][0].dated_input[0].grazing_Closs.inx += 1;
-				inx = patch[0].base_stations[0][0].dated_input[0].grazing_Closs.inx;
-				clim_event = patch[0].base_stations[0][0].dated_input[0].grazing_Closs.seq[inx];
-				}
 			if ((clim_event.edate.year != 0) && ( julday(clim_event.edate) == julday(current_date)) ) {
 				grazing_Closs = clim_event.value;
 				}
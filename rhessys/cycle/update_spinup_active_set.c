@@ -0,0 +1,172 @@
+/*--------------------------------------------------------------*/
+/* 																*/
+/*					update_spinup_active_set					*/
+/*																*/
+/*	NAME														*/
+/*	update_spinup_active_set - reports spinup progress and		*/
+/*		holds patches that have met their targets				*/
+/*																*/
+/*	SYNOPSIS													*/
+/*	void	update_spinup_active_set(							*/
+/*					struct world_object *world,					*/
+/*					struct command_line_object *command_line,	*/
+/*					struct date current_date)					*/
+/*	void	hold_frozen_patch(									*/
+/*					struct patch_object *patch,					*/
+/*					struct hillslope_object *hillslope,			*/
+/*					struct command_line_object *command_line)	*/
+/*																*/
+/*	OPTIONS														*/
+/*	-vegspinup <file>, -vegspinupfreeze							*/
+/*																*/
+/*	DESCRIPTION													*/
+/*																*/
+/*	update_spinup_active_set is called by execute_tec at the	*/
+/*	end of each year of a -vegspinup run and prints how many	*/
+/*	patches have met the targets of all their strata.			*/
+/*																*/
+/*	With -vegspinupfreeze those patches are also taken out of	*/
+/*	the simulation: a copy of the patch is kept and it is no	*/
+/*	longer cycled (patch_daily_I, patch_hourly, patch_daily_F	*/
+/*	and its strata).  Its neighbours still get water and		*/
+/*	nitrogen from it - each routing time step it sends the mean	*/
+/*	outflow of the year just simulated (update_drainage_frozen)	*/
+/*	and each day the mean drainage to the hillslope			*/
+/*	groundwater - and what is routed into it is dropped.  Only	*/
+/*	the patches still short of their targets are simulated in	*/
+/*	full, so the run ends sooner; the state written at the end	*/
+/*	holds the other patches as they were when they met theirs.	*/
+/*	The yearly line then also gives the water dropped that year	*/
+/*	(compute_subsurface_routing sums it in the basins), in mm	*/
+/*	over the area of all patches, so that a large loss shows.	*/
+/*																*/
+/*	hold_frozen_patch puts a held patch back to its copy, and	*/
+/*	when given its hillslope adds the day's groundwater			*/
+/*	drainage.  zone_daily_F calls it in place of patch_daily_F,	*/
+/*	compute_subsurface_routing after routing.					*/
+/*																*/
+/*	PROGRAMMER NOTES											*/
+/*																*/
+/*	stream and road patches, and patches of zones with hourly	*/
+/*	rain (routed hourly), are always simulated					*/
+/*	a patch is only held once a whole year has been recorded	*/
+/*	(not at the end of a run's first, partial year)				*/
+/*	boundary_flux holds sums until the patch is held, then		*/
+/*	means (per routing time step; per day for groundwater)		*/
+/*--------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "rhessys.h"
+
+/*--------------------------------------------------------------*/
+/*	turns the sums of the year into means and keeps the patch	*/
+/*--------------------------------------------------------------*/
+static void freeze_patch(struct patch_object *patch)
+{
+	void	*alloc(size_t, char *, char *);
+
+	struct	patch_boundary_flux_object	*flux;
+	double	steps, days;
+
+	flux = &(patch[0].boundary_flux);
+	steps = max(flux[0].steps, 1.0);
+	days = max(flux[0].days, 1.0);
+	flux[0].route_to_patch /= steps;
+	flux[0].NO3_to_patch /= steps;
+	flux[0].NH4_to_patch /= steps;
+	flux[0].DON_to_patch /= steps;
+	flux[0].DOC_to_patch /= steps;
+	flux[0].route_to_surface /= steps;
+	flux[0].NO3_to_surface /= steps;
+	flux[0].NH4_to_surface /= steps;
+	flux[0].DON_to_surface /= steps;
+	flux[0].DOC_to_surface /= steps;
+	flux[0].gw_drainage /= days;
+	flux[0].gw_NO3 /= days;
+	flux[0].gw_NH4 /= days;
+	flux[0].gw_DON /= days;
+	flux[0].gw_DOC /= days;
+
+	patch[0].frozen = 1;
+	patch[0].frozen_state = (struct patch_object *) alloc(sizeof(struct patch_object),
+		"frozen_state", "update_spinup_active_set");
+	memcpy(patch[0].frozen_state, patch, sizeof(struct patch_object));
+}
+
+void	hold_frozen_patch(
+						  struct patch_object *patch,
+						  struct hillslope_object *hillslope,
+						  struct command_line_object *command_line)
+{
+	struct	patch_boundary_flux_object	*flux;
+
+	memcpy(patch, patch[0].frozen_state, sizeof(struct patch_object));
+	if ((hillslope == NULL) || (command_line[0].gw_flag == 0))
+		return;
+	flux = &(patch[0].boundary_flux);
+	hillslope[0].gw.storage += (flux[0].gw_drainage * patch[0].area / hillslope[0].area);
+	hillslope[0].gw.NO3 += (flux[0].gw_NO3 * patch[0].area / hillslope[0].area);
+	hillslope[0].gw.NH4 += (flux[0].gw_NH4 * patch[0].area / hillslope[0].area);
+	hillslope[0].gw.DON += (flux[0].gw_DON * patch[0].area / hillslope[0].area);
+	hillslope[0].gw.DOC += (flux[0].gw_DOC * patch[0].area / hillslope[0].area);
+}
+
+void	update_spinup_active_set(
+								 struct world_object *world,
+								 struct command_line_object *command_line,
+								 struct date current_date)
+{
+	/*--------------------------------------------------------------*/
+	/*	Local variable definition.									*/
+	/*--------------------------------------------------------------*/
+	int	b, h, z, p;
+	int	num_patches, num_met, num_frozen;
+	double	area, dropped_inflow;
+	struct	zone_object	*zone;
+	struct	patch_object	*patch;
+
+	num_patches = 0;
+	num_met = 0;
+	num_frozen = 0;
+	area = 0.0;
+	dropped_inflow = 0.0;
+	for (b=0; b<world[0].num_basin_files; b++) {
+		dropped_inflow += world[0].basins[b][0].spinup_dropped_inflow;
+		world[0].basins[b][0].spinup_dropped_inflow = 0.0;
+	}
+	for (b=0; b<world[0].num_basin_files; b++)
+	for (h=0; h<world[0].basins[b][0].num_hillslopes; h++)
+	for (z=0; z<world[0].basins[b][0].hillslopes[h][0].num_zones; z++) {
+		zone = world[0].basins[b][0].hillslopes[h][0].zones[z];
+		for (p=0; p<zone[0].num_patches; p++) {
+			patch = zone[0].patches[p];
+			num_patches++;
+			area += patch[0].area;
+			if (patch[0].target_status == 1)
+				num_met++;
+			if (command_line[0].vegspinup_freeze_flag == 0)
+				continue;
+			if ((patch[0].frozen == 0) && (patch[0].target_status == 1)
+				&& (patch[0].boundary_flux.days >= 365.0)
+				&& (patch[0].drainage_type != STREAM)
+				&& (patch[0].drainage_type != ROAD)
+				&& (zone[0].hourly_rain_flag == 0))
+				freeze_patch(patch);
+			else if (patch[0].frozen == 0)
+				memset(&(patch[0].boundary_flux), 0,
+					sizeof(struct patch_boundary_flux_object));
+			if (patch[0].frozen == 1)
+				num_frozen++;
+		}
+	}
+
+	if (command_line[0].vegspinup_freeze_flag == 1)
+		printf("\nSpinup YEAR %ld: %d of %d patches at targets, %d held, %.3f mm routed into held patches dropped\n",
+			current_date.year, num_met, num_patches, num_frozen,
+			(area > 0.0) ? 1000.0 * dropped_inflow / area : 0.0);
+	else
+		printf("\nSpinup YEAR %ld: %d of %d patches at targets\n",
+			current_date.year, num_met, num_patches);
+	return;
+} /*end update_spinup_active_set*/
@@ -60,10 +60,11 @@ void world_daily_F(
 	/*	Simulate over all of the basins.							*/
 	/*--------------------------------------------------------------*/
   world[0].target_status = 1;
+	#pragma omp parallel for schedule(dynamic,1) if(command_line[0].basin_parallel_flag == 1)
 	for ( basin = 0; basin < world[0].num_basin_files; basin++ ){
 		basin_daily_F(	day,
 			world,
-			world[0].basins[basin],
+			world[0].basins[world[0].basin_order[basin]],
 			command_line,
 			event,
 			current_date);
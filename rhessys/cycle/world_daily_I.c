@@ -53,6 +53,13 @@ void		world_daily_I(
 		struct command_line_object *,
 		struct tec_entry *,
 		struct date);
+
+	void	order_basins_by_cost(
+		struct world_object *);
+
+	void	advance_daily_clim_events(
+		struct world_object *,
+		struct date);
 	/*--------------------------------------------------------------*/
 	/*  Local variable definition.                                  */
 	/*--------------------------------------------------------------*/
@@ -102,12 +109,21 @@ void		world_daily_I(
 	world[0].cos_declin = cos(declination_array[index]*DtoR);
 	world[0].sin_declin = sin(declination_array[index]*DtoR);
 	/*--------------------------------------------------------------*/
+	/*	Move the base station dated input cursors to this day;	*/
+	/*	patches of all basins share them and only read them		*/
+	/*--------------------------------------------------------------*/
+	advance_daily_clim_events(world, current_date);
+	/*--------------------------------------------------------------*/
 	/*	Simulate over all of the basins.							*/
+	/*	with -basinparallel basins run concurrently, largest first	*/
 	/*--------------------------------------------------------------*/
+	if (command_line[0].basin_parallel_flag == 1)
+		order_basins_by_cost(world);
+	#pragma omp parallel for schedule(dynamic,1) if(command_line[0].basin_parallel_flag == 1)
 	for ( basin = 0; basin < world[0].num_basin_files; basin++ ){
 		basin_daily_I(	day,
 			world,
-			world[0].basins[basin],
+			world[0].basins[world[0].basin_order[basin]],
 			command_line,
 			event,
 			current_date);
@@ -30,6 +30,7 @@
 /*--------------------------------------------------------------*/
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include "rhessys.h"
 
 void		world_hourly(
@@ -48,32 +49,34 @@ void		world_hourly(
 		struct tec_entry *,
 		struct date);
 	
+	void	advance_hourly_clim_events(
+		struct world_object *,
+		struct date);
 	/*--------------------------------------------------------------*/
 	/*  Local variable definition.                                  */
 	/*--------------------------------------------------------------*/
 	int	basin;
 	/*--------------------------------------------------------------*/
-	/*	Create world hourly parameter array.						*/
+	/*	Reset world hourly parameter array (allocated in			*/
+	/*	construct_world).											*/
 	/*--------------------------------------------------------------*/
-	if ( (world[0].hourly = (struct world_hourly_object *)
-		calloc(1,sizeof(struct world_hourly_object))) == NULL ){
-		fprintf(stderr,"FATAL ERROR: in simulate_world_hourly\n");
-		exit(EXIT_FAILURE);
-	}
+	memset(world[0].hourly, 0, sizeof(struct world_hourly_object));
+	/*--------------------------------------------------------------*/
+	/*	Move the base station hourly rain cursors to this hour;	*/
+	/*	zones of all basins share them and only read them below	*/
+	/*--------------------------------------------------------------*/
+	advance_hourly_clim_events(world, current_date);
 	/*--------------------------------------------------------------*/
 	/*	Simulate the basins											*/
 	/*--------------------------------------------------------------*/
+	#pragma omp parallel for schedule(dynamic,1) if(command_line[0].basin_parallel_flag == 1)
 	for ( basin = 0 ; basin < world[0].num_basin_files ; basin++ ){
 		basin_hourly(
 			world,
-			world[0].basins[basin],
+			world[0].basins[world[0].basin_order[basin]],
 			command_line,
 			event,
 			current_date);
 	}
-	/*--------------------------------------------------------------*/
-	/*	Destory world hourly object									*/
-	/*--------------------------------------------------------------*/
-	free ( world[0].hourly );
 	return;
 } /*end world_hourly.c*/
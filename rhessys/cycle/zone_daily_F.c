@@ -151,6 +151,10 @@ void		zone_daily_F(
 		struct command_line_object *,
 		struct tec_entry *,
 		struct date);
+	void	hold_frozen_patch(
+		struct patch_object *,
+		struct hillslope_object *,
+		struct command_line_object *);
 	long julday(struct date);
 	
 	/*--------------------------------------------------------------*/
@@ -616,17 +620,25 @@ void		zone_daily_F(
 	
 	/*--------------------------------------------------------------*/
 	/*	Cycle through the patches for day end computations		    	*/
+	/*	(patches held at their spinup targets only keep their state	*/
+	/*	and send their groundwater drainage, see -vegspinupfreeze)	*/
 	/*--------------------------------------------------------------*/
 	for ( patch=0 ; patch<zone[0].num_patches; patch++ ){
-		patch_daily_F(
-			world,
-			basin,
-			hillslope,
-			zone,
-			zone[0].patches[patch],
-			command_line,
-			event,
-			current_date );
+		if (zone[0].patches[patch][0].frozen == 1)
+			hold_frozen_patch(zone[0].patches[patch], hillslope, command_line);
+		else {
+			patch_daily_F(
+				world,
+				basin,
+				hillslope,
+				zone,
+				zone[0].patches[patch],
+				command_line,
+				event,
+				current_date );
+			if (command_line[0].vegspinup_freeze_flag == 1)
+				zone[0].patches[patch][0].boundary_flux.days += 1.0;
+		}
 
 	  if(command_line[0].vegspinup_flag > 0){
       if (zone[0].patches[patch]->target_status == 0){
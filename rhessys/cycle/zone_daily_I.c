@@ -160,9 +160,11 @@ void zone_daily_I(
 		struct date);
 
 
-	double normdist(double, double);
+	struct random_stream_object init_random_stream(long, int, struct date);
 
-	double unifdist(double, double);
+	double normdist(struct random_stream_object *, double, double);
+
+	double unifdist(struct random_stream_object *, double, double);
 
 	long  julday(struct date);	
 	/*--------------------------------------------------------------*/
@@ -170,7 +172,9 @@ void zone_daily_I(
 	/*--------------------------------------------------------------*/
 	int		flag;
 	int		i;
+	long	clim_day;
 	double	isohyet_adjustment;
+	struct	random_stream_object	stream;
 	int 	patch;
 	double	temp, tmp;
 	double	Tlapse_adjustment;
@@ -190,6 +194,10 @@ void zone_daily_I(
 	/*																*/
 	/*	Step through the list of basestations.						*/
 	/*--------------------------------------------------------------*/
+	/*--------------------------------------------------------------*/
+	/*	random draws of this zone and day (precip noise)	*/
+	/*--------------------------------------------------------------*/
+	stream = init_random_stream(command_line[0].random_seed, zone[0].ID, current_date);
 	i = 0;
 	flag = 0;
 	while ( (i < zone[0].num_base_stations) && (flag<3) ){
@@ -205,6 +213,10 @@ void zone_daily_I(
 		}
 		else z_delta = zone[0].z - zone[0].base_stations[i][0].z;
 		/*--------------------------------------------------------------*/
+		/*		day in the station's sequences (see update_clim_window)	*/
+		/*--------------------------------------------------------------*/
+		clim_day = day - zone[0].base_stations[i][0].daily_clim[0].window_start;
+		/*--------------------------------------------------------------*/
 		/*		compute isohyet difference adjustment					*/
 		/*--------------------------------------------------------------*/
 		if ( zone[0].base_stations[i][0].daily_clim[0].lapse_rate_precip == NULL) {
@@ -216,7 +228,7 @@ void zone_daily_I(
 		}
 		else {
 			isohyet_adjustment = 
-			zone[0].base_stations[i][0].daily_clim[0].lapse_rate_precip[day]*z_delta + 1.0;
+			zone[0].base_stations[i][0].daily_clim[0].lapse_rate_precip[clim_day]*z_delta + 1.0;
 			}
 
 		isohyet_adjustment = max(0.0, isohyet_adjustment);
@@ -233,7 +245,7 @@ void zone_daily_I(
 		/*																*/
 		/*		we do not adjust for slope, cloudyness or lai as yet	*/
 		/*--------------------------------------------------------------*/
-		temp = zone[0].base_stations[i][0].daily_clim[0].rain[day];
+		temp = zone[0].base_stations[i][0].daily_clim[0].rain[clim_day];
 		/*--------------------------------------------------------------*/
 		/* 	allow for stocastic noise in precip scaling 		*/
 		/*--------------------------------------------------------------*/
@@ -241,17 +253,17 @@ void zone_daily_I(
 
 			if (temp < zone[0].defaults[0][0].psen[PTHRESH])   {
 				if (zone[0].defaults[0][0].psen[PTYPELOW] > 0) 
-					isohyet_adjustment = exp(normdist(zone[0].defaults[0][0].psen[P1LOW], zone[0].defaults[0][0].psen[P2LOW]))*z_delta + 1.0;
+					isohyet_adjustment = exp(normdist(&stream, zone[0].defaults[0][0].psen[P1LOW], zone[0].defaults[0][0].psen[P2LOW]))*z_delta + 1.0;
 				else
-					isohyet_adjustment = z_delta * unifdist(zone[0].defaults[0][0].psen[P1LOW], zone[0].defaults[0][0].psen[P2LOW]) + 1;
+					isohyet_adjustment = z_delta * unifdist(&stream, zone[0].defaults[0][0].psen[P1LOW], zone[0].defaults[0][0].psen[P2LOW]) + 1;
 			}
 			else {
 				if (zone[0].defaults[0][0].psen[PTYPEHIGH] > 0) 
 				
-					isohyet_adjustment = exp(normdist(zone[0].defaults[0][0].psen[P1HIGH], zone[0].defaults[0][0].psen[P2HIGH]))*z_delta + 1.0;
+					isohyet_adjustment = exp(normdist(&stream, zone[0].defaults[0][0].psen[P1HIGH], zone[0].defaults[0][0].psen[P2HIGH]))*z_delta + 1.0;
 						
 				else
-					isohyet_adjustment = z_delta * unifdist(zone[0].defaults[0][0].psen[P1HIGH], zone[0].defaults[0][0].psen[P2HIGH]) + 1;
+					isohyet_adjustment = z_delta * unifdist(&stream, zone[0].defaults[0][0].psen[P1HIGH], zone[0].defaults[0][0].psen[P2HIGH]) + 1;
 			}
 
 			if (isohyet_adjustment < ZERO) 
@@ -269,7 +281,7 @@ void zone_daily_I(
 		/*--------------------------------------------------------------*/
 
 		
-		temp = zone[0].base_stations[i][0].daily_clim[0].tmin[day];
+		temp = zone[0].base_stations[i][0].daily_clim[0].tmin[clim_day];
 		if (temp != -999.0) {
 		if ( zone[0].base_stations[i][0].daily_clim[0].lapse_rate_tmin == NULL) {
 			if (zone[0].rain > ZERO)
@@ -280,14 +292,14 @@ void zone_daily_I(
 		}
 		else {
 			Tlapse_adjustment = z_delta * 
-				zone[0].base_stations[i][0].daily_clim[0].lapse_rate_tmin[day];
+				zone[0].base_stations[i][0].daily_clim[0].lapse_rate_tmin[clim_day];
 			zone[0].metv.tmin = temp - Tlapse_adjustment;
 		}
 			flag++;
 		}
 			
 	
-		temp = zone[0].base_stations[i][0].daily_clim[0].tmax[day];
+		temp = zone[0].base_stations[i][0].daily_clim[0].tmax[clim_day];
 
 		if (temp != -999.0) {
 		if ( zone[0].base_stations[i][0].daily_clim[0].lapse_rate_tmax == NULL) {
@@ -300,7 +312,7 @@ void zone_daily_I(
 		}
 		else {
 			Tlapse_adjustment = z_delta * 
-				zone[0].base_stations[i][0].daily_clim[0].lapse_rate_tmax[day];
+				zone[0].base_stations[i][0].daily_clim[0].lapse_rate_tmax[clim_day];
 			zone[0].metv.tmax = temp - Tlapse_adjustment;
 			flag++;
 		}
@@ -322,6 +334,7 @@ void zone_daily_I(
 			current_date.year, current_date.month, current_date.day);
 		exit(EXIT_FAILURE);
 	} /*end if*/
+	clim_day = day - zone[0].base_stations[0][0].daily_clim[0].window_start;
 	/*--------------------------------------------------------------*/
 	/*	Repeat the same exercise for the non-critical parameters.	*/
 	/*																*/
@@ -400,7 +413,7 @@ void zone_daily_I(
 	
 	
 	if ( zone[0].base_stations[0][0].daily_clim[0].snow != NULL ){
-		temp = zone[0].base_stations[0][0].daily_clim[0].snow[day];
+		temp = zone[0].base_stations[0][0].daily_clim[0].snow[clim_day];
 		if ( temp != -999.0 ){
 			zone[0].snow = temp * isohyet_adjustment;
 		}
@@ -416,7 +429,7 @@ void zone_daily_I(
 	/*	for the rest of the day by adjusting the mean value	*/
 	/*--------------------------------------------------------------*/
 	if ( zone[0].base_stations[0][0].daily_clim[0].daytime_rain_duration!=NULL){
-		temp=zone[0].base_stations[0][0].daily_clim[0].daytime_rain_duration[day];
+		temp=zone[0].base_stations[0][0].daily_clim[0].daytime_rain_duration[clim_day];
 		if ( temp != -999.0 ){
 			zone[0].rain_duration = temp * 3600;
 		}
@@ -443,7 +456,7 @@ void zone_daily_I(
 	/*--------------------------------------------------------------*/
 	if(zone[0].base_stations[0][0].daily_clim[0].base_station_effective_lai
 		!= NULL ){
-		temp = zone[0].base_stations[0][0].daily_clim[0].base_station_effective_lai[day];
+		temp = zone[0].base_stations[0][0].daily_clim[0].base_station_effective_lai[clim_day];
 		if ( temp != -999.0 ){
 			zone[0].base_station_effective_lai = temp;
 		}
@@ -456,7 +469,7 @@ void zone_daily_I(
 	/*	cloud fraction												*/
 	/*--------------------------------------------------------------*/
 	if ( zone[0].base_stations[0][0].daily_clim[0].cloud_fraction != NULL ){
-		temp = zone[0].base_stations[0][0].daily_clim[0].cloud_fraction[day];
+		temp = zone[0].base_stations[0][0].daily_clim[0].cloud_fraction[clim_day];
 		if ( temp != -999.0 ) zone[0].cloud_fraction = temp;
 	}
 	/*--------------------------------------------------------------*/
@@ -468,7 +481,7 @@ void zone_daily_I(
 	/*	Opacity defaults as 0.8 for clouds.							*/
 	/*--------------------------------------------------------------*/
 	if ( zone[0].base_stations[0][0].daily_clim[0].cloud_opacity != NULL ){
-		temp = zone[0].base_stations[0][0].daily_clim[0].cloud_opacity[day];
+		temp = zone[0].base_stations[0][0].daily_clim[0].cloud_opacity[clim_day];
 		if ( temp != -999.0 ) zone[0].cloud_opacity = temp;
 	}
 	else{
@@ -492,7 +505,7 @@ void zone_daily_I(
 	/*			fraction data is present.							*/
 	/*--------------------------------------------------------------*/
 	if ( zone[0].base_stations[0][0].daily_clim[0].Delta_T != NULL ){
-		temp = zone[0].base_stations[0][0].daily_clim[0].Delta_T[day];
+		temp = zone[0].base_stations[0][0].daily_clim[0].Delta_T[clim_day];
 		if ( temp != -999.0 ){
 			zone[0].Delta_T = temp;
 		}
@@ -531,7 +544,7 @@ void zone_daily_I(
 	/*	Assumed to be applicable to this zone's slope and aspect!!	*/
 	/*--------------------------------------------------------------*/
 	if ( zone[0].base_stations[0][0].daily_clim[0].Kdown_direct != NULL ){
-		temp = zone[0].base_stations[0][0].daily_clim[0].Kdown_direct[day];
+		temp = zone[0].base_stations[0][0].daily_clim[0].Kdown_direct[clim_day];
 		if ( temp != -999.0 ){
 			zone[0].Kdown_direct = temp;
 			zone[0].Kdown_direct_flag = 1;
@@ -543,7 +556,7 @@ void zone_daily_I(
 	/*	Assumed to be applicable to this zone's slope and aspect!!	*/
 	/*--------------------------------------------------------------*/
 	if ( zone[0].base_stations[0][0].daily_clim[0].Kdown_diffuse != NULL ){
-		temp = zone[0].base_stations[0][0].daily_clim[0].Kdown_diffuse[day];
+		temp = zone[0].base_stations[0][0].daily_clim[0].Kdown_diffuse[clim_day];
 		if ( temp != -999.0 ){
 			zone[0].Kdown_diffuse = temp;
 			zone[0].Kdown_diffuse_flag = 1;
@@ -559,7 +572,7 @@ void zone_daily_I(
 	/*	ivity which may not be the same for Kdown and PAR.			*/
 	/*--------------------------------------------------------------*/
 	if ( zone[0].base_stations[0][0].daily_clim[0].PAR_diffuse != NULL ){
-		temp = zone[0].base_stations[0][0].daily_clim[0].PAR_diffuse[day];
+		temp = zone[0].base_stations[0][0].daily_clim[0].PAR_diffuse[clim_day];
 		if ( temp != -999.0 ) zone[0].PAR_diffuse = temp * 1000000;
 	}
 	/*--------------------------------------------------------------*/
@@ -572,7 +585,7 @@ void zone_daily_I(
 	/*	ivity which may not be the same for Kdown and PAR.			*/
 	/*--------------------------------------------------------------*/
 	if ( zone[0].base_stations[0][0].daily_clim[0].PAR_direct != NULL ){
-		temp = zone[0].base_stations[0][0].daily_clim[0].PAR_direct[day];
+		temp = zone[0].base_stations[0][0].daily_clim[0].PAR_direct[clim_day];
 		if ( temp != -999.0 ) zone[0].PAR_direct = temp * 1000000;
 	}
 	/*--------------------------------------------------------------*/
@@ -580,7 +593,7 @@ void zone_daily_I(
 	/*	assumed for So and Do (I dont think this is valid for PAR)	*/
 	/*--------------------------------------------------------------*/
 	if ( zone[0].base_stations[0][0].daily_clim[0].atm_trans != NULL ){
-		temp = zone[0].base_stations[0][0].daily_clim[0].atm_trans[day];
+		temp = zone[0].base_stations[0][0].daily_clim[0].atm_trans[clim_day];
 		if ( temp != -999.0 ) zone[0].atm_trans = temp;
 	}
 	/*--------------------------------------------------------------*/
@@ -589,7 +602,7 @@ void zone_daily_I(
 	/* not sure what depth is 		*/
 	/*--------------------------------------------------------------*/
 	if ( zone[0].base_stations[0][0].daily_clim[0].tsoil != NULL ){
-		temp = zone[0].base_stations[0][0].daily_clim[0].tsoil[day];
+		temp = zone[0].base_stations[0][0].daily_clim[0].tsoil[clim_day];
 		if ( temp != -999.0 ) zone[0].metv.tsoil = temp;
 	}
 	/*--------------------------------------------------------------*/
@@ -612,7 +625,7 @@ void zone_daily_I(
 	/*	can modify wind speed.										*/
 	/*--------------------------------------------------------------*/
 	if ( zone[0].base_stations[0][0].daily_clim[0].wind != NULL ){
-		temp = zone[0].base_stations[0][0].daily_clim[0].wind[day];
+		temp = zone[0].base_stations[0][0].daily_clim[0].wind[clim_day];
 		if ( temp != -999.0 ){
 			zone[0].wind = temp;
 		}
@@ -629,7 +642,7 @@ void zone_daily_I(
 	/*	Wind direction at screen height.								*/
 	/*--------------------------------------------------------------*/
 	if ( zone[0].base_stations[0][0].daily_clim[0].wind_direction != NULL ){
-		temp = zone[0].base_stations[0][0].daily_clim[0].wind_direction[day];
+		temp = zone[0].base_stations[0][0].daily_clim[0].wind_direction[clim_day];
 		if ( temp != -999.0 ){
 			zone[0].wind_direction = temp;
 		}
@@ -647,13 +660,13 @@ void zone_daily_I(
 	/*--------------------------------------------------------------*/
 	if ( zone[0].base_stations[0][0].daily_clim[0].ndep_NO3 != NULL )
 		{
-		temp = zone[0].base_stations[0][0].daily_clim[0].ndep_NO3[day];
+		temp = zone[0].base_stations[0][0].daily_clim[0].ndep_NO3[clim_day];
 		if ( temp != -999.0 ) zone[0].ndep_NO3 = temp;
 	}
 		else zone[0].ndep_NO3 = zone[0].defaults[0][0].ndep_NO3;
 	if ( zone[0].base_stations[0][0].daily_clim[0].ndep_NH4 != NULL )
 		{
-		temp = zone[0].base_stations[0][0].daily_clim[0].ndep_NH4[day];
+		temp = zone[0].base_stations[0][0].daily_clim[0].ndep_NH4[clim_day];
 		if ( temp != -999.0 ) zone[0].ndep_NH4 = temp;
 	}
 		else zone[0].ndep_NH4 = 0.0;
@@ -661,14 +674,14 @@ void zone_daily_I(
 	/*	CO2 -ppm - atmospheric CO2  concentration time series	*/
 	/*--------------------------------------------------------------*/
 	if ( zone[0].base_stations[0][0].daily_clim[0].CO2 != NULL ){
-		temp = zone[0].base_stations[0][0].daily_clim[0].CO2[day];
+		temp = zone[0].base_stations[0][0].daily_clim[0].CO2[clim_day];
 		if ( temp != -999.0 ) zone[0].CO2 = temp;
 	}
 	/*--------------------------------------------------------------*/
 	/*      vpd - Pa - daylight mean value.                         */
 	/*--------------------------------------------------------------*/
 	if ( zone[0].base_stations[0][0].daily_clim[0].vpd != NULL ){
-		temp = zone[0].base_stations[0][0].daily_clim[0].vpd[day];
+		temp = zone[0].base_stations[0][0].daily_clim[0].vpd[clim_day];
 		if ( temp != -999.0 ) zone[0].metv.vpd = temp;
 	}
 	/*--------------------------------------------------------------*/
@@ -679,7 +692,7 @@ void zone_daily_I(
 	/*		if it is available.										*/
 	/*--------------------------------------------------------------*/
 	if ( zone[0].base_stations[0][0].daily_clim[0].relative_humidity != NULL ){
-		temp = zone[0].base_stations[0][0].daily_clim[0].relative_humidity[day];
+		temp = zone[0].base_stations[0][0].daily_clim[0].relative_humidity[clim_day];
 		if ( temp != -999.0 ) zone[0].relative_humidity= temp;
 	}
 	/*--------------------------------------------------------------*/
@@ -692,7 +705,7 @@ void zone_daily_I(
 	/*	"MTNCLIM"; otherwise we use Tmin_air for dewpoint.			*/
 	/*--------------------------------------------------------------*/
 	if ( zone[0].base_stations[0][0].daily_clim[0].tdewpoint != NULL ){
-		temp = zone[0].base_stations[0][0].daily_clim[0].tdewpoint[day];
+		temp = zone[0].base_stations[0][0].daily_clim[0].tdewpoint[clim_day];
 		if ( temp != -999.0 ){
 			zone[0].tdewpoint = temp-( z_delta )
 				* zone[0].defaults[0][0].dewpoint_lapse_rate;
@@ -711,7 +724,7 @@ void zone_daily_I(
 	/*	Arithmetic mean of daily tmax and tmin.				*/
 	/*--------------------------------------------------------------*/
 	if ( zone[0].base_stations[0][0].daily_clim[0].tavg != NULL ){
-		temp = zone[0].base_stations[0][0].daily_clim[0].tavg[day];
+		temp = zone[0].base_stations[0][0].daily_clim[0].tavg[clim_day];
 		if ( temp != -999.0 ){
 			zone[0].metv.tavg = temp-( z_delta )
 				* zone[0].defaults[0][0].lapse_rate;
@@ -731,7 +744,7 @@ void zone_daily_I(
 	/*      LAI_scalar                                              */
 	/*--------------------------------------------------------------*/
 	if ( zone[0].base_stations[0][0].daily_clim[0].LAI_scalar != NULL ){
-		temp = zone[0].base_stations[0][0].daily_clim[0].LAI_scalar[day];
+		temp = zone[0].base_stations[0][0].daily_clim[0].LAI_scalar[clim_day];
 		if ( temp != -999.0 ){
 			zone[0].LAI_scalar = temp;
 		}
@@ -743,7 +756,7 @@ void zone_daily_I(
 	/*	Ldown						*/
 	/*--------------------------------------------------------------*/
 	if ( zone[0].base_stations[0][0].daily_clim[0].Ldown != NULL ){
-		temp = zone[0].base_stations[0][0].daily_clim[0].Ldown[day];
+		temp = zone[0].base_stations[0][0].daily_clim[0].Ldown[clim_day];
 		if ( temp != -999.0 ){
 			zone[0].Ldown = temp;
 		}
@@ -752,7 +765,7 @@ void zone_daily_I(
 	/*	daylength	(sec)					*/
 	/*--------------------------------------------------------------*/
 	if ( zone[0].base_stations[0][0].daily_clim[0].dayl != NULL ){
-		temp = zone[0].base_stations[0][0].daily_clim[0].dayl[day];
+		temp = zone[0].base_stations[0][0].daily_clim[0].dayl[clim_day];
 		if ( temp != -999.0 ){
 			zone[0].metv.dayl = temp;
 			zone[0].daylength_flag = 1;
@@ -779,7 +792,7 @@ void zone_daily_I(
 	/*	rate.														*/
 	/*--------------------------------------------------------------*/
 	if ( zone[0].base_stations[0][0].daily_clim[0].tday != NULL ){
-		temp = zone[0].base_stations[0][0].daily_clim[0].tday[day];
+		temp = zone[0].base_stations[0][0].daily_clim[0].tday[clim_day];
 		if ( temp != -999.0 ){
 			temp = temp - ( z_delta )
 				* zone[0].defaults[0][0].lapse_rate;
@@ -799,7 +812,7 @@ void zone_daily_I(
 	/*	if tday is not given we wait until it is computed	*/
 	/*--------------------------------------------------------------*/
 	if ( zone[0].base_stations[0][0].daily_clim[0].tnight != NULL ){
-		temp = zone[0].base_stations[0][0].daily_clim[0].tnight[day];
+		temp = zone[0].base_stations[0][0].daily_clim[0].tnight[clim_day];
 		if ( temp != -999.0 ){
 			temp = temp - ( z_delta ) *
 				zone[0].defaults[0][0].lapse_rate;
@@ -825,7 +838,7 @@ void zone_daily_I(
 	/*	flux.							*/
 	/*--------------------------------------------------------------*/
 	if ( zone[0].base_stations[0][0].daily_clim[0].tnightmax != NULL ){
-		temp = zone[0].base_stations[0][0].daily_clim[0].tnightmax[day];
+		temp = zone[0].base_stations[0][0].daily_clim[0].tnightmax[clim_day];
 		if ( temp != -999.0 ){
 			temp = temp - ( z_delta )
 				* zone[0].defaults[0][0].lapse_rate;
@@ -1041,9 +1054,12 @@ void zone_daily_I(
 	}
 	
 	/*--------------------------------------------------------------*/
-	/*	Cycle through the patches 									*/
+	/*	Cycle through the patches (not those held at their spinup	*/
+	/*	targets)													*/
 	/*--------------------------------------------------------------*/
 	for ( patch=0 ; patch<zone[0].num_patches; patch++ ){
+		if (zone[0].patches[patch][0].frozen == 1)
+			continue;
 		patch_daily_I(
 			world,
 			basin,
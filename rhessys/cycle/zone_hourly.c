@@ -79,6 +79,8 @@ void		zone_hourly(
 	/*--------------------------------------------------------------*/
 	/* 	check for hourly precipitation data			*/
 	/* 	for now only assume one base station per zone		*/
+	/*	(the cursors are moved to the current hour in		*/
+	/*	world_hourly, see advance_clim_events)			*/
 	/*--------------------------------------------------------------*/
 	zone[0].hourly_rain_flag = 0;
 	zone[0].hourly[0].rain = 0.0;
@@ -87,11 +89,6 @@ void		zone_hourly(
 
 	if (inx > -999)  {
 		clim_event = zone[0].base_stations[0][0].hourly_clim[0].rain.seq[inx];
-		while (clim_event.edate.year!=0 && (julday(clim_event.edate) + clim_event.edate.hour/24.0 < julday(current_date) + current_date.hour/24.0)) {
-			zone[0].base_stations[0][0].hourly_clim[0].rain.inx += 1;
-			inx = zone[0].base_stations[0][0].hourly_clim[0].rain.inx;
-			clim_event = zone[0].base_stations[0][0].hourly_clim[0].rain.seq[inx];
-			}
 		
 		if ( (clim_event.edate.year != 0) &&
 			(julday(clim_event.edate) == julday(current_date)) && (clim_event.edate.hour == current_date.hour) ) {
@@ -172,11 +169,6 @@ void		zone_hourly(
 			/*--------------------------------------------------------------*/
 			if (inx > -999) {
 				clim_event = zone[0].base_stations[0][0].hourly_clim[0].rain_duration.seq[inx];
-				while (julday(clim_event.edate) + clim_event.edate.hour/24.0 < julday(current_date) + current_date.hour/24.0) {
-					zone[0].base_stations[0][0].hourly_clim[0].rain_duration.inx += 1;
-					inx = zone[0].base_stations[0][0].hourly_clim[0].rain_duration.inx;
-					clim_event = zone[0].base_stations[0][0].hourly_clim[0].rain_duration.seq[inx];
-					}
 				if ( (julday(clim_event.edate) == julday(current_date)) && (clim_event.edate.hour == current_date.hour) ) {
 					zone[0].hourly[0].rain_duration = clim_event.value;
 				}
@@ -364,6 +356,8 @@ void		zone_hourly(
 		/*	Cycle through the patches 									*/
 		/*--------------------------------------------------------------*/
 		for ( patch=0 ; patch<zone[0].num_patches; patch++ ){
+			if (zone[0].patches[patch][0].frozen == 1)
+				continue;
 			patch_hourly(
 				world,
 				basin,
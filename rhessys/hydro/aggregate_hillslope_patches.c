@@ -0,0 +1,187 @@
+/*--------------------------------------------------------------------------------------*/
+/* 											*/
+/*			aggregate_hillslope_patches					*/
+/*											*/
+/*	NAME										*/
+/*	aggregate_hillslope_patches.c - area weighted sums of a hillslope's patches	*/
+/*											*/
+/*	SYNOPSIS									*/
+/*	void aggregate_hillslope_patches( 						*/
+/*					struct hillslope_object *hillslope,		*/
+/*					struct hillslope_sums_object *sums)		*/
+/*	void add_hillslope_sums(struct hillslope_sums_object *total,		*/
+/*					struct hillslope_sums_object *sums)		*/
+/*											*/
+/*	OPTIONS										*/
+/*											*/
+/*	DESCRIPTION									*/
+/*	walks the zones, patches and canopy strata of one hillslope, in order, and	*/
+/*	sums the area weighted values written by output_basin and output_hillslope.	*/
+/*											*/
+/*	update_hillslope_accumulator calls it for every hillslope at the end of	*/
+/*	basin_daily_F (after routing) into hillslope[0].daily_sums, on the thread	*/
+/*	that has the hillslope, when basin or hillslope output is on.  output_basin	*/
+/*	then adds the sums of its hillslopes in hillslope order, so the daily	*/
+/*	output no longer walks the patches and is the same for any number of	*/
+/*	threads.  Hourly hillslope output calls it for the current hour.		*/
+/*											*/
+/*	add_hillslope_sums adds sums into total, field by field.			*/
+/*											*/
+/*	PROGRAMMER NOTES								*/
+/*	hillslope_sums_object must only hold doubles (add_hillslope_sums)		*/
+/*	sums are divided by area (or zone_area) by the output routines		*/
+/*	the squares of transpiration give the basin variances as		*/
+/*	sum(a x^2) - 2 m sum(a x) + m^2 sum(a)						*/
+/*--------------------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <string.h>
+#include "rhessys.h"
+
+void aggregate_hillslope_patches(
+			struct hillslope_object *hillslope,
+			struct hillslope_sums_object *sums)
+{
+	/*--------------------------------------------------------------------------------------*/
+	/* Local variables definition								*/
+	/*--------------------------------------------------------------------------------------*/
+	int z, p, c, layer;
+	double area, trans;
+	struct zone_object *zone;
+	struct patch_object *patch;
+	struct canopy_strata_object *stratum;
+
+	memset(sums, 0, sizeof(struct hillslope_sums_object));
+	for (z=0; z < hillslope[0].num_zones; z++) {
+		zone = hillslope[0].zones[z];
+		sums[0].pcp += (zone[0].rain_hourly_total + zone[0].rain + zone[0].snow) * zone[0].area;
+		sums[0].tmin += zone[0].metv.tmin * zone[0].area;
+		sums[0].tmax += zone[0].metv.tmax * zone[0].area;
+		sums[0].tavg += zone[0].metv.tavg * zone[0].area;
+		sums[0].vpd += zone[0].metv.vpd * zone[0].area;
+		sums[0].Kdown += (zone[0].Kdown_diffuse + zone[0].Kdown_direct) * zone[0].area;
+		sums[0].Ldown += zone[0].Ldown * zone[0].area;
+		sums[0].snow += zone[0].snow * zone[0].area;
+		sums[0].zone_area += zone[0].area;
+		for (p=0; p < zone[0].num_patches; p++) {
+			patch = zone[0].patches[p];
+			area = patch[0].area;
+			sums[0].rain_throughfall += patch[0].rain_throughfall * area;
+			sums[0].rain_throughfall_total += (patch[0].rain_throughfall_24hours
+				+ patch[0].rain_throughfall) * area;
+			sums[0].snow_throughfall += patch[0].snow_throughfall * area;
+			sums[0].precip_with_assim += patch[0].precip_with_assim * area;
+			sums[0].sat_deficit_z += patch[0].sat_deficit_z * area;
+			sums[0].sat_deficit += patch[0].sat_deficit * area;
+			sums[0].recharge += patch[0].recharge * area;
+			sums[0].rz_storage += patch[0].rz_storage * area;
+			sums[0].unsat_storage += patch[0].unsat_storage * area;
+			sums[0].rz_drainage += patch[0].rz_drainage * area;
+			sums[0].unsat_drainage += patch[0].unsat_drainage * area;
+			sums[0].cap_rise += patch[0].cap_rise * area;
+			sums[0].evaporation += (patch[0].evaporation + patch[0].evaporation_surf
+				+ patch[0].exfiltration_sat_zone
+				+ patch[0].exfiltration_unsat_zone) * area;
+			sums[0].evap_can += (patch[0].evaporation) * area;
+			sums[0].evap_lit += (patch[0].evaporation_surf) * area;
+			sums[0].evap_soil += (patch[0].exfiltration_sat_zone
+				+ patch[0].exfiltration_unsat_zone) * area;
+			sums[0].sublimation += patch[0].snowpack.sublimation * area;
+			sums[0].snowpack += patch[0].snowpack.water_equivalent_depth * area;
+			if (patch[0].snowpack.water_equivalent_depth > 0.001)
+				sums[0].perc_snow += area;
+			sums[0].snowmelt += patch[0].snow_melt * area;
+			sums[0].PET += (patch[0].PET) * area;
+			sums[0].litter_store += patch[0].litter.rain_stored * area;
+			sums[0].detention_store += patch[0].detention_store * area;
+			sums[0].acc_year_trans += patch[0].acc_year_trans * area;
+			sums[0].acc_year_trans_square += (1000 * patch[0].acc_year_trans)
+				* (1000 * patch[0].acc_year_trans) * area;
+			trans = patch[0].transpiration_sat_zone + patch[0].transpiration_unsat_zone;
+			sums[0].transpiration += trans * area;
+			sums[0].trans_square += (1000 * trans) * (1000 * trans) * area;
+			sums[0].litrc += (patch[0].litter_cs.litr1c + patch[0].litter_cs.litr2c
+				+ patch[0].litter_cs.litr3c + patch[0].litter_cs.litr4c) * area;
+			sums[0].Kup += (patch[0].Kup_direct + patch[0].Kup_diffuse) * area;
+			sums[0].Lup += (patch[0].Lup) * area;
+			sums[0].Kstar_can += patch[0].Kstar_canopy * area;
+			sums[0].Kstar_soil += patch[0].Kstar_soil * area;
+			sums[0].Kstar_snow += (patch[0].snowpack.Kstar_direct
+				+ patch[0].snowpack.Kstar_diffuse) * area;
+			sums[0].Lstar_can += patch[0].Lstar_canopy * area;
+			sums[0].Lstar_soil += patch[0].Lstar_soil * area;
+			sums[0].Lstar_snow += patch[0].Lstar_snow * area;
+			sums[0].LE_can += patch[0].LE_canopy * area;
+			sums[0].LE_soil += patch[0].LE_soil * area;
+			sums[0].LE_snow += (-1 * patch[0].snowpack.Q_LE + patch[0].snowpack.Q_melt) * area;
+			if (patch[0].sat_deficit <= ZERO)
+				sums[0].sat_area += area;
+			if (patch[0].drainage_type == STREAM)
+				sums[0].streamflow += patch[0].streamflow * area;
+			sums[0].return_flow += patch[0].return_flow * area;
+			sums[0].base_flow += patch[0].base_flow * area;
+			for (layer=0; layer < patch[0].num_layers; layer++) {
+				for (c=0; c < patch[0].layers[layer].count; c++) {
+					stratum = patch[0].canopy_strata[(patch[0].layers[layer].strata[c])];
+					sums[0].canopy_rain += stratum[0].cover_fraction
+						* (stratum[0].rain_stored + stratum[0].snow_stored) * area;
+					sums[0].psn += stratum[0].cover_fraction * stratum[0].cs.net_psn * area;
+					sums[0].lai += stratum[0].cover_fraction * stratum[0].epv.proj_lai * area;
+					sums[0].canopy_sublimation += stratum[0].cover_fraction
+						* stratum[0].sublimation * area;
+					sums[0].dC13 += stratum[0].cover_fraction * stratum[0].dC13 * area;
+					sums[0].mortality_fract += stratum[0].cover_fraction
+						* stratum[0].cs.mortality_fract * area;
+					sums[0].gpsn += stratum[0].cover_fraction * stratum[0].cdf.psn_to_cpool * area;
+					sums[0].resp += stratum[0].cover_fraction
+						* (stratum[0].cdf.leaf_day_mr + stratum[0].cdf.cpool_leaf_gr
+						+ stratum[0].cdf.leaf_night_mr + stratum[0].cdf.livestem_mr
+						+ stratum[0].cdf.cpool_livestem_gr + stratum[0].cdf.livecroot_mr
+						+ stratum[0].cdf.cpool_livecroot_gr
+						+ stratum[0].cdf.cpool_deadcroot_gr
+						+ stratum[0].cdf.froot_mr + stratum[0].cdf.cpool_froot_gr
+						+ stratum[0].cdf.cpool_to_gresp_store) * area;
+					sums[0].gs += stratum[0].cover_fraction * stratum[0].gs * area;
+					sums[0].rootdepth += stratum[0].cover_fraction
+						* (stratum[0].rootzone.depth) * area;
+					sums[0].leafc += stratum[0].cover_fraction * (stratum[0].cs.leafc
+						+ stratum[0].cs.leafc_store + stratum[0].cs.leafc_transfer) * area;
+					sums[0].frootc += stratum[0].cover_fraction * (stratum[0].cs.frootc
+						+ stratum[0].cs.frootc_store + stratum[0].cs.frootc_transfer) * area;
+					sums[0].woodc += stratum[0].cover_fraction * (stratum[0].cs.live_crootc
+						+ stratum[0].cs.live_stemc + stratum[0].cs.dead_crootc
+						+ stratum[0].cs.dead_stemc + stratum[0].cs.livecrootc_store
+						+ stratum[0].cs.livestemc_store + stratum[0].cs.deadcrootc_store
+						+ stratum[0].cs.deadstemc_store
+						+ stratum[0].cs.livecrootc_transfer
+						+ stratum[0].cs.livestemc_transfer
+						+ stratum[0].cs.deadcrootc_transfer
+						+ stratum[0].cs.deadstemc_transfer
+						+ stratum[0].cs.cwdc + stratum[0].cs.cpool) * area;
+					sums[0].canopy_snow += stratum[0].cover_fraction
+						* (stratum[0].snow_stored) * area;
+					sums[0].height += stratum[0].cover_fraction * stratum[0].epv.height * area;
+					sums[0].canopy_Lstar += stratum[0].cover_fraction * (stratum[0].Lstar) * area;
+					sums[0].canopy_drip += stratum[0].cover_fraction
+						* (stratum[0].canopy_drip) * area;
+					sums[0].ga += stratum[0].cover_fraction * stratum[0].ga * area;
+				}
+			}
+			sums[0].area += area;
+		} /* end of patch p */
+	} /* end of zones z */
+	return;
+} /* end of aggregate_hillslope_patches */
+
+void add_hillslope_sums(
+			struct hillslope_sums_object *total,
+			struct hillslope_sums_object *sums)
+{
+	size_t i;
+	double *t, *s;
+
+	t = (double *) total;
+	s = (double *) sums;
+	for (i=0; i < sizeof(struct hillslope_sums_object)/sizeof(double); i++)
+		t[i] += s[i];
+	return;
+} /* end of file aggregate_hillslope_patches.c */
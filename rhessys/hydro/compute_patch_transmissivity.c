@@ -0,0 +1,63 @@
+/*--------------------------------------------------------------*/
+/* 								*/
+/*		compute_patch_transmissivity			*/
+/*								*/
+/*	NAME							*/
+/*	compute_patch_transmissivity - transmissivity curve of	*/
+/*		a patch at one soil interval			*/
+/*								*/
+/*	SYNOPSIS						*/
+/*	double compute_patch_transmissivity(			*/
+/*				struct patch_object *,		*/
+/*				int	)			*/
+/*								*/
+/*	returns:						*/
+/*	transmissivity - (unitless) multiplier for Ksat0 	*/
+/*		for a water table at interval didx (see		*/
+/*		compute_transmissivity_curve)			*/
+/*								*/
+/*	OPTIONS							*/
+/*	int	didx - soil interval, 0 to num_soil_intervals	*/
+/*								*/
+/*	DESCRIPTION						*/
+/*								*/
+/*	Below the patch's limited intervals the curve is the	*/
+/*	soil's profile; within them each interval gives its	*/
+/*	drainable water times area/gamma instead:		*/
+/*								*/
+/*	T(didx) = profile[k] + area/gamma *			*/
+/*		(drainable_profile[didx] - drainable_profile[k])*/
+/*								*/
+/*	with k = transmissivity_limit.				*/
+/*								*/
+/*	PROGRAMMER NOTES					*/
+/*								*/
+/*	a patch with its own curve (transmissivity_profile)	*/
+/*	is read from that					*/
+/*--------------------------------------------------------------*/
+#include <stdio.h>
+#include "rhessys.h"
+
+double	compute_patch_transmissivity(
+					struct patch_object *patch,
+					int didx)
+{
+	/*--------------------------------------------------------------*/
+	/*	Local variable definition.				*/
+	/*--------------------------------------------------------------*/
+	int	k;
+	struct transmissivity_table_object *table;
+
+	if (didx < 0) didx = 0;
+	if (patch[0].transmissivity_profile != NULL)
+		return(patch[0].transmissivity_profile[didx]);
+
+	table = patch[0].transmissivity_table;
+	k = patch[0].transmissivity_limit;
+	if (didx >= k)
+		return(table[0].profile[didx]);
+
+	return(table[0].profile[k] + patch[0].transmissivity_ratio
+		* (table[0].drainable_profile[didx] - table[0].drainable_profile[k]));
+
+} /*compute_patch_transmissivity*/
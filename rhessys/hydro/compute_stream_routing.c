@@ -10,8 +10,7 @@
 /*	SYNOPSIS									*/
 /*	struct routing_list_object compute_stream_routing( 				*/
 /*							struct command_line_object command */
-/*							struct stream_network_object *network)	*/
-/*							int num_reaches,		*/	
+/*							struct stream_list_object *stream_list)	*/
 /*							struct date *current_date)	*/
 /*											*/
 /* 											*/
@@ -23,6 +22,11 @@
 /*											*/
 /* 	computes reach scale stream routing using nonlinear kimetic wave					*/
 /*											*/
+/*	reaches are solved level by level (see					*/
+/*	construct_stream_routing_topology); reaches of one level	*/
+/*	are independent and are solved in parallel, each one		*/
+/*	collecting the outflow of its upstream reaches in a fixed	*/
+/*	order so results do not depend on the number of threads		*/
 /*											*/
 /*											*/
 /*	PROGRAMMER NOTES								*/
@@ -45,8 +49,7 @@
 
 
 double  compute_stream_routing(struct command_line_object *command_line,
-						 struct stream_network_object *stream_network,
-						 int  num_reaches,
+						 struct stream_list_object *stream_list,
 						 struct	date	current_date)
 {
 	/*--------------------------------------------------------------*/
@@ -78,6 +81,8 @@ double  compute_stream_routing(struct command_line_object *command_line,
     //160628LML double stagelow;
     //160628LML double manning_new;
     double dt;
+    int l, num_reaches;
+    struct stream_network_object *stream_network;
     //160628LML double xarea;
     //160628LML double lateral_input_flow,streamflow;
     //160628LML double Qout,Qin,previous_lateral_input,length,initial_flow,sum;
@@ -92,10 +97,19 @@ double  compute_stream_routing(struct command_line_object *command_line,
 
 	dt=86400.0;
     double streamflow=0.0;
-    double sum=0.0;
+    num_reaches = stream_list->num_reaches;
+    stream_network = stream_list->stream_network;
     printf("\nnum_reaches = %d\n",num_reaches);
-    #pragma omp parallel for reduction(+ : sum)                                  //160628LML
-    for (int i = 0; i < num_reaches; i++) {
+    for (l = 0; l < stream_list->num_levels; l++) {
+    #pragma omp parallel for                                  //160628LML
+    for (int n = stream_list->level_start[l]; n < stream_list->level_start[l+1]; n++) {
+        int i = stream_list->level_reaches[n];
+	/* calculate income flow from upstream reaches (all solved at an earlier level); */
+	/* initial_flow holds their kinematic wave outflow of this time step */
+        for (int j=0; j< stream_network[i].num_upstream_reaches; j++) {
+            int u=stream_network[i].upstream_reaches[j];
+            stream_network[i].Qin += stream_network[u].initial_flow/stream_network[u].num_downstream_neighbours;
+        }
 	/* calculate total lateral input from patches */
        double lateral_input_flow = 0.0;
         double Qout=0.0;
@@ -107,7 +121,7 @@ double  compute_stream_routing(struct command_line_object *command_line,
                 struct patch_object *patch=stream_network[i].lateral_inputs[j];
 		   if (patch[0].drainage_type == STREAM  ){
 	      		lateral_input_flow += (patch[0].streamflow)*patch[0].area/dt/(stream_network[i].length); //unit:m2/s
-			   sum+= (patch[0].streamflow)*patch[0].area;}
+			   }
 		   
 	
 	}
@@ -167,17 +181,8 @@ double count this way */
 		stream_network[i].previous_lateral_input=lateral_input_flow;
 		stream_network[i].previous_Qin=Qin;
 		stream_network[i].Qin=0.0;
-		
-        /*calulate income flow  for downstream neighbours */
-         for (int j=0; j< stream_network[i].num_downstream_neighbours; j++) {
-             int downstream_neighbour=stream_network[i].downstream_neighbours[j];
-                            for(int k=i;k<num_reaches;k++)
-                               if(stream_network[k].reach_ID == downstream_neighbour){
-                                    stream_network[k].Qin += Qout/stream_network[i].num_downstream_neighbours;
-					break;			
-	}	
-	}
 	}
+    }
  
     	streamflow=stream_network[num_reaches-1].Qout;
 	return(streamflow);
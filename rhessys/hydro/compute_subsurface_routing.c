@@ -29,6 +29,13 @@
 /*	June 16, 98 C.Tague								*/
 /*	limit drainage to maximum saturation deficit defined by soil depth		*/
 /*											*/
+/*	with -parallelrouting patches store their outflows in	*/
+/*	route_list->outflow and each patch then gathers its inflows	*/
+/*	(update_drainage_inflow, update_overland_inflow); all patches	*/
+/*	see the stores of the start of the time step so results are	*/
+/*	the same for any number of threads, but differ slightly from	*/
+/*	the default sequential update				*/
+/*											*/
 /*--------------------------------------------------------------*/
 #include <stdio.h>
 #include "rhessys.h"
@@ -40,14 +47,34 @@ void compute_subsurface_routing(struct command_line_object *command_line,
 	/*--------------------------------------------------------------*/
 
 	void update_drainage_stream(struct patch_object *,
+			struct routing_state_object *,
 			struct command_line_object *, double, int);
 
 	void update_drainage_road(struct patch_object *,
-			struct command_line_object *, double, int);
+			struct routing_state_object *,
+			struct command_line_object *, double, int,
+			struct patch_outflow_object *);
 
 	void update_drainage_land(struct patch_object *,
+			struct routing_state_object *,
+			struct command_line_object *, double, int,
+			struct patch_outflow_object *);
+
+	void update_drainage_frozen(struct patch_object *,
+			struct routing_state_object *,
+			struct command_line_object *, double, int,
+			struct patch_outflow_object *);
+
+	void hold_frozen_patch(struct patch_object *,
+			struct hillslope_object *,
+			struct command_line_object *);
+
+	void update_drainage_inflow(struct routing_list_object *, int,
 			struct command_line_object *, double, int);
 
+	void update_overland_inflow(struct routing_list_object *, int,
+			struct command_line_object *);
+
 	double compute_infiltration(int, double, double, double, double, double,
 			double, double, double, double, double);
 
@@ -68,6 +95,7 @@ void compute_subsurface_routing(struct command_line_object *command_line,
 	int i, d;
 	int j, k;
 	int grow_flag, verbose_flag;
+	int parallel;
 	double time_int, tmp;
 	double theta, m, Ksat, Nout;
 	double NO3_out, NH4_out, DON_out, DOC_out;
@@ -89,14 +117,22 @@ void compute_subsurface_routing(struct command_line_object *command_line,
 	double preday_basin_detention_store;
 	double add_field_capacity, rz_drainage, unsat_drainage;
 	double streamflow, Qout, Qin_total, Qstr_total;
+	double dropped_inflow;
 	struct patch_object *patch;
 	struct hillslope_object *hillslope;
 	struct patch_object *neigh;
+	struct routing_list_object *rlist;
+	struct routing_state_object *state;
+	struct patch_outflow_object *outflow;
 	/*--------------------------------------------------------------*/
 	/*	initializations						*/
 	/*--------------------------------------------------------------*/
 	grow_flag = command_line[0].grow_flag;
 	verbose_flag = command_line[0].verbose_flag;
+	rlist = basin->route_list;
+	state = rlist->state;
+	parallel = ((command_line[0].parallel_routing_flag == 1)
+			&& (rlist->outflow != NULL));
 
 	time_int = 1.0 / n_timesteps;
 	basin_outflow = 0.0;
@@ -114,6 +150,7 @@ void compute_subsurface_routing(struct command_line_object *command_line,
 	streamflow = 0.0;
 	Qin_total = 0.0;
 	Qstr_total = 0.0;
+	dropped_inflow = 0.0;
 	d = 0;
 	basin[0].basin_outflow = 0.0;
 	basin[0].basin_area = 0.0;
@@ -145,8 +182,8 @@ void compute_subsurface_routing(struct command_line_object *command_line,
 		basin[0].basin_area += patch[0].area;
 		patch[0].Qin_total = 0.0;
 		patch[0].Qout_total = 0.0;
-		patch[0].Qin = 0.0;
-		patch[0].Qout = 0.0;
+		state->Qin[i] = 0.0;
+		state->Qout[i] = 0.0;
 		patch[0].surface_Qin = 0.0;
 		patch[0].surface_Qout = 0.0;
 
@@ -167,10 +204,10 @@ void compute_subsurface_routing(struct command_line_object *command_line,
 			patch[0].S = patch[0].unsat_storage / patch[0].sat_deficit;
 
 		if (grow_flag > 0) {
-			patch[0].soil_ns.NO3_Qin = 0.0;
-			patch[0].soil_ns.NO3_Qout = 0.0;
-			patch[0].soil_ns.NH4_Qin = 0.0;
-			patch[0].soil_ns.NH4_Qout = 0.0;
+			state->NO3_Qin[i] = 0.0;
+			state->NO3_Qout[i] = 0.0;
+			state->NH4_Qin[i] = 0.0;
+			state->NH4_Qout[i] = 0.0;
 			patch[0].soil_ns.NO3_Qin_total = 0.0;
 			patch[0].soil_ns.NO3_Qout_total = 0.0;
 			patch[0].soil_ns.NH4_Qin_total = 0.0;
@@ -189,10 +226,10 @@ void compute_subsurface_routing(struct command_line_object *command_line,
 			patch[0].surface_DOC_Qout_total = 0.0;
 			patch[0].soil_ns.leach = 0.0;
 			patch[0].surface_ns_leach = 0.0;
-			patch[0].soil_ns.DON_Qout = 0.0;
-			patch[0].soil_ns.DON_Qin = 0.0;
-			patch[0].soil_cs.DOC_Qout = 0.0;
-			patch[0].soil_cs.DOC_Qin = 0.0;
+			state->DON_Qout[i] = 0.0;
+			state->DON_Qin[i] = 0.0;
+			state->DOC_Qout[i] = 0.0;
+			state->DOC_Qin[i] = 0.0;
 			patch[0].surface_DON_Qout = 0.0;
 			patch[0].surface_DON_Qin = 0.0;
 			patch[0].surface_DOC_Qout = 0.0;
@@ -219,8 +256,10 @@ void compute_subsurface_routing(struct command_line_object *command_line,
 		patch[0].preday_sat_deficit = patch[0].sat_deficit;
 
 
+		#pragma omp parallel for if(parallel) private(patch, outflow)
 		for (i = 0; i < basin->route_list->num_patches; i++) {
 			patch = basin->route_list->list[i];
+			outflow = (parallel) ? &(rlist->outflow[i]) : NULL;
 		      	patch[0].hourly_subsur2stream_flow = 0;
 			patch[0].hourly_sur2stream_flow = 0;
 			patch[0].hourly_stream_flow = 0;
@@ -235,28 +274,85 @@ void compute_subsurface_routing(struct command_line_object *command_line,
 			/*	for streams, no routing - all exported from basin	*/
 			/*								*/
 			/*	regular land patches - route to downslope neighbours    */
+			/*								*/
+			/*	patches held at their spinup targets send a fixed	*/
+			/*	outflow							*/
 			/*--------------------------------------------------------------*/
-			if ((patch[0].drainage_type == ROAD)
+			if (patch[0].frozen == 1) {
+				update_drainage_frozen(patch, state, command_line, time_int,
+						verbose_flag, outflow);
+			} else if ((patch[0].drainage_type == ROAD)
 					&& (command_line[0].road_flag == 1)) {
-				update_drainage_road(patch, command_line, time_int,
-						verbose_flag);
+				update_drainage_road(patch, state, command_line, time_int,
+						verbose_flag, outflow);
 			} else if (patch[0].drainage_type == STREAM) {
-				update_drainage_stream(patch, command_line, time_int,
+				update_drainage_stream(patch, state, command_line, time_int,
 						verbose_flag);
 			} else {
-				update_drainage_land(patch, command_line, time_int,
-						verbose_flag);
+				update_drainage_land(patch, state, command_line, time_int,
+						verbose_flag, outflow);
 			}
 
 		} /* end i */
 
+		/*--------------------------------------------------------------*/
+		/*	parallel routing - each patch gathers the flows that	*/
+		/*	its upslope neighbours stored in their outflow buffer	*/
+		/*--------------------------------------------------------------*/
+		if (parallel) {
+			#pragma omp parallel for
+			for (i = 0; i < rlist->num_patches; i++)
+				update_drainage_inflow(rlist, i, command_line, time_int,
+						verbose_flag);
+		}
+
 		/*--------------------------------------------------------------*/
 		/*	update soil moisture and nitrogen stores		*/
 		/*	check water balance					*/
+		/*	(d is carried from patch to patch in the sequential	*/
+		/*	case, hence firstprivate)				*/
 		/*--------------------------------------------------------------*/
+		#pragma omp parallel for if(parallel) firstprivate(d) \
+			reduction(+:dropped_inflow) \
+			private(patch, neigh, outflow, j, excess, innundation_depth, Qout, Nout, \
+			NO3_out, NH4_out, DON_out, DOC_out, infiltration, \
+			add_field_capacity, rz_drainage, unsat_drainage)
 		for (i = 0; i < basin->route_list->num_patches; i++) {
 			patch = basin->route_list->list[i];
 
+			/*--------------------------------------------------------------*/
+			/*	a patch held at its spinup targets keeps its stores;	*/
+			/*	what is routed into it is dropped, and counted for	*/
+			/*	update_spinup_active_set				*/
+			/*--------------------------------------------------------------*/
+			if (patch[0].frozen == 1) {
+				dropped_inflow += (state->Qin[i] + patch[0].surface_Qin)
+						* patch[0].area;
+				patch[0].surface_Qin = 0.0;
+				state->Qin[i] = 0.0;
+				state->Qout[i] = 0.0;
+				if (grow_flag > 0) {
+					state->NH4_Qin[i] = 0.0;
+					state->NH4_Qout[i] = 0.0;
+					state->NO3_Qin[i] = 0.0;
+					state->NO3_Qout[i] = 0.0;
+					state->DON_Qin[i] = 0.0;
+					state->DON_Qout[i] = 0.0;
+					state->DOC_Qin[i] = 0.0;
+					state->DOC_Qout[i] = 0.0;
+				}
+				if ((k == (n_timesteps - 1)) && !parallel) {
+					basin[0].basin_return_flow += (patch[0].return_flow) * patch[0].area;
+					basin[0].basin_outflow += (patch[0].streamflow) * patch[0].area;
+					basin[0].basin_unsat_storage += patch[0].unsat_storage * patch[0].area;
+					basin[0].basin_sat_deficit += patch[0].sat_deficit * patch[0].area;
+					basin[0].basin_rz_storage += patch[0].rz_storage * patch[0].area;
+					basin[0].basin_detention_store += patch[0].detention_store
+							* patch[0].area;
+				}
+				continue;
+			}
+
 			/*--------------------------------------------------------------*/
 			/*	update subsurface 				*/
 			/*-------------------------------------------------------------------------*/
@@ -264,7 +360,7 @@ void compute_subsurface_routing(struct command_line_object *command_line,
 			/*-------------------------------------------------------------------------*/
 			/*	Recompute current actual depth to water table				*/
 			/*-------------------------------------------------------------------------*/
-			patch[0].sat_deficit += (patch[0].Qout - patch[0].Qin);
+			patch[0].sat_deficit += (state->Qout[i] - state->Qin[i]);
 
 			patch[0].sat_deficit_z = compute_z_final(verbose_flag,
 					patch[0].soil_defaults[0][0].porosity_0,
@@ -273,14 +369,14 @@ void compute_subsurface_routing(struct command_line_object *command_line,
 					-1.0 * patch[0].sat_deficit);
 
 			if (grow_flag > 0) {
-				patch[0].soil_ns.nitrate += (patch[0].soil_ns.NO3_Qin
-						- patch[0].soil_ns.NO3_Qout);
-				patch[0].soil_ns.sminn += (patch[0].soil_ns.NH4_Qin
-						- patch[0].soil_ns.NH4_Qout);
-				patch[0].soil_cs.DOC += (patch[0].soil_cs.DOC_Qin
-						- patch[0].soil_cs.DOC_Qout);
-				patch[0].soil_ns.DON += (patch[0].soil_ns.DON_Qin
-						- patch[0].soil_ns.DON_Qout);
+				patch[0].soil_ns.nitrate += (state->NO3_Qin[i]
+						- state->NO3_Qout[i]);
+				patch[0].soil_ns.sminn += (state->NH4_Qin[i]
+						- state->NH4_Qout[i]);
+				patch[0].soil_cs.DOC += (state->DOC_Qin[i]
+						- state->DOC_Qout[i]);
+				patch[0].soil_ns.DON += (state->DON_Qin[i]
+						- state->DON_Qout[i]);
 			}
 
 			/*--------------------------------------------------------------*/
@@ -304,43 +400,43 @@ void compute_subsurface_routing(struct command_line_object *command_line,
 			/*--------------------------------------------------------------*/
 			/*	reset iterative  patch fluxes to zero			*/
 			/*--------------------------------------------------------------*/
-			patch[0].soil_ns.leach += (patch[0].soil_ns.DON_Qout
-					+ patch[0].soil_ns.NH4_Qout + patch[0].soil_ns.NO3_Qout
-					- patch[0].soil_ns.NH4_Qin - patch[0].soil_ns.NO3_Qin
-					- patch[0].soil_ns.DON_Qin);
+			patch[0].soil_ns.leach += (state->DON_Qout[i]
+					+ state->NH4_Qout[i] + state->NO3_Qout[i]
+					- state->NH4_Qin[i] - state->NO3_Qin[i]
+					- state->DON_Qin[i]);
 			patch[0].surface_ns_leach += ((patch[0].surface_NO3_Qout
 					- patch[0].surface_NO3_Qin)
 					+ (patch[0].surface_NH4_Qout - patch[0].surface_NH4_Qin)
 					+ (patch[0].surface_DON_Qout - patch[0].surface_DON_Qin));
-			patch[0].Qin_total += patch[0].Qin + patch[0].surface_Qin;
-			patch[0].Qout_total += patch[0].Qout + patch[0].surface_Qout;
+			patch[0].Qin_total += state->Qin[i] + patch[0].surface_Qin;
+			patch[0].Qout_total += state->Qout[i] + patch[0].surface_Qout;
 
 			patch[0].surface_Qin = 0.0;
 			patch[0].surface_Qout = 0.0;
-			patch[0].Qin = 0.0;
-			patch[0].Qout = 0.0;
+			state->Qin[i] = 0.0;
+			state->Qout[i] = 0.0;
 			if (grow_flag > 0) {
-				patch[0].soil_cs.DOC_Qin_total += patch[0].soil_cs.DOC_Qin;
-				patch[0].soil_cs.DOC_Qout_total += patch[0].soil_cs.DOC_Qout;
-				patch[0].soil_ns.NH4_Qin_total += patch[0].soil_ns.NH4_Qin;
-				patch[0].soil_ns.NH4_Qout_total += patch[0].soil_ns.NH4_Qout;
-				patch[0].soil_ns.NO3_Qin_total += patch[0].soil_ns.NO3_Qin;
-				patch[0].soil_ns.NO3_Qout_total += patch[0].soil_ns.NO3_Qout;
-				patch[0].soil_ns.DON_Qin_total += patch[0].soil_ns.DON_Qin;
-				patch[0].soil_ns.DON_Qout_total += patch[0].soil_ns.DON_Qout;
+				patch[0].soil_cs.DOC_Qin_total += state->DOC_Qin[i];
+				patch[0].soil_cs.DOC_Qout_total += state->DOC_Qout[i];
+				patch[0].soil_ns.NH4_Qin_total += state->NH4_Qin[i];
+				patch[0].soil_ns.NH4_Qout_total += state->NH4_Qout[i];
+				patch[0].soil_ns.NO3_Qin_total += state->NO3_Qin[i];
+				patch[0].soil_ns.NO3_Qout_total += state->NO3_Qout[i];
+				patch[0].soil_ns.DON_Qin_total += state->DON_Qin[i];
+				patch[0].soil_ns.DON_Qout_total += state->DON_Qout[i];
 				patch[0].surface_DON_Qin_total += patch[0].surface_DON_Qin;
 				patch[0].surface_DON_Qout_total += patch[0].surface_DON_Qout;
 				patch[0].surface_DOC_Qin_total += patch[0].surface_DOC_Qin;
 				patch[0].surface_DOC_Qout_total += patch[0].surface_DOC_Qout;
 
-				patch[0].soil_ns.NH4_Qin = 0.0;
-				patch[0].soil_ns.NH4_Qout = 0.0;
-				patch[0].soil_ns.NO3_Qin = 0.0;
-				patch[0].soil_ns.NO3_Qout = 0.0;
-				patch[0].soil_ns.DON_Qout = 0.0;
-				patch[0].soil_ns.DON_Qin = 0.0;
-				patch[0].soil_cs.DOC_Qout = 0.0;
-				patch[0].soil_cs.DOC_Qin = 0.0;
+				state->NH4_Qin[i] = 0.0;
+				state->NH4_Qout[i] = 0.0;
+				state->NO3_Qin[i] = 0.0;
+				state->NO3_Qout[i] = 0.0;
+				state->DON_Qout[i] = 0.0;
+				state->DON_Qin[i] = 0.0;
+				state->DOC_Qout[i] = 0.0;
+				state->DOC_Qin[i] = 0.0;
 				patch[0].surface_NH4_Qout = 0.0;
 				patch[0].surface_NH4_Qin = 0.0;
 				patch[0].surface_NO3_Qout = 0.0;
@@ -377,6 +473,10 @@ void compute_subsurface_routing(struct command_line_object *command_line,
 
 			if (k == (n_timesteps -1))
             {
+				if (parallel) {
+					d = 0;
+					rlist->outflow[i].overland_d = -1;
+				}
 			      if ((patch[0].sat_deficit
 						- (patch[0].unsat_storage + patch[0].rz_storage))
 						< -1.0 * ZERO) {
@@ -530,6 +630,42 @@ void compute_subsurface_routing(struct command_line_object *command_line,
 							d = 0;
 						}
 
+						/*--------------------------------------------------------------*/
+						/* kept for update_drainage_frozen			*/
+						/*--------------------------------------------------------------*/
+						if (command_line[0].vegspinup_freeze_flag == 1) {
+							patch[0].boundary_flux.route_to_surface += excess * patch[0].area;
+							if (grow_flag > 0) {
+								patch[0].boundary_flux.NO3_to_surface += excess
+										/ patch[0].detention_store * patch[0].surface_NO3
+										* patch[0].area;
+								patch[0].boundary_flux.NH4_to_surface += excess
+										/ patch[0].detention_store * patch[0].surface_NH4
+										* patch[0].area;
+								patch[0].boundary_flux.DON_to_surface += excess
+										/ patch[0].detention_store * patch[0].surface_DON
+										* patch[0].area;
+								patch[0].boundary_flux.DOC_to_surface += excess
+										/ patch[0].detention_store * patch[0].surface_DOC
+										* patch[0].area;
+							}
+						}
+
+						/*--------------------------------------------------------------*/
+						/* parallel routing - neighbours gather this in		*/
+						/* update_overland_inflow					*/
+						/*--------------------------------------------------------------*/
+						if (parallel) {
+							outflow = &(rlist->outflow[i]);
+							outflow->overland_d = d;
+							outflow->overland_excess = excess;
+							outflow->overland_detention_store = patch[0].detention_store;
+							outflow->overland_NO3 = patch[0].surface_NO3;
+							outflow->overland_NH4 = patch[0].surface_NH4;
+							outflow->overland_DON = patch[0].surface_DON;
+							outflow->overland_DOC = patch[0].surface_DOC;
+						}
+						else
 						for (j = 0; j < patch->surface_innundation_list[d].num_neighbours; j++) {
 							neigh = patch->surface_innundation_list[d].neighbours[j].patch;
 							Qout = excess * patch->surface_innundation_list[d].neighbours[j].gamma;
@@ -972,6 +1108,7 @@ void compute_subsurface_routing(struct command_line_object *command_line,
 				/* final stream flow calculations				*/
 				/*--------------------------------------------------------------*/
 
+				if (!parallel) {
 				basin[0].basin_return_flow += (patch[0].return_flow) * patch[0].area;
 				basin[0].basin_outflow += (patch[0].streamflow) * patch[0].area;
 				basin[0].basin_unsat_storage += patch[0].unsat_storage * patch[0].area;
@@ -979,6 +1116,7 @@ void compute_subsurface_routing(struct command_line_object *command_line,
 				basin[0].basin_rz_storage += patch[0].rz_storage * patch[0].area;
 				basin[0].basin_detention_store += patch[0].detention_store
 						* patch[0].area;
+				}
 
 				/*---------------------------------------------------------------------*/
 				/*update accumulator variables                                            */
@@ -1002,8 +1140,38 @@ void compute_subsurface_routing(struct command_line_object *command_line,
 
 		} /* end i */
 
+		/*--------------------------------------------------------------*/
+		/*	parallel routing - gather final overland flow and sum	*/
+		/*	basin stores in route list order			*/
+		/*--------------------------------------------------------------*/
+		if (parallel && (k == (n_timesteps -1))) {
+			#pragma omp parallel for
+			for (i = 0; i < rlist->num_patches; i++)
+				update_overland_inflow(rlist, i, command_line);
+
+			for (i = 0; i < rlist->num_patches; i++) {
+				patch = rlist->list[i];
+				basin[0].basin_return_flow += (patch[0].return_flow) * patch[0].area;
+				basin[0].basin_outflow += (patch[0].streamflow) * patch[0].area;
+				basin[0].basin_unsat_storage += patch[0].unsat_storage * patch[0].area;
+				basin[0].basin_sat_deficit += patch[0].sat_deficit * patch[0].area;
+				basin[0].basin_rz_storage += patch[0].rz_storage * patch[0].area;
+				basin[0].basin_detention_store += patch[0].detention_store
+						* patch[0].area;
+			}
+		}
+
 	} /* end k  */
 
+	/*--------------------------------------------------------------*/
+	/*	patches held at their spinup targets go back to that state	*/
+	/*--------------------------------------------------------------*/
+	basin[0].spinup_dropped_inflow += dropped_inflow;
+	if (command_line[0].vegspinup_freeze_flag == 1)
+		for (i = 0; i < basin->route_list->num_patches; i++)
+			if (basin->route_list->list[i][0].frozen == 1)
+				hold_frozen_patch(basin->route_list->list[i], NULL, command_line);
+
 	basin[0].basin_outflow /= basin_area;
 	basin[0].preday_basin_rz_storage /= basin_area;
 	basin[0].preday_basin_unsat_storage /= basin_area;
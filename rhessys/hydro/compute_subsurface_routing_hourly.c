@@ -43,13 +43,18 @@ void compute_subsurface_routing_hourly(
 	/*--------------------------------------------------------------*/
 
 	void update_drainage_stream(struct patch_object *,
+			struct routing_state_object *,
 			struct command_line_object *, double, int);
 
 	void update_drainage_road(struct patch_object *,
-			struct command_line_object *, double, int);
+			struct routing_state_object *,
+			struct command_line_object *, double, int,
+			struct patch_outflow_object *);
 
 	void update_drainage_land(struct patch_object *,
-			struct command_line_object *, double, int);
+			struct routing_state_object *,
+			struct command_line_object *, double, int,
+			struct patch_outflow_object *);
 
 	double compute_infiltration(int, double, double, double, double, double,
 			double, double, double, double, double);
@@ -93,6 +98,7 @@ void compute_subsurface_routing_hourly(
 	double add_field_capacity, rz_drainage, unsat_drainage;
 	double streamflow, Qout, Qin_total, Qstr_total;
 	struct patch_object *patch;
+	struct routing_state_object *state;
 	struct hillslope_object *hillslope;
 	struct patch_object *neigh;
 	struct litter_object *litter;
@@ -102,6 +108,7 @@ void compute_subsurface_routing_hourly(
 	/*--------------------------------------------------------------*/
 	
 		grow_flag = command_line[0].grow_flag;
+		state = basin->route_list->state;
 		verbose_flag = command_line[0].verbose_flag;
 
 		time_int = 1.0 / n_timesteps;
@@ -155,8 +162,8 @@ void compute_subsurface_routing_hourly(
 			basin[0].basin_area += patch[0].area;
 			patch[0].Qin_total = 0.0;
 			patch[0].Qout_total = 0.0;
-			patch[0].Qin = 0.0;
-			patch[0].Qout = 0.0;
+			state->Qin[i] = 0.0;
+			state->Qout[i] = 0.0;
 			patch[0].surface_Qin = 0.0;
 			patch[0].surface_Qout = 0.0;
 
@@ -170,10 +177,10 @@ void compute_subsurface_routing_hourly(
 				patch[0].S = patch[0].unsat_storage / patch[0].sat_deficit;
 
 			if (grow_flag > 0) {
-				patch[0].soil_ns.NO3_Qin = 0.0;
-				patch[0].soil_ns.NO3_Qout = 0.0;
-				patch[0].soil_ns.NH4_Qin = 0.0;
-				patch[0].soil_ns.NH4_Qout = 0.0;
+				state->NO3_Qin[i] = 0.0;
+				state->NO3_Qout[i] = 0.0;
+				state->NH4_Qin[i] = 0.0;
+				state->NH4_Qout[i] = 0.0;
 				patch[0].soil_ns.NO3_Qin_total = 0.0;
 				patch[0].soil_ns.NO3_Qout_total = 0.0;
 				patch[0].soil_ns.NH4_Qin_total = 0.0;
@@ -192,10 +199,10 @@ void compute_subsurface_routing_hourly(
 				patch[0].surface_DOC_Qout_total = 0.0;
 				patch[0].soil_ns.leach = 0.0;
 				patch[0].surface_ns_leach = 0.0;
-				patch[0].soil_ns.DON_Qout = 0.0;
-				patch[0].soil_ns.DON_Qin = 0.0;
-				patch[0].soil_cs.DOC_Qout = 0.0;
-				patch[0].soil_cs.DOC_Qin = 0.0;
+				state->DON_Qout[i] = 0.0;
+				state->DON_Qin[i] = 0.0;
+				state->DOC_Qout[i] = 0.0;
+				state->DOC_Qin[i] = 0.0;
 				patch[0].surface_DON_Qout = 0.0;
 				patch[0].surface_DON_Qin = 0.0;
 				patch[0].surface_DOC_Qout = 0.0;
@@ -242,14 +249,14 @@ void compute_subsurface_routing_hourly(
 			/*--------------------------------------------------------------*/
 			if ((patch[0].drainage_type == ROAD)
 					&& (command_line[0].road_flag == 1)) {
-				update_drainage_road(patch, command_line, time_int,
-						verbose_flag);
+				update_drainage_road(patch, state, command_line, time_int,
+						verbose_flag, NULL);
 			} else if (patch[0].drainage_type == STREAM) {
-				update_drainage_stream(patch, command_line, time_int,
+				update_drainage_stream(patch, state, command_line, time_int,
 						verbose_flag);
 			} else {
-				update_drainage_land(patch, command_line, time_int,
-						verbose_flag);
+				update_drainage_land(patch, state, command_line, time_int,
+						verbose_flag, NULL);
 			}
 
 
@@ -270,7 +277,7 @@ void compute_subsurface_routing_hourly(
 			/*-------------------------------------------------------------------------*/
 			/*	Recompute current actual depth to water table				*/
 			/*-------------------------------------------------------------------------*/
-			patch[0].sat_deficit += (patch[0].Qout - patch[0].Qin); // this part need to put into some where else
+			patch[0].sat_deficit += (state->Qout[i] - state->Qin[i]); // this part need to put into some where else
 
 			patch[0].sat_deficit_z = compute_z_final(verbose_flag,
 					patch[0].soil_defaults[0][0].porosity_0,
@@ -279,14 +286,14 @@ void compute_subsurface_routing_hourly(
 					-1.0 * patch[0].sat_deficit);
 
 			if (grow_flag > 0) {
-				patch[0].soil_ns.nitrate += (patch[0].soil_ns.NO3_Qin
-						- patch[0].soil_ns.NO3_Qout);
-				patch[0].soil_ns.sminn += (patch[0].soil_ns.NH4_Qin
-						- patch[0].soil_ns.NH4_Qout);
-				patch[0].soil_cs.DOC += (patch[0].soil_cs.DOC_Qin
-						- patch[0].soil_cs.DOC_Qout);
-				patch[0].soil_ns.DON += (patch[0].soil_ns.DON_Qin
-						- patch[0].soil_ns.DON_Qout);
+				patch[0].soil_ns.nitrate += (state->NO3_Qin[i]
+						- state->NO3_Qout[i]);
+				patch[0].soil_ns.sminn += (state->NH4_Qin[i]
+						- state->NH4_Qout[i]);
+				patch[0].soil_cs.DOC += (state->DOC_Qin[i]
+						- state->DOC_Qout[i]);
+				patch[0].soil_ns.DON += (state->DON_Qin[i]
+						- state->DON_Qout[i]);
 			}
 
 			/*--------------------------------------------------------------*/
@@ -310,43 +317,43 @@ void compute_subsurface_routing_hourly(
 			/*--------------------------------------------------------------*/
 			/*	reset iterative  patch fluxes to zero			*/
 			/*--------------------------------------------------------------*/
-			patch[0].soil_ns.leach += (patch[0].soil_ns.DON_Qout
-					+ patch[0].soil_ns.NH4_Qout + patch[0].soil_ns.NO3_Qout
-					- patch[0].soil_ns.NH4_Qin - patch[0].soil_ns.NO3_Qin
-					- patch[0].soil_ns.DON_Qin);
+			patch[0].soil_ns.leach += (state->DON_Qout[i]
+					+ state->NH4_Qout[i] + state->NO3_Qout[i]
+					- state->NH4_Qin[i] - state->NO3_Qin[i]
+					- state->DON_Qin[i]);
 			patch[0].surface_ns_leach += ((patch[0].surface_NO3_Qout
 					- patch[0].surface_NO3_Qin)
 					+ (patch[0].surface_NH4_Qout - patch[0].surface_NH4_Qin)
 					+ (patch[0].surface_DON_Qout - patch[0].surface_DON_Qin));
-			patch[0].Qin_total += patch[0].Qin + patch[0].surface_Qin;
-			patch[0].Qout_total += patch[0].Qout + patch[0].surface_Qout;
+			patch[0].Qin_total += state->Qin[i] + patch[0].surface_Qin;
+			patch[0].Qout_total += state->Qout[i] + patch[0].surface_Qout;
 
 			patch[0].surface_Qin = 0.0;
 			patch[0].surface_Qout = 0.0;
-			patch[0].Qin = 0.0;
-			patch[0].Qout = 0.0;
+			state->Qin[i] = 0.0;
+			state->Qout[i] = 0.0;
 			if (grow_flag > 0) {
-				patch[0].soil_cs.DOC_Qin_total += patch[0].soil_cs.DOC_Qin;
-				patch[0].soil_cs.DOC_Qout_total += patch[0].soil_cs.DOC_Qout;
-				patch[0].soil_ns.NH4_Qin_total += patch[0].soil_ns.NH4_Qin;
-				patch[0].soil_ns.NH4_Qout_total += patch[0].soil_ns.NH4_Qout;
-				patch[0].soil_ns.NO3_Qin_total += patch[0].soil_ns.NO3_Qin;
-				patch[0].soil_ns.NO3_Qout_total += patch[0].soil_ns.NO3_Qout;
-				patch[0].soil_ns.DON_Qin_total += patch[0].soil_ns.DON_Qin;
-				patch[0].soil_ns.DON_Qout_total += patch[0].soil_ns.DON_Qout;
+				patch[0].soil_cs.DOC_Qin_total += state->DOC_Qin[i];
+				patch[0].soil_cs.DOC_Qout_total += state->DOC_Qout[i];
+				patch[0].soil_ns.NH4_Qin_total += state->NH4_Qin[i];
+				patch[0].soil_ns.NH4_Qout_total += state->NH4_Qout[i];
+				patch[0].soil_ns.NO3_Qin_total += state->NO3_Qin[i];
+				patch[0].soil_ns.NO3_Qout_total += state->NO3_Qout[i];
+				patch[0].soil_ns.DON_Qin_total += state->DON_Qin[i];
+				patch[0].soil_ns.DON_Qout_total += state->DON_Qout[i];
 				patch[0].surface_DON_Qin_total += patch[0].surface_DON_Qin;
 				patch[0].surface_DON_Qout_total += patch[0].surface_DON_Qout;
 				patch[0].surface_DOC_Qin_total += patch[0].surface_DOC_Qin;
 				patch[0].surface_DOC_Qout_total += patch[0].surface_DOC_Qout;
 
-				patch[0].soil_ns.NH4_Qin = 0.0;
-				patch[0].soil_ns.NH4_Qout = 0.0;
-				patch[0].soil_ns.NO3_Qin = 0.0;
-				patch[0].soil_ns.NO3_Qout = 0.0;
-				patch[0].soil_ns.DON_Qout = 0.0;
-				patch[0].soil_ns.DON_Qin = 0.0;
-				patch[0].soil_cs.DOC_Qout = 0.0;
-				patch[0].soil_cs.DOC_Qin = 0.0;
+				state->NH4_Qin[i] = 0.0;
+				state->NH4_Qout[i] = 0.0;
+				state->NO3_Qin[i] = 0.0;
+				state->NO3_Qout[i] = 0.0;
+				state->DON_Qout[i] = 0.0;
+				state->DON_Qin[i] = 0.0;
+				state->DOC_Qout[i] = 0.0;
+				state->DOC_Qin[i] = 0.0;
 				patch[0].surface_NH4_Qout = 0.0;
 				patch[0].surface_NH4_Qin = 0.0;
 				patch[0].surface_NO3_Qout = 0.0;
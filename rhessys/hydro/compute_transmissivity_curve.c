@@ -11,20 +11,18 @@
 /*								*/
 /*								*/
 /*	SYNOPSIS						*/
-/*	compute_transmissivity_curve(				*/
+/*	void compute_transmissivity_curve(			*/
 /*				double	,			*/
-/*				double	,			*/
-/*				double	)			*/
+/*				struct patch_object *,		*/
+/*				struct command_line_object *)	*/
 /*								*/
-/*	returns:						*/
+/*	sets up, for the patch:					*/
 /*	transmissivity - (unitless) multiplier for Ksat0 	*/
 /*		to calculate transmissivity over range of	*/
 /*		depths specified				*/
 /*								*/
 /*	OPTIONS							*/
-/*	double	m - Ksat decay parameter			*/
-/*	double	z - (m) depth to the water table		*/
-/*	double  D - maximum depth				*/
+/*	double	gamma - patch gamma				*/
 /*								*/
 /*	DESCRIPTION						*/
 /*								*/
@@ -39,53 +37,34 @@
 /*								*/
 /*	PROGRAMMER NOTES					*/
 /*								*/
+/*	the patch independent part of the curve is computed	*/
+/*	once per soil default by compute_transmissivity_table;	*/
+/*	a patch normally keeps only area/gamma and the number	*/
+/*	of top intervals limited by drainable water, and the	*/
+/*	curve is read through compute_patch_transmissivity.	*/
+/*	Only a patch on a soil that is not top_limited gets	*/
+/*	its own array (transmissivity_profile)			*/
+/*								*/
 /*--------------------------------------------------------------*/
 #include <stdio.h>
+#include <stdlib.h>
 #include <math.h>
 #include "rhessys.h"
 #include "phys_constants.h"
 
-double 	*compute_transmissivity_curve( 
+void	compute_transmissivity_curve(
 					double  gamma,
 					struct patch_object *patch,
 					struct command_line_object *command_line
 					)
 {
-
-	
 	/*--------------------------------------------------------------*/
 	/*	Local function definition.				*/
 	/*--------------------------------------------------------------*/
-	double compute_field_capacity(
-		int,
-		int,
-		double,
-		double,
-		double,
-		double,
-		double,
-		double,
-		double,
-		double,
-		double);
-
-
-	double	compute_delta_water(
-		int,
-		double,
-		double,
-		double,
-		double,
-		double);
-
-
-	double	compute_z_final(
+	struct transmissivity_table_object *compute_transmissivity_table(
+		struct soil_default *,
 		int,
-		double,
-		double,
-		double,
-		double,
-		double);
+		struct command_line_object *);
 
 	 void    *alloc( size_t, char *, char *);
 
@@ -94,94 +73,84 @@ double 	*compute_transmissivity_curve(
 	/*	Local variable definition.				*/
 	/*--------------------------------------------------------------*/
 
-	int didx,initial;
-	double	lower, depth, m;
-	double	lower_z, depth_z;
-	double start, fclayer, potential_sat;
+	int didx,initial,top,bottom;
 	double transmissivity_layer;
 	double *transmissivity;
+	struct soil_default *soil;
+	struct transmissivity_table_object *table;
 
-	m = patch[0].soil_defaults[0][0].m;
-
-	transmissivity = (double *) alloc((patch[0].num_soil_intervals+1) * sizeof(double),
-					"trans","compute_transmissivity_cuve");
-
+	/*--------------------------------------------------------------*/
+	/*	the soil's table, computed by the first of its patches	*/
+	/*--------------------------------------------------------------*/
+	soil = patch[0].soil_defaults[0];
+	table = soil[0].transmissivity_table;
+	if (table == NULL) {
+		table = compute_transmissivity_table(soil, patch[0].num_soil_intervals, command_line);
+		soil[0].transmissivity_table = table;
+	}
+	else if ((table[0].num_intervals != patch[0].num_soil_intervals)
+		|| (table[0].interval_size != soil[0].interval_size)) {
+		fprintf(stderr,
+			"FATAL ERROR: in compute_transmissivity_curve, soil default %d has patches with different soil intervals\n",
+			soil[0].ID);
+		exit(EXIT_FAILURE);
+	}
+	patch[0].transmissivity_table = table;
+	patch[0].transmissivity_profile = NULL;
+	patch[0].transmissivity_ratio = 0.0;
+	patch[0].transmissivity_limit = 0;
 
 	/*--------------------------------------------------------------*/
 	/*	for do not include surface overland flow or detention   */
 	/*	storage here						*/
 	/*--------------------------------------------------------------*/
-	if (patch[0].soil_defaults[0][0].soil_water_cap > patch[0].soil_defaults[0][0].interval_size) {
-		initial = patch[0].num_soil_intervals;
-		depth = patch[0].soil_defaults[0][0].soil_water_cap;
-		transmissivity[initial]=0.0;
-		initial = initial-1;
-		for (didx=initial; didx >= 0; didx -= 1) {
-			lower = depth;
-			depth = depth-patch[0].soil_defaults[0][0].interval_size;
-
-			
-			lower_z = compute_z_final(
-				command_line[0].verbose_flag,
-				patch[0].soil_defaults[0][0].porosity_0,
-				patch[0].soil_defaults[0][0].porosity_decay,
-				patch[0].soil_defaults[0][0].soil_depth,
-				0.0,
-				-1.0*lower);
-
-			depth_z = compute_z_final(
-				command_line[0].verbose_flag,
-				patch[0].soil_defaults[0][0].porosity_0,
-				patch[0].soil_defaults[0][0].porosity_decay,
-				patch[0].soil_defaults[0][0].soil_depth,
-				0.0,
-				-1.0*depth);
-
-	       		fclayer = compute_field_capacity(
-				command_line[0].verbose_flag,
-				patch[0].soil_defaults[0][0].theta_psi_curve,
-				patch[0].soil_defaults[0][0].psi_air_entry,
-				patch[0].soil_defaults[0][0].pore_size_index,
-				patch[0].soil_defaults[0][0].p3,
-				patch[0].soil_defaults[0][0].p4,
-				patch[0].soil_defaults[0][0].porosity_0,
-				patch[0].soil_defaults[0][0].porosity_decay,
-				patch[0].soil_defaults[0][0].soil_depth,
-				lower_z,
-				depth_z);
+	if (table[0].layer == NULL)
+		return;
 
+	/*--------------------------------------------------------------*/
+	/*	no transmissivity at all					*/
+	/*--------------------------------------------------------------*/
+	if (gamma <= ZERO) {
+		patch[0].transmissivity_limit = table[0].num_intervals;
+		return;
+	}
 
-		if (m > ZERO)
-			transmissivity_layer = gamma  
-			 * (exp ( -1.0 * (max(depth, 0.0)/ m)) - exp ( -1.0 * (lower/m))); 
-		else
-			transmissivity_layer =  gamma * (lower-depth);
+	/*--------------------------------------------------------------*/
+	/*	find the top intervals, limited by drainable water	*/
+	/*--------------------------------------------------------------*/
+	if (table[0].top_limited == 1) {
+		top = 0;
+		bottom = table[0].num_intervals;
+		while (top < bottom) {
+			didx = (top + bottom) / 2;
+			if (gamma * table[0].layer[didx] / patch[0].area > table[0].drainable[didx])
+				top = didx + 1;
+			else
+				bottom = didx;
+		}
+		patch[0].transmissivity_ratio = patch[0].area / gamma;
+		patch[0].transmissivity_limit = top;
+		return;
+	}
 
-		fclayer = max(patch[0].soil_defaults[0][0].interval_size-fclayer,0.0);
+	/*--------------------------------------------------------------*/
+	/*	otherwise the patch gets its own curve			*/
+	/*--------------------------------------------------------------*/
+	transmissivity = (double *) alloc((patch[0].num_soil_intervals+1) * sizeof(double),
+					"trans","compute_transmissivity_cuve");
 
-		transmissivity_layer = min(fclayer, transmissivity_layer/patch[0].area);  
+	initial = patch[0].num_soil_intervals;
+	transmissivity[initial]=0.0;
+	initial = initial-1;
+	for (didx=initial; didx >= 0; didx -= 1) {
+		transmissivity_layer = gamma * table[0].layer[didx];
 
-		if (gamma > ZERO)
-			transmissivity[didx] = transmissivity[didx+1]+transmissivity_layer * 
-				patch[0].area / gamma;
-		else
-			transmissivity[didx] = transmissivity[didx+1];
+		transmissivity_layer = min(table[0].drainable[didx], transmissivity_layer/patch[0].area);
 
-		}
+		transmissivity[didx] = transmissivity[didx+1]+transmissivity_layer *
+			patch[0].area / gamma;
 	}
-	
-	else {
-		initial = 1;
-		transmissivity[initial]=0.0;
-		lower = patch[0].soil_defaults[0][0].soil_water_cap;
-		depth = 0;
-		if (m > ZERO)
-			transmissivity[initial-1] =   (exp ( -1.0 * (max(depth, 0.0)/ m)) - exp ( -1.0 * (lower/m))); 
-		else
-			transmissivity[initial-1] =  (lower-depth);
-		
-		}
-
-	return(transmissivity);
+	patch[0].transmissivity_profile = transmissivity;
+	return;
 
 } /*compute_transmissivity_curve*/
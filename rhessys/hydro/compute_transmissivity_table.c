@@ -0,0 +1,188 @@
+/*--------------------------------------------------------------*/
+/* 								*/
+/*		compute_transmissivity_table			*/
+/*								*/
+/*	NAME							*/
+/*	compute_transmissivity_table - transmissivity of the	*/
+/*		soil intervals of a soil default, per unit	*/
+/*		gamma						*/
+/*								*/
+/*	SYNOPSIS						*/
+/*	struct transmissivity_table_object *			*/
+/*	compute_transmissivity_table(				*/
+/*			struct soil_default *,			*/
+/*			int ,					*/
+/*			struct command_line_object *)		*/
+/*								*/
+/*	OPTIONS							*/
+/*	soil - soil default the table is for			*/
+/*	num_intervals - number of soil intervals		*/
+/*								*/
+/*	DESCRIPTION						*/
+/*								*/
+/*	Computes, once for a soil default, everything of the	*/
+/*	transmissivity curve that does not depend on the patch:	*/
+/*	for each interval the exponential decay term (layer)	*/
+/*	and the water that can drain from it (drainable), and	*/
+/*	their sums over that interval and all below it		*/
+/*	(profile, drainable_profile).				*/
+/*								*/
+/*	A patch is limited by drainable water in interval i	*/
+/*	when layer[i] / drainable[i] > area / gamma.  When that	*/
+/*	ratio does not increase with depth (top_limited), the	*/
+/*	limited intervals of any patch are the top ones, and	*/
+/*	its whole curve follows from the two sums; see		*/
+/*	compute_patch_transmissivity.				*/
+/*								*/
+/*	PROGRAMMER NOTES					*/
+/*								*/
+/*	the loop is the one compute_transmissivity_curve used	*/
+/*	per patch, with gamma and patch area taken out		*/
+/*	the arrays have at least 2 entries - a soil whose	*/
+/*	water capacity is below one interval still gets a	*/
+/*	two point curve, which no patch can limit		*/
+/*--------------------------------------------------------------*/
+#include <stdio.h>
+#include <math.h>
+#include "rhessys.h"
+#include "phys_constants.h"
+
+struct transmissivity_table_object *compute_transmissivity_table(
+					struct soil_default *soil,
+					int num_intervals,
+					struct command_line_object *command_line
+					)
+{
+	/*--------------------------------------------------------------*/
+	/*	Local function definition.				*/
+	/*--------------------------------------------------------------*/
+	double compute_field_capacity(
+		int,
+		int,
+		double,
+		double,
+		double,
+		double,
+		double,
+		double,
+		double,
+		double,
+		double);
+
+	double	compute_z_final(
+		int,
+		double,
+		double,
+		double,
+		double,
+		double);
+
+	void    *alloc( size_t, char *, char *);
+
+	/*--------------------------------------------------------------*/
+	/*	Local variable definition.				*/
+	/*--------------------------------------------------------------*/
+	int didx, initial, size;
+	double	lower, depth, m;
+	double	lower_z, depth_z;
+	double	fclayer, layer, ratio, ratio_below;
+	struct	transmissivity_table_object *table;
+
+	m = soil[0].m;
+	size = max(num_intervals, 1) + 1;
+
+	table = (struct transmissivity_table_object *) alloc(
+		sizeof(struct transmissivity_table_object),
+		"table", "compute_transmissivity_table");
+	table[0].num_intervals = num_intervals;
+	table[0].interval_size = soil[0].interval_size;
+	table[0].top_limited = 1;
+	table[0].profile = (double *) alloc(size * sizeof(double),
+		"profile", "compute_transmissivity_table");
+
+	if (soil[0].soil_water_cap > soil[0].interval_size) {
+		table[0].layer = (double *) alloc(size * sizeof(double),
+			"layer", "compute_transmissivity_table");
+		table[0].drainable = (double *) alloc(size * sizeof(double),
+			"drainable", "compute_transmissivity_table");
+		table[0].drainable_profile = (double *) alloc(size * sizeof(double),
+			"drainable_profile", "compute_transmissivity_table");
+		initial = num_intervals;
+		depth = soil[0].soil_water_cap;
+		table[0].profile[initial] = 0.0;
+		table[0].drainable_profile[initial] = 0.0;
+		ratio_below = 0.0;
+		initial = initial-1;
+		for (didx=initial; didx >= 0; didx -= 1) {
+			lower = depth;
+			depth = depth-soil[0].interval_size;
+
+			lower_z = compute_z_final(
+				command_line[0].verbose_flag,
+				soil[0].porosity_0,
+				soil[0].porosity_decay,
+				soil[0].soil_depth,
+				0.0,
+				-1.0*lower);
+
+			depth_z = compute_z_final(
+				command_line[0].verbose_flag,
+				soil[0].porosity_0,
+				soil[0].porosity_decay,
+				soil[0].soil_depth,
+				0.0,
+				-1.0*depth);
+
+			fclayer = compute_field_capacity(
+				command_line[0].verbose_flag,
+				soil[0].theta_psi_curve,
+				soil[0].psi_air_entry,
+				soil[0].pore_size_index,
+				soil[0].p3,
+				soil[0].p4,
+				soil[0].porosity_0,
+				soil[0].porosity_decay,
+				soil[0].soil_depth,
+				lower_z,
+				depth_z);
+
+			if (m > ZERO)
+				layer = exp ( -1.0 * (max(depth, 0.0)/ m)) - exp ( -1.0 * (lower/m));
+			else
+				layer = lower-depth;
+
+			table[0].layer[didx] = layer;
+			table[0].drainable[didx] = max(soil[0].interval_size-fclayer,0.0);
+			table[0].profile[didx] = table[0].profile[didx+1] + layer;
+			table[0].drainable_profile[didx] = table[0].drainable_profile[didx+1]
+				+ table[0].drainable[didx];
+
+			/*--------------------------------------------------------------*/
+			/*	the interval is limited for area/gamma below ratio	*/
+			/*--------------------------------------------------------------*/
+			if (layer <= 0.0)
+				ratio = 0.0;
+			else if (table[0].drainable[didx] > 0.0)
+				ratio = layer / table[0].drainable[didx];
+			else
+				ratio = HUGE_VAL;
+			if (ratio < ratio_below)
+				table[0].top_limited = 0;
+			ratio_below = ratio;
+		}
+	}
+
+	else {
+		initial = 1;
+		table[0].profile[initial]=0.0;
+		lower = soil[0].soil_water_cap;
+		depth = 0;
+		if (m > ZERO)
+			table[0].profile[initial-1] =   (exp ( -1.0 * (max(depth, 0.0)/ m)) - exp ( -1.0 * (lower/m)));
+		else
+			table[0].profile[initial-1] =  (lower-depth);
+	}
+
+	return(table);
+
+} /*compute_transmissivity_table*/
@@ -13,7 +13,6 @@
 /*				double	,			*/
 /*				double	,			*/
 /*				double	,			*/
-/*				double	,			*/
 /*				struct patch_object *patch)	    	*/
 /*								*/
 /*	returns:						*/
@@ -47,7 +46,6 @@ double	compute_varbased_flow(
 				double s1,
 				double gamma,	
 				double interval_size,
-				double *transmissivity,
 				struct patch_object *patch)
 {
 
@@ -55,6 +53,9 @@ double	compute_varbased_flow(
 	/*--------------------------------------------------------------*/
 	/*	Local sub	definition				*/
 	/*--------------------------------------------------------------*/
+	double	compute_patch_transmissivity(
+		struct patch_object *,
+		int);
 
 	/*--------------------------------------------------------------*/
 	/*	Local variable definition.				*/
@@ -109,10 +110,10 @@ double	compute_varbased_flow(
 		didx = (int) lround((s1 + normal[i]*std)/interval_size);
 		if (didx > num_soil_intervals) didx = num_soil_intervals;
 
-		accum = transmissivity[didx] * 1;
+		accum = compute_patch_transmissivity(patch, didx) * 1;
 		/* fill and spill */
 		if ((patch[0].sat_deficit <= threshold) && ((s1 + normal[i]*std) <= threshold)){
-		    accum=transmissivity[didx] * 1;
+		    accum=compute_patch_transmissivity(patch, didx) * 1;
 		}
 
 		flow += accum * perc[i];
@@ -128,13 +129,13 @@ double	compute_varbased_flow(
 
 		/* if sat_deficit > threshold */
 		if(patch[0].sat_deficit > threshold){
-		    flow = transmissivity[didx] * fs_percolation; // fs_percolation defaults = 1 
+		    flow = compute_patch_transmissivity(patch, didx) * fs_percolation; // fs_percolation defaults = 1 
 
 		}
 		// if water level exceed moisture threshold (or sat_deficit <= soil deficit threshold)
 		else {
-		    thre_flow=transmissivity[didthr];
-		    abovthre_flow = (transmissivity[didx]-thre_flow) * fs_spill; // fs_spill default value is 1 
+		    thre_flow=compute_patch_transmissivity(patch, didthr);
+		    abovthre_flow = (compute_patch_transmissivity(patch, didx)-thre_flow) * fs_spill; // fs_spill default value is 1 
       		    flow = abovthre_flow + thre_flow * fs_percolation;  // fs_percolation defaults = 1
 		}
 
@@ -0,0 +1,143 @@
+/*--------------------------------------------------------------*/
+/* 											*/
+/*					update_drainage_frozen			*/
+/*											*/
+/*	update_drainage_frozen.c - routes the fixed outflow of a held patch	*/
+/*											*/
+/*	NAME										*/
+/*	update_drainage_frozen.c - routes the fixed outflow of a held patch	*/
+/*											*/
+/*	SYNOPSIS									*/
+/*	void update_drainage_frozen( 							*/
+/*				struct patch_object *patch,			*/
+/*				struct routing_state_object *state,		*/
+/*				struct command_line_object *command_line,	*/
+/*				double time_int,				*/
+/*				int verbose_flag,				*/
+/*				struct patch_outflow_object *outflow)		*/
+/*											*/
+/*	OPTIONS										*/
+/*											*/
+/*	DESCRIPTION									*/
+/*											*/
+/*	stands in for update_drainage_land for a land patch held at	*/
+/*	its spinup targets (-vegspinupfreeze).  The patch's stores	*/
+/*	are not used; each routing time step it sends its neighbours	*/
+/*	the mean subsurface and surface outflow (and nitrogen) of its	*/
+/*	last simulated year, kept in patch[0].boundary_flux, to the	*/
+/*	same neighbours and in the same shares as update_drainage_land	*/
+/*	(surface flow at the first innundation depth).  With		*/
+/*	-parallelrouting the flows go to its outflow buffer instead.	*/
+/*	Neighbours that are held too get nothing: they would drop	*/
+/*	it, and compute_subsurface_routing counts what held patches	*/
+/*	drop as water lost.						*/
+/*											*/
+/*	PROGRAMMER NOTES								*/
+/*											*/
+/*	nothing is taken from the patch - it is restored to the state	*/
+/*	it is held at by hold_frozen_patch				*/
+/*--------------------------------------------------------------*/
+#include <stdio.h>
+#include <string.h>
+#include "rhessys.h"
+
+void  update_drainage_frozen(
+					struct patch_object *patch,
+					struct routing_state_object *state,
+					struct command_line_object *command_line,
+					double time_int,
+					int verbose_flag,
+					struct patch_outflow_object *outflow)
+{
+	/*--------------------------------------------------------------*/
+	/*	Local function definition.				*/
+	/*--------------------------------------------------------------*/
+	void update_surface_inflow(
+		struct patch_object *,
+		struct routing_state_object *,
+		struct command_line_object *,
+		double,
+		double,
+		double,
+		double,
+		double,
+		double,
+		int);
+
+	/*--------------------------------------------------------------*/
+	/*	Local variable definition.				*/
+	/*--------------------------------------------------------------*/
+	int j, r;
+	double gamma;
+	struct patch_object *neigh;
+	struct patch_boundary_flux_object *flux;
+
+	flux = &(patch[0].boundary_flux);
+	if (outflow != NULL) {
+		memset(outflow, 0, sizeof(struct patch_outflow_object));
+		outflow[0].surface_d = -1;
+		outflow[0].overland_d = -1;
+	}
+	if (command_line[0].noredist_flag != 0)
+		return;
+
+	/*--------------------------------------------------------------*/
+	/* parallel routing - neighbours gather these			*/
+	/*--------------------------------------------------------------*/
+	if (outflow != NULL) {
+		outflow[0].route_to_patch = flux[0].route_to_patch;
+		outflow[0].NO3_to_patch = flux[0].NO3_to_patch;
+		outflow[0].NH4_to_patch = flux[0].NH4_to_patch;
+		outflow[0].DON_to_patch = flux[0].DON_to_patch;
+		outflow[0].DOC_to_patch = flux[0].DOC_to_patch;
+		outflow[0].route_to_surface = flux[0].route_to_surface;
+		outflow[0].NO3_to_surface = flux[0].NO3_to_surface;
+		outflow[0].NH4_to_surface = flux[0].NH4_to_surface;
+		outflow[0].DON_to_surface = flux[0].DON_to_surface;
+		outflow[0].DOC_to_surface = flux[0].DOC_to_surface;
+		outflow[0].surface_d = 0;
+		return;
+	}
+
+	/*--------------------------------------------------------------*/
+	/* subsurface water and nitrogen				*/
+	/*--------------------------------------------------------------*/
+	for (j = 0; j < patch[0].innundation_list[0].num_neighbours; j++) {
+		if (patch[0].innundation_list[0].neighbours[j].patch[0].frozen == 1)
+			continue;
+		r = patch[0].innundation_list[0].neighbours[j].route_index;
+		gamma = patch[0].innundation_list[0].neighbours[j].gamma;
+		if (command_line[0].grow_flag > 0) {
+			state->DON_Qin[r] += (gamma * flux[0].DON_to_patch) / state->area[r];
+			state->DOC_Qin[r] += (gamma * flux[0].DOC_to_patch) / state->area[r];
+			state->NO3_Qin[r] += (gamma * flux[0].NO3_to_patch) / state->area[r];
+			state->NH4_Qin[r] += (gamma * flux[0].NH4_to_patch) / state->area[r];
+			}
+		state->Qin[r] += (gamma * flux[0].route_to_patch) / state->area[r];
+	}
+
+	/*--------------------------------------------------------------*/
+	/* surface water and nitrogen					*/
+	/*--------------------------------------------------------------*/
+	if (flux[0].route_to_surface <= 0.0)
+		return;
+	for (j = 0; j < patch[0].surface_innundation_list[0].num_neighbours; j++) {
+		neigh = patch[0].surface_innundation_list[0].neighbours[j].patch;
+		if (neigh[0].frozen == 1)
+			continue;
+		gamma = patch[0].surface_innundation_list[0].neighbours[j].gamma;
+		update_surface_inflow(
+			neigh,
+			state,
+			command_line,
+			(gamma * flux[0].route_to_surface) / neigh[0].area,
+			(gamma * flux[0].NO3_to_surface) / neigh[0].area,
+			(gamma * flux[0].NH4_to_surface) / neigh[0].area,
+			(gamma * flux[0].DON_to_surface) / neigh[0].area,
+			(gamma * flux[0].DOC_to_surface) / neigh[0].area,
+			time_int,
+			verbose_flag);
+	}
+
+	return;
+} /*end update_drainage_frozen.c*/
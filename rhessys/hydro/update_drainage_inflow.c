@@ -0,0 +1,158 @@
+/*--------------------------------------------------------------*/
+/* 											*/
+/*					update_drainage_inflow			*/
+/*											*/
+/*	update_drainage_inflow.c - gathers routed water into a patch	*/
+/*											*/
+/*	NAME										*/
+/*	update_drainage_inflow.c - gathers routed water into a patch	*/
+/*											*/
+/*	SYNOPSIS									*/
+/*	void update_drainage_inflow( 							*/
+/*				struct routing_list_object *rlist,		*/
+/*				int i,						*/
+/*				struct command_line_object *command_line,	*/
+/*				double time_int,				*/
+/*				int verbose_flag)				*/
+/*											*/
+/*	OPTIONS										*/
+/*											*/
+/*	DESCRIPTION									*/
+/*											*/
+/*	parallel routing counterpart of the neighbour updates in	*/
+/*	update_drainage_land and update_drainage_road; patch i of	*/
+/*	the route list collects the subsurface, surface and road	*/
+/*	diversion flows that its upslope patches stored in their	*/
+/*	outflow buffers.  Links are visited in source order		*/
+/*	(see construct_routing_inflows) so results do not depend	*/
+/*	on the number of threads.					*/
+/*											*/
+/*	PROGRAMMER NOTES								*/
+/*											*/
+/*	only patch i is modified so all patches can be updated	*/
+/*	concurrently once every outflow buffer has been filled		*/
+/*	a patch held at its spinup targets takes nothing from held	*/
+/*	patches, as in update_drainage_frozen				*/
+/*--------------------------------------------------------------*/
+#include <stdio.h>
+#include "rhessys.h"
+
+
+void  update_drainage_inflow(
+					struct routing_list_object *rlist,
+					int i,
+					struct command_line_object *command_line,
+					double time_int,
+					int verbose_flag)
+{
+	/*--------------------------------------------------------------*/
+	/*	Local function definition.				*/
+	/*--------------------------------------------------------------*/
+	void update_surface_inflow(
+		struct patch_object *,
+		struct routing_state_object *,
+		struct command_line_object *,
+		double,
+		double,
+		double,
+		double,
+		double,
+		double,
+		int);
+
+	/*--------------------------------------------------------------*/
+	/*	Local variable definition.				*/
+	/*--------------------------------------------------------------*/
+	int l;
+	double gamma, Qin, Nin;
+	struct patch_object *patch;
+	struct patch_outflow_object *outflow;
+	struct routing_inflow_object *inflow;
+
+	patch = rlist->list[i];
+
+	for (l = rlist->inflow_start[i]; l < rlist->inflow_start[i+1]; l++) {
+		inflow = &(rlist->inflows[l]);
+		outflow = &(rlist->outflow[inflow->source]);
+		gamma = inflow->gamma;
+		if ((patch[0].frozen == 1)
+			&& (rlist->list[inflow->source][0].frozen == 1))
+			continue;
+
+		switch (inflow->type) {
+		/*--------------------------------------------------------------*/
+		/* subsurface water and nitrogen				*/
+		/*--------------------------------------------------------------*/
+		case SUBSURFACE_INFLOW:
+			Qin = (gamma * outflow->route_to_patch) / patch[0].area;
+			if (command_line[0].grow_flag > 0) {
+				Nin = (gamma * outflow->DON_to_patch) / patch[0].area;
+				rlist->state->DON_Qin[i] += Nin;
+				Nin = (gamma * outflow->DOC_to_patch) / patch[0].area;
+				rlist->state->DOC_Qin[i] += Nin;
+				Nin = (gamma * outflow->NO3_to_patch) / patch[0].area;
+				rlist->state->NO3_Qin[i] += Nin;
+				Nin = (gamma * outflow->NH4_to_patch) / patch[0].area;
+				rlist->state->NH4_Qin[i] += Nin;
+				}
+			rlist->state->Qin[i] += Qin;
+			break;
+
+		/*--------------------------------------------------------------*/
+		/* surface water and nitrogen; only links of the innundation	*/
+		/* depth chosen by the source patch are active		*/
+		/*--------------------------------------------------------------*/
+		case SURFACE_INFLOW:
+			if (inflow->d != outflow->surface_d)
+				break;
+			update_surface_inflow(
+				patch,
+				rlist->state,
+				command_line,
+				(gamma * outflow->route_to_surface) / patch[0].area,
+				(gamma * outflow->NO3_to_surface) / patch[0].area,
+				(gamma * outflow->NH4_to_surface) / patch[0].area,
+				(gamma * outflow->DON_to_surface) / patch[0].area,
+				(gamma * outflow->DOC_to_surface) / patch[0].area,
+				time_int,
+				verbose_flag);
+			break;
+
+		/*--------------------------------------------------------------*/
+		/* road infiltration excess and diversion to next_stream	*/
+		/*--------------------------------------------------------------*/
+		case ROAD_STREAM_INFLOW:
+			if (outflow->surface_to_stream > 0.0) {
+				if (command_line[0].grow_flag > 0) {
+					Nin = outflow->NO3_surface_to_stream / patch[0].area;
+					patch[0].streamflow_NO3 += Nin;
+					patch[0].streamNO3_from_surface += Nin;
+					patch[0].hourly[0].streamflow_NO3 += Nin;
+					patch[0].hourly[0].streamflow_NO3_from_surface += Nin;
+					patch[0].streamflow_NH4 += outflow->NH4_surface_to_stream / patch[0].area;
+					patch[0].streamflow_DON += outflow->DON_surface_to_stream / patch[0].area;
+					patch[0].streamflow_DOC += outflow->DOC_surface_to_stream / patch[0].area;
+					}
+				patch[0].streamflow += outflow->surface_to_stream / patch[0].area;
+				patch[0].hourly_sur2stream_flow += outflow->surface_to_stream / patch[0].area;
+				}
+
+			patch[0].streamflow += outflow->route_to_stream / patch[0].area;
+			patch[0].surface_Qin += outflow->route_to_stream / patch[0].area;
+			patch[0].hourly_sur2stream_flow += outflow->route_to_stream / patch[0].area;
+			if (command_line[0].grow_flag > 0) {
+				patch[0].streamflow_DON += outflow->DON_to_stream / patch[0].area;
+				patch[0].streamflow_DOC += outflow->DOC_to_stream / patch[0].area;
+				Nin = outflow->NO3_to_stream / patch[0].area;
+				patch[0].streamflow_NO3 += Nin;
+				patch[0].streamNO3_from_sub += Nin;
+				patch[0].hourly[0].streamflow_NO3 += Nin;
+				patch[0].hourly[0].streamflow_NO3_from_sub += Nin;
+				patch[0].streamflow_NH4 += outflow->NH4_to_stream / patch[0].area;
+				}
+			break;
+		}
+	}
+
+	return;
+} /*end update_drainage_inflow.c*/
@@ -10,11 +10,13 @@
 /*	SYNOPSIS									*/
 /*	void update_drainage_land( 							*/
 /*					struct patch_object *patch			*/
+/*					struct routing_state_object *state		*/
 /*				 			double,			 	*/
 /*				 			double,			 	*/
 /*				 			double,			 	*/
 /*							int,				*/
-/*							int)				*/
+/*							int,				*/
+/*					struct patch_outflow_object *outflow)		*/
 /*											*/
 /* 											*/
 /*											*/
@@ -28,7 +30,14 @@
 /*											*/
 /*	PROGRAMMER NOTES								*/
 /*											*/
+/*	if outflow is not NULL (parallel routing) water and	*/
+/*	nitrogen leaving the patch are stored in outflow and the	*/
+/*	neighbours are not updated; they gather it later in		*/
+/*	update_drainage_inflow						*/
 /*											*/
+/*	subsurface water and nitrogen fluxes (Qin, Qout and the	*/
+/*	N/DOC equivalents) are accumulated in the route list state	*/
+/*	arrays, not in the patch objects (see construct_routing_state) */
 /*--------------------------------------------------------------*/
 #include <stdio.h>
 #include "rhessys.h"
@@ -36,9 +45,11 @@
 
 void  update_drainage_land(
 					struct patch_object *patch,
+					 struct routing_state_object *state,
 					 struct command_line_object *command_line,
 					 double time_int,
-					 int verbose_flag)
+					 int verbose_flag,
+					 struct patch_outflow_object *outflow)
 {
 	/*--------------------------------------------------------------*/
 	/*	Local function definition.				*/
@@ -64,7 +75,6 @@ void  update_drainage_land(
 		double,
 		double,
 		double,
-		double *,
 		struct patch_object *);
 
 
@@ -87,23 +97,23 @@ void  update_drainage_land(
 		struct patch_object *,
 		double);
 
-
-	double compute_infiltration( int,
-		double,
-		double,
-		double,
+	void update_surface_inflow(
+		struct patch_object *,
+		struct routing_state_object *,
+		struct command_line_object *,
 		double,
 		double,
 		double,
 		double,
 		double,
 		double,
-		double);
-	
+		int);
+
+
 	/*--------------------------------------------------------------*/
 	/*	Local variable definition.				*/
 	/*--------------------------------------------------------------*/
-	int j, d, idx;
+	int j, d, r, idx;
 	double tmp;
 	double m, Ksat, std_scale;
 	double NH4_leached_to_patch, NH4_leached_to_stream;
@@ -121,7 +131,7 @@ void  update_drainage_land(
 	double return_flow,route_to_patch ;  /* m3 */
 	double available_sat_water; /* m3 */
 	double Qin, Qout;  /* m */
-	double innundation_depth, infiltration; /* m */
+	double innundation_depth; /* m */
 	double total_gamma;
 	double Nin, Nout; /* kg/m2 */ 
 	double t1,t2,t3;
@@ -175,7 +185,6 @@ void  update_drainage_land(
 		patch[0].sat_deficit,
 		total_gamma, 
 		patch[0].soil_defaults[0][0].interval_size,
-		patch[0].transmissivity_profile,
 		patch);
 
 
@@ -203,7 +212,7 @@ void  update_drainage_land(
 			patch[0].soil_defaults[0][0].NO3_adsorption_rate,
 			patch[0].transmissivity_profile);
 		NO3_leached_to_patch = Nout * patch[0].area;
-		patch[0].soil_ns.NO3_Qout += Nout;
+		state->NO3_Qout[patch[0].route_index] += Nout;
 
 
 		Nout = compute_N_leached(
@@ -222,7 +231,7 @@ void  update_drainage_land(
 			patch[0].soil_defaults[0][0].NH4_adsorption_rate,
 			patch[0].transmissivity_profile);
 		NH4_leached_to_patch = Nout * patch[0].area;
-		patch[0].soil_ns.NH4_Qout += Nout;
+		state->NH4_Qout[patch[0].route_index] += Nout;
 
 		Nout = compute_N_leached(
 			verbose_flag,
@@ -240,7 +249,7 @@ void  update_drainage_land(
 			patch[0].soil_defaults[0][0].DON_adsorption_rate,
 			patch[0].transmissivity_profile);
 		DON_leached_to_patch = Nout * patch[0].area;
-		patch[0].soil_ns.DON_Qout += Nout;
+		state->DON_Qout[patch[0].route_index] += Nout;
 
 		Nout = compute_N_leached(
 			verbose_flag,
@@ -258,13 +267,13 @@ void  update_drainage_land(
 			patch[0].soil_defaults[0][0].DOC_adsorption_rate,
 			patch[0].transmissivity_profile);
 		DOC_leached_to_patch = Nout * patch[0].area;
-		patch[0].soil_cs.DOC_Qout += Nout;
+		state->DOC_Qout[patch[0].route_index] += Nout;
 
 
 	}
 
 	
-	patch[0].Qout += (route_to_patch / patch[0].area);
+	state->Qout[patch[0].route_index] += (route_to_patch / patch[0].area);
 
 
 	/*--------------------------------------------------------------*/
@@ -310,7 +319,7 @@ void  update_drainage_land(
 				patch[0].soil_defaults[0][0].NO3_adsorption_rate,
 				patch[0].transmissivity_profile);
 			patch[0].surface_NO3 += Nout;
-			patch[0].soil_ns.NO3_Qout += Nout;
+			state->NO3_Qout[patch[0].route_index] += Nout;
 
 			Nout = compute_N_leached(
 				verbose_flag,
@@ -328,7 +337,7 @@ void  update_drainage_land(
 				patch[0].soil_defaults[0][0].NH4_adsorption_rate,
 				patch[0].transmissivity_profile);
 			patch[0].surface_NH4 += Nout;
-			patch[0].soil_ns.NH4_Qout += Nout;
+			state->NH4_Qout[patch[0].route_index] += Nout;
 
 
 			Nout = compute_N_leached(
@@ -347,7 +356,7 @@ void  update_drainage_land(
 				patch[0].soil_defaults[0][0].DON_adsorption_rate,
 				patch[0].transmissivity_profile);
 			patch[0].surface_DON += Nout;
-			patch[0].soil_ns.DON_Qout += Nout;
+			state->DON_Qout[patch[0].route_index] += Nout;
 
 			Nout = compute_N_leached(
 				verbose_flag,
@@ -365,7 +374,7 @@ void  update_drainage_land(
 				patch[0].soil_defaults[0][0].DOC_adsorption_rate,
 				patch[0].transmissivity_profile);
 			patch[0].surface_DOC += Nout;
-			patch[0].soil_cs.DOC_Qout += Nout;
+			state->DOC_Qout[patch[0].route_index] += Nout;
 		}
 	
 	/*--------------------------------------------------------------*/
@@ -401,6 +410,24 @@ void  update_drainage_land(
 	if (NO3_leached_to_surface < 0.0)
 		printf("WARNING %d %lf",patch[0].ID, NO3_leached_to_surface);
 
+	/*--------------------------------------------------------------*/
+	/*	outflow of the year, sent on if the patch is held at its	*/
+	/*	spinup targets (see update_drainage_frozen)					*/
+	/*--------------------------------------------------------------*/
+	if (command_line[0].vegspinup_freeze_flag == 1) {
+		patch[0].boundary_flux.steps += 1.0;
+		patch[0].boundary_flux.route_to_patch += route_to_patch;
+		patch[0].boundary_flux.NO3_to_patch += NO3_leached_to_patch;
+		patch[0].boundary_flux.NH4_to_patch += NH4_leached_to_patch;
+		patch[0].boundary_flux.DON_to_patch += DON_leached_to_patch;
+		patch[0].boundary_flux.DOC_to_patch += DOC_leached_to_patch;
+		patch[0].boundary_flux.route_to_surface += route_to_surface;
+		patch[0].boundary_flux.NO3_to_surface += NO3_leached_to_surface;
+		patch[0].boundary_flux.NH4_to_surface += NH4_leached_to_surface;
+		patch[0].boundary_flux.DON_to_surface += DON_leached_to_surface;
+		patch[0].boundary_flux.DOC_to_surface += DOC_leached_to_surface;
+	}
+
 	/*--------------------------------------------------------------*/
 	/*	route flow to neighbours				*/
 	/*	route n_leaching if grow flag specfied			*/
@@ -409,30 +436,47 @@ void  update_drainage_land(
 	/*--------------------------------------------------------------*/
 	/* regular downslope routing */
 	/*--------------------------------------------------------------*/
+	if (outflow != NULL)
+		outflow[0].surface_d = -1;
+
 	if (command_line[0].noredist_flag == 0) {
+	if (outflow != NULL) {
+		outflow[0].route_to_patch = route_to_patch;
+		outflow[0].NO3_to_patch = NO3_leached_to_patch;
+		outflow[0].NH4_to_patch = NH4_leached_to_patch;
+		outflow[0].DON_to_patch = DON_leached_to_patch;
+		outflow[0].DOC_to_patch = DOC_leached_to_patch;
+		outflow[0].route_to_surface = route_to_surface;
+		outflow[0].NO3_to_surface = NO3_leached_to_surface;
+		outflow[0].NH4_to_surface = NH4_leached_to_surface;
+		outflow[0].DON_to_surface = DON_leached_to_surface;
+		outflow[0].DOC_to_surface = DOC_leached_to_surface;
+		}
+
 	d=0;
+	if (outflow == NULL)
 	for (j = 0; j < patch[0].innundation_list[d].num_neighbours; j++) {
-		neigh = patch[0].innundation_list[d].neighbours[j].patch;  
+		r = patch[0].innundation_list[d].neighbours[j].route_index;
 		/*--------------------------------------------------------------*/
 		/* first transfer subsurface water and nitrogen */
 		/*--------------------------------------------------------------*/
-		Qin =	(patch[0].innundation_list[d].neighbours[j].gamma * route_to_patch) / neigh[0].area;
+		Qin =	(patch[0].innundation_list[d].neighbours[j].gamma * route_to_patch) / state->area[r];
 		if (Qin < 0) printf("\n warning negative routing from patch %d with gamma %lf", patch[0].ID, total_gamma);
 		if (command_line[0].grow_flag > 0) {
 			Nin = (patch[0].innundation_list[d].neighbours[j].gamma * DON_leached_to_patch) 
-				/ neigh[0].area;
-			neigh[0].soil_ns.DON_Qin += Nin;
+				/ state->area[r];
+			state->DON_Qin[r] += Nin;
 			Nin = (patch[0].innundation_list[d].neighbours[j].gamma * DOC_leached_to_patch) 
-				/ neigh[0].area;
-			neigh[0].soil_cs.DOC_Qin += Nin;
+				/ state->area[r];
+			state->DOC_Qin[r] += Nin;
 			Nin = (patch[0].innundation_list[d].neighbours[j].gamma * NO3_leached_to_patch) 
-				/ neigh[0].area;
-			neigh[0].soil_ns.NO3_Qin += Nin;
+				/ state->area[r];
+			state->NO3_Qin[r] += Nin;
 			Nin = (patch[0].innundation_list[d].neighbours[j].gamma * NH4_leached_to_patch) 
-				/ neigh[0].area;
-			neigh[0].soil_ns.NH4_Qin += Nin;
+				/ state->area[r];
+			state->NH4_Qin[r] += Nin;
 			}
-		neigh[0].Qin += Qin;
+		state->Qin[r] += Qin;
 	}
 
 	/*--------------------------------------------------------------*/
@@ -449,120 +493,28 @@ void  update_drainage_land(
 			d++;}
 		}
 	else d=0;
+	if (outflow != NULL)
+		outflow[0].surface_d = d;
+	else
 	for (j = 0; j < patch[0].surface_innundation_list[d].num_neighbours; j++) {
 
 		neigh = patch[0].surface_innundation_list[d].neighbours[j].patch;
 
 		/*--------------------------------------------------------------*/
-		/* now transfer surface water and nitrogen */
-		/*	- first nitrogen					*/
-		/*--------------------------------------------------------------*/
-		if (command_line[0].grow_flag > 0) {
-			Nin = (patch[0].surface_innundation_list[d].neighbours[j].gamma * NO3_leached_to_surface) / neigh[0].area;
-			neigh[0].surface_NO3 += Nin;
-			Nin = (patch[0].surface_innundation_list[d].neighbours[j].gamma * NH4_leached_to_surface) / neigh[0].area;
-			neigh[0].surface_NH4 += Nin;
-			Nin = (patch[0].surface_innundation_list[d].neighbours[j].gamma * DON_leached_to_surface) / neigh[0].area;
-			neigh[0].surface_DON += Nin;
-			Nin = (patch[0].surface_innundation_list[d].neighbours[j].gamma * DOC_leached_to_surface) / neigh[0].area;
-			neigh[0].surface_DOC += Nin;
-			}
-		
+		/* now transfer surface water and nitrogen and infiltrate it	*/
 		/*--------------------------------------------------------------*/
-		/*	- now surface water 					*/
-		/*	surface stores should be updated to facilitate transfer */
-		/* added net surface water transfer to detention store		*/
-		/*--------------------------------------------------------------*/
-
 		Qin = (patch[0].surface_innundation_list[d].neighbours[j].gamma * route_to_surface) / neigh[0].area;
-		neigh[0].detention_store += Qin;// need fix this
-		neigh[0].surface_Qin += Qin;
-		
-		/*--------------------------------------------------------------*/
-		/* try to infiltrate this water					*/ 
-		/* use time_int as duration */
-		/*--------------------------------------------------------------*/
-		if (neigh[0].detention_store > ZERO) {
-			if (neigh[0].rootzone.depth > ZERO) {
-			infiltration = compute_infiltration(
-				verbose_flag,
-				neigh[0].sat_deficit_z,
-				neigh[0].rootzone.S,
-				neigh[0].Ksat_vertical,
-				neigh[0].soil_defaults[0][0].Ksat_0_v,
-				neigh[0].soil_defaults[0][0].mz_v,
-				neigh[0].soil_defaults[0][0].porosity_0,
-				neigh[0].soil_defaults[0][0].porosity_decay,
-				(neigh[0].detention_store),	
-				time_int,
-				neigh[0].soil_defaults[0][0].psi_air_entry);
-			}
-			else {
-			infiltration = compute_infiltration(
-				verbose_flag,
-				neigh[0].sat_deficit_z,
-				neigh[0].S,
-				neigh[0].Ksat_vertical,
-				neigh[0].soil_defaults[0][0].Ksat_0_v,
-				neigh[0].soil_defaults[0][0].mz_v,
-				neigh[0].soil_defaults[0][0].porosity_0,
-				neigh[0].soil_defaults[0][0].porosity_decay,
-				(neigh[0].detention_store),	
-				time_int,
-				neigh[0].soil_defaults[0][0].psi_air_entry);
-			}
-		}
-		else infiltration = 0.0;
-		/*--------------------------------------------------------------*/
-		/* added an surface N flux to surface N pool	and		*/
-		/* allow infiltration of surface N				*/
-		/*--------------------------------------------------------------*/
-		if ((command_line[0].grow_flag > 0 ) && (infiltration > ZERO)) {
-			neigh[0].soil_cs.DOC_Qin += ((infiltration / neigh[0].detention_store) * neigh[0].surface_DOC);
-			neigh[0].surface_DOC -= ((infiltration / neigh[0].detention_store) * neigh[0].surface_DOC);
-			neigh[0].soil_ns.DON_Qin += ((infiltration / neigh[0].detention_store) * neigh[0].surface_DON);
-			neigh[0].surface_DON -= ((infiltration / neigh[0].detention_store) * neigh[0].surface_DON);
-			neigh[0].soil_ns.NO3_Qin += ((infiltration / neigh[0].detention_store) * neigh[0].surface_NO3);
-			neigh[0].surface_NO3 -= ((infiltration / neigh[0].detention_store) * neigh[0].surface_NO3);
-			neigh[0].soil_ns.NH4_Qin += ((infiltration / neigh[0].detention_store) * neigh[0].surface_NH4);
-			neigh[0].surface_NH4 -= ((infiltration / neigh[0].detention_store) * neigh[0].surface_NH4);
-		}
-
-		if (infiltration > neigh[0].sat_deficit - neigh[0].unsat_storage - neigh[0].rz_storage) {
-			neigh[0].sat_deficit -= (infiltration + neigh[0].unsat_storage + neigh[0].rz_storage);
-			neigh[0].unsat_storage = 0.0; 
-			neigh[0].rz_storage = 0.0; 
-			neigh[0].field_capacity = 0.0; 
-			neigh[0].rootzone.field_capacity = 0.0; 
-		}
-
-		else if ((neigh[0].sat_deficit > neigh[0].rootzone.potential_sat) &&
-			(infiltration > neigh[0].rootzone.potential_sat - neigh[0].rz_storage)) {
-		/*------------------------------------------------------------------------------*/
-		/*		Just add the infiltration to the rz_storage and unsat_storage	*/
-		/*------------------------------------------------------------------------------*/
-			neigh[0].unsat_storage += infiltration - (neigh[0].rootzone.potential_sat - neigh[0].rz_storage);
-			neigh[0].rz_storage = neigh[0].rootzone.potential_sat;
-		}								
-		/* Only rootzone layer saturated - perched water table case */
-		else if ((neigh[0].sat_deficit > neigh[0].rootzone.potential_sat) &&
-			(infiltration <= neigh[0].rootzone.potential_sat - neigh[0].rz_storage)) {
-			/*--------------------------------------------------------------*/
-			/*		Just add the infiltration to the rz_storage	*/
-			/*--------------------------------------------------------------*/
-			neigh[0].rz_storage += infiltration;
-		}
-		else if ((neigh[0].sat_deficit <= neigh[0].rootzone.potential_sat) &&
-			(infiltration <= neigh[0].sat_deficit - neigh[0].rz_storage - neigh[0].unsat_storage)) {
-			neigh[0].rz_storage += neigh[0].unsat_storage;		
-			/* transfer left water in unsat storage to rootzone layer */
-			neigh[0].unsat_storage = 0;
-			neigh[0].rz_storage += infiltration;
-			neigh[0].field_capacity = 0;
-		}
-
-		neigh[0].detention_store -= infiltration;
-
+		update_surface_inflow(
+			neigh,
+			state,
+			command_line,
+			Qin,
+			(patch[0].surface_innundation_list[d].neighbours[j].gamma * NO3_leached_to_surface) / neigh[0].area,
+			(patch[0].surface_innundation_list[d].neighbours[j].gamma * NH4_leached_to_surface) / neigh[0].area,
+			(patch[0].surface_innundation_list[d].neighbours[j].gamma * DON_leached_to_surface) / neigh[0].area,
+			(patch[0].surface_innundation_list[d].neighbours[j].gamma * DOC_leached_to_surface) / neigh[0].area,
+			time_int,
+			verbose_flag);
 	}
 
 	} /* end if redistribution flag */
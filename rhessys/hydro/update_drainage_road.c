@@ -10,11 +10,13 @@
 /*	SYNOPSIS									*/
 /*	void update_drainage_road( 							*/
 /*					struct patch_object *patch			*/
+/*					struct routing_state_object *state		*/
 /*				 			double,			 	*/
 /*				 			double,			 	*/
 /*				 			double,			 	*/
 /*							int,				*/
-/*							int)				*/
+/*							int,				*/
+/*					struct patch_outflow_object *outflow)		*/
 /*											*/
 /* 											*/
 /*											*/
@@ -28,7 +30,9 @@
 /*											*/
 /*	PROGRAMMER NOTES								*/
 /*											*/
-/*											*/
+/*	if outflow is not NULL (parallel routing) water and	*/
+/*	nitrogen sent to next_stream and downslope patches are	*/
+/*	stored in outflow (as m3 and kg) instead			*/
 /*--------------------------------------------------------------*/
 #include <stdio.h>
 #include "rhessys.h"
@@ -36,9 +40,11 @@
 
 void  update_drainage_road(
 								 struct patch_object *patch,
+								 struct routing_state_object *state,
 								 struct command_line_object *command_line,
 								 double time_int,
-								 int verbose_flag)
+								 int verbose_flag,
+								 struct patch_outflow_object *outflow)
 {
 	/*--------------------------------------------------------------*/
 	/*	Local function definition.				*/
@@ -73,7 +79,6 @@ void  update_drainage_road(
 		double,
 		double,
 		double,
-		double *,
 		struct patch_object *patch);
 
 	double recompute_gamma(	
@@ -90,7 +95,7 @@ void  update_drainage_road(
 	/*--------------------------------------------------------------*/
 	/*	Local variable definition.				*/
 	/*--------------------------------------------------------------*/
-	int i, j,k,d;
+	int i, j,k,d,r;
 	double m, Ksat, return_flow;
 	double NO3_leached_to_patch, NO3_leached_to_stream, NO3_surface_leached_to_stream; /* kg/m2 */
 	double NH4_leached_to_patch, NH4_leached_to_stream, NH4_surface_leached_to_stream; /* kg/m2 */
@@ -104,11 +109,11 @@ void  update_drainage_road(
 	double road_int_depth;  /* m of H2O */
 	double available_sat_water, route_total; /* m3 */
 	double  Qin, Qout, Qstr_total;  /* m */
+	double	surface_to_stream;  /* m3 */
 	double total_gamma, percent_loss;
 	double Nin, Nout; /* kg/m2 */ 
 	double percent_tobe_routed;
 
-	struct patch_object *neigh;
 
 	DOC_leached_to_patch = 0.0;
 	DOC_leached_to_stream = 0.0;
@@ -124,6 +129,7 @@ void  update_drainage_road(
 	NO3_surface_leached_to_stream = 0.0;
 	route_to_stream = 0.0;
 	route_to_patch = 0.0;
+	surface_to_stream = 0.0;
 	return_flow=0.0;
 
 
@@ -168,7 +174,6 @@ void  update_drainage_road(
 			road_int_depth,
 			total_gamma, 
 			patch[0].soil_defaults[0][0].interval_size,
-			patch[0].transmissivity_profile,
 			patch);
 
 		/*-----------------------------------------------------------*/
@@ -180,7 +185,6 @@ void  update_drainage_road(
 			patch[0].sat_deficit,
 			total_gamma, 
 			patch[0].soil_defaults[0][0].interval_size,
-			patch[0].transmissivity_profile,
 			patch) - route_to_patch;
 
 		if (route_to_patch < 0.0) route_to_patch = 0.0;
@@ -225,7 +229,7 @@ void  update_drainage_road(
 				patch[0].transmissivity_profile) -
 				NO3_leached_to_patch;
 			if (NO3_leached_to_stream < 0.0) NO3_leached_to_stream = 0.0;	
-			patch[0].soil_ns.NO3_Qout += (NO3_leached_to_patch + NO3_leached_to_stream);
+			state->NO3_Qout[patch[0].route_index] += (NO3_leached_to_patch + NO3_leached_to_stream);
 
 			NH4_leached_to_patch = compute_N_leached(
 				verbose_flag,
@@ -259,7 +263,7 @@ void  update_drainage_road(
 				patch[0].transmissivity_profile) -
 				NH4_leached_to_patch;
 			if (NH4_leached_to_stream < 0.0) NH4_leached_to_stream = 0.0;
-			patch[0].soil_ns.NH4_Qout += (NH4_leached_to_patch + NH4_leached_to_stream);
+			state->NH4_Qout[patch[0].route_index] += (NH4_leached_to_patch + NH4_leached_to_stream);
 
 
 			DON_leached_to_patch = compute_N_leached(
@@ -295,7 +299,7 @@ void  update_drainage_road(
 				DON_leached_to_patch;
                      if (DON_leached_to_stream < 0.0) DON_leached_to_stream = 0.0;
 
-			patch[0].soil_ns.DON_Qout += (DON_leached_to_patch + DON_leached_to_stream);
+			state->DON_Qout[patch[0].route_index] += (DON_leached_to_patch + DON_leached_to_stream);
 
 
 			DOC_leached_to_patch = compute_N_leached(
@@ -332,10 +336,10 @@ void  update_drainage_road(
 
 			if (DOC_leached_to_stream < 0.0) DOC_leached_to_stream = 0.0;
 		      
-			patch[0].soil_cs.DOC_Qout += (DOC_leached_to_patch + DOC_leached_to_stream);
+			state->DOC_Qout[patch[0].route_index] += (DOC_leached_to_patch + DOC_leached_to_stream);
 					 
 		}
-		patch[0].Qout += ((route_to_patch + route_to_stream) / patch[0].area);
+		state->Qout[patch[0].route_index] += ((route_to_patch + route_to_stream) / patch[0].area);
 
 		
 	}
@@ -350,7 +354,6 @@ void  update_drainage_road(
 			patch[0].sat_deficit,
 			total_gamma, 
 			patch[0].soil_defaults[0][0].interval_size,
-			patch[0].transmissivity_profile,
 			patch);
 
 		if (route_to_patch < 0.0) route_to_patch = 0.0;
@@ -376,7 +379,7 @@ void  update_drainage_road(
 				patch[0].soil_defaults[0][0].NO3_adsorption_rate,
 				patch[0].transmissivity_profile);
 			NO3_leached_to_stream = 0.0;
-			patch[0].soil_ns.NO3_Qout += (NO3_leached_to_patch + NO3_leached_to_stream);
+			state->NO3_Qout[patch[0].route_index] += (NO3_leached_to_patch + NO3_leached_to_stream);
 
 
 			NH4_leached_to_patch = compute_N_leached(
@@ -395,7 +398,7 @@ void  update_drainage_road(
 				patch[0].soil_defaults[0][0].NH4_adsorption_rate,
 				patch[0].transmissivity_profile);
 			NH4_leached_to_stream = 0.0;
-			patch[0].soil_ns.NH4_Qout += (NH4_leached_to_patch + NH4_leached_to_stream);
+			state->NH4_Qout[patch[0].route_index] += (NH4_leached_to_patch + NH4_leached_to_stream);
 
 
 			DON_leached_to_patch = compute_N_leached(
@@ -414,7 +417,7 @@ void  update_drainage_road(
 				patch[0].soil_defaults[0][0].DON_adsorption_rate,
 				patch[0].transmissivity_profile);
 			DON_leached_to_stream = 0.0;
-			patch[0].soil_ns.DON_Qout += (DON_leached_to_patch + DON_leached_to_stream);
+			state->DON_Qout[patch[0].route_index] += (DON_leached_to_patch + DON_leached_to_stream);
 
 
 			DOC_leached_to_patch = compute_N_leached(
@@ -433,11 +436,11 @@ void  update_drainage_road(
 				patch[0].soil_defaults[0][0].DOC_adsorption_rate,
 				patch[0].transmissivity_profile);
 			DOC_leached_to_stream = 0.0;
-			patch[0].soil_cs.DOC_Qout += (DOC_leached_to_patch + DOC_leached_to_stream);
+			state->DOC_Qout[patch[0].route_index] += (DOC_leached_to_patch + DOC_leached_to_stream);
 
 		}
 
-		patch[0].Qout += ((route_to_patch + route_to_stream) / patch[0].area);
+		state->Qout[patch[0].route_index] += ((route_to_patch + route_to_stream) / patch[0].area);
 		
 	}
 
@@ -484,7 +487,7 @@ void  update_drainage_road(
 			patch[0].soil_defaults[0][0].NO3_adsorption_rate,
 			patch[0].transmissivity_profile);
 		patch[0].surface_NO3 += Nout;
-		patch[0].soil_ns.NO3_Qout += Nout;
+		state->NO3_Qout[patch[0].route_index] += Nout;
 
 
 		Nout = compute_N_leached(
@@ -503,7 +506,7 @@ void  update_drainage_road(
 			patch[0].soil_defaults[0][0].NH4_adsorption_rate,
 			patch[0].transmissivity_profile);
 		patch[0].surface_NH4 += Nout;
-		patch[0].soil_ns.NH4_Qout += Nout;
+		state->NH4_Qout[patch[0].route_index] += Nout;
 
 
 		Nout = compute_N_leached(
@@ -522,7 +525,7 @@ void  update_drainage_road(
 			patch[0].soil_defaults[0][0].DON_adsorption_rate,
 			patch[0].transmissivity_profile);
 		patch[0].surface_DON += Nout;
-		patch[0].soil_ns.DON_Qout += Nout;
+		state->DON_Qout[patch[0].route_index] += Nout;
 
 
 		Nout = compute_N_leached(
@@ -541,7 +544,7 @@ void  update_drainage_road(
 			patch[0].soil_defaults[0][0].DOC_adsorption_rate,
 			patch[0].transmissivity_profile);
 		patch[0].surface_DOC += Nout;
-		patch[0].soil_cs.DOC_Qout += Nout;
+		state->DOC_Qout[patch[0].route_index] += Nout;
 
 		
 		}
@@ -554,26 +557,61 @@ void  update_drainage_road(
 		(patch[0].detention_store > ZERO) ) {
 		Qout = (patch[0].detention_store - patch[0].soil_defaults[0][0].detention_store_size);
 		if (command_line[0].grow_flag > 0) {
-			Nout = (min(1.0, (Qout/ patch[0].detention_store))) * patch[0].surface_NO3;
-			patch[0].surface_NO3  -= Nout;
+			NO3_surface_leached_to_stream = (min(1.0, (Qout/ patch[0].detention_store))) * patch[0].surface_NO3;
+			NH4_surface_leached_to_stream = (min(1.0, (Qout/ patch[0].detention_store))) * patch[0].surface_NH4;
+			DON_surface_leached_to_stream = (min(1.0, (Qout/ patch[0].detention_store))) * patch[0].surface_DON;
+			DOC_surface_leached_to_stream = (min(1.0, (Qout/ patch[0].detention_store))) * patch[0].surface_DOC;
+			patch[0].surface_NO3  -= NO3_surface_leached_to_stream;
+			patch[0].surface_NH4  -= NH4_surface_leached_to_stream;
+			patch[0].surface_DON  -= DON_surface_leached_to_stream;
+			patch[0].surface_DOC  -= DOC_surface_leached_to_stream;
+			}
+		surface_to_stream = Qout;
+		patch[0].detention_store -= Qout;
+		}
+
+	if (outflow != NULL) {
+		/*--------------------------------------------------------------*/
+		/*	parallel routing - next_stream and neighbours gather	*/
+		/*	these in update_drainage_inflow				*/
+		/*--------------------------------------------------------------*/
+		outflow[0].surface_d = -1;
+		outflow[0].route_to_patch = route_to_patch;
+		outflow[0].NO3_to_patch = NO3_leached_to_patch * patch[0].area;
+		outflow[0].NH4_to_patch = NH4_leached_to_patch * patch[0].area;
+		outflow[0].DON_to_patch = DON_leached_to_patch * patch[0].area;
+		outflow[0].DOC_to_patch = DOC_leached_to_patch * patch[0].area;
+		outflow[0].route_to_stream = route_to_stream;
+		outflow[0].NO3_to_stream = NO3_leached_to_stream * patch[0].area;
+		outflow[0].NH4_to_stream = NH4_leached_to_stream * patch[0].area;
+		outflow[0].DON_to_stream = DON_leached_to_stream * patch[0].area;
+		outflow[0].DOC_to_stream = DOC_leached_to_stream * patch[0].area;
+		outflow[0].surface_to_stream = surface_to_stream * patch[0].area;
+		outflow[0].NO3_surface_to_stream = NO3_surface_leached_to_stream * patch[0].area;
+		outflow[0].NH4_surface_to_stream = NH4_surface_leached_to_stream * patch[0].area;
+		outflow[0].DON_surface_to_stream = DON_surface_leached_to_stream * patch[0].area;
+		outflow[0].DOC_surface_to_stream = DOC_surface_leached_to_stream * patch[0].area;
+		return;
+		}
+
+	if (surface_to_stream > 0.0) {
+		if (command_line[0].grow_flag > 0) {
+			Nout = NO3_surface_leached_to_stream;
 			patch[0].next_stream[0].streamflow_NO3 += (Nout * patch[0].area / patch[0].next_stream[0].area);
 			patch[0].next_stream[0].streamNO3_from_surface += (Nout * patch[0].area / patch[0].next_stream[0].area);
 			patch[0].next_stream[0].hourly[0].streamflow_NO3 += (Nout * patch[0].area / patch[0].next_stream[0].area);
 			patch[0].next_stream[0].hourly[0].streamflow_NO3_from_surface =+ (Nout * patch[0].area / patch[0].next_stream[0].area);
 
-			Nout = (min(1.0, (Qout/ patch[0].detention_store))) * patch[0].surface_NH4;
-			patch[0].surface_NH4  -= Nout;
+			Nout = NH4_surface_leached_to_stream;
 			patch[0].next_stream[0].streamflow_NH4 += (Nout * patch[0].area / patch[0].next_stream[0].area);
-			Nout = (min(1.0, (Qout/ patch[0].detention_store))) * patch[0].surface_DON;
-			patch[0].surface_DON  -= Nout;
+			Nout = DON_surface_leached_to_stream;
 			patch[0].next_stream[0].streamflow_DON += (Nout * patch[0].area / patch[0].next_stream[0].area);
-			Nout = (min(1.0, (Qout/ patch[0].detention_store))) * patch[0].surface_DOC;
-			patch[0].surface_DOC  -= Nout;
+			Nout = DOC_surface_leached_to_stream;
 			patch[0].next_stream[0].streamflow_DOC += (Nout * patch[0].area / patch[0].next_stream[0].area);
 			}
+		Qout = surface_to_stream;
 		patch[0].next_stream[0].streamflow += (Qout * patch[0].area / patch[0].next_stream[0].area);
 		patch[0].next_stream[0].hourly_sur2stream_flow += Qout *  patch[0].area / patch[0].next_stream[0].area;
-		patch[0].detention_store -= Qout;
 		}
 		
 
@@ -615,26 +653,26 @@ void  update_drainage_road(
 	/*--------------------------------------------------------------*/
 	d=0;
 	for (j = 0; j < patch[0].innundation_list[d].num_neighbours; j++) {
-		neigh = patch[0].innundation_list[d].neighbours[j].patch;  
+		r = patch[0].innundation_list[d].neighbours[j].route_index;
 		/*--------------------------------------------------------------*/
 		/* first transfer subsurface water and nitrogen */
 		/*--------------------------------------------------------------*/
-		Qin =	(patch[0].innundation_list[d].neighbours[j].gamma * route_to_patch) / neigh[0].area;
+		Qin =	(patch[0].innundation_list[d].neighbours[j].gamma * route_to_patch) / state->area[r];
 		if (command_line[0].grow_flag > 0) {
 			Nin = (patch[0].innundation_list[d].neighbours[j].gamma * NO3_leached_to_patch * patch[0].area) 
-				/ neigh[0].area;
-			neigh[0].soil_ns.NO3_Qin += Nin;
+				/ state->area[r];
+			state->NO3_Qin[r] += Nin;
 			Nin = (patch[0].innundation_list[d].neighbours[j].gamma * NH4_leached_to_patch * patch[0].area) 
-				/ neigh[0].area;
-			neigh[0].soil_ns.NH4_Qin += Nin;
+				/ state->area[r];
+			state->NH4_Qin[r] += Nin;
 			Nin = (patch[0].innundation_list[d].neighbours[j].gamma * DON_leached_to_patch * patch[0].area) 
-				/ neigh[0].area;
-			neigh[0].soil_ns.DON_Qin += Nin;
+				/ state->area[r];
+			state->DON_Qin[r] += Nin;
 			Nin = (patch[0].innundation_list[d].neighbours[j].gamma * DOC_leached_to_patch * patch[0].area) 
-				/ neigh[0].area;
-			neigh[0].soil_cs.DOC_Qin += Nin;
+				/ state->area[r];
+			state->DOC_Qin[r] += Nin;
 			}
-		neigh[0].Qin += Qin;
+		state->Qin[r] += Qin;
 
 
 	}
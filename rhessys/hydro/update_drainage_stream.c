@@ -10,6 +10,7 @@
 /*	SYNOPSIS									*/
 /*	void update_drainage_stream( 							*/
 /*					struct patch_object *patch			*/
+/*					struct routing_state_object *state		*/
 /*				 			double,			 	*/
 /*				 			double,			 	*/
 /*				 			double,			 	*/
@@ -36,6 +37,7 @@
 
 void  update_drainage_stream(
 								 struct patch_object *patch,
+								 struct routing_state_object *state,
 								 struct command_line_object *command_line,
 								 double time_int,
 								 int verbose_flag)
@@ -84,7 +86,6 @@ void  update_drainage_stream(
 		double,
 		double,
 		double,
-		double *,
 		struct patch_object *patch);
 
 	double recompute_gamma(	
@@ -148,7 +149,6 @@ void  update_drainage_stream(
 		patch[0].sat_deficit,
 		gamma,
 		patch[0].soil_defaults[0][0].interval_size,
-		patch[0].transmissivity_profile,
 		patch);
 
 	if (route_to_stream < 0.0) route_to_stream = 0.0;
@@ -174,7 +174,7 @@ void  update_drainage_stream(
 			patch[0].soil_defaults[0][0].soil_depth,
 			patch[0].soil_defaults[0][0].NO3_adsorption_rate,
 			patch[0].transmissivity_profile);
-		patch[0].soil_ns.NO3_Qout += NO3_leached_to_stream;
+		state->NO3_Qout[patch[0].route_index] += NO3_leached_to_stream;
 
 
 		NH4_leached_to_stream = compute_N_leached(
@@ -192,7 +192,7 @@ void  update_drainage_stream(
 			patch[0].soil_defaults[0][0].soil_depth,
 			patch[0].soil_defaults[0][0].NH4_adsorption_rate,
 			patch[0].transmissivity_profile);
-		patch[0].soil_ns.NH4_Qout += NH4_leached_to_stream;
+		state->NH4_Qout[patch[0].route_index] += NH4_leached_to_stream;
 
 		DON_leached_to_stream = compute_N_leached(
 			verbose_flag,
@@ -209,7 +209,7 @@ void  update_drainage_stream(
 			patch[0].soil_defaults[0][0].soil_depth,
 			patch[0].soil_defaults[0][0].DON_adsorption_rate,
 			patch[0].transmissivity_profile);
-		patch[0].soil_ns.DON_Qout += DON_leached_to_stream;
+		state->DON_Qout[patch[0].route_index] += DON_leached_to_stream;
 
 		DOC_leached_to_stream = compute_N_leached(
 			verbose_flag,
@@ -226,7 +226,7 @@ void  update_drainage_stream(
 			patch[0].soil_defaults[0][0].soil_depth,
 			patch[0].soil_defaults[0][0].DOC_adsorption_rate,
 			patch[0].transmissivity_profile);
-		patch[0].soil_cs.DOC_Qout += DOC_leached_to_stream;
+		state->DOC_Qout[patch[0].route_index] += DOC_leached_to_stream;
 		patch[0].streamflow_NO3 += NO3_leached_to_stream;
 		patch[0].streamNO3_from_sub += NO3_leached_to_stream;
 		patch[0].hourly[0].streamflow_NO3 += NO3_leached_to_stream;
@@ -239,7 +239,7 @@ void  update_drainage_stream(
 
 	}
 
-	patch[0].Qout += (route_to_stream / patch[0].area);
+	state->Qout[patch[0].route_index] += (route_to_stream / patch[0].area);
 	patch[0].base_flow += (route_to_stream / patch[0].area);
 	patch[0].hourly_subsur2stream_flow += route_to_stream / patch[0].area;
 
@@ -282,7 +282,7 @@ void  update_drainage_stream(
 			patch[0].soil_defaults[0][0].NO3_adsorption_rate,
 			patch[0].transmissivity_profile);
 		patch[0].surface_NO3 += Nout;
-		patch[0].soil_ns.NO3_Qout += Nout;
+		state->NO3_Qout[patch[0].route_index] += Nout;
 
 		Nout = compute_N_leached(
 			verbose_flag,
@@ -300,7 +300,7 @@ void  update_drainage_stream(
 			patch[0].soil_defaults[0][0].NH4_adsorption_rate,
 			patch[0].transmissivity_profile);
 		patch[0].surface_NH4 += Nout;
-		patch[0].soil_ns.NH4_Qout += Nout;
+		state->NH4_Qout[patch[0].route_index] += Nout;
 
 		Nout = compute_N_leached(
 			verbose_flag,
@@ -318,7 +318,7 @@ void  update_drainage_stream(
 			patch[0].soil_defaults[0][0].DON_adsorption_rate,
 			patch[0].transmissivity_profile);
 		patch[0].surface_DON += Nout;
-		patch[0].soil_ns.DON_Qout += Nout;
+		state->DON_Qout[patch[0].route_index] += Nout;
 
 		Nout = compute_N_leached(
 			verbose_flag,
@@ -336,7 +336,7 @@ void  update_drainage_stream(
 			patch[0].soil_defaults[0][0].DOC_adsorption_rate,
 			patch[0].transmissivity_profile);
 		patch[0].surface_DOC += Nout;
-		patch[0].soil_cs.DOC_Qout += Nout;
+		state->DOC_Qout[patch[0].route_index] += Nout;
 
 	}
 
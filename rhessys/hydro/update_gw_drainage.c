@@ -78,6 +78,8 @@ int update_gw_drainage(
 	patch[0].detention_store -= drainage;
 	patch[0].gw_drainage = drainage;
 	hillslope[0].gw.storage += (drainage * patch[0].area / hillslope[0].area);
+	if (command_line[0].vegspinup_freeze_flag == 1)
+		patch[0].boundary_flux.gw_drainage += drainage;
 
 	/*------------------------------------------------------*/
 	/*	determine associated N leached			*/
@@ -85,12 +87,16 @@ int update_gw_drainage(
 	if (patch[0].surface_DON > ZERO) {
 		N_loss = sat_to_gw_coeff * patch[0].surface_DON;
 		hillslope[0].gw.DON += (N_loss * patch[0].area / hillslope[0].area);
+		if (command_line[0].vegspinup_freeze_flag == 1)
+			patch[0].boundary_flux.gw_DON += N_loss;
 		patch[0].ndf.DON_to_gw += N_loss;
 		patch[0].surface_DON -= N_loss;
 		}
 	if (patch[0].surface_DOC > ZERO) {
 		N_loss = sat_to_gw_coeff * patch[0].surface_DOC;
 		hillslope[0].gw.DOC += (N_loss * patch[0].area / hillslope[0].area);
+		if (command_line[0].vegspinup_freeze_flag == 1)
+			patch[0].boundary_flux.gw_DOC += N_loss;
 		patch[0].cdf.DOC_to_gw += N_loss;
 		patch[0].surface_DOC -= N_loss;
 		}
@@ -99,6 +105,8 @@ int update_gw_drainage(
 	if (patch[0].surface_NH4 > ZERO) {
 		N_loss = sat_to_gw_coeff * patch[0].surface_NH4;
 		hillslope[0].gw.NH4 += (N_loss * patch[0].area / hillslope[0].area);
+		if (command_line[0].vegspinup_freeze_flag == 1)
+			patch[0].boundary_flux.gw_NH4 += N_loss;
 		patch[0].ndf.N_to_gw += N_loss;
 		patch[0].surface_NH4 -= N_loss;
 		}
@@ -106,6 +114,8 @@ int update_gw_drainage(
 	if (patch[0].surface_NO3 > ZERO) {
 		N_loss = sat_to_gw_coeff * patch[0].surface_NO3;
 		hillslope[0].gw.NO3 += (N_loss * patch[0].area / hillslope[0].area);
+		if (command_line[0].vegspinup_freeze_flag == 1)
+			patch[0].boundary_flux.gw_NO3 += N_loss;
 		patch[0].ndf.N_to_gw += N_loss;
 		patch[0].surface_NO3 -= N_loss;
 		}
@@ -17,17 +17,35 @@
 /*											*/
 /*	DESCRIPTION									*/
 /*	this function is called in basin_daily_F at the end of each day,		*/
+/*	it also takes the daily_sums of each hillslope read by output_basin and	*/
+/*	output_hillslope (see aggregate_hillslope_patches.c)				*/
 /*											*/
 /*											*/
 /*	PROGRAMMER NOTES								*/
 /*											*/
 /*--------------------------------------------------------------------------------------*/
 #include <stdio.h>
+#include <omp.h>
 #include "rhessys.h"
 void update_hillslope_accumulator(
 			struct command_line_object *command_line,
 			struct basin_object *basin){
 	/*--------------------------------------------------------------------------------------*/
+	/* Local function definition								*/
+	/*--------------------------------------------------------------------------------------*/
+	void	reset_hillslope_queues(
+		struct hillslope_schedule_object *);
+
+	int	next_scheduled_hillslope(
+		struct hillslope_schedule_object *,
+		int,
+		double *);
+
+	void	aggregate_hillslope_patches(
+		struct hillslope_object *,
+		struct hillslope_sums_object *);
+
+	/*--------------------------------------------------------------------------------------*/
 	/* Local variables definitin								*/
 	/*--------------------------------------------------------------------------------------*/
     //160420LML double scale;
@@ -38,9 +56,18 @@ void update_hillslope_accumulator(
 	/*--------------------------------------------------------------------------------------*/
 	/* update hillslope accumulator								*/
 	/*--------------------------------------------------------------------------------------*/
-    #pragma omp parallel for
-    for (int h = 0 ; h < basin[0].num_hillslopes; h++ ){
+	reset_hillslope_queues(&(basin[0].schedule));
+    #pragma omp parallel
+    {
+    int h = -1;
+    double start;
+    while ((h = next_scheduled_hillslope(&(basin[0].schedule), h, &start)) >= 0) {
         struct hillslope_object *hillslope = basin[0].hillslopes[h];
+		/*------------------------------------------------------------------------------*/
+		/* the day's sums for basin and hillslope output				*/
+		/*------------------------------------------------------------------------------*/
+		if ((command_line[0].b != NULL) || (command_line[0].h != NULL))
+			aggregate_hillslope_patches(hillslope, &(hillslope[0].daily_sums));
 		hillslope[0].acc_month.length += 1;
         for (int z = 0; z < hillslope[0].num_zones; z++) {
             for (int p=0; p < hillslope[0].zones[z][0].num_patches; p++) {
@@ -87,5 +114,6 @@ void update_hillslope_accumulator(
 			} /* end of patch p  */
 		} /* end of zones z */
 	} /* end of hillslope  */	
+    }
 	return;
 } /* end of file update_hillslope_accumulator.c */
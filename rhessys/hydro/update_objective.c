@@ -0,0 +1,201 @@
+/*--------------------------------------------------------------*/
+/* 																*/
+/*					update_objective							*/
+/*																*/
+/*	NAME														*/
+/*	update_objective - adds the day's streamflow to the sums	*/
+/*		of the objective functions								*/
+/*																*/
+/*	SYNOPSIS													*/
+/*	void	update_objective(									*/
+/*					struct basin_object *basin,					*/
+/*					struct objective_object *objective,			*/
+/*					struct command_line_object *command_line,	*/
+/*					struct date current_date)					*/
+/*	void	output_objective(									*/
+/*					struct world_object *world,					*/
+/*					struct command_line_object *command_line)	*/
+/*																*/
+/*	OPTIONS														*/
+/*	-objective <file> [<start y m d> <end y m d>]				*/
+/*																*/
+/*	DESCRIPTION													*/
+/*																*/
+/*	update_objective is called by basin_daily_F, for the		*/
+/*	evaluated basin, once the day is routed.  On the days of	*/
+/*	the window with an observed flow it adds the simulated		*/
+/*	streamflow (mm/day, as in basin.daily) and the observed one	*/
+/*	to the sums of the basin (objective_sums):					*/
+/*																*/
+/*		with -str the flow routed out of the stream network		*/
+/*		(stream_list.streamflow) plus the hillslope baseflow,	*/
+/*		else the streamflow of the STREAM patches plus the		*/
+/*		baseflow (and the return flow without routing)			*/
+/*																*/
+/*	output_objective is called by main at the end of the run	*/
+/*	and prints one line with, over the days summed,				*/
+/*																*/
+/*		NSE		1 - sum (sim-obs)^2 / sum (obs-mean obs)^2		*/
+/*		logNSE	the same of log(flow + log_offset)				*/
+/*		KGE		1 - sqrt((r-1)^2 + (alpha-1)^2 + (beta-1)^2),	*/
+/*				r the correlation, alpha the ratio of standard	*/
+/*				deviations and beta of means (sim/obs)			*/
+/*		pbias	100 (sum sim - sum obs) / sum obs				*/
+/*																*/
+/*	and with an output prefix writes them to <prefix>.objective	*/
+/*	(the columns of OBJECTIVE_COLUMNS), which run_ensemble		*/
+/*	adds to the summary of an ensemble.  With fewer than two	*/
+/*	days summed the functions are not evaluated and the file	*/
+/*	has NA for them.											*/
+/*																*/
+/*	PROGRAMMER NOTES											*/
+/*																*/
+/*	the sums are kept in the basin so that a checkpoint holds	*/
+/*	them; the run needs no daily output							*/
+/*--------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "rhessys.h"
+
+void	update_objective(
+						 struct basin_object *basin,
+						 struct objective_object *objective,
+						 struct command_line_object *command_line,
+						 struct date current_date)
+{
+	/*--------------------------------------------------------------*/
+	/*	Local function definition.									*/
+	/*--------------------------------------------------------------*/
+	long	julday(struct date);
+
+	/*--------------------------------------------------------------*/
+	/*	Local variable definition.									*/
+	/*--------------------------------------------------------------*/
+	int	h, z, p;
+	long	day;
+	double	obs, sim, area, hill_area, streamflow, base_flow, log_obs, log_sim;
+	struct	hillslope_object	*hillslope;
+	struct	patch_object	*patch;
+	struct	objective_sums_object	*sums;
+
+	day = julday(current_date);
+	if ((day < objective[0].window_start) || (day > objective[0].window_end)
+		|| (day < objective[0].first_day)
+		|| (day >= objective[0].first_day + objective[0].num_days))
+		return;
+	obs = objective[0].obs[day - objective[0].first_day];
+	if (isnan(obs) || (obs < 0.0))
+		return;
+
+	/*--------------------------------------------------------------*/
+	/*	the day's streamflow of the basin, m						*/
+	/*--------------------------------------------------------------*/
+	area = 0.0;
+	streamflow = 0.0;
+	base_flow = 0.0;
+	for (h=0; h<basin[0].num_hillslopes; h++) {
+		hillslope = basin[0].hillslopes[h];
+		hill_area = 0.0;
+		for (z=0; z<hillslope[0].num_zones; z++)
+			for (p=0; p<hillslope[0].zones[z][0].num_patches; p++) {
+				patch = hillslope[0].zones[z][0].patches[p];
+				hill_area += patch[0].area;
+				if (command_line[0].routing_flag == 0)
+					streamflow += patch[0].return_flow * patch[0].area;
+				else if ((patch[0].drainage_type == STREAM)
+					&& (command_line[0].stream_routing_flag == 0))
+					streamflow += patch[0].streamflow * patch[0].area;
+			}
+		base_flow += hillslope[0].base_flow * hill_area;
+		area += hill_area;
+	}
+	if (command_line[0].stream_routing_flag == 1)
+		streamflow = basin[0].stream_list.streamflow * 86400;
+	sim = (streamflow + base_flow) / area * 1000.0;
+
+	/*--------------------------------------------------------------*/
+	/*	add it to the sums											*/
+	/*--------------------------------------------------------------*/
+	sums = &(basin[0].objective_sums);
+	log_obs = log(obs + objective[0].log_offset);
+	log_sim = log(max(sim, 0.0) + objective[0].log_offset);
+	sums[0].days += 1.0;
+	sums[0].obs += obs;
+	sums[0].sim += sim;
+	sums[0].obs_square += obs * obs;
+	sums[0].sim_square += sim * sim;
+	sums[0].obs_sim += obs * sim;
+	sums[0].error_square += (sim - obs) * (sim - obs);
+	sums[0].log_obs += log_obs;
+	sums[0].log_obs_square += log_obs * log_obs;
+	sums[0].log_error_square += (log_sim - log_obs) * (log_sim - log_obs);
+	return;
+} /*end update_objective*/
+
+void	output_objective(
+						 struct world_object *world,
+						 struct command_line_object *command_line)
+{
+	/*--------------------------------------------------------------*/
+	/*	Local variable definition.									*/
+	/*--------------------------------------------------------------*/
+	int	b;
+	double	n, mean_obs, mean_sim, var_obs, var_sim, cov;
+	double	nse, log_nse, kge, r, alpha, beta, pbias;
+	char	filename[FILEPATH_LEN+20];
+	struct	objective_sums_object	*sums;
+	FILE	*file;
+
+	for (b=0; b<world[0].num_basin_files; b++)
+		if (world[0].basins[b][0].ID == world[0].objective[0].basin_ID)
+			break;
+	sums = &(world[0].basins[b][0].objective_sums);
+	n = sums[0].days;
+	if (n < 2.0) {
+		printf("\nObjective basin %d: %.0f days with observed streamflow, not evaluated\n",
+			world[0].objective[0].basin_ID, n);
+		if (command_line[0].output_prefix == NULL)
+			return;
+		sprintf(filename, "%s.objective", command_line[0].output_prefix);
+		if ((file = fopen(filename, "w")) == NULL) {
+			fprintf(stderr,"FATAL ERROR: Cannot open %s\n", filename);
+			exit(EXIT_FAILURE);
+		}
+		fprintf(file, "%s\n%.0f NA NA NA NA NA NA NA\n", OBJECTIVE_COLUMNS, n);
+		fclose(file);
+		return;
+	}
+
+	/*--------------------------------------------------------------*/
+	/*	the functions from the sums									*/
+	/*--------------------------------------------------------------*/
+	mean_obs = sums[0].obs / n;
+	mean_sim = sums[0].sim / n;
+	var_obs = max(sums[0].obs_square / n - mean_obs * mean_obs, 0.0);
+	var_sim = max(sums[0].sim_square / n - mean_sim * mean_sim, 0.0);
+	cov = sums[0].obs_sim / n - mean_obs * mean_sim;
+	nse = (var_obs > 0.0) ? 1.0 - sums[0].error_square / (n * var_obs) : -9999.0;
+	log_nse = sums[0].log_obs_square - sums[0].log_obs * sums[0].log_obs / n;
+	log_nse = (log_nse > 0.0) ? 1.0 - sums[0].log_error_square / log_nse : -9999.0;
+	r = ((var_obs > 0.0) && (var_sim > 0.0)) ? cov / sqrt(var_obs * var_sim) : 0.0;
+	alpha = (var_obs > 0.0) ? sqrt(var_sim / var_obs) : 0.0;
+	beta = (mean_obs > 0.0) ? mean_sim / mean_obs : 0.0;
+	kge = 1.0 - sqrt((r - 1.0) * (r - 1.0) + (alpha - 1.0) * (alpha - 1.0)
+		+ (beta - 1.0) * (beta - 1.0));
+	pbias = (mean_obs > 0.0) ? 100.0 * (mean_sim - mean_obs) / mean_obs : 0.0;
+
+	printf("\nObjective basin %d: days %.0f NSE %.4f logNSE %.4f KGE %.4f (r %.4f alpha %.4f beta %.4f) pbias %.2f\n",
+		world[0].objective[0].basin_ID, n, nse, log_nse, kge, r, alpha, beta, pbias);
+	if (command_line[0].output_prefix == NULL)
+		return;
+	sprintf(filename, "%s.objective", command_line[0].output_prefix);
+	if ((file = fopen(filename, "w")) == NULL) {
+		fprintf(stderr,"FATAL ERROR: Cannot open %s\n", filename);
+		exit(EXIT_FAILURE);
+	}
+	fprintf(file, "%s\n%.0f %.6f %.6f %.6f %.6f %.6f %.6f %.4f\n", OBJECTIVE_COLUMNS,
+		n, nse, log_nse, kge, r, alpha, beta, pbias);
+	fclose(file);
+	return;
+} /*end output_objective*/
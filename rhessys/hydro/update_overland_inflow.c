@@ -0,0 +1,103 @@
+/*--------------------------------------------------------------*/
+/* 											*/
+/*					update_overland_inflow			*/
+/*											*/
+/*	update_overland_inflow.c - gathers final overland flow		*/
+/*											*/
+/*	NAME										*/
+/*	update_overland_inflow.c - gathers final overland flow		*/
+/*											*/
+/*	SYNOPSIS									*/
+/*	void update_overland_inflow( 							*/
+/*				struct routing_list_object *rlist,		*/
+/*				int i,						*/
+/*				struct command_line_object *command_line)	*/
+/*											*/
+/*	OPTIONS										*/
+/*											*/
+/*	DESCRIPTION									*/
+/*											*/
+/*	parallel routing counterpart of the final overland flow	*/
+/*	routing in compute_subsurface_routing; patch i of the route	*/
+/*	list collects the detention store excess that upslope		*/
+/*	patches stored in their outflow buffers at the end of the	*/
+/*	day.  Stream patches add it to streamflow directly since	*/
+/*	their own streamflow has already been finalized.		*/
+/*											*/
+/*	PROGRAMMER NOTES								*/
+/*											*/
+/*	only patch i is modified					*/
+/*--------------------------------------------------------------*/
+#include <stdio.h>
+#include "rhessys.h"
+
+
+void  update_overland_inflow(
+					struct routing_list_object *rlist,
+					int i,
+					struct command_line_object *command_line)
+{
+	/*--------------------------------------------------------------*/
+	/*	Local variable definition.				*/
+	/*--------------------------------------------------------------*/
+	int l;
+	double Qout, Qin, Nout, area_ratio;
+	double NO3_out, NH4_out, DON_out, DOC_out;
+	struct patch_object *patch, *source;
+	struct patch_outflow_object *outflow;
+	struct routing_inflow_object *inflow;
+
+	patch = rlist->list[i];
+	NO3_out = 0.0;
+	NH4_out = 0.0;
+	DON_out = 0.0;
+	DOC_out = 0.0;
+	Nout = 0.0;
+
+	for (l = rlist->inflow_start[i]; l < rlist->inflow_start[i+1]; l++) {
+		inflow = &(rlist->inflows[l]);
+		outflow = &(rlist->outflow[inflow->source]);
+		if ((inflow->type != SURFACE_INFLOW) || (inflow->d != outflow->overland_d))
+			continue;
+
+		source = rlist->list[inflow->source];
+		area_ratio = source[0].area / patch[0].area;
+		Qout = outflow->overland_excess * inflow->gamma;
+		Qin = Qout * area_ratio;
+		if (command_line[0].grow_flag > 0) {
+			NO3_out = Qout / outflow->overland_detention_store * outflow->overland_NO3;
+			NH4_out = Qout / outflow->overland_detention_store * outflow->overland_NH4;
+			DON_out = Qout / outflow->overland_detention_store * outflow->overland_DON;
+			DOC_out = Qout / outflow->overland_detention_store * outflow->overland_DOC;
+			Nout = NO3_out + NH4_out + DON_out;
+			}
+
+		patch[0].Qin_total += Qin;
+		if (patch[0].drainage_type == STREAM) {
+			patch[0].return_flow += Qin;
+			patch[0].streamflow += Qin;
+			if (command_line[0].grow_flag > 0) {
+				patch[0].streamflow_DOC += DOC_out * area_ratio;
+				patch[0].streamflow_DON += DON_out * area_ratio;
+				patch[0].streamflow_NO3 += NO3_out * area_ratio;
+				patch[0].streamNO3_from_surface += NO3_out * area_ratio;
+				patch[0].hourly[0].streamflow_NO3 += NO3_out * area_ratio;
+				patch[0].hourly[0].streamflow_NO3_from_sub += NO3_out * area_ratio;
+				patch[0].streamflow_NH4 += NH4_out * area_ratio;
+				patch[0].surface_ns_leach += Nout * area_ratio;
+				}
+			}
+		else {
+			patch[0].detention_store += Qin;
+			if (command_line[0].grow_flag > 0) {
+				patch[0].surface_DOC += DOC_out * area_ratio;
+				patch[0].surface_DON += DON_out * area_ratio;
+				patch[0].surface_NO3 += NO3_out * area_ratio;
+				patch[0].surface_ns_leach -= Nout * area_ratio;
+				patch[0].surface_NH4 += NH4_out * area_ratio;
+				}
+			}
+	}
+
+	return;
+} /*end update_overland_inflow.c*/
@@ -0,0 +1,178 @@
+/*--------------------------------------------------------------*/
+/* 											*/
+/*					update_surface_inflow			*/
+/*											*/
+/*	update_surface_inflow.c - adds routed surface water to a patch	*/
+/*											*/
+/*	NAME										*/
+/*	update_surface_inflow.c - adds routed surface water to a patch	*/
+/*											*/
+/*	SYNOPSIS									*/
+/*	void update_surface_inflow( 							*/
+/*					struct patch_object *patch,			*/
+/*					struct routing_state_object *state,		*/
+/*					struct command_line_object *command_line,	*/
+/*				 			double Qin,		 	*/
+/*				 			double NO3_in,		 	*/
+/*				 			double NH4_in,		 	*/
+/*				 			double DON_in,		 	*/
+/*				 			double DOC_in,		 	*/
+/*				 			double time_int,	 	*/
+/*							int verbose_flag)		*/
+/*											*/
+/*	OPTIONS										*/
+/*											*/
+/*	DESCRIPTION									*/
+/*											*/
+/*	adds surface water (m) and nitrogen (kg/m2) routed from an	*/
+/*	upslope neighbour to the detention store of patch and tries	*/
+/*	to infiltrate it over time_int					*/
+/*											*/
+/*	PROGRAMMER NOTES								*/
+/*											*/
+/*	moved out of update_drainage_land so that the same code is	*/
+/*	used when inflows are gathered by the receiving patch		*/
+/*	(parallel routing option)					*/
+/*--------------------------------------------------------------*/
+#include <stdio.h>
+#include "rhessys.h"
+
+
+void  update_surface_inflow(
+					struct patch_object *patch,
+					struct routing_state_object *state,
+					struct command_line_object *command_line,
+					double Qin,
+					double NO3_in,
+					double NH4_in,
+					double DON_in,
+					double DOC_in,
+					double time_int,
+					int verbose_flag)
+{
+	/*--------------------------------------------------------------*/
+	/*	Local function definition.				*/
+	/*--------------------------------------------------------------*/
+	double compute_infiltration( int,
+		double,
+		double,
+		double,
+		double,
+		double,
+		double,
+		double,
+		double,
+		double,
+		double);
+
+	/*--------------------------------------------------------------*/
+	/*	Local variable definition.				*/
+	/*--------------------------------------------------------------*/
+	double infiltration; /* m */
+
+	/*--------------------------------------------------------------*/
+	/* now transfer surface water and nitrogen */
+	/*	- first nitrogen					*/
+	/*--------------------------------------------------------------*/
+	if (command_line[0].grow_flag > 0) {
+		patch[0].surface_NO3 += NO3_in;
+		patch[0].surface_NH4 += NH4_in;
+		patch[0].surface_DON += DON_in;
+		patch[0].surface_DOC += DOC_in;
+		}
+
+	/*--------------------------------------------------------------*/
+	/*	- now surface water 					*/
+	/*	surface stores should be updated to facilitate transfer */
+	/* added net surface water transfer to detention store		*/
+	/*--------------------------------------------------------------*/
+	patch[0].detention_store += Qin;// need fix this
+	patch[0].surface_Qin += Qin;
+
+	/*--------------------------------------------------------------*/
+	/* try to infiltrate this water					*/
+	/* use time_int as duration */
+	/*--------------------------------------------------------------*/
+	if (patch[0].detention_store > ZERO) {
+		if (patch[0].rootzone.depth > ZERO) {
+		infiltration = compute_infiltration(
+			verbose_flag,
+			patch[0].sat_deficit_z,
+			patch[0].rootzone.S,
+			patch[0].Ksat_vertical,
+			patch[0].soil_defaults[0][0].Ksat_0_v,
+			patch[0].soil_defaults[0][0].mz_v,
+			patch[0].soil_defaults[0][0].porosity_0,
+			patch[0].soil_defaults[0][0].porosity_decay,
+			(patch[0].detention_store),
+			time_int,
+			patch[0].soil_defaults[0][0].psi_air_entry);
+		}
+		else {
+		infiltration = compute_infiltration(
+			verbose_flag,
+			patch[0].sat_deficit_z,
+			patch[0].S,
+			patch[0].Ksat_vertical,
+			patch[0].soil_defaults[0][0].Ksat_0_v,
+			patch[0].soil_defaults[0][0].mz_v,
+			patch[0].soil_defaults[0][0].porosity_0,
+			patch[0].soil_defaults[0][0].porosity_decay,
+			(patch[0].detention_store),
+			time_int,
+			patch[0].soil_defaults[0][0].psi_air_entry);
+		}
+	}
+	else infiltration = 0.0;
+	/*--------------------------------------------------------------*/
+	/* added an surface N flux to surface N pool	and		*/
+	/* allow infiltration of surface N				*/
+	/*--------------------------------------------------------------*/
+	if ((command_line[0].grow_flag > 0 ) && (infiltration > ZERO)) {
+		state->DOC_Qin[patch[0].route_index] += ((infiltration / patch[0].detention_store) * patch[0].surface_DOC);
+		patch[0].surface_DOC -= ((infiltration / patch[0].detention_store) * patch[0].surface_DOC);
+		state->DON_Qin[patch[0].route_index] += ((infiltration / patch[0].detention_store) * patch[0].surface_DON);
+		patch[0].surface_DON -= ((infiltration / patch[0].detention_store) * patch[0].surface_DON);
+		state->NO3_Qin[patch[0].route_index] += ((infiltration / patch[0].detention_store) * patch[0].surface_NO3);
+		patch[0].surface_NO3 -= ((infiltration / patch[0].detention_store) * patch[0].surface_NO3);
+		state->NH4_Qin[patch[0].route_index] += ((infiltration / patch[0].detention_store) * patch[0].surface_NH4);
+		patch[0].surface_NH4 -= ((infiltration / patch[0].detention_store) * patch[0].surface_NH4);
+	}
+
+	if (infiltration > patch[0].sat_deficit - patch[0].unsat_storage - patch[0].rz_storage) {
+		patch[0].sat_deficit -= (infiltration + patch[0].unsat_storage + patch[0].rz_storage);
+		patch[0].unsat_storage = 0.0;
+		patch[0].rz_storage = 0.0;
+		patch[0].field_capacity = 0.0;
+		patch[0].rootzone.field_capacity = 0.0;
+	}
+
+	else if ((patch[0].sat_deficit > patch[0].rootzone.potential_sat) &&
+		(infiltration > patch[0].rootzone.potential_sat - patch[0].rz_storage)) {
+	/*------------------------------------------------------------------------------*/
+	/*		Just add the infiltration to the rz_storage and unsat_storage	*/
+	/*------------------------------------------------------------------------------*/
+		patch[0].unsat_storage += infiltration - (patch[0].rootzone.potential_sat - patch[0].rz_storage);
+		patch[0].rz_storage = patch[0].rootzone.potential_sat;
+	}
+	/* Only rootzone layer saturated - perched water table case */
+	else if ((patch[0].sat_deficit > patch[0].rootzone.potential_sat) &&
+		(infiltration <= patch[0].rootzone.potential_sat - patch[0].rz_storage)) {
+		/*--------------------------------------------------------------*/
+		/*		Just add the infiltration to the rz_storage	*/
+		/*--------------------------------------------------------------*/
+		patch[0].rz_storage += infiltration;
+	}
+	else if ((patch[0].sat_deficit <= patch[0].rootzone.potential_sat) &&
+		(infiltration <= patch[0].sat_deficit - patch[0].rz_storage - patch[0].unsat_storage)) {
+		patch[0].rz_storage += patch[0].unsat_storage;
+		/* transfer left water in unsat storage to rootzone layer */
+		patch[0].unsat_storage = 0;
+		patch[0].rz_storage += infiltration;
+		patch[0].field_capacity = 0;
+	}
+
+	patch[0].detention_store -= infiltration;
+
+	return;
+} /*end update_surface_inflow.c*/
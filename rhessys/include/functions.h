@@ -48,4 +48,34 @@ double compute_saturation_vapor_pressure(double temperature);
 double compute_vapor_pressure_deficit(double saturation_vapor_pressure,
 		double dewpoint_vapor_pressure);
 
+struct random_stream_object init_random_stream(long seed, int ID, struct date date);
+
+double random_uniform(struct random_stream_object *stream);
+
+double normdist(struct random_stream_object *stream, double mean, double std);
+
+double unifdist(struct random_stream_object *stream, double min, double max);
+
+struct id_index_object *construct_id_index(struct basin_object *basin);
+
+void *find_in_id_index(struct id_index_object *index, void *parent, int ID);
+
+struct column_file_object *construct_column_file(char *filename);
+
+void column_file_name(struct column_file_object *columns, char *name);
+
+void column_file_int(struct column_file_object *columns, int value);
+
+void column_file_double(struct column_file_object *columns, double value);
+
+void column_file_end_row(struct column_file_object *columns);
+
+void destroy_column_file(struct column_file_object *columns);
+
+void dump_column_file(char *filename);
+
+void update_soil_spinup(struct world_object *world,
+		struct command_line_object *command_line,
+		struct date current_date);
+
 #endif
@@ -5,14 +5,24 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#define PARAM_STR_LEN 128    /* Longest name or value, as read by readParamFile */
+#define PARAM_HASH_SIZE 512  /* Buckets of the name index of a parameter array */
+
 typedef struct {
-    char name[32];    /* The name field of the parameter. */
-    char strVal[1024]; /* The parameter as it was read in from the file. */
+    char name[PARAM_STR_LEN];    /* The name field of the parameter. */
+    char strVal[PARAM_STR_LEN]; /* The parameter as it was read in from the file. */
     char format[8]; /* The default format to read this parameter with. */
     int accessed; /* Has the program accessed this parameter? */
     int defaultValUsed; /* Was the passed in default value used for this parameter? */
+    int next; /* Next parameter in the same hash bucket, -1 if none */
 } param;
 
+/* Kept in front of every parameter array; see paramIndexOf in params.c */
+typedef struct {
+    int capacity; /* Number of parameters the array has room for */
+    int bucket[PARAM_HASH_SIZE]; /* First parameter of each hash bucket, -1 if none */
+} paramIndex;
+
 /* Function prototypes */
 param * readParamFile(int *paramCnt, char *filename);
 char * getStrParam(int *paramCnt, param **paramPtr, char *paramName, char *readFormat, char *defaultVal, int useDefaultVal);
@@ -20,6 +30,8 @@ int    getIntParam(int *paramCnt, param **paramPtr , char *paramName, char *read
 float  getFloatParam(int *paramCnt, param **paramPtr , char *paramName, char *readFormat, float defaultVal, int useDefaultVal);
 double getDoubleParam(int *paramCnt, param **paramPtr , char *paramName, char *readFormat, double defaultVal, int useDefaultVal);
 void   printParams(int paramCnt, param *params, char *outFilename);
+param * addParam(int *paramCnt, param **paramPtr, char *paramName, char *strVal);
+void   freeParams(param *params);
 int string_length(char *s);
 
 
@@ -141,6 +141,8 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdint.h>
+#include <pthread.h>
 
 #include "../../util/WMFireInterface.h" /* required for fire spread*/
 /*----------------------------------------------------------*/
@@ -215,8 +217,14 @@ int get_netcdf_station_number(char *base_station_filename);
 int get_netcdf_var_timeserias(char *, char *, char *, char *, float, float, float, int, int, int, int, float *);
 int get_netcdf_xy(char *, char *, char *, float, float, float, float *, float *);
 int get_netcdf_var(char *, char *, char *, char *, float, float, float, float *);
+int get_netcdf_grid_timeseries(char *, char *, char *, char *, int, float *, float *, float, int, int, int, int, double **);
+int get_netcdf_grid_var(char *, char *, char *, char *, int, float *, float *, float, double *);
 int get_indays(int,int,int,int,int);	//get days since XXXX-01-01
 #endif
+struct netcdf_grid_series;                                                      /* see read_netcdf.c */
+struct netcdf_grid_series *open_netcdf_grid_series(char *, char *, char *, char *, int, float *, float *, float, int, int, int, int);
+int read_netcdf_grid_series(struct netcdf_grid_series *, int, int, int, float *);
+void close_netcdf_grid_series(struct netcdf_grid_series *);
 
 /*----------------------------------------------------------*/
 /*      Define types                                        */
@@ -236,6 +244,16 @@ struct date
         long    hour;
         };
 
+/*----------------------------------------------------------*/
+/*      Define a random stream object.                      */
+/*      counter based; see util/create_random_distrb.c      */
+/*----------------------------------------------------------*/
+struct random_stream_object
+        {
+        unsigned long long      key;    /* hash of seed, entity ID and date */
+        unsigned long long      counter;        /* draws taken so far */
+        };
+
 /*----------------------------------------------------------*/
 /*      Define default object.                              */      
 /*----------------------------------------------------------*/
@@ -263,6 +281,120 @@ struct  default_object
         };
 
 
+/*----------------------------------------------------------*/
+/*      Define the binary worldfile.                        */
+/*      a header, then one fixed size record per line of    */
+/*      the text worldfile body (value and label), then a   */
+/*      string table holding the labels.  Records are in    */
+/*      text order, so construct_* read them one after the  */
+/*      other exactly as they would read the text lines.    */
+/*      see open_world_input and convert_worldfile          */
+/*----------------------------------------------------------*/
+#define WORLDFILE_MAGIC         "RHESSysW"      /* 8 bytes, no NUL */
+#define WORLDFILE_VERSION       1
+#define WORLDFILE_INT           1
+#define WORLDFILE_DOUBLE        2
+#define WORLDFILE_STRING        3       /* value.i is a string table offset */
+
+struct worldfile_header_object
+        {
+        char    magic[8];
+        int32_t version;
+        int32_t record_size;            /* bytes, sizeof(worldfile_record_object) */
+        int64_t num_records;
+        int64_t strings_offset;         /* bytes from start of file */
+        int64_t strings_size;           /* bytes */
+        };
+
+struct worldfile_record_object
+        {
+        int32_t type;                   /* WORLDFILE_INT, _DOUBLE or _STRING */
+        int32_t label;                  /* string table offset */
+        union
+                {
+                int64_t i;
+                double  d;
+                } value;
+        };
+
+/*----------------------------------------------------------*/
+/*      Define the climate cache (-climcache).              */
+/*      <sequence file>.cache holds a parsed climate        */
+/*      sequence: this header, then num_records records of  */
+/*      record_size bytes.  It is used only while the       */
+/*      source file and the requested dates are unchanged.  */
+/*      see read_clim_cache and write_clim_cache            */
+/*----------------------------------------------------------*/
+#define CLIM_CACHE_MAGIC        "RHESSysC"      /* 8 bytes, no NUL */
+#define CLIM_CACHE_VERSION      1
+#define CLIM_CACHE_SEQUENCE     1               /* doubles, one per step */
+#define CLIM_CACHE_DATED        2               /* struct dated_sequence */
+
+struct clim_cache_header_object
+        {
+        char    magic[8];
+        int32_t version;
+        int32_t kind;                   /* CLIM_CACHE_SEQUENCE or _DATED */
+        int32_t record_size;            /* bytes */
+        int32_t clim_repeat_flag;
+        int64_t source_size;            /* bytes */
+        int64_t source_mtime;           /* s */
+        int64_t source_mtime_nsec;
+        int64_t start_date_julian;
+        int64_t duration;
+        int64_t num_records;
+        char    source[FILEPATH_LEN];
+        };
+
+/*----------------------------------------------------------*/
+/*      Define a world input object.                        */
+/*      the worldfile being read: a text file (file) or a   */
+/*      memory mapped binary worldfile (image)              */
+/*----------------------------------------------------------*/
+struct world_input_object
+        {
+        FILE    *file;                  /* NULL for binary */
+        void    *image;
+        size_t  image_size;             /* bytes */
+        struct  worldfile_record_object *records;
+        int64_t num_records;
+        int64_t next;                   /* next record to read */
+        char    *strings;
+        char    filename[FILEPATH_LEN];
+        };
+
+/*----------------------------------------------------------*/
+/*      Define the world arena.                             */
+/*      hillslope, zone, patch and stratum objects (and the */
+/*      small lists hanging off them) are cut from large    */
+/*      blocks, one chain of blocks per object type, so     */
+/*      objects of a type lie next to each other in the     */
+/*      order they are constructed (hillslope/zone order).  */
+/*      see arena_alloc and release_arena                   */
+/*----------------------------------------------------------*/
+#define ARENA_HILLSLOPE 0
+#define ARENA_ZONE      1
+#define ARENA_PATCH     2
+#define ARENA_STRATUM   3
+#define ARENA_LIST      4       /* pointer lists, hourly and shadow objects */
+#define NUM_ARENA_TYPES 5
+#define ARENA_BLOCK_SIZE        (4 * 1024 * 1024)       /* bytes */
+
+struct arena_block_object
+        {
+        struct  arena_block_object      *next;
+        size_t  size;                   /* bytes usable after the header */
+        size_t  used;                   /* bytes */
+        };
+
+struct arena_object
+        {
+        struct  arena_block_object      *blocks[NUM_ARENA_TYPES]; /* newest first */
+        size_t  bytes[NUM_ARENA_TYPES];         /* handed out */
+        size_t  reserved[NUM_ARENA_TYPES];      /* in blocks */
+        long    count[NUM_ARENA_TYPES];         /* allocations */
+        };
+
 /*----------------------------------------------------------*/
 /*      Define the world object.                            */
 /*----------------------------------------------------------*/
@@ -301,7 +433,12 @@ struct world_object
         double  Io;                     /* Wm-2         */
         struct  base_station_object     **base_stations;
         struct  base_station_ncheader_object    *base_station_ncheader;
+        struct  base_station_index_object       *base_station_index;
+        struct  clim_window_object      *clim_window;
+        struct  objective_object        *objective;     /* -objective */
         struct  basin_object            **basins;
+        int                             *basin_order;   /* decreasing cost */
+        struct  arena_object            arena;
         struct  date                    start_date;                             
         struct  date                    end_date;                               
         struct  date                    duration;                               
@@ -334,6 +471,7 @@ struct  world_output_file_object
         struct  output_files_object             *canopy_stratum;
         struct  output_files_object             *shadow_strata;
         struct  output_files_object             *stream_routing;
+        struct  output_spec_object              *spec;
         };
 
 /*----------------------------------------------------------*/
@@ -345,6 +483,102 @@ struct  output_files_object
         FILE    *monthly;
         FILE    *daily;
         FILE    *hourly;
+        struct  column_file_object      *daily_columns; /* -colout, daily is NULL */
+        };
+
+/*----------------------------------------------------------*/
+/*      Column output file (-colout).                       */
+/*                                                          */
+/*      header: magic, int32 version, int32 num_columns,    */
+/*              then per column int32 type, int32 length    */
+/*              and the name                                */
+/*      blocks: int32 num_rows, then per column uint32      */
+/*              size and the deflated, byte shuffled values */
+/*----------------------------------------------------------*/
+#define COLUMN_FILE_MAGIC       "RHESSysO"      /* 8 bytes, no NUL */
+#define COLUMN_FILE_VERSION     1
+#define COLUMN_INT              1               /* int32 */
+#define COLUMN_DOUBLE           2               /* double */
+#define COLUMN_BLOCK_ROWS       4096
+
+struct  column_file_object
+        {
+        FILE    *file;
+        char    filename[FILEPATH_LEN];
+        int     num_columns;                    /* 0 until the first row ends */
+        int     num_names;
+        int     column;                         /* next value of the row */
+        int     header_written;
+        int     num_rows;                       /* rows in the current block */
+        int     capacity;                       /* of types, names and values */
+        int     *types;
+        char    **names;
+        char    **values;                       /* COLUMN_BLOCK_ROWS values */
+        unsigned char   *shuffled;
+        unsigned char   *compressed;
+        unsigned long   compressed_capacity;
+        };
+
+/*----------------------------------------------------------*/
+/*      Output specification (-outspec): the variables and  */
+/*      objects listed in the spec file, resolved once into */
+/*      one entry per output value.                         */
+/*----------------------------------------------------------*/
+#define OUTPUT_SPEC_INT         1
+#define OUTPUT_SPEC_DOUBLE      2
+
+struct  output_spec_entry_object
+        {
+        void    *object;                        /* patch, zone ... */
+        size_t  offset;                         /* of the field in it */
+        int     type;                           /* OUTPUT_SPEC_INT or _DOUBLE */
+        };
+
+struct  output_spec_object
+        {
+        int     num_entries;
+        struct  output_spec_entry_object        *entries;
+        char    *format;                        /* of a record */
+        union   output_value_object     *values;        /* of a record */
+        FILE    *outfile;                       /* NULL with columns */
+        struct  column_file_object      *columns;
+        };
+
+/*----------------------------------------------------------*/
+/*      Output writer thread (-outbuffer): output records   */
+/*      are copied into a ring of snapshots and written on  */
+/*      their own thread.                                   */
+/*----------------------------------------------------------*/
+union   output_value_object
+        {
+        long    i;                              /* %d, %ld */
+        double  d;                              /* %f, %lf, %e, %g */
+        char    *s;                             /* %s */
+        };
+
+struct  output_snapshot_object
+        {
+        FILE    *outfile;
+        struct  column_file_object      *columns;
+        char    *format;                        /* as given to fprintf */
+        int     num_values;
+        int     capacity;
+        union   output_value_object     *values;
+        };
+
+struct  output_writer_object
+        {
+        long    depth;                          /* snapshots in the ring */
+        long    head;                           /* next to write */
+        long    count;                          /* waiting to be written */
+        int     quit;
+        long    num_records;
+        double  wait_seconds;                   /* simulation waiting on a full ring */
+        struct  output_snapshot_object  *snapshots;
+        pthread_t       thread;
+        pthread_mutex_t mutex;
+        pthread_cond_t  not_empty;
+        pthread_cond_t  not_full;
         };
 
 /*----------------------------------------------------------*/
@@ -414,6 +648,29 @@ struct rooting_zone_object
 
 };
 
+/*----------------------------------------------------------*/
+/*      Define routing state object.                        */
+/*      subsurface exchange fluxes of the patches of a      */
+/*      routing list, stored by list position so the        */
+/*      neighbour scatter writes into contiguous arrays.    */
+/*      entry num_patches is a sink for neighbours outside  */
+/*      the list (see construct_routing_state)              */
+/*----------------------------------------------------------*/
+struct routing_state_object
+        {
+        double  *Qin;           /* m /day       */
+        double  *Qout;          /* m /day       */
+        double  *NO3_Qin;       /* kgN/m2/day   */
+        double  *NO3_Qout;      /* kgN/m2/day   */
+        double  *NH4_Qin;       /* kgN/m2/day   */
+        double  *NH4_Qout;      /* kgN/m2/day   */
+        double  *DON_Qin;       /* kgN/m2/day   */
+        double  *DON_Qout;      /* kgN/m2/day   */
+        double  *DOC_Qin;       /* kgC/m2/day   */
+        double  *DOC_Qout;      /* kgC/m2/day   */
+        double  *area;          /* m2           */
+        };
+
 /*----------------------------------------------------------*/
 /*      Define routing list object.                         */
 /*----------------------------------------------------------*/
@@ -421,6 +678,111 @@ struct routing_list_object
         {
         int num_patches;
         struct patch_object **list;
+        struct  routing_state_object    *state;
+        int     *inflow_start;          /* offsets into inflows, num_patches+1 */
+        struct  routing_inflow_object   *inflows;
+        struct  patch_outflow_object    *outflow;
+        };
+
+/*----------------------------------------------------------*/
+/*      Define a routing inflow object.                     */
+/*      one entry per (upslope patch, receiving patch) link */
+/*      in the reverse adjacency used by parallel routing   */
+/*----------------------------------------------------------*/
+#define SUBSURFACE_INFLOW 0
+#define SURFACE_INFLOW 1
+#define ROAD_STREAM_INFLOW 2
+
+struct routing_inflow_object
+        {
+        int     source;                 /* index into route list        */
+        int     type;                   /* SUBSURFACE, SURFACE or ROAD_STREAM */
+        int     d;                      /* innundation depth of the link */
+        double  gamma;                  /* neighbour share              */
+        };
+
+/*----------------------------------------------------------*/
+/*      Define a patch outflow object.                      */
+/*      holds what a patch sends downslope during one       */
+/*      routing substep so that neighbours can gather it    */
+/*----------------------------------------------------------*/
+struct patch_outflow_object
+        {
+        int     surface_d;              /* innundation depth used for surface routing */
+        int     overland_d;             /* innundation depth used for final overland flow */
+        double  route_to_patch;         /* m3 */
+        double  NO3_to_patch;           /* kg */
+        double  NH4_to_patch;           /* kg */
+        double  DON_to_patch;           /* kg */
+        double  DOC_to_patch;           /* kg */
+        double  route_to_surface;       /* m3 */
+        double  NO3_to_surface;         /* kg */
+        double  NH4_to_surface;         /* kg */
+        double  DON_to_surface;         /* kg */
+        double  DOC_to_surface;         /* kg */
+        double  route_to_stream;        /* m3 */
+        double  NO3_to_stream;          /* kg */
+        double  NH4_to_stream;          /* kg */
+        double  DON_to_stream;          /* kg */
+        double  DOC_to_stream;          /* kg */
+        double  surface_to_stream;      /* m3 */
+        double  NO3_surface_to_stream;  /* kg */
+        double  NH4_surface_to_stream;  /* kg */
+        double  DON_surface_to_stream;  /* kg */
+        double  DOC_surface_to_stream;  /* kg */
+        double  overland_excess;        /* m */
+        double  overland_detention_store;       /* m */
+        double  overland_NO3;           /* kg/m2 */
+        double  overland_NH4;           /* kg/m2 */
+        double  overland_DON;           /* kg/m2 */
+        double  overland_DOC;           /* kg/m2 */
+        };
+
+/*----------------------------------------------------------*/
+/*      Define a patch boundary flux object.                */
+/*      (-vegspinupfreeze) what a patch sends downslope     */
+/*      and to the hillslope groundwater, summed over the   */
+/*      year while it is simulated, then the mean per       */
+/*      routing time step (per day for groundwater) that    */
+/*      it keeps sending once it is held at its targets     */
+/*----------------------------------------------------------*/
+struct patch_boundary_flux_object
+        {
+        double  steps;                  /* routing time steps summed */
+        double  days;                   /* days summed */
+        double  route_to_patch;         /* m3 */
+        double  NO3_to_patch;           /* kg */
+        double  NH4_to_patch;           /* kg */
+        double  DON_to_patch;           /* kg */
+        double  DOC_to_patch;           /* kg */
+        double  route_to_surface;       /* m3 */
+        double  NO3_to_surface;         /* kg */
+        double  NH4_to_surface;         /* kg */
+        double  DON_to_surface;         /* kg */
+        double  DOC_to_surface;         /* kg */
+        double  gw_drainage;            /* m */
+        double  gw_NO3;                 /* kg/m2 */
+        double  gw_NH4;                 /* kg/m2 */
+        double  gw_DON;                 /* kg/m2 */
+        double  gw_DOC;                 /* kg/m2 */
+        };
+
+/*----------------------------------------------------------*/
+/*      Define a soil spinup object.                        */
+/*      (-soilspinup) the litter and soil carbon pools of   */
+/*      a patch over a climate cycle: litr1c, litr2c,       */
+/*      litr3c, litr4c, soil1c, soil2c, soil3c, soil4c      */
+/*----------------------------------------------------------*/
+#define NUM_SOIL_SPINUP_POOLS 8
+
+struct soil_spinup_object
+        {
+        double  days;                   /* days summed */
+        int     years;                  /* years summed */
+        double  start_c[NUM_SOIL_SPINUP_POOLS];    /* kgC/m2 */
+        double  pool_c[NUM_SOIL_SPINUP_POOLS];     /* kgC/m2 * days */
+        double  loss_c[NUM_SOIL_SPINUP_POOLS];     /* kgC/m2 respired, passed on or lost as DOC */
+        double  transfer_c[NUM_SOIL_SPINUP_POOLS]; /* kgC/m2 passed on to the next pool */
         };
 /*----------------------------------------------------------*/
 /*      Define spinup threshold list object.                */
@@ -458,6 +820,8 @@ int num_upstream_neighbours;
 int num_neighbour_hills;
 int *downstream_neighbours;
 int *upstream_neighbours;
+int num_upstream_reaches;
+int *upstream_reaches; /* indices of reaches that drain into this one */
 int reservoir_ID;
 struct reservoir_object reservoir;
 struct patch_object **lateral_inputs;
@@ -479,10 +843,47 @@ double Qout; /* m3/s */
 struct stream_list_object
         {
         int num_reaches;
+        int num_levels;
+        int *level_start;       /* offsets into level_reaches, num_levels+1 */
+        int *level_reaches;     /* reach indices grouped by level, upstream first */
         double streamflow;
         struct stream_network_object *stream_network;
         };
 
+/*----------------------------------------------------------*/
+/*      Streamflow objective functions (-objective): the     */
+/*      observed series, read once, and the sums of the      */
+/*      evaluated basin, kept with it so that checkpoints    */
+/*      hold them (see update_objective).                    */
+/*----------------------------------------------------------*/
+#define OBJECTIVE_COLUMNS "days NSE logNSE KGE r alpha beta pbias"
+#define NUM_OBJECTIVE_COLUMNS 8
+
+struct objective_sums_object
+        {
+        double  days;
+        double  obs;                    /* mm/day       */
+        double  sim;
+        double  obs_square;
+        double  sim_square;
+        double  obs_sim;
+        double  error_square;
+        double  log_obs;                /* log(mm/day + log_offset) */
+        double  log_obs_square;
+        double  log_error_square;
+        };
+
+struct objective_object
+        {
+        int     basin_ID;
+        long    first_day;              /* julian day of obs[0] */
+        long    num_days;
+        long    window_start;           /* julian days, inclusive */
+        long    window_end;
+        double  log_offset;             /* mm/day       */
+        double  *obs;                   /* mm/day, < 0 if missing */
+        };
+
 /*----------------------------------------------------------*/
 /*	Define a snowpack object.								*/
 /*----------------------------------------------------------*/
@@ -517,9 +918,55 @@ struct	snowpack_object
 	};
 
 
+/*----------------------------------------------------------*/
+/*      Define hillslope schedule object.                   */
+/*      hillslopes of a basin are split into one queue per  */
+/*      thread using their measured cost; threads run their */
+/*      own queue and (steal mode) then help the others     */
+/*----------------------------------------------------------*/
+#define HILLSLOPE_SCHEDULE_STATIC 0
+#define HILLSLOPE_SCHEDULE_COST 1
+#define HILLSLOPE_SCHEDULE_STEAL 2
+
+struct hillslope_schedule_object
+        {
+        int     mode;
+        int     num_hillslopes;
+        int     num_threads;
+        int     num_days;
+        int     *order;                 /* hillslope index, grouped by queue */
+        int     *queue_start;           /* num_threads+1 offsets into order */
+        int     *queue_next;            /* next unclaimed entry of a queue */
+        int     *queue_of;              /* queue of each hillslope */
+        int     *thread_hillslopes;     /* hillslopes run by each thread */
+        double  *units;                 /* patches + strata per hillslope */
+        double  *cost;                  /* s    predicted for today */
+        double  *wall_time;             /* s    measured today */
+        double  *queue_cost;            /* s    predicted for each queue */
+        double  *thread_load;           /* s    busy time over the run */
+        };
+
 /*----------------------------------------------------------*/
 /*      Define basin object.                                */
 /*----------------------------------------------------------*/
+/*----------------------------------------------------------*/
+/*      Index of the objects of a basin by parent and ID (see   */
+/*      construct_id_index).                                    */
+/*----------------------------------------------------------*/
+struct  id_index_entry_object
+        {
+        void    *parent;        /* NULL for an empty entry */
+        int     ID;
+        void    *object;
+        };
+
+struct  id_index_object
+        {
+        int     size;           /* power of 2 */
+        int     count;
+        struct  id_index_entry_object   *entries;
+        };
+
 struct basin_object
         {
         int             ID;                                                                     
@@ -551,6 +998,7 @@ struct basin_object
         double preday_sat_deficit;
         double preday_basin_return_flow;
         double preday_basin_detention_store;
+        double spinup_dropped_inflow;   /* m3 routed into held patches */
         /*                                              */
         
         struct  base_station_object     **base_stations;
@@ -562,9 +1010,13 @@ struct basin_object
         struct  stream_list_object      stream_list;
         struct  routing_list_object     *route_list;
         struct  routing_list_object *surface_route_list;
+        struct  date    road_date;      /* of the routing tables, year 0 if none */
         struct  accumulate_patch_object acc_month;
         struct  accumulate_patch_object acc_year;
         struct  snowpack_object snowpack;
+        struct  hillslope_schedule_object       schedule;
+        struct  id_index_object         *id_index;
+        struct  objective_sums_object   objective_sums;
         };
 
 /*----------------------------------------------------------*/
@@ -621,6 +1073,28 @@ typedef struct base_station_object
         struct  yearly_clim_object       *yearly_clim;
         struct  dated_input_object       *dated_input;
         } base_station_object;
+/*----------------------------------------------------------*/
+/*      Index of the world's base stations, by ID and by     */
+/*      location (see construct_base_station_index)          */
+/*----------------------------------------------------------*/
+struct base_station_index_object
+{
+        int     num_stations;           /* stations entered so far */
+        int     capacity;
+        int     id_size;                /* power of 2 */
+        int     *id_slot;               /* station index, -1 when empty */
+        int     grid_size;              /* power of 2 */
+        double  cell_meter;             /* grid cell of proj_x, proj_y */
+        double  cell_dd;                /* grid cell of lon, lat */
+        int     *meter_bucket;          /* first station of each bucket */
+        int     *meter_next;            /* next station of the same bucket */
+        int     *dd_bucket;
+        int     *dd_next;
+        double  build_seconds;
+        double  assign_seconds;
+        long    num_assigned;
+};
+
 /*----------------------------------------------------------*/
 /*      Define a netcdf base station header object.                                                     */
 /*----------------------------------------------------------*/
@@ -755,7 +1229,65 @@ struct  daily_clim_object
         double  *vpd;                           /*      Pa              */
         double  *wind;                          /*      m/s             */
         double  *wind_direction;                /*      degrees         */
+        long    window_start;           /* day of element 0 of the series; */
+                                        /* 0 unless streamed (-climwindow) */
         };    
+
+/*----------------------------------------------------------*/
+/*      Streamed daily climate (-climwindow): each sequence  */
+/*      file stays open and only window_days values of it   */
+/*      are held, while the next window is read ahead on a   */
+/*      background thread (see update_clim_window).          */
+/*      A grid stream (ascii or netcdf grid) holds the same  */
+/*      sequence of num_series base stations; a netcdf grid  */
+/*      reads ahead into a float window, as the file holds   */
+/*      floats, which is converted at the swap.              */
+/*----------------------------------------------------------*/
+#define CLIM_STREAM_HEAD 3000   /* days kept for clim_repeat, > 8 years */
+#define CLIM_STREAM_SEQUENCE    0
+#define CLIM_STREAM_ASCII_GRID  1
+#define CLIM_STREAM_NETCDF_GRID 2
+
+struct  clim_stream_object
+        {
+        int     type;                   /* CLIM_STREAM_* */
+        FILE    *file;
+        char    filename[FILEPATH_LEN];
+        int     clim_repeat_flag;
+        long    start_date_julian;
+        long    next_day;               /* day of the next value read */
+        long    num_head;
+        double  value;                  /* last value read */
+        double  *head;                  /* first num_head days */
+        int     num_series;             /* base stations fed, 1 unless a grid */
+        double  *buffer[2];             /* current and next window, */
+                                        /* window_days per series */
+        float   *float_buffer;          /* next window of a netcdf grid */
+        double  kelvin_above;           /* netcdf values above it are K */
+        double  multiplier;             /* netcdf values are scaled by it */
+        struct  netcdf_grid_series      *netcdf;
+        double  ***series;              /* daily_clim pointer of each series */
+        struct  daily_clim_object       **daily_clim;
+        struct  clim_stream_object      *next;
+        };
+
+struct  clim_window_object
+        {
+        long    window_days;
+        long    duration;
+        long    window_start;           /* first day of the current window */
+        long    fill_start;             /* first day of the window being read */
+        int     num_streams;
+        int     thread_started;
+        int     fill_requested;
+        int     fill_done;
+        int     quit;
+        double  wait_seconds;           /* simulation time spent waiting */
+        struct  clim_stream_object      *streams;
+        pthread_t       thread;
+        pthread_mutex_t mutex;
+        pthread_cond_t  cond;
+        };
         
 
 /*----------------------------------------------------------*/
@@ -815,6 +1347,79 @@ struct  gw_object
 
         };
 /*----------------------------------------------------------*/
+/*      area weighted patch, strata and zone sums of a          */
+/*      hillslope, taken once a day for the basin and           */
+/*      hillslope output (see aggregate_hillslope_patches.c)    */
+/*----------------------------------------------------------*/
+struct  hillslope_sums_object
+        {
+        double  area;                   /* sq meters of patch   */
+        double  zone_area;              /* sq meters of zone    */
+        double  rain_throughfall;       /* m * m2               */
+        double  rain_throughfall_total; /* m * m2 with 24hours  */
+        double  snow_throughfall;
+        double  precip_with_assim;
+        double  sat_deficit_z;
+        double  sat_deficit;
+        double  recharge;
+        double  rz_storage;
+        double  unsat_storage;
+        double  rz_drainage;
+        double  unsat_drainage;
+        double  cap_rise;
+        double  evaporation;            /* canopy, surface and soil */
+        double  evap_can;
+        double  evap_lit;
+        double  evap_soil;
+        double  sublimation;
+        double  snowpack;
+        double  perc_snow;              /* m2 with snow         */
+        double  snowmelt;
+        double  PET;
+        double  litter_store;
+        double  detention_store;
+        double  acc_year_trans;
+        double  transpiration;
+        double  trans_square;           /* of 1000 * transpiration      */
+        double  acc_year_trans_square;  /* of 1000 * acc_year_trans     */
+        double  litrc;
+        double  Kup, Lup;
+        double  Kstar_can, Kstar_soil, Kstar_snow;
+        double  Lstar_can, Lstar_soil, Lstar_snow;
+        double  LE_can, LE_soil, LE_snow;
+        double  sat_area;               /* m2 saturated         */
+        double  streamflow;             /* of STREAM patches    */
+        double  return_flow;
+        double  base_flow;
+        double  canopy_rain;            /* strata sums weighted by cover */
+        double  psn;
+        double  lai;
+        double  canopy_sublimation;
+        double  dC13;
+        double  mortality_fract;
+        double  gpsn;
+        double  resp;
+        double  gs;
+        double  rootdepth;
+        double  leafc;
+        double  frootc;
+        double  woodc;
+        double  canopy_snow;
+        double  height;
+        double  canopy_Lstar;
+        double  canopy_drip;
+        double  ga;
+        double  pcp;                    /* zone sums            */
+        double  tmin;
+        double  tmax;
+        double  tavg;
+        double  vpd;
+        double  Kdown;
+        double  Ldown;
+        double  snow;
+        };
+
+/*----------------------------------------------------------*/
 /*      Define a hillslope object.                                                              */      
 /*----------------------------------------------------------*/
 struct hillslope_object
@@ -849,6 +1454,7 @@ struct hillslope_object
         struct  zone_object             **zones;
         struct  accumulate_patch_object acc_month;
         struct  accumulate_patch_object acc_year;
+        struct  hillslope_sums_object   daily_sums;
         };
 
 /*----------------------------------------------------------*/
@@ -1080,6 +1686,22 @@ struct  landuse_default
         double  grazing_Closs;                  /* kgC/m2/day */
 };
 /*----------------------------------------------------------*/
+/*	Transmissivity per unit gamma over the soil intervals of	*/
+/*	one soil default, shared by all its patches (see		*/
+/*	compute_transmissivity_curve).					*/
+/*----------------------------------------------------------*/
+struct	transmissivity_table_object
+	{
+	int	num_intervals;
+	int	top_limited;					/* 1 if drainable water can only */
+								/* limit the top intervals */
+	double	interval_size;					/* m */
+	double	*layer;						/* unitless per interval */
+	double	*drainable;					/* m water per interval */
+	double	*profile;					/* sum of layer below */
+	double	*drainable_profile;				/* sum of drainable below */
+	};
+/*----------------------------------------------------------*/
 /*	Define an soil 	default object.						*/
 /*----------------------------------------------------------*/
 struct	soil_default
@@ -1134,6 +1756,7 @@ struct	soil_default
 	double  theta_mean_std_p1;				/* DIM */
 	double  theta_mean_std_p2;				/* DIM */
 	struct soil_class	soil_type;
+	struct transmissivity_table_object *transmissivity_table;
 	};
 
 
@@ -1153,6 +1776,7 @@ struct  innundation_object
 struct  neighbour_object
         {
         double gamma;           /* m**2 / day */
+        int     route_index;    /* position in the basin routing list */
         struct  patch_object *patch;
         };
 /*----------------------------------------------------------*/
@@ -1501,6 +2125,7 @@ struct patch_object
         int             zone_ID;
         int             default_flag;
         int             ID;     
+        int             route_index;    /* position in the basin routing list */
         int             num_base_stations;                              
         int             num_innundation_depths;
         int             num_canopy_strata;
@@ -1508,6 +2133,7 @@ struct patch_object
         int             num_layers;
         int             num_soil_intervals;                             /* unitless */
         int             target_status;
+        int             frozen;         /* held at its spinup targets */
         double  x;                                                                      /* meters       */
         double  y;                                                                      /* meters       */
         double  z;                                                                      /* meters       */
@@ -1723,7 +2349,10 @@ struct patch_object
         double  preday_sat_deficit_z;                   /* meters               */
         double  sat_deficit;                            /* meters water         */
         double  sat_deficit_z;                          /* meters               */
-        double  *transmissivity_profile;                /* array (m/day) */
+        double  *transmissivity_profile;                /* own curve, NULL if table */
+        struct  transmissivity_table_object *transmissivity_table;
+        double  transmissivity_ratio;                   /* area/gamma (day) */
+        int     transmissivity_limit;                   /* intervals limited by drainage */
         struct  snowpack_object snowpack;               /* meters               */
         double  preday_unsat_storage;                   /* meters water         */
         double  preday_rz_storage;                      /* meters water by Taehee Hwang */
@@ -1768,6 +2397,9 @@ struct patch_object
         struct  litter_n_object *shadow_litter_ns;
         struct cdayflux_patch_struct    cdf;
         struct ndayflux_patch_struct    ndf;
+        struct  patch_boundary_flux_object      boundary_flux;
+        struct  patch_object    *frozen_state;  /* the patch as held */
+        struct  soil_spinup_object      soil_spinup;
         };
 
 /*----------------------------------------------------------*/
@@ -1940,12 +2572,33 @@ struct  command_line_object
         int             gridded_netcdf_flag;
         int             grow_flag;
         int             vegspinup_flag; 
+        int             vegspinup_freeze_flag;
+        int             soilspinup_flag;
+        int             soilspinup_years;
+        double          soilspinup_tolerance;
         int             routing_flag;
         int             surface_routing_flag;
         int             stream_routing_flag;
         int             gwtoriparian_flag;
         int             reservoir_operation_flag;
         int             ddn_routing_flag;
+        int             parallel_routing_flag;
+        int             hillslope_schedule;
+        int             hillslope_schedule_report_flag;
+        int             basin_parallel_flag;
+        long            random_seed;
+        long            clim_window_days;
+        int             clim_cache_flag;
+        char            column_levels[8];       /* -colout, subset of bhzpcs */
+        int             output_spec_flag;
+        long            output_buffer_depth;
+        int             restart_flag;
+        int             ensemble_flag;
+        int             ensemble_member;        /* 0 outside an ensemble */
+        int             ensemble_jobs;
+        int             objective_flag;
+        struct  date    objective_start;        /* year 0 if not given */
+        struct  date    objective_end;
         int             dclim_flag;
         int             clim_repeat_flag;
         int             road_flag;
@@ -1959,6 +2612,8 @@ struct  command_line_object
         int             tec_flag;
         int             world_flag;
         int             world_header_flag;
+        int             world_convert_flag;
+        int             column_dump_flag;
         int             start_flag;
         int             end_flag;
         int             firespread_flag;
@@ -1981,6 +2636,12 @@ struct  command_line_object
         char    reservoir_operation_filename[FILEPATH_LEN];
         char    world_filename[FILEPATH_LEN];
         char    world_header_filename[FILEPATH_LEN];
+        char    world_convert_filename[FILEPATH_LEN];
+        char    column_dump_filename[FILEPATH_LEN];
+        char    output_spec_filename[FILEPATH_LEN];
+        char    restart_filename[FILEPATH_LEN];
+        char    ensemble_filename[FILEPATH_LEN];
+        char    objective_filename[FILEPATH_LEN];
         char    tec_filename[FILEPATH_LEN];
         char    vegspinup_filename[FILEPATH_LEN];
         double  tmp_value;
@@ -2034,6 +2695,35 @@ struct tec_entry
         char    command[TEC_CMD_LEN];
         };
 
+/*----------------------------------------------------------*/
+/*      Binary checkpoint of the simulation state (see      */
+/*      execute_checkpoint_event and restore_checkpoint).   */
+/*      The header is followed by the objects of the world  */
+/*      in construction order (see checkpoint_world).       */
+/*----------------------------------------------------------*/
+#define CHECKPOINT_MAGIC "RHESSysR"
+#define CHECKPOINT_VERSION 1
+#define NUM_CHECKPOINT_SIZES 8
+
+struct  checkpoint_header_object
+        {
+        char    magic[8];
+        int     version;
+        size_t  sizes[NUM_CHECKPOINT_SIZES];    /* of the objects written */
+        int     num_basins;
+        long    num_patches;
+        struct  date    resume_date;    /* hour 1 of the next day to run */
+        long    tec_offset;             /* of the next tec entry, -1 at end */
+        struct  output_flag     output_flags;
+        int     road_flag;
+        int     year_day;
+        int     target_status;
+        double  declin;
+        double  cos_declin;
+        double  sin_declin;
+        double  Io;
+        };
+
 
 /*----------------------------------------------------------*/
 /*      Define min and max functions                                                    */
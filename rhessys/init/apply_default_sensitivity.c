@@ -0,0 +1,131 @@
+/*--------------------------------------------------------------*/
+/* 								*/
+/*	apply_default_sensitivity				*/
+/*								*/
+/*	NAME							*/
+/*	apply_default_sensitivity - scales the default		*/
+/*		parameters by the sensitivity multipliers	*/
+/*								*/
+/*	SYNOPSIS						*/
+/*	void apply_default_sensitivity(				*/
+/*			struct default_object *defaults,	*/
+/*			struct command_line_object *command_line) */
+/*								*/
+/*	OPTIONS							*/
+/*	-s, -sv, -svalt, -vgsen, -gw				*/
+/*								*/
+/*	DESCRIPTION						*/
+/*								*/
+/*	Applies the sensitivity multipliers of the command line	*/
+/*	to the soil, hillslope and stratum defaults read by	*/
+/*	construct_*_defaults:					*/
+/*								*/
+/*	-s	soil m, m_z, Ksat_0 and soil_depth			*/
+/*	-sv	vertical m_v, mz_v and Ksat_0_v			*/
+/*	-svalt	psi_air_entry and pore_size_index (p3 and p4	*/
+/*		for theta_psi_curve 3)				*/
+/*	-vgsen	stratum epc.proj_sla and epc.shade_sla_mult	*/
+/*	-gw	soil sat_to_gw_coeff, hillslope gw_loss_coeff	*/
+/*		and gw_loss_fast_coeff				*/
+/*								*/
+/*	and computes soil_water_cap from the scaled soil depth.	*/
+/*	construct_world calls it once the defaults are read; an	*/
+/*	ensemble (-ensemble) reads them once and each member	*/
+/*	calls it with its own multipliers (see run_ensemble).	*/
+/*								*/
+/*	PROGRAMMER NOTES					*/
+/*								*/
+/*	must be called once, before the worldfile is read	*/
+/*--------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include "rhessys.h"
+
+void	apply_default_sensitivity(
+				struct default_object *defaults,
+				struct command_line_object *command_line)
+{
+	/*--------------------------------------------------------------*/
+	/*	Local function definition.				*/
+	/*--------------------------------------------------------------*/
+	double compute_delta_water(int, double, double,	double, double, double);
+
+	/*--------------------------------------------------------------*/
+	/*	Local variable definition.				*/
+	/*--------------------------------------------------------------*/
+	int	i;
+	struct	soil_default	*soil;
+
+	for (i=0; i<defaults[0].num_soil_default_files; i++) {
+		soil = &(defaults[0].soil[i]);
+		if (command_line[0].gw_flag > 0)
+			soil[0].sat_to_gw_coeff *= command_line[0].sat_to_gw_coeff_mult;
+
+		/*--------------------------------------------------------------*/
+		/* sensitivity adjustment of vertical drainage  soil paramters	*/
+		/*--------------------------------------------------------------*/
+		if (command_line[0].vsen_flag > 0) {
+				soil[0].m_v *= command_line[0].vsen[M];
+				soil[0].mz_v *= command_line[0].vsen[M];
+				soil[0].Ksat_0_v *= command_line[0].vsen[K];
+		}
+
+		/*--------------------------------------------------------------*/
+		/* sensitivity adjustment of soil drainage paramters		*/
+		/*--------------------------------------------------------------*/
+		if (command_line[0].sen_flag > 0) {
+				soil[0].m *= command_line[0].sen[M];
+				soil[0].m_z *= command_line[0].sen[M];
+				soil[0].Ksat_0 *= command_line[0].sen[K];
+				soil[0].soil_depth *= command_line[0].sen[SOIL_DEPTH];
+		}
+
+		/*--------------------------------------------------------------*/
+		/*      calculate water_equivalent depth of soil                */
+		/*--------------------------------------------------------------*/
+		soil[0].soil_water_cap = compute_delta_water(
+			0, soil[0].porosity_0,
+			soil[0].porosity_decay,
+			soil[0].soil_depth,
+			soil[0].soil_depth,
+			0.0);
+
+		/*--------------------------------------------------------------*/
+		/* sensitivity adjustment of vertical drainage  soil paramters	*/
+		/* an  scale Pore size index and psi air entry or other parameters	*/
+		/* that control moisture retention (if curve 3 is used)		*/
+		/*--------------------------------------------------------------*/
+		if (command_line[0].vsen_alt_flag > 0) {
+			if (soil[0].theta_psi_curve != 3)  {
+				soil[0].psi_air_entry *= command_line[0].vsen_alt[PA];
+				soil[0].pore_size_index *= command_line[0].vsen_alt[PO];
+				if (soil[0].pore_size_index >= 1.0) {
+					printf("\n Sensitivity analysis giving Pore Size Index > 1.0, not allowed, setting to 1.0\n");
+					soil[0].pore_size_index = 0.999;
+					}
+			}
+			else {
+				soil[0].p3 *= command_line[0].vsen_alt[PA];
+				soil[0].p4 *= command_line[0].vsen_alt[PO];
+			}
+		}
+	}
+
+	if (command_line[0].gw_flag > 0) {
+		for (i=0; i<defaults[0].num_hillslope_default_files; i++) {
+			defaults[0].hillslope[i].gw_loss_coeff *= command_line[0].gw_loss_coeff_mult;
+			defaults[0].hillslope[i].gw_loss_fast_coeff *= command_line[0].gw_loss_coeff_mult;
+		}
+	}
+
+	/*--------------------------------------------------------------*/
+	/*	Apply sensitivity analysis if appropriate		*/
+	/*--------------------------------------------------------------*/
+	if (command_line[0].vgsen_flag == 1) {
+		for (i=0; i<defaults[0].num_stratum_default_files; i++) {
+			defaults[0].stratum[i].epc.proj_sla *= command_line[0].veg_sen1;
+			defaults[0].stratum[i].epc.shade_sla_mult *= command_line[0].veg_sen2;
+		}
+	}
+	return;
+} /*end apply_default_sensitivity*/
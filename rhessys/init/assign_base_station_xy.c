@@ -17,6 +17,7 @@
 /*--------------------------------------------------------------*/
 #include <stdio.h>
 #include <stdlib.h>
+#include <omp.h>
 #include "rhessys.h"
 bool is_close_to_station(const double x, const double y, const base_station_object *station,
                          const base_station_ncheader_object *ncheader);          //160518LML
@@ -27,6 +28,7 @@ struct base_station_object
 					 int		num_base_stations,
 					 int		*notfound,
                      struct	base_station_object	**base_stations,
+                     struct	base_station_index_object *index,
                      const struct base_station_ncheader_object *ncheader         //160518LML
                      //160517LML #ifdef LIU_NETCDF_READER
                      //160517LML ,double dist_tol
@@ -39,43 +41,85 @@ struct base_station_object
 	/*--------------------------------------------------------------*/
 	/*	Local function definition.									*/
 	/*--------------------------------------------------------------*/
+	void	update_base_station_index(
+		struct base_station_index_object *,
+		int,
+		struct base_station_object **);
+	int	base_station_index_cell(
+		struct base_station_index_object *,
+		double,
+		double,
+		double,
+		int,
+		int);
+	int	base_station_index_id(
+		struct base_station_index_object *,
+		int);
 	/*--------------------------------------------------------------*/
 	/*	Local variable definition.									*/
 	/*--------------------------------------------------------------*/
 	int	i;
+	int	fnd;
+	double	start;
 	struct	base_station_object *base_station;
 	/*--------------------------------------------------------------*/
-	/*	Loop through all of the basestations available.			*/
-	/*	and find the record which holds the matching base station	*/
+	/*	Look the base station up in the index; the station found	*/
+	/*	is the first in base_stations that matches, as with a scan	*/
+	/*	of the list.												*/
 	/*--------------------------------------------------------------*/
-	i = 0;
 	if (num_base_stations < 1) {
 		*notfound = 1;
 		return 0;
 	}
-	else {
+	start = omp_get_wtime();
+	update_base_station_index(index, num_base_stations, base_stations);
+	fnd = -1;
         #ifdef FIND_STATION_BASED_ON_ID
-        while ( (*(base_stations[i])).ID != basestation_id ) {
-                
+	i = base_station_index_id(index, basestation_id);
+	while ((fnd == -1) && (index[0].id_slot[i] >= 0)) {
+		if ((*(base_stations[index[0].id_slot[i]])).ID == basestation_id)
+			fnd = index[0].id_slot[i];
+		else
+			i = (i + 1) & (index[0].id_size - 1);
+	}
         #else
-        while (!is_close_to_station(x,y,base_stations[i],ncheader)) {
-        /*160518LML !is_approximately(x,(*(base_stations[i])).x,dist_tol) || !is_approximately(y,(*(base_stations[i])).y,dist_tol) */
+	{
+	int	dx, dy, b;
+	/*--------------------------------------------------------------*/
+	/*	a close station is in the zone's cell or a neighbour, in	*/
+	/*	projected or in geographic coordinates						*/
+	/*--------------------------------------------------------------*/
+	for (dx = -1; dx <= 1; dx++) {
+		for (dy = -1; dy <= 1; dy++) {
+			b = base_station_index_cell(index, x, y,
+				index[0].cell_meter, dx, dy);
+			for (i = index[0].meter_bucket[b]; i >= 0; i = index[0].meter_next[i])
+				if (((fnd == -1) || (i < fnd))
+					&& is_close_to_station(x,y,base_stations[i],ncheader))
+					fnd = i;
+			b = base_station_index_cell(index, x, y,
+				index[0].cell_dd, dx, dy);
+			for (i = index[0].dd_bucket[b]; i >= 0; i = index[0].dd_next[i])
+				if (((fnd == -1) || (i < fnd))
+					&& is_close_to_station(x,y,base_stations[i],ncheader))
+					fnd = i;
+		}
+	}
+	}
         #endif
-            //printf("\n      Assign: Starting while loop: i:%d\tzone_baseid:%d\tbstation_id:%d\tbstation_x:%lf\tbstation_y:%lf\n",i,basestation_id,(*(base_stations[i])).ID,(*(base_stations[i])).x,(*(base_stations[i])).y);
-			i++;
-			/*--------------------------------------------------------------*/
-			/*	Report an error if no match was found.  Otherwise assign	*/
-			/*	the base_station_pointer to point to this base_station.		*/
-			/*--------------------------------------------------------------*/
-			if ( i >= num_base_stations ){
-				//fprintf(stderr,"\n      Assign: NOT FOUND. Adding new base station for %lf %lf",x,y);
-				*notfound = 1;
-				return 0;
-			}
-		}  /* end-while */
-	base_station = base_stations[i];
-	return(base_station);
+	index[0].assign_seconds += omp_get_wtime() - start;
+	index[0].num_assigned += 1;
+	/*--------------------------------------------------------------*/
+	/*	Report an error if no match was found.  Otherwise assign	*/
+	/*	the base_station_pointer to point to this base_station.		*/
+	/*--------------------------------------------------------------*/
+	if (fnd == -1) {
+		//fprintf(stderr,"\n      Assign: NOT FOUND. Adding new base station for %lf %lf",x,y);
+		*notfound = 1;
+		return 0;
 	}
+	base_station = base_stations[fnd];
+	return(base_station);
 } /*end assign_base_station*/
 //160518LML_____________________________________________________________________
 bool is_close_to_station(const double x, const double y, const base_station_object *station,
@@ -12,12 +12,16 @@
 /*					base_station_file_name,						*/
 /*					start_date,									*/
 /*					duration									*/
-/*					column_index);								*/
+/*					clim_window);								*/
 /*																*/
 /*	OPTIONS														*/
 /*																*/
 /*	DESCRIPTION													*/
 /*																*/
+/*	With -climwindow (clim_window not NULL, and a run longer	*/
+/*	than the window) the files are left open at the start		*/
+/*	date and each is streamed for all stations, see			*/
+/*	construct_clim_grid_stream.									*/
 /*																*/
 /*	PROGRAMMER NOTES											*/
 /*	Assumes all climate files start on the same date as tmax	*/
@@ -29,10 +33,59 @@
 #include <math.h>
 #include "rhessys.h"
 
+/*--------------------------------------------------------------*/
+/*	stream_ascii_grid - streams the open file of variable name	*/
+/*		(tmax, tmin, rain, daytime_rain_duration, ndep_NO3 or	*/
+/*		ndep_NH4) for all stations							*/
+/*--------------------------------------------------------------*/
+static void stream_ascii_grid(FILE *file,
+							  char *prefix,
+							  char *name,
+							  int num_base_stations,
+							  struct base_station_object **base_stations,
+							  struct clim_window_object *clim_window)
+{
+	void	*alloc( 	size_t, char *, char *);
+	struct clim_stream_object *construct_clim_grid_stream(int, FILE *,
+		struct netcdf_grid_series *, char *, int, double ***,
+		struct daily_clim_object **, double, double,
+		struct clim_window_object *);
+	int		i;
+	char	filename[MAXSTR];
+	double	***series;
+	struct	daily_clim_object	**daily_clim;
+
+	series = (double ***) alloc(num_base_stations * sizeof(double **),
+		"series", "stream_ascii_grid");
+	daily_clim = (struct daily_clim_object **) alloc(
+		num_base_stations * sizeof(struct daily_clim_object *),
+		"daily_clim", "stream_ascii_grid");
+	for ( i = 0; i < num_base_stations; i++) {
+		daily_clim[i] = base_stations[i][0].daily_clim;
+		if (strcmp(name, "tmax") == 0)
+			series[i] = &(daily_clim[i][0].tmax);
+		else if (strcmp(name, "tmin") == 0)
+			series[i] = &(daily_clim[i][0].tmin);
+		else if (strcmp(name, "rain") == 0)
+			series[i] = &(daily_clim[i][0].rain);
+		else if (strcmp(name, "daytime_rain_duration") == 0)
+			series[i] = &(daily_clim[i][0].daytime_rain_duration);
+		else if (strcmp(name, "ndep_NO3") == 0)
+			series[i] = &(daily_clim[i][0].ndep_NO3);
+		else
+			series[i] = &(daily_clim[i][0].ndep_NH4);
+	}
+	snprintf(filename, MAXSTR, "%s.%s", prefix, name);
+	construct_clim_grid_stream(CLIM_STREAM_ASCII_GRID, file, NULL, filename,
+		num_base_stations, series, daily_clim, 0.0, 1.0, clim_window);
+	return;
+}
+
 struct base_station_object **construct_ascii_grid (
 								char		*base_station_filename,
 								struct		date start_date,
-								struct		date duration)
+								struct		date duration,
+								struct		clim_window_object *clim_window)
 {
 	/*--------------------------------------------------------------*/
 	/*	Local function definition.									*/
@@ -83,6 +136,7 @@ struct base_station_object **construct_ascii_grid (
 	int		i;
 	int		j;
 		int tmp;
+	int		streamed;
 
 	long	julday();
 	long	first_date_julian;
@@ -129,6 +183,7 @@ struct base_station_object **construct_ascii_grid (
 
 	/* allocate daily_optional_clim_sequence_flags struct and make sure set to 0 */
 	memset(&daily_flags, 0, sizeof(struct daily_optional_clim_sequence_flags));
+	streamed = ((clim_window != NULL) && (duration.day > clim_window[0].window_days));
 	
 	
 	/*--------------------------------------------------------------*/
@@ -239,10 +294,17 @@ struct base_station_object **construct_ascii_grid (
 		/* For each daily clim structure allocate clim seqs for all required & optional clims */
 		base_stations[i][0].daily_clim = (struct daily_clim_object *)
 			alloc(1*sizeof(struct daily_clim_object),"daily_clim","construct_daily_clim" );
+		base_stations[i][0].daily_clim[0].window_start = 0;
 		//duration.day is a long that was passed into construct_ascii as a date struct
-		base_stations[i][0].daily_clim[0].tmax = (double *) alloc(duration.day * sizeof(double),"tmax", "construct_ascii_grid");
-		base_stations[i][0].daily_clim[0].tmin = (double *) alloc(duration.day * sizeof(double),"tmin", "construct_ascii_grid");
-		base_stations[i][0].daily_clim[0].rain = (double *) alloc(duration.day * sizeof(double),"rain", "construct_ascii_grid");
+		//streamed sequences point into their stream's window instead
+		base_stations[i][0].daily_clim[0].tmax = NULL;
+		base_stations[i][0].daily_clim[0].tmin = NULL;
+		base_stations[i][0].daily_clim[0].rain = NULL;
+		if (streamed == 0) {
+			base_stations[i][0].daily_clim[0].tmax = (double *) alloc(duration.day * sizeof(double),"tmax", "construct_ascii_grid");
+			base_stations[i][0].daily_clim[0].tmin = (double *) alloc(duration.day * sizeof(double),"tmin", "construct_ascii_grid");
+			base_stations[i][0].daily_clim[0].rain = (double *) alloc(duration.day * sizeof(double),"rain", "construct_ascii_grid");
+		}
 		/*--------------------------------------------------------------*/
 		/*	initialize the rest of the clim sequences as null	*/
 		/*--------------------------------------------------------------*/
@@ -275,16 +337,16 @@ struct base_station_object **construct_ascii_grid (
 		base_stations[i][0].daily_clim[0].ndep_NH4 = NULL;
 		
 		/*Check if any flags are set in the optional clim sequence struct*/
-		if ( daily_flags.daytime_rain_duration == 1 ) {
+		if (( daily_flags.daytime_rain_duration == 1 ) && (streamed == 0)) {
 			   base_stations[i][0].daily_clim[0].daytime_rain_duration = (double *) 
 			alloc(duration.day * sizeof(double),"day_rain_dur", "construct_ascii_grid");
 
 		}
-		if ( daily_flags.ndep_NO3 == 1 ) {
+		if (( daily_flags.ndep_NO3 == 1 ) && (streamed == 0)) {
 			   base_stations[i][0].daily_clim[0].ndep_NO3 = (double *) 
 			alloc(duration.day * sizeof(double),"ndep_NO3", "construct_ascii_grid");
 		}
-		if ( daily_flags.ndep_NH4 == 1 ) {
+		if (( daily_flags.ndep_NH4 == 1 ) && (streamed == 0)) {
 			   base_stations[i][0].daily_clim[0].ndep_NH4 = (double *) 
 			alloc(duration.day * sizeof(double),"ndep_NH4", "construct_ascii_grid");
 		}
@@ -310,6 +372,7 @@ struct base_station_object **construct_ascii_grid (
 		/*	Initialize non - critical sequences.						*/
 		base_stations[i][0].hourly_clim[0].rain.inx = -999;
 		base_stations[i][0].hourly_clim[0].rain_duration.inx = -999;
+		base_stations[i][0].dated_input = NULL;
 	}
 
 	fclose(base_station_file );	
@@ -466,6 +529,29 @@ struct base_station_object **construct_ascii_grid (
 		}
 	}
 	
+	/*--------------------------------------------------------------*/
+	/* Or stream them, leaving the files open						*/
+	/*--------------------------------------------------------------*/
+	if (streamed == 1) {
+		stream_ascii_grid(tmax_file, old_prefix, "tmax",
+			num_base_stations, base_stations, clim_window);
+		stream_ascii_grid(tmin_file, old_prefix, "tmin",
+			num_base_stations, base_stations, clim_window);
+		stream_ascii_grid(rain_file, old_prefix, "rain",
+			num_base_stations, base_stations, clim_window);
+		if (daily_flags.daytime_rain_duration == 1)
+			stream_ascii_grid(daytime_rain_duration_file, old_prefix,
+				"daytime_rain_duration", num_base_stations, base_stations,
+				clim_window);
+		if (daily_flags.ndep_NO3 == 1)
+			stream_ascii_grid(ndep_NO3_file, old_prefix, "ndep_NO3",
+				num_base_stations, base_stations, clim_window);
+		if (daily_flags.ndep_NH4 == 1)
+			stream_ascii_grid(ndep_NH4_file, old_prefix, "ndep_NH4",
+				num_base_stations, base_stations, clim_window);
+		return(base_stations);
+	}
+
 	/*--------------------------------------------------------------*/
 	/* Fill daily clim structures and clim seqs						*/
 	/*--------------------------------------------------------------*/
@@ -150,7 +150,9 @@ struct	base_station_object *construct_base_station(
 													char	*base_station_filename,
 													struct	date start_date,
 													struct	date duration, 
-													int  clim_repeat_flag)
+													int  clim_repeat_flag,
+													int  clim_cache_flag,
+													struct	clim_window_object *clim_window)
 {
 	/*--------------------------------------------------------------*/
 	/*	local function declarations.								*/
@@ -159,30 +161,32 @@ struct	base_station_object *construct_base_station(
 		FILE	*,
 		char	*,
 		struct date,
-		long,int);
+		long,int,int);
 	
 	struct	monthly_clim_object	*construct_monthly_clim(
 		FILE	*,
 		char	*,
 		struct date,
-		long,int);
+		long,int,int);
 	
 	struct	daily_clim_object	*construct_daily_clim(
 		FILE	*,
 		char	*,
 		struct date,
-		long,int);
+		long,int,int,
+		struct clim_window_object *);
 	
 	struct	hourly_clim_object	*construct_hourly_clim(
 		FILE	*,
 		char	*,
 		struct date,
-		long);
+		long,int);
 	
 	struct	dated_input_object	*construct_dated_input(
 		FILE	*,
 		char	*,
-		struct date);
+		struct date,
+		int);
 
 	void	*alloc(	size_t, char *, char *);
 	/*--------------------------------------------------------------*/
@@ -198,6 +202,8 @@ struct	base_station_object *construct_base_station(
 	base_station = (struct base_station_object *)
 		alloc(1 * sizeof(struct base_station_object ),
 		"base_station","construct_base_station");
+	base_station[0].hourly_clim = NULL;
+	base_station[0].dated_input = NULL;
 	
 	/*--------------------------------------------------------------*/
 	/*	Try to open the base station file.							*/
@@ -241,7 +247,7 @@ struct	base_station_object *construct_base_station(
 		base_station[0].base_station_file,
 		clim_object_file_prefix,
 		start_date,
-		duration.year, clim_repeat_flag );
+		duration.year, clim_repeat_flag, clim_cache_flag );
 	}
 	
 	/*--------------------------------------------------------------*/
@@ -257,7 +263,7 @@ struct	base_station_object *construct_base_station(
 		base_station[0].base_station_file,
 		clim_object_file_prefix,
 		start_date,
-		duration.month, clim_repeat_flag );
+		duration.month, clim_repeat_flag, clim_cache_flag );
 	}
 	
 	/*--------------------------------------------------------------*/
@@ -275,7 +281,8 @@ struct	base_station_object *construct_base_station(
 			base_station[0].base_station_file,
 			clim_object_file_prefix,
 			start_date,
-			duration.day, clim_repeat_flag);
+			duration.day, clim_repeat_flag, clim_cache_flag,
+			clim_window);
 	}
 	/*--------------------------------------------------------------*/
 	/*	read in the name of the hourly clim object prefix.			*/
@@ -291,7 +298,7 @@ struct	base_station_object *construct_base_station(
 		base_station[0].base_station_file,
 		clim_object_file_prefix,
 		start_date,
-		duration.hour);
+		duration.hour, clim_cache_flag);
 	}
 	/*--------------------------------------------------------------*/
 	/*	now check to see if there are additional sequences to be read */
@@ -302,7 +309,7 @@ struct	base_station_object *construct_base_station(
 		base_station[0].dated_input = construct_dated_input(
 			base_station[0].base_station_file,
 			clim_object_file_prefix,
-			start_date);
+			start_date, clim_cache_flag);
 			}
 
 	/*--------------------------------------------------------------*/
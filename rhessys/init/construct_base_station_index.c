@@ -0,0 +1,89 @@
+/*--------------------------------------------------------------*/
+/* 								*/
+/*		construct_base_station_index			*/
+/*								*/
+/*	NAME							*/
+/*	construct_base_station_index - index of the world's	*/
+/*		base stations for assign_base_station_xy	*/
+/*								*/
+/*	SYNOPSIS						*/
+/*	struct base_station_index_object *			*/
+/*	construct_base_station_index(				*/
+/*			int num_base_stations,			*/
+/*			struct base_station_object **,		*/
+/*			struct base_station_ncheader_object *)	*/
+/*								*/
+/*	OPTIONS							*/
+/*								*/
+/*	DESCRIPTION						*/
+/*								*/
+/*	Gridded (netcdf) climate gives one base station per	*/
+/*	grid cell, and every zone looks its station up by ID	*/
+/*	or by location.  The index holds a hash table of the	*/
+/*	station IDs and two hashed grids of the station		*/
+/*	locations, one of proj_x/proj_y and one of lon/lat,	*/
+/*	with cells the size of the climate grid resolution, so	*/
+/*	a lookup only looks at the stations of the cells around	*/
+/*	the zone (see assign_base_station_xy).			*/
+/*								*/
+/*	PROGRAMMER NOTES					*/
+/*								*/
+/*	stations added later (construct_netcdf_grid without	*/
+/*	the LIU reader adds them while zones are read) are	*/
+/*	entered by update_base_station_index			*/
+/*--------------------------------------------------------------*/
+#include <stdio.h>
+#include <omp.h>
+#include "rhessys.h"
+
+struct base_station_index_object *construct_base_station_index(
+				int	num_base_stations,
+				struct	base_station_object **base_stations,
+				struct	base_station_ncheader_object *ncheader)
+{
+	/*--------------------------------------------------------------*/
+	/*	Local function definition.				*/
+	/*--------------------------------------------------------------*/
+	void	*alloc(size_t, char *, char *);
+	void	update_base_station_index(
+		struct base_station_index_object *,
+		int,
+		struct base_station_object **);
+
+	/*--------------------------------------------------------------*/
+	/*	Local variable definition.				*/
+	/*--------------------------------------------------------------*/
+	double	start;
+	struct	base_station_index_object *index;
+
+	start = omp_get_wtime();
+	index = (struct base_station_index_object *) alloc(
+		sizeof(struct base_station_index_object),
+		"index", "construct_base_station_index");
+	index[0].num_stations = 0;
+	index[0].capacity = 0;
+	index[0].id_size = 0;
+	index[0].id_slot = NULL;
+	index[0].grid_size = 0;
+	index[0].meter_bucket = NULL;
+	index[0].meter_next = NULL;
+	index[0].dd_bucket = NULL;
+	index[0].dd_next = NULL;
+	index[0].assign_seconds = 0.0;
+	index[0].num_assigned = 0;
+
+	/*--------------------------------------------------------------*/
+	/*	a station is close within half the resolution, so a	*/
+	/*	zone's station is in its cell or a neighbouring one	*/
+	/*--------------------------------------------------------------*/
+	index[0].cell_meter = 1.0;
+	index[0].cell_dd = 1.0;
+	if ((ncheader != NULL) && (ncheader[0].resolution_meter > 0.0))
+		index[0].cell_meter = ncheader[0].resolution_meter;
+	if ((ncheader != NULL) && (ncheader[0].resolution_dd > 0.0))
+		index[0].cell_dd = ncheader[0].resolution_dd;
+
+	update_base_station_index(index, num_base_stations, base_stations);
+	index[0].build_seconds = omp_get_wtime() - start;
+	return(index);
+} /*end construct_base_station_index*/
@@ -10,7 +10,7 @@
 /*	SYNOPSIS													*/
 /*	void construct_basin(										*/
 /*			struct	command_line_object	*command_line,			*/
-/*			FILE	*world_file									*/
+/*			struct world_input_object *world_file	*/
 /*			int		num_world_base_stations,					*/
 /*			struct base_station_object	**world_base_stations,	*/
 /*			struct basin_object	**basin_list,					*/
@@ -55,13 +55,14 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
+#include <string.h>
 
 #include "rhessys.h"
 #include "functions.h"
 
 struct basin_object *construct_basin(
 									 struct	command_line_object	*command_line,
-									 FILE	*world_file,
+									 struct world_input_object *world_file,
 									 int	*num_world_base_stations,
 									 struct base_station_object	**world_base_stations,
 									 struct	default_object	*defaults,
@@ -78,7 +79,7 @@ struct basin_object *construct_basin(
 	
 	struct hillslope_object *construct_hillslope(
 		struct	command_line_object *,
-		FILE    *,
+		struct world_input_object *,
 		int		*,
 		struct base_station_object **,
 		struct	default_object *,
@@ -86,6 +87,8 @@ struct basin_object *construct_basin(
 		struct world_object *);
 	
 	void	*alloc( 	size_t, char *, char *);
+	int	read_world_int(struct world_input_object *);
+	double	read_world_double(struct world_input_object *);
 	
 	void	sort_by_elevation( struct basin_object *);
 	
@@ -102,6 +105,17 @@ struct basin_object *construct_basin(
 		char *,
 		struct basin_object *, 
 		struct	command_line_object *);
+
+	void construct_basin_routing(
+		struct basin_object *,
+		struct	command_line_object *,
+		char *,
+		char *);
+
+	struct id_index_object *construct_id_index( struct basin_object *);
+	void construct_hillslope_schedule(
+		struct basin_object *,
+		struct	command_line_object *);
 	
 	/*--------------------------------------------------------------*/
 	/*	Local variable definition.									*/
@@ -111,7 +125,6 @@ struct basin_object *construct_basin(
 	int		default_object_ID;
 	double		check_snow_scale;
 	double		n_routing_timesteps;
-	char		record[MAXSTR];
 	struct basin_object	*basin;
 	
 	/*--------------------------------------------------------------*/
@@ -119,24 +132,22 @@ struct basin_object *construct_basin(
 	/*--------------------------------------------------------------*/
 	basin = (struct basin_object *) alloc( 1 *
 		sizeof( struct basin_object ),"basin","construct_basin");
+	/*--------------------------------------------------------------*/
+	/*	hourly scratch, reset in place by basin_hourly				*/
+	/*--------------------------------------------------------------*/
+	basin[0].hourly = (struct basin_hourly_object *) alloc(
+		sizeof( struct basin_hourly_object ),"hourly","construct_basin");
 	
 	/*--------------------------------------------------------------*/
 	/*	Read in the basinID.									*/
 	/*--------------------------------------------------------------*/
-	fscanf(world_file,"%d",&(basin[0].ID));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(basin[0].x));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(basin[0].y));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(basin[0].z));
-	read_record(world_file, record);
-	fscanf(world_file,"%d",&(default_object_ID));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(basin[0].latitude));
-	read_record(world_file, record);
-	fscanf(world_file,"%d",&(basin[0].num_base_stations));
-	read_record(world_file, record);
+	basin[0].ID = read_world_int(world_file);
+	basin[0].x = read_world_double(world_file);
+	basin[0].y = read_world_double(world_file);
+	basin[0].z = read_world_double(world_file);
+	default_object_ID = read_world_int(world_file);
+	basin[0].latitude = read_world_double(world_file);
+	basin[0].num_base_stations = read_world_int(world_file);
 	
 	/*--------------------------------------------------------------*/
 	/*	Create cosine of latitude to save future computations.		*/
@@ -155,9 +166,8 @@ struct basin_object *construct_basin(
 	/*--------------------------------------------------------------*/
 	for (i=0 ; i<basin[0].num_base_stations; i++) {
     
-		fscanf(world_file,"%d",&(base_stationID));
+		base_stationID = read_world_int(world_file);
     printf( "*** RECORD %d ***\n", i );
-		read_record(world_file, record);
     //printf ("Base Station ID %d \n", basin[0].base_stations[i][0].ID);
 		/*--------------------------------------------------------------*/
 		/*	Point to the appropriate base station in the base       	*/
@@ -207,8 +217,7 @@ struct basin_object *construct_basin(
 	/*--------------------------------------------------------------*/
 	/*	Read in the number of hillslopes.						*/
 	/*--------------------------------------------------------------*/
-	fscanf(world_file,"%d",&(basin[0].num_hillslopes));
-	read_record(world_file, record);
+	basin[0].num_hillslopes = read_world_int(world_file);
 	
 	/*--------------------------------------------------------------*/
 	/*	Allocate a list of pointers to hillslope objects.			*/
@@ -219,6 +228,8 @@ struct basin_object *construct_basin(
 
 	basin[0].area = 0.0;
 	basin[0].max_slope = 0.0;
+	basin[0].spinup_dropped_inflow = 0.0;
+	memset(&(basin[0].objective_sums), 0, sizeof(struct objective_sums_object));
 	n_routing_timesteps = 0.0;
 	check_snow_scale = 0.0;
 	/*--------------------------------------------------------------*/
@@ -321,6 +332,16 @@ struct basin_object *construct_basin(
 	/*--------------------------------------------------------------*/
 	sort_by_elevation(basin);
 
+	/*--------------------------------------------------------------*/
+	/*	Index the sub-hierarchy by ID for the find_* routines	*/
+	/*--------------------------------------------------------------*/
+	basin[0].id_index = construct_id_index(basin);
+
+	/*--------------------------------------------------------------*/
+	/*	Split the hillslopes among threads				*/
+	/*--------------------------------------------------------------*/
+	construct_hillslope_schedule(basin, command_line);
+
 	/*--------------------------------------------------------------*/
 	/*	Read in flow routing topology for routing option	*/
 	/*--------------------------------------------------------------*/
@@ -330,29 +351,10 @@ struct basin_object *construct_basin(
 			"construct_basin");
 		basin[0].outside_region[0].sat_deficit = 0.0;
 		basin[0].outside_region[0].ID = 0;
-		if ( command_line[0].ddn_routing_flag == 1 ) {
-			basin->route_list = construct_ddn_routing_topology( command_line[0].routing_filename, basin);
-		} else {
-			basin->route_list = construct_routing_topology( command_line[0].routing_filename, basin,
-						command_line, false);
-			if ( command_line->surface_routing_flag ) {
-				printf("\tReading surface routing table\n");
-				basin->surface_route_list =
-						construct_routing_topology( command_line->surface_routing_filename, basin,
-								command_line, true);
-				if ( basin->surface_route_list->num_patches != basin->route_list->num_patches ) {
-					fprintf(stderr,
-							"\nFATAL ERROR: in construct_basin, surface routing table has %d patches, but subsurface routing table has %d patches. The number of patches must be identical.\n",
-							basin->surface_route_list->num_patches, basin->route_list->num_patches);
-					exit(EXIT_FAILURE);
-				}
-			} else {
-				// No surface routing table specified, use sub-surface for surface
-				basin->surface_route_list =
-						construct_routing_topology( command_line->routing_filename, basin,
-								command_line, true);
-			}
-		}
+		construct_basin_routing(basin, command_line, command_line[0].routing_filename,
+			(command_line[0].surface_routing_flag) ?
+			command_line[0].surface_routing_filename : NULL);
+		basin[0].road_date.year = 0;
 	} else { // command_line[0].routing_flag != 1
 		// For TOPMODEL mode, make a dummy route list consisting of all patches
 		// in the basin, in no particular order.
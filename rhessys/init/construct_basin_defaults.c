@@ -66,7 +66,7 @@ struct basin_default *construct_basin_defaults(
 		printf("Reading %s\n", default_files[i]);
                 paramCnt = 0;
                 if (paramPtr != NULL)
-                    free(paramPtr);
+                    freeParams(paramPtr);
 
                 paramPtr = readParamFile(&paramCnt, default_files[i]);
 
@@ -0,0 +1,85 @@
+/*--------------------------------------------------------------*/
+/* 																*/
+/*					construct_basin_routing						*/
+/*																*/
+/*	construct_basin_routing.c - builds the routing of a basin	*/
+/*																*/
+/*	NAME														*/
+/*	construct_basin_routing.c - builds the routing of a basin	*/
+/*																*/
+/*	SYNOPSIS													*/
+/*	void construct_basin_routing(								*/
+/*				struct basin_object *basin,						*/
+/*				struct command_line_object *command_line,		*/
+/*				char *routing_filename,							*/
+/*				char *surface_routing_filename)					*/
+/*																*/
+/*	OPTIONS														*/
+/*																*/
+/*	DESCRIPTION													*/
+/*																*/
+/*	Reads the subsurface and surface routing topology of the	*/
+/*	basin and builds the routing state (route indices and flux	*/
+/*	arrays) that compute_subsurface_routing works on, and with	*/
+/*	-parallelrouting the inflow links of each patch.  With a	*/
+/*	NULL surface_routing_filename the subsurface table is also	*/
+/*	used for surface flow.										*/
+/*																*/
+/*	Called by construct_basin and, with the tables of the		*/
+/*	event date, by execute_road_construction_event once the		*/
+/*	old routing has been freed by destroy_basin_routing.		*/
+/*																*/
+/*	PROGRAMMER NOTES											*/
+/*																*/
+/*	with -ddn the surface route list is not used and is NULL	*/
+/*--------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include "rhessys.h"
+#include "functions.h"
+
+void construct_basin_routing(
+							 struct basin_object *basin,
+							 struct command_line_object *command_line,
+							 char *routing_filename,
+							 char *surface_routing_filename)
+{
+	/*--------------------------------------------------------------*/
+	/*	Local function definition.									*/
+	/*--------------------------------------------------------------*/
+	void construct_routing_state(
+		struct basin_object *);
+	void construct_routing_inflows(
+		struct routing_list_object *,
+		struct	command_line_object *);
+
+	if ( command_line[0].ddn_routing_flag == 1 ) {
+		basin->route_list = construct_ddn_routing_topology( routing_filename, basin);
+		basin->surface_route_list = NULL;
+	} else {
+		basin->route_list = construct_routing_topology( routing_filename, basin,
+					command_line, false);
+		if ( surface_routing_filename != NULL ) {
+			printf("\tReading surface routing table\n");
+			basin->surface_route_list =
+					construct_routing_topology( surface_routing_filename, basin,
+							command_line, true);
+			if ( basin->surface_route_list->num_patches != basin->route_list->num_patches ) {
+				fprintf(stderr,
+						"\nFATAL ERROR: in construct_basin_routing, surface routing table has %d patches, but subsurface routing table has %d patches. The number of patches must be identical.\n",
+						basin->surface_route_list->num_patches, basin->route_list->num_patches);
+				exit(EXIT_FAILURE);
+			}
+		} else {
+			// No surface routing table specified, use sub-surface for surface
+			basin->surface_route_list =
+					construct_routing_topology( routing_filename, basin,
+							command_line, true);
+		}
+	}
+	construct_routing_state(basin);
+	basin->route_list->outflow = NULL;
+	if ( command_line[0].parallel_routing_flag == 1 )
+		construct_routing_inflows(basin->route_list, command_line);
+	return;
+} /*end construct_basin_routing.c*/
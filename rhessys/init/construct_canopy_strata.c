@@ -10,7 +10,12 @@
 /*	SYNOPSIS													*/
 /*	struct canopy_strata_object  construct_canopy_strata( 		*/
 /*				struct	command_line_object	*command_line,		*/
-/*				FILE	*world_file)						*/
+/*				struct world_input_object *world_file,	*/
+/*				struct	patch_object	*patch,				*/
+/*				int	num_world_base_stations,				*/
+/*				struct	base_station_object **world_base_stations,	*/
+/*				struct	default_object	*defaults,			*/
+/*				struct	arena_object	*arena)				*/
 /*																*/
 /*																*/
 /*	OPTIONS														*/
@@ -19,6 +24,7 @@
 /*																*/
 /*	Allocates memory for a canopy strata object and reads in 	*/
 /*	parameters for the object from an open hillslopes file.		*/
+/*	The object and its lists come from the world arena.		*/
 /*																*/
 /*	Refer to construct_basin.c for a specification of the 		*/
 /*	hillslopes file.											*/
@@ -43,11 +49,12 @@
 
 struct canopy_strata_object *construct_canopy_strata(
 													 struct	command_line_object	*command_line,
-													 FILE	*world_file,
+													 struct world_input_object *world_file,
 													 struct	patch_object	*patch,
 													 int		num_world_base_stations,
 													 struct base_station_object **world_base_stations,
-													 struct	default_object	*defaults)
+													 struct	default_object	*defaults,
+													 struct	arena_object	*arena)
 {
 	/*--------------------------------------------------------------*/
 	/*	Local function definition.									*/
@@ -77,6 +84,9 @@ struct canopy_strata_object *construct_canopy_strata(
 		double);
 
 	void	*alloc(size_t, char *, char *);
+	int	read_world_int(struct world_input_object *);
+	double	read_world_double(struct world_input_object *);
+	void	*arena_alloc(struct arena_object *, int, size_t, char *, char *);
 	/*--------------------------------------------------------------*/
 	/*	Local variable definition.									*/
 	/*--------------------------------------------------------------*/
@@ -84,129 +94,82 @@ struct canopy_strata_object *construct_canopy_strata(
 	int	i;
 	double	sai, rootc;
 	int	default_object_ID; 
-	int     spinup_default_object_ID; 
-	char	record[MAXSTR];
+	int     spinup_default_object_ID = 0; 
 	struct	canopy_strata_object	*canopy_strata;
 	
 	/*--------------------------------------------------------------*/
 	/*  Allocate a canopy_strata object.                                */
 	/*--------------------------------------------------------------*/
-	canopy_strata = (struct canopy_strata_object *) alloc( 1 *
+	canopy_strata = (struct canopy_strata_object *) arena_alloc(arena, ARENA_STRATUM, 1 *
 		sizeof( struct canopy_strata_object ),"canopy_strata",
 		"construct_canopy_strata" );
+	/*--------------------------------------------------------------*/
+	/*	hourly scratch, reset in place by canopy_stratum_hourly		*/
+	/*--------------------------------------------------------------*/
+	canopy_strata[0].hourly = (struct canopy_strata_hourly_object *) arena_alloc(
+		arena, ARENA_LIST, sizeof( struct canopy_strata_hourly_object ),
+		"hourly", "construct_canopy_strata" );
 	
 	/*--------------------------------------------------------------*/
 	/*	Read in the next canopy strata record for this patch.	*/
 	/*--------------------------------------------------------------*/
-	fscanf(world_file,"%d",&(canopy_strata[0].ID));
-	read_record(world_file, record);
-	fscanf(world_file,"%d",&(default_object_ID));
-	read_record(world_file, record);
+	canopy_strata[0].ID = read_world_int(world_file);
+	default_object_ID = read_world_int(world_file);
 	if (command_line[0].vegspinup_flag > 0){
-	    fscanf(world_file,"%d",&(spinup_default_object_ID));
-	    read_record(world_file, record);
+	    spinup_default_object_ID = read_world_int(world_file);
         }
-  fscanf(world_file,"%lf",&(canopy_strata[0].cover_fraction));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(canopy_strata[0].gap_fraction));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(canopy_strata[0].rootzone.depth));
-	read_record(world_file, record);
+  canopy_strata[0].cover_fraction = read_world_double(world_file);
+	canopy_strata[0].gap_fraction = read_world_double(world_file);
+	canopy_strata[0].rootzone.depth = read_world_double(world_file);
 		if (command_line[0].tmp_value > ZERO)
 			canopy_strata[0].rootzone.depth *= command_line[0].tmp_value;
 
-	fscanf(world_file,"%lf",&(canopy_strata[0].snow_stored));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(canopy_strata[0].rain_stored));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(canopy_strata[0].cs.cpool));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(canopy_strata[0].cs.leafc));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(canopy_strata[0].cs.dead_leafc));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(canopy_strata[0].cs.leafc_store));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(canopy_strata[0].cs.leafc_transfer));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(canopy_strata[0].cs.live_stemc));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(canopy_strata[0].cs.livestemc_store));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(canopy_strata[0].cs.livestemc_transfer));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(canopy_strata[0].cs.dead_stemc));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(canopy_strata[0].cs.deadstemc_store));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(canopy_strata[0].cs.deadstemc_transfer));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(canopy_strata[0].cs.live_crootc));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(canopy_strata[0].cs.livecrootc_store));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(canopy_strata[0].cs.livecrootc_transfer));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(canopy_strata[0].cs.dead_crootc));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(canopy_strata[0].cs.deadcrootc_store));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(canopy_strata[0].cs.deadcrootc_transfer));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(canopy_strata[0].cs.frootc));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(canopy_strata[0].cs.frootc_store));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(canopy_strata[0].cs.frootc_transfer));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(canopy_strata[0].cs.cwdc));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(canopy_strata[0].epv.prev_leafcalloc));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(canopy_strata[0].ns.npool));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(canopy_strata[0].ns.leafn));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(canopy_strata[0].ns.dead_leafn));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(canopy_strata[0].ns.leafn_store));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(canopy_strata[0].ns.leafn_transfer));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(canopy_strata[0].ns.live_stemn));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(canopy_strata[0].ns.livestemn_store));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(canopy_strata[0].ns.livestemn_transfer));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(canopy_strata[0].ns.dead_stemn));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(canopy_strata[0].ns.deadstemn_store));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(canopy_strata[0].ns.deadstemn_transfer));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(canopy_strata[0].ns.live_crootn));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(canopy_strata[0].ns.livecrootn_store));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(canopy_strata[0].ns.livecrootn_transfer));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(canopy_strata[0].ns.dead_crootn));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(canopy_strata[0].ns.deadcrootn_store));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(canopy_strata[0].ns.deadcrootn_transfer));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(canopy_strata[0].ns.frootn));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(canopy_strata[0].ns.frootn_store));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(canopy_strata[0].ns.frootn_transfer));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(canopy_strata[0].ns.cwdn));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(canopy_strata[0].ns.retransn));
-	read_record(world_file, record);
+	canopy_strata[0].snow_stored = read_world_double(world_file);
+	canopy_strata[0].rain_stored = read_world_double(world_file);
+	canopy_strata[0].cs.cpool = read_world_double(world_file);
+	canopy_strata[0].cs.leafc = read_world_double(world_file);
+	canopy_strata[0].cs.dead_leafc = read_world_double(world_file);
+	canopy_strata[0].cs.leafc_store = read_world_double(world_file);
+	canopy_strata[0].cs.leafc_transfer = read_world_double(world_file);
+	canopy_strata[0].cs.live_stemc = read_world_double(world_file);
+	canopy_strata[0].cs.livestemc_store = read_world_double(world_file);
+	canopy_strata[0].cs.livestemc_transfer = read_world_double(world_file);
+	canopy_strata[0].cs.dead_stemc = read_world_double(world_file);
+	canopy_strata[0].cs.deadstemc_store = read_world_double(world_file);
+	canopy_strata[0].cs.deadstemc_transfer = read_world_double(world_file);
+	canopy_strata[0].cs.live_crootc = read_world_double(world_file);
+	canopy_strata[0].cs.livecrootc_store = read_world_double(world_file);
+	canopy_strata[0].cs.livecrootc_transfer = read_world_double(world_file);
+	canopy_strata[0].cs.dead_crootc = read_world_double(world_file);
+	canopy_strata[0].cs.deadcrootc_store = read_world_double(world_file);
+	canopy_strata[0].cs.deadcrootc_transfer = read_world_double(world_file);
+	canopy_strata[0].cs.frootc = read_world_double(world_file);
+	canopy_strata[0].cs.frootc_store = read_world_double(world_file);
+	canopy_strata[0].cs.frootc_transfer = read_world_double(world_file);
+	canopy_strata[0].cs.cwdc = read_world_double(world_file);
+	canopy_strata[0].epv.prev_leafcalloc = read_world_double(world_file);
+	canopy_strata[0].ns.npool = read_world_double(world_file);
+	canopy_strata[0].ns.leafn = read_world_double(world_file);
+	canopy_strata[0].ns.dead_leafn = read_world_double(world_file);
+	canopy_strata[0].ns.leafn_store = read_world_double(world_file);
+	canopy_strata[0].ns.leafn_transfer = read_world_double(world_file);
+	canopy_strata[0].ns.live_stemn = read_world_double(world_file);
+	canopy_strata[0].ns.livestemn_store = read_world_double(world_file);
+	canopy_strata[0].ns.livestemn_transfer = read_world_double(world_file);
+	canopy_strata[0].ns.dead_stemn = read_world_double(world_file);
+	canopy_strata[0].ns.deadstemn_store = read_world_double(world_file);
+	canopy_strata[0].ns.deadstemn_transfer = read_world_double(world_file);
+	canopy_strata[0].ns.live_crootn = read_world_double(world_file);
+	canopy_strata[0].ns.livecrootn_store = read_world_double(world_file);
+	canopy_strata[0].ns.livecrootn_transfer = read_world_double(world_file);
+	canopy_strata[0].ns.dead_crootn = read_world_double(world_file);
+	canopy_strata[0].ns.deadcrootn_store = read_world_double(world_file);
+	canopy_strata[0].ns.deadcrootn_transfer = read_world_double(world_file);
+	canopy_strata[0].ns.frootn = read_world_double(world_file);
+	canopy_strata[0].ns.frootn_store = read_world_double(world_file);
+	canopy_strata[0].ns.frootn_transfer = read_world_double(world_file);
+	canopy_strata[0].ns.cwdn = read_world_double(world_file);
+	canopy_strata[0].ns.retransn = read_world_double(world_file);
 
 	if (command_line[0].vegspinup_flag > 0){
      canopy_strata[0].target.lai = NULLVAL;
@@ -217,19 +180,16 @@ struct canopy_strata_object *construct_canopy_strata(
 	/*--------------------------------------------------------------*/
 	/*	intialized annual flux variables			*/
 	/*--------------------------------------------------------------*/
-	fscanf(world_file,"%d",&(canopy_strata[0].epv.wstress_days));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(canopy_strata[0].epv.max_fparabs));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(canopy_strata[0].epv.min_vwc));
-	read_record(world_file, record);
+	canopy_strata[0].epv.wstress_days = read_world_int(world_file);
+	canopy_strata[0].epv.max_fparabs = read_world_double(world_file);
+	canopy_strata[0].epv.min_vwc = read_world_double(world_file);
 	
 
 	/*--------------------------------------------------------------*/
 	/*	Assign	defaults for this canopy_strata								*/
 	/*--------------------------------------------------------------*/
 	canopy_strata[0].defaults = (struct stratum_default **)
-		alloc( sizeof(struct stratum_default *),"defaults",
+		arena_alloc(arena, ARENA_LIST, sizeof(struct stratum_default *),"defaults",
 		"construct_canopy_strata" );
 	i = 0;
 	while (defaults[0].stratum[i].ID != default_object_ID) {
@@ -252,7 +212,7 @@ struct canopy_strata_object *construct_canopy_strata(
 	/*--------------------------------------------------------------*/
 	if (command_line[0].vegspinup_flag > 0) {
 	canopy_strata[0].spinup_defaults = (struct spinup_default **)
-		alloc( sizeof(struct spinup_default *),"defaults",
+		arena_alloc(arena, ARENA_LIST, sizeof(struct spinup_default *),"defaults",
 		"construct_stratum" );
 	i = 0;
 	while (defaults[0].spinup[i].ID != spinup_default_object_ID) {
@@ -521,21 +481,19 @@ struct canopy_strata_object *construct_canopy_strata(
 	/*--------------------------------------------------------------*/
 	/*	Read in the number of  strata base stations 					*/
 	/*--------------------------------------------------------------*/
-	fscanf(world_file,"%d",&(canopy_strata[0].num_base_stations));
-	read_record(world_file, record);
+	canopy_strata[0].num_base_stations = read_world_int(world_file);
 	/*--------------------------------------------------------------*/
 	/*    Allocate a list of base stations for this strata.			*/
 	/*--------------------------------------------------------------*/
 	canopy_strata[0].base_stations = (struct base_station_object **)
-		alloc(canopy_strata[0].num_base_stations *
+		arena_alloc(arena, ARENA_LIST, canopy_strata[0].num_base_stations *
 		sizeof(struct base_station_object *),"base_stations",
 		"construct_canopy_strata");
 	/*--------------------------------------------------------------*/
 	/* Read each base_station ID and then point to that base_station*/
 	/*--------------------------------------------------------------*/
 	for (i=0 ; i<canopy_strata[0].num_base_stations; i++){
-		fscanf(world_file,"%d",&(base_stationID));
-		read_record(world_file, record);
+		base_stationID = read_world_int(world_file);
 		/*--------------------------------------------------------------*/
 		/*	Point to the appropriate base station in the base       	*/
 		/*              station list for this world.					*/
@@ -0,0 +1,117 @@
+/*--------------------------------------------------------------*/
+/* 																*/
+/*					construct_clim_grid_stream 					*/
+/*																*/
+/*	construct_clim_grid_stream - streams a gridded clim variable	*/
+/*																*/
+/*	NAME														*/
+/*	construct_clim_grid_stream - streams a gridded clim variable	*/
+/*																*/
+/*	SYNOPSIS													*/
+/*	struct clim_stream_object *construct_clim_grid_stream(		*/
+/*				int type,										*/
+/*				FILE *file,										*/
+/*				struct netcdf_grid_series *netcdf,				*/
+/*				char *filename,									*/
+/*				int num_series,									*/
+/*				double ***series,								*/
+/*				struct daily_clim_object **daily_clim,			*/
+/*				double kelvin_above,							*/
+/*				double multiplier,								*/
+/*				struct clim_window_object *clim_window)			*/
+/*																*/
+/*	OPTIONS														*/
+/*	type - CLIM_STREAM_ASCII_GRID (file positioned at the		*/
+/*		start date) or CLIM_STREAM_NETCDF_GRID (netcdf opened	*/
+/*		at the start date)										*/
+/*	series[s] - the daily_clim pointer of base station s		*/
+/*	kelvin_above, multiplier - netcdf conversion, see			*/
+/*		swap_clim_stream										*/
+/*																*/
+/*	DESCRIPTION													*/
+/*																*/
+/*	The grid counterpart of construct_clim_stream: one stream	*/
+/*	holds the windows of a variable for all num_series base		*/
+/*	stations of construct_ascii_grid or						*/
+/*	construct_netcdf_grid_clim.  The first window is read and	*/
+/*	made current, so that series[s] points at day 0 of station	*/
+/*	s, and the stream is added to the clim window.				*/
+/*																*/
+/*	PROGRAMMER NOTES											*/
+/*																*/
+/*	the stream keeps series and daily_clim						*/
+/*	a netcdf grid reads ahead into a float window (the file		*/
+/*	holds floats); the current window is double, as zone_daily_I	*/
+/*	reads it													*/
+/*--------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "rhessys.h"
+
+struct clim_stream_object *construct_clim_grid_stream(int type,
+							  FILE *file,
+							  struct netcdf_grid_series *netcdf,
+							  char *filename,
+							  int num_series,
+							  double ***series,
+							  struct daily_clim_object **daily_clim,
+							  double kelvin_above,
+							  double multiplier,
+							  struct clim_window_object *clim_window)
+{
+	/*--------------------------------------------------------------*/
+	/*	local function declarations.								*/
+	/*--------------------------------------------------------------*/
+	void	*alloc(size_t, char *, char *);
+	void	read_clim_stream(struct clim_stream_object *, long, long);
+	void	swap_clim_stream(struct clim_stream_object *, long, long);
+	/*--------------------------------------------------------------*/
+	/*	local variable declarations 								*/
+	/*--------------------------------------------------------------*/
+	size_t	window_values;
+	struct	clim_stream_object	*stream;
+
+	window_values = (size_t)num_series * clim_window[0].window_days;
+	stream = (struct clim_stream_object *) alloc(
+		sizeof(struct clim_stream_object),
+		"stream", "construct_clim_grid_stream");
+	stream[0].type = type;
+	stream[0].file = file;
+	stream[0].netcdf = netcdf;
+	strncpy(stream[0].filename, filename, FILEPATH_LEN-1);
+	stream[0].filename[FILEPATH_LEN-1] = '\0';
+	stream[0].clim_repeat_flag = 0;
+	stream[0].next_day = 0;
+	stream[0].num_head = 0;
+	stream[0].head = NULL;
+	stream[0].kelvin_above = kelvin_above;
+	stream[0].multiplier = multiplier;
+	stream[0].num_series = num_series;
+	stream[0].series = series;
+	stream[0].daily_clim = daily_clim;
+	stream[0].buffer[0] = (double *) alloc(window_values*sizeof(double),
+		"buffer", "construct_clim_grid_stream");
+	if (type == CLIM_STREAM_NETCDF_GRID) {
+		stream[0].buffer[1] = NULL;
+		stream[0].float_buffer = (float *) alloc(window_values*sizeof(float),
+			"float_buffer", "construct_clim_grid_stream");
+	}
+	else {
+		stream[0].buffer[1] = (double *) alloc(window_values*sizeof(double),
+			"buffer", "construct_clim_grid_stream");
+		stream[0].float_buffer = NULL;
+	}
+
+	/*--------------------------------------------------------------*/
+	/*	Read the first window.										*/
+	/*--------------------------------------------------------------*/
+	read_clim_stream(stream, clim_window[0].window_days,
+		clim_window[0].window_days);
+	swap_clim_stream(stream, clim_window[0].window_days, 0);
+
+	stream[0].next = clim_window[0].streams;
+	clim_window[0].streams = stream;
+	clim_window[0].num_streams += 1;
+	return(stream);
+} /*end construct_clim_grid_stream*/
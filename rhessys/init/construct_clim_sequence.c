@@ -21,6 +21,8 @@
 /*	Reads clim data into the allocated array as long as the		*/
 /*		EOF is not present.										*/
 /*	Returns the clim sequence array.							*/
+/*	With -climcache the array is kept in <file>.cache and read	*/
+/*	back from there while file and dates are unchanged.			*/
 /*																*/
 /*																*/
 /*	PROGRAMMER NOTES											*/
@@ -54,7 +56,8 @@
 #include "rhessys.h"
 
 double *construct_clim_sequence(char *file, struct date start_date,
-								long duration, int clim_repeat_flag)
+								long duration, int clim_repeat_flag,
+								int clim_cache_flag)
 {
 	/*--------------------------------------------------------------*/
 	/*	local function declarations.								*/
@@ -62,6 +65,8 @@ double *construct_clim_sequence(char *file, struct date start_date,
 	void	*alloc(size_t, char *, char *);
 	long	julday(struct date);
 	struct  date caldat(long);
+	void	*read_clim_cache(char *, struct clim_cache_header_object *);
+	void	write_clim_cache(char *, struct clim_cache_header_object *, void *);
 	/*--------------------------------------------------------------*/
 	/*	local variable declarations 								*/
 	/*--------------------------------------------------------------*/
@@ -76,8 +81,22 @@ double *construct_clim_sequence(char *file, struct date start_date,
 	FILE	*sequence_file;
 	struct	date	first_date;
 	struct	date	target_date, curr_date;
+	struct	clim_cache_header_object	cache_key;
 
 
+	/*--------------------------------------------------------------*/
+	/*	Use the parsed sequence of an earlier run if there is one.	*/
+	/*--------------------------------------------------------------*/
+	if (clim_cache_flag == 1) {
+		cache_key.kind = CLIM_CACHE_SEQUENCE;
+		cache_key.record_size = sizeof(double);
+		cache_key.clim_repeat_flag = clim_repeat_flag;
+		cache_key.start_date_julian = julday(start_date);
+		cache_key.duration = duration;
+		sequence = (double *) read_clim_cache(file, &cache_key);
+		if (sequence != NULL)
+			return(sequence);
+	}
 	/*--------------------------------------------------------------*/
 	/*	Allocate the clim sequence.									*/
 	/*--------------------------------------------------------------*/
@@ -160,5 +179,9 @@ double *construct_clim_sequence(char *file, struct date start_date,
 		}
 	}
 	fclose(sequence_file);
+	if (clim_cache_flag == 1) {
+		cache_key.num_records = duration;
+		write_clim_cache(file, &cache_key, sequence);
+	}
 	return(sequence);
 } /*end construct_clim_sequence*/
@@ -0,0 +1,140 @@
+/*--------------------------------------------------------------*/
+/* 																*/
+/*					construct_clim_stream	 					*/
+/*																*/
+/*	construct_clim_stream - opens a streamed clim sequence		*/
+/*																*/
+/*	NAME														*/
+/*	construct_clim_stream - opens a streamed clim sequence		*/
+/*																*/
+/*	SYNOPSIS													*/
+/*	double *construct_clim_stream(char *file,					*/
+/*				struct date start_date,							*/
+/*				long duration,									*/
+/*				int clim_repeat_flag,							*/
+/*				int clim_cache_flag,							*/
+/*				struct clim_window_object *clim_window,			*/
+/*				double **series,								*/
+/*				struct daily_clim_object *daily_clim)			*/
+/*																*/
+/*	OPTIONS														*/
+/*	series - the daily_clim pointer the sequence is returned to	*/
+/*																*/
+/*	DESCRIPTION													*/
+/*																*/
+/*	Without a clim window (or when the run fits in one) this	*/
+/*	is construct_clim_sequence.									*/
+/*																*/
+/*	Otherwise the sequence file is opened and positioned at		*/
+/*	the start date as construct_clim_sequence does, the first	*/
+/*	window_days values are read and the file is left open for	*/
+/*	update_clim_window, which reads the following windows.		*/
+/*	Returns the first window; element 0 is the start date.		*/
+/*																*/
+/*	PROGRAMMER NOTES											*/
+/*																*/
+/*	values stay double - they are read with %lf and used as		*/
+/*	such, so a streamed run is identical to one that holds the	*/
+/*	whole sequence												*/
+/*--------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "rhessys.h"
+
+double *construct_clim_stream(char *file, struct date start_date,
+							  long duration, int clim_repeat_flag,
+							  int clim_cache_flag,
+							  struct clim_window_object *clim_window,
+							  double **series,
+							  struct daily_clim_object *daily_clim)
+{
+	/*--------------------------------------------------------------*/
+	/*	local function declarations.								*/
+	/*--------------------------------------------------------------*/
+	void	*alloc(size_t, char *, char *);
+	long	julday(struct date);
+	double	*construct_clim_sequence(char *, struct date, long, int, int);
+	void	read_clim_stream(struct clim_stream_object *, long, long);
+	void	swap_clim_stream(struct clim_stream_object *, long, long);
+	/*--------------------------------------------------------------*/
+	/*	local variable declarations 								*/
+	/*--------------------------------------------------------------*/
+	long	i;
+	long	offset;
+	double	value;
+	struct	date	first_date;
+	struct	clim_stream_object	*stream;
+
+	if ((clim_window == NULL) || (duration <= clim_window[0].window_days))
+		return(construct_clim_sequence(file, start_date, duration,
+			clim_repeat_flag, clim_cache_flag));
+
+	stream = (struct clim_stream_object *) alloc(
+		sizeof(struct clim_stream_object),
+		"stream", "construct_clim_stream");
+	stream[0].type = CLIM_STREAM_SEQUENCE;
+	strncpy(stream[0].filename, file, FILEPATH_LEN-1);
+	stream[0].filename[FILEPATH_LEN-1] = '\0';
+	if ( (stream[0].file = fopen(file, "r") ) == NULL ){
+		fprintf(stderr,
+			"\nFATAL ERROR: in construct_clim_stream\nunable to open sequence file %s\n", file);
+		exit(EXIT_FAILURE);
+	} /*end if*/
+	/*--------------------------------------------------------------*/
+	/*	Skip to the start date, as construct_clim_sequence.		*/
+	/*--------------------------------------------------------------*/
+	fscanf(stream[0].file,"%ld %ld %ld %ld",&first_date.year,
+		&first_date.month,&first_date.day,&first_date.hour);
+	stream[0].start_date_julian = julday(start_date);
+	offset = stream[0].start_date_julian - julday(first_date);
+	if ( offset < 0 ){
+		fprintf(stderr,
+			"FATAL ERROR: start date before first date of a clim sequence.\n");
+		exit(EXIT_FAILURE);
+	}
+	value = 0.0;
+	for ( i = 0 ; i<offset ; i++ ){
+		if ( fscanf(stream[0].file,"%lf",&value) == EOF  ) {
+			fprintf(stderr,"FATAL ERROR: in construct_clim_stream\n - start date beyond eof in %s\n", file);
+			exit(EXIT_FAILURE);
+		}
+	}
+
+	/*--------------------------------------------------------------*/
+	/*	Read the first window.										*/
+	/*--------------------------------------------------------------*/
+	stream[0].clim_repeat_flag = clim_repeat_flag;
+	stream[0].next_day = 0;
+	stream[0].value = value;
+	if (clim_repeat_flag == 0)
+		stream[0].num_head = 0;
+	else
+		stream[0].num_head = min(duration, CLIM_STREAM_HEAD);
+	stream[0].head = (double *) alloc((stream[0].num_head+1)*sizeof(double),
+		"head", "construct_clim_stream");
+	stream[0].buffer[0] = (double *) alloc(
+		clim_window[0].window_days*sizeof(double),
+		"buffer", "construct_clim_stream");
+	stream[0].buffer[1] = (double *) alloc(
+		clim_window[0].window_days*sizeof(double),
+		"buffer", "construct_clim_stream");
+	stream[0].float_buffer = NULL;
+	stream[0].netcdf = NULL;
+	stream[0].num_series = 1;
+	stream[0].series = (double ***) alloc(sizeof(double **),
+		"series", "construct_clim_stream");
+	stream[0].series[0] = series;
+	stream[0].daily_clim = (struct daily_clim_object **) alloc(
+		sizeof(struct daily_clim_object *),
+		"daily_clim", "construct_clim_stream");
+	stream[0].daily_clim[0] = daily_clim;
+	read_clim_stream(stream, clim_window[0].window_days,
+		clim_window[0].window_days);
+	swap_clim_stream(stream, clim_window[0].window_days, 0);
+
+	stream[0].next = clim_window[0].streams;
+	clim_window[0].streams = stream;
+	clim_window[0].num_streams += 1;
+	return(stream[0].buffer[0]);
+} /*end construct_clim_stream*/
@@ -0,0 +1,65 @@
+/*--------------------------------------------------------------*/
+/* 																*/
+/*					construct_clim_window	 					*/
+/*																*/
+/*	construct_clim_window - window of streamed daily climate	*/
+/*																*/
+/*	NAME														*/
+/*	construct_clim_window - window of streamed daily climate	*/
+/*																*/
+/*	SYNOPSIS													*/
+/*	struct clim_window_object *construct_clim_window(			*/
+/*				long window_days,								*/
+/*				long duration)									*/
+/*																*/
+/*	OPTIONS														*/
+/*	-climwindow <window_days>									*/
+/*																*/
+/*	DESCRIPTION													*/
+/*																*/
+/*	Makes the (empty) list of streamed daily clim sequences.	*/
+/*	construct_clim_stream adds a sequence to it for each file	*/
+/*	construct_daily_clim reads, and construct_clim_grid_stream	*/
+/*	one for each variable of an ascii or netcdf grid;			*/
+/*	update_clim_window then moves all of them forward together	*/
+/*	as the simulation days pass.								*/
+/*																*/
+/*	PROGRAMMER NOTES											*/
+/*																*/
+/*	the reading thread is started by the first					*/
+/*	update_clim_window, once all sequences are known			*/
+/*--------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include "rhessys.h"
+
+struct clim_window_object *construct_clim_window(long window_days,
+												 long duration)
+{
+	/*--------------------------------------------------------------*/
+	/*	local function declarations.								*/
+	/*--------------------------------------------------------------*/
+	void	*alloc(size_t, char *, char *);
+	/*--------------------------------------------------------------*/
+	/*	local variable declarations 								*/
+	/*--------------------------------------------------------------*/
+	struct	clim_window_object	*clim_window;
+
+	clim_window = (struct clim_window_object *) alloc(
+		sizeof(struct clim_window_object),
+		"clim_window", "construct_clim_window");
+	clim_window[0].window_days = window_days;
+	clim_window[0].duration = duration;
+	clim_window[0].window_start = 0;
+	clim_window[0].fill_start = 0;
+	clim_window[0].num_streams = 0;
+	clim_window[0].thread_started = 0;
+	clim_window[0].fill_requested = 0;
+	clim_window[0].fill_done = 0;
+	clim_window[0].quit = 0;
+	clim_window[0].wait_seconds = 0.0;
+	clim_window[0].streams = NULL;
+	pthread_mutex_init(&(clim_window[0].mutex), NULL);
+	pthread_cond_init(&(clim_window[0].cond), NULL);
+	return(clim_window);
+} /*end construct_clim_window*/
@@ -38,6 +38,8 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
+#include <unistd.h>
 #include "rhessys.h"
 struct	command_line_object	*construct_command_line(
 													int main_argc,
@@ -81,9 +83,28 @@ struct	command_line_object	*construct_command_line(
 	command_line[0].clim_repeat_flag = 0;
 	command_line[0].dclim_flag = 0;
 	command_line[0].ddn_routing_flag = 0;
+	command_line[0].parallel_routing_flag = 0;
+	command_line[0].hillslope_schedule = HILLSLOPE_SCHEDULE_STATIC;
+	command_line[0].hillslope_schedule_report_flag = 0;
+	command_line[0].basin_parallel_flag = 0;
+	command_line[0].random_seed = (long)time(0);
+	command_line[0].clim_window_days = 0;
+	command_line[0].clim_cache_flag = 0;
+	command_line[0].column_levels[0] = '\0';
+	command_line[0].output_spec_flag = 0;
+	command_line[0].output_buffer_depth = 0;
+	command_line[0].restart_flag = 0;
+	command_line[0].ensemble_flag = 0;
+	command_line[0].ensemble_member = 0;
+	command_line[0].ensemble_jobs = (int) sysconf(_SC_NPROCESSORS_ONLN);
+	command_line[0].objective_flag = 0;
+	command_line[0].objective_start.year = 0;
+	command_line[0].objective_end.year = 0;
 	command_line[0].tec_flag = 0;
 	command_line[0].world_flag = 0;
 	command_line[0].world_header_flag = 0;
+	command_line[0].world_convert_flag = 0;
+	command_line[0].column_dump_flag = 0;
 	command_line[0].start_flag = 0;
 	command_line[0].end_flag = 0;
 	command_line[0].sen_flag = 0;
@@ -94,7 +115,11 @@ struct	command_line_object	*construct_command_line(
 	command_line[0].noredist_flag = 0;
 	command_line[0].surface_energy_flag = 0;
 	command_line[0].firespread_flag = 0;
-	command_line[0].vegspinup_flag = 0;		
+	command_line[0].vegspinup_flag = 0;
+	command_line[0].vegspinup_freeze_flag = 0;		
+	command_line[0].soilspinup_flag = 0;
+	command_line[0].soilspinup_years = 1;
+	command_line[0].soilspinup_tolerance = 0.01;
 	command_line[0].vgsen_flag = 0;
 	command_line[0].FillSpill_flag=0;	
 	command_line[0].evap_use_longwave_flag = 0;
@@ -302,6 +327,37 @@ struct	command_line_object	*construct_command_line(
 				i++;
       }
 
+			/*------------------------------------------*/
+			/*	hold patches once at their spinup targets	*/
+			/*------------------------------------------*/
+			else if ( strcmp(main_argv[i],"-vegspinupfreeze") == 0 ){
+				command_line[0].vegspinup_freeze_flag = 1;
+				i++;
+			}
+
+			/*------------------------------------------*/
+			/*	soil carbon spinup: climate cycle in years	*/
+			/*	and drift tolerance				*/
+			/*------------------------------------------*/
+			else if ( strcmp(main_argv[i],"-soilspinup") == 0 ){
+				i++;
+				command_line[0].soilspinup_flag = 1;
+				if ((i == main_argc) || (valid_option(main_argv[i])==1)){
+					fprintf(stderr,"FATAL ERROR: Climate cycle for -soilspinup not specified\n");
+					exit(EXIT_FAILURE);
+				} /*end if*/
+				command_line[0].soilspinup_years = (int)atoi(main_argv[i]);
+				if (command_line[0].soilspinup_years < 1){
+					fprintf(stderr,"FATAL ERROR: Climate cycle for -soilspinup must be at least 1 year\n");
+					exit(EXIT_FAILURE);
+				} /*end if*/
+				i++;
+				if ((i != main_argc) && (valid_option(main_argv[i])==0)){
+					command_line[0].soilspinup_tolerance = (double)atof(main_argv[i]);
+					i++;
+				} /*end if*/
+			}
+
 			/*-------------------------------------------------*/
 			/*	routing gw to riparian option */
 			/*-------------------------------------------------*/
@@ -1093,6 +1149,236 @@ struct	command_line_object	*construct_command_line(
 				i++;
 			}
 			/*--------------------------------------------------------------*/
+			/*	parallel (two pass) lateral routing option		*/
+			/*--------------------------------------------------------------*/
+			else if ( strcmp(main_argv[i],"-parallelrouting") == 0 ){
+				printf("\n Running with parallel lateral routing");
+				command_line[0].parallel_routing_flag = 1;
+				i++;
+			}
+			/*--------------------------------------------------------------*/
+			/*	hillslope scheduling option: static (default), cost	*/
+			/*	(partition on measured cost) or steal (partition and	*/
+			/*	let idle threads take work from busy ones)		*/
+			/*--------------------------------------------------------------*/
+			else if ( strcmp(main_argv[i],"-hillsched") == 0 ){
+				i++;
+				if ((i == main_argc) || (valid_option(main_argv[i])==1)){
+					fprintf(stderr,"FATAL ERROR: Hillslope schedule not specified\n");
+					exit(EXIT_FAILURE);
+				} /*end if*/
+				if ( strcmp(main_argv[i],"static") == 0 )
+					command_line[0].hillslope_schedule = HILLSLOPE_SCHEDULE_STATIC;
+				else if ( strcmp(main_argv[i],"cost") == 0 )
+					command_line[0].hillslope_schedule = HILLSLOPE_SCHEDULE_COST;
+				else if ( strcmp(main_argv[i],"steal") == 0 )
+					command_line[0].hillslope_schedule = HILLSLOPE_SCHEDULE_STEAL;
+				else {
+					fprintf(stderr,
+						"FATAL ERROR: unknown hillslope schedule %s (static, cost or steal)\n",
+						main_argv[i]);
+					exit(EXIT_FAILURE);
+				} /*end if*/
+				printf("\n Running with %s hillslope schedule", main_argv[i]);
+				i++;
+			}
+			else if ( strcmp(main_argv[i],"-hillschedreport") == 0 ){
+				command_line[0].hillslope_schedule_report_flag = 1;
+				i++;
+			}
+			/*--------------------------------------------------------------*/
+			/*	basin parallel option: basins of the world are run	*/
+			/*	concurrently, largest first				*/
+			/*--------------------------------------------------------------*/
+			else if ( strcmp(main_argv[i],"-basinparallel") == 0 ){
+				printf("\n Running basins in parallel");
+				command_line[0].basin_parallel_flag = 1;
+				i++;
+			}
+			/*--------------------------------------------------------------*/
+			/*	seed of the random streams (default is the clock)	*/
+			/*--------------------------------------------------------------*/
+			else if ( strcmp(main_argv[i],"-seed") == 0 ){
+				i++;
+				if ((i == main_argc) || (valid_option(main_argv[i])==1)){
+					fprintf(stderr,"FATAL ERROR: Random seed not specified\n");
+					exit(EXIT_FAILURE);
+				} /*end if*/
+				command_line[0].random_seed = atol(main_argv[i]);
+				printf("\n Random seed %ld", command_line[0].random_seed);
+				i++;
+			}
+			/*--------------------------------------------------------------*/
+			/*	convert the worldfile (text <-> binary) and exit	*/
+			/*--------------------------------------------------------------*/
+			else if ( strcmp(main_argv[i],"-wconvert") == 0 ){
+				i++;
+				if ((i == main_argc) || (valid_option(main_argv[i])==1)){
+					fprintf(stderr,"FATAL ERROR: Converted world file name not specified\n");
+					exit(EXIT_FAILURE);
+				} /*end if*/
+				strncpy(command_line[0].world_convert_filename, main_argv[i],
+					FILEPATH_LEN-1);
+				command_line[0].world_convert_flag = 1;
+				i++;
+			}
+			/*--------------------------------------------------------------*/
+			/*	stream the daily climate sequences in windows of n days	*/
+			/*--------------------------------------------------------------*/
+			else if ( strcmp(main_argv[i],"-climwindow") == 0 ){
+				i++;
+				if ((i == main_argc) || (valid_option(main_argv[i])==1)){
+					fprintf(stderr,"FATAL ERROR: Climate window (days) not specified\n");
+					exit(EXIT_FAILURE);
+				} /*end if*/
+				command_line[0].clim_window_days = atol(main_argv[i]);
+				if (command_line[0].clim_window_days < 1) {
+					fprintf(stderr,"FATAL ERROR: Climate window must be at least one day\n");
+					exit(EXIT_FAILURE);
+				}
+				printf("\n Streaming daily climate in windows of %ld days",
+					command_line[0].clim_window_days);
+				i++;
+			}
+			/*--------------------------------------------------------------*/
+			/*	keep parsed climate sequences in <file>.cache		*/
+			/*--------------------------------------------------------------*/
+			else if ( strcmp(main_argv[i],"-climcache") == 0 ){
+				command_line[0].clim_cache_flag = 1;
+				i++;
+			}
+			/*--------------------------------------------------------------*/
+			/*	daily output of the given levels (bhzpcs) as columns	*/
+			/*--------------------------------------------------------------*/
+			else if ( strcmp(main_argv[i],"-colout") == 0 ){
+				i++;
+				if ((i == main_argc) || (valid_option(main_argv[i])==1)){
+					fprintf(stderr,"FATAL ERROR: Column output levels not specified\n");
+					exit(EXIT_FAILURE);
+				} /*end if*/
+				if ((strlen(main_argv[i]) >= sizeof(command_line[0].column_levels))
+					|| (strspn(main_argv[i], "bhzpcs") != strlen(main_argv[i]))) {
+					fprintf(stderr,"FATAL ERROR: Column output levels %s must be some of bhzpcs\n",
+						main_argv[i]);
+					exit(EXIT_FAILURE);
+				}
+				strcpy(command_line[0].column_levels, main_argv[i]);
+				i++;
+			}
+			/*--------------------------------------------------------------*/
+			/*	daily output of the variables listed in a spec file	*/
+			/*--------------------------------------------------------------*/
+			else if ( strcmp(main_argv[i],"-outspec") == 0 ){
+				i++;
+				if ((i == main_argc) || (valid_option(main_argv[i])==1)){
+					fprintf(stderr,"FATAL ERROR: Output specification file name not specified\n");
+					exit(EXIT_FAILURE);
+				} /*end if*/
+				strncpy(command_line[0].output_spec_filename, main_argv[i],
+					FILEPATH_LEN-1);
+				command_line[0].output_spec_flag = 1;
+				i++;
+			}
+			/*--------------------------------------------------------------*/
+			/*	write output on its own thread through n snapshots	*/
+			/*--------------------------------------------------------------*/
+			else if ( strcmp(main_argv[i],"-outbuffer") == 0 ){
+				i++;
+				if ((i == main_argc) || (valid_option(main_argv[i])==1)){
+					fprintf(stderr,"FATAL ERROR: Output buffer depth not specified\n");
+					exit(EXIT_FAILURE);
+				} /*end if*/
+				command_line[0].output_buffer_depth = atol(main_argv[i]);
+				if (command_line[0].output_buffer_depth < 1) {
+					fprintf(stderr,"FATAL ERROR: Output buffer must hold at least one record\n");
+					exit(EXIT_FAILURE);
+				}
+				i++;
+			}
+			/*--------------------------------------------------------------*/
+			/*	resume from a binary checkpoint				*/
+			/*--------------------------------------------------------------*/
+			else if ( strcmp(main_argv[i],"-restart") == 0 ){
+				i++;
+				if ((i == main_argc) || (valid_option(main_argv[i])==1)){
+					fprintf(stderr,"FATAL ERROR: Checkpoint file name not specified\n");
+					exit(EXIT_FAILURE);
+				} /*end if*/
+				strncpy(command_line[0].restart_filename, main_argv[i],
+					FILEPATH_LEN-1);
+				command_line[0].restart_flag = 1;
+				i++;
+			}
+			/*--------------------------------------------------------------*/
+			/*	parameter ensemble: table of members and how many	*/
+			/*	to run at once						*/
+			/*--------------------------------------------------------------*/
+			else if ( strcmp(main_argv[i],"-ensemble") == 0 ){
+				i++;
+				if ((i == main_argc) || (valid_option(main_argv[i])==1)){
+					fprintf(stderr,"FATAL ERROR: Ensemble file name not specified\n");
+					exit(EXIT_FAILURE);
+				} /*end if*/
+				strncpy(command_line[0].ensemble_filename, main_argv[i],
+					FILEPATH_LEN-1);
+				command_line[0].ensemble_flag = 1;
+				i++;
+				if ((i != main_argc) && (valid_option(main_argv[i])==0)){
+					command_line[0].ensemble_jobs = (int)atoi(main_argv[i]);
+					i++;
+				} /*end if*/
+				if (command_line[0].ensemble_jobs < 1)
+					command_line[0].ensemble_jobs = 1;
+			}
+			/*--------------------------------------------------------------*/
+			/*	streamflow objective functions: observed flow and	*/
+			/*	optionally the evaluation window (start, end y m d)	*/
+			/*--------------------------------------------------------------*/
+			else if ( strcmp(main_argv[i],"-objective") == 0 ){
+				i++;
+				if ((i == main_argc) || (valid_option(main_argv[i])==1)){
+					fprintf(stderr,"FATAL ERROR: Observed streamflow file name not specified\n");
+					exit(EXIT_FAILURE);
+				} /*end if*/
+				strncpy(command_line[0].objective_filename, main_argv[i],
+					FILEPATH_LEN-1);
+				command_line[0].objective_flag = 1;
+				i++;
+				if ((i != main_argc) && (valid_option(main_argv[i])==0)){
+					long	window[6];
+					int	k;
+					for (k=0; k<6; k++, i++) {
+						if ((i == main_argc) || (valid_option(main_argv[i])==1)){
+							fprintf(stderr,"FATAL ERROR: -objective window needs start and end year month day\n");
+							exit(EXIT_FAILURE);
+						} /*end if*/
+						window[k] = (long)atoi(main_argv[i]);
+					}
+					command_line[0].objective_start.year = window[0];
+					command_line[0].objective_start.month = window[1];
+					command_line[0].objective_start.day = window[2];
+					command_line[0].objective_start.hour = 1;
+					command_line[0].objective_end.year = window[3];
+					command_line[0].objective_end.month = window[4];
+					command_line[0].objective_end.day = window[5];
+					command_line[0].objective_end.hour = 1;
+				} /*end if*/
+			}
+			/*--------------------------------------------------------------*/
+			/*	print a column output file as text and exit		*/
+			/*--------------------------------------------------------------*/
+			else if ( strcmp(main_argv[i],"-coldump") == 0 ){
+				i++;
+				if ((i == main_argc) || (valid_option(main_argv[i])==1)){
+					fprintf(stderr,"FATAL ERROR: Column output file name not specified\n");
+					exit(EXIT_FAILURE);
+				} /*end if*/
+				strncpy(command_line[0].column_dump_filename, main_argv[i],
+					FILEPATH_LEN-1);
+				command_line[0].column_dump_flag = 1;
+				i++;
+			}
+			/*--------------------------------------------------------------*/
 			/*	NOTE:  ADD MORE OPTION PARSING HERE.						*/
 			/*--------------------------------------------------------------*/
 			/*--------------------------------------------------------------*/
@@ -1107,5 +1393,14 @@ struct	command_line_object	*construct_command_line(
 		} /*end if*/
 	} /*end while*/
 
+	/*--------------------------------------------------------------*/
+	/*	patches are held at the targets of -vegspinup			*/
+	/*--------------------------------------------------------------*/
+	if ((command_line[0].vegspinup_freeze_flag == 1)
+		&& (command_line[0].vegspinup_flag == 0)) {
+		fprintf(stderr,"FATAL ERROR: -vegspinupfreeze needs -vegspinup\n");
+		exit(EXIT_FAILURE);
+	}
+
 	return(command_line);
 } /*end construct_command_line*/
@@ -33,6 +33,8 @@
 /*  The clim_sequence is constructed by calling construct_      */
 /*  clim_sequence.  Refer to that code for documentation of     */
 /*  what a valid clim sequence is.                              */
+/*  With -climwindow (clim_window not NULL) the sequences are   */
+/*  streamed instead, see construct_clim_stream.                */
 /*                                                              */
 /*  Feb 28/95 - Richard Fernandes				*/
 /*	Took out warnings that optional clim squences were not	*/
@@ -49,12 +51,16 @@ struct	daily_clim_object *construct_daily_clim(
 												char	*file_prefix,
 												struct	date	start_date,
 												long	duration,
-												int	clim_repeat_flag)
+												int	clim_repeat_flag,
+												int	clim_cache_flag,
+												struct	clim_window_object *clim_window)
 {
 	/*--------------------------------------------------------------*/
 	/*	local function declarations.								*/
 	/*--------------------------------------------------------------*/
-	double	*construct_clim_sequence( char *, struct date, long, int);
+	double	*construct_clim_stream( char *, struct date, long, int, int,
+		struct clim_window_object *, double **,
+		struct daily_clim_object *);
 	void	*alloc(	size_t, char *, char *);
 	/*--------------------------------------------------------------*/
 	/*	local variable declarations 								*/
@@ -74,26 +80,30 @@ struct	daily_clim_object *construct_daily_clim(
 	daily_clim = (struct daily_clim_object *)
 		alloc(1*sizeof(struct daily_clim_object),"daily_clim",
 		"construct_daily_clim" );
+	daily_clim[0].window_start = 0;
 	
 	/*--------------------------------------------------------------*/
 	/*	Attempt to open the daily clim sequence file for each		*/
 	/*	critical clim parameter and read them in.					*/
 	/*--------------------------------------------------------------*/
 	strcpy(file_name, file_prefix);
-	daily_clim[0].tmin = construct_clim_sequence(
+	daily_clim[0].tmin = construct_clim_stream(
 		(char *)strcat(file_name,".tmin"),
 		start_date,
-		duration, clim_repeat_flag);
+		duration, clim_repeat_flag, clim_cache_flag,
+		clim_window, &(daily_clim[0].tmin), daily_clim);
 	strcpy(file_name, file_prefix);
-	daily_clim[0].tmax = construct_clim_sequence(
+	daily_clim[0].tmax = construct_clim_stream(
 		(char *)strcat(file_name,".tmax"),
 		start_date,
-		duration, clim_repeat_flag);
+		duration, clim_repeat_flag, clim_cache_flag,
+		clim_window, &(daily_clim[0].tmax), daily_clim);
 	strcpy(file_name, file_prefix);
-	daily_clim[0].rain = construct_clim_sequence(
+	daily_clim[0].rain = construct_clim_stream(
 		(char *)strcat(file_name,".rain"),
 		start_date,
-		duration, clim_repeat_flag);
+		duration, clim_repeat_flag, clim_cache_flag,
+		clim_window, &(daily_clim[0].rain), daily_clim);
 	/*--------------------------------------------------------------*/
 	/*	initialize the rest of the clim sequences as null	*/
 	/*--------------------------------------------------------------*/
@@ -155,180 +165,205 @@ struct	daily_clim_object *construct_daily_clim(
 		if ( strcmp(sequence_name,"dayl") == 0 ){
 			strcpy(file_name, file_prefix);
 			printf("\n Reading day length sequence ");
-			daily_clim[0].dayl = construct_clim_sequence(
+			daily_clim[0].dayl = construct_clim_stream(
 				(char *)strcat(file_name,".dayl"),
 				start_date,
-				duration, clim_repeat_flag);
+				duration, clim_repeat_flag, clim_cache_flag,
+				clim_window, &(daily_clim[0].dayl), daily_clim);
 		}
 		else if ( strcmp(sequence_name,"daytime_rain_duration") == 0 ){
 			strcpy(file_name, file_prefix);
 			printf("\n Reading rain duration sequence");
-			daily_clim[0].daytime_rain_duration = construct_clim_sequence(
+			daily_clim[0].daytime_rain_duration = construct_clim_stream(
 				(char *)strcat(file_name,".daytime_rain_duration"),
 				start_date,
-				duration, clim_repeat_flag);
+				duration, clim_repeat_flag, clim_cache_flag,
+				clim_window, &(daily_clim[0].daytime_rain_duration), daily_clim);
 		}
 		else if ( strcmp(sequence_name,"LAI_scalar") == 0 ){
 			strcpy(file_name, file_prefix);
-			daily_clim[0].LAI_scalar = construct_clim_sequence(
+			daily_clim[0].LAI_scalar = construct_clim_stream(
 				(char *)strcat(file_name,".LAI_scalar"),
 				start_date,
-				duration, clim_repeat_flag);
+				duration, clim_repeat_flag, clim_cache_flag,
+				clim_window, &(daily_clim[0].LAI_scalar), daily_clim);
 		}
 		else if ( strcmp(sequence_name,"Ldown") == 0 ) {
 			strcpy(file_name, file_prefix);
-			daily_clim[0].Ldown = construct_clim_sequence(
+			daily_clim[0].Ldown = construct_clim_stream(
 				(char *)strcat(file_name,".Ldown"),
 				start_date,
-				duration, clim_repeat_flag);
+				duration, clim_repeat_flag, clim_cache_flag,
+				clim_window, &(daily_clim[0].Ldown), daily_clim);
 		}
 		else if ( strcmp(sequence_name,"Kdown_diffuse") == 0 ) {
 			strcpy(file_name, file_prefix);
-			daily_clim[0].Kdown_diffuse = construct_clim_sequence(
+			daily_clim[0].Kdown_diffuse = construct_clim_stream(
 				(char *)strcat(file_name,".Kdown_diffuse"),
 				start_date,
-				duration, clim_repeat_flag);
+				duration, clim_repeat_flag, clim_cache_flag,
+				clim_window, &(daily_clim[0].Kdown_diffuse), daily_clim);
 		}
 		else if ( strcmp(sequence_name,"Kdown_direct") == 0 ) {
 			strcpy(file_name, file_prefix);
-			daily_clim[0].Kdown_direct = construct_clim_sequence(
+			daily_clim[0].Kdown_direct = construct_clim_stream(
 				(char *)strcat(file_name,".Kdown_direct"),
 				start_date,
-				duration, clim_repeat_flag);
+				duration, clim_repeat_flag, clim_cache_flag,
+				clim_window, &(daily_clim[0].Kdown_direct), daily_clim);
 		}
 		else if ( strcmp(sequence_name,"PAR_diffuse") == 0 ) {
 			strcpy(file_name, file_prefix);
-			daily_clim[0].PAR_diffuse = construct_clim_sequence(
+			daily_clim[0].PAR_diffuse = construct_clim_stream(
 				(char *)strcat(file_name,".PAR_diffuse"),
 				start_date,
-				duration, clim_repeat_flag);
+				duration, clim_repeat_flag, clim_cache_flag,
+				clim_window, &(daily_clim[0].PAR_diffuse), daily_clim);
 		}
 		else if ( strcmp(sequence_name,"PAR_direct") == 0 ) {
 			strcpy(file_name, file_prefix);
-			daily_clim[0].PAR_direct = construct_clim_sequence(
+			daily_clim[0].PAR_direct = construct_clim_stream(
 				(char *)strcat(file_name,".PAR_direct"),
 				start_date,
-				duration, clim_repeat_flag);
+				duration, clim_repeat_flag, clim_cache_flag,
+				clim_window, &(daily_clim[0].PAR_direct), daily_clim);
 		}
 		else if ( strcmp(sequence_name,"relative_humidity") == 0 ) {
 			strcpy(file_name, file_prefix);
-			daily_clim[0].relative_humidity = construct_clim_sequence(
+			daily_clim[0].relative_humidity = construct_clim_stream(
 				(char *)strcat(file_name,".relative_humidity"),
 				start_date,
-				duration, clim_repeat_flag);
+				duration, clim_repeat_flag, clim_cache_flag,
+				clim_window, &(daily_clim[0].relative_humidity), daily_clim);
 		}
 		else if ( strcmp(sequence_name,"tday") == 0 ){
 			strcpy(file_name, file_prefix);
-			daily_clim[0].tday = construct_clim_sequence(
+			daily_clim[0].tday = construct_clim_stream(
 				(char *)strcat(file_name,".tday"),
 				start_date,
-				duration, clim_repeat_flag);
+				duration, clim_repeat_flag, clim_cache_flag,
+				clim_window, &(daily_clim[0].tday), daily_clim);
 		}
 		else if ( strcmp(sequence_name,"tnightmax") == 0 ){
 			strcpy(file_name, file_prefix);
-			daily_clim[0].tnightmax = construct_clim_sequence(
+			daily_clim[0].tnightmax = construct_clim_stream(
 				(char *)strcat(file_name,".tnightmax"),
 				start_date,
-				duration, clim_repeat_flag);
+				duration, clim_repeat_flag, clim_cache_flag,
+				clim_window, &(daily_clim[0].tnightmax), daily_clim);
 		}
 		else if ( strcmp(sequence_name,"tsoil") == 0 ){
 			strcpy(file_name, file_prefix);
-			daily_clim[0].tsoil = construct_clim_sequence(
+			daily_clim[0].tsoil = construct_clim_stream(
 				(char *)strcat(file_name,".tsoil"),
 				start_date,
-				duration, clim_repeat_flag);
+				duration, clim_repeat_flag, clim_cache_flag,
+				clim_window, &(daily_clim[0].tsoil), daily_clim);
 		}
 		else if ( strcmp(sequence_name,"CO2") == 0 ){
 			strcpy(file_name, file_prefix);
-			daily_clim[0].CO2 = construct_clim_sequence(
+			daily_clim[0].CO2 = construct_clim_stream(
 				(char *)strcat(file_name,".CO2"),
 				start_date,
-				duration, clim_repeat_flag);
+				duration, clim_repeat_flag, clim_cache_flag,
+				clim_window, &(daily_clim[0].CO2), daily_clim);
 		}
 		else if ( strcmp(sequence_name,"vpd") == 0 ){
 			strcpy(file_name, file_prefix);
-			daily_clim[0].vpd = construct_clim_sequence(
+			daily_clim[0].vpd = construct_clim_stream(
 				(char *)strcat(file_name,".vpd"),
 				start_date,
-				duration, clim_repeat_flag);
+				duration, clim_repeat_flag, clim_cache_flag,
+				clim_window, &(daily_clim[0].vpd), daily_clim);
 		}
 		else if ( strcmp(sequence_name,"tavg") == 0 ){
 			strcpy(file_name, file_prefix);
-			daily_clim[0].tavg = construct_clim_sequence(
+			daily_clim[0].tavg = construct_clim_stream(
 				(char *)strcat(file_name,".tavg"),
 				start_date,
-				duration, clim_repeat_flag);
+				duration, clim_repeat_flag, clim_cache_flag,
+				clim_window, &(daily_clim[0].tavg), daily_clim);
 		}
 		else if ( strcmp(sequence_name,"snow") == 0 ) {
 			strcpy(file_name, file_prefix);
-			daily_clim[0].snow = construct_clim_sequence(
+			daily_clim[0].snow = construct_clim_stream(
 				(char *)strcat(file_name,".snow"),
 				start_date,
-				duration, clim_repeat_flag);
+				duration, clim_repeat_flag, clim_cache_flag,
+				clim_window, &(daily_clim[0].snow), daily_clim);
 		}
 
 		else if ( strcmp(sequence_name,"wind") == 0 ){
 			strcpy(file_name, file_prefix);
-			daily_clim[0].wind = construct_clim_sequence(
+			daily_clim[0].wind = construct_clim_stream(
 				(char *)strcat(file_name,".wind"),
 				start_date,
-				duration, clim_repeat_flag);
+				duration, clim_repeat_flag, clim_cache_flag,
+				clim_window, &(daily_clim[0].wind), daily_clim);
 		}
 		else if ( strcmp(sequence_name,"wind_direction") == 0 ){
 			strcpy(file_name, file_prefix);
-			daily_clim[0].wind_direction = construct_clim_sequence(
+			daily_clim[0].wind_direction = construct_clim_stream(
 				(char *)strcat(file_name,".wind_direction"),
 				start_date,
-				duration, clim_repeat_flag);
+				duration, clim_repeat_flag, clim_cache_flag,
+				clim_window, &(daily_clim[0].wind_direction), daily_clim);
 		}
 		else if ( strcmp(sequence_name,"ndep_NH4") == 0 ){
 			strcpy(file_name, file_prefix);
-			daily_clim[0].ndep_NH4 = construct_clim_sequence(
+			daily_clim[0].ndep_NH4 = construct_clim_stream(
 				(char *)strcat(file_name,".ndep_NH4"),
 				start_date,
-				duration, clim_repeat_flag);
+				duration, clim_repeat_flag, clim_cache_flag,
+				clim_window, &(daily_clim[0].ndep_NH4), daily_clim);
 		}
 		else if ( strcmp(sequence_name,"ndep_NO3") == 0 ){
 			strcpy(file_name, file_prefix);
-			daily_clim[0].ndep_NO3 = construct_clim_sequence(
+			daily_clim[0].ndep_NO3 = construct_clim_stream(
 				(char *)strcat(file_name,".ndep_NO3"),
 				start_date,
-				duration, clim_repeat_flag);
+				duration, clim_repeat_flag, clim_cache_flag,
+				clim_window, &(daily_clim[0].ndep_NO3), daily_clim);
 		}
 		else if ( strcmp(sequence_name,"lapse_rate_tmax") == 0 ){
 			strcpy(file_name, file_prefix);
-			daily_clim[0].lapse_rate_tmax = construct_clim_sequence(
+			daily_clim[0].lapse_rate_tmax = construct_clim_stream(
 				(char *)strcat(file_name,".lapse_rate_tmax"),
 				start_date,
-				duration, clim_repeat_flag);
+				duration, clim_repeat_flag, clim_cache_flag,
+				clim_window, &(daily_clim[0].lapse_rate_tmax), daily_clim);
 		}
 		else if ( strcmp(sequence_name,"lapse_rate_tmin") == 0 ){
 			strcpy(file_name, file_prefix);
-			daily_clim[0].lapse_rate_tmin = construct_clim_sequence(
+			daily_clim[0].lapse_rate_tmin = construct_clim_stream(
 				(char *)strcat(file_name,".lapse_rate_tmin"),
 				start_date,
-				duration, clim_repeat_flag);
+				duration, clim_repeat_flag, clim_cache_flag,
+				clim_window, &(daily_clim[0].lapse_rate_tmin), daily_clim);
 		}
 		else if ( strcmp(sequence_name,"lapse_rate_precip") == 0 ){
 			strcpy(file_name, file_prefix);
-			daily_clim[0].lapse_rate_precip = construct_clim_sequence(
+			daily_clim[0].lapse_rate_precip = construct_clim_stream(
 				(char *)strcat(file_name,".lapse_rate_precip"),
 				start_date,
-				duration, clim_repeat_flag);
+				duration, clim_repeat_flag, clim_cache_flag,
+				clim_window, &(daily_clim[0].lapse_rate_precip), daily_clim);
 		}
 		else if ( strcmp(sequence_name,"tdewpoint") == 0 ){
 			strcpy(file_name, file_prefix);
-			daily_clim[0].tdewpoint = construct_clim_sequence(
+			daily_clim[0].tdewpoint = construct_clim_stream(
 				(char *)strcat(file_name,".tdewpoint"),
 				start_date,
-				duration, clim_repeat_flag);
+				duration, clim_repeat_flag, clim_cache_flag,
+				clim_window, &(daily_clim[0].tdewpoint), daily_clim);
 		}
 		else if ( strcmp(sequence_name,"atm_trans") == 0 ){
 			strcpy(file_name, file_prefix);
-			daily_clim[0].atm_trans = construct_clim_sequence(
+			daily_clim[0].atm_trans = construct_clim_stream(
 				(char *)strcat(file_name,".atm_trans"),
 				start_date,
-				duration, clim_repeat_flag);
+				duration, clim_repeat_flag, clim_cache_flag,
+				clim_window, &(daily_clim[0].atm_trans), daily_clim);
 		}
 		
 		
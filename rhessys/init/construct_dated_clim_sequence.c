@@ -21,6 +21,9 @@
 /*	Reads clim data into the allocated array as long as the		*/
 /*		EOF is not present.										*/
 /*	Returns the clim sequence array.							*/
+/*	With -climcache the sequence is kept in <file>.cache and	*/
+/*	read back from there while file and start date are			*/
+/*	unchanged.													*/
 /*																*/
 /*																*/
 /*	PROGRAMMER NOTES											*/
@@ -54,13 +57,16 @@
 #include "rhessys.h"
 
 struct clim_event_sequence construct_dated_clim_sequence(
-														 char *file, struct date start_date)
+														 char *file, struct date start_date,
+														 int clim_cache_flag)
 {
 	/*--------------------------------------------------------------*/
 	/*	local function declarations.								*/
 	/*--------------------------------------------------------------*/
 	void	*alloc(	size_t, char *, char *);
 	long julday(struct date );
+	void	*read_clim_cache(char *, struct clim_cache_header_object *);
+	void	write_clim_cache(char *, struct clim_cache_header_object *, void *);
 	/*--------------------------------------------------------------*/
 	/*	local variable declarations 								*/
 	/*--------------------------------------------------------------*/
@@ -77,7 +83,24 @@ struct clim_event_sequence construct_dated_clim_sequence(
 	FILE	*sequence_file;
 	struct	date	cur_date;
 	struct	date	tmp_date;
+	struct	clim_cache_header_object	cache_key;
 	
+	/*--------------------------------------------------------------*/
+	/*	Use the parsed sequence of an earlier run if there is one.	*/
+	/*--------------------------------------------------------------*/
+	if (clim_cache_flag == 1) {
+		cache_key.kind = CLIM_CACHE_DATED;
+		cache_key.record_size = sizeof(struct dated_sequence);
+		cache_key.clim_repeat_flag = 0;
+		cache_key.start_date_julian = julday(start_date);
+		cache_key.duration = 0;
+		events.seq = (struct dated_sequence *) read_clim_cache(file, &cache_key);
+		if (events.seq != NULL) {
+			events.inx = 0;
+			printf("\nRead dated climate input file  %s from its cache\n", file);
+			return(events);
+		}
+	}
 	/*--------------------------------------------------------------*/
 	/*	Initialize							*/
 	/*--------------------------------------------------------------*/
@@ -269,6 +292,10 @@ struct clim_event_sequence construct_dated_clim_sequence(
 		}
 	}
 	events.seq[inx].edate.year = 0;
+	if (clim_cache_flag == 1) {
+		cache_key.num_records = inx + 1;
+		write_clim_cache(file, &cache_key, events.seq);
+	}
 
 
 
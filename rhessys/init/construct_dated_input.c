@@ -45,13 +45,14 @@
 struct	dated_input_object *construct_dated_input(
 						  FILE	*base_station_file,
 						  char	*file_prefix,
-						  struct	date	start_date)
+						  struct	date	start_date,
+						  int	clim_cache_flag)
 {
 	/*--------------------------------------------------------------*/
 	/*	local function declarations.								*/
 	/*--------------------------------------------------------------*/
 	struct clim_event_sequence construct_dated_clim_sequence(char *,
-		struct date);
+		struct date, int);
 	void	*alloc(size_t, char *, char *);
 	/*--------------------------------------------------------------*/
 	/*	local variable declarations 								*/
@@ -111,43 +112,43 @@ struct	dated_input_object *construct_dated_input(
 			strcpy(file_name, file_prefix);
 			dated_input[0].fertilizer_NO3 = construct_dated_clim_sequence(
 				(char *)strcat(file_name,".fertilizer_NO3"),
-				start_date);
+				start_date, clim_cache_flag);
 		}
 		else if ( strcmp(sequence_name,"fertilizer_NH4" ) == 0){
 			strcpy(file_name, file_prefix);
 			dated_input[0].fertilizer_NH4 = construct_dated_clim_sequence(
 				(char *)strcat(file_name,".fertilizer_NH4"),
-				start_date);
+				start_date, clim_cache_flag);
 		}
 		else if ( strcmp(sequence_name,"irrigation" ) == 0){
 			strcpy(file_name, file_prefix);
 			dated_input[0].irrigation = construct_dated_clim_sequence(
 				(char *)strcat(file_name,".irrigation"),
-				start_date);
+				start_date, clim_cache_flag);
 		}
 		else if ( strcmp(sequence_name,"snow_melt_input" ) == 0){
 			strcpy(file_name, file_prefix);
 			dated_input[0].snow_melt_input = construct_dated_clim_sequence(
 				(char *)strcat(file_name,".snow_melt_input"),
-				start_date);
+				start_date, clim_cache_flag);
 		}
 		else if ( strcmp(sequence_name,"biomass_removal_percent" ) == 0){
 			strcpy(file_name, file_prefix);
 			dated_input[0].biomass_removal_percent = construct_dated_clim_sequence(
 				(char *)strcat(file_name,".biomass_removal_percent"),
-				start_date);
+				start_date, clim_cache_flag);
 		}
 		else if ( strcmp(sequence_name,"PH" ) == 0) {
 			strcpy(file_name, file_prefix);
 			dated_input[0].PH = construct_dated_clim_sequence(
 				(char *)strcat(file_name,".PH"),
-				start_date);
+				start_date, clim_cache_flag);
 		}
 		else if ( strcmp(sequence_name,"grazing_Closs" ) == 0) {
 			strcpy(file_name, file_prefix);
 			dated_input[0].grazing_Closs = construct_dated_clim_sequence(
 				(char *)strcat(file_name,".grazing_Closs"),
-				start_date);
+				start_date, clim_cache_flag);
 		}
 		else  fprintf(stderr,"WARNING-clim sequence %s not found.\n",
 			sequence_name);
@@ -73,6 +73,7 @@ struct	daily_clim_object *construct_daily_clim(
 	daily_clim = (struct daily_clim_object *)
 		alloc(1*sizeof(struct daily_clim_object),"daily_clim",
 		"construct_daily_clim" );
+	daily_clim[0].window_start = 0;
 	
 	/*--------------------------------------------------------------*/
 	/*	Attempt to open the daily clim sequence file for each		*/
@@ -72,7 +72,7 @@ struct fire_default *construct_fire_defaults(
 		printf("\n Reading %s\n", default_files[i]);
                 paramCnt = 0;
                 if (paramPtr != NULL)
-                    free(paramPtr);
+                    freeParams(paramPtr);
 
                 paramPtr = readParamFile(&paramCnt, default_files[i]);
 
@@ -10,7 +10,7 @@
 /*	SYNOPSIS													*/
 /* 	void construct_hillslope(									*/
 /*			struct	command_line_object	*command_line,			*/
-/*			FILE	*world_file,								*/
+/*			struct world_input_object *world_file,	*/
 /*			int		num_world_base_stations,					*/
 /*			struct	base_station_object	**world_base_stations,	*/
 /*			struct	hillslope_object	**hillslope_list,		*/
@@ -48,7 +48,7 @@
 
 struct hillslope_object *construct_hillslope(
 											 struct	command_line_object	*command_line,
-											 FILE	*world_file,
+											 struct world_input_object *world_file,
 											 int	*num_world_base_stations,
 											 struct	base_station_object	**world_base_stations,
 											 struct	default_object	*defaults,
@@ -65,7 +65,7 @@ struct hillslope_object *construct_hillslope(
 	
 	struct zone_object *construct_zone(
 		struct command_line_object *,
-		FILE	*,
+		struct world_input_object *,
 		int		*num_world_base_stations,
 		struct	base_station_object	**world_base_stations,
 		struct	default_object *,
@@ -75,6 +75,9 @@ struct hillslope_object *construct_hillslope(
 	void	*alloc(	size_t,
 		char	*,
 		char	*);
+	int	read_world_int(struct world_input_object *);
+	double	read_world_double(struct world_input_object *);
+	void	*arena_alloc(struct arena_object *, int, size_t, char *, char *);
 	
 	/*--------------------------------------------------------------*/
 	/*	Local variable definition.									*/
@@ -82,15 +85,20 @@ struct hillslope_object *construct_hillslope(
 	int		i,j;
 	int		base_stationID;
 	int		default_object_ID;
-	char		record[MAXSTR];
 	struct	hillslope_object *hillslope;
 	
 	/*--------------------------------------------------------------*/
 	/*	Allocate a hillslope object.								*/
 	/*--------------------------------------------------------------*/
-	hillslope = (struct hillslope_object *) alloc( 1 *
+	hillslope = (struct hillslope_object *) arena_alloc(&(world[0].arena), ARENA_HILLSLOPE, 1 *
 		sizeof( struct hillslope_object ),"hillslope",
 		"construct_hillsope" );
+	/*--------------------------------------------------------------*/
+	/*	hourly scratch, reset in place by hillslope_hourly			*/
+	/*--------------------------------------------------------------*/
+	hillslope[0].hourly = (struct hillslope_hourly_object *) arena_alloc(
+		&(world[0].arena), ARENA_LIST, sizeof( struct hillslope_hourly_object ),
+		"hourly", "construct_hillslope" );
 	
 	/*--------------------------------------------------------------*/
 	/*	Create the grow extension to the hillslope object if 		*/
@@ -107,22 +115,14 @@ struct hillslope_object *construct_hillslope(
 	/*--------------------------------------------------------------*/
 	/*	Read in the hillslope record from the world file.			*/
 	/*--------------------------------------------------------------*/
-	fscanf(world_file,"%d",&(hillslope[0].ID));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(hillslope[0].x));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(hillslope[0].y));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(hillslope[0].z));
-	read_record(world_file, record);
-	fscanf(world_file,"%d",&(default_object_ID));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(hillslope[0].gw.storage));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(hillslope[0].gw.NO3));
-	read_record(world_file, record);
-	fscanf(world_file,"%d",&(hillslope[0].num_base_stations));
-	read_record(world_file, record);
+	hillslope[0].ID = read_world_int(world_file);
+	hillslope[0].x = read_world_double(world_file);
+	hillslope[0].y = read_world_double(world_file);
+	hillslope[0].z = read_world_double(world_file);
+	default_object_ID = read_world_int(world_file);
+	hillslope[0].gw.storage = read_world_double(world_file);
+	hillslope[0].gw.NO3 = read_world_double(world_file);
+	hillslope[0].num_base_stations = read_world_int(world_file);
 
 	hillslope[0].streamflow_NO3 = 0.0;	
 	hillslope[0].streamflow_NH4 = 0.0;	
@@ -130,7 +130,7 @@ struct hillslope_object *construct_hillslope(
 	/*  Assign  defaults for this hillslope                             */
 	/*--------------------------------------------------------------*/
 	hillslope[0].defaults = (struct hillslope_default **)
-		alloc( sizeof(struct hillslope_default *),"defaults",
+		arena_alloc(&(world[0].arena), ARENA_LIST, sizeof(struct hillslope_default *),"defaults",
 		"construct_hillslopes" );
 	
 	i = 0;
@@ -152,15 +152,14 @@ struct hillslope_object *construct_hillslope(
 	/*	Allocate a list of base stations for this hillslope.		*/
 	/*--------------------------------------------------------------*/
 	hillslope[0].base_stations = (struct base_station_object **)
-		alloc(hillslope[0].num_base_stations *
+		arena_alloc(&(world[0].arena), ARENA_LIST, hillslope[0].num_base_stations *
 		sizeof(struct base_station_object *),"base_stations",
 		"construct_hillslopes" );
 	/*--------------------------------------------------------------*/
 	/*	Read each base_station ID and then point to that base_statio*/
 	/*--------------------------------------------------------------*/
 	for (i=0 ; i<hillslope[0].num_base_stations; i++){
-		fscanf(world_file,"%d",&(base_stationID));
-		read_record(world_file, record);
+		base_stationID = read_world_int(world_file);
 		/*--------------------------------------------------------------*/
 		/*		Point to the appropriate base station in the base       */
 		/*		station list for this world.							*/
@@ -175,14 +174,13 @@ struct hillslope_object *construct_hillslope(
 	/*--------------------------------------------------------------*/
 	/*	Read in number of zones in this hillslope.					*/
 	/*--------------------------------------------------------------*/
-	fscanf(world_file,"%d",&(hillslope[0].num_zones));
-	read_record(world_file, record);
+	hillslope[0].num_zones = read_world_int(world_file);
 	
 	/*--------------------------------------------------------------*/
 	/*	Allocate list of pointers to zone objects .					*/
 	/*--------------------------------------------------------------*/
 	hillslope[0].zones = ( struct zone_object ** )
-		alloc( hillslope[0].num_zones * sizeof( struct zone_object *),
+		arena_alloc(&(world[0].arena), ARENA_LIST, hillslope[0].num_zones * sizeof( struct zone_object *),
 		"zones","construct_hillslopes");
 	
 	hillslope[0].streamflow_NO3 = 0.0;
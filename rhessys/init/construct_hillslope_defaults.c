@@ -77,7 +77,7 @@ struct hillslope_default *construct_hillslope_defaults(
 		printf("Reading %s\n", default_files[i]);
                 paramCnt = 0;
                 if (paramPtr != NULL)
-                    free(paramPtr);
+                    freeParams(paramPtr);
 
                 paramPtr = readParamFile(&paramCnt, default_files[i]);
 
@@ -94,10 +94,6 @@ struct hillslope_default *construct_hillslope_defaults(
 		if (default_object_list[i].n_routing_timesteps < 1)
 			default_object_list[i].n_routing_timesteps = 1;
 		
-		if (command_line[0].gw_flag > 0) {
-			default_object_list[i].gw_loss_coeff *= command_line[0].gw_loss_coeff_mult;
-			default_object_list[i].gw_loss_fast_coeff *= command_line[0].gw_loss_coeff_mult;
-			}
 
                 memset(strbuf, '\0', strbufLen);
                 strcpy(strbuf, default_files[i]);
@@ -148,7 +144,7 @@ struct hillslope_default *construct_hillslope_defaults(
 	} /*end for*/
 
                 if (paramPtr != NULL)
-                    free(paramPtr);
+                    freeParams(paramPtr);
 		    
 	return(default_object_list);
 } /*end construct_hillslope_defaults*/
@@ -0,0 +1,98 @@
+/*--------------------------------------------------------------*/
+/* 																*/
+/*					construct_hillslope_schedule				*/
+/*																*/
+/*	construct_hillslope_schedule.c - sets up hillslope queues	*/
+/*																*/
+/*	NAME														*/
+/*	construct_hillslope_schedule.c - sets up hillslope queues	*/
+/*																*/
+/*	SYNOPSIS													*/
+/*	void construct_hillslope_schedule( 							*/
+/*				struct basin_object *basin,						*/
+/*				struct command_line_object *command_line)		*/
+/*																*/
+/*	OPTIONS														*/
+/*																*/
+/*	DESCRIPTION													*/
+/*																*/
+/*	Allocates the schedule used by the hillslope loops of		*/
+/*	basin_daily_I, basin_hourly, basin_daily_F and				*/
+/*	update_hillslope_accumulator.  Until a day has been timed	*/
+/*	the cost of a hillslope is its number of patches plus its	*/
+/*	number of canopy strata.  One queue is made per OpenMP		*/
+/*	thread (see update_hillslope_schedule).						*/
+/*																*/
+/*	PROGRAMMER NOTES											*/
+/*																*/
+/*	must be called after sort_by_elevation since the schedule	*/
+/*	refers to hillslopes by their index in the basin			*/
+/*--------------------------------------------------------------*/
+#include <stdio.h>
+#include <omp.h>
+#include "rhessys.h"
+
+void construct_hillslope_schedule(struct basin_object *basin,
+								  struct command_line_object *command_line)
+{
+	/*--------------------------------------------------------------*/
+	/*	Local function definition.									*/
+	/*--------------------------------------------------------------*/
+	void *alloc(size_t, char *, char *);
+
+	void update_hillslope_schedule(struct hillslope_schedule_object *);
+
+	/*--------------------------------------------------------------*/
+	/*	Local variable definition.									*/
+	/*--------------------------------------------------------------*/
+	int h, z, p, num_hillslopes, num_threads;
+	struct hillslope_schedule_object *schedule;
+	struct hillslope_object *hillslope;
+	struct zone_object *zone;
+
+	schedule = &(basin[0].schedule);
+	num_hillslopes = max(basin[0].num_hillslopes, 1);
+	num_threads = max(omp_get_max_threads(), 1);
+
+	schedule->mode = command_line[0].hillslope_schedule;
+	schedule->num_hillslopes = basin[0].num_hillslopes;
+	schedule->num_threads = num_threads;
+	schedule->num_days = 0;
+	schedule->order = (int *)alloc(num_hillslopes * sizeof(int),
+		"order", "construct_hillslope_schedule");
+	schedule->queue_of = (int *)alloc(num_hillslopes * sizeof(int),
+		"queue_of", "construct_hillslope_schedule");
+	schedule->units = (double *)alloc(num_hillslopes * sizeof(double),
+		"units", "construct_hillslope_schedule");
+	schedule->cost = (double *)alloc(num_hillslopes * sizeof(double),
+		"cost", "construct_hillslope_schedule");
+	schedule->wall_time = (double *)alloc(num_hillslopes * sizeof(double),
+		"wall_time", "construct_hillslope_schedule");
+	schedule->queue_start = (int *)alloc((num_threads + 1) * sizeof(int),
+		"queue_start", "construct_hillslope_schedule");
+	schedule->queue_next = (int *)alloc(num_threads * sizeof(int),
+		"queue_next", "construct_hillslope_schedule");
+	schedule->thread_hillslopes = (int *)alloc(num_threads * sizeof(int),
+		"thread_hillslopes", "construct_hillslope_schedule");
+	schedule->queue_cost = (double *)alloc(num_threads * sizeof(double),
+		"queue_cost", "construct_hillslope_schedule");
+	schedule->thread_load = (double *)alloc(num_threads * sizeof(double),
+		"thread_load", "construct_hillslope_schedule");
+
+	/*--------------------------------------------------------------*/
+	/*	static work estimate: patches plus canopy strata		*/
+	/*--------------------------------------------------------------*/
+	for (h = 0; h < basin[0].num_hillslopes; h++) {
+		hillslope = basin[0].hillslopes[h];
+		schedule->units[h] = 0.0;
+		for (z = 0; z < hillslope[0].num_zones; z++) {
+			zone = hillslope[0].zones[z];
+			for (p = 0; p < zone[0].num_patches; p++)
+				schedule->units[h] += 1.0
+					+ zone[0].patches[p][0].num_canopy_strata;
+		}
+	}
+
+	update_hillslope_schedule(schedule);
+	return;
+} /*end construct_hillslope_schedule.c*/
@@ -47,13 +47,14 @@ struct	hourly_clim_object *construct_hourly_clim(
 												  FILE	*base_station_file,
 												  char	*file_prefix,
 												  struct	date	start_date,
-												  long	duration)
+												  long	duration,
+												  int	clim_cache_flag)
 {
 	/*--------------------------------------------------------------*/
 	/*	local function declarations.								*/
 	/*--------------------------------------------------------------*/
 	struct clim_event_sequence construct_dated_clim_sequence(char *,
-		struct date);
+		struct date, int);
 	void	*alloc(size_t, char *, char *);
 	/*--------------------------------------------------------------*/
 	/*	local variable declarations 								*/
@@ -108,13 +109,13 @@ struct	hourly_clim_object *construct_hourly_clim(
 			strcpy(file_name, file_prefix);
 			hourly_clim[0].rain = construct_dated_clim_sequence(
 				(char *)strcat(file_name,".rain"),
-				start_date);
+				start_date, clim_cache_flag);
 		}
 		else if ( strcmp(sequence_name,"rain_duration" ) == 0){
 			strcpy(file_name, file_prefix);
 			hourly_clim[0].rain_duration = construct_dated_clim_sequence(
 				(char *)strcat(file_name,".rain_duration"),
-				start_date);
+				start_date, clim_cache_flag);
 		}
 		else  {fprintf(stderr,"WARNING-clim sequence %s not found.\n", sequence_name);
 			exit(EXIT_FAILURE);
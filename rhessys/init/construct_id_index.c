@@ -0,0 +1,128 @@
+/*--------------------------------------------------------------*/
+/*                                                              */
+/*		construct_id_index				*/
+/*                                                              */
+/*  NAME                                                        */
+/*		construct_id_index				*/
+/*                                                              */
+/*                                                              */
+/*  SYNOPSIS                                                    */
+/*  struct id_index_object *construct_id_index(			*/
+/*			struct basin_object *basin)		*/
+/*                                                              */
+/*  OPTIONS                                                     */
+/*                                                              */
+/*  DESCRIPTION                                                 */
+/*                                                              */
+/*	builds a hash table of all hillslopes, zones, patches	*/
+/*	and canopy strata of a basin, keyed by the object they	*/
+/*	belong to and their ID, so that the find_* routines	*/
+/*	(find_patch, find_zone_in_hillslope, ...) look an	*/
+/*	object up in constant time instead of scanning the	*/
+/*	hierarchy.						*/
+/*                                                              */
+/*  PROGRAMMER NOTES                                            */
+/*                                                              */
+/*	must be called after sort_by_elevation - objects are	*/
+/*	entered in array order and a repeated ID keeps the	*/
+/*	first entry, which is the object the linear scans	*/
+/*	used to return						*/
+/*	the table is kept at most half full			*/
+/*                                                              */
+/*--------------------------------------------------------------*/
+
+#include <stdio.h>
+#include "rhessys.h"
+
+/*--------------------------------------------------------------*/
+/*	add (parent, ID) -> object unless already present	*/
+/*--------------------------------------------------------------*/
+static void insert_id_index( struct id_index_object *index,
+							void *parent,
+							int ID,
+							void *object)
+{
+	int id_index_slot( struct id_index_object *, void *, int);
+	int i;
+	struct id_index_entry_object *entry;
+
+	i = id_index_slot(index, parent, ID);
+	entry = &(index[0].entries[i]);
+	while (entry[0].parent != NULL) {
+		if ((entry[0].parent == parent) && (entry[0].ID == ID))
+			return;
+		i = (i + 1) & (index[0].size - 1);
+		entry = &(index[0].entries[i]);
+	}
+	entry[0].parent = parent;
+	entry[0].ID = ID;
+	entry[0].object = object;
+	index[0].count += 1;
+	return;
+}
+
+struct id_index_object *construct_id_index( struct basin_object *basin)
+{
+	/*------------------------------------------------------*/
+	/*	Local Function Definition. 							*/
+	/*------------------------------------------------------*/
+	void	*alloc( size_t, char *, char *);
+
+	/*------------------------------------------------------*/
+	/*	Local Variable Definition. 							*/
+	/*------------------------------------------------------*/
+	int h, z, p, c;
+	int num_objects;
+	struct hillslope_object *hillslope;
+	struct zone_object *zone;
+	struct patch_object *patch;
+	struct id_index_object *index;
+
+	/*--------------------------------------------------------------*/
+	/*	size the table						*/
+	/*--------------------------------------------------------------*/
+	num_objects = basin[0].num_hillslopes;
+	for (h = 0; h < basin[0].num_hillslopes; h++) {
+		hillslope = basin[0].hillslopes[h];
+		num_objects += hillslope[0].num_zones;
+		for (z = 0; z < hillslope[0].num_zones; z++) {
+			zone = hillslope[0].zones[z];
+			num_objects += zone[0].num_patches;
+			for (p = 0; p < zone[0].num_patches; p++)
+				num_objects += zone[0].patches[p][0].num_canopy_strata;
+		}
+	}
+
+	index = (struct id_index_object *) alloc(sizeof(struct id_index_object),
+		"index", "construct_id_index");
+	index[0].size = 16;
+	while (index[0].size < 2 * num_objects)
+		index[0].size *= 2;
+	index[0].count = 0;
+	index[0].entries = (struct id_index_entry_object *) alloc(
+		index[0].size * sizeof(struct id_index_entry_object),
+		"entries", "construct_id_index");
+	for (h = 0; h < index[0].size; h++)
+		index[0].entries[h].parent = NULL;
+
+	/*--------------------------------------------------------------*/
+	/*	enter every object under its parent			*/
+	/*--------------------------------------------------------------*/
+	for (h = 0; h < basin[0].num_hillslopes; h++) {
+		hillslope = basin[0].hillslopes[h];
+		insert_id_index(index, basin, hillslope[0].ID, hillslope);
+		for (z = 0; z < hillslope[0].num_zones; z++) {
+			zone = hillslope[0].zones[z];
+			insert_id_index(index, hillslope, zone[0].ID, zone);
+			for (p = 0; p < zone[0].num_patches; p++) {
+				patch = zone[0].patches[p];
+				insert_id_index(index, zone, patch[0].ID, patch);
+				for (c = 0; c < patch[0].num_canopy_strata; c++)
+					insert_id_index(index, patch,
+						patch[0].canopy_strata[c][0].ID,
+						patch[0].canopy_strata[c]);
+			}
+		}
+	}
+	return(index);
+}/*end construct_id_index */
@@ -84,7 +84,7 @@ struct landuse_default *construct_landuse_defaults(
 		printf("Reading %s\n", default_files[i]);
                 paramCnt = 0;
                 if (paramPtr != NULL)
-                    free(paramPtr);
+                    freeParams(paramPtr);
 
                 paramPtr = readParamFile(&paramCnt, default_files[i]);
 
@@ -156,6 +156,6 @@ struct landuse_default *construct_landuse_defaults(
     
                 printParams(paramCnt, paramPtr, outFilename);
 	} /*end for*/
-        free(paramPtr);
+        freeParams(paramPtr);
 	return(default_object_list);
 } /*end construct_landuse_defaults*/
@@ -47,7 +47,8 @@ struct	monthly_clim_object *construct_monthly_clim(
 													char	*file_prefix,
 													struct	date	start_date,
 													long	duration,
-													int  clim_repeat_flag)
+													int  clim_repeat_flag,
+													int  clim_cache_flag)
 													
 {
 	/*--------------------------------------------------------------*/
@@ -56,7 +57,7 @@ struct	monthly_clim_object *construct_monthly_clim(
 	double	*construct_clim_sequence(
 		char	*,
 		struct date	,
-		long, int);
+		long, int, int);
 	
 	void	*alloc(	size_t,
 		char	*,
@@ -123,7 +124,7 @@ struct	monthly_clim_object *construct_monthly_clim(
 			monthly_clim[0].temp = construct_clim_sequence(
 				(char *)strcat(file_name,".temp"),
 				start_date,
-				duration, clim_repeat_flag);
+				duration, clim_repeat_flag, clim_cache_flag);
 		}
 		else
 		{
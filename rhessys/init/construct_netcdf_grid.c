@@ -22,6 +22,8 @@
 
 /*--------------------------------------------------------------*/
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <math.h>
 #include "rhessys.h"
 
@@ -157,10 +159,18 @@ struct base_station_object *construct_netcdf_grid (
         /* For each daily clim structure allocate clim seqs for all required & optional clims */
         base_station[0].daily_clim = (struct daily_clim_object *)
                 alloc(1*sizeof(struct daily_clim_object),"daily_clim","construct_netcdf_grid" );
+        base_station[0].daily_clim[0].window_start = 0;
+#ifdef LIU_NETCDF_READER
+        /* allocated (or streamed) by construct_netcdf_grid_clim */
+        base_station[0].daily_clim[0].tmax = NULL;
+        base_station[0].daily_clim[0].tmin = NULL;
+        base_station[0].daily_clim[0].rain = NULL;
+#else
         //duration.day is a long that was passed into construct_ascii as a date struct
         base_station[0].daily_clim[0].tmax = (double *) alloc(duration->day * sizeof(double),"tmax", "construct_netcdf_grid");
         base_station[0].daily_clim[0].tmin = (double *) alloc(duration->day * sizeof(double),"tmin", "construct_netcdf_grid");
         base_station[0].daily_clim[0].rain = (double *) alloc(duration->day * sizeof(double),"rain", "construct_netcdf_grid");
+#endif
         /*--------------------------------------------------------------*/
         /*	initialize the rest of the clim sequences as null	*/
         /*--------------------------------------------------------------*/
@@ -220,6 +230,9 @@ struct base_station_object *construct_netcdf_grid (
         /*	Initialize non - critical sequences.						*/
         base_station[0].hourly_clim[0].rain.inx = -999;
         base_station[0].hourly_clim[0].rain_duration.inx = -999;
+        base_station[0].dated_input = NULL;
+#ifndef LIU_NETCDF_READER
+        /* the LIU reader fills the climate of all stations at once, see construct_netcdf_grid_clim */
         /* Calculate start day index */
         instartday = get_indays((int)start_date->year,
                         (int)start_date->month,
@@ -364,6 +377,7 @@ struct base_station_object *construct_netcdf_grid (
         //if( command_line[0].clim_repeat_flag ) { 
                 free(tempdata);
         //}
+#endif
         /*printf("\n      Construct netcdf cell: END ID=%d x=%lf y=%lf lai=%lf i=%d",
           base_station[0].ID,
           base_station[0].x,
@@ -378,3 +392,303 @@ struct base_station_object *construct_netcdf_grid (
         return(base_station);
 }
 
+
+#ifdef LIU_NETCDF_READER
+/*--------------------------------------------------------------*/
+/*	stream_netcdf_grid - opens variable name (tmax, tmin or	*/
+/*		rain) of all stations as a clim grid stream		*/
+/*--------------------------------------------------------------*/
+static void stream_netcdf_grid(
+                struct base_station_object **base_stations,
+                int		num_base_stations,
+                struct base_station_ncheader_object *base_station_ncheader,
+                char	*filename,
+                char	*varname,
+                char	*name,
+                float	*net_x,
+                float	*net_y,
+                int	instartday,
+                struct		date *duration,
+                struct command_line_object *command_line,
+                double	kelvin_above,
+                double	multiplier,
+                struct clim_window_object *clim_window
+                )
+{
+        void	*alloc( 	size_t, char *, char *);
+        struct clim_stream_object *construct_clim_grid_stream(int, FILE *,
+                struct netcdf_grid_series *, char *, int, double ***,
+                struct daily_clim_object **, double, double,
+                struct clim_window_object *);
+        int	i;
+        double	***series;
+        struct	daily_clim_object	**daily_clim;
+        struct	netcdf_grid_series	*netcdf;
+
+        netcdf = open_netcdf_grid_series(
+                        filename,
+                        varname,
+                        "lat",
+                        "lon",
+                        num_base_stations,
+                        net_y,
+                        net_x,
+                        (float)base_station_ncheader[0].resolution_dd,
+                        instartday,
+                        base_station_ncheader[0].day_offset,
+                        (int)duration->day,
+                        command_line[0].clim_repeat_flag);
+        if (netcdf == NULL){
+                fprintf(stderr,"can't locate station data in netcdf for var %s\n", name);
+                exit(0);
+        }
+        series = (double ***) alloc(num_base_stations * sizeof(double **),"series","stream_netcdf_grid");
+        daily_clim = (struct daily_clim_object **) alloc(num_base_stations * sizeof(struct daily_clim_object *),"daily_clim","stream_netcdf_grid");
+        for (i = 0; i < num_base_stations; i++) {
+                daily_clim[i] = base_stations[i][0].daily_clim;
+                if (strcmp(name, "tmax") == 0)
+                        series[i] = &(daily_clim[i][0].tmax);
+                else if (strcmp(name, "tmin") == 0)
+                        series[i] = &(daily_clim[i][0].tmin);
+                else
+                        series[i] = &(daily_clim[i][0].rain);
+        }
+        construct_clim_grid_stream(CLIM_STREAM_NETCDF_GRID, NULL, netcdf,
+                filename, num_base_stations, series, daily_clim,
+                kelvin_above, multiplier, clim_window);
+        return;
+}
+
+/*--------------------------------------------------------------*/
+/*	construct_netcdf_grid_clim - reads the netcdf climate of	*/
+/*		all grid base stations					*/
+/*	SYNOPSIS							*/
+/*	void construct_netcdf_grid_clim(				*/
+/*		base_stations, num_base_stations,			*/
+/*		base_station_ncheader, start_date, duration,		*/
+/*		command_line, clim_window)				*/
+/*	DESCRIPTION							*/
+/*	Fills tmax, tmin, rain and (with elevflag) z of the		*/
+/*	stations set up by construct_netcdf_grid.  Each variable	*/
+/*	is read for all stations in one pass over its file (see	*/
+/*	get_netcdf_grid_timeseries), instead of opening the file	*/
+/*	and reading its coordinates once per station.			*/
+/*	Values and unit conversions are those of the per station	*/
+/*	reader.								*/
+/*	With -climwindow (clim_window not NULL, and a run longer	*/
+/*	than the window) tmax, tmin and rain are streamed instead:	*/
+/*	each variable stays open as a clim grid stream and its		*/
+/*	windows are read by read_netcdf_clim_stream.			*/
+/*--------------------------------------------------------------*/
+void construct_netcdf_grid_clim(
+                struct base_station_object **base_stations,
+                int		num_base_stations,
+                struct base_station_ncheader_object *base_station_ncheader,
+                struct		date *start_date,
+                struct		date *duration,
+                struct command_line_object *command_line,
+                struct clim_window_object *clim_window
+                )
+{
+        void	*alloc( 	size_t, char *, char *);
+        /*--------------------------------------------------------------*/
+        /*	Local variable definition.									*/
+        /*--------------------------------------------------------------*/
+        int	i;
+        int	j;
+        int	k;
+        int	instartday;		//days since Jan 1, STARTYEAR
+        float	*net_x, *net_y;
+        double	**series;
+        double	*elev;
+        double	kelvin_above;
+        char *lat_name = "lat";
+        char *lon_name = "lon";
+
+        if (num_base_stations < 1)
+                return;
+
+        net_x = (float *) alloc(num_base_stations * sizeof(float),"net_x","construct_netcdf_grid_clim");
+        net_y = (float *) alloc(num_base_stations * sizeof(float),"net_y","construct_netcdf_grid_clim");
+        series = (double **) alloc(num_base_stations * sizeof(double *),"series","construct_netcdf_grid_clim");
+        for (i = 0; i < num_base_stations; i++) {
+                net_x[i] = base_stations[i][0].lon;
+                net_y[i] = base_stations[i][0].lat;
+        }
+
+        instartday = get_indays((int)start_date->year,
+                        (int)start_date->month,
+                        (int)start_date->day,
+                        base_station_ncheader[0].year_start,
+                        base_station_ncheader[0].leap_year);
+
+        if ((clim_window != NULL) && (duration->day > clim_window[0].window_days)) {
+                /* ------------------ TMAX, TMIN, PRECIP streamed ------------------ */
+                kelvin_above = (base_station_ncheader[0].temperature_unit == 'K') ? -HUGE_VAL : 150.0;
+                stream_netcdf_grid(base_stations, num_base_stations, base_station_ncheader,
+                        base_station_ncheader[0].netcdf_tmax_filename,
+                        base_station_ncheader[0].netcdf_tmax_varname,
+                        "tmax", net_x, net_y, instartday, duration, command_line,
+                        kelvin_above, 1.0, clim_window);
+                kelvin_above = (base_station_ncheader[0].temperature_unit == 'K') ? -HUGE_VAL : HUGE_VAL;
+                stream_netcdf_grid(base_stations, num_base_stations, base_station_ncheader,
+                        base_station_ncheader[0].netcdf_tmin_filename,
+                        base_station_ncheader[0].netcdf_tmin_varname,
+                        "tmin", net_x, net_y, instartday, duration, command_line,
+                        kelvin_above, 1.0, clim_window);
+                stream_netcdf_grid(base_stations, num_base_stations, base_station_ncheader,
+                        base_station_ncheader[0].netcdf_rain_filename,
+                        base_station_ncheader[0].netcdf_rain_varname,
+                        "rain", net_x, net_y, instartday, duration, command_line,
+                        HUGE_VAL, base_station_ncheader[0].precip_mult, clim_window);
+        }
+        else {
+                for (i = 0; i < num_base_stations; i++) {
+                        base_stations[i][0].daily_clim[0].tmax = (double *) alloc(duration->day * sizeof(double),"tmax", "construct_netcdf_grid_clim");
+                        base_stations[i][0].daily_clim[0].tmin = (double *) alloc(duration->day * sizeof(double),"tmin", "construct_netcdf_grid_clim");
+                        base_stations[i][0].daily_clim[0].rain = (double *) alloc(duration->day * sizeof(double),"rain", "construct_netcdf_grid_clim");
+                }
+
+                /* ------------------ TMAX ------------------ */
+                for (i = 0; i < num_base_stations; i++)
+                        series[i] = base_stations[i][0].daily_clim[0].tmax;
+                k = get_netcdf_grid_timeseries(
+                                base_station_ncheader[0].netcdf_tmax_filename,
+                                base_station_ncheader[0].netcdf_tmax_varname,
+                                lat_name,
+                                lon_name,
+                                num_base_stations,
+                                net_y,
+                                net_x,
+                                (float)base_station_ncheader[0].resolution_dd,
+                                instartday,
+                                base_station_ncheader[0].day_offset,
+                                (int)duration->day,
+                                command_line[0].clim_repeat_flag,
+                                series);
+                if (k == -1){
+                        fprintf(stderr,"can't locate station data in netcdf for var tmax\n");
+                        exit(0);
+                }
+                #pragma omp parallel for private(j)
+                for (i = 0; i < num_base_stations; i++) {
+                        for (j = 0; j < duration->day; j++) {
+                                if ((base_station_ncheader[0].temperature_unit == 'K') || (series[i][j] > 150.0)) // kind of hard coded for temperature > 150
+                                        series[i][j] -= 273.15;
+                        }
+                }
+
+                /* ------------------ TMIN ------------------ */
+                for (i = 0; i < num_base_stations; i++)
+                        series[i] = base_stations[i][0].daily_clim[0].tmin;
+                k = get_netcdf_grid_timeseries(
+                                base_station_ncheader[0].netcdf_tmin_filename,
+                                base_station_ncheader[0].netcdf_tmin_varname,
+                                lat_name,
+                                lon_name,
+                                num_base_stations,
+                                net_y,
+                                net_x,
+                                (float)base_station_ncheader[0].resolution_dd,
+                                instartday,
+                                base_station_ncheader[0].day_offset,
+                                (int)duration->day,
+                                command_line[0].clim_repeat_flag,
+                                series);
+                if (k == -1){
+                        fprintf(stderr,"can't locate station data in netcdf for var tmin\n");
+                        exit(0);
+                }
+                if (base_station_ncheader[0].temperature_unit == 'K') {
+                        #pragma omp parallel for private(j)
+                        for (i = 0; i < num_base_stations; i++) {
+                                for (j = 0; j < duration->day; j++)
+                                        series[i][j] -= 273.15;
+                        }
+                }
+
+                /* ------------------ PRECIP ------------------ */
+                for (i = 0; i < num_base_stations; i++)
+                        series[i] = base_stations[i][0].daily_clim[0].rain;
+                k = get_netcdf_grid_timeseries(
+                                base_station_ncheader[0].netcdf_rain_filename,
+                                base_station_ncheader[0].netcdf_rain_varname,
+                                lat_name,
+                                lon_name,
+                                num_base_stations,
+                                net_y,
+                                net_x,
+                                (float)base_station_ncheader[0].resolution_dd,
+                                instartday,
+                                base_station_ncheader[0].day_offset,
+                                (int)duration->day,
+                                command_line[0].clim_repeat_flag,
+                                series);
+                if (k == -1){
+                        fprintf(stderr,"can't locate station data in netcdf for var rain\n");
+                        exit(0);
+                }
+                #pragma omp parallel for private(j)
+                for (i = 0; i < num_base_stations; i++) {
+                        for (j = 0; j < duration->day; j++)
+                                series[i][j] *= base_station_ncheader[0].precip_mult;
+                }
+        }
+
+        /* ------------------ ELEV ------------------ */
+        if (base_station_ncheader[0].elevflag != 0) {
+                elev = (double *) alloc(num_base_stations * sizeof(double),"elev","construct_netcdf_grid_clim");
+                k = get_netcdf_grid_var(
+                                base_station_ncheader[0].netcdf_elev_filename,
+                                base_station_ncheader[0].netcdf_elev_varname,
+                                lat_name,
+                                lon_name,
+                                num_base_stations,
+                                net_y,
+                                net_x,
+                                (float)base_station_ncheader[0].resolution_dd,
+                                elev);
+                if (k == -1){
+                        fprintf(stderr,"can't locate station data in netcdf for var elev\n");
+                        exit(0);
+                }
+                for (i = 0; i < num_base_stations; i++)
+                        base_stations[i][0].z = elev[i];
+                free(elev);
+        }
+
+        free(net_x);
+        free(net_y);
+        free(series);
+        return;
+}
+#endif
+
+
+/*--------------------------------------------------------------*/
+/*	read_netcdf_clim_stream - reads the next num_days days of	*/
+/*		a netcdf clim grid stream into its float window		*/
+/*		(see read_clim_stream)					*/
+/*	close_netcdf_clim_stream - closes its netcdf file		*/
+/*--------------------------------------------------------------*/
+void read_netcdf_clim_stream(
+                struct clim_stream_object *stream,
+                long	window_days,
+                long	num_days)
+{
+        if (read_netcdf_grid_series(stream[0].netcdf, (int)stream[0].next_day,
+                        (int)num_days, (int)window_days, stream[0].float_buffer) == -1) {
+                fprintf(stderr,"FATAL ERROR: in read_netcdf_clim_stream, cannot read %s\n",
+                        stream[0].filename);
+                exit(EXIT_FAILURE);
+        }
+        stream[0].next_day += num_days;
+        return;
+}
+
+void close_netcdf_clim_stream(struct clim_stream_object *stream)
+{
+        close_netcdf_grid_series(stream[0].netcdf);
+        stream[0].netcdf = NULL;
+        return;
+}
@@ -23,6 +23,7 @@
 
 /*--------------------------------------------------------------*/
 #include <stdio.h>
+#include <stdlib.h>
 #include <math.h>
 #include "rhessys.h"
 
@@ -53,3 +54,31 @@ struct base_station_object *construct_netcdf_grid(
   return(base_station);
 }
 
+
+void construct_netcdf_grid_clim(
+                struct base_station_object **base_stations,
+                int   num_base_stations,
+                struct base_station_ncheader_object *base_station_ncheader,
+                struct    date *start_date,
+                struct    date *duration,
+                struct command_line_object *command_line,
+                struct clim_window_object *clim_window)
+{
+  return;
+}
+
+
+/* without netcdf there are no netcdf clim streams */
+void read_netcdf_clim_stream(
+                struct clim_stream_object *stream,
+                long    window_days,
+                long    num_days)
+{
+  fprintf(stderr,"FATAL ERROR: in read_netcdf_clim_stream, built without netcdf\n");
+  exit(EXIT_FAILURE);
+}
+
+void close_netcdf_clim_stream(struct clim_stream_object *stream)
+{
+  return;
+}
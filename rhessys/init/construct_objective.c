@@ -0,0 +1,138 @@
+/*--------------------------------------------------------------*/
+/* 																*/
+/*					construct_objective							*/
+/*																*/
+/*	NAME														*/
+/*	construct_objective - reads the observed streamflow for		*/
+/*		the objective functions									*/
+/*																*/
+/*	SYNOPSIS													*/
+/*	struct objective_object *construct_objective(				*/
+/*					struct world_object *world,					*/
+/*					struct command_line_object *command_line)	*/
+/*																*/
+/*	OPTIONS														*/
+/*	-objective <file> [<start y m d> <end y m d>]				*/
+/*																*/
+/*	DESCRIPTION													*/
+/*																*/
+/*	Reads the observed daily streamflow of the first basin of	*/
+/*	the world, one day per line:								*/
+/*																*/
+/*		year month day streamflow (mm/day)						*/
+/*																*/
+/*	Days not listed, negative values and values that are not	*/
+/*	numbers (NA, nan) are missing.  The evaluation window is the		*/
+/*	one given on the command line, or else the days of the		*/
+/*	file.  The offset added to flows before taking their log	*/
+/*	(log NSE) is a hundredth of the mean observed flow of the	*/
+/*	window.														*/
+/*																*/
+/*	PROGRAMMER NOTES											*/
+/*																*/
+/*	the lines must be in date order								*/
+/*--------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "rhessys.h"
+
+struct objective_object *construct_objective(
+											 struct world_object *world,
+											 struct command_line_object *command_line)
+{
+	/*--------------------------------------------------------------*/
+	/*	Local function definition.									*/
+	/*--------------------------------------------------------------*/
+	void	*alloc(size_t, char *, char *);
+	long	julday(struct date);
+
+	/*--------------------------------------------------------------*/
+	/*	Local variable definition.									*/
+	/*--------------------------------------------------------------*/
+	long	i, day, last_day, num_obs;
+	double	value, sum;
+	char	record[MAXSTR];
+	struct	date	date;
+	struct	objective_object	*objective;
+	FILE	*file;
+
+	if ((file = fopen(command_line[0].objective_filename, "r")) == NULL) {
+		fprintf(stderr,"FATAL ERROR: Cannot open observed streamflow file %s\n",
+			command_line[0].objective_filename);
+		exit(EXIT_FAILURE);
+	}
+	objective = (struct objective_object *) alloc(sizeof(struct objective_object),
+		"objective", "construct_objective");
+	objective[0].basin_ID = world[0].basins[0][0].ID;
+
+	/*--------------------------------------------------------------*/
+	/*	first pass for the dates, second for the values			*/
+	/*--------------------------------------------------------------*/
+	date.hour = 1;
+	objective[0].first_day = 0;
+	last_day = 0;
+	num_obs = 0;
+	while (fgets(record, MAXSTR, file) != NULL) {
+		if (sscanf(record, "%ld %ld %ld", &(date.year), &(date.month), &(date.day)) != 3)
+			continue;
+		day = julday(date);
+		if (num_obs == 0)
+			objective[0].first_day = day;
+		else if (day <= last_day) {
+			fprintf(stderr,"FATAL ERROR: %s is not in date order at %ld %ld %ld\n",
+				command_line[0].objective_filename, date.year, date.month, date.day);
+			exit(EXIT_FAILURE);
+		}
+		last_day = day;
+		num_obs++;
+	}
+	if (num_obs == 0) {
+		fprintf(stderr,"FATAL ERROR: no observed streamflow in %s\n",
+			command_line[0].objective_filename);
+		exit(EXIT_FAILURE);
+	}
+	objective[0].num_days = last_day - objective[0].first_day + 1;
+	objective[0].obs = (double *) alloc(objective[0].num_days * sizeof(double),
+		"obs", "construct_objective");
+	for (i=0; i<objective[0].num_days; i++)
+		objective[0].obs[i] = -1.0;
+	rewind(file);
+	while (fgets(record, MAXSTR, file) != NULL) {
+		if (sscanf(record, "%ld %ld %ld %lf", &(date.year), &(date.month),
+				&(date.day), &value) != 4)
+			continue;
+		if (!isfinite(value))
+			continue;
+		objective[0].obs[julday(date) - objective[0].first_day] = value;
+	}
+	fclose(file);
+
+	/*--------------------------------------------------------------*/
+	/*	the window, and the log offset from its mean flow			*/
+	/*--------------------------------------------------------------*/
+	objective[0].window_start = objective[0].first_day;
+	objective[0].window_end = last_day;
+	if (command_line[0].objective_start.year != 0) {
+		objective[0].window_start = julday(command_line[0].objective_start);
+		objective[0].window_end = julday(command_line[0].objective_end);
+	}
+	sum = 0.0;
+	num_obs = 0;
+	for (day = max(objective[0].window_start, objective[0].first_day);
+		day <= min(objective[0].window_end, last_day); day++) {
+		value = objective[0].obs[day - objective[0].first_day];
+		if (value >= 0.0) {
+			sum += value;
+			num_obs++;
+		}
+	}
+	if (num_obs == 0) {
+		fprintf(stderr,"FATAL ERROR: no observed streamflow in the -objective window\n");
+		exit(EXIT_FAILURE);
+	}
+	objective[0].log_offset = max(sum / num_obs / 100.0, 1.0e-6);
+	printf("\n Read %ld days of observed streamflow for basin %d\n",
+		num_obs, objective[0].basin_ID);
+	return(objective);
+} /*end construct_objective*/
@@ -12,6 +12,8 @@
 /*   						command_line ) 						*/	
 /*																*/
 /*	OPTIONS														*/
+/*	column_levels - levels (of bhzpc) whose daily output is		*/
+/*					written as columns (-colout)				*/
 /*																*/
 /*	DESCRIPTION													*/
 /*																*/
@@ -34,12 +36,13 @@
 
 struct	world_output_file_object *construct_output_files(
 														 char 	*prefix,
-														 struct	command_line_object *command_line )
+														 struct	command_line_object *command_line,
+														 char	*column_levels )
 {
 	/*--------------------------------------------------------------*/
 	/*	Local function definition.									*/
 	/*--------------------------------------------------------------*/
-	struct	output_files_object	*construct_output_fileset(char *);
+	struct	output_files_object	*construct_output_fileset(char *, int);
 	void	*alloc(	size_t, char *, char *);
 	/*--------------------------------------------------------------*/
 	/*	Local variable definition.									*/
@@ -52,10 +55,12 @@ struct	world_output_file_object *construct_output_files(
 	/*--------------------------------------------------------------*/
 	if ((command_line[0].b != NULL) || (command_line[0].h != NULL) ||
 		(command_line[0].z != NULL) || (command_line[0].p != NULL) ||
-		(command_line[0].c != NULL)|| (command_line[0].stro != NULL) ){
+		(command_line[0].c != NULL)|| (command_line[0].stro != NULL) ||
+		(command_line[0].output_spec_flag == 1) ){
 		world_output_file = (struct world_output_file_object *)
 			alloc(1 * sizeof(struct world_output_file_object),
 			"world_output_file","construct_output_files");
+		world_output_file[0].spec = NULL;
 	}
 	else{
 		fprintf(stderr,
@@ -68,7 +73,7 @@ struct	world_output_file_object *construct_output_files(
 	if ( command_line[0].stro != NULL ){
 		strcpy(root,prefix);
 		strcat(root, "_streamrouting");
-		world_output_file[0].stream_routing = construct_output_fileset(root);
+		world_output_file[0].stream_routing = construct_output_fileset(root, 0);
 	}
 	/*--------------------------------------------------------------*/
 	/*	Construct the basin output files.							*/
@@ -76,7 +81,8 @@ struct	world_output_file_object *construct_output_files(
 	if ( command_line[0].b != NULL ){
 		strcpy(root,prefix);
 		strcat(root, "_basin");
-		world_output_file[0].basin = construct_output_fileset(root);
+		world_output_file[0].basin = construct_output_fileset(root,
+			strchr(column_levels, 'b') != NULL);
 	}
 	/*--------------------------------------------------------------*/
 	/*	Construct the hillslope output files.						*/
@@ -84,7 +90,8 @@ struct	world_output_file_object *construct_output_files(
 	if ( command_line[0].h != NULL ){
 		strcpy(root,prefix);
 		strcat(root, "_hillslope");
-		world_output_file[0].hillslope = construct_output_fileset(root);
+		world_output_file[0].hillslope = construct_output_fileset(root,
+			strchr(column_levels, 'h') != NULL);
 	}
 	/*--------------------------------------------------------------*/
 	/*	Construct the zone output files.							*/
@@ -92,7 +99,8 @@ struct	world_output_file_object *construct_output_files(
 	if ( command_line[0].z != NULL ){
 		strcpy(root, prefix);
 		strcat(root, "_zone");
-		world_output_file[0].zone = construct_output_fileset(root);
+		world_output_file[0].zone = construct_output_fileset(root,
+			strchr(column_levels, 'z') != NULL);
 	}
 	/*--------------------------------------------------------------*/
 	/*	Construct the patch output files.							*/
@@ -100,7 +108,8 @@ struct	world_output_file_object *construct_output_files(
 	if ( command_line[0].p != NULL ){
 		strcpy(root, prefix);
 		strcat(root, "_patch");
-		world_output_file[0].patch = construct_output_fileset(root);
+		world_output_file[0].patch = construct_output_fileset(root,
+			strchr(column_levels, 'p') != NULL);
 	}
 	/*--------------------------------------------------------------*/
 	/*	Construct the canopy stratum output files.					*/
@@ -109,12 +118,13 @@ struct	world_output_file_object *construct_output_files(
 	if ( (command_line[0].c != NULL) || (command_line[0].p != NULL ) ){
 		strcpy(root, prefix);
 		strcat(root, "_stratum");
-		world_output_file[0].canopy_stratum = construct_output_fileset(root);
+		world_output_file[0].canopy_stratum = construct_output_fileset(root,
+			strchr(column_levels, 'c') != NULL);
   }
  if (command_line[0].vegspinup_flag > ZERO)  {
 	  strcpy(root, prefix);
 		strcat(root, "_shadow_stratum");
-		world_output_file[0].shadow_strata = construct_output_fileset(root);
+		world_output_file[0].shadow_strata = construct_output_fileset(root, 0);
   }
 	fprintf(stderr,"FINISHED CONSTRUCT OUTPUT FILES\n");
 	return(world_output_file);
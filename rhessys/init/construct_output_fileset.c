@@ -11,9 +11,12 @@
 /*																*/
 /*	SYNOPSIS													*/
 /*	struct	output_file_object	*construct_output_fileset(		*/
-/*								char	*root)					*/
+/*								char	*root,					*/
+/*								int		daily_columns)			*/
 /*																*/
 /*	OPTIONS														*/
+/*	daily_columns - 1 to write the daily output as columns		*/
+/*					(-colout) to root.daily.rcol				*/
 /*																*/
 /*	DESCRIPTION													*/
 /*																*/
@@ -39,12 +42,14 @@
 
 
 struct	output_files_object	*construct_output_fileset(
-													  char	*root)
+													  char	*root,
+													  int	daily_columns)
 {
 	/*--------------------------------------------------------------*/
 	/*	Local function definition.									*/
 	/*--------------------------------------------------------------*/
 	void	*alloc(	size_t, char *, char *);
+	struct	column_file_object	*construct_column_file(char *);
 	/*--------------------------------------------------------------*/
 	/*	Local variable definition.									*/
 	/*--------------------------------------------------------------*/
@@ -70,7 +75,13 @@ struct	output_files_object	*construct_output_fileset(
 	} /*end if*/
 	strcpy(filename, root);
 	strcat(filename,".daily");
-	if ( (fileset[0].daily = fopen(filename , "w"))	== NULL ){
+	fileset[0].daily_columns = NULL;
+	if ( daily_columns == 1 ){
+		strcat(filename,".rcol");
+		fileset[0].daily = NULL;
+		fileset[0].daily_columns = construct_column_file(filename);
+	}
+	else if ( (fileset[0].daily = fopen(filename , "w"))	== NULL ){
 		fprintf(stderr,"FATAL ERROR: in construct_output_file.\n");
 		exit(EXIT_FAILURE);
 	} /*end if*/
@@ -0,0 +1,457 @@
+/*--------------------------------------------------------------*/
+/* 																*/
+/*					construct_output_spec						*/
+/*																*/
+/*	construct_output_spec - resolves an output specification	*/
+/*																*/
+/*	NAME														*/
+/*	construct_output_spec - resolves an output specification	*/
+/*																*/
+/*	SYNOPSIS													*/
+/*	struct output_spec_object *construct_output_spec(			*/
+/*				char *filename,									*/
+/*				char *prefix,									*/
+/*				struct world_object *world,						*/
+/*				int daily_columns)								*/
+/*																*/
+/*	OPTIONS														*/
+/*	-outspec <filename>											*/
+/*	daily_columns - 1 to write <prefix>_spec.daily.rcol		*/
+/*					(-colout s) instead of <prefix>_spec.daily	*/
+/*																*/
+/*	DESCRIPTION													*/
+/*																*/
+/*	Each line of the spec file names a level, the IDs of the	*/
+/*	objects (-999 for any, as for -b/-h/-z/-p/-c) and the		*/
+/*	variables wanted from them:									*/
+/*																*/
+/*		basin		<b> <variables>								*/
+/*		hillslope	<b> <h> <variables>							*/
+/*		zone		<b> <h> <z> <variables>						*/
+/*		patch		<b> <h> <z> <p> <variables>					*/
+/*		stratum		<b> <h> <z> <p> <c> <variables>				*/
+/*																*/
+/*	e.g. "patch 1 -999 -999 2134 sat_deficit rz_storage".		*/
+/*	Variables are the fields in spec_variables below, named		*/
+/*	as in rhessys.h (e.g. snowpack.water_equivalent_depth) and	*/
+/*	in its units.  Text after # is a comment.					*/
+/*																*/
+/*	The world is searched once here and every (object,			*/
+/*	variable) found becomes one entry of the returned list, in	*/
+/*	the order of the spec lines, then of the world, then of		*/
+/*	the variables on the line.  output_spec writes one line		*/
+/*	per day: day month year and the value of each entry, under	*/
+/*	a header naming each column <level>_<IDs>.<variable>.		*/
+/*																*/
+/*	PROGRAMMER NOTES											*/
+/*																*/
+/*	a line matching no object is only a warning; an unknown		*/
+/*	level or variable is fatal									*/
+/*	to offer another variable add it to spec_variables			*/
+/*--------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include "rhessys.h"
+
+#define SPEC_BASIN		0
+#define SPEC_HILLSLOPE	1
+#define SPEC_ZONE		2
+#define SPEC_PATCH		3
+#define SPEC_STRATUM	4
+#define SPEC_LINE_LEN	8192
+
+static char *spec_levels[] = {"basin", "hillslope", "zone", "patch", "stratum"};
+
+static struct spec_variable {
+	int		level;
+	char	*name;
+	size_t	offset;
+	int		type;
+} spec_variables[] = {
+#define BASIN_VAR(f)	{SPEC_BASIN, #f, offsetof(struct basin_object, f), OUTPUT_SPEC_DOUBLE}
+#define HILL_VAR(f)		{SPEC_HILLSLOPE, #f, offsetof(struct hillslope_object, f), OUTPUT_SPEC_DOUBLE}
+#define ZONE_VAR(f)		{SPEC_ZONE, #f, offsetof(struct zone_object, f), OUTPUT_SPEC_DOUBLE}
+#define PATCH_VAR(f)	{SPEC_PATCH, #f, offsetof(struct patch_object, f), OUTPUT_SPEC_DOUBLE}
+#define PATCH_INT(f)	{SPEC_PATCH, #f, offsetof(struct patch_object, f), OUTPUT_SPEC_INT}
+#define STRATUM_VAR(f)	{SPEC_STRATUM, #f, offsetof(struct canopy_strata_object, f), OUTPUT_SPEC_DOUBLE}
+	BASIN_VAR(area),
+	BASIN_VAR(basin_outflow),
+	BASIN_VAR(basin_rz_storage),
+	BASIN_VAR(basin_unsat_storage),
+	BASIN_VAR(basin_sat_deficit),
+	BASIN_VAR(basin_return_flow),
+	BASIN_VAR(basin_detention_store),
+	HILL_VAR(area),
+	HILL_VAR(base_flow),
+	HILL_VAR(streamflow_NO3),
+	HILL_VAR(streamflow_NH4),
+	HILL_VAR(streamflow_DON),
+	HILL_VAR(streamflow_DOC),
+	HILL_VAR(gw.Qout),
+	HILL_VAR(gw.storage),
+	ZONE_VAR(rain),
+	ZONE_VAR(snow),
+	ZONE_VAR(metv.tmax),
+	ZONE_VAR(metv.tmin),
+	ZONE_VAR(metv.tavg),
+	ZONE_VAR(metv.vpd),
+	ZONE_VAR(Kdown_direct),
+	ZONE_VAR(Kdown_diffuse),
+	ZONE_VAR(PAR_direct),
+	ZONE_VAR(PAR_diffuse),
+	ZONE_VAR(Ldown),
+	ZONE_VAR(relative_humidity),
+	ZONE_VAR(tdewpoint),
+	ZONE_VAR(atm_trans),
+	ZONE_VAR(wind),
+	ZONE_VAR(cloud_fraction),
+	PATCH_VAR(area),
+	PATCH_VAR(rain_throughfall),
+	PATCH_VAR(detention_store),
+	PATCH_VAR(sat_deficit_z),
+	PATCH_VAR(sat_deficit),
+	PATCH_VAR(rz_storage),
+	PATCH_VAR(unsat_storage),
+	PATCH_VAR(rz_drainage),
+	PATCH_VAR(unsat_drainage),
+	PATCH_VAR(field_capacity),
+	PATCH_VAR(wilting_point),
+	PATCH_VAR(rootzone.S),
+	PATCH_VAR(rootzone.depth),
+	PATCH_VAR(rootzone.potential_sat),
+	PATCH_VAR(rootzone.field_capacity),
+	PATCH_VAR(return_flow),
+	PATCH_VAR(overland_flow),
+	PATCH_VAR(base_flow),
+	PATCH_VAR(streamflow),
+	PATCH_VAR(recharge),
+	PATCH_VAR(Qin_total),
+	PATCH_VAR(Qout_total),
+	PATCH_VAR(evaporation),
+	PATCH_VAR(evaporation_surf),
+	PATCH_VAR(exfiltration_sat_zone),
+	PATCH_VAR(exfiltration_unsat_zone),
+	PATCH_VAR(transpiration_sat_zone),
+	PATCH_VAR(transpiration_unsat_zone),
+	PATCH_VAR(PET),
+	PATCH_VAR(snow_melt),
+	PATCH_VAR(snowpack.water_equivalent_depth),
+	PATCH_VAR(snowpack.sublimation),
+	PATCH_VAR(snowpack.energy_deficit),
+	PATCH_VAR(litter.rain_stored),
+	PATCH_VAR(Kdown_direct),
+	PATCH_VAR(Kdown_diffuse),
+	PATCH_VAR(Kup_direct),
+	PATCH_VAR(Kup_diffuse),
+	PATCH_VAR(Lup),
+	PATCH_VAR(Kstar_canopy),
+	PATCH_VAR(Kstar_soil),
+	PATCH_VAR(Lstar_canopy),
+	PATCH_VAR(Lstar_soil),
+	PATCH_VAR(LE_canopy),
+	PATCH_VAR(wind),
+	PATCH_VAR(ga),
+	PATCH_VAR(soil_cs.totalc),
+	PATCH_VAR(soil_ns.totaln),
+	PATCH_VAR(soil_ns.nitrate),
+	PATCH_VAR(soil_ns.sminn),
+	PATCH_VAR(litter_cs.litr1c),
+	PATCH_VAR(litter_ns.litr1n),
+	PATCH_INT(drainage_type),
+	PATCH_INT(target_status),
+	STRATUM_VAR(cover_fraction),
+	STRATUM_VAR(gap_fraction),
+	STRATUM_VAR(evaporation),
+	STRATUM_VAR(sublimation),
+	STRATUM_VAR(transpiration_sat_zone),
+	STRATUM_VAR(transpiration_unsat_zone),
+	STRATUM_VAR(rain_stored),
+	STRATUM_VAR(snow_stored),
+	STRATUM_VAR(ga),
+	STRATUM_VAR(gs),
+	STRATUM_VAR(gsurf),
+	STRATUM_VAR(Kstar_direct),
+	STRATUM_VAR(Kstar_diffuse),
+	STRATUM_VAR(Lstar),
+	STRATUM_VAR(rootzone.depth),
+	STRATUM_VAR(epv.proj_lai),
+	STRATUM_VAR(epv.height),
+	STRATUM_VAR(epv.psi),
+	STRATUM_VAR(cs.net_psn),
+	STRATUM_VAR(cs.cpool),
+	STRATUM_VAR(cs.leafc),
+	STRATUM_VAR(cs.frootc),
+	STRATUM_VAR(cs.live_stemc),
+	STRATUM_VAR(cs.dead_stemc),
+	STRATUM_VAR(cs.live_crootc),
+	STRATUM_VAR(cs.dead_crootc),
+	STRATUM_VAR(ns.leafn),
+	STRATUM_VAR(ns.frootn),
+	{-1, NULL, 0, 0}
+};
+
+/*--------------------------------------------------------------*/
+/*	append one entry, growing the list as needed			*/
+/*--------------------------------------------------------------*/
+static void add_spec_entry(struct output_spec_object *spec, int *capacity,
+						   void *object, struct spec_variable *variable)
+{
+	if (spec[0].num_entries == *capacity) {
+		*capacity = 2 * (*capacity) + 16;
+		spec[0].entries = (struct output_spec_entry_object *) realloc(
+			spec[0].entries, *capacity * sizeof(struct output_spec_entry_object));
+		if (spec[0].entries == NULL) {
+			fprintf(stderr,"FATAL ERROR: in construct_output_spec, out of memory\n");
+			exit(EXIT_FAILURE);
+		}
+	}
+	spec[0].entries[spec[0].num_entries].object = object;
+	spec[0].entries[spec[0].num_entries].offset = variable[0].offset;
+	spec[0].entries[spec[0].num_entries].type = variable[0].type;
+	spec[0].num_entries += 1;
+}
+
+/*--------------------------------------------------------------*/
+/*	header name of a column, e.g. patch_1_12_3_2134.rz_storage	*/
+/*	(written straight away, before the next one is made)		*/
+/*--------------------------------------------------------------*/
+static void add_spec_name(struct output_spec_object *spec, int level,
+						  int *ids, struct spec_variable *variable)
+{
+	void	column_file_name(struct column_file_object *, char *);
+	int	i;
+	char	name[256], id[16];
+
+	strcpy(name, spec_levels[level]);
+	for (i=0; i<=level; i++) {
+		sprintf(id, "_%d", ids[i]);
+		strcat(name, id);
+	}
+	strcat(name, ".");
+	strncat(name, variable[0].name, sizeof(name) - strlen(name) - 1);
+	if (spec[0].columns != NULL)
+		column_file_name(spec[0].columns, name);
+	else
+		fprintf(spec[0].outfile, " %s", name);
+}
+
+struct output_spec_object *construct_output_spec(char *filename,
+												  char *prefix,
+												  struct world_object *world,
+												  int daily_columns)
+{
+	/*--------------------------------------------------------------*/
+	/*	local function declarations.								*/
+	/*--------------------------------------------------------------*/
+	void	*alloc(size_t, char *, char *);
+	struct	column_file_object	*construct_column_file(char *);
+	void	column_file_name(struct column_file_object *, char *);
+	void	column_file_end_row(struct column_file_object *);
+	/*--------------------------------------------------------------*/
+	/*	local variable declarations 								*/
+	/*--------------------------------------------------------------*/
+	int	level, num_ids, num_vars, num_found, line_num, capacity, i, v;
+	int	b, h, z, p, c;
+	int	want[5], ids[5];
+	char	line[SPEC_LINE_LEN], outname[FILEPATH_LEN];
+	char	*token, *comment, *cursor;
+	struct	spec_variable	*vars[SPEC_LINE_LEN/2];
+	struct	basin_object	*basin;
+	struct	hillslope_object	*hillslope;
+	struct	zone_object	*zone;
+	struct	patch_object	*patch;
+	struct	canopy_strata_object	*stratum;
+	FILE	*specfile;
+	struct	output_spec_object	*spec;
+
+	if ((specfile = fopen(filename, "r")) == NULL) {
+		fprintf(stderr,"FATAL ERROR: in construct_output_spec, cannot open %s\n",
+			filename);
+		exit(EXIT_FAILURE);
+	}
+	spec = (struct output_spec_object *) alloc(sizeof(struct output_spec_object),
+		"spec", "construct_output_spec");
+	spec[0].num_entries = 0;
+	spec[0].entries = NULL;
+	spec[0].outfile = NULL;
+	spec[0].columns = NULL;
+	spec[0].format = NULL;
+	spec[0].values = NULL;
+	capacity = 0;
+
+	/*--------------------------------------------------------------*/
+	/*	the header starts with the date							*/
+	/*--------------------------------------------------------------*/
+	snprintf(outname, sizeof(outname), "%s_spec.daily%s", prefix,
+		daily_columns ? ".rcol" : "");
+	if (daily_columns) {
+		spec[0].columns = construct_column_file(outname);
+		column_file_name(spec[0].columns, "day");
+		column_file_name(spec[0].columns, "month");
+		column_file_name(spec[0].columns, "year");
+	}
+	else {
+		if ((spec[0].outfile = fopen(outname, "w")) == NULL) {
+			fprintf(stderr,"FATAL ERROR: in construct_output_spec, cannot open %s\n",
+				outname);
+			exit(EXIT_FAILURE);
+		}
+		fprintf(spec[0].outfile, "day month year");
+	}
+
+	line_num = 0;
+	while (fgets(line, SPEC_LINE_LEN, specfile) != NULL) {
+		line_num++;
+		if ((strlen(line) == SPEC_LINE_LEN-1) && (line[SPEC_LINE_LEN-2] != '\n')) {
+			fprintf(stderr,"FATAL ERROR: line %d of %s is too long\n", line_num, filename);
+			exit(EXIT_FAILURE);
+		}
+		if ((comment = strchr(line, '#')) != NULL)
+			*comment = '\0';
+		if ((token = strtok(line, " \t\r\n")) == NULL)
+			continue;
+		/*--------------------------------------------------------------*/
+		/*	level, IDs and variables of the line					*/
+		/*--------------------------------------------------------------*/
+		for (level=0; level<5; level++)
+			if (strcmp(token, spec_levels[level]) == 0) break;
+		if (level == 5) {
+			fprintf(stderr,"FATAL ERROR: unknown level %s on line %d of %s\n",
+				token, line_num, filename);
+			exit(EXIT_FAILURE);
+		}
+		num_ids = level + 1;
+		for (i=0; i<num_ids; i++) {
+			if ((token = strtok(NULL, " \t\r\n")) == NULL) {
+				fprintf(stderr,"FATAL ERROR: %s needs %d IDs on line %d of %s\n",
+					spec_levels[level], num_ids, line_num, filename);
+				exit(EXIT_FAILURE);
+			}
+			want[i] = atoi(token);
+		}
+		num_vars = 0;
+		while ((token = strtok(NULL, " \t\r\n")) != NULL) {
+			for (v=0; spec_variables[v].name != NULL; v++)
+				if ((spec_variables[v].level == level)
+					&& (strcmp(spec_variables[v].name, token) == 0)) break;
+			if (spec_variables[v].name == NULL) {
+				fprintf(stderr,"FATAL ERROR: no %s variable %s (line %d of %s)\n",
+					spec_levels[level], token, line_num, filename);
+				exit(EXIT_FAILURE);
+			}
+			if (num_vars == SPEC_LINE_LEN/2) {
+				fprintf(stderr,"FATAL ERROR: too many variables on line %d of %s\n",
+					line_num, filename);
+				exit(EXIT_FAILURE);
+			}
+			vars[num_vars++] = &(spec_variables[v]);
+		}
+		if (num_vars == 0) {
+			fprintf(stderr,"FATAL ERROR: no variables on line %d of %s\n",
+				line_num, filename);
+			exit(EXIT_FAILURE);
+		}
+
+		/*--------------------------------------------------------------*/
+		/*	one entry per variable of each matching object			*/
+		/*--------------------------------------------------------------*/
+		num_found = 0;
+		for (b=0; b<world[0].num_basin_files; b++) {
+			basin = world[0].basins[b];
+			ids[SPEC_BASIN] = basin[0].ID;
+			if ((want[SPEC_BASIN] != -999) && (want[SPEC_BASIN] != ids[SPEC_BASIN]))
+				continue;
+			if (level == SPEC_BASIN) {
+				num_found++;
+				for (v=0; v<num_vars; v++) {
+					add_spec_entry(spec, &capacity, basin, vars[v]);
+					add_spec_name(spec, level, ids, vars[v]);
+				}
+				continue;
+			}
+			for (h=0; h<basin[0].num_hillslopes; h++) {
+				hillslope = basin[0].hillslopes[h];
+				ids[SPEC_HILLSLOPE] = hillslope[0].ID;
+				if ((want[SPEC_HILLSLOPE] != -999) && (want[SPEC_HILLSLOPE] != ids[SPEC_HILLSLOPE]))
+					continue;
+				if (level == SPEC_HILLSLOPE) {
+					num_found++;
+					for (v=0; v<num_vars; v++) {
+						add_spec_entry(spec, &capacity, hillslope, vars[v]);
+						add_spec_name(spec, level, ids, vars[v]);
+					}
+					continue;
+				}
+				for (z=0; z<hillslope[0].num_zones; z++) {
+					zone = hillslope[0].zones[z];
+					ids[SPEC_ZONE] = zone[0].ID;
+					if ((want[SPEC_ZONE] != -999) && (want[SPEC_ZONE] != ids[SPEC_ZONE]))
+						continue;
+					if (level == SPEC_ZONE) {
+						num_found++;
+						for (v=0; v<num_vars; v++) {
+							add_spec_entry(spec, &capacity, zone, vars[v]);
+							add_spec_name(spec, level, ids, vars[v]);
+						}
+						continue;
+					}
+					for (p=0; p<zone[0].num_patches; p++) {
+						patch = zone[0].patches[p];
+						ids[SPEC_PATCH] = patch[0].ID;
+						if ((want[SPEC_PATCH] != -999) && (want[SPEC_PATCH] != ids[SPEC_PATCH]))
+							continue;
+						if (level == SPEC_PATCH) {
+							num_found++;
+							for (v=0; v<num_vars; v++) {
+								add_spec_entry(spec, &capacity, patch, vars[v]);
+								add_spec_name(spec, level, ids, vars[v]);
+							}
+							continue;
+						}
+						for (c=0; c<patch[0].num_canopy_strata; c++) {
+							stratum = patch[0].canopy_strata[c];
+							ids[SPEC_STRATUM] = stratum[0].ID;
+							if ((want[SPEC_STRATUM] != -999) && (want[SPEC_STRATUM] != ids[SPEC_STRATUM]))
+								continue;
+							num_found++;
+							for (v=0; v<num_vars; v++) {
+								add_spec_entry(spec, &capacity, stratum, vars[v]);
+								add_spec_name(spec, level, ids, vars[v]);
+							}
+						}
+					}
+				}
+			}
+		}
+		if (num_found == 0)
+			fprintf(stderr,"WARNING: line %d of %s matches no %s\n",
+				line_num, filename, spec_levels[level]);
+	}
+	fclose(specfile);
+
+	/*--------------------------------------------------------------*/
+	/*	format and values of a record, for output_values		*/
+	/*--------------------------------------------------------------*/
+	spec[0].format = (char *) alloc(4 * spec[0].num_entries + 16,
+		"format", "construct_output_spec");
+	strcpy(spec[0].format, "%ld %ld %ld");
+	cursor = spec[0].format + strlen(spec[0].format);
+	for (i=0; i<spec[0].num_entries; i++) {
+		strcpy(cursor, (spec[0].entries[i].type == OUTPUT_SPEC_INT) ? " %d" : " %lf");
+		cursor += strlen(cursor);
+	}
+	strcpy(cursor, "\n");
+	spec[0].values = (union output_value_object *) alloc(
+		(spec[0].num_entries + 3) * sizeof(union output_value_object),
+		"values", "construct_output_spec");
+
+	if (spec[0].columns != NULL)
+		column_file_end_row(spec[0].columns);
+	else
+		fprintf(spec[0].outfile, "\n");
+	printf("\n Output specification %s: %d values per day", filename,
+		spec[0].num_entries);
+	return(spec);
+} /*end construct_output_spec*/
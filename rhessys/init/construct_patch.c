@@ -9,9 +9,10 @@
 /*																*/
 /*	SYNOPSIS													*/
 /*	struct patch_object  construct_patch( 						*/
-/*					FILE	*world_file,						*/
+/*					struct world_input_object *world_file,	*/
 /*					struct	command_line_object	*command_line,	*/
-/*					struct	default_object)						*/
+/*					struct	default_object,						*/
+/*					struct	arena_object *arena)				*/
 /* 																*/
 /*																*/
 /*	OPTIONS														*/
@@ -23,6 +24,9 @@
 /*	file to create a patch object.  Invokes construction		*/
 /*	of canopy_stratum objects.									*/
 /*																*/
+/*	The patch and the lists hanging off it come from the world	*/
+/*	arena (see arena_alloc).									*/
+/*																*/
 /*	Refer to cnostruct_basin.c for a specification of the		*/
 /*	hillslopes file.											*/
 /*																*/
@@ -39,15 +43,17 @@
 /*--------------------------------------------------------------*/
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include "rhessys.h"
 #include "phys_constants.h"
 
 struct patch_object *construct_patch(
 									 struct	command_line_object	*command_line,
-									 FILE	*world_file,
+									 struct world_input_object *world_file,
 									 int     num_world_base_stations,
 									 struct  base_station_object **world_base_stations,
-									 struct	default_object	*defaults)
+									 struct	default_object	*defaults,
+									 struct	arena_object	*arena)
 {
 	/*--------------------------------------------------------------*/
 	/*	Local function definition.									*/
@@ -58,11 +64,12 @@ struct patch_object *construct_patch(
 		struct base_station_object **);
 	struct 	canopy_strata_object *construct_canopy_strata( 
 		struct command_line_object *,
-		FILE	*,
+		struct world_input_object *,
 		struct	patch_object *,
 		int     num_world_base_stations,
 		struct  base_station_object **world_base_stations,
-		struct	default_object	*defaults);
+		struct	default_object	*defaults,
+		struct	arena_object *);
 	struct 	canopy_strata_object *construct_empty_shadow_strata( 
 		struct command_line_object *,
 		struct	patch_object *,
@@ -82,6 +89,9 @@ struct patch_object *construct_patch(
 	
 	void	sort_patch_layers(struct patch_object *);
 	void	*alloc(	size_t, char *, char *);
+	int	read_world_int(struct world_input_object *);
+	double	read_world_double(struct world_input_object *);
+	void	*arena_alloc(struct arena_object *, int, size_t, char *, char *);
 	
 	/*--------------------------------------------------------------*/
 	/*	Local variable definitions				*/
@@ -90,96 +100,79 @@ struct patch_object *construct_patch(
 	int		i;
 	int		soil_default_object_ID;
 	int		landuse_default_object_ID;
-	int		fire_default_object_ID;
-	int		surface_energy_default_object_ID;
-	char		record[MAXSTR];
+	int		fire_default_object_ID = 0;
+	int		surface_energy_default_object_ID = 0;
 	struct patch_object *patch;
 	double	mpar;
 	
 	/*--------------------------------------------------------------*/
 	/*  Allocate a patch object.                                */
 	/*--------------------------------------------------------------*/
-	patch = (struct patch_object *) alloc( 1 *
+	patch = (struct patch_object *) arena_alloc(arena, ARENA_PATCH, 1 *
 		sizeof( struct patch_object ),"patch","construct_patch");
 
   /*---------------------------------------------------------------------------------*/
   /*  Allocate a shadow_litter object, and shadow_soil object if spinup flag is set  */
   /*---------------------------------------------------------------------------------*/
  	if ( (command_line[0].vegspinup_flag > 0) ) {
-   patch[0].shadow_litter_cs = (struct litter_c_object *) alloc( 1 *
+   patch[0].shadow_litter_cs = (struct litter_c_object *) arena_alloc(arena, ARENA_LIST, 1 *
       sizeof( struct litter_c_object ),"shadow_litter_cs", "construct_patch" );
         
-   patch[0].shadow_litter_ns = (struct litter_n_object *) alloc( 1 *
+   patch[0].shadow_litter_ns = (struct litter_n_object *) arena_alloc(arena, ARENA_LIST, 1 *
       sizeof( struct litter_n_object ),"shadow_litter_ns", "construct_patch" );
     
-   patch[0].shadow_soil_cs = (struct soil_c_object *) alloc( 1 *
+   patch[0].shadow_soil_cs = (struct soil_c_object *) arena_alloc(arena, ARENA_LIST, 1 *
       sizeof( struct soil_c_object ),"shadow_soil_cs", "construct_patch" );
         
-   patch[0].shadow_soil_ns = (struct soil_n_object *) alloc( 1 *
+   patch[0].shadow_soil_ns = (struct soil_n_object *) arena_alloc(arena, ARENA_LIST, 1 *
       sizeof( struct soil_n_object ),"shadow_soil_ns", "construct_patch" );
   }
+	/*--------------------------------------------------------------*/
+	/*	simulated until held at its spinup targets (-vegspinupfreeze) */
+	/*--------------------------------------------------------------*/
+	patch[0].frozen = 0;
+	patch[0].frozen_state = NULL;
+	memset(&(patch[0].boundary_flux), 0, sizeof(struct patch_boundary_flux_object));
+	memset(&(patch[0].soil_spinup), 0, sizeof(struct soil_spinup_object));
 	
 	/*--------------------------------------------------------------*/
 	/*	Read in the next patch record for this hillslope.			*/
 	/*--------------------------------------------------------------*/
-	fscanf(world_file,"%d",&(patch[0].ID));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(patch[0].x));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(patch[0].y));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(patch[0].z));
-	read_record(world_file, record);
-	fscanf(world_file,"%d",&(soil_default_object_ID));
-	read_record(world_file, record);
-	fscanf(world_file,"%d",&(landuse_default_object_ID));
-	read_record(world_file, record);
+	patch[0].ID = read_world_int(world_file);
+	patch[0].x = read_world_double(world_file);
+	patch[0].y = read_world_double(world_file);
+	patch[0].z = read_world_double(world_file);
+	soil_default_object_ID = read_world_int(world_file);
+	landuse_default_object_ID = read_world_int(world_file);
 
 	if (command_line[0].firespread_flag == 1) {
-		fscanf(world_file,"%d",&(fire_default_object_ID));
-		read_record(world_file, record);
+		fire_default_object_ID = read_world_int(world_file);
 		}
 
 	if (command_line[0].surface_energy_flag == 1) {
-		fscanf(world_file,"%d",&(surface_energy_default_object_ID));
-		read_record(world_file, record);
+		surface_energy_default_object_ID = read_world_int(world_file);
 		}
 
-	fscanf(world_file,"%lf",&(patch[0].area));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(patch[0].slope));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(patch[0].lna));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(patch[0].Ksat_vertical));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(mpar));
-	read_record(world_file, record);
+	patch[0].area = read_world_double(world_file);
+	patch[0].slope = read_world_double(world_file);
+	patch[0].lna = read_world_double(world_file);
+	patch[0].Ksat_vertical = read_world_double(world_file);
+	mpar = read_world_double(world_file);
 	if (command_line[0].stdev_flag == 1) {
-		fscanf(world_file,"%lf",&(patch[0].std));
-		read_record(world_file, record);
+		patch[0].std = read_world_double(world_file);
 		patch[0].std = patch[0].std*command_line[0].std_scale;
 		}
 	else patch[0].std = 0.0;
-	fscanf(world_file,"%lf",&(patch[0].rz_storage));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(patch[0].unsat_storage));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(patch[0].sat_deficit));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(patch[0].snowpack.water_equivalent_depth));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(patch[0].snowpack.water_depth));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(patch[0].snowpack.T));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(patch[0].snowpack.surface_age));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(patch[0].snowpack.energy_deficit));
-	read_record(world_file, record);
+	patch[0].rz_storage = read_world_double(world_file);
+	patch[0].unsat_storage = read_world_double(world_file);
+	patch[0].sat_deficit = read_world_double(world_file);
+	patch[0].snowpack.water_equivalent_depth = read_world_double(world_file);
+	patch[0].snowpack.water_depth = read_world_double(world_file);
+	patch[0].snowpack.T = read_world_double(world_file);
+	patch[0].snowpack.surface_age = read_world_double(world_file);
+	patch[0].snowpack.energy_deficit = read_world_double(world_file);
 	if (command_line[0].snow_scale_flag == 1) {
-		fscanf(world_file,"%lf",&(patch[0].snow_redist_scale));
-		read_record(world_file, record);
+		patch[0].snow_redist_scale = read_world_double(world_file);
 		}
 
 
@@ -267,37 +260,24 @@ struct patch_object *construct_patch(
 	/*--------------------------------------------------------------*/
 	/*	Variables for the dynamic version are included here     */
 	/*--------------------------------------------------------------*/
-	fscanf(world_file,"%lf",&(patch[0].litter.cover_fraction));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(patch[0].litter.rain_stored));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(patch[0].litter_cs.litr1c));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(patch[0].litter_ns.litr1n));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(patch[0].litter_cs.litr2c));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(patch[0].litter_cs.litr3c));
-	read_record(world_file, record); 
-	fscanf(world_file,"%lf",&(patch[0].litter_cs.litr4c));
-	read_record(world_file, record);
+	patch[0].litter.cover_fraction = read_world_double(world_file);
+	patch[0].litter.rain_stored = read_world_double(world_file);
+	patch[0].litter_cs.litr1c = read_world_double(world_file);
+	patch[0].litter_ns.litr1n = read_world_double(world_file);
+	patch[0].litter_cs.litr2c = read_world_double(world_file);
+	patch[0].litter_cs.litr3c = read_world_double(world_file); 
+	patch[0].litter_cs.litr4c = read_world_double(world_file);
 	
 	patch[0].litter_ns.litr2n = patch[0].litter_cs.litr2c / CEL_CN;
 	patch[0].litter_ns.litr3n = patch[0].litter_cs.litr3c / CEL_CN;
 	patch[0].litter_ns.litr4n = patch[0].litter_cs.litr4c / LIG_CN;
 	
-	fscanf(world_file,"%lf",&(patch[0].soil_cs.soil1c));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(patch[0].soil_ns.sminn));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(patch[0].soil_ns.nitrate));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(patch[0].soil_cs.soil2c));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(patch[0].soil_cs.soil3c));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(patch[0].soil_cs.soil4c));
-	read_record(world_file, record);
+	patch[0].soil_cs.soil1c = read_world_double(world_file);
+	patch[0].soil_ns.sminn = read_world_double(world_file);
+	patch[0].soil_ns.nitrate = read_world_double(world_file);
+	patch[0].soil_cs.soil2c = read_world_double(world_file);
+	patch[0].soil_cs.soil3c = read_world_double(world_file);
+	patch[0].soil_cs.soil4c = read_world_double(world_file);
 
 
 	patch[0].soil_ns.soil1n = patch[0].soil_cs.soil1c / SOIL1_CN;
@@ -361,7 +341,7 @@ struct patch_object *construct_patch(
 	/*	Assign	defaults for this patch								*/
 	/*--------------------------------------------------------------*/
 	patch[0].soil_defaults = (struct soil_default **)
-		alloc( sizeof(struct soil_default *),"defaults",
+		arena_alloc(arena, ARENA_LIST, sizeof(struct soil_default *),"defaults",
 		"construct_patch" );
 	
 	i = 0;
@@ -381,7 +361,7 @@ struct patch_object *construct_patch(
 	patch[0].soil_defaults[0] = &defaults[0].soil[i];
 
 	patch[0].landuse_defaults = (struct landuse_default **)
-		alloc( sizeof(struct landuse_default *),"defaults",
+		arena_alloc(arena, ARENA_LIST, sizeof(struct landuse_default *),"defaults",
 		"construct_patch" );
 	i = 0;
 	while (defaults[0].landuse[i].ID != landuse_default_object_ID) {
@@ -408,7 +388,7 @@ struct patch_object *construct_patch(
 	/*--------------------------------------------------------------*/
 	if (command_line[0].firespread_flag == 1) {
 	patch[0].fire_defaults = (struct fire_default **)
-		alloc( sizeof(struct fire_default *),"defaults",
+		arena_alloc(arena, ARENA_LIST, sizeof(struct fire_default *),"defaults",
 		"construct_patch" );
 	i = 0;
 	while (defaults[0].fire[i].ID != fire_default_object_ID) {
@@ -434,11 +414,11 @@ struct patch_object *construct_patch(
 	if (command_line[0].surface_energy_flag == 1) {
 
 		patch[0].surface_energy_profile = (struct surface_energy_object *)
-		alloc(4* sizeof(struct surface_energy_object),"energy_object",
+		arena_alloc(arena, ARENA_LIST, 4* sizeof(struct surface_energy_object),"energy_object",
 		"construct_patch");
 
 		patch[0].surface_energy_defaults = (struct surface_energy_default **)
-		alloc( sizeof(struct surface_energy_default *),"defaults",
+		arena_alloc(arena, ARENA_LIST, sizeof(struct surface_energy_default *),"defaults",
 		"construct_patch" );
 		i = 0;
 	while (defaults[0].surface_energy[i].ID != surface_energy_default_object_ID) {
@@ -536,21 +516,19 @@ struct patch_object *construct_patch(
 	/*--------------------------------------------------------------*/
 	/*	Read in the number of  patch base stations 					*/
 	/*--------------------------------------------------------------*/
-	fscanf(world_file,"%d",&(patch[0].num_base_stations));
-	read_record(world_file, record);
+	patch[0].num_base_stations = read_world_int(world_file);
 	/*--------------------------------------------------------------*/
 	/*    Allocate a list of base stations for this patch.			*/
 	/*--------------------------------------------------------------*/
 	patch[0].base_stations = (struct base_station_object **)
-		alloc(patch[0].num_base_stations *
+		arena_alloc(arena, ARENA_LIST, patch[0].num_base_stations *
 		sizeof(struct base_station_object *),
 		"base_stations","construct_patch" );
 	/*--------------------------------------------------------------*/
 	/*      Read each base_station ID and then point to that base_statio*/
 	/*--------------------------------------------------------------*/
 	for (i=0 ; i<patch[0].num_base_stations; i++){
-		fscanf(world_file,"%d",&(base_stationID));
-		read_record(world_file, record);
+		base_stationID = read_world_int(world_file);
 		/*--------------------------------------------------------------*/
 		/*	Point to the appropriate base station in the base       	*/
 		/*              station list for this world.					*/
@@ -563,30 +541,26 @@ struct patch_object *construct_patch(
 	/*--------------------------------------------------------------*/
 	/*	Read in number of canopy strata objects in this patch		*/
 	/*--------------------------------------------------------------*/
-	fscanf(world_file,"%d",&(patch[0].num_canopy_strata));
-	read_record(world_file, record);
+	patch[0].num_canopy_strata = read_world_int(world_file);
 	
 	/*--------------------------------------------------------------*/
 	/*	Allocate list of pointers to stratum objects .				*/
 	/*--------------------------------------------------------------*/
 	patch[0].canopy_strata = ( struct canopy_strata_object ** )
-		alloc( patch[0].num_canopy_strata *
+		arena_alloc(arena, ARENA_LIST, patch[0].num_canopy_strata *
 		sizeof( struct canopy_strata_object *),
 		"canopy_strata","construct_patch");
  	
 		patch[0].shadow_strata = ( struct canopy_strata_object ** )
-			alloc( patch[0].num_canopy_strata * 
+			arena_alloc(arena, ARENA_LIST, patch[0].num_canopy_strata * 
 			sizeof( struct canopy_strata_object *),
 			"shadow_strata","construct_patch");
 
 	/*--------------------------------------------------------------*/
 	/*      Allocate the patch hourly object.	  */
 	/*--------------------------------------------------------------*/
-	if ((patch[0].hourly = (struct patch_hourly_object *) calloc(1,
-		sizeof(struct patch_hourly_object))) == NULL ){
-		fprintf(stderr,"FATAL ERROR: in patch_hourly\n");
-		exit(EXIT_FAILURE);
-	}
+	patch[0].hourly = (struct patch_hourly_object *) arena_alloc(arena, ARENA_LIST,
+		sizeof(struct patch_hourly_object),"hourly","construct_patch");
 	
 	/*--------------------------------------------------------------*/
 	/*      Initialize patch level rainand snow stored              */
@@ -610,7 +584,8 @@ struct patch_object *construct_patch(
 			world_file,
 			patch,
 			num_world_base_stations,
-			world_base_stations,defaults);
+			world_base_stations,defaults,
+			arena);
 		/*--------------------------------------------------------------*/
 		/*      Aggregate rain and snow stored already for water balance*/
 		/*--------------------------------------------------------------*/
@@ -683,7 +658,7 @@ struct patch_object *construct_patch(
 	/*	Define a list of canopy strata layers that can at least	*/
 	/*	fit all of the canopy strata.				*/
 	/*--------------------------------------------------------------*/
-	patch[0].layers = (struct layer_object *) alloc( patch[0].num_canopy_strata *
+	patch[0].layers = (struct layer_object *) arena_alloc(arena, ARENA_LIST, patch[0].num_canopy_strata *
 		sizeof( struct layer_object ),"layers","construct_patch");
 	patch[0].num_layers = 0;
 	sort_patch_layers(patch);
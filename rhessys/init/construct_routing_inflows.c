@@ -0,0 +1,201 @@
+/*--------------------------------------------------------------*/
+/* 																*/
+/*					construct_routing_inflows					*/
+/*																*/
+/*	construct_routing_inflows.c - builds reverse routing links	*/
+/*																*/
+/*	NAME														*/
+/*	construct_routing_inflows.c - builds reverse routing links	*/
+/*																*/
+/*	SYNOPSIS													*/
+/*	void construct_routing_inflows( 							*/
+/*				struct routing_list_object *rlist,				*/
+/*				struct command_line_object *command_line)		*/
+/*																*/
+/*	OPTIONS														*/
+/*																*/
+/*	DESCRIPTION													*/
+/*																*/
+/*	For the parallel routing option (-parallelrouting) each		*/
+/*	patch gathers its inflows instead of having upslope patches	*/
+/*	scatter into it.  This routine inverts the neighbour lists	*/
+/*	of the route list: for every patch it stores the route list	*/
+/*	index of each upslope patch that drains into it, together	*/
+/*	with the neighbour gamma and link type (subsurface, surface	*/
+/*	or road diversion to next_stream).  Links of one receiving	*/
+/*	patch are ordered by source index so that the gather is		*/
+/*	independent of the number of threads.						*/
+/*																*/
+/*	It also allocates one outflow buffer per route list patch.	*/
+/*																*/
+/*	PROGRAMMER NOTES											*/
+/*																*/
+/*	Neighbours that are not in the route list (e.g. the			*/
+/*	basin outside_region) receive no links; flow to them		*/
+/*	leaves the basin.											*/
+/*--------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include "rhessys.h"
+
+struct	route_index_object
+	{
+	struct	patch_object	*patch;
+	int	index;
+	};
+
+static int compare_route_index(const void *a, const void *b)
+{
+	const struct route_index_object *ra = a;
+	const struct route_index_object *rb = b;
+	if (ra->patch < rb->patch) return(-1);
+	if (ra->patch > rb->patch) return(1);
+	return(0);
+}
+
+static int find_route_index(struct patch_object *patch,
+							struct route_index_object *table,
+							int num_patches)
+{
+	struct route_index_object key, *found;
+	key.patch = patch;
+	found = bsearch(&key, table, num_patches,
+		sizeof(struct route_index_object), compare_route_index);
+	if (found == NULL)
+		return(-1);
+	return(found->index);
+}
+
+/*--------------------------------------------------------------*/
+/*	walk all downslope links of the route list; with inflows	*/
+/*	NULL only count the links of each receiving patch			*/
+/*--------------------------------------------------------------*/
+static void walk_routing_links(struct routing_list_object *rlist,
+							   struct command_line_object *command_line,
+							   struct route_index_object *table,
+							   int *next,
+							   struct routing_inflow_object *inflows)
+{
+	int i, j, d, r;
+	struct patch_object *patch;
+	struct innundation_object *list;
+
+	for (i = 0; i < rlist->num_patches; i++) {
+		patch = rlist->list[i];
+		/*--------------------------------------------------------------*/
+		/*	subsurface links (only the first innundation depth is	*/
+		/*	used for subsurface routing)				*/
+		/*--------------------------------------------------------------*/
+		if ((patch[0].drainage_type != STREAM) && (patch[0].innundation_list != NULL)) {
+			list = &(patch[0].innundation_list[0]);
+			for (j = 0; j < list->num_neighbours; j++) {
+				r = find_route_index(list->neighbours[j].patch, table, rlist->num_patches);
+				if (r < 0) continue;
+				if (inflows != NULL) {
+					inflows[next[r]].source = i;
+					inflows[next[r]].type = SUBSURFACE_INFLOW;
+					inflows[next[r]].d = 0;
+					inflows[next[r]].gamma = list->neighbours[j].gamma;
+				}
+				next[r]++;
+			}
+		}
+		/*--------------------------------------------------------------*/
+		/*	surface links for each innundation depth; stream	*/
+		/*	patches export all surface water to the stream		*/
+		/*--------------------------------------------------------------*/
+		if ((patch[0].drainage_type != STREAM) && (patch[0].surface_innundation_list != NULL)) {
+			for (d = 0; d < max(patch[0].num_innundation_depths, 1); d++) {
+				list = &(patch[0].surface_innundation_list[d]);
+				for (j = 0; j < list->num_neighbours; j++) {
+					r = find_route_index(list->neighbours[j].patch, table, rlist->num_patches);
+					if (r < 0) continue;
+					if (inflows != NULL) {
+						inflows[next[r]].source = i;
+						inflows[next[r]].type = SURFACE_INFLOW;
+						inflows[next[r]].d = d;
+						inflows[next[r]].gamma = list->neighbours[j].gamma;
+					}
+					next[r]++;
+				}
+			}
+		}
+		/*--------------------------------------------------------------*/
+		/*	road diversion to the next stream patch			*/
+		/*--------------------------------------------------------------*/
+		if ((patch[0].drainage_type == ROAD) && (command_line[0].road_flag == 1)
+			&& (patch[0].next_stream != NULL)) {
+			r = find_route_index(patch[0].next_stream, table, rlist->num_patches);
+			if (r >= 0) {
+				if (inflows != NULL) {
+					inflows[next[r]].source = i;
+					inflows[next[r]].type = ROAD_STREAM_INFLOW;
+					inflows[next[r]].d = 0;
+					inflows[next[r]].gamma = 1.0;
+				}
+				next[r]++;
+			}
+		}
+	}
+	return;
+}
+
+void construct_routing_inflows(struct routing_list_object *rlist,
+							   struct command_line_object *command_line)
+{
+	/*--------------------------------------------------------------*/
+	/*	Local function definition.									*/
+	/*--------------------------------------------------------------*/
+	void *alloc(size_t, char *, char *);
+
+	/*--------------------------------------------------------------*/
+	/*	Local variable definition.									*/
+	/*--------------------------------------------------------------*/
+	int i, num_patches;
+	int *next;
+	struct route_index_object *table;
+
+	num_patches = rlist->num_patches;
+	rlist->outflow = (struct patch_outflow_object *)alloc(num_patches *
+		sizeof(struct patch_outflow_object), "outflow", "construct_routing_inflows");
+	rlist->inflow_start = (int *)alloc((num_patches + 1) * sizeof(int),
+		"inflow_start", "construct_routing_inflows");
+	next = (int *)alloc((num_patches + 1) * sizeof(int),
+		"next", "construct_routing_inflows");
+
+	/*--------------------------------------------------------------*/
+	/*	sorted patch pointer -> route list index table		*/
+	/*--------------------------------------------------------------*/
+	table = (struct route_index_object *)alloc(num_patches *
+		sizeof(struct route_index_object), "table", "construct_routing_inflows");
+	for (i = 0; i < num_patches; i++) {
+		table[i].patch = rlist->list[i];
+		table[i].index = i;
+	}
+	qsort(table, num_patches, sizeof(struct route_index_object), compare_route_index);
+
+	/*--------------------------------------------------------------*/
+	/*	count links per receiving patch and set offsets		*/
+	/*--------------------------------------------------------------*/
+	walk_routing_links(rlist, command_line, table, next, NULL);
+	rlist->inflow_start[0] = 0;
+	for (i = 0; i < num_patches; i++) {
+		rlist->inflow_start[i+1] = rlist->inflow_start[i] + next[i];
+		next[i] = rlist->inflow_start[i];
+	}
+
+	/*--------------------------------------------------------------*/
+	/*	fill links; sources are visited in route list order	*/
+	/*--------------------------------------------------------------*/
+	rlist->inflows = (struct routing_inflow_object *)alloc(
+		max(rlist->inflow_start[num_patches], 1) * sizeof(struct routing_inflow_object),
+		"inflows", "construct_routing_inflows");
+	walk_routing_links(rlist, command_line, table, next, rlist->inflows);
+
+	printf("\n Parallel routing: %d patches, %d inflow links\n",
+		num_patches, rlist->inflow_start[num_patches]);
+
+	free(table);
+	free(next);
+	return;
+} /*end construct_routing_inflows.c*/
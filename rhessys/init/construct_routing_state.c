@@ -0,0 +1,126 @@
+/*--------------------------------------------------------------*/
+/* 																*/
+/*					construct_routing_state						*/
+/*																*/
+/*	construct_routing_state.c - route list flux arrays			*/
+/*																*/
+/*	NAME														*/
+/*	construct_routing_state.c - route list flux arrays			*/
+/*																*/
+/*	SYNOPSIS													*/
+/*	void construct_routing_state( 								*/
+/*				struct basin_object *basin)						*/
+/*																*/
+/*	OPTIONS														*/
+/*																*/
+/*	DESCRIPTION													*/
+/*																*/
+/*	Allocates the routing state of the basin route list: the	*/
+/*	subsurface water and N/DOC exchange fluxes (Qin, Qout and	*/
+/*	their solute equivalents) and the patch area, one array		*/
+/*	per variable indexed by route list position.  Routing		*/
+/*	scatters into the downslope neighbours of every patch; with	*/
+/*	the fluxes in contiguous arrays those writes no longer		*/
+/*	touch a different (large) patch object per neighbour.		*/
+/*																*/
+/*	Sets patch[0].route_index to the list position of each		*/
+/*	route list patch and copies it into the neighbour entries	*/
+/*	of the innundation lists.									*/
+/*																*/
+/*	PROGRAMMER NOTES											*/
+/*																*/
+/*	every array has num_patches+1 entries; the last one is a	*/
+/*	sink given to patches that are not in the route list (the	*/
+/*	basin outside_region) so flow to them can be written		*/
+/*	without a test.  The sink is never read.					*/
+/*--------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include "rhessys.h"
+
+static void index_neighbours(struct innundation_object *list, int num_depths)
+{
+	int d, j;
+
+	if (list == NULL)
+		return;
+	for (d = 0; d < num_depths; d++)
+		for (j = 0; j < list[d].num_neighbours; j++)
+			list[d].neighbours[j].route_index =
+				list[d].neighbours[j].patch[0].route_index;
+	return;
+}
+
+void construct_routing_state(struct basin_object *basin)
+{
+	/*--------------------------------------------------------------*/
+	/*	Local function definition.									*/
+	/*--------------------------------------------------------------*/
+	void *alloc(size_t, char *, char *);
+
+	/*--------------------------------------------------------------*/
+	/*	Local variable definition.									*/
+	/*--------------------------------------------------------------*/
+	int h, z, p, i, n;
+	struct patch_object *patch;
+	struct routing_list_object *rlist;
+	struct routing_state_object *state;
+
+	rlist = basin[0].route_list;
+	n = rlist->num_patches;
+
+	/*--------------------------------------------------------------*/
+	/*	all patches start on the sink, then list patches get their	*/
+	/*	position													*/
+	/*--------------------------------------------------------------*/
+	for (h = 0; h < basin[0].num_hillslopes; h++)
+		for (z = 0; z < basin[0].hillslopes[h][0].num_zones; z++)
+			for (p = 0; p < basin[0].hillslopes[h][0].zones[z][0].num_patches; p++)
+				basin[0].hillslopes[h][0].zones[z][0].patches[p][0].route_index = n;
+	if (basin[0].outside_region != NULL)
+		basin[0].outside_region[0].route_index = n;
+	for (i = 0; i < n; i++)
+		rlist->list[i][0].route_index = i;
+
+	for (i = 0; i < n; i++) {
+		patch = rlist->list[i];
+		index_neighbours(patch[0].innundation_list,
+			max(patch[0].num_innundation_depths, 1));
+		if (patch[0].surface_innundation_list != patch[0].innundation_list)
+			index_neighbours(patch[0].surface_innundation_list,
+				max(patch[0].num_innundation_depths, 1));
+	}
+
+	/*--------------------------------------------------------------*/
+	/*	flux arrays													*/
+	/*--------------------------------------------------------------*/
+	state = (struct routing_state_object *)alloc(1 *
+		sizeof(struct routing_state_object), "state", "construct_routing_state");
+	state->Qin = (double *)alloc((n+1) * sizeof(double), "Qin", "construct_routing_state");
+	state->Qout = (double *)alloc((n+1) * sizeof(double), "Qout", "construct_routing_state");
+	state->NO3_Qin = (double *)alloc((n+1) * sizeof(double), "NO3_Qin", "construct_routing_state");
+	state->NO3_Qout = (double *)alloc((n+1) * sizeof(double), "NO3_Qout", "construct_routing_state");
+	state->NH4_Qin = (double *)alloc((n+1) * sizeof(double), "NH4_Qin", "construct_routing_state");
+	state->NH4_Qout = (double *)alloc((n+1) * sizeof(double), "NH4_Qout", "construct_routing_state");
+	state->DON_Qin = (double *)alloc((n+1) * sizeof(double), "DON_Qin", "construct_routing_state");
+	state->DON_Qout = (double *)alloc((n+1) * sizeof(double), "DON_Qout", "construct_routing_state");
+	state->DOC_Qin = (double *)alloc((n+1) * sizeof(double), "DOC_Qin", "construct_routing_state");
+	state->DOC_Qout = (double *)alloc((n+1) * sizeof(double), "DOC_Qout", "construct_routing_state");
+	state->area = (double *)alloc((n+1) * sizeof(double), "area", "construct_routing_state");
+	for (i = 0; i <= n; i++) {
+		state->Qin[i] = 0.0;
+		state->Qout[i] = 0.0;
+		state->NO3_Qin[i] = 0.0;
+		state->NO3_Qout[i] = 0.0;
+		state->NH4_Qin[i] = 0.0;
+		state->NH4_Qout[i] = 0.0;
+		state->DON_Qin[i] = 0.0;
+		state->DON_Qout[i] = 0.0;
+		state->DOC_Qin[i] = 0.0;
+		state->DOC_Qout[i] = 0.0;
+		state->area[i] = (i < n) ? rlist->list[i][0].area : 1.0;
+	}
+
+	rlist->state = state;
+	return;
+} /*end construct_routing_state.c*/
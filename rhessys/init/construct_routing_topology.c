@@ -51,7 +51,7 @@ struct routing_list_object *construct_routing_topology(char *routing_filename,
 	
 	void *alloc(size_t, char *, char *);
 
-	double * compute_transmissivity_curve( double, struct patch_object *, struct command_line_object *);
+	void compute_transmissivity_curve( double, struct patch_object *, struct command_line_object *);
 	
 	/*--------------------------------------------------------------*/
 	/*	Local variable definition.									*/
@@ -190,7 +190,7 @@ struct routing_list_object *construct_routing_topology(char *routing_filename,
 				patch[0].num_soil_intervals = MAX_NUM_INTERVAL;
 				patch[0].soil_defaults[0][0].interval_size = patch[0].soil_defaults[0][0].soil_water_cap / MAX_NUM_INTERVAL;
 				}
-			patch[0].transmissivity_profile = compute_transmissivity_curve(gamma, patch, command_line);
+			compute_transmissivity_curve(gamma, patch, command_line);
 			}
 
 
@@ -48,7 +48,6 @@ struct soil_default *construct_soil_defaults(
 		char	*,
 		char	*);
 	
-	double compute_delta_water(int, double, double,	double, double, double);
 	int	parse_albedo_flag( char *);
 	
 	/*--------------------------------------------------------------*/
@@ -91,7 +90,7 @@ struct soil_default *construct_soil_defaults(
 		printf("Reading %s\n", default_files[i]);
                 paramCnt = 0;
                 if (paramPtr != NULL)
-                    free(paramPtr);
+                    freeParams(paramPtr);
 
                 paramPtr = readParamFile(&paramCnt, default_files[i]);
 
@@ -160,7 +159,6 @@ struct soil_default *construct_soil_defaults(
 		} /*end if*/
 		if (command_line[0].gw_flag > 0) {
 			default_object_list[i].sat_to_gw_coeff = getDoubleParam(&paramCnt, &paramPtr, "sat_to_gw_coeff", "%lf", 1.0, 1);
-			default_object_list[i].sat_to_gw_coeff *= command_line[0].sat_to_gw_coeff_mult;
 			}
 
 		/*-----------------------------------------------------------------------------
@@ -180,35 +178,6 @@ struct soil_default *construct_soil_defaults(
 			default_object_list[i].Ksat_0_v = default_object_list[i].Ksat_0;
 
 
-		/*--------------------------------------------------------------*/
-		/* sensitivity adjustment of vertical drainage  soil paramters	*/
-		/*--------------------------------------------------------------*/
-		if (command_line[0].vsen_flag > 0) {
-				default_object_list[i].m_v *= command_line[0].vsen[M];
-				default_object_list[i].mz_v *= command_line[0].vsen[M];
-				default_object_list[i].Ksat_0_v *= command_line[0].vsen[K];
-		}
-
-		/*--------------------------------------------------------------*/
-		/* sensitivity adjustment of soil drainage paramters		*/
-		/*--------------------------------------------------------------*/
-		if (command_line[0].sen_flag > 0) {
-				default_object_list[i].m *= command_line[0].sen[M];
-				default_object_list[i].m_z *= command_line[0].sen[M];
-				default_object_list[i].Ksat_0 *= command_line[0].sen[K];
-				default_object_list[i].soil_depth *= command_line[0].sen[SOIL_DEPTH];
-		}
-
-		/*--------------------------------------------------------------*/
-		/*      calculate water_equivalent depth of soil                */
-		/*--------------------------------------------------------------*/
-		default_object_list[i].soil_water_cap = compute_delta_water(
-			0, default_object_list[i].porosity_0,
-			default_object_list[i].porosity_decay,
-			default_object_list[i].soil_depth,
-			default_object_list[i].soil_depth,
-			0.0);
-
 		/*--------------------------------------------------------------*/
 		/* initialization of optional default file parms		*/
 		/*--------------------------------------------------------------*/
@@ -225,26 +194,6 @@ struct soil_default *construct_soil_defaults(
 		default_object_list[i].DON_adsorption_rate = 	getDoubleParam(&paramCnt, &paramPtr, "DON_adsorption_rate", "%lf", 0.000001, 1);
 		default_object_list[i].interval_size = 		getDoubleParam(&paramCnt, &paramPtr, "interval_size", "%lf", INTERVAL_SIZE, 1);
 
-		/*--------------------------------------------------------------*/
-		/* sensitivity adjustment of vertical drainage  soil paramters	*/
-		/* an  scale Pore size index and psi air entry or other parameters	*/
-		/* that control moisture retention (if curve 3 is used)		*/
-		/*--------------------------------------------------------------*/
-		if (command_line[0].vsen_alt_flag > 0) {
-			if (default_object_list[i].theta_psi_curve != 3)  {
-				default_object_list[i].psi_air_entry *= command_line[0].vsen_alt[PA];
-				default_object_list[i].pore_size_index *= command_line[0].vsen_alt[PO];
-				if (default_object_list[i].pore_size_index >= 1.0) {
-					printf("\n Sensitivity analysis giving Pore Size Index > 1.0, not allowed, setting to 1.0\n");
-					default_object_list[i].pore_size_index = 0.999;
-					}
-			}
-			else {
-				default_object_list[i].p3 *= command_line[0].vsen_alt[PA];
-				default_object_list[i].p4 *= command_line[0].vsen_alt[PO];
-			}
-		}
-		
 		/*--------------------------------------------------------------*/
 		/*		Close the ith default file.								*/
 		/*--------------------------------------------------------------*/
@@ -300,6 +249,6 @@ struct soil_default *construct_soil_defaults(
 
 
 	if (paramPtr != NULL)
-            free(paramPtr);
+            freeParams(paramPtr);
   return(default_object_list);
 } /*end construct_soil_defaults*/
@@ -71,7 +71,7 @@ struct spinup_default *construct_spinup_defaults(
                 printf("\nReading %s\n", default_files[i]);
                 paramCnt = 0;
                 if (paramPtr != NULL)
-                    free(paramPtr);
+                    freeParams(paramPtr);
 
                 paramPtr = readParamFile(&paramCnt, default_files[i]);
 
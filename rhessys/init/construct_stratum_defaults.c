@@ -86,7 +86,7 @@ struct stratum_default *construct_stratum_defaults(
 		printf("Reading %s\n", default_files[i]);
                 paramCnt = 0;
                 if (paramPtr != NULL)
-                    free(paramPtr);
+                    freeParams(paramPtr);
 
                 paramPtr = readParamFile(&paramCnt, default_files[i]);
 		/*--------------------------------------------------------------*/
@@ -353,15 +353,6 @@ struct stratum_default *construct_stratum_defaults(
 		/*--------------------------------------------------------------*/
 		default_object_list[i].epc.shade_sla_mult = 1.0;
 
-		/*--------------------------------------------------------------*/
-		/*	Apply sensitivity analysis if appropriate		*/
-		/*--------------------------------------------------------------*/
-		
-		if (command_line[0].vgsen_flag == 1) {
-			default_object_list[i].epc.proj_sla *= command_line[0].veg_sen1;
-			default_object_list[i].epc.shade_sla_mult *= command_line[0].veg_sen2;
-		}
-
 		/*--------------------------------------------------------------*/
 		/*		Close the ith default file.								*/
 		/*--------------------------------------------------------------*/
@@ -414,7 +405,7 @@ struct stratum_default *construct_stratum_defaults(
 	} /*end for*/
 
                 if (paramPtr != NULL)
-                    free(paramPtr);
+                    freeParams(paramPtr);
 		    
 	return(default_object_list);
 } /*end construct_stratum_defaults*/
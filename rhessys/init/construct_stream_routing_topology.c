@@ -26,12 +26,75 @@
 /*																*/
 /*	PROGRAMMER NOTES											*/
 /*																*/
+/*	reach IDs are resolved through a sorted reach index map		*/
+/*	and each reach gets the list of reach indices that drain	*/
+/*	into it.  Reaches are also grouped into levels by their		*/
+/*	(longest) distance to the outlet; reaches of one level do	*/
+/*	not exchange water so compute_stream_routing solves them		*/
+/*	in parallel, level by level from the headwaters down.		*/
 /*--------------------------------------------------------------*/
 #include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
 #include "rhessys.h"
 
+struct	reach_index_object
+	{
+	int	reach_ID;
+	int	index;
+	};
+
+static int compare_reach_index(const void *a, const void *b)
+{
+	const struct reach_index_object *ra = a;
+	const struct reach_index_object *rb = b;
+	if (ra->reach_ID != rb->reach_ID)
+		return((ra->reach_ID < rb->reach_ID) ? -1 : 1);
+	return((ra->index < rb->index) ? -1 : (ra->index > rb->index));
+}
+
+/*--------------------------------------------------------------*/
+/*	sorted reach_ID -> index map of a stream network		*/
+/*--------------------------------------------------------------*/
+static struct reach_index_object *build_reach_index(
+		struct stream_network_object *network, int num_reaches)
+{
+	void *alloc(size_t, char *, char *);
+	int i;
+	struct reach_index_object *map;
+
+	map = (struct reach_index_object *)alloc(max(num_reaches, 1) *
+		sizeof(struct reach_index_object), "reach_index",
+		"construct_stream_routing_topology");
+	for (i = 0; i < num_reaches; i++) {
+		map[i].reach_ID = network[i].reach_ID;
+		map[i].index = i;
+	}
+	qsort(map, num_reaches, sizeof(struct reach_index_object), compare_reach_index);
+	return(map);
+}
+
+/*--------------------------------------------------------------*/
+/*	first (lowest) index with this reach_ID, -1 if none		*/
+/*--------------------------------------------------------------*/
+static int find_reach_index(int reach_ID, struct reach_index_object *map,
+		int num_reaches)
+{
+	int lo, hi, mid;
+	lo = 0;
+	hi = num_reaches;
+	while (lo < hi) {
+		mid = (lo + hi) / 2;
+		if (map[mid].reach_ID < reach_ID)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	if ((lo < num_reaches) && (map[lo].reach_ID == reach_ID))
+		return(map[lo].index);
+	return(-1);
+}
+
 struct stream_list_object construct_stream_routing_topology(
 					  		  char *stream_filename,
 							  struct basin_object *basin,
@@ -68,6 +131,7 @@ struct stream_list_object construct_stream_routing_topology(
 	/*      Local variable definition.                                                                      */
 	/*--------------------------------------------------------------*/
 	int i, j, num_reaches,m,k,num_reservoir,reach_ID,reservoir_ID,flag_min_flow_storage;
+	int l, *level;
 	int hillID, patchID, zoneID;
 	int neighbour_hill_num,neighbour_hill_count_0,neighbour_hill_count_1;    
 	double month_max_storage[12],min_storage, min_outflow;
@@ -78,6 +142,7 @@ struct stream_list_object construct_stream_routing_topology(
 	struct stream_network_object *stream_network;
     struct stream_network_object *stream_network_ini;
 	struct hillslope_object *hillslope;
+	struct reach_index_object *reach_index;
 	
 	
 	
@@ -205,19 +270,94 @@ struct stream_list_object construct_stream_routing_topology(
 	/*   code to sort the stream_network from upstream to downstream */
 	/*--------------------------------------------------------------*/
 	
+	reach_index = build_reach_index(stream_network_ini, num_reaches);
 	m=num_reaches-2;
 	for(i=num_reaches-1;i>=0;--i){
 		for (j=0; j< stream_network[i].num_upstream_neighbours; ++j) {
-			for(k=0; k< num_reaches; ++k){
-				
-				if(stream_network[i].upstream_neighbours[j]==stream_network_ini[k].reach_ID){
-					stream_network[m]=stream_network_ini[k];
-					m=m-1;
-					break;
-				}
+			k = find_reach_index(stream_network[i].upstream_neighbours[j],
+				reach_index, num_reaches);
+			if (k >= 0) {
+				stream_network[m]=stream_network_ini[k];
+				m=m-1;
 			}
 		} 
 	}
+	free(reach_index);
+
+	/*--------------------------------------------------------------*/
+	/*   upstream reach lists of the sorted network; water only	*/
+	/*   moves to reaches further down the list			*/
+	/*--------------------------------------------------------------*/
+	reach_index = build_reach_index(stream_network, num_reaches);
+	for (i=0; i< num_reaches; ++i)
+		stream_network[i].num_upstream_reaches = 0;
+	for (i=0; i< num_reaches; ++i) {
+		for (j=0; j< stream_network[i].num_downstream_neighbours; ++j) {
+			k = find_reach_index(stream_network[i].downstream_neighbours[j],
+				reach_index, num_reaches);
+			if (k > i)
+				stream_network[k].num_upstream_reaches += 1;
+		}
+	}
+	for (i=0; i< num_reaches; ++i) {
+		stream_network[i].upstream_reaches = (int *)alloc(
+			max(stream_network[i].num_upstream_reaches, 1) * sizeof(int),
+			"upstream_reaches", "construct_stream_routing_topology");
+		stream_network[i].num_upstream_reaches = 0;
+	}
+	for (i=0; i< num_reaches; ++i) {
+		for (j=0; j< stream_network[i].num_downstream_neighbours; ++j) {
+			k = find_reach_index(stream_network[i].downstream_neighbours[j],
+				reach_index, num_reaches);
+			if (k > i) {
+				stream_network[k].upstream_reaches[stream_network[k].num_upstream_reaches] = i;
+				stream_network[k].num_upstream_reaches += 1;
+			}
+		}
+	}
+
+	/*--------------------------------------------------------------*/
+	/*   level of each reach = longest path (in reaches) to the	*/
+	/*   outlet; downstream reaches always have a lower level	*/
+	/*--------------------------------------------------------------*/
+	level = (int *)alloc(max(num_reaches, 1) * sizeof(int), "level",
+		"construct_stream_routing_topology");
+	stream_list.num_levels = 0;
+	for (i=num_reaches-1; i>=0; --i) {
+		level[i] = 0;
+		for (j=0; j< stream_network[i].num_downstream_neighbours; ++j) {
+			k = find_reach_index(stream_network[i].downstream_neighbours[j],
+				reach_index, num_reaches);
+			if ((k > i) && (level[k] + 1 > level[i]))
+				level[i] = level[k] + 1;
+		}
+		if (level[i] + 1 > stream_list.num_levels)
+			stream_list.num_levels = level[i] + 1;
+	}
+	free(reach_index);
+
+	/*--------------------------------------------------------------*/
+	/*   group reaches by level, headwater levels first		*/
+	/*--------------------------------------------------------------*/
+	stream_list.level_start = (int *)alloc((stream_list.num_levels + 1) * sizeof(int),
+		"level_start", "construct_stream_routing_topology");
+	stream_list.level_reaches = (int *)alloc(max(num_reaches, 1) * sizeof(int),
+		"level_reaches", "construct_stream_routing_topology");
+	for (i=0; i< num_reaches; ++i)
+		stream_list.level_start[stream_list.num_levels - level[i]] += 1;
+	for (l=0; l< stream_list.num_levels; ++l)
+		stream_list.level_start[l+1] += stream_list.level_start[l];
+	for (i=0; i< num_reaches; ++i) {
+		l = stream_list.num_levels - 1 - level[i];
+		stream_list.level_reaches[stream_list.level_start[l]] = i;
+		stream_list.level_start[l] += 1;
+	}
+	for (l=stream_list.num_levels; l > 0; --l)
+		stream_list.level_start[l] = stream_list.level_start[l-1];
+	stream_list.level_start[0] = 0;
+	free(level);
+	printf("\n Stream routing: %d reaches in %d levels\n",
+		num_reaches, stream_list.num_levels);
 		
         /*--------------------------------------------------------------*/
         /*   code to construct reservoir                                */
@@ -72,7 +72,7 @@ struct surface_energy_default *construct_surface_energy_defaults(
                 paramCnt = 0;
                 printf("Reading %s\n", default_files[i]);
                 if (paramPtr != NULL)
-                    free(paramPtr);
+                    freeParams(paramPtr);
 
                 paramPtr = readParamFile(&paramCnt, default_files[i]);
 
@@ -132,8 +132,12 @@ struct tec_object	*construct_tec(
 		command);
 	/*--------------------------------------------------------------*/
 	/*	Assume that the earliest date possible is the startdate.	*/
+	/*	A restarted run starts at its checkpoint, and the entries	*/
+	/*	before it are skipped by restore_checkpoint.				*/
 	/*--------------------------------------------------------------*/
 	old_date = world[0].start_date;
+	if ((command_line[0].restart_flag == 1) && (check == 5))
+		old_date = current_date;
 	/*--------------------------------------------------------------*/
 	/*	Read every line until end of file or an error.				*/
 	/*--------------------------------------------------------------*/
@@ -191,7 +195,8 @@ struct tec_object	*construct_tec(
 			(strcmp(command,"redefine_world_thin_snags") != 0) &&			
 			(strcmp(command,"roads_on") != 0) &&
 			(strcmp(command,"roads_off") != 0) &&
-			(strcmp(command,"output_current_state") != 0)  ){
+			(strcmp(command,"output_current_state") != 0) &&
+			(strcmp(command,"output_checkpoint") != 0)  ){
 			fprintf(stderr,
 				"\nFATAL ERROR: in construct_tec bad command %s for date %d %d %d %d\n ",
 				command, current_date.year,
@@ -361,24 +361,36 @@ struct world_object *construct_world(struct command_line_object *command_line){
 	struct surface_energy_default *construct_surface_energy_defaults(int, char **, struct command_line_object *);
 	struct spinup_default *construct_spinup_defaults(int, char **, struct command_line_object *); 
 	struct base_station_object *construct_base_station(char *,
-		struct date, struct date, int);
-	struct basin_object *construct_basin(struct command_line_object *, FILE *, int *, 
+		struct date, struct date, int, int, struct clim_window_object *);
+	struct clim_window_object *construct_clim_window(long, long);
+	struct basin_object *construct_basin(struct command_line_object *, struct world_input_object *, int *, 
 		struct base_station_object **, struct default_object *, 
         struct base_station_ncheader_object *,
         struct world_object *);
 	struct fire_patch_object **construct_patch_fire_grid(struct world_object *, struct command_line_object *,struct fire_default def);
 	struct fire_object **construct_fire_grid(struct world_object *);
-	struct base_station_object **construct_ascii_grid(char *, struct date, struct date);
+	struct base_station_object **construct_ascii_grid(char *, struct date, struct date, struct clim_window_object *);
 	struct base_station_ncheader_object *construct_netcdf_header(struct world_object *, char *);
 	struct base_station_object *construct_netcdf_grid(struct base_station_object *, struct base_station_ncheader *, int *, float, float, float, struct date *, struct date *, struct command_line_object *);
+	struct base_station_index_object *construct_base_station_index(int, struct base_station_object **, struct base_station_ncheader_object *);
+	void construct_netcdf_grid_clim(struct base_station_object **, int, struct base_station_ncheader_object *, struct date *, struct date *, struct command_line_object *, struct clim_window_object *);
   void *construct_spinup_thresholds(char *, struct world_object *, struct command_line_object *);	
 	void *alloc(size_t, char *, char *);
+	void output_arena_report(struct arena_object *);
+	struct world_input_object *open_world_input(char *);
+	int read_world_int(struct world_input_object *);
+	void close_world_input(struct world_input_object *);
+	void apply_default_sensitivity(struct default_object *, struct command_line_object *);
+	void run_ensemble(struct world_object *, struct world_input_object *,
+		struct command_line_object *);
+	struct objective_object *construct_objective(struct world_object *,
+		struct command_line_object *);
 
 	void resemble_hourly_date(struct world_object *);
 	/*--------------------------------------------------------------*/
 	/*	Local variable definition.									*/
 	/*--------------------------------------------------------------*/
-	FILE	*world_file;
+	struct	world_input_object	*world_file;
 	FILE	*header_file;
 	int 	header_file_flag = 0;
 	int		legacy_worldfile = 0;
@@ -391,9 +403,14 @@ struct world_object *construct_world(struct command_line_object *command_line){
 	world = (struct world_object *) alloc(1 * sizeof(struct world_object),
 		"world", "construct_world");
 	/*--------------------------------------------------------------*/
-	/*	Try to open the world file in read mode.					*/
+	/*	hourly scratch, reset in place by world_hourly				*/
 	/*--------------------------------------------------------------*/
-	if ( (world_file = fopen(command_line[0].world_filename,"r")) == NULL ){
+	world[0].hourly = (struct world_hourly_object *) alloc(
+		sizeof(struct world_hourly_object), "hourly", "construct_world");
+	/*--------------------------------------------------------------*/
+	/*	Try to open the world file in read mode (text or binary).	*/
+	/*--------------------------------------------------------------*/
+	if ( (world_file = open_world_input(command_line[0].world_filename)) == NULL ){
 		fprintf(stderr,"FATAL ERROR:  Cannot open world file %s\n",
 			command_line[0].world_filename);
 		exit(EXIT_FAILURE);
@@ -435,7 +452,12 @@ struct world_object *construct_world(struct command_line_object *command_line){
 			printf("\nFound world file header %s\n", command_line->world_header_filename);
 		} else {
 			// Option 3. From legacy world file (deprecated)
-			header_file = world_file;
+			if ( world_file[0].file == NULL ) {
+				fprintf(stderr,"FATAL ERROR:  Binary world file %s needs a header file (%s or -whdr)\n",
+						command_line->world_filename, command_line->world_header_filename);
+				exit(EXIT_FAILURE);
+			}
+			header_file = world_file[0].file;
 			legacy_worldfile = 1;
 			printf("\nWARNING\nReading world file header from legacy world file.\nThis feature will be removed from a future release.\nPlease re-run g2w to generate a separate world file header.\nWARNING\n\n");
 		}
@@ -450,25 +472,25 @@ struct world_object *construct_world(struct command_line_object *command_line){
 		/*--------------------------------------------------------------*/
 		/*	Read in the start calendar date (year, month, day, hour )	*/
 		/*--------------------------------------------------------------*/
-		fscanf( world_file , "%ld", &world[0].start_date.year);
-		read_record(world_file, record);
-		fscanf( world_file , "%ld", &world[0].start_date.month);
-		read_record(world_file, record);
-		fscanf( world_file , "%ld", &world[0].start_date.day);
-		read_record(world_file, record);
-		fscanf( world_file , "%ld", &world[0].start_date.hour);
-		read_record(world_file, record);
+		fscanf( header_file , "%ld", &world[0].start_date.year);
+		read_record(header_file, record);
+		fscanf( header_file , "%ld", &world[0].start_date.month);
+		read_record(header_file, record);
+		fscanf( header_file , "%ld", &world[0].start_date.day);
+		read_record(header_file, record);
+		fscanf( header_file , "%ld", &world[0].start_date.hour);
+		read_record(header_file, record);
 		/*--------------------------------------------------------------*/
 		/*	Read in the end calendar date (year, month, day, hour )	*/
 		/*--------------------------------------------------------------*/
-		fscanf( world_file , "%ld", &world[0].end_date.year);
-		read_record(world_file, record);
-		fscanf( world_file , "%ld", &world[0].end_date.month);
-		read_record(world_file, record);
-		fscanf( world_file , "%ld", &world[0].end_date.day);
-		read_record(world_file, record);
-		fscanf( world_file , "%ld", &world[0].end_date.hour);
-		read_record(world_file, record);
+		fscanf( header_file , "%ld", &world[0].end_date.year);
+		read_record(header_file, record);
+		fscanf( header_file , "%ld", &world[0].end_date.month);
+		read_record(header_file, record);
+		fscanf( header_file , "%ld", &world[0].end_date.day);
+		read_record(header_file, record);
+		fscanf( header_file , "%ld", &world[0].end_date.hour);
+		read_record(header_file, record);
 	}
 	
 	/*--------------------------------------------------------------
@@ -751,12 +773,24 @@ struct world_object *construct_world(struct command_line_object *command_line){
 			world[0].spinup_default_files, command_line);
 	}
 
+	/*--------------------------------------------------------------*/
+	/*	Scale the defaults by the sensitivity multipliers (each	*/
+	/*	ensemble member does so with its own, see run_ensemble).	*/
+	/*--------------------------------------------------------------*/
+	if (command_line[0].ensemble_flag == 0)
+		apply_default_sensitivity(world[0].defaults, command_line);
 
 	/*--------------------------------------------------------------*/
 	/*	Construct the list of base stations.			*/
 	/*--------------------------------------------------------------*/
 
+	world[0].base_station_index = NULL;
+	world[0].clim_window = NULL;
 	if (command_line[0].dclim_flag == 0) {
+		if (command_line[0].clim_window_days > 0)
+			world[0].clim_window = construct_clim_window(
+				command_line[0].clim_window_days,
+				world[0].duration.day);
 		/*--------------------------------------------------------------*/
 		/*	Construct the base_stations.				*/
 		/*--------------------------------------------------------------*/
@@ -764,7 +798,8 @@ struct world_object *construct_world(struct command_line_object *command_line){
 			printf("\nConstructing base stations from ASCII GRID");
 			world[0].base_stations = construct_ascii_grid( world[0].base_station_files[0],
 												world[0].start_date, 
-												world[0].duration);
+												world[0].duration,
+												world[0].clim_window);
 		}
 		else if(command_line[0].gridded_netcdf_flag == 1){
 			printf("\nConstructing base stations from NETCDF GRID");
@@ -808,7 +843,18 @@ struct world_object *construct_world(struct command_line_object *command_line){
 
                 //printf("new station %d ID:%d\n", i, world[0].base_stations[i][0].ID ); 
             }
+            construct_netcdf_grid_clim(world[0].base_stations,
+                                       world[0].num_base_stations,
+                                       world[0].base_station_ncheader,
+                                       &world[0].start_date,
+                                       &world[0].duration,
+                                       command_line,
+                                       world[0].clim_window);
             #endif
+            world[0].base_station_index = construct_base_station_index(
+                                                world[0].num_base_stations,
+                                                world[0].base_stations,
+                                                world[0].base_station_ncheader);
 			/*printf("\n  file=%s firstID=%d num=%d numfiles=%d lai=%lf screenht=%lf sdist=%lf startyr=%d dayoffset=%d leapyr=%d precipmult=%lf",
 				   world[0].base_station_ncheader[0].netcdf_tmax_filename,
 				   world[0].ID,
@@ -828,12 +874,13 @@ struct world_object *construct_world(struct command_line_object *command_line){
 			alloc(world[0].num_base_stations *
 				  sizeof(struct base_station_object *),"base_stations","construct_world" );
 			
-			
 			for (i=0; i<world[0].num_base_stations; i++ ) {
 				world[0].base_stations[i] = construct_base_station(
 								world[0].base_station_files[i],
 								world[0].start_date, world[0].duration,
-								command_line[0].clim_repeat_flag);
+								command_line[0].clim_repeat_flag,
+								command_line[0].clim_cache_flag,
+								world[0].clim_window);
 			} /*end for*/
 
 			/*--------------------------------------------------------------*/
@@ -846,23 +893,25 @@ struct world_object *construct_world(struct command_line_object *command_line){
 
 		}
 	} /*end if dclim_flag*/
-	
-        
+
+	/*--------------------------------------------------------------*/
+	/*	An ensemble forks its members here; only they return.	*/
+	/*--------------------------------------------------------------*/
+	if (command_line[0].ensemble_flag == 1)
+		run_ensemble(world, world_file, command_line);
 
 	/*--------------------------------------------------------------*/
 	/*	Read in the world ID.							*/
 	/*--------------------------------------------------------------*/
 
 	printf("\n Finished constructing base stations\n");
-	fscanf(world_file,"%d",&(world[0].ID));
-	read_record(world_file, record);
+	world[0].ID = read_world_int(world_file);
 
 	printf("\n Constructing world %d\n", world[0].ID);
 	/*--------------------------------------------------------------*/
 	/*	Read in the number of basin	files.							*/
 	/*--------------------------------------------------------------*/
-	fscanf(world_file,"%d",&(world[0].num_basin_files));
-	read_record(world_file, record);
+	world[0].num_basin_files = read_world_int(world_file);
 
 	printf("\n Constructing basins\n");
 	/*--------------------------------------------------------------*/
@@ -885,6 +934,21 @@ struct world_object *construct_world(struct command_line_object *command_line){
             world);
 	} /*end for*/
 	printf("\n After for loop\n");  //XXX
+	if (world[0].base_station_index != NULL)
+		printf("\n Assigned base stations to %ld zones in %.3f s (index of %d stations built in %.3f s)\n",
+			world[0].base_station_index[0].num_assigned,
+			world[0].base_station_index[0].assign_seconds,
+			world[0].base_station_index[0].num_stations,
+			world[0].base_station_index[0].build_seconds);
+
+	/*--------------------------------------------------------------*/
+	/*	Order in which basins are handed to threads; updated	*/
+	/*	daily with the -basinparallel option				*/
+	/*--------------------------------------------------------------*/
+	world[0].basin_order = (int *)alloc(max(world[0].num_basin_files, 1) *
+		sizeof(int), "basin_order", "construct_world");
+	for (i=0; i<world[0].num_basin_files; i++ )
+		world[0].basin_order[i] = i;
 
 	/*--------------------------------------------------------------*/
 	/*	If spinup flag is set construct the spinup thresholds object*/
@@ -906,12 +970,19 @@ struct world_object *construct_world(struct command_line_object *command_line){
 
 	}	
 	/*--------------------------------------------------------------*/
+	/*	Read the observed streamflow (-objective).		*/
+	/*--------------------------------------------------------------*/
+	world[0].objective = NULL;
+	if (command_line[0].objective_flag == 1)
+		world[0].objective = construct_objective(world, command_line);
+	/*--------------------------------------------------------------*/
 	/*	Close the world_file and header (if necessary)	         	*/
 	/*--------------------------------------------------------------*/
-	if ( fclose(world_file) != 0 ) exit(EXIT_FAILURE);
+	close_world_input(world_file);
 	if ( header_file_flag ) {
 		fclose(header_file);
 	}
+	output_arena_report(&(world[0].arena));
 
 	
 	return(world);
@@ -43,12 +43,13 @@ struct	yearly_clim_object *construct_yearly_clim(
 												  char	*file_prefix,
 												  struct	date	start_date,
 												  long	duration, 
-												int clim_repeat_flag)
+												int clim_repeat_flag,
+												int clim_cache_flag)
 {
 	/*--------------------------------------------------------------*/
 	/*	local function declarations.								*/
 	/*--------------------------------------------------------------*/
-	double	*construct_clim_sequence( char *, struct date, long, int);
+	double	*construct_clim_sequence( char *, struct date, long, int, int);
 	void	*alloc(	size_t, char *, char *);
 	
 	/*--------------------------------------------------------------*/
@@ -107,7 +108,7 @@ struct	yearly_clim_object *construct_yearly_clim(
 			yearly_clim[0].temp = construct_clim_sequence(
 				(char *)strcat(file_name,".temp"),
 				start_date,
-				duration, clim_repeat_flag);
+				duration, clim_repeat_flag, clim_cache_flag);
 		}
 		else{
 			fprintf(stderr,
@@ -10,7 +10,7 @@
 /*	SYNOPSIS													*/
 /*	struct zone_object *construct_zone(										*/
 /*					struct	command_line_object	*command_line,	*/
-/*					FILE	*world_file,					*/
+/*					struct world_input_object *world_file,	*/
 /*					struct	default_object						*/
 /*																*/
 /*	OPTIONS														*/
@@ -53,7 +53,7 @@
 
 struct zone_object *construct_zone(
 								   struct	command_line_object	*command_line,
-								   FILE		*world_file,
+								   struct world_input_object *world_file,
 								   int		*num_world_base_stations,
 								   struct	base_station_object **world_base_stations,
 								   struct	default_object	*defaults,
@@ -74,6 +74,7 @@ struct zone_object *construct_zone(
 		int ,
 		int *,
         struct base_station_object **,
+        struct base_station_index_object *,
         const struct base_station_ncheader_object *
         //#ifdef LIU_NETCDF_READER
         //,double
@@ -85,10 +86,11 @@ struct zone_object *construct_zone(
 	
 	struct patch_object *construct_patch(
 		struct command_line_object *,
-		FILE	*,
+		struct world_input_object *,
 		int		num_world_base_stations,
 		struct base_station_object **world_base_stations,
-		struct	default_object	*defaults);
+		struct	default_object	*defaults,
+		struct	arena_object *);
 	
 	struct base_station_object *construct_netcdf_grid(
         #ifdef LIU_NETCDF_READER
@@ -106,6 +108,9 @@ struct zone_object *construct_zone(
 	int get_netcdf_xy(char *, char *, char *, float, float, float, float *, float *);
 	
 	void	*alloc(size_t, char *, char *);
+	int	read_world_int(struct world_input_object *);
+	double	read_world_double(struct world_input_object *);
+	void	*arena_alloc(struct arena_object *, int, size_t, char *, char *);
 	double	atm_pres( double );
 	
 	/*--------------------------------------------------------------*/
@@ -116,9 +121,8 @@ struct zone_object *construct_zone(
 	int		i, k, j;
 	int		default_object_ID;
 	int		notfound;
-    int     basestation_id;
+    int     basestation_id = 0;
 	float   base_x, base_y;	
-	char	record[MAXSTR];
 	struct	zone_object *zone;
 	
 	notfound = 0;
@@ -131,35 +135,23 @@ struct zone_object *construct_zone(
 	/*--------------------------------------------------------------*/
 	/*	Allocate a zone object.								*/
 	/*--------------------------------------------------------------*/
-	zone = (struct zone_object *) alloc( 1 *
+	zone = (struct zone_object *) arena_alloc(&(world[0].arena), ARENA_ZONE, 1 *
 		sizeof( struct zone_object ),"zone","construct_zone" );
 	/*--------------------------------------------------------------*/
 	/*	Read in the next zone record for this hillslope.			*/
 	/*--------------------------------------------------------------*/
-	fscanf(world_file,"%d",&(zone[0].ID));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(zone[0].x));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(zone[0].y));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(zone[0].z));
-	read_record(world_file, record);
-	fscanf(world_file,"%d",&(default_object_ID));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(zone[0].area));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(zone[0].slope));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(zone[0].aspect));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(zone[0].precip_lapse_rate));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(zone[0].e_horizon));
-	read_record(world_file, record);
-	fscanf(world_file,"%lf",&(zone[0].w_horizon));
-	read_record(world_file, record);
-	fscanf(world_file,"%d",&(zone[0].num_base_stations));
-	read_record(world_file, record);
+	zone[0].ID = read_world_int(world_file);
+	zone[0].x = read_world_double(world_file);
+	zone[0].y = read_world_double(world_file);
+	zone[0].z = read_world_double(world_file);
+	default_object_ID = read_world_int(world_file);
+	zone[0].area = read_world_double(world_file);
+	zone[0].slope = read_world_double(world_file);
+	zone[0].aspect = read_world_double(world_file);
+	zone[0].precip_lapse_rate = read_world_double(world_file);
+	zone[0].e_horizon = read_world_double(world_file);
+	zone[0].w_horizon = read_world_double(world_file);
+	zone[0].num_base_stations = read_world_int(world_file);
 
 	/*--------------------------------------------------------------*/
 	/*	convert from degrees to radians for slope and aspects 	*/
@@ -185,14 +177,14 @@ struct zone_object *construct_zone(
 	/*--------------------------------------------------------------*/
 	/*	Define hourly array zone				*/
 	/*--------------------------------------------------------------*/
-	zone[0].hourly = (struct zone_hourly_object *) alloc(
+	zone[0].hourly = (struct zone_hourly_object *) arena_alloc(&(world[0].arena), ARENA_LIST,
 		sizeof( struct zone_hourly_object ),
 		"hourly","zone_hourly");
 	/*--------------------------------------------------------------*/
 	/*	Assign	defaults for this zone								*/
 	/*--------------------------------------------------------------*/
 	zone[0].defaults = (struct zone_default **)
-		alloc( sizeof(struct zone_default *),"defaults",
+		arena_alloc(&(world[0].arena), ARENA_LIST, sizeof(struct zone_default *),"defaults",
 		"construct_zone" );
 	i = 0;
 	while (defaults[0].zone[i].ID != default_object_ID) {
@@ -218,7 +210,7 @@ struct zone_object *construct_zone(
 	/*	Allocate a list of base stations for this zone.          */
 	/*--------------------------------------------------------------*/
 	zone[0].base_stations = (struct base_station_object **)
-		alloc(zone[0].num_base_stations *
+		arena_alloc(&(world[0].arena), ARENA_LIST, zone[0].num_base_stations *
 		sizeof(struct base_station_object *),
 		"base_stations","construct_zone" );
 	/*--------------------------------------------------------------*/
@@ -228,8 +220,7 @@ struct zone_object *construct_zone(
 	/*--------------------------------------------------------------*/
 	if (command_line[0].gridded_netcdf_flag == 0){
 	for (i=0 ; i<zone[0].num_base_stations ; i++ ){
-		fscanf(world_file,"%d",&(base_stationID));
-		read_record(world_file, record);
+		base_stationID = read_world_int(world_file);
 		/*--------------------------------------------------------------*/
 		/*  Point to the appropriate base station in the base           */
 		/*              station list for this world.                    */
@@ -242,8 +233,7 @@ struct zone_object *construct_zone(
 	} /*end for*/
 	}
 	else {
-        fscanf(world_file,"%d",&basestation_id);
-        read_record(world_file, record);
+        basestation_id = read_world_int(world_file);
 	}
 	/*--------------------------------------------------------------*/
 	/* NETCDF BASE STATIONS                                         */
@@ -296,6 +286,7 @@ struct zone_object *construct_zone(
 																   *num_world_base_stations,
 																   &(notfound),
                                         world_base_stations,
+                                        world[0].base_station_index,
                                         world[0].base_station_ncheader
                                         //#ifdef LIU_NETCDF_READER
                                         //,base_station_ncheader[0].resolution_meter / 3.0
@@ -364,13 +355,12 @@ struct zone_object *construct_zone(
 	/*--------------------------------------------------------------*/
 	/*	Read in number of patches in this zone.						*/
 	/*--------------------------------------------------------------*/
-	fscanf(world_file,"%d",&(zone[0].num_patches));
-	read_record(world_file, record);
+	zone[0].num_patches = read_world_int(world_file);
 	/*--------------------------------------------------------------*/
 	/*	Allocate list of pointers to patch objects .				*/
   /*--------------------------------------------------------------*/
   zone[0].patches = (struct patch_object ** ) 
-		alloc( zone[0].num_patches * sizeof( struct patch_object *),
+		arena_alloc(&(world[0].arena), ARENA_LIST, zone[0].num_patches * sizeof( struct patch_object *),
 		"patches","construct_zone");
 	/*--------------------------------------------------------------*/
 	/*	Initialize any variables that should be initialized at	*/
@@ -393,7 +383,8 @@ struct zone_object *construct_zone(
 			world_file,
 			*num_world_base_stations,
 			world_base_stations,
-			defaults);
+			defaults,
+			&(world[0].arena));
 		zone[0].patches[i][0].zone = zone;
 	} /*end for*/
 
@@ -76,7 +76,7 @@ struct zone_default *construct_zone_defaults(
                 paramCnt = 0;
                 printf("Reading %s\n", default_files[i]);
                 if (paramPtr != NULL)
-                    free(paramPtr);
+                    freeParams(paramPtr);
 
                 paramPtr = readParamFile(&paramCnt, default_files[i]);
 		/*--------------------------------------------------------------*/
@@ -200,7 +200,7 @@ struct zone_default *construct_zone_defaults(
 	} /*end for*/
 
                 if (paramPtr != NULL)
-                    free(paramPtr);
+                    freeParams(paramPtr);
 		    
 	return(default_object_list);
 } /*end construct_zone_defaults*/
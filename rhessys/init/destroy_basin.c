@@ -30,6 +30,8 @@ void destroy_basin(
 	void	destroy_hillslope(
 		struct	command_line_object	*,
 		struct	hillslope_object	**);
+	void	destroy_basin_routing(
+		struct	basin_object	*);
 	/*--------------------------------------------------------------*/
 	/*	local variable declarations 								*/
 	/*--------------------------------------------------------------*/
@@ -46,6 +48,24 @@ void destroy_basin(
 	/*--------------------------------------------------------------*/
 	free(basin[0].hillslopes);
 	/*--------------------------------------------------------------*/
+	/*	destroy the ID index						*/
+	/*--------------------------------------------------------------*/
+	free(basin[0].id_index[0].entries);
+	free(basin[0].id_index);
+	/*--------------------------------------------------------------*/
+	/*	destroy the hillslope schedule					*/
+	/*--------------------------------------------------------------*/
+	free(basin[0].schedule.order);
+	free(basin[0].schedule.queue_of);
+	free(basin[0].schedule.units);
+	free(basin[0].schedule.cost);
+	free(basin[0].schedule.wall_time);
+	free(basin[0].schedule.queue_start);
+	free(basin[0].schedule.queue_next);
+	free(basin[0].schedule.thread_hillslopes);
+	free(basin[0].schedule.queue_cost);
+	free(basin[0].schedule.thread_load);
+	/*--------------------------------------------------------------*/
 	/*	Destroy the basins grow extension if it exists.			*/
 	/*--------------------------------------------------------------*/
 	if ( command_line[0].grow_flag == 1)
@@ -58,15 +78,12 @@ void destroy_basin(
 	/*--------------------------------------------------------------*/
 	/*	destroy the list of route_list: need further free	*/
 	/*--------------------------------------------------------------*/
-        if (command_line[0].routing_flag==1){
-	    free(basin[0].route_list[0].list);
-	    free(basin[0].route_list); 
-	    free(basin[0].surface_route_list[0].list);
-	    free(basin[0].surface_route_list);	    
-	}
+	if (command_line[0].routing_flag==1)
+		destroy_basin_routing(basin);
 	/*--------------------------------------------------------------*/
 	/*	Destroy the main basin object.								*/
 	/*--------------------------------------------------------------*/
+	free(basin[0].hourly);
 	free(basin);
 	return;
 } /*end destroy_basin*/
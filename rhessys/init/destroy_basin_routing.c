@@ -0,0 +1,59 @@
+/*--------------------------------------------------------------*/
+/* 																*/
+/*					destroy_basin_routing						*/
+/*																*/
+/*	destroy_basin_routing.c - destroy the routing of a basin	*/
+/*																*/
+/*	NAME														*/
+/*	destroy_basin_routing.c - destroy the routing of a basin	*/
+/*																*/
+/*	SYNOPSIS													*/
+/*	void destroy_basin_routing(struct basin_object *basin)		*/
+/*																*/
+/*	OPTIONS														*/
+/*																*/
+/*	DESCRIPTION													*/
+/*																*/
+/*	Frees what construct_basin_routing built: the routing		*/
+/*	state, the parallel routing inflow links and the			*/
+/*	subsurface and surface route lists.							*/
+/*																*/
+/*	PROGRAMMERS NOTES											*/
+/*																*/
+/*--------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include "rhessys.h"
+
+void destroy_basin_routing(struct basin_object *basin)
+{
+	struct	routing_state_object	*state;
+
+	state = basin[0].route_list[0].state;
+	free(state[0].Qin);
+	free(state[0].Qout);
+	free(state[0].NO3_Qin);
+	free(state[0].NO3_Qout);
+	free(state[0].NH4_Qin);
+	free(state[0].NH4_Qout);
+	free(state[0].DON_Qin);
+	free(state[0].DON_Qout);
+	free(state[0].DOC_Qin);
+	free(state[0].DOC_Qout);
+	free(state[0].area);
+	free(state);
+	if (basin[0].route_list[0].outflow != NULL) {
+		free(basin[0].route_list[0].outflow);
+		free(basin[0].route_list[0].inflow_start);
+		free(basin[0].route_list[0].inflows);
+	}
+	free(basin[0].route_list[0].list);
+	free(basin[0].route_list);
+	basin[0].route_list = NULL;
+	if (basin[0].surface_route_list != NULL) {
+		free(basin[0].surface_route_list[0].list);
+		free(basin[0].surface_route_list);
+		basin[0].surface_route_list = NULL;
+	}
+	return;
+} /*end destroy_basin_routing*/
@@ -0,0 +1,73 @@
+/*--------------------------------------------------------------*/
+/* 																*/
+/*					destroy_clim_window		 					*/
+/*																*/
+/*	destroy_clim_window - stops and frees streamed climate		*/
+/*																*/
+/*	NAME														*/
+/*	destroy_clim_window - stops and frees streamed climate		*/
+/*																*/
+/*	SYNOPSIS													*/
+/*	void destroy_clim_window(struct clim_window_object *)		*/
+/*																*/
+/*	OPTIONS														*/
+/*																*/
+/*	DESCRIPTION													*/
+/*																*/
+/*	Stops the reading thread, closes the sequence files and		*/
+/*	frees the windows.  The daily_clim sequences that pointed	*/
+/*	into them are set to NULL, so destroy_base_station must		*/
+/*	come after this.											*/
+/*																*/
+/*	PROGRAMMER NOTES											*/
+/*																*/
+/*--------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include "rhessys.h"
+
+void destroy_clim_window(struct clim_window_object *clim_window)
+{
+	/*--------------------------------------------------------------*/
+	/*	local function declarations.								*/
+	/*--------------------------------------------------------------*/
+	void	close_netcdf_clim_stream(struct clim_stream_object *);
+	/*--------------------------------------------------------------*/
+	/*	local variable declarations 								*/
+	/*--------------------------------------------------------------*/
+	int	s;
+	struct	clim_stream_object	*stream, *next;
+
+	if (clim_window == NULL)
+		return;
+	if (clim_window[0].thread_started == 1) {
+		pthread_mutex_lock(&(clim_window[0].mutex));
+		clim_window[0].quit = 1;
+		pthread_cond_broadcast(&(clim_window[0].cond));
+		pthread_mutex_unlock(&(clim_window[0].mutex));
+		pthread_join(clim_window[0].thread, NULL);
+		printf("\n Streamed %d climate sequences in windows of %ld days, waited %.3f s for reading",
+			clim_window[0].num_streams, clim_window[0].window_days,
+			clim_window[0].wait_seconds);
+	}
+	for (stream = clim_window[0].streams; stream != NULL; stream = next) {
+		next = stream[0].next;
+		if (stream[0].type == CLIM_STREAM_NETCDF_GRID)
+			close_netcdf_clim_stream(stream);
+		else
+			fclose(stream[0].file);
+		for (s = 0; s < stream[0].num_series; s++)
+			*(stream[0].series[s]) = NULL;
+		free(stream[0].head);
+		free(stream[0].buffer[0]);
+		free(stream[0].buffer[1]);
+		free(stream[0].float_buffer);
+		free(stream[0].series);
+		free(stream[0].daily_clim);
+		free(stream);
+	}
+	pthread_mutex_destroy(&(clim_window[0].mutex));
+	pthread_cond_destroy(&(clim_window[0].cond));
+	free(clim_window);
+	return;
+} /*end destroy_clim_window*/
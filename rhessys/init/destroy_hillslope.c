@@ -16,6 +16,9 @@
 /*	PROGRAMMERS NOTES											*/
 /*																*/
 /*	Original code - MARCH 15, 1996								*/
+/*																*/
+/*	the hillslope and its lists live in the world arena and go	*/
+/*	with release_arena											*/
 /*--------------------------------------------------------------*/
 #include <stdio.h>
 #include "rhessys.h"
@@ -42,22 +45,9 @@ void destroy_hillslope(
 	for ( i=0 ; i< hillslope[0].num_zones; i++ )
 		destroy_zone( command_line, &(hillslope[0].zones[i]));
 	/*--------------------------------------------------------------*/
-	/*	destroy the list of zones.									*/
-	/*--------------------------------------------------------------*/
-	free(hillslope[0].zones);
-	/*--------------------------------------------------------------*/
 	/*	destroy the hillslope's grow extension if it exists.		*/
 	/*--------------------------------------------------------------*/
 	if ( command_line[0].grow_flag == 1)
 		free(hillslope[0].grow);
-	/*--------------------------------------------------------------*/
-	/*	destroy the list of pointers to base stations.				*/
-	/*--------------------------------------------------------------*/
-	if ( hillslope[0].num_base_stations > 0 )
-		free( hillslope[0].base_stations);
-	/*--------------------------------------------------------------*/
-	/*	Destroy the main hillslope object.							*/
-	/*--------------------------------------------------------------*/
-	free(hillslope);
 	return;
 } /*end destroy_hillslope*/
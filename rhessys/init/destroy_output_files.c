@@ -33,6 +33,7 @@ void	destroy_output_files(
 	/*	Local function definition.									*/
 	/*--------------------------------------------------------------*/
 	void	*destroy_output_fileset( struct	output_files_object	*);
+	void	destroy_output_spec( struct output_spec_object *);
 	/*--------------------------------------------------------------*/
 	/*	Local variable definition.									*/
 	/*--------------------------------------------------------------*/
@@ -62,16 +63,23 @@ void	destroy_output_files(
 	}
 	/*--------------------------------------------------------------*/
 	/*	Destroy the canopy_stratum output files.		*/
+	/*	(constructed for patch output too)				*/
 	/*--------------------------------------------------------------*/
-	if ( command_line[0].c != NULL ){
+	if ( (command_line[0].c != NULL) || (command_line[0].p != NULL) ){
 		destroy_output_fileset( output[0].canopy_stratum);
 	}
 	/*--------------------------------------------------------------*/
+	/*	Destroy the output specification.							*/
+	/*--------------------------------------------------------------*/
+	if ( (output != NULL) && (output[0].spec != NULL) ){
+		destroy_output_spec( output[0].spec );
+	}
+	/*--------------------------------------------------------------*/
 	/*	Destroy the world output file object.						*/
 	/*--------------------------------------------------------------*/
 	if ((command_line[0].b != NULL) || (command_line[0].h != NULL) ||
 		(command_line[0].z != NULL) || (command_line[0].p != NULL) ||
-		(command_line[0].c != NULL)){
+		(command_line[0].c != NULL) || (command_line[0].output_spec_flag == 1)){
 		free( output );
 	}
 	return;
@@ -29,6 +29,7 @@ void	destroy_output_fileset(	 struct	output_files_object *fileset)
 	/*------------------------------------------------------*/
 	/*	Local Function Declarations.						*/
 	/*------------------------------------------------------*/
+	void	destroy_column_file(struct column_file_object *);
 	
 	/*------------------------------------------------------*/
 	/*	Local Variable Definition. 							*/
@@ -39,7 +40,9 @@ void	destroy_output_fileset(	 struct	output_files_object *fileset)
 	/*--------------------------------------------------------------*/
 	fclose(  fileset[0].yearly );
 	fclose(  fileset[0].monthly );
-	fclose(  fileset[0].daily );
+	if ( fileset[0].daily != NULL )
+		fclose(  fileset[0].daily );
+	destroy_column_file( fileset[0].daily_columns );
 	fclose(  fileset[0].hourly );
 	free( fileset );
 	return;
@@ -0,0 +1,39 @@
+/*--------------------------------------------------------------*/
+/* 																*/
+/*					destroy_output_spec							*/
+/*																*/
+/*	destroy_output_spec - closes an output specification		*/
+/*																*/
+/*	NAME														*/
+/*	destroy_output_spec - closes an output specification		*/
+/*																*/
+/*	SYNOPSIS													*/
+/*	void	destroy_output_spec(struct output_spec_object *)	*/
+/*																*/
+/*	OPTIONS														*/
+/*																*/
+/*	DESCRIPTION													*/
+/*																*/
+/*	PROGRAMMER NOTES											*/
+/*																*/
+/*--------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include "rhessys.h"
+
+void	destroy_output_spec(struct output_spec_object *spec)
+{
+	/*------------------------------------------------------*/
+	/*	Local Function Declarations.						*/
+	/*------------------------------------------------------*/
+	void	destroy_column_file(struct column_file_object *);
+
+	if (spec[0].outfile != NULL)
+		fclose(spec[0].outfile);
+	destroy_column_file(spec[0].columns);
+	free(spec[0].entries);
+	free(spec[0].format);
+	free(spec[0].values);
+	free(spec);
+	return;
+} /*end destroy_output_spec*/
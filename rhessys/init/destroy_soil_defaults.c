@@ -23,6 +23,7 @@
 /*	Original code, January 15, 1996.							*/
 /*--------------------------------------------------------------*/
 #include <stdio.h>
+#include <stdlib.h>
 #include "rhessys.h"
 
 void destroy_soil_defaults(int num_default_files,
@@ -36,7 +37,22 @@ void destroy_soil_defaults(int num_default_files,
 	/*------------------------------------------------------*/
 	/*	Local Variable Definition. 							*/
 	/*------------------------------------------------------*/
+	int	i;
+	struct	transmissivity_table_object *table;
 	
+	/*--------------------------------------------------------------*/
+	/*	transmissivity tables shared by the patches of each soil	*/
+	/*--------------------------------------------------------------*/
+	for (i=0; i<num_default_files; i++) {
+		table = default_object_list[i].transmissivity_table;
+		if (table != NULL) {
+			free(table[0].layer);
+			free(table[0].drainable);
+			free(table[0].profile);
+			free(table[0].drainable_profile);
+			free(table);
+		}
+	}
 	/*--------------------------------------------------------------*/
 	/*	Delete the default records (all at once since they were		*/
 	/*	allocated in a contiguous array).							*/
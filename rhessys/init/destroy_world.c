@@ -72,9 +72,11 @@ void destroy_world(struct command_line_object *command_line,
 		int,
 		int,
 		struct stratum_default * );
+	void	release_arena(struct arena_object *);
 	void	destroy_base_station(
 		struct command_line_object *,
 		struct base_station_object *);
+	void	destroy_clim_window(struct clim_window_object *);
 	/*--------------------------------------------------------------*/
 	/*	Local variable definition.									*/
 	/*--------------------------------------------------------------*/
@@ -132,11 +134,20 @@ void destroy_world(struct command_line_object *command_line,
 	/*--------------------------------------------------------------*/
 	/*	Destroy the base_stations objects.					*/
 	/*--------------------------------------------------------------*/
+	destroy_clim_window(world[0].clim_window);
 	for ( i=0; i<world[0].num_base_stations; i++){
 		destroy_base_station( command_line,
 			world[0].base_stations[i]);
 	} /*end for*/
 	free( world[0].base_stations );
+	if (world[0].base_station_index != NULL) {
+		free(world[0].base_station_index[0].id_slot);
+		free(world[0].base_station_index[0].meter_bucket);
+		free(world[0].base_station_index[0].meter_next);
+		free(world[0].base_station_index[0].dd_bucket);
+		free(world[0].base_station_index[0].dd_next);
+		free(world[0].base_station_index);
+	}
 	/*--------------------------------------------------------------*/
 	/*	Destroy the basins. 										*/
 	/*--------------------------------------------------------------*/
@@ -145,6 +156,16 @@ void destroy_world(struct command_line_object *command_line,
 			&(world[0].basins[i]) );
 	} /*end for*/
 	free( world[0].basins );
+	if (world[0].objective != NULL) {
+		free(world[0].objective[0].obs);
+		free(world[0].objective);
+	}
+	free( world[0].basin_order );
+	free( world[0].hourly );
+	/*--------------------------------------------------------------*/
+	/*	Give back the hillslope, zone, patch and strata objects.	*/
+	/*--------------------------------------------------------------*/
+	release_arena(&(world[0].arena));
 
 	if (command_line[0].firespread_flag == 1)
 	/*	free(world[0].fire_grid);*/
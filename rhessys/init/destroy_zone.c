@@ -16,6 +16,9 @@
 /*	PROGRAMMERS NOTES											*/
 /*																*/
 /*	Original code - MARCH 15, 1996								*/
+/*																*/
+/*	the zone and its lists live in the world arena and go		*/
+/*	with release_arena											*/
 /*--------------------------------------------------------------*/
 #include <stdio.h>
 #include "rhessys.h"
@@ -42,28 +45,9 @@ void destroy_zone(
 	for ( i=0 ; i< zone[0].num_patches; i++ )
 		destroy_patch( command_line, &(zone[0].patches[i]) );
 	/*--------------------------------------------------------------*/
-	/*	destroy the list of patches.								*/
-	/*--------------------------------------------------------------*/
-	free(zone[0].patches);
-	/*--------------------------------------------------------------*/
 	/*	destroy the zone grow extension if it exists.				*/
 	/*--------------------------------------------------------------*/
 	if ( command_line[0].grow_flag == 1)
 		free(zone[0].grow);
-	/*--------------------------------------------------------------*/
-	/*	destroy the list of pointers to the base stations 			*/
-	/*--------------------------------------------------------------*/
-	if ( zone[0].num_base_stations > 0 ){
-	       free(zone[0].base_stations);
-	}
-      
-	/*--------------------------------------------------------------*/
-	/*	destroy the hourly zone			*/
-	/*--------------------------------------------------------------*/
-	free(zone[0].hourly);
-	/*--------------------------------------------------------------*/
-	/*	Destroy the main zone object.								*/
-	/*--------------------------------------------------------------*/
-	free(zone);
 	return;
 } /*end destroy_zone*/
@@ -45,7 +45,6 @@ int	parse_albedo_flag( char *input_string)
 		exit(EXIT_FAILURE);
 	}
 
-	free(input_string);
 	
 	return(albedo_flag);
 }/*end parse_albedo_flag.c*/
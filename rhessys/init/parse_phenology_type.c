@@ -46,6 +46,5 @@ int	parse_phenology_type( char *input_string)
 		exit(EXIT_FAILURE);
 		}
 
-	free(input_string);	
 	return(veg_type);
 }/*parse_phenology_type.c*/
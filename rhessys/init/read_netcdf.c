@@ -12,6 +12,9 @@
 #define UNITS "units"
 #define DESCRIPTION "description"
 
+/* most values read by one nc_get_vara_float call in the get_netcdf_grid_* readers */
+#define NETCDF_SLICE_VALUES (1 << 24)
+
 /* Handle errors by printing an error message and exiting with a
  * non-zero status. */
 #define ERR(e) {fprintf(stderr,"Error: %s\n", nc_strerror(e)); return -1;}
@@ -121,7 +124,103 @@ int wrap_repeat_date( int month, int day, int start_date_index, int data_length
   }
   return index;
 }
+//_____________________________________________________________________________/
+/* get_repeat_map
+** index into the netcdf record (0 = days[0]) of each of the duration days
+** requested from startday, recycling the record for days past its end
+** (clim_repeat_flag).  Where the record has no Feb 29 for a leap year
+** date, the previous day is used again.
+**
+** Variables:
+**    nday : the total number of days in the actual netcdf file
+**    startday: the first date requested (since STARTYEAR-01-01)
+**    read_start_index : index that says where in the netcdf data array we begin to read from
+**    duration: the number of days of requested data
+**    src: duration indices, filled here
+*/
+void get_repeat_map( int *days, int nday, int startday, int day_offset,
+    int duration, int *src ) {
+  int total_days_in_netcdf_data = nday;
+  int requested_output_data_length = duration;
+
+  // index that says where in the netcdf data array we begin to read from
+  int read_start_index = startday - days[0] + day_offset;
+
+  // how many days of existing, sequential, real netcdf data to copy
+  // directly into the beginning of our output_data array.
+  int amount_to_memcpy = total_days_in_netcdf_data - read_start_index;
+  if( amount_to_memcpy > requested_output_data_length ) {
+    amount_to_memcpy = requested_output_data_length;
+  }
+
+  fprintf( stderr, "start with copying %d days of %d total netcdf.\n", amount_to_memcpy, nday);
+  for( int i = 0; i < amount_to_memcpy; i++ ) {
+    src[ i ] = read_start_index + i;
+  }
+
+  // now we should have all the data from the start date to the end of the actual data copied over.
+  // next comes looping through and creating repeated data as needed...
+
+  int next_write_index = amount_to_memcpy;
+
+  // index inside of netcdf data where we are getting records to repeat
+  int read_data_index = 0;
+
+  // get date object for next day after the last day held in days[]
+  int last_date_in_netcdf_data = days[ total_days_in_netcdf_data - 1];
+  struct date first_date_for_new_data = caldat( last_date_in_netcdf_data + 1 );
+
+  // determine initial index to start drawing repeated data from
+  read_data_index = wrap_repeat_date( first_date_for_new_data.month,
+                                      first_date_for_new_data.day,
+                                      days[0],
+                                      total_days_in_netcdf_data );
 
+  struct date next_date_to_fill;
+  struct date candidate_repeat_date;
+
+  for( int i = next_write_index; i < requested_output_data_length; i++ ) {
+    next_date_to_fill  = caldat( last_date_in_netcdf_data + i - next_write_index );
+    candidate_repeat_date = caldat( days[0] + read_data_index ); //day[0] is the point we start reading netcdfdata (it doesn't change)
+
+    // Test to see if next day is feb. 29th in a leap year
+    if( next_date_to_fill.month == 2 && next_date_to_fill.day == 29 ) {
+      // if the current year of netcdf data is also a leap year...
+      if( LEAPYR( candidate_repeat_date.year ) ) {
+        if( read_data_index >= total_days_in_netcdf_data ) {
+          read_data_index = wrap_repeat_date( next_date_to_fill.month,
+                            next_date_to_fill.day,
+                            days[0],
+                            total_days_in_netcdf_data );
+        }
+        src[ i ] = read_data_index++;
+      }else{
+        // use previous day of data for feb. 29th
+        src[ i ] = ( i > 0 ) ? src[ i - 1 ] : read_data_index;
+      }
+    }else{
+      // if the repeat day is feb. 29th, just skip it.
+      if( candidate_repeat_date.month == 2 && candidate_repeat_date.day == 29 ) {
+        read_data_index++;
+        candidate_repeat_date = caldat( days[0] + read_data_index );
+      }
+      if( read_data_index >= total_days_in_netcdf_data ) {
+        read_data_index = wrap_repeat_date( next_date_to_fill.month,
+                                            next_date_to_fill.day,
+                                            days[0],
+                                            total_days_in_netcdf_data );
+
+        candidate_repeat_date = caldat( days[0] + read_data_index );
+      }
+
+      src[ i ] = read_data_index++;
+    } // end last else
+  } // end for loop
+
+  fprintf( stderr, "read_start_index %d, startday %d, durationRequest %d, days in dataset %d\n", read_start_index, startday, duration, nday );
+}
+
+//_____________________________________________________________________________/
 int get_netcdf_var_timeserias(char *netcdf_filename, char *varname,
     char *nlat_name, char *nlon_name,
     float rlat, float rlon, float sd,
@@ -249,6 +348,7 @@ clim_repeat_flag: command line object that tells RHESSys to recycle through netc
   count[2] = 1;
   /***Read netcdf data***/
   float * allActualData;
+  int * repeat_map;
 
   if( !clim_repeat_flag ) {
     if ((retval = nc_get_vara_float(ncid,temp_varid,start,count,&data[0]))){
@@ -269,103 +369,15 @@ clim_repeat_flag: command line object that tells RHESSys to recycle through netc
   }
   //fprintf( stderr, "WE HAVE READ NETCDF\n" );
 
-/* Check for Climate repeat flag. If flag is set, cycle through clim data
- *
- * Variables:
- *    nday : the total number of days in the actual netcdf file
- *    startday: the start of the metdata, the starting index to read from allActualData... the first date requested when this function is called
- *    start_date_index : index that says where in the netcdf data array we begin to read from
- *    allActualData: the entire dataset from the netcdf file, irrespective of how much data is requested by the user
- *    duration: the number of days of requested data
- *    data: an array passed as an argument to this function to be populated with the requested netcdf data
- */
-
+  /* Check for Climate repeat flag. If flag is set, cycle through clim data (see get_repeat_map) */
   if( clim_repeat_flag ) {
-    float * real_netcdf_data = allActualData;
-    float * output_data = data;
-    int total_days_in_netcdf_data = nday;
-    struct date target_date;
-    struct date curr_date;
-
-    int requested_output_data_length = duration;
-
-    // index that says where in the netcdf data array we begin to read from
-    int read_start_index = startday - days[0] + day_offset;
-    int start_date_index = read_start_index;
-
-    // how many days of existing, sequential, real netcdf data to copy
-    // directly into the beginning of our output_data array.
-    int amount_to_memcpy = total_days_in_netcdf_data - read_start_index;
-
-    fprintf( stderr, "start with copying %d days of %d total netcdf.\n", amount_to_memcpy, nday);
-    memcpy( &output_data[ 0 ], &real_netcdf_data[ read_start_index ], amount_to_memcpy * sizeof(float) );
-
-    // now we should have all the data from the start date to the end of the actual data copied over.
-    // next comes looping through and creating repeated data as needed...
-
-    int next_write_index = amount_to_memcpy;
-
-    // index inside of netcdf data where we are getting records to repeat
-    int read_data_index = 0;
-
-    // get date object for next day after the last day held in days[]
-    int last_date_in_netcdf_data = days[ total_days_in_netcdf_data - 1];
-    struct date first_date_for_new_data = caldat( last_date_in_netcdf_data + 1 );
-
-    // determine initial index to start drawing repeated data from
-    read_data_index = wrap_repeat_date( first_date_for_new_data.month,
-                                        first_date_for_new_data.day,
-                                        days[0],
-                                        total_days_in_netcdf_data );
-
-    struct date next_date_to_fill;
-    struct date candidate_repeat_date;
-
-    for( int i = next_write_index; i < requested_output_data_length; i++ ) {
-      next_date_to_fill  = caldat( last_date_in_netcdf_data + i - next_write_index );
-      candidate_repeat_date = caldat( days[0] + read_data_index ); //day[0] is the point we start reading netcdfdata (it doesn't change)
-
-      // Test to see if next day is feb. 29th in a leap year
-      if( next_date_to_fill.month == 2 && next_date_to_fill.day == 29 ) {
-        // if the current year of netcdf data is also a leap year...
-        if( LEAPYR( candidate_repeat_date.year ) ) {
-          if( read_data_index >= total_days_in_netcdf_data ) {
-            read_data_index = wrap_repeat_date( next_date_to_fill.month,
-                              next_date_to_fill.day,
-                              days[0],
-                              total_days_in_netcdf_data );
-          }
-          output_data[ i ] = real_netcdf_data[ read_data_index++ ];
-        }else{
-          // use previous day of data for feb. 29th
-          output_data[ i ] = output_data[ i - 1 ];
-        }
-      }else{
-        // if the repeat day is feb. 29th, just skip it.
-        if( candidate_repeat_date.month == 2 && candidate_repeat_date.day == 29 ) {
-          read_data_index++;
-          candidate_repeat_date = caldat( days[0] + read_data_index );
-        }
-        if( read_data_index >= total_days_in_netcdf_data ) {
-          read_data_index = wrap_repeat_date( next_date_to_fill.month,
-                                              next_date_to_fill.day,
-                                              days[0],
-                                              total_days_in_netcdf_data );
-
-          candidate_repeat_date = caldat( days[0] + read_data_index );
-        }
-
-        output_data[ i ] = real_netcdf_data[ read_data_index++ ];
-     
-        /*if( candidate_repeat_date.month != next_date_to_fill.month) {
-            fprintf( stderr, "candidate month: %d, target month %d, target year %d\n", candidate_repeat_date.month, next_date_to_fill.month, next_date_to_fill.year );
-        }*/
-      } // end last else
-    } // end for loop
-
-    fprintf( stderr, "read_start_index %d, startday %d, durationRequest %d, days in dataset %d\n", read_start_index, startday, duration, nday );
-  
- } // end if clim_repeat_flag
+    repeat_map = (int *) alloc(duration * sizeof(int),"repeat_map","get_netcdf_var_timeserias");
+    get_repeat_map( days, nday, startday, day_offset, duration, repeat_map );
+    for( int i = 0; i < duration; i++ ) {
+      data[ i ] = allActualData[ repeat_map[ i ] ];
+    }
+    free( repeat_map );
+  } // end if clim_repeat_flag
 
   if ((retval = nc_close(ncid))){
     free(days);
@@ -551,3 +563,433 @@ sd: the minimum distance for searching nearby grid in netcdf
   free(lont);
   return 0;
 }
+//_____________________________________________________________________________/
+/* locate_netcdf_points
+** grid row (idlat) and column (idlont) of each of npts locations in an open
+** netcdf file, and the bounding box of those cells. Returns -1 (after
+** naming the location) if a location is not within sd of a grid cell.
+*/
+int locate_netcdf_points(int ncid, char *nlat_name, char *nlon_name,
+    int npts, float *rlat, float *rlon, float sd,
+    int *idlat, int *idlont, int *lat_lo, int *lat_hi, int *lont_lo, int *lont_hi){
+  int nlatid,nlontid,latid,lontid;
+  size_t nlat,nlont;
+  float *lat,*lont;
+  int retval;
+  int p;
+
+  if((retval = nc_inq_dimid(ncid, nlat_name, &nlatid)))
+    ERR(retval);
+  if((retval = nc_inq_dimid(ncid, nlon_name, &nlontid)))
+    ERR(retval);
+  if((retval = nc_inq_dimlen(ncid, nlatid, &nlat)))
+    ERR(retval);
+  if((retval = nc_inq_dimlen(ncid, nlontid, &nlont)))
+    ERR(retval);
+  if ((retval = nc_inq_varid(ncid, nlat_name, &latid)))
+    ERR(retval);
+  if ((retval = nc_inq_varid(ncid, nlon_name, &lontid)))
+    ERR(retval);
+
+  lat = (float *) alloc(nlat * sizeof(float),"lat","locate_netcdf_points");
+  lont = (float *) alloc(nlont * sizeof(float),"lont","locate_netcdf_points");
+  if ((retval = nc_get_var_float(ncid, latid, &lat[0])) ||
+      (retval = nc_get_var_float(ncid, lontid, &lont[0]))){
+    free(lat);
+    free(lont);
+    ERR(retval);
+  }
+
+  *lat_lo = nlat;
+  *lat_hi = -1;
+  *lont_lo = nlont;
+  *lont_hi = -1;
+  for (p = 0; p < npts; p++) {
+    idlat[p] = locate(lat,nlat,rlat[p],sd);
+    idlont[p] = locate(lont,nlont,rlon[p],sd);
+    if(idlat[p] == -1 || idlont[p] == -1){
+      fprintf(stderr,"rlat:%lf\trlon:%lf\tsd:%lf\tlat[0]:%lf\tlont[0]:%lf can't locate the station locate_netcdf_points\n",rlat[p],rlon[p],sd,lat[0],lont[0]);
+      free(lat);
+      free(lont);
+      return -1;
+    }
+    if (idlat[p] < *lat_lo) *lat_lo = idlat[p];
+    if (idlat[p] > *lat_hi) *lat_hi = idlat[p];
+    if (idlont[p] < *lont_lo) *lont_lo = idlont[p];
+    if (idlont[p] > *lont_hi) *lont_hi = idlont[p];
+  }
+  free(lat);
+  free(lont);
+  return 0;
+}
+//_____________________________________________________________________________/
+int get_netcdf_grid_timeseries(char *netcdf_filename, char *varname,
+    char *nlat_name, char *nlon_name,
+    int npts, float *rlat, float *rlon, float sd,
+    int startday, int day_offset, int duration, int clim_repeat_flag, double **data ){
+  /***Read the metdata of npts locations at once; data[p] gets the duration
+days from startday at (rlat[p],rlon[p]), the same days get_netcdf_var_timeserias
+would return for that location (including clim_repeat_flag).
+
+The file is opened and its coordinates read once. The bounding box of all
+locations is read in slices of whole days, at most NETCDF_SLICE_VALUES values
+per slice, and each slice is scattered to all locations before the next is
+read. The scatter is split across threads; the netcdf calls are not, as the
+netcdf library is not thread safe.
+   ************************************************************/
+
+  int ncid, temp_varid,ndaysid,dayid;
+  size_t nday;
+  int *days;
+  int *idlat,*idlont,*offset;
+  int *src,*first,*next,*slice_day,*slice_out;
+  int lat_lo,lat_hi,lont_lo,lont_hi;
+  int tmin,tmax,t0,t1,t,slice_days,num_out;
+  int i,k,p;
+  size_t box;
+  size_t start[3],count[3];
+  float *slab;
+  int retval;
+
+  if((retval = nc_open(netcdf_filename, NC_NOWRITE, &ncid)))
+    ERR(retval);
+  if((retval = nc_inq_dimid(ncid,NDAYS_NAME, &ndaysid)))
+    ERR(retval);
+  if((retval = nc_inq_dimlen(ncid, ndaysid, &nday)))
+    ERR(retval);
+  if ((retval = nc_inq_varid(ncid, NDAYS_NAME, &dayid)))
+    ERR(retval);
+  if ((retval = nc_inq_varid(ncid, varname, &temp_varid)))
+    ERR(retval);
+  days = (int *) alloc(nday * sizeof(int),"days","get_netcdf_grid_timeseries");
+  if ((retval = nc_get_var_int(ncid, dayid, &days[0]))){
+    free(days);
+    ERR(retval);
+  }
+
+  /*locate the records */
+  idlat = (int *) alloc(npts * sizeof(int),"idlat","get_netcdf_grid_timeseries");
+  idlont = (int *) alloc(npts * sizeof(int),"idlont","get_netcdf_grid_timeseries");
+  offset = (int *) alloc(npts * sizeof(int),"offset","get_netcdf_grid_timeseries");
+  if (locate_netcdf_points(ncid, nlat_name, nlon_name, npts, rlat, rlon, sd,
+      idlat, idlont, &lat_lo, &lat_hi, &lont_lo, &lont_hi) == -1) {
+    free(days);
+    free(idlat);
+    free(idlont);
+    free(offset);
+    return -1;
+  }
+  for (p = 0; p < npts; p++)
+    offset[p] = (idlat[p] - lat_lo) * (lont_hi - lont_lo + 1) + (idlont[p] - lont_lo);
+  box = (size_t)(lat_hi - lat_lo + 1) * (size_t)(lont_hi - lont_lo + 1);
+
+  /* record index of each requested day */
+  src = (int *) alloc(duration * sizeof(int),"src","get_netcdf_grid_timeseries");
+  if((startday<days[0] || (duration+startday) > days[nday-1])){
+    if( clim_repeat_flag == 0) {
+      fprintf(stderr,"time period is out of the range of metdata\n");
+      free(days);
+      free(idlat);
+      free(idlont);
+      free(offset);
+      free(src);
+      return -1;
+    }
+  }
+  if( clim_repeat_flag ) {
+    get_repeat_map( days, nday, startday, day_offset, duration, src );
+  }else{
+    for (i = 0; i < duration; i++)
+      src[i] = startday-days[0]+day_offset+i;                //netcdf 4.1.3 problem: there is 1 day offset
+  }
+
+  /* requested days of each record day, as lists through next[] */
+  tmin = src[0];
+  tmax = src[0];
+  for (i = 1; i < duration; i++) {
+    if (src[i] < tmin) tmin = src[i];
+    if (src[i] > tmax) tmax = src[i];
+  }
+  first = (int *) alloc((tmax - tmin + 1) * sizeof(int),"first","get_netcdf_grid_timeseries");
+  next = (int *) alloc(duration * sizeof(int),"next","get_netcdf_grid_timeseries");
+  for (t = 0; t <= tmax - tmin; t++)
+    first[t] = -1;
+  for (i = duration - 1; i >= 0; i--) {
+    next[i] = first[src[i] - tmin];
+    first[src[i] - tmin] = i;
+  }
+
+  /***Read netcdf data in slices of days***/
+  slice_days = (int)(NETCDF_SLICE_VALUES / box);
+  if (slice_days < 1) slice_days = 1;
+  if (slice_days > tmax - tmin + 1) slice_days = tmax - tmin + 1;
+  slab = (float *) alloc(slice_days * box * sizeof(float),"slab","get_netcdf_grid_timeseries");
+  slice_day = (int *) alloc(duration * sizeof(int),"slice_day","get_netcdf_grid_timeseries");
+  slice_out = (int *) alloc(duration * sizeof(int),"slice_out","get_netcdf_grid_timeseries");
+  for (t0 = tmin; t0 <= tmax; t0 += slice_days) {
+    t1 = (t0 + slice_days <= tmax + 1) ? t0 + slice_days : tmax + 1;
+    num_out = 0;
+    for (t = t0; t < t1; t++) {
+      for (i = first[t - tmin]; i >= 0; i = next[i]) {
+        slice_day[num_out] = t - t0;
+        slice_out[num_out] = i;
+        num_out++;
+      }
+    }
+    if (num_out == 0)
+      continue;
+
+    start[0] = t0;
+    start[1] = lat_lo;
+    start[2] = lont_lo;
+    count[0] = t1 - t0;
+    count[1] = lat_hi - lat_lo + 1;
+    count[2] = lont_hi - lont_lo + 1;
+    if ((retval = nc_get_vara_float(ncid,temp_varid,start,count,&slab[0]))){
+      fprintf(stderr,"reading %s from %s\n",varname,netcdf_filename);
+      ERR(retval);
+    }
+
+    #pragma omp parallel for private(k)
+    for (p = 0; p < npts; p++) {
+      for (k = 0; k < num_out; k++)
+        data[p][slice_out[k]] = (double)slab[(size_t)slice_day[k] * box + offset[p]];
+    }
+  }
+
+  if ((retval = nc_close(ncid)))
+    ERR(retval);
+
+  free(days);
+  free(idlat);
+  free(idlont);
+  free(offset);
+  free(src);
+  free(first);
+  free(next);
+  free(slab);
+  free(slice_day);
+  free(slice_out);
+  return 0;
+}
+//_____________________________________________________________________________/
+/* netcdf_grid_series
+** an open netcdf variable read a window of days at a time for npts
+** locations (the -climwindow streams of construct_netcdf_grid_clim).
+** src holds the record index of each requested day, as
+** get_netcdf_grid_timeseries works it out.
+*/
+struct netcdf_grid_series
+        {
+        int ncid;
+        int varid;
+        int npts;
+        int lat_lo;
+        int lont_lo;
+        int nrow;
+        int ncol;
+        int *offset;
+        int duration;
+        int *src;
+        char varname[256];
+        };
+//_____________________________________________________________________________/
+struct netcdf_grid_series *open_netcdf_grid_series(char *netcdf_filename, char *varname,
+    char *nlat_name, char *nlon_name,
+    int npts, float *rlat, float *rlon, float sd,
+    int startday, int day_offset, int duration, int clim_repeat_flag){
+  /***Open varname for read_netcdf_grid_series: locate the npts locations and
+map each of the duration days from startday to its record, as
+get_netcdf_grid_timeseries does. Returns NULL on error.
+   ************************************************************/
+
+  struct netcdf_grid_series *series;
+  int ndaysid,dayid;
+  size_t nday;
+  int *days,*idlat,*idlont;
+  int lat_hi,lont_hi;
+  int i,p;
+  int retval;
+
+  series = (struct netcdf_grid_series *) alloc(sizeof(struct netcdf_grid_series),"series","open_netcdf_grid_series");
+  if((retval = nc_open(netcdf_filename, NC_NOWRITE, &(series->ncid)))){
+    fprintf(stderr,"Error: %s\n", nc_strerror(retval));
+    free(series);
+    return NULL;
+  }
+  if((retval = nc_inq_dimid(series->ncid,NDAYS_NAME, &ndaysid)) ||
+     (retval = nc_inq_dimlen(series->ncid, ndaysid, &nday)) ||
+     (retval = nc_inq_varid(series->ncid, NDAYS_NAME, &dayid)) ||
+     (retval = nc_inq_varid(series->ncid, varname, &(series->varid)))){
+    fprintf(stderr,"Error: %s\n", nc_strerror(retval));
+    nc_close(series->ncid);
+    free(series);
+    return NULL;
+  }
+  days = (int *) alloc(nday * sizeof(int),"days","open_netcdf_grid_series");
+  if ((retval = nc_get_var_int(series->ncid, dayid, &days[0]))){
+    fprintf(stderr,"Error: %s\n", nc_strerror(retval));
+    nc_close(series->ncid);
+    free(days);
+    free(series);
+    return NULL;
+  }
+
+  /*locate the records */
+  idlat = (int *) alloc(npts * sizeof(int),"idlat","open_netcdf_grid_series");
+  idlont = (int *) alloc(npts * sizeof(int),"idlont","open_netcdf_grid_series");
+  if (locate_netcdf_points(series->ncid, nlat_name, nlon_name, npts, rlat, rlon, sd,
+      idlat, idlont, &(series->lat_lo), &lat_hi, &(series->lont_lo), &lont_hi) == -1) {
+    nc_close(series->ncid);
+    free(days);
+    free(idlat);
+    free(idlont);
+    free(series);
+    return NULL;
+  }
+  series->npts = npts;
+  series->nrow = lat_hi - series->lat_lo + 1;
+  series->ncol = lont_hi - series->lont_lo + 1;
+  series->offset = (int *) alloc(npts * sizeof(int),"offset","open_netcdf_grid_series");
+  for (p = 0; p < npts; p++)
+    series->offset[p] = (idlat[p] - series->lat_lo) * series->ncol + (idlont[p] - series->lont_lo);
+  free(idlat);
+  free(idlont);
+
+  /* record index of each requested day */
+  if((startday<days[0] || (duration+startday) > days[nday-1]) && (clim_repeat_flag == 0)){
+    fprintf(stderr,"time period is out of the range of metdata\n");
+    nc_close(series->ncid);
+    free(days);
+    free(series->offset);
+    free(series);
+    return NULL;
+  }
+  series->duration = duration;
+  series->src = (int *) alloc(duration * sizeof(int),"src","open_netcdf_grid_series");
+  if( clim_repeat_flag ) {
+    get_repeat_map( days, nday, startday, day_offset, duration, series->src );
+  }else{
+    for (i = 0; i < duration; i++)
+      series->src[i] = startday-days[0]+day_offset+i;                //netcdf 4.1.3 problem: there is 1 day offset
+  }
+  free(days);
+  strncpy(series->varname, varname, sizeof(series->varname) - 1);
+  series->varname[sizeof(series->varname) - 1] = '\0';
+  return series;
+}
+//_____________________________________________________________________________/
+int read_netcdf_grid_series(struct netcdf_grid_series *series,
+    int first_day, int num_days, int stride, float *data){
+  /***Read the requested days first_day to first_day+num_days-1 of a series
+opened by open_netcdf_grid_series: location p, day first_day+d goes to
+data[p*stride+d], as read (no conversion).
+
+Days whose records follow each other are read together, in slices of at
+most NETCDF_SLICE_VALUES values of the locations' bounding box.
+   ************************************************************/
+
+  int d,k,n,p,slice_days;
+  size_t box;
+  size_t start[3],count[3];
+  float *slab;
+  int retval;
+
+  box = (size_t)series->nrow * (size_t)series->ncol;
+  slice_days = (int)(NETCDF_SLICE_VALUES / box);
+  if (slice_days < 1) slice_days = 1;
+  if (slice_days > num_days) slice_days = num_days;
+  slab = (float *) alloc(slice_days * box * sizeof(float),"slab","read_netcdf_grid_series");
+  for (d = 0; d < num_days; d += n) {
+    n = 1;
+    while ((d + n < num_days) && (n < slice_days)
+        && (series->src[first_day + d + n] == series->src[first_day + d] + n))
+      n++;
+    start[0] = series->src[first_day + d];
+    start[1] = series->lat_lo;
+    start[2] = series->lont_lo;
+    count[0] = n;
+    count[1] = series->nrow;
+    count[2] = series->ncol;
+    if ((retval = nc_get_vara_float(series->ncid,series->varid,start,count,&slab[0]))){
+      fprintf(stderr,"reading %s\n",series->varname);
+      free(slab);
+      ERR(retval);
+    }
+    for (p = 0; p < series->npts; p++) {
+      for (k = 0; k < n; k++)
+        data[(size_t)p * stride + d + k] = slab[(size_t)k * box + series->offset[p]];
+    }
+  }
+  free(slab);
+  return 0;
+}
+//_____________________________________________________________________________/
+void close_netcdf_grid_series(struct netcdf_grid_series *series){
+  if (series == NULL)
+    return;
+  nc_close(series->ncid);
+  free(series->offset);
+  free(series->src);
+  free(series);
+}
+//_____________________________________________________________________________/
+int get_netcdf_grid_var(char *netcdf_filename, char *varname,
+    char *nlat_name, char *nlon_name,
+    int npts, float *rlat, float *rlon, float sd, double *data){
+  /***Read a variable with NO TIME DIMENSION at npts locations at once:
+data[p] is the value at (rlat[p],rlon[p]). The bounding box of the locations
+is read in slices of whole rows, at most NETCDF_SLICE_VALUES values each.
+   ************************************************************/
+
+  int ncid, temp_varid;
+  int *idlat,*idlont;
+  int lat_lo,lat_hi,lont_lo,lont_hi;
+  int r0,r1,slice_rows,ncol,p;
+  size_t start[2],count[2];
+  float *slab;
+  int retval;
+
+  if((retval = nc_open(netcdf_filename, NC_NOWRITE, &ncid)))
+    ERR(retval);
+  if ((retval = nc_inq_varid(ncid, varname, &temp_varid)))
+    ERR(retval);
+
+  idlat = (int *) alloc(npts * sizeof(int),"idlat","get_netcdf_grid_var");
+  idlont = (int *) alloc(npts * sizeof(int),"idlont","get_netcdf_grid_var");
+  if (locate_netcdf_points(ncid, nlat_name, nlon_name, npts, rlat, rlon, sd,
+      idlat, idlont, &lat_lo, &lat_hi, &lont_lo, &lont_hi) == -1) {
+    free(idlat);
+    free(idlont);
+    return -1;
+  }
+
+  ncol = lont_hi - lont_lo + 1;
+  slice_rows = NETCDF_SLICE_VALUES / ncol;
+  if (slice_rows < 1) slice_rows = 1;
+  if (slice_rows > lat_hi - lat_lo + 1) slice_rows = lat_hi - lat_lo + 1;
+  slab = (float *) alloc((size_t)slice_rows * ncol * sizeof(float),"slab","get_netcdf_grid_var");
+  for (r0 = lat_lo; r0 <= lat_hi; r0 += slice_rows) {
+    r1 = (r0 + slice_rows <= lat_hi + 1) ? r0 + slice_rows : lat_hi + 1;
+    start[0] = r0;           //lat
+    start[1] = lont_lo;
+    count[0] = r1 - r0;
+    count[1] = ncol;
+    if ((retval = nc_get_vara_float(ncid,temp_varid,start,count,&slab[0]))){
+      fprintf(stderr,"reading %s from %s\n",varname,netcdf_filename);
+      ERR(retval);
+    }
+    for (p = 0; p < npts; p++) {
+      if (idlat[p] >= r0 && idlat[p] < r1)
+        data[p] = (double)slab[(size_t)(idlat[p] - r0) * ncol + (idlont[p] - lont_lo)];
+    }
+  }
+
+  if ((retval = nc_close(ncid)))
+    ERR(retval);
+
+  free(idlat);
+  free(idlont);
+  free(slab);
+  return 0;
+}
@@ -0,0 +1,168 @@
+/*--------------------------------------------------------------*/
+/* 																*/
+/*					restore_checkpoint							*/
+/*																*/
+/*	restore_checkpoint - resumes a run from a binary checkpoint	*/
+/*																*/
+/*	NAME														*/
+/*	restore_checkpoint - resumes a run from a binary checkpoint	*/
+/*																*/
+/*	SYNOPSIS													*/
+/*	void	read_checkpoint_date(								*/
+/*					struct	command_line_object *command_line)	*/
+/*	void	restore_checkpoint(									*/
+/*					struct	world_object	*world,				*/
+/*					struct	command_line_object *command_line,	*/
+/*					struct	tec_object	*tec)					*/
+/*																*/
+/*	OPTIONS														*/
+/*	-restart <file>												*/
+/*																*/
+/*	DESCRIPTION													*/
+/*																*/
+/*	read_checkpoint_date checks the header of the checkpoint	*/
+/*	written by execute_checkpoint_event and makes its resume	*/
+/*	date the start date of the run, before the world is built,	*/
+/*	so the climate sequences are read from that date as for		*/
+/*	-st.  restore_checkpoint, called once the world and the		*/
+/*	tec file are open, reads the objects of the world back		*/
+/*	(see checkpoint_world), the world's daily values and the	*/
+/*	output flags, and moves the tec file to the entry execute_tec */
+/*	was to read next, so tec events before the checkpoint are	*/
+/*	not done again.  The run then continues as the first run	*/
+/*	would have, giving the same output from the resume date.	*/
+/*																*/
+/*	The route lists are not in the checkpoint but built from	*/
+/*	the flow tables.  If a roads_on event ran before the		*/
+/*	checkpoint, the basins keep the date of its tables			*/
+/*	(road_date) and restore_checkpoint replays the event with	*/
+/*	that date, so the run resumes on the road topology.			*/
+/*																*/
+/*	PROGRAMMER NOTES											*/
+/*																*/
+/*	the world must be built from the same worldfile, flow		*/
+/*	tables, tec file and options as the run that wrote the		*/
+/*	checkpoint (-st and -ed excepted)							*/
+/*	the dated flow tables of that roads_on event must still		*/
+/*	be there													*/
+/*--------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "rhessys.h"
+
+static FILE *open_checkpoint(char *filename, struct checkpoint_header_object *header)
+{
+	void	checkpoint_sizes(size_t *);
+
+	FILE	*file;
+	size_t	sizes[NUM_CHECKPOINT_SIZES];
+
+	if ((file = fopen(filename, "rb")) == NULL) {
+		fprintf(stderr,"FATAL ERROR: in restore_checkpoint, cannot open %s\n", filename);
+		exit(EXIT_FAILURE);
+	}
+	if ((fread(header, sizeof(struct checkpoint_header_object), 1, file) != 1)
+		|| (memcmp(header[0].magic, CHECKPOINT_MAGIC, 8) != 0)) {
+		fprintf(stderr,"FATAL ERROR: in restore_checkpoint, %s is not a checkpoint\n",
+			filename);
+		exit(EXIT_FAILURE);
+	}
+	checkpoint_sizes(sizes);
+	if ((header[0].version != CHECKPOINT_VERSION)
+		|| (memcmp(header[0].sizes, sizes, sizeof(sizes)) != 0)) {
+		fprintf(stderr,
+			"FATAL ERROR: in restore_checkpoint, %s was written by another version of rhessys\n",
+			filename);
+		exit(EXIT_FAILURE);
+	}
+	return(file);
+}
+
+void	read_checkpoint_date(struct command_line_object *command_line)
+{
+	int	cal_date_lt(struct date, struct date);
+
+	FILE	*file;
+	struct	checkpoint_header_object	header;
+
+	file = open_checkpoint(command_line[0].restart_filename, &header);
+	fclose(file);
+	command_line[0].start_date = header.resume_date;
+	command_line[0].start_flag = 1;
+	if (cal_date_lt(command_line[0].start_date, command_line[0].end_date) == 0) {
+		fprintf(stderr,
+			"FATAL ERROR: in restore_checkpoint, %s resumes at %ld %ld %ld, after the end date\n",
+			command_line[0].restart_filename, header.resume_date.year,
+			header.resume_date.month, header.resume_date.day);
+		exit(EXIT_FAILURE);
+	}
+	return;
+}
+
+void	restore_checkpoint(
+						   struct	world_object	*world,
+						   struct	command_line_object *command_line,
+						   struct	tec_object	*tec)
+{
+	/*--------------------------------------------------------------*/
+	/*	Local function definition.									*/
+	/*--------------------------------------------------------------*/
+	void	checkpoint_world(struct world_object *, struct command_line_object *,
+		FILE *, char *, int);
+	void	execute_road_construction_event(struct world_object *,
+		struct command_line_object *, struct date);
+	/*--------------------------------------------------------------*/
+	/*	Local variable definition.									*/
+	/*--------------------------------------------------------------*/
+	int	b, h, z;
+	long	num_patches;
+	FILE	*file;
+	struct	checkpoint_header_object	header;
+
+	file = open_checkpoint(command_line[0].restart_filename, &header);
+	num_patches = 0;
+	for (b=0; b<world[0].num_basin_files; b++)
+		for (h=0; h<world[0].basins[b][0].num_hillslopes; h++)
+			for (z=0; z<world[0].basins[b][0].hillslopes[h][0].num_zones; z++)
+				num_patches += world[0].basins[b][0].hillslopes[h][0].zones[z][0].num_patches;
+	if ((header.num_basins != world[0].num_basin_files)
+		|| (header.num_patches != num_patches)) {
+		fprintf(stderr,
+			"FATAL ERROR: in restore_checkpoint, %s has %d basins and %ld patches, the world %d and %ld\n",
+			command_line[0].restart_filename, header.num_basins, header.num_patches,
+			world[0].num_basin_files, num_patches);
+		exit(EXIT_FAILURE);
+	}
+
+	checkpoint_world(world, command_line, file, command_line[0].restart_filename, 1);
+	fclose(file);
+	world[0].year_day = header.year_day;
+	world[0].target_status = header.target_status;
+	world[0].declin = header.declin;
+	world[0].cos_declin = header.cos_declin;
+	world[0].sin_declin = header.sin_declin;
+	world[0].Io = header.Io;
+	command_line[0].output_flags = header.output_flags;
+	command_line[0].road_flag = header.road_flag;
+
+	/*--------------------------------------------------------------*/
+	/*	routing tables of a roads_on event before the checkpoint	*/
+	/*--------------------------------------------------------------*/
+	if (world[0].basins[0][0].road_date.year != 0)
+		execute_road_construction_event(world, command_line,
+			world[0].basins[0][0].road_date);
+
+	/*--------------------------------------------------------------*/
+	/*	the next tec entry, or none left							*/
+	/*--------------------------------------------------------------*/
+	if (fseek(tec[0].tfile, (header.tec_offset < 0) ? 0 : header.tec_offset,
+		(header.tec_offset < 0) ? SEEK_END : SEEK_SET) != 0) {
+		fprintf(stderr,"FATAL ERROR: in restore_checkpoint, cannot find the tec entry of %s\n",
+			command_line[0].restart_filename);
+		exit(EXIT_FAILURE);
+	}
+	printf("\nResuming from %s at %ld %ld %ld\n", command_line[0].restart_filename,
+		header.resume_date.year, header.resume_date.month, header.resume_date.day);
+	return;
+} /*end restore_checkpoint*/
@@ -56,6 +56,44 @@
 		-gw		include hillslope scale groundwater (sat_to_gw_coeff; gw_loss_coeff parameters scaled)
         -str    Streamflow routing option. Gives name of stream_table to define explicit streamflow routing connectivit.     
         -stro   Streamflow routing output option. Print out streamflow for specified stream reaches.
+		-parallelrouting  route patches in parallel (two pass, deterministic for any number of threads)
+		-hillsched <static|cost|steal>  how hillslopes are shared among threads (default static)
+		-hillschedreport  print the per-thread hillslope load at the end of the run
+		-basinparallel  run the basins of the world in parallel (hillslopes of a basin are
+				run nested if OMP_MAX_ACTIVE_LEVELS >= 2, e.g. OMP_NUM_THREADS=8,2)
+		-seed <n>	seed of the random streams (precip noise); results are repeatable
+				for a given seed and any number of threads (default: clock)
+		-wconvert <file>  write the worldfile given by -w to <file> in the other format
+				(text -> binary or binary -> text) and exit; -w reads either format
+		-climwindow <n>	hold only n days of each daily climate sequence, reading
+				the next n ahead while the model runs (default: whole run)
+		-climcache	keep each parsed base station climate sequence in <file>.cache
+				and read it from there while the file and run dates are unchanged
+		-colout <levels>  write the daily output of the given levels (some of bhzpc,
+				s for -outspec) to <prefix>_<level>.daily.rcol as compressed typed columns
+		-outspec <file>  also write the daily values of the variables and objects listed
+				in <file> to <prefix>_spec.daily (see construct_output_spec.c)
+		-outbuffer <n>	format and write the daily and hourly output on a separate
+				thread, holding up to n records for it (default: written in place)
+		-vegspinupfreeze  with -vegspinup, stop simulating patches once they meet
+				their targets (checked yearly); they keep sending their neighbours
+				the mean outflow of their last year (see update_spinup_active_set.c)
+		-soilspinup <years> [<tol>]  record the litter and soil carbon budget of each
+				patch over climate cycles of <years> years (with -climrepeat) and, where
+				the pools drifted by more than tol (default 0.01) over the cycle, set
+				them to the steady state of that budget (see update_soil_spinup.c)
+		-restart <file>	continue the run from a checkpoint written by the tec event
+				output_checkpoint or on SIGUSR1 (same files and options as the run
+				that wrote it; see execute_checkpoint_event.c)
+		-ensemble <file> [<n>]  run the parameter sets (-s, -sv, -svalt, -vgsen, -gw
+				multipliers) listed in <file> as members sharing this run's startup,
+				n at a time (default: processors), output to <prefix>_m<member>
+				(see run_ensemble.c)
+		-objective <file> [<start y m d> <end y m d>]  compare the daily streamflow of
+				the first basin with the observed flow in <file> (year month day mm/day)
+				over the window (default: all observations) and print NSE, log NSE,
+				KGE and percent bias at the end of the run (see update_objective.c)
+		-coldump <file>  print a column output file as text (as the .daily file) and exit
 		-version Prints the RHESSys version number, then exits immediately
 
 	DESCRIPTION
@@ -312,6 +350,7 @@ int	main( int main_argc, char **main_argv)
 	struct	world_output_file_object	*output;
 	struct	world_output_file_object	*growth_output;
 	char	*prefix;
+	int	b;
 	
 	/*--------------------------------------------------------------*/
 	/* Local Function declarations 									*/
@@ -325,7 +364,8 @@ int	main( int main_argc, char **main_argv)
 	
 	struct	world_output_file_object	*construct_output_files(
 		char *,
-		struct command_line_object	*);
+		struct command_line_object	*,
+		char *);
 	
 	
 	struct	tec_object	*construct_tec(
@@ -353,6 +393,25 @@ int	main( int main_argc, char **main_argv)
 	void	destroy_command_line(
 		struct command_line_object * );
 
+	void	convert_worldfile(
+		char *,
+		char * );
+
+	void	dump_column_file(
+		char * );
+
+	struct	output_spec_object	*construct_output_spec(
+		char *,
+		char *,
+		struct world_object *,
+		int );
+
+	void	start_output_writer(
+		long );
+
+	void	stop_output_writer(
+		void );
+
 	void   add_headers(
 		struct world_output_file_object *,
 		struct command_line_object * );
@@ -361,8 +420,24 @@ int	main( int main_argc, char **main_argv)
 		struct world_output_file_object *,
 		struct command_line_object * );
 
+	void	output_hillslope_schedule(
+		struct basin_object * );
+
+	void	output_objective(
+		struct world_object *,
+		struct command_line_object * );
+
+	void	install_checkpoint_signal(
+		void );
+
+	void	read_checkpoint_date(
+		struct command_line_object * );
+
+	void	restore_checkpoint(
+		struct world_object *,
+		struct command_line_object *,
+		struct tec_object * );
 
-	srand((unsigned)(time(0)));
 
 	/*--------------------------------------------------------------*/
 	/*	Command line parsing.										*/
@@ -379,9 +454,36 @@ int	main( int main_argc, char **main_argv)
 		return(EXIT_SUCCESS);
 	}
 
+	/*--------------------------------------------------------------*/
+	/*	-wconvert only converts the worldfile given by -w	*/
+	/*--------------------------------------------------------------*/
+	if (command_line[0].world_convert_flag == 1) {
+		convert_worldfile(command_line[0].world_filename,
+			command_line[0].world_convert_filename);
+		destroy_command_line(command_line);
+		return(EXIT_SUCCESS);
+	}
+
+	/*--------------------------------------------------------------*/
+	/*	-coldump only prints a column output file		*/
+	/*--------------------------------------------------------------*/
+	if (command_line[0].column_dump_flag == 1) {
+		dump_column_file(command_line[0].column_dump_filename);
+		destroy_command_line(command_line);
+		return(EXIT_SUCCESS);
+	}
+
 
 	if (command_line[0].verbose_flag > 0 )
 		fprintf(stderr,"FINISHED CON COMMAND LINE ***\n");
+
+	/*--------------------------------------------------------------*/
+	/*	A restarted run starts on the date of its checkpoint and	*/
+	/*	SIGUSR1 asks for a checkpoint at the end of the day.		*/
+	/*--------------------------------------------------------------*/
+	if (command_line[0].restart_flag == 1)
+		read_checkpoint_date(command_line);
+	install_checkpoint_signal();
 	
 	/*--------------------------------------------------------------*/
 	/*	Construct the world object.									*/
@@ -402,10 +504,15 @@ int	main( int main_argc, char **main_argv)
 	else{
 		strcpy(prefix,PRE);
 	}
-	output = construct_output_files( prefix, command_line );
+	output = construct_output_files( prefix, command_line,
+		command_line[0].column_levels );
+	if (command_line[0].output_spec_flag == 1)
+		output[0].spec = construct_output_spec(
+			command_line[0].output_spec_filename, prefix, world,
+			strchr(command_line[0].column_levels, 's') != NULL);
 	if (command_line[0].grow_flag > 0) {
 		strcat(prefix,"_grow");
-		growth_output = construct_output_files(prefix, command_line );
+		growth_output = construct_output_files(prefix, command_line, "" );
 	}
 	else growth_output = NULL;
 
@@ -427,13 +534,35 @@ int	main( int main_argc, char **main_argv)
 	
 	if (command_line[0].verbose_flag > 0 )
 		fprintf(stderr,"FINISHED CON TEC\n");
+	if (command_line[0].restart_flag == 1)
+		restore_checkpoint(world, command_line, tec);
+	/*--------------------------------------------------------------*/
+	/*	Output records are written on their own thread from here	*/
+	/*	(-outbuffer), the headers having been written.				*/
+	/*--------------------------------------------------------------*/
+	start_output_writer(command_line[0].output_buffer_depth);
+
 	/*--------------------------------------------------------------*/
 	/*	AN EVENT LOOP WOULD GO HERE.								*/
 	/*--------------------------------------------------------------*/
 	fprintf(stderr,"Beginning Simulation\n");
 	execute_tec( tec, command_line, output, growth_output, world );
+	stop_output_writer();
 	if (command_line[0].verbose_flag > 0 )
 		fprintf(stderr,"FINISHED EXE TEC\n");
+
+	/*--------------------------------------------------------------*/
+	/*	Per thread hillslope load of each basin.					*/
+	/*--------------------------------------------------------------*/
+	if (command_line[0].hillslope_schedule_report_flag == 1)
+		for (b = 0; b < world[0].num_basin_files; b++)
+			output_hillslope_schedule(world[0].basins[b]);
+
+	/*--------------------------------------------------------------*/
+	/*	Streamflow objective functions (-objective).				*/
+	/*--------------------------------------------------------------*/
+	if (world[0].objective != NULL)
+		output_objective(world, command_line);
 	
 	/*--------------------------------------------------------------*/
 	/*	Destroy the tec object.										*/
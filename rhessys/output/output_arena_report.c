@@ -0,0 +1,52 @@
+/*--------------------------------------------------------------*/
+/* 																*/
+/*					output_arena_report							*/
+/*																*/
+/*	output_arena_report.c - memory used by the world objects	*/
+/*																*/
+/*	NAME														*/
+/*	output_arena_report.c - memory used by the world objects	*/
+/*																*/
+/*	SYNOPSIS													*/
+/*	void output_arena_report( 									*/
+/*				struct arena_object *arena)						*/
+/*																*/
+/*	OPTIONS														*/
+/*																*/
+/*	DESCRIPTION													*/
+/*																*/
+/*	prints, once the world is constructed, the number of		*/
+/*	allocations and the bytes used and reserved for each		*/
+/*	object type of the world arena								*/
+/*																*/
+/*	PROGRAMMER NOTES											*/
+/*																*/
+/*--------------------------------------------------------------*/
+#include <stdio.h>
+#include "rhessys.h"
+
+void output_arena_report(struct arena_object *arena)
+{
+	/*--------------------------------------------------------------*/
+	/*	Local variable definition.									*/
+	/*--------------------------------------------------------------*/
+	int type;
+	size_t bytes, reserved;
+	char *names[NUM_ARENA_TYPES] = {"hillslope", "zone", "patch",
+		"stratum", "lists"};
+
+	bytes = 0;
+	reserved = 0;
+	printf("\n World memory by object type");
+	printf("\n %10s %12s %14s %14s", "type", "allocs", "used (kB)",
+		"reserved (kB)");
+	for (type = 0; type < NUM_ARENA_TYPES; type++) {
+		printf("\n %10s %12ld %14.1f %14.1f", names[type], arena->count[type],
+			arena->bytes[type] / 1024.0, arena->reserved[type] / 1024.0);
+		bytes += arena->bytes[type];
+		reserved += arena->reserved[type];
+	}
+	printf("\n %10s %12s %14.1f %14.1f\n", "total", "",
+		bytes / 1024.0, reserved / 1024.0);
+	return;
+} /*end output_arena_report.c*/
@@ -25,24 +25,32 @@
 /*	We only permit one fileset per spatial modelling level.     */
 /*	Each fileset has one file for each timestep.  				*/
 /*																*/
+/*	the patch sums are the daily_sums of the hillslopes, taken	*/
+/*	by update_hillslope_accumulator at the end of basin_daily_F	*/
+/*																*/
 /*--------------------------------------------------------------*/
 #include <stdio.h>
+#include <string.h>
 #include "rhessys.h"
 
 void	output_basin(			int routing_flag,
 					 struct	basin_object	*basin,
 					 struct	date	date,
-					 FILE *outfile)
+					 FILE *outfile,
+					 struct column_file_object *columns)
 {
 	/*------------------------------------------------------*/
 	/*	Local Function Declarations.						*/
 	/*------------------------------------------------------*/
+	int	output_record(FILE *, struct column_file_object *, char *, ...)
+		__attribute__((format(printf, 3, 4)));
+	void	add_hillslope_sums(struct hillslope_sums_object *,
+		struct hillslope_sums_object *);
 	
 	/*------------------------------------------------------*/
 	/*	Local Variable Definition. 							*/
 	/*------------------------------------------------------*/
-	int h,z,p,c;
-	int var_flag, layer;
+	int h;
 	double arain_throughfall;
 	double asnow_throughfall;
 	double alitter_store;
@@ -60,7 +68,7 @@ void	output_basin(			int routing_flag,
 	double asublimation, acanopysubl;
 	double asat_area, adetention_store;
 	double apsn, alai, acrain, acsnow;
-	double abase_flow, hbase_flow,  hstreamflow_NO3, hstreamflow_NH4;
+	double abase_flow, hbase_flow;
 	double	aacctrans, var_acctrans, var_trans;
 	double aPET, adC13, amortality_fract, apcp, apcpassim;
 	double	hgw;
@@ -78,241 +86,102 @@ void	output_basin(			int routing_flag,
 	double acLstar;
 	double acdrip;
 	double acga;	
-	struct	patch_object  *patch;
-	struct	zone_object	*zone;
 	struct hillslope_object *hillslope;
+	struct	hillslope_sums_object	sums;
 	/*--------------------------------------------------------------*/
-	/*	Initialize Accumlating variables.								*/
+	/*	Add up the daily sums of the hillslopes (taken at the end	*/
+	/*	of basin_daily_F, see aggregate_hillslope_patches.c)		*/
 	/*--------------------------------------------------------------*/
-	arain_throughfall =  0.0;
-	asnow_throughfall = 0.0 ;
-	acrain = 0.0;
-	asat_deficit_z = 0.0 ;
-	asat_deficit = 0.0 ;
-	arz_storage = 0.0;	
-	aunsat_storage = 0.0 ;
-	arz_drainage = 0.0;		
-	aunsat_drainage = 0.0 ;
-	acap_rise = 0.0 ;
-	areturn_flow = 0.0 ;
-	aevaporation = 0.0 ;
-	asat_area = 0.0;
-	asnowpack = 0.0  ;
-	asublimation = 0.0  ;
-	aperc_snow = 0.0  ;
-	alitter_store = 0.0  ;
-	atranspiration = 0.0  ;
-	astreamflow = 0.0;
-	arecharge = 0.0;
-	apsn = 0.0 ;
-	aPET = 0.0;
-	aarea =  0.0 ;
-	abase_flow = 0.0;
+	memset(&sums, 0, sizeof(struct hillslope_sums_object));
 	hbase_flow = 0.0;
-	hstreamflow_NO3 = 0.0;
-	hstreamflow_NH4 = 0.0;
 	hgwQout = 0.0;
 	hgw = 0.0;
-	alai = 0.0;
-	adetention_store = 0.0;
-	aacctrans = 0.0; 
 	basin_area = 0.0;
-	zone_area = 0.0;
-	adC13 = 0.0;
-	amortality_fract = 0.0;
-	apcp = 0.0;
-	apcpassim = 0.0;
-    atmin = 0.0;
-    atmax = 0.0;
-    atavg = 0.0;
-    avpd = 0.0;
-    asnow = 0.0;
-	
-	agpsn=0.0;
-	aresp=0.0;
-	ags=0.0;
-	arootdepth = 0.0;
-	aleafc = 0.0;
-	afrootc = 0.0;
-	awoodc = 0.0;
-	asnowmelt = 0.0;
-	acanopysubl = 0.0;
-	acsnow = 0.0;
-	aheight = 0.0;
-	
-	aevap_can = 0.0;
-	aevap_lit = 0.0;
-	aevap_soil = 0.0;
-	
-	aKdown = 0.0;
-	aLdown = 0.0;
-	aKup = 0.0;
-	aLup = 0.0;
-	aKstar_can = 0.0;
-	aKstar_soil = 0.0;
-	aKstar_snow = 0.0;
-	aLstar_can = 0.0;
-	aLstar_soil = 0.0;
-	aLstar_snow = 0.0;
-	aLE_can = 0.0;
-	aLE_soil = 0.0;
-	aLE_snow = 0.0;
-	acLstar = 0.0;
-	
-	alitrc = 0.0;
-	acdrip = 0.0;
-	acga = 0.0;
-	
-
 	for (h=0; h < basin[0].num_hillslopes; h++){
 		hillslope = basin[0].hillslopes[h];
-		hill_area = 0.0;
-		for (z=0; z< hillslope[0].num_zones; z++){
-			zone = hillslope[0].zones[z];
-			apcp += (zone[0].rain_hourly_total+zone[0].rain+zone[0].snow)*zone[0].area;
-			atmin += zone[0].metv.tmin * zone[0].area;
-			atmax += zone[0].metv.tmax * zone[0].area;
-			atavg += zone[0].metv.tavg * zone[0].area;
-			avpd += zone[0].metv.vpd * zone[0].area;
-			aKdown += (zone[0].Kdown_diffuse + zone[0].Kdown_direct) * zone[0].area;
-			aLdown += zone[0].Ldown * zone[0].area;
-			asnow += zone[0].snow * zone[0].area;
-			zone_area += zone[0].area;
-			for (p=0; p< zone[0].num_patches; p++){
-				patch = zone[0].patches[p];
-				arain_throughfall += (patch[0].rain_throughfall_24hours + patch[0].rain_throughfall) * patch[0].area;
-				asnow_throughfall += patch[0].snow_throughfall * patch[0].area;
-				apcpassim += patch[0].precip_with_assim * patch[0].area;
-				asat_deficit_z += patch[0].sat_deficit_z * patch[0].area;
-				asat_deficit += patch[0].sat_deficit * patch[0].area;
-				arecharge += patch[0].recharge * patch[0].area;
-				arz_storage += patch[0].rz_storage * patch[0].area;		
-				aunsat_storage += patch[0].unsat_storage * patch[0].area;
-				arz_drainage += patch[0].rz_drainage * patch[0].area;	
-				aunsat_drainage += patch[0].unsat_drainage * patch[0].area;
-				acap_rise += patch[0].cap_rise * patch[0].area;
-				aevaporation += (patch[0].evaporation + patch[0].evaporation_surf
-					+ patch[0].exfiltration_sat_zone
-					+ patch[0].exfiltration_unsat_zone) * patch[0].area;
-				aevap_can += (patch[0].evaporation) * patch[0].area;
-				aevap_lit += (patch[0].evaporation_surf) * patch[0].area;
-				aevap_soil += (patch[0].exfiltration_sat_zone
-							   + patch[0].exfiltration_unsat_zone) * patch[0].area;
-				asublimation += patch[0].snowpack.sublimation * patch[0].area;
-				asnowpack += patch[0].snowpack.water_equivalent_depth*patch[0].area;
-				if (patch[0].snowpack.water_equivalent_depth > 0.001)
-					aperc_snow += patch[0].area;
-				asnowmelt += patch[0].snow_melt*patch[0].area;
-				aPET += (patch[0].PET) * patch[0].area;
-				alitter_store += patch[0].litter.rain_stored * patch[0].area;
-				adetention_store += patch[0].detention_store*patch[0].area;
-				aacctrans += patch[0].acc_year_trans * patch[0].area; 
-				atranspiration += (patch[0].transpiration_sat_zone
-					+ patch[0].transpiration_unsat_zone)  *  patch[0].area;
-				alitrc += (patch[0].litter_cs.litr1c + patch[0].litter_cs.litr2c
-						   + patch[0].litter_cs.litr3c + patch[0].litter_cs.litr4c)
-				* patch[0].area;
-				aKup += (patch[0].Kup_direct + patch[0].Kup_diffuse) * patch[0].area;
-				aLup += (patch[0].Lup) * patch[0].area;
-				aKstar_can += patch[0].Kstar_canopy * patch[0].area;
-				aKstar_soil += patch[0].Kstar_soil * patch[0].area;
-				aKstar_snow += (patch[0].snowpack.Kstar_direct + patch[0].snowpack.Kstar_diffuse) * patch[0].area;
-				aLstar_can += patch[0].Lstar_canopy * patch[0].area;
-				aLstar_soil += patch[0].Lstar_soil * patch[0].area;
-				aLstar_snow += patch[0].Lstar_snow * patch[0].area;
-				aLE_can += patch[0].LE_canopy * patch[0].area;
-				aLE_soil += patch[0].LE_soil * patch[0].area;
-				aLE_snow += (-1 * patch[0].snowpack.Q_LE + patch[0].snowpack.Q_melt) * patch[0].area;
-				if (patch[0].sat_deficit <= ZERO)
-					asat_area += patch[0].area;
-				if (routing_flag == 1) {
-					if (patch[0].drainage_type == STREAM  )  
-						astreamflow += patch[0].streamflow*patch[0].area;
-						areturn_flow += patch[0].return_flow * patch[0].area;
-						abase_flow += patch[0].base_flow * patch[0].area;
-				}
-				else {
-						/* for Topmodel version compute only return flow and later added to streamflow */
-						areturn_flow += patch[0].return_flow * patch[0].area;
-				}
-				for ( layer=0 ; layer<patch[0].num_layers; layer++ ){
-					for ( c=0 ; c<patch[0].layers[layer].count; c++ ){
-						acrain += patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cover_fraction
-							* (patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].rain_stored +
-							 patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].snow_stored )
-							* patch[0].area;
-						apsn += patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cover_fraction
-							* patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cs.net_psn
-							* patch[0].area;
-						alai += patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cover_fraction
-							* patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].epv.proj_lai
-							* patch[0].area;
-						acanopysubl += patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cover_fraction
-							* patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].sublimation
-							* patch[0].area;
-						adC13 += patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cover_fraction
-							* patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].dC13
-							* patch[0].area;
-						amortality_fract += patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cover_fraction
-							* patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cs.mortality_fract
-							* patch[0].area;
-						agpsn += patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cover_fraction * patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cdf.psn_to_cpool
-							* patch[0].area;
-						aresp += patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cover_fraction
-							* (patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cdf.leaf_day_mr + patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cdf.cpool_leaf_gr
-						   + patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cdf.leaf_night_mr +	patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cdf.livestem_mr
-						   + patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cdf.cpool_livestem_gr + patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cdf.livecroot_mr
-						   + patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cdf.cpool_livecroot_gr
-						   + patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cdf.cpool_deadcroot_gr
-						   + patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cdf.froot_mr + patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cdf.cpool_froot_gr
-						   + patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cdf.cpool_to_gresp_store)	* patch[0].area;
-						ags += patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cover_fraction 
-							* patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].gs * patch[0].area;
-						arootdepth += patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cover_fraction 
-							* (patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].rootzone.depth)
-							* patch[0].area;
-						aleafc += patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cover_fraction	* (patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cs.leafc
-							+ patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cs.leafc_store + patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cs.leafc_transfer ) 
-							* patch[0].area;
-						afrootc += patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cover_fraction * (patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cs.frootc
-							+ patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cs.frootc_store + patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cs.frootc_transfer)
-							* patch[0].area;
-						awoodc += patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cover_fraction	* (patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cs.live_crootc
-						   + patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cs.live_stemc + patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cs.dead_crootc
-						   + patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cs.dead_stemc + patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cs.livecrootc_store
-						   + patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cs.livestemc_store + patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cs.deadcrootc_store
-						   + patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cs.deadstemc_store
-						   + patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cs.livecrootc_transfer
-						   + patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cs.livestemc_transfer
-						   + patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cs.deadcrootc_transfer
-						   + patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cs.deadstemc_transfer
-						   + patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cs.cwdc + patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cs.cpool) 
-							* patch[0].area;
-						acsnow += patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cover_fraction
-							* (	patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].snow_stored )
-							* patch[0].area;
-						aheight += patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cover_fraction 
-							* patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].epv.height 
-							* patch[0].area;
-						acLstar += patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cover_fraction
-							* (	patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].Lstar )
-							* patch[0].area;
-						acdrip += patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cover_fraction
-							* (	patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].canopy_drip )
-							* patch[0].area;
-						acga += patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cover_fraction
-							* patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].ga * patch[0].area;
-					}
-				}
-				aarea +=  patch[0].area;
-				hill_area += patch[0].area;
-			}
-		}
+		add_hillslope_sums(&sums, &(hillslope[0].daily_sums));
+		hill_area = hillslope[0].daily_sums.area;
 		hbase_flow += hillslope[0].base_flow * hill_area;
 		hgw += hillslope[0].gw.storage * hill_area;
 		hgwQout += hillslope[0].gw.Qout * hill_area;
 		basin_area += hill_area;
 	}
+	aarea = sums.area;
+	zone_area = sums.zone_area;
+	apcp = sums.pcp;
+	atmin = sums.tmin;
+	atmax = sums.tmax;
+	atavg = sums.tavg;
+	avpd = sums.vpd;
+	aKdown = sums.Kdown;
+	aLdown = sums.Ldown;
+	asnow = sums.snow;
+	arain_throughfall = sums.rain_throughfall_total;
+	asnow_throughfall = sums.snow_throughfall;
+	apcpassim = sums.precip_with_assim;
+	asat_deficit_z = sums.sat_deficit_z;
+	asat_deficit = sums.sat_deficit;
+	arecharge = sums.recharge;
+	arz_storage = sums.rz_storage;
+	aunsat_storage = sums.unsat_storage;
+	arz_drainage = sums.rz_drainage;
+	aunsat_drainage = sums.unsat_drainage;
+	acap_rise = sums.cap_rise;
+	aevaporation = sums.evaporation;
+	aevap_can = sums.evap_can;
+	aevap_lit = sums.evap_lit;
+	aevap_soil = sums.evap_soil;
+	asublimation = sums.sublimation;
+	asnowpack = sums.snowpack;
+	aperc_snow = sums.perc_snow;
+	asnowmelt = sums.snowmelt;
+	aPET = sums.PET;
+	alitter_store = sums.litter_store;
+	adetention_store = sums.detention_store;
+	aacctrans = sums.acc_year_trans;
+	atranspiration = sums.transpiration;
+	alitrc = sums.litrc;
+	aKup = sums.Kup;
+	aLup = sums.Lup;
+	aKstar_can = sums.Kstar_can;
+	aKstar_soil = sums.Kstar_soil;
+	aKstar_snow = sums.Kstar_snow;
+	aLstar_can = sums.Lstar_can;
+	aLstar_soil = sums.Lstar_soil;
+	aLstar_snow = sums.Lstar_snow;
+	aLE_can = sums.LE_can;
+	aLE_soil = sums.LE_soil;
+	aLE_snow = sums.LE_snow;
+	asat_area = sums.sat_area;
+	/* for Topmodel version compute only return flow and later added to streamflow */
+	areturn_flow = sums.return_flow;
+	if (routing_flag == 1) {
+		astreamflow = sums.streamflow;
+		abase_flow = sums.base_flow;
+	}
+	else {
+		astreamflow = 0.0;
+		abase_flow = 0.0;
+	}
+	acrain = sums.canopy_rain;
+	apsn = sums.psn;
+	alai = sums.lai;
+	acanopysubl = sums.canopy_sublimation;
+	adC13 = sums.dC13;
+	amortality_fract = sums.mortality_fract;
+	agpsn = sums.gpsn;
+	aresp = sums.resp;
+	ags = sums.gs;
+	arootdepth = sums.rootdepth;
+	aleafc = sums.leafc;
+	afrootc = sums.frootc;
+	awoodc = sums.woodc;
+	acsnow = sums.canopy_snow;
+	aheight = sums.height;
+	acLstar = sums.canopy_Lstar;
+	acdrip = sums.canopy_drip;
+	acga = sums.ga;
+
 	adC13 /=  aarea;
 	amortality_fract /=  aarea;
 	apcp /= zone_area;
@@ -393,30 +262,22 @@ void	output_basin(			int routing_flag,
 	if (routing_flag == 0)
 		astreamflow += areturn_flow;
 
-	var_flag = 1;
-	var_trans = 0; 
-	var_acctrans = 0;
-	if (var_flag == 1) {
-        #pragma omp parallel for reduction(+ : var_acctrans,var_trans)           //160628LML
-        for (int h=0; h < basin[0].num_hillslopes; h++){
-        struct hillslope_object *hillslope = basin[0].hillslopes[h];
-        for (int z=0; z< hillslope[0].num_zones; z++){
-            struct zone_object *zone = hillslope[0].zones[z];
-            for (int p=0; p< zone[0].num_patches; p++){
-                struct patch_object *patch = zone[0].patches[p];
-				var_acctrans += pow( 1000*(patch[0].acc_year_trans - aacctrans), 2.0)  *  patch[0].area;
-				var_trans += pow( 1000*(patch[0].transpiration_sat_zone
-					+ patch[0].transpiration_unsat_zone - atranspiration), 2.0)  *  patch[0].area;
-			}
-		}
-		}
-	}
+	/*--------------------------------------------------------------*/
+	/*	area weighted variances of transpiration about the basin	*/
+	/*	means, from the sums of squares								*/
+	/*--------------------------------------------------------------*/
+	var_trans = max(0.0, sums.trans_square
+		- 2.0 * (1000 * atranspiration) * (1000 * sums.transpiration)
+		+ (1000 * atranspiration) * (1000 * atranspiration) * aarea);
+	var_acctrans = max(0.0, sums.acc_year_trans_square
+		- 2.0 * (1000 * aacctrans) * (1000 * sums.acc_year_trans)
+		+ (1000 * aacctrans) * (1000 * aacctrans) * aarea);
 
 	var_trans /= aarea;
 	var_acctrans /= aarea;
 				
 
-	fprintf(outfile,"%d %d %d %d %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf\n",
+	output_record(outfile, columns,"%ld %ld %ld %d %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf\n",
 		date.day,
 		date.month,
 		date.year,
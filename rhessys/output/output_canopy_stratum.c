@@ -32,18 +32,21 @@
 void	output_canopy_stratum( int basinID, int hillID, int zoneID, int patchID,
 							  struct	canopy_strata_object	*stratum,
 							  struct	date	current_date,
-							  FILE *outfile)
+							  FILE *outfile,
+							  struct column_file_object *columns)
 {
 	/*------------------------------------------------------*/
 	/*	Local Function Declarations.						*/
 	/*------------------------------------------------------*/
+	int	output_record(FILE *, struct column_file_object *, char *, ...)
+		__attribute__((format(printf, 3, 4)));
 	
 	/*------------------------------------------------------*/
 	/*	Local Variable Definition. 							*/
 	/*------------------------------------------------------*/
 	
-	fprintf(outfile,
-		"%d %d %d %d %d %d %d %d %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %d \n",
+	output_record(outfile, columns,
+		"%ld %ld %ld %d %d %d %d %d %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %d \n",
 		current_date.day,
 		current_date.month,
 		current_date.year,
@@ -10,6 +10,7 @@
 /*	SYNOPSIS													*/
 /*	void	output_hillslope(										*/
 /*					struct	hillslope_object	*hillslope,				*/
+/*					struct	hillslope_sums_object	*sums,			*/
 /*					struct	date	date,  						*/
 /*					FILE 	*outfile)							*/
 /*																*/
@@ -25,24 +26,30 @@
 /*	We only permit one fileset per spatial modelling level.     */
 /*	Each fileset has one file for each timestep.  				*/
 /*																*/
+/*	sums are the hillslope's daily_sums for daily output; with	*/
+/*	NULL (hourly output) the patches are summed here			*/
+/*																*/
 /*--------------------------------------------------------------*/
 #include <stdio.h>
 #include "rhessys.h"
-
 void	output_hillslope(				int basinID,
 						 struct	hillslope_object	*hillslope,
+						 struct	hillslope_sums_object	*sums,
 						 struct	date	date,
-						 FILE *outfile)
+						 FILE *outfile,
+						 struct column_file_object *columns)
 {
 	/*------------------------------------------------------*/
 	/*	Local Function Declarations.						*/
 	/*------------------------------------------------------*/
+	int	output_record(FILE *, struct column_file_object *, char *, ...)
+		__attribute__((format(printf, 3, 4)));
+	void	aggregate_hillslope_patches(struct hillslope_object *,
+		struct hillslope_sums_object *);
 	
 	/*------------------------------------------------------*/
 	/*	Local Variable Definition. 							*/
 	/*------------------------------------------------------*/
-	int z,p,c;
-	int layer;
 	double arain_throughfall;
 	double asnow_throughfall;
 	double asat_deficit_z;
@@ -57,94 +64,33 @@ void	output_hillslope(				int basinID,
 	double astreamflow;
 	double abase_flow;
 	double apsn, alai;
-	double u20, au20; 
 	double aarea;
-	struct	patch_object  *patch;
-	struct	zone_object	*zone;
-
+	struct	hillslope_sums_object	current_sums;
 	/*--------------------------------------------------------------*/
-	/*	Initialize Accumlating variables.								*/
+	/*	Sum the patches now unless the day's sums are given			*/
 	/*--------------------------------------------------------------*/
-	arain_throughfall =  0.0;
-	asnow_throughfall = 0.0 ;
-	asat_deficit_z = 0.0 ;
-	asat_deficit = 0.0 ;
-	aunsat_storage = 0.0 ;
-	aunsat_drainage = 0.0 ;
-	acap_rise = 0.0 ;
-	areturn_flow = 0.0 ;
-	au20 = 0.0;
-	aevaporation = 0.0 ;
-	asnowpack = 0.0  ;
-	atranspiration = 0.0  ;
-	astreamflow = 0.0;
-	abase_flow = 0.0;
-	apsn = 0.0 ;
-	alai = 0.0;
-	aarea =  0.0 ;
-	for (z=0; z<hillslope[0].num_zones; z++){
-		zone = hillslope[0].zones[z];
-		for (p=0; p< zone[0].num_patches; p++){
-			patch = zone[0].patches[p];
-			arain_throughfall += patch[0].rain_throughfall * patch[0].area;
-			asnow_throughfall += patch[0].snow_throughfall * patch[0].area;
-			asat_deficit_z += patch[0].sat_deficit_z * patch[0].area;
-			asat_deficit += patch[0].sat_deficit * patch[0].area;
-
-			/* determine actual amount in upper 20cm */
-			if (patch[0].sat_deficit_z > 0.020)
-				u20 = patch[0].unsat_storage * 0.020/patch[0].sat_deficit_z;
-			else
-				u20 = patch[0].unsat_storage + (0.020 - patch[0].sat_deficit_z)*
-						patch[0].soil_defaults[0][0].porosity_0;         
-			au20 += u20 * patch[0].area;
-			aunsat_storage += patch[0].unsat_storage * patch[0].area;
-			aunsat_drainage += patch[0].unsat_drainage * patch[0].area;
-			acap_rise += patch[0].cap_rise * patch[0].area;
-			abase_flow += patch[0].base_flow * patch[0].area;
-			areturn_flow += patch[0].return_flow * patch[0].area;
-			aevaporation += patch[0].evaporation * patch[0].area;
-			aarea += patch[0].area;
-			asnowpack += patch[0].snowpack.water_equivalent_depth  *  patch[0].area;
-			atranspiration += (patch[0].transpiration_sat_zone
-				+ patch[0].transpiration_unsat_zone)  *  patch[0].area;
-			if (patch[0].drainage_type == STREAM)  {
-				astreamflow += patch[0].streamflow*patch[0].area;
-			}
-			for ( layer=0 ; layer<patch[0].num_layers; layer++ ){
-				for ( c=0 ; c<patch[0].layers[layer].count; c++ ){
-					apsn += patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cover_fraction
-						* patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cs.net_psn
-						* patch[0].area;
-					alai += patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].cover_fraction
-						* patch[0].canopy_strata[(patch[0].layers[layer].strata[c])][0].epv.proj_lai
-						* patch[0].area;
-				}
-			}
-		}
+	if (sums == NULL) {
+		aggregate_hillslope_patches(hillslope, &current_sums);
+		sums = &current_sums;
 	}
-
-	arain_throughfall /=  aarea;
-	asnow_throughfall /= aarea ;
-	asat_deficit_z /= aarea ;
-	asat_deficit /= aarea ;
-	aunsat_storage /= aarea ;
-	aunsat_drainage /= aarea ;
-	acap_rise /= aarea ;
-	areturn_flow /= aarea ;
-	aevaporation /= aarea ;
-	abase_flow /= aarea;
-	asnowpack /= aarea  ;
-	atranspiration /= aarea  ;
-	astreamflow /= aarea;
-	apsn /= aarea ;
-	alai /= aarea ;
-	au20 /= aarea;
-
+	aarea = sums[0].area;
+	arain_throughfall = sums[0].rain_throughfall / aarea;
+	asnow_throughfall = sums[0].snow_throughfall / aarea;
+	asat_deficit_z = sums[0].sat_deficit_z / aarea;
+	asat_deficit = sums[0].sat_deficit / aarea;
+	aunsat_storage = sums[0].unsat_storage / aarea;
+	aunsat_drainage = sums[0].unsat_drainage / aarea;
+	acap_rise = sums[0].cap_rise / aarea;
+	areturn_flow = sums[0].return_flow / aarea;
+	aevaporation = sums[0].evap_can / aarea;
+	abase_flow = sums[0].base_flow / aarea;
+	asnowpack = sums[0].snowpack / aarea;
+	atranspiration = sums[0].transpiration / aarea;
+	astreamflow = sums[0].streamflow / aarea;
+	apsn = sums[0].psn / aarea;
+	alai = sums[0].lai / aarea;
 	abase_flow += hillslope[0].base_flow;
-
-
-	fprintf(outfile,"%d %d %d %d %d %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf\n",
+	output_record(outfile, columns,"%ld %ld %ld %d %d %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf\n",
 		date.day,
 		date.month,
 		date.year,
@@ -0,0 +1,68 @@
+/*--------------------------------------------------------------*/
+/* 																*/
+/*					output_hillslope_schedule					*/
+/*																*/
+/*	output_hillslope_schedule.c - per thread hillslope load		*/
+/*																*/
+/*	NAME														*/
+/*	output_hillslope_schedule.c - per thread hillslope load		*/
+/*																*/
+/*	SYNOPSIS													*/
+/*	void output_hillslope_schedule( 							*/
+/*				struct basin_object *basin)						*/
+/*																*/
+/*	OPTIONS														*/
+/*																*/
+/*	DESCRIPTION													*/
+/*																*/
+/*	prints, for the -hillschedreport option, the number of		*/
+/*	hillslope runs and the busy time of each thread summed		*/
+/*	over all hillslope loops of the simulation, and the load	*/
+/*	imbalance (busiest thread over mean thread busy time; 1.0	*/
+/*	is a perfect split)											*/
+/*																*/
+/*	PROGRAMMER NOTES											*/
+/*																*/
+/*--------------------------------------------------------------*/
+#include <stdio.h>
+#include "rhessys.h"
+
+void output_hillslope_schedule(struct basin_object *basin)
+{
+	/*--------------------------------------------------------------*/
+	/*	Local variable definition.									*/
+	/*--------------------------------------------------------------*/
+	int t;
+	double total, busiest, mean;
+	char *mode;
+	struct hillslope_schedule_object *schedule;
+
+	schedule = &(basin[0].schedule);
+	if (schedule->mode == HILLSLOPE_SCHEDULE_COST)
+		mode = "cost";
+	else if (schedule->mode == HILLSLOPE_SCHEDULE_STEAL)
+		mode = "steal";
+	else
+		mode = "static";
+
+	total = 0.0;
+	busiest = 0.0;
+	for (t = 0; t < schedule->num_threads; t++) {
+		total += schedule->thread_load[t];
+		if (schedule->thread_load[t] > busiest)
+			busiest = schedule->thread_load[t];
+	}
+	mean = total / schedule->num_threads;
+
+	printf("\n Hillslope schedule for basin %d: %s, %d hillslopes, %d threads, %d days",
+		basin[0].ID, mode, schedule->num_hillslopes, schedule->num_threads,
+		schedule->num_days);
+	printf("\n %8s %12s %12s %8s", "thread", "runs", "busy (s)", "share");
+	for (t = 0; t < schedule->num_threads; t++)
+		printf("\n %8d %12d %12.3f %7.1f%%", t, schedule->thread_hillslopes[t],
+			schedule->thread_load[t],
+			(total > 0.0) ? 100.0 * schedule->thread_load[t] / total : 0.0);
+	printf("\n load imbalance (busiest / mean) = %.3f\n",
+		(mean > 0.0) ? busiest / mean : 1.0);
+	return;
+} /*end output_hillslope_schedule.c*/
@@ -0,0 +1,287 @@
+/*--------------------------------------------------------------*/
+/* 																*/
+/*					output_record								*/
+/*																*/
+/*	output_record - writes one output record as text or columns	*/
+/*																*/
+/*	NAME														*/
+/*	output_record - writes one output record as text or columns	*/
+/*																*/
+/*	SYNOPSIS													*/
+/*	int	output_record(FILE *outfile,							*/
+/*				struct column_file_object *columns,				*/
+/*				char *format, ...)								*/
+/*	void	output_values(FILE *outfile,						*/
+/*				struct column_file_object *columns,				*/
+/*				char *format,									*/
+/*				union output_value_object *values,				*/
+/*				int num_values)									*/
+/*	void	write_output_values(same)							*/
+/*																*/
+/*	OPTIONS														*/
+/*	columns - column output of the file, NULL for text			*/
+/*																*/
+/*	DESCRIPTION													*/
+/*																*/
+/*	output_record takes the arguments of fprintf.  Each			*/
+/*	conversion of format gives the type of its argument: %s is	*/
+/*	a column name (header rows), %d an int, %ld a long and %f,	*/
+/*	%e or %g a double column.  The compiler checks the			*/
+/*	arguments against format as for fprintf.  With columns,	*/
+/*	widths, precisions and the text between conversions are		*/
+/*	not used.													*/
+/*																*/
+/*	output_values is the same for a record whose values are		*/
+/*	already in an array (one per conversion).  With an output	*/
+/*	writer running (-outbuffer) the record is queued for it,	*/
+/*	otherwise write_output_values writes it: to the columns,	*/
+/*	or as text, printing the values with the conversions of		*/
+/*	format (a few at a time) so that the text is what fprintf	*/
+/*	would give.													*/
+/*																*/
+/*	output_record returns what fprintf returns, or 1.			*/
+/*																*/
+/*	PROGRAMMER NOTES											*/
+/*																*/
+/*	output routines give one fprintf per record; writing it		*/
+/*	through here is all that is needed for -colout and			*/
+/*	-outbuffer													*/
+/*	format must last until the record is written - it is kept	*/
+/*	by the queue, not copied									*/
+/*--------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include "rhessys.h"
+
+#define OUTPUT_RECORD_VALUES	1024	/* conversions in one format */
+
+/*--------------------------------------------------------------*/
+/*	next conversion of format at or after p: returns its		*/
+/*	start ('%') and sets its type character and is_long			*/
+/*--------------------------------------------------------------*/
+static char *next_conversion(char *p, char **end, char *type, int *is_long)
+{
+	char	*start;
+
+	while ((p = strchr(p, '%')) != NULL) {
+		if (p[1] == '%') {
+			p += 2;
+			continue;
+		}
+		start = p++;
+		while ((*p != '\0') && (strchr("-+ #0123456789.", *p) != NULL))
+			p++;
+		*is_long = 0;
+		while ((*p == 'l') || (*p == 'h')) {
+			if (*p == 'l') *is_long = 1;
+			p++;
+		}
+		*type = *p;
+		if ((*p == 'd') || (*p == 'i') || (*p == 'f') || (*p == 'e')
+			|| (*p == 'g') || (*p == 's')) {
+			*end = p + 1;
+			return(start);
+		}
+		fprintf(stderr,
+			"FATAL ERROR: in output_record, conversion %%%c of \"%s\" is not supported\n",
+			*p, start);
+		exit(EXIT_FAILURE);
+	}
+	return(NULL);
+}
+
+/*--------------------------------------------------------------*/
+/*	print n values of one kind with one fprintf of chunk, the	*/
+/*	part of format from before the first of their conversions	*/
+/*	to the end of the last										*/
+/*--------------------------------------------------------------*/
+#define OUTPUT_CHUNK_VALUES	8
+#define PRINT_CHUNK(field, cast) \
+	switch (n) { \
+	case 1: fprintf(outfile, chunk, cast v[0].field); break; \
+	case 2: fprintf(outfile, chunk, cast v[0].field, cast v[1].field); break; \
+	case 3: fprintf(outfile, chunk, cast v[0].field, cast v[1].field, cast v[2].field); break; \
+	case 4: fprintf(outfile, chunk, cast v[0].field, cast v[1].field, cast v[2].field, \
+		cast v[3].field); break; \
+	case 5: fprintf(outfile, chunk, cast v[0].field, cast v[1].field, cast v[2].field, \
+		cast v[3].field, cast v[4].field); break; \
+	case 6: fprintf(outfile, chunk, cast v[0].field, cast v[1].field, cast v[2].field, \
+		cast v[3].field, cast v[4].field, cast v[5].field); break; \
+	case 7: fprintf(outfile, chunk, cast v[0].field, cast v[1].field, cast v[2].field, \
+		cast v[3].field, cast v[4].field, cast v[5].field, cast v[6].field); break; \
+	case 8: fprintf(outfile, chunk, cast v[0].field, cast v[1].field, cast v[2].field, \
+		cast v[3].field, cast v[4].field, cast v[5].field, cast v[6].field, \
+		cast v[7].field); break; \
+	}
+
+static void print_chunk(FILE *outfile, char *chunk, char kind,
+						union output_value_object *v, int n)
+{
+	if (kind == 's') {
+		PRINT_CHUNK(s, (char *))
+	}
+	else if (kind == 'l') {
+		PRINT_CHUNK(i, (long))
+	}
+	else if (kind == 'd') {
+		PRINT_CHUNK(i, (int))
+	}
+	else {
+		PRINT_CHUNK(d, (double))
+	}
+}
+
+void	write_output_values(FILE *outfile,
+							struct column_file_object *columns,
+							char *format,
+							union output_value_object *values,
+							int num_values)
+{
+	void	column_file_name(struct column_file_object *, char *);
+	void	column_file_int(struct column_file_object *, int);
+	void	column_file_double(struct column_file_object *, double);
+	void	column_file_end_row(struct column_file_object *);
+
+	int	v, n, is_long;
+	char	type, kind, chunk_kind;
+	char	*p, *start, *end, *chunk_start, *chunk_end;
+	char	chunk[256];
+
+	/*--------------------------------------------------------------*/
+	/*	columns: one value per conversion							*/
+	/*--------------------------------------------------------------*/
+	v = 0;
+	p = format;
+	if (columns != NULL) {
+		while ((start = next_conversion(p, &end, &type, &is_long)) != NULL) {
+			if (v == num_values) break;
+			if (type == 's')
+				column_file_name(columns, values[v].s);
+			else if ((type == 'd') || (type == 'i'))
+				column_file_int(columns, (int) values[v].i);
+			else
+				column_file_double(columns, values[v].d);
+			v++;
+			p = end;
+		}
+		if (next_conversion(p, &end, &type, &is_long) != NULL) {
+			fprintf(stderr,"FATAL ERROR: in output_record, too few values for \"%s\"\n",
+				format);
+			exit(EXIT_FAILURE);
+		}
+		column_file_end_row(columns);
+		return;
+	}
+
+	/*--------------------------------------------------------------*/
+	/*	text: runs of up to OUTPUT_CHUNK_VALUES values of one kind	*/
+	/*	(and the text before them) per fprintf						*/
+	/*--------------------------------------------------------------*/
+	chunk_start = p;
+	chunk_end = p;
+	chunk_kind = 0;
+	kind = 0;
+	n = 0;
+	while (1) {
+		start = next_conversion(p, &end, &type, &is_long);
+		if (start != NULL) {
+			if (type == 's') kind = 's';
+			else if ((type == 'd') || (type == 'i')) kind = is_long ? 'l' : 'd';
+			else kind = 'f';
+		}
+		if ((n > 0) && ((start == NULL) || (kind != chunk_kind)
+			|| (n == OUTPUT_CHUNK_VALUES)
+			|| (end - chunk_start >= (long) sizeof(chunk)))) {
+			memcpy(chunk, chunk_start, chunk_end - chunk_start);
+			chunk[chunk_end - chunk_start] = '\0';
+			print_chunk(outfile, chunk, chunk_kind, &(values[v-n]), n);
+			chunk_start = chunk_end;
+			n = 0;
+		}
+		if (start == NULL)
+			break;
+		if (end - chunk_start >= (long) sizeof(chunk)) {
+			fwrite(chunk_start, 1, start - chunk_start, outfile);
+			chunk_start = start;
+		}
+		if (v == num_values) {
+			fprintf(stderr,"FATAL ERROR: in output_record, too few values for \"%s\"\n",
+				format);
+			exit(EXIT_FAILURE);
+		}
+		chunk_kind = kind;
+		chunk_end = end;
+		n++;
+		v++;
+		p = end;
+	}
+	fputs(chunk_start, outfile);
+	return;
+}
+
+void	output_values(FILE *outfile,
+					  struct column_file_object *columns,
+					  char *format,
+					  union output_value_object *values,
+					  int num_values)
+{
+	int	queue_output_values(FILE *, struct column_file_object *, char *,
+		union output_value_object *, int);
+
+	if (queue_output_values(outfile, columns, format, values, num_values) == 0)
+		write_output_values(outfile, columns, format, values, num_values);
+	return;
+}
+
+int	output_record(FILE *, struct column_file_object *, char *, ...)
+	__attribute__((format(printf, 3, 4)));
+
+int	output_record(FILE *outfile,
+				  struct column_file_object *columns,
+				  char *format, ...)
+{
+	/*------------------------------------------------------*/
+	/*	Local Function Declarations.						*/
+	/*------------------------------------------------------*/
+	int	output_writer_running(void);
+	/*------------------------------------------------------*/
+	/*	Local Variable Definition. 							*/
+	/*------------------------------------------------------*/
+	int	check, is_long, num_values;
+	char	type;
+	char	*p, *end;
+	union	output_value_object	values[OUTPUT_RECORD_VALUES];
+	va_list	ap;
+
+	va_start(ap, format);
+	if ((columns == NULL) && (output_writer_running() == 0)) {
+		check = vfprintf(outfile, format, ap);
+		va_end(ap);
+		return(check);
+	}
+
+	num_values = 0;
+	p = format;
+	while (next_conversion(p, &end, &type, &is_long) != NULL) {
+		if (num_values == OUTPUT_RECORD_VALUES) {
+			fprintf(stderr,"FATAL ERROR: in output_record, more than %d values in \"%s\"\n",
+				OUTPUT_RECORD_VALUES, format);
+			exit(EXIT_FAILURE);
+		}
+		if (type == 's')
+			values[num_values].s = va_arg(ap, char *);
+		else if (((type == 'd') || (type == 'i')) && is_long)
+			values[num_values].i = va_arg(ap, long);
+		else if ((type == 'd') || (type == 'i'))
+			values[num_values].i = va_arg(ap, int);
+		else
+			values[num_values].d = va_arg(ap, double);
+		num_values++;
+		p = end;
+	}
+	va_end(ap);
+	output_values(outfile, columns, format, values, num_values);
+	return(1);
+} /*end output_record*/
@@ -0,0 +1,58 @@
+/*--------------------------------------------------------------*/
+/* 																*/
+/*					output_spec									*/
+/*																*/
+/*	output_spec - writes the values of an output specification	*/
+/*																*/
+/*	NAME														*/
+/*	output_spec - writes the values of an output specification	*/
+/*																*/
+/*	SYNOPSIS													*/
+/*	void	output_spec(struct output_spec_object *spec,		*/
+/*					struct	date	date)						*/
+/*																*/
+/*	OPTIONS														*/
+/*																*/
+/*	DESCRIPTION													*/
+/*																*/
+/*	Writes one record: the date and the current value of every	*/
+/*	entry resolved by construct_output_spec, in the format it	*/
+/*	made.														*/
+/*																*/
+/*	PROGRAMMER NOTES											*/
+/*																*/
+/*	nothing is searched here; the cost is one value per entry	*/
+/*--------------------------------------------------------------*/
+#include <stdio.h>
+#include "rhessys.h"
+
+void	output_spec(struct output_spec_object *spec,
+					struct	date	date)
+{
+	/*------------------------------------------------------*/
+	/*	Local Function Declarations.						*/
+	/*------------------------------------------------------*/
+	void	output_values(FILE *, struct column_file_object *, char *,
+		union output_value_object *, int);
+	/*------------------------------------------------------*/
+	/*	Local Variable Definition. 							*/
+	/*------------------------------------------------------*/
+	int	i;
+	char	*value;
+	struct	output_spec_entry_object	*entry;
+
+	spec[0].values[0].i = date.day;
+	spec[0].values[1].i = date.month;
+	spec[0].values[2].i = date.year;
+	for (i=0; i<spec[0].num_entries; i++) {
+		entry = &(spec[0].entries[i]);
+		value = (char *) entry[0].object + entry[0].offset;
+		if (entry[0].type == OUTPUT_SPEC_INT)
+			spec[0].values[i+3].i = *(int *) value;
+		else
+			spec[0].values[i+3].d = *(double *) value;
+	}
+	output_values(spec[0].outfile, spec[0].columns, spec[0].format,
+		spec[0].values, spec[0].num_entries + 3);
+	return;
+} /*end output_spec*/
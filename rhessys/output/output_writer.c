@@ -0,0 +1,212 @@
+/*--------------------------------------------------------------*/
+/* 																*/
+/*					output_writer								*/
+/*																*/
+/*	output_writer - writes output records on their own thread	*/
+/*																*/
+/*	NAME														*/
+/*	output_writer - writes output records on their own thread	*/
+/*																*/
+/*	SYNOPSIS													*/
+/*	void	start_output_writer(long depth)						*/
+/*	void	stop_output_writer(void)							*/
+/*	int	output_writer_running(void)								*/
+/*	int	queue_output_values(FILE *outfile,						*/
+/*				struct column_file_object *columns,				*/
+/*				char *format,									*/
+/*				union output_value_object *values,				*/
+/*				int num_values)									*/
+/*																*/
+/*	OPTIONS														*/
+/*	-outbuffer <depth>											*/
+/*																*/
+/*	DESCRIPTION													*/
+/*																*/
+/*	start_output_writer makes a ring of depth snapshots and		*/
+/*	starts the writer thread.  From then on output_values		*/
+/*	(output_record) calls queue_output_values, which copies		*/
+/*	the record's values into the next free snapshot and			*/
+/*	returns 1; the writer thread formats and writes the			*/
+/*	snapshots in the order they were queued, with				*/
+/*	write_output_values.  The simulation only waits when the	*/
+/*	ring is full.  Without a writer queue_output_values			*/
+/*	returns 0 and the caller writes the record itself.			*/
+/*																*/
+/*	stop_output_writer waits until every snapshot is written,	*/
+/*	stops the thread and frees the ring.  It must be called		*/
+/*	before the output files are closed or the program exits.	*/
+/*																*/
+/*	PROGRAMMER NOTES											*/
+/*																*/
+/*	there is one writer, as there is one set of output files	*/
+/*	records must only be queued from one thread (the output		*/
+/*	events run outside the parallel regions)					*/
+/*	the files written through output_record must not be			*/
+/*	written directly while the writer runs; the headers are		*/
+/*	written before it starts									*/
+/*--------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <omp.h>
+#include "rhessys.h"
+
+static struct output_writer_object *output_writer = NULL;
+
+/*--------------------------------------------------------------*/
+/*	writer thread: writes every snapshot queued, in order		*/
+/*--------------------------------------------------------------*/
+static void *write_output_snapshots(void *arg)
+{
+	void	write_output_values(FILE *, struct column_file_object *, char *,
+		union output_value_object *, int);
+
+	long	i, n, head;
+	struct	output_writer_object	*writer;
+	struct	output_snapshot_object	*snapshot;
+
+	writer = (struct output_writer_object *) arg;
+	while (1) {
+		pthread_mutex_lock(&(writer[0].mutex));
+		while ((writer[0].count == 0) && (writer[0].quit == 0))
+			pthread_cond_wait(&(writer[0].not_empty), &(writer[0].mutex));
+		if (writer[0].count == 0) {
+			pthread_mutex_unlock(&(writer[0].mutex));
+			break;
+		}
+		head = writer[0].head;
+		n = writer[0].count;
+		pthread_mutex_unlock(&(writer[0].mutex));
+
+		/*--------------------------------------------------------------*/
+		/*	the n snapshots from head are ours until released			*/
+		/*--------------------------------------------------------------*/
+		for (i=0; i<n; i++) {
+			snapshot = &(writer[0].snapshots[(head + i) % writer[0].depth]);
+			write_output_values(snapshot[0].outfile, snapshot[0].columns,
+				snapshot[0].format, snapshot[0].values, snapshot[0].num_values);
+		}
+
+		pthread_mutex_lock(&(writer[0].mutex));
+		writer[0].head = (head + n) % writer[0].depth;
+		writer[0].count -= n;
+		pthread_cond_signal(&(writer[0].not_full));
+		pthread_mutex_unlock(&(writer[0].mutex));
+	}
+	return(NULL);
+}
+
+int	output_writer_running(void)
+{
+	return(output_writer != NULL);
+}
+
+void	start_output_writer(long depth)
+{
+	void	*alloc(size_t, char *, char *);
+	long	i;
+
+	if ((depth < 1) || (output_writer != NULL))
+		return;
+	output_writer = (struct output_writer_object *) alloc(
+		sizeof(struct output_writer_object), "output_writer", "start_output_writer");
+	output_writer[0].depth = depth;
+	output_writer[0].head = 0;
+	output_writer[0].count = 0;
+	output_writer[0].quit = 0;
+	output_writer[0].num_records = 0;
+	output_writer[0].wait_seconds = 0.0;
+	output_writer[0].snapshots = (struct output_snapshot_object *) alloc(
+		depth * sizeof(struct output_snapshot_object), "snapshots", "start_output_writer");
+	for (i=0; i<depth; i++) {
+		output_writer[0].snapshots[i].capacity = 0;
+		output_writer[0].snapshots[i].values = NULL;
+	}
+	pthread_mutex_init(&(output_writer[0].mutex), NULL);
+	pthread_cond_init(&(output_writer[0].not_empty), NULL);
+	pthread_cond_init(&(output_writer[0].not_full), NULL);
+	if (pthread_create(&(output_writer[0].thread), NULL,
+		write_output_snapshots, output_writer) != 0) {
+		fprintf(stderr,
+			"FATAL ERROR: in start_output_writer, cannot start the output thread\n");
+		exit(EXIT_FAILURE);
+	}
+	return;
+}
+
+int	queue_output_values(FILE *outfile,
+						struct column_file_object *columns,
+						char *format,
+						union output_value_object *values,
+						int num_values)
+{
+	long	tail;
+	double	wait_start;
+	struct	output_writer_object	*writer;
+	struct	output_snapshot_object	*snapshot;
+
+	if ((writer = output_writer) == NULL)
+		return(0);
+
+	/*--------------------------------------------------------------*/
+	/*	wait for a free snapshot									*/
+	/*--------------------------------------------------------------*/
+	pthread_mutex_lock(&(writer[0].mutex));
+	if (writer[0].count == writer[0].depth) {
+		wait_start = omp_get_wtime();
+		while (writer[0].count == writer[0].depth)
+			pthread_cond_wait(&(writer[0].not_full), &(writer[0].mutex));
+		writer[0].wait_seconds += omp_get_wtime() - wait_start;
+	}
+	tail = (writer[0].head + writer[0].count) % writer[0].depth;
+	pthread_mutex_unlock(&(writer[0].mutex));
+
+	snapshot = &(writer[0].snapshots[tail]);
+	if (snapshot[0].capacity < num_values) {
+		snapshot[0].capacity = num_values;
+		snapshot[0].values = (union output_value_object *) realloc(
+			snapshot[0].values, num_values * sizeof(union output_value_object));
+		if (snapshot[0].values == NULL) {
+			fprintf(stderr,"FATAL ERROR: in queue_output_values, out of memory\n");
+			exit(EXIT_FAILURE);
+		}
+	}
+	snapshot[0].outfile = outfile;
+	snapshot[0].columns = columns;
+	snapshot[0].format = format;
+	snapshot[0].num_values = num_values;
+	memcpy(snapshot[0].values, values, num_values * sizeof(union output_value_object));
+
+	pthread_mutex_lock(&(writer[0].mutex));
+	writer[0].count += 1;
+	writer[0].num_records += 1;
+	pthread_cond_signal(&(writer[0].not_empty));
+	pthread_mutex_unlock(&(writer[0].mutex));
+	return(1);
+}
+
+void	stop_output_writer(void)
+{
+	long	i;
+	struct	output_writer_object	*writer;
+
+	if ((writer = output_writer) == NULL)
+		return;
+	pthread_mutex_lock(&(writer[0].mutex));
+	writer[0].quit = 1;
+	pthread_cond_signal(&(writer[0].not_empty));
+	pthread_mutex_unlock(&(writer[0].mutex));
+	pthread_join(writer[0].thread, NULL);
+	output_writer = NULL;
+
+	printf("\n Output writer: %ld records through %ld snapshots, waited %.3f s for a free one",
+		writer[0].num_records, writer[0].depth, writer[0].wait_seconds);
+	for (i=0; i<writer[0].depth; i++)
+		free(writer[0].snapshots[i].values);
+	free(writer[0].snapshots);
+	pthread_mutex_destroy(&(writer[0].mutex));
+	pthread_cond_destroy(&(writer[0].not_empty));
+	pthread_cond_destroy(&(writer[0].not_full));
+	free(writer);
+	return;
+} /*end output_writer*/
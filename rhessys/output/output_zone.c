@@ -32,17 +32,20 @@
 void	output_zone(	int basinID, int hillID,
 					struct	zone_object	*zone,
 					struct	date	current_date,
-					FILE *outfile)
+					FILE *outfile,
+					struct column_file_object *columns)
 {
 	/*------------------------------------------------------*/
 	/*	Local Function Declarations.						*/
 	/*------------------------------------------------------*/
+	int	output_record(FILE *, struct column_file_object *, char *, ...)
+		__attribute__((format(printf, 3, 4)));
 	
 	/*------------------------------------------------------*/
 	/*	Local Variable Definition. 							*/
 	/*------------------------------------------------------*/
-	fprintf(outfile,
-		"%4d %4d %4d %3d %3d %3d %f %f %f %f %f %f %f %f %f %f %f %f %f %f %f %f %f %f %f %f %f %f %f %f\n ",
+	output_record(outfile, columns,
+		"%4ld %4ld %4ld %3d %3d %3d %f %f %f %f %f %f %f %f %f %f %f %f %f %f %f %f %f %f %f %f %f %f %f %f\n ",
 		current_date.day,
 		current_date.month,
 		current_date.year,
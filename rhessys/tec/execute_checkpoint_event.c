@@ -0,0 +1,155 @@
+/*--------------------------------------------------------------*/
+/* 																*/
+/*					execute_checkpoint_event					*/
+/*																*/
+/*	execute_checkpoint_event - writes a binary checkpoint		*/
+/*																*/
+/*	NAME														*/
+/*	execute_checkpoint_event - writes a binary checkpoint		*/
+/*																*/
+/*	SYNOPSIS													*/
+/*	void	request_checkpoint(void)							*/
+/*	void	install_checkpoint_signal(void)						*/
+/*	int	checkpoint_requested(void)								*/
+/*	void	checkpoint_sizes(size_t *sizes)						*/
+/*	void	execute_checkpoint_event(							*/
+/*					struct	world_object	*world,				*/
+/*					struct	command_line_object *command_line,	*/
+/*					struct	date	resume_date,				*/
+/*					long	tec_offset)							*/
+/*																*/
+/*	OPTIONS														*/
+/*	tec event output_checkpoint, signal SIGUSR1					*/
+/*																*/
+/*	DESCRIPTION													*/
+/*																*/
+/*	The output_checkpoint tec event (request_checkpoint) or a	*/
+/*	SIGUSR1 sent to the process asks for a checkpoint.  It is	*/
+/*	written by execute_tec once the day under way and its		*/
+/*	daily, monthly and yearly output are done, to				*/
+/*																*/
+/*		<worldfile>.Y<year>M<month>D<day>H1.checkpoint			*/
+/*																*/
+/*	named, like the state files, for the date the run resumes	*/
+/*	at.  It holds a checkpoint_header_object (the resume date,	*/
+/*	where execute_tec is in the tec file, the output flags set	*/
+/*	by tec events and the world's daily values) followed by		*/
+/*	the objects of the world (see checkpoint_world).  rhessys	*/
+/*	-restart <file>, with the options and files of the first	*/
+/*	run, continues from it (see restore_checkpoint).			*/
+/*																*/
+/*	checkpoint_sizes gives the object sizes recorded in the		*/
+/*	header: the file is only read by the same build of rhessys	*/
+/*																*/
+/*	PROGRAMMER NOTES											*/
+/*																*/
+/*	the signal handler only sets the request; the checkpoint	*/
+/*	is written between days, outside the parallel regions		*/
+/*--------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include "rhessys.h"
+
+static volatile sig_atomic_t checkpoint_due = 0;
+
+static void checkpoint_signal(int signal_number)
+{
+	checkpoint_due = 1;
+}
+
+void	request_checkpoint(void)
+{
+	checkpoint_due = 1;
+}
+
+void	install_checkpoint_signal(void)
+{
+	signal(SIGUSR1, checkpoint_signal);
+}
+
+int	checkpoint_requested(void)
+{
+	return(checkpoint_due != 0);
+}
+
+void	checkpoint_sizes(size_t *sizes)
+{
+	sizes[0] = sizeof(struct basin_object);
+	sizes[1] = sizeof(struct stream_network_object);
+	sizes[2] = sizeof(struct hillslope_object);
+	sizes[3] = sizeof(struct zone_object);
+	sizes[4] = sizeof(struct patch_object);
+	sizes[5] = sizeof(struct canopy_strata_object);
+	sizes[6] = sizeof(struct layer_object);
+	sizes[7] = sizeof(struct checkpoint_header_object);
+}
+
+void	execute_checkpoint_event(
+								 struct	world_object	*world,
+								 struct	command_line_object *command_line,
+								 struct	date	resume_date,
+								 long	tec_offset)
+{
+	/*--------------------------------------------------------------*/
+	/*	Local function definition.									*/
+	/*--------------------------------------------------------------*/
+	void	checkpoint_world(struct world_object *, struct command_line_object *,
+		FILE *, char *, int);
+	/*--------------------------------------------------------------*/
+	/*	Local variable definition.									*/
+	/*--------------------------------------------------------------*/
+	int	b, h, z;
+	FILE	*file;
+	char	filename[FILEPATH_LEN+100];
+	struct	checkpoint_header_object	header;
+
+	checkpoint_due = 0;
+	strcpy(filename, command_line[0].world_filename);
+	if (command_line[0].ensemble_member > 0)
+		sprintf(filename + strlen(filename), "_m%d", command_line[0].ensemble_member);
+	sprintf(filename + strlen(filename), ".Y%4ldM%ldD%ldH%ld.checkpoint",
+		resume_date.year, resume_date.month, resume_date.day, resume_date.hour);
+	if ((file = fopen(filename, "wb")) == NULL) {
+		fprintf(stderr,"FATAL ERROR: in execute_checkpoint_event, cannot open %s\n",
+			filename);
+		exit(EXIT_FAILURE);
+	}
+
+	memset(&header, 0, sizeof(struct checkpoint_header_object));
+	memcpy(header.magic, CHECKPOINT_MAGIC, 8);
+	header.version = CHECKPOINT_VERSION;
+	checkpoint_sizes(header.sizes);
+	header.num_basins = world[0].num_basin_files;
+	header.num_patches = 0;
+	for (b=0; b<world[0].num_basin_files; b++)
+		for (h=0; h<world[0].basins[b][0].num_hillslopes; h++)
+			for (z=0; z<world[0].basins[b][0].hillslopes[h][0].num_zones; z++)
+				header.num_patches +=
+					world[0].basins[b][0].hillslopes[h][0].zones[z][0].num_patches;
+	header.resume_date = resume_date;
+	header.tec_offset = tec_offset;
+	header.output_flags = command_line[0].output_flags;
+	header.road_flag = command_line[0].road_flag;
+	header.year_day = world[0].year_day;
+	header.target_status = world[0].target_status;
+	header.declin = world[0].declin;
+	header.cos_declin = world[0].cos_declin;
+	header.sin_declin = world[0].sin_declin;
+	header.Io = world[0].Io;
+	if (fwrite(&header, sizeof(struct checkpoint_header_object), 1, file) != 1) {
+		fprintf(stderr,"FATAL ERROR: in execute_checkpoint_event, cannot write %s\n",
+			filename);
+		exit(EXIT_FAILURE);
+	}
+
+	checkpoint_world(world, command_line, file, filename, 0);
+	if (fclose(file) != 0) {
+		fprintf(stderr,"FATAL ERROR: in execute_checkpoint_event, cannot write %s\n",
+			filename);
+		exit(EXIT_FAILURE);
+	}
+	printf("\nCheckpoint written to %s\n", filename);
+	return;
+} /*end execute_checkpoint_event*/
@@ -50,35 +50,44 @@ void	execute_daily_output_event(
 		int,
 		struct	basin_object *,
 		struct	date,
-		FILE	*);
+		FILE	*,
+		struct	column_file_object *);
 	
 	void output_hillslope(	int,
 		struct	hillslope_object *,
+		struct	hillslope_sums_object *,
 		struct	date,
-		FILE	*);
+		FILE	*,
+		struct	column_file_object *);
 	
 	void output_zone(	int, int,
 		struct	zone_object *,
 		struct	date,
-		FILE	*);
+		FILE	*,
+		struct	column_file_object *);
 	
 	void output_patch(
 		int, int, int,
 		struct	patch_object *,
 		struct	zone_object *,
 		struct	date,
-		FILE	*);
+		FILE	*,
+		struct	column_file_object *);
 	
 	void output_canopy_stratum(
 		int, int, int, int,
 		struct	canopy_strata_object *,
 		struct	date,
-		FILE	*);
+		FILE	*,
+		struct	column_file_object *);
 	void output_shadow_strata(
 		int, int, int, int,
 		struct	canopy_strata_object *,
 		struct	date,
 		FILE	*);
+	void output_spec(
+		struct	output_spec_object *,
+		struct	date);
         void output_stream_routing(
 		struct	stream_network_object *,
 		struct	date,
@@ -89,6 +98,11 @@ void	execute_daily_output_event(
 	int	basinID, hillID, patchID, zoneID, stratumID,reachID;
 	int b,h,p,z,c,s;
 	/*--------------------------------------------------------------*/
+	/*	output the values listed by -outspec					*/
+	/*--------------------------------------------------------------*/
+	if ((outfile != NULL) && (outfile[0].spec != NULL))
+		output_spec(outfile[0].spec, date);
+	/*--------------------------------------------------------------*/
 	/*	check to see if there are any print options					*/
 	/*--------------------------------------------------------------*/
 		/*--------------------------------------------------------------*/
@@ -130,7 +144,8 @@ void	execute_daily_output_event(
 					command_line[0].routing_flag,
 					world[0].basins[b],
 					date,
-					outfile->basin->daily);
+					outfile->basin->daily,
+					outfile->basin->daily_columns);
 			}
 			/*--------------------------------------------------------------*/
 			/*	check to see if there are any lower print options			*/
@@ -154,8 +169,10 @@ void	execute_daily_output_event(
 								output_hillslope(
 								world[0].basins[b][0].ID,
 								world[0].basins[b]->hillslopes[h],
+								&(world[0].basins[b][0].hillslopes[h][0].daily_sums),
 								date,
-								outfile->hillslope->daily);
+								outfile->hillslope->daily,
+								outfile->hillslope->daily_columns);
 					}
 					/*-------------------------------------------------------------*/
 					/*	check to see if there are any lower print options			*/
@@ -185,7 +202,8 @@ void	execute_daily_output_event(
 											world[0].basins[b][0].ID,
 											world[0].basins[b][0].hillslopes[h][0].ID,
 											world[0].basins[b]->hillslopes[h]->zones[z],
-											date, outfile->zone->daily);
+											date, outfile->zone->daily,
+											outfile->zone->daily_columns);
 							}
 							/*-------------------------------------------------------*/
 							/*	check to see if there are any lower print options		*/
@@ -221,7 +239,8 @@ void	execute_daily_output_event(
 															world[0].basins[b]->hillslopes[h]->zones[z]->patches[p],
 															world[0].basins[b]->hillslopes[h]->zones[z],
 															date,
-															outfile->patch->daily);
+															outfile->patch->daily,
+															outfile->patch->daily_columns);
 													}
 									}
 									/*------------------------------------------------*/
@@ -255,7 +274,8 @@ void	execute_daily_output_event(
 																world[0].basins[b][0].hillslopes[h][0].zones[z][0].ID,
 																world[0].basins[b][0].hillslopes[h][0].zones[z][0].patches[p][0].ID,
 																world[0].basins[b]->hillslopes[h]->zones[z]->patches[p]->canopy_strata[c],
-																date, outfile->canopy_stratum->daily);
+																date, outfile->canopy_stratum->daily,
+																outfile->canopy_stratum->daily_columns);
 															}
 										} /* end stratum (c) for loop */
 									} /* end if options */
@@ -51,24 +51,29 @@ void	execute_hourly_output_event(
 	
 	void output_hillslope( int,
 		struct	hillslope_object *,
+		struct	hillslope_sums_object *,
 		struct	date,
-		FILE	*);
+		FILE	*,
+		struct	column_file_object *);
 	
 	void output_zone(	int, int,
 		struct	zone_object *,
 		struct	date,
-		FILE	*);
+		FILE	*,
+		struct	column_file_object *);
 	
 	void output_patch(	int, int,int,
 		struct	patch_object *,
 		struct	zone_object *,
 		struct	date,
-		FILE	*);
+		FILE	*,
+		struct	column_file_object *);
 	
 	void output_canopy_stratum( int, int, int, int,
 		struct	canopy_strata_object *,
 		struct	date,
-		FILE	*);
+		FILE	*,
+		struct	column_file_object *);
 	/*--------------------------------------------------------------*/
 	/*	Local variable definition.									*/
 	/*--------------------------------------------------------------*/
@@ -118,8 +123,9 @@ void	execute_hourly_output_event(
 								output_hillslope(
 								world[0].basins[b][0].ID,
 								world[0].basins[b]->hillslopes[h],
+								NULL,
 								date,
-								outfile->hillslope->hourly);
+								outfile->hillslope->hourly, NULL);
 					}
 					/*------------------------------------------------------------*/
 					/*	check to see if there are any lower print options			*/
@@ -186,7 +192,7 @@ void	execute_hourly_output_event(
 														world[0].basins[b]->hillslopes[h]->zones[z]->patches[p],
 														world[0].basins[b]->hillslopes[h]->zones[z],
 														date,
-														outfile->patch->hourly);
+														outfile->patch->hourly, NULL);
 									}
 									/*-----------------------------------------------*/
 									/*	Construct the canopy_stratum output files		 */
@@ -220,7 +226,7 @@ void	execute_hourly_output_event(
 																world[0].basins[b][0].hillslopes[h][0].zones[z][0].patches[p][0].ID,
 																world[0].basins[b]->hillslopes[h]->zones[z]->patches[p]->canopy_strata[c],
 																date,
-																outfile->canopy_stratum->hourly);
+																outfile->canopy_stratum->hourly, NULL);
 										} /* end stratum (c) for loop */
 									} /* end if options */
 								} /* end patch (p) for loop */
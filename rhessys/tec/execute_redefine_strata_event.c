@@ -55,13 +55,16 @@ void	execute_redefine_strata_event(struct world_object *world,
 		struct patch_object *,
 		struct canopy_strata_object *);
 	struct patch_object	*find_patch( int,
-		int, int, int,
+		int, int,
+		struct basin_object *);
+	struct basin_object	*find_basin( int,
 		struct world_object *);
 	struct canopy_strata_object	*find_stratum( int, int,
 		int, int, int,
 		struct world_object *);
 	struct canopy_strata_object	*find_stratum_in_patch( int, 
-		struct patch_object *);
+		struct patch_object *,
+		struct basin_object *);
 	/*--------------------------------------------------------------*/
 	/*	Local variable definition.									*/
 	/*--------------------------------------------------------------*/
@@ -74,6 +77,7 @@ void	execute_redefine_strata_event(struct world_object *world,
 	char	ext[11];
 	struct	canopy_strata_object	*stratum;
 	struct	patch_object	*patch;
+	struct	basin_object	*basin;
 	/*--------------------------------------------------------------*/
 	/*	Try to open the world file in read mode.					*/
 	/*--------------------------------------------------------------*/
@@ -105,6 +109,13 @@ void	execute_redefine_strata_event(struct world_object *world,
 	for (b=0; b < num_basin; b++ ){
 		fscanf(stratum_file,"%d",&basin_ID);
 		read_record(stratum_file, record);
+		basin = find_basin(basin_ID, world);
+		if (basin == NULL) {
+			fprintf(stderr,
+				"FATAL ERROR: Could not find basin %d in redefine strata\n",
+				basin_ID);
+			exit(EXIT_FAILURE);
+		}
 		fscanf(stratum_file,"%d",&num_hill);
 		read_record(stratum_file, record);
 		for ( h = 0; h < num_hill; h++){
@@ -128,9 +139,9 @@ void	execute_redefine_strata_event(struct world_object *world,
 						patch = find_patch(patch_ID,
 							zone_ID,
 							hill_ID,
-							basin_ID,
-							world);
-						stratum = find_stratum_in_patch(stratum_ID, patch);
+							basin);
+						stratum = find_stratum_in_patch(stratum_ID, patch,
+							basin);
 						input_new_strata(command_line, stratum_file,
 							world[0].num_base_stations,
 							world[0].base_stations,
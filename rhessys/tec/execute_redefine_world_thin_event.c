@@ -105,11 +105,14 @@ void	execute_redefine_world_thin_event(struct world_object *world,
 	
 	void compute_mean_hillslope_parameters( struct hillslope_object *);
 	struct canopy_strata_object	*find_stratum_in_patch( int, 
-		struct patch_object *);
+		struct patch_object *,
+		struct basin_object *);
 	struct patch_object	*find_patch_in_zone( int, 
-		struct zone_object *);
+		struct zone_object *,
+		struct basin_object *);
 	struct zone_object	*find_zone_in_hillslope( int, 
-		struct hillslope_object *);
+		struct hillslope_object *,
+		struct basin_object *);
 	struct hillslope_object	*find_hillslope_in_basin( int, 
 		struct basin_object *);
 	struct basin_object	*find_basin( int, 
@@ -189,7 +192,7 @@ void	execute_redefine_world_thin_event(struct world_object *world,
 				for ( z=0; z < num_zone; z++) {
 					fscanf(world_input_file,"%d",&zone_ID);
 					read_record(world_input_file, record);
-					zone = find_zone_in_hillslope(zone_ID,hillslope);
+					zone = find_zone_in_hillslope(zone_ID,hillslope,basin);
 					if (zone != NULL) {
 						input_new_zone_mult(command_line, world_input_file,
 								   world[0].num_base_stations,
@@ -201,7 +204,7 @@ void	execute_redefine_world_thin_event(struct world_object *world,
 						for (p=0; p < num_patch; p++) {
 							fscanf(world_input_file,"%d",&patch_ID);
 							read_record(world_input_file, record);
-							patch = find_patch_in_zone(patch_ID, zone);
+							patch = find_patch_in_zone(patch_ID, zone, basin);
 							if (patch != NULL) {
 								input_new_patch_mult(command_line, world_input_file,
 										world[0].num_base_stations,
@@ -213,7 +216,7 @@ void	execute_redefine_world_thin_event(struct world_object *world,
 								for (c=0; c < num_stratum; c++) {
 									fscanf(world_input_file,"%d",&stratum_ID);
 									read_record(world_input_file, record);
-									stratum = find_stratum_in_patch(stratum_ID,patch);
+									stratum = find_stratum_in_patch(stratum_ID,patch,basin);
 									if (stratum != NULL) {
 										input_new_strata_thin(command_line, world_input_file,
 											 world[0].num_base_stations,
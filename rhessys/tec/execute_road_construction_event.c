@@ -48,21 +48,25 @@ void execute_road_construction_event(
 	
 
 	void *alloc(size_t, char *, char *);
+	void construct_basin_routing(
+		struct basin_object *,
+		struct	command_line_object *,
+		char *,
+		char *);
+	void destroy_basin_routing(
+		struct basin_object *);
 	/*--------------------------------------------------------------*/
 	/*	Local variable definition.									*/
 	/*--------------------------------------------------------------*/
 	int		i, b;
 	char		routing_filename[MAXSTR];
-	char		ext[11];
+	char		surface_routing_filename[MAXSTR];
+	char		ext[32];
 
 	struct	basin_object	*basin;
 	
 	for (b=0; b< world[0].num_basin_files; b++) {
 		basin = world[0].basins[b];
-		free(basin->route_list->list);
-		free(basin->route_list);
-		free(basin->surface_route_list->list);
-		free(basin->surface_route_list);
 		/*--------------------------------------------------------------*/
 		/*  Read in a new routing topology file.                    */
 		/*--------------------------------------------------------------*/
@@ -73,21 +77,15 @@ void execute_road_construction_event(
 		strncpy(routing_filename, command_line[0].routing_filename, MAXSTR);
 		strncat(routing_filename, ext, MAXSTR);
 		printf("\nRedefining Flow Connectivity using %s\n", routing_filename);
-		basin->route_list = construct_routing_topology( routing_filename, basin, command_line, false );
-
 		if ( command_line->surface_routing_flag ) {
-			strncpy(routing_filename, command_line->surface_routing_filename, MAXSTR);
-			strncat(routing_filename, ext, MAXSTR);
-			printf("\nRedefining Surface Flow Connectivity using %s\n", routing_filename);
-		}
-		basin->surface_route_list = construct_routing_topology( routing_filename, basin, command_line, true );
-		if (basin->surface_route_list->num_patches != basin->route_list->num_patches) {
-			fprintf(stderr,
-					"\nFATAL ERROR: in execute_road_construction_event, surface routing table has %d patches, but subsurface routing table has %d patches. The number of patches must be identical.\n",
-					basin->surface_route_list->num_patches,
-					basin->route_list->num_patches);
-			exit(EXIT_FAILURE);
+			strncpy(surface_routing_filename, command_line->surface_routing_filename, MAXSTR);
+			strncat(surface_routing_filename, ext, MAXSTR);
+			printf("\nRedefining Surface Flow Connectivity using %s\n", surface_routing_filename);
 		}
+		destroy_basin_routing(basin);
+		construct_basin_routing(basin, command_line, routing_filename,
+			(command_line->surface_routing_flag) ? surface_routing_filename : NULL);
+		basin[0].road_date = current_date;
 
 	} /* end basins */
 	return;
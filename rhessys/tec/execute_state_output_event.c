@@ -20,6 +20,7 @@
 /*	DESCRIPTION													*/
 /*																*/
 /*	outputs current world state - in worldfile format			*/
+/*	(an ensemble member's as <worldfile>_m<member>.Y...state)	*/
 /*																*/
 /*	PROGRAMMER NOTES											*/
 /*																*/
@@ -27,6 +28,7 @@
 /*--------------------------------------------------------------*/
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include "rhessys.h"
 
 void	execute_state_output_event(
@@ -59,6 +61,8 @@ void	execute_state_output_event(
 		current_date.hour);
 
 	strcpy(filename, command_line[0].world_filename);
+	if (command_line[0].ensemble_member > 0)
+		sprintf(filename + strlen(filename), "_m%d", command_line[0].ensemble_member);
 	strcat(filename, ext);
 	strcat(filename, ".state");
 
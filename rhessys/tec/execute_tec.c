@@ -110,6 +110,14 @@ void	execute_tec(
 	
 	struct	tec_entry	*construct_tec_entry( struct date, char * );
 	
+	void	stop_output_writer(void);
+	void	destroy_output_files(
+		struct command_line_object *,
+		struct world_output_file_object *);
+	void	update_clim_window(
+		struct clim_window_object *,
+		long);
+	
 	void	world_daily_I(
 		long,
 		struct world_object *,
@@ -183,10 +191,29 @@ void	execute_tec(
 		struct date,
 		struct command_line_object *);
 
+	int	checkpoint_requested(void);
+
+	void	update_spinup_active_set(
+		struct	world_object *,
+		struct	command_line_object *,
+		struct	date);
+
+	void	update_soil_spinup(
+		struct	world_object *,
+		struct	command_line_object *,
+		struct	date);
+
+	void	execute_checkpoint_event(
+		struct	world_object *,
+		struct	command_line_object *,
+		struct	date,
+		long);
+
 	/*--------------------------------------------------------------*/
 	/*	Local Variable Definition. 									*/
 	/*--------------------------------------------------------------*/
 	int check;
+	long	tec_offset;
 	long	day;
 	long	hour;
 	long	month;
@@ -208,6 +235,7 @@ void	execute_tec(
 	/*--------------------------------------------------------------*/
 	
 	event =  construct_tec_entry(world[0].end_date,"none");
+	tec_offset = -1;
 	
 	/*--------------------------------------------------------------*/
 	/*	Loop from the start of the world to the end of the world.	*/
@@ -226,7 +254,9 @@ void	execute_tec(
 		if ( !(feof(tecfile[0].tfile))){
 			/*--------------------------------------------------------------*/
 			/*			read in the next tec line.							*/
+			/*			(where it starts is kept for a checkpoint)			*/
 			/*--------------------------------------------------------------*/
+			tec_offset = ftell(tecfile[0].tfile);
 			check = fscanf(tecfile[0].tfile,"%d %d %d %d %s\n",
 				&(event[0].cal_date.year),
 				&(event[0].cal_date.month),
@@ -247,6 +277,7 @@ void	execute_tec(
 		/*--------------------------------------------------------------*/
 		else{
 			event =  construct_tec_entry(world[0].end_date, "none");
+			tec_offset = -1;
 		} /*end if-else*/
 		/*--------------------------------------------------------------*/
 		/*		If the next event's date exceeds the end_date then		*/
@@ -267,6 +298,7 @@ void	execute_tec(
                    current_date.year,current_date.month,current_date.day);
             //fflush(stdout);
 			if ( current_date.hour == 1 ){
+				update_clim_window(world[0].clim_window, day);
                 world_daily_I(
 					day,
 					world,
@@ -344,6 +376,11 @@ void	execute_tec(
 				if((command_line[0].vegspinup_flag > 0) && (world[0].target_status > 0)) {
 		      execute_state_output_event(world, current_date, world[0].end_date,command_line);
           printf("\nSpinup completed YEAR %d MONTH %d DAY %d \n", current_date.year,current_date.month,current_date.day);
+          /* queued records and column blocks are written on closing */
+          stop_output_writer();
+          destroy_output_files(command_line, outfile);
+          if (command_line[0].grow_flag > 0)
+            destroy_output_files(command_line, growth_outfile);
           exit(0);
         } 
 
@@ -423,7 +460,12 @@ void	execute_tec(
 			if ( next_date.year != current_date.year ){
 				/*--------------------------------------------------------------*/
 				/*				Do yearly stuff.								*/
+				/*				(spinup progress, held patches, soil pools)		*/
 				/*--------------------------------------------------------------*/
+				if (command_line[0].vegspinup_flag > 0)
+					update_spinup_active_set(world, command_line, current_date);
+				if (command_line[0].soilspinup_flag > 0)
+					update_soil_spinup(world, command_line, current_date);
 				
 				/*--------------------------------------------------------------*/
 				/*				increment year  								*/
@@ -432,6 +474,12 @@ void	execute_tec(
 				year = year + 1;
 				current_date.year= next_date.year;
 			}  /*end if*/
+			/*--------------------------------------------------------------*/
+			/*			Write a checkpoint asked for during the day (tec	*/
+			/*			output_checkpoint or SIGUSR1) now that it is done.	*/
+			/*--------------------------------------------------------------*/
+			if ((current_date.hour == 1) && (checkpoint_requested() == 1))
+				execute_checkpoint_event(world, command_line, current_date, tec_offset);
 			} /*end while*/
 		} /*end while*/
 		return;
@@ -80,6 +80,7 @@ void	handle_event(
 		struct date,
 		struct date,
 		struct command_line_object *);
+	void	request_checkpoint(void);
 	/*--------------------------------------------------------------*/
 	/*	Local variable definition.									*/
 	/*--------------------------------------------------------------*/
@@ -167,6 +168,10 @@ void	handle_event(
 		execute_state_output_event(world, current_date,
 			world[0].end_date,command_line);
 	}
+	else if ( !strcmp(event[0].command,"output_checkpoint") ){
+		/* written at the end of the day, see execute_tec */
+		request_checkpoint();
+	}
 	else if ( !strcmp(event[0].command,"redefine_strata") ){
 		execute_redefine_strata_event(world, command_line, current_date);
 	}
@@ -78,11 +78,28 @@ int	 valid_option( char *command_line){
 		(strcmp(command_line,"-whdr") == 0) ||
 		(strcmp(command_line,"-netcdf") == 0) ||
 		(strcmp(command_line,"-climrepeat") == 0) ||
+		(strcmp(command_line,"-parallelrouting") == 0) ||
+		(strcmp(command_line,"-hillsched") == 0) ||
+		(strcmp(command_line,"-hillschedreport") == 0) ||
+		(strcmp(command_line,"-basinparallel") == 0) ||
+		(strcmp(command_line,"-seed") == 0) ||
+		(strcmp(command_line,"-wconvert") == 0) ||
+		(strcmp(command_line,"-climwindow") == 0) ||
+		(strcmp(command_line,"-climcache") == 0) ||
+		(strcmp(command_line,"-colout") == 0) ||
+		(strcmp(command_line,"-coldump") == 0) ||
+		(strcmp(command_line,"-outspec") == 0) ||
+		(strcmp(command_line,"-outbuffer") == 0) ||
+		(strcmp(command_line,"-restart") == 0) ||
+		(strcmp(command_line,"-ensemble") == 0) ||
+		(strcmp(command_line,"-objective") == 0) ||
 
 		(strcmp(command_line,"-template") == 0) ||
 		(strcmp(command_line,"-fs") == 0) ||
 
 		(strcmp(command_line,"-vegspinup") == 0) ||
+		(strcmp(command_line,"-vegspinupfreeze") == 0) ||
+		(strcmp(command_line,"-soilspinup") == 0) ||
 		(strcmp(command_line,"-template") == 0))
 
 		i = 0;
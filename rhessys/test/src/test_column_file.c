@@ -0,0 +1,140 @@
+/** @file test_column_file.c
+ *
+ * 	@brief Unit tests of the column output files (-colout)
+ * 	@note To compile: see the test target of the makefile
+ */
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <glib.h>
+
+#include "functions.h"
+
+
+/* more than one block of rows */
+#define NUM_ROWS (COLUMN_BLOCK_ROWS + 10)
+
+
+/* what dump_column_file prints, in a string */
+static char *dump_to_string(char *filename) {
+
+	int saved;
+	long size;
+	char *text;
+	FILE *dump = tmpfile();
+
+	g_assert(dump != NULL);
+	fflush(stdout);
+	saved = dup(fileno(stdout));
+	dup2(fileno(dump), fileno(stdout));
+	dump_column_file(filename);
+	fflush(stdout);
+	dup2(saved, fileno(stdout));
+	close(saved);
+
+	size = ftell(dump);
+	text = calloc(size + 1, 1);
+	rewind(dump);
+	g_assert(fread(text, 1, size, dump) == (size_t) size);
+	fclose(dump);
+	return text;
+}
+
+static double row_value(int row) {
+	return row * 0.125 - 3.0;
+}
+
+void test_column_file_round_trip() {
+
+	int row;
+	char filename[] = "test_column_file.rcol";
+	char line[256];
+	char *text, *next;
+	struct column_file_object *columns = construct_column_file(filename);
+
+	column_file_name(columns, "day");
+	column_file_name(columns, "ID");
+	column_file_name(columns, "flow");
+	column_file_end_row(columns);
+	for (row = 0; row < NUM_ROWS; row++) {
+		column_file_int(columns, row % 31 + 1);
+		column_file_int(columns, -row);
+		column_file_double(columns, row_value(row));
+		column_file_end_row(columns);
+	}
+	destroy_column_file(columns);
+
+	text = dump_to_string(filename);
+	remove(filename);
+	next = text;
+	g_assert(strncmp(next, "day ID flow\n", 12) == 0);
+	next += 12;
+	for (row = 0; row < NUM_ROWS; row++) {
+		sprintf(line, "%d %d %lf\n", row % 31 + 1, -row, row_value(row));
+		g_assert(strncmp(next, line, strlen(line)) == 0);
+		next += strlen(line);
+	}
+	g_assert(*next == '\0');
+	free(text);
+}
+
+void test_column_file_names_only() {
+
+	/* without records the names are kept as double columns */
+	char filename[] = "test_column_file_names.rcol";
+	char *text;
+	struct column_file_object *columns = construct_column_file(filename);
+
+	column_file_name(columns, "day");
+	column_file_name(columns, "flow");
+	column_file_end_row(columns);
+	destroy_column_file(columns);
+
+	text = dump_to_string(filename);
+	remove(filename);
+	g_assert(strcmp(text, "day flow\n") == 0);
+	free(text);
+}
+
+void test_column_file_wide() {
+
+	/* a header wider than the first column arrays */
+	int c;
+	char filename[] = "test_column_file_wide.rcol";
+	char name[32];
+	char *text, *next;
+	struct column_file_object *columns = construct_column_file(filename);
+
+	for (c = 0; c < 1500; c++) {
+		sprintf(name, "c%d", c);
+		column_file_name(columns, name);
+	}
+	column_file_end_row(columns);
+	for (c = 0; c < 1500; c++)
+		column_file_int(columns, c);
+	column_file_end_row(columns);
+	destroy_column_file(columns);
+
+	text = dump_to_string(filename);
+	remove(filename);
+	next = strchr(text, '\n');
+	g_assert(next != NULL);
+	g_assert(strncmp(text, "c0 c1 ", 6) == 0);
+	g_assert(strncmp(next - 6, " c1499\n", 7) == 0);
+	g_assert(strncmp(next + 1, "0 1 2 ", 6) == 0);
+	g_assert(strcmp(text + strlen(text) - 6, " 1499\n") == 0);
+	free(text);
+}
+
+int main(int argc, char **argv) {
+	g_test_init(&argc, &argv, NULL);
+
+	g_test_add_func("/set1/test column file round trip", test_column_file_round_trip);
+	g_test_add_func("/set1/test column file names only", test_column_file_names_only);
+	g_test_add_func("/set1/test column file wide", test_column_file_wide);
+
+	return g_test_run();
+}
@@ -0,0 +1,122 @@
+/** @file test_construct_id_index.c
+ *
+ * 	@brief Unit tests of the basin ID index
+ * 	@note To compile: see the test target of the makefile
+ */
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <glib.h>
+
+#include "functions.h"
+
+
+#define NUM_HILLSLOPES 2
+#define NUM_ZONES 3
+#define NUM_PATCHES 4
+#define NUM_STRATA 2
+
+
+/* patch IDs repeat under every zone and zone IDs under every hillslope,
+ * as they do in world files */
+static struct basin_object *test_basin() {
+
+	int h, z, p, c;
+	struct basin_object *basin;
+	struct hillslope_object *hillslope;
+	struct zone_object *zone;
+	struct patch_object *patch;
+
+	basin = calloc(1, sizeof(struct basin_object));
+	basin->ID = 1;
+	basin->num_hillslopes = NUM_HILLSLOPES;
+	basin->hillslopes = calloc(NUM_HILLSLOPES, sizeof(struct hillslope_object *));
+	for (h = 0; h < NUM_HILLSLOPES; h++) {
+		hillslope = basin->hillslopes[h] = calloc(1, sizeof(struct hillslope_object));
+		hillslope->ID = 10 + h;
+		hillslope->num_zones = NUM_ZONES;
+		hillslope->zones = calloc(NUM_ZONES, sizeof(struct zone_object *));
+		for (z = 0; z < NUM_ZONES; z++) {
+			zone = hillslope->zones[z] = calloc(1, sizeof(struct zone_object));
+			zone->ID = 100 + z;
+			zone->num_patches = NUM_PATCHES;
+			zone->patches = calloc(NUM_PATCHES, sizeof(struct patch_object *));
+			for (p = 0; p < NUM_PATCHES; p++) {
+				patch = zone->patches[p] = calloc(1, sizeof(struct patch_object));
+				patch->ID = 1000 + p;
+				patch->num_canopy_strata = NUM_STRATA;
+				patch->canopy_strata = calloc(NUM_STRATA, sizeof(struct canopy_strata_object *));
+				for (c = 0; c < NUM_STRATA; c++) {
+					patch->canopy_strata[c] = calloc(1, sizeof(struct canopy_strata_object));
+					patch->canopy_strata[c]->ID = 10000 + c;
+				}
+			}
+		}
+	}
+	return basin;
+}
+
+void test_id_index_finds_every_object() {
+
+	int h, z, p, c;
+	struct basin_object *basin = test_basin();
+	struct id_index_object *index = construct_id_index(basin);
+	struct hillslope_object *hillslope;
+	struct zone_object *zone;
+	struct patch_object *patch;
+
+	g_assert_cmpint(index->count, ==, NUM_HILLSLOPES * (1 + NUM_ZONES
+		* (1 + NUM_PATCHES * (1 + NUM_STRATA))));
+	g_assert_cmpint(index->size, >=, 2 * index->count);
+	for (h = 0; h < NUM_HILLSLOPES; h++) {
+		hillslope = basin->hillslopes[h];
+		g_assert(find_in_id_index(index, basin, hillslope->ID) == hillslope);
+		for (z = 0; z < NUM_ZONES; z++) {
+			zone = hillslope->zones[z];
+			g_assert(find_in_id_index(index, hillslope, zone->ID) == zone);
+			for (p = 0; p < NUM_PATCHES; p++) {
+				patch = zone->patches[p];
+				g_assert(find_in_id_index(index, zone, patch->ID) == patch);
+				for (c = 0; c < NUM_STRATA; c++)
+					g_assert(find_in_id_index(index, patch, patch->canopy_strata[c]->ID)
+						== patch->canopy_strata[c]);
+			}
+		}
+	}
+}
+
+void test_id_index_misses() {
+
+	struct basin_object *basin = test_basin();
+	struct id_index_object *index = construct_id_index(basin);
+	struct zone_object *zone = basin->hillslopes[0]->zones[0];
+
+	g_assert(find_in_id_index(index, basin, 99) == NULL);
+	g_assert(find_in_id_index(index, zone, 1000 + NUM_PATCHES) == NULL);
+	/* a patch ID under a hillslope is not a zone */
+	g_assert(find_in_id_index(index, basin->hillslopes[0], 1000) == NULL);
+	g_assert(find_in_id_index(NULL, basin, 10) == NULL);
+	g_assert(find_in_id_index(index, NULL, 10) == NULL);
+}
+
+void test_id_index_repeated_id() {
+
+	/* a repeated ID keeps the first object, as the linear scans did */
+	struct basin_object *basin = test_basin();
+	struct zone_object *zone = basin->hillslopes[1]->zones[2];
+	struct id_index_object *index;
+
+	zone->patches[3]->ID = zone->patches[1]->ID;
+	index = construct_id_index(basin);
+	g_assert(find_in_id_index(index, zone, zone->patches[1]->ID) == zone->patches[1]);
+}
+
+int main(int argc, char **argv) {
+	g_test_init(&argc, &argv, NULL);
+
+	g_test_add_func("/set1/test id index finds every object", test_id_index_finds_every_object);
+	g_test_add_func("/set1/test id index misses", test_id_index_misses);
+	g_test_add_func("/set1/test id index repeated ID", test_id_index_repeated_id);
+
+	return g_test_run();
+}
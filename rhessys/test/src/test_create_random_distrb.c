@@ -0,0 +1,113 @@
+/** @file test_create_random_distrb.c
+ *
+ * 	@brief Unit tests of the counter based random streams
+ * 	@note To compile: see the test target of the makefile
+ */
+#include <stdio.h>
+#include <math.h>
+
+#include <glib.h>
+
+#include "functions.h"
+
+
+#define NUM_DRAWS 10000
+
+
+static struct date test_date(long year, long month, long day) {
+	struct date date;
+
+	date.year = year;
+	date.month = month;
+	date.day = day;
+	date.hour = 1;
+	return date;
+}
+
+void test_random_stream_repeats() {
+
+	int i;
+	struct random_stream_object a = init_random_stream(42, 7, test_date(2004, 10, 1));
+	struct random_stream_object b = init_random_stream(42, 7, test_date(2004, 10, 1));
+
+	for (i = 0; i < 100; i++)
+		g_assert(random_uniform(&a) == random_uniform(&b));
+}
+
+void test_random_stream_keys() {
+
+	struct date date = test_date(2004, 10, 1);
+	double first;
+	struct random_stream_object base = init_random_stream(42, 7, date);
+	struct random_stream_object seed = init_random_stream(43, 7, date);
+	struct random_stream_object entity = init_random_stream(42, 8, date);
+	struct random_stream_object day = init_random_stream(42, 7, test_date(2004, 10, 2));
+
+	first = random_uniform(&base);
+	g_assert(random_uniform(&seed) != first);
+	g_assert(random_uniform(&entity) != first);
+	g_assert(random_uniform(&day) != first);
+}
+
+void test_random_stream_order() {
+
+	/* draws of one stream do not depend on the draws of another */
+	int i;
+	double alone[10];
+	struct date date = test_date(2004, 10, 1);
+	struct random_stream_object a = init_random_stream(42, 1, date);
+	struct random_stream_object b = init_random_stream(42, 2, date);
+
+	for (i = 0; i < 10; i++)
+		alone[i] = random_uniform(&a);
+	a = init_random_stream(42, 1, date);
+	for (i = 0; i < 10; i++) {
+		random_uniform(&b);
+		g_assert(random_uniform(&a) == alone[i]);
+	}
+}
+
+void test_random_uniform() {
+
+	int i;
+	double u, sum = 0.0;
+	struct random_stream_object stream = init_random_stream(1, 1, test_date(2000, 1, 1));
+
+	for (i = 0; i < NUM_DRAWS; i++) {
+		u = random_uniform(&stream);
+		g_assert(u > 0.0 && u < 1.0);
+		sum += u;
+	}
+	g_assert(fabs(sum / NUM_DRAWS - 0.5) < 0.01);
+
+	u = unifdist(&stream, 2.0, 3.0);
+	g_assert(u > 2.0 && u < 3.0);
+	g_assert(unifdist(&stream, 3.0, 3.0) == 0.0);
+}
+
+void test_normdist() {
+
+	int i;
+	double x, sum = 0.0, sum_square = 0.0;
+	struct random_stream_object stream = init_random_stream(1, 1, test_date(2000, 1, 1));
+
+	for (i = 0; i < NUM_DRAWS; i++) {
+		x = normdist(&stream, 10.0, 2.0);
+		sum += x;
+		sum_square += x * x;
+	}
+	g_assert(fabs(sum / NUM_DRAWS - 10.0) < 0.1);
+	g_assert(fabs(sqrt(sum_square / NUM_DRAWS - (sum / NUM_DRAWS) * (sum / NUM_DRAWS)) - 2.0) < 0.1);
+}
+
+int main(int argc, char **argv) {
+	g_test_init(&argc, &argv, NULL);
+
+	g_test_add_func("/set1/test random stream repeats", test_random_stream_repeats);
+	g_test_add_func("/set1/test random stream keys", test_random_stream_keys);
+	g_test_add_func("/set1/test random stream order", test_random_stream_order);
+	g_test_add_func("/set1/test random_uniform", test_random_uniform);
+	g_test_add_func("/set1/test normdist", test_normdist);
+
+	return g_test_run();
+}
@@ -0,0 +1,172 @@
+/** @file test_update_soil_spinup.c
+ *
+ * 	@brief Unit tests of the soil and litter pool spinup (-soilspinup)
+ * 	@note To compile: see the test target of the makefile
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include <glib.h>
+
+#include "functions.h"
+#include "phys_constants.h"
+
+
+#define EPSILON 0.000000001
+#define DAYS 365.0
+
+/* pools in the order of update_soil_spinup */
+enum { L1, L2, L3, L4, S1, S2, S3, S4 };
+
+
+static struct world_object *test_world(struct patch_object **patch) {
+
+	struct world_object *world;
+	struct basin_object *basin;
+	struct hillslope_object *hillslope;
+	struct zone_object *zone;
+
+	world = calloc(1, sizeof(struct world_object));
+	basin = calloc(1, sizeof(struct basin_object));
+	hillslope = calloc(1, sizeof(struct hillslope_object));
+	zone = calloc(1, sizeof(struct zone_object));
+	*patch = calloc(1, sizeof(struct patch_object));
+	world->num_basin_files = 1;
+	world->basins = calloc(1, sizeof(struct basin_object *));
+	world->basins[0] = basin;
+	basin->num_hillslopes = 1;
+	basin->hillslopes = calloc(1, sizeof(struct hillslope_object *));
+	basin->hillslopes[0] = hillslope;
+	hillslope->num_zones = 1;
+	hillslope->zones = calloc(1, sizeof(struct zone_object *));
+	hillslope->zones[0] = zone;
+	zone->num_patches = 1;
+	zone->patches = calloc(1, sizeof(struct patch_object *));
+	zone->patches[0] = *patch;
+	return world;
+}
+
+/*
+ * One cycle of a linear cascade litr1c -> soil1c -> ... -> soil4c fed by
+ * a constant litter fall into litr1c, with pool means mean[] and daily
+ * decay rates rate[] of which fraction[] is passed on.  The pools end
+ * the cycle where this budget takes them.
+ */
+static void set_cycle(struct patch_object *patch, double litter_fall,
+		double *mean, double *rate, double *fraction) {
+
+	static const int next[] = {S1, -1, -1, -1, S2, S3, S4, -1};
+	struct soil_spinup_object *spinup = &(patch->soil_spinup);
+	double end[NUM_SOIL_SPINUP_POOLS];
+	int j;
+
+	spinup->days = DAYS;
+	spinup->years = 0;
+	for (j = 0; j < NUM_SOIL_SPINUP_POOLS; j++) {
+		spinup->start_c[j] = mean[j];
+		spinup->pool_c[j] = mean[j] * DAYS;
+		spinup->loss_c[j] = rate[j] * mean[j] * DAYS;
+		spinup->transfer_c[j] = fraction[j] * spinup->loss_c[j];
+		end[j] = mean[j] - spinup->loss_c[j];
+	}
+	end[L1] += litter_fall * DAYS;
+	for (j = 0; j < NUM_SOIL_SPINUP_POOLS; j++)
+		if (next[j] >= 0)
+			end[next[j]] += spinup->transfer_c[j];
+
+	patch->litter_cs.litr1c = end[L1];
+	patch->litter_cs.litr2c = end[L2];
+	patch->litter_cs.litr3c = end[L3];
+	patch->litter_cs.litr4c = end[L4];
+	patch->soil_cs.soil1c = end[S1];
+	patch->soil_cs.soil2c = end[S2];
+	patch->soil_cs.soil3c = end[S3];
+	patch->soil_cs.soil4c = end[S4];
+	patch->litter_ns.litr1n = end[L1] / 40.0;
+}
+
+static struct command_line_object test_command_line() {
+
+	struct command_line_object command_line = {0};
+
+	command_line.soilspinup_years = 1;
+	command_line.soilspinup_tolerance = 0.01;
+	return command_line;
+}
+
+void test_soil_spinup_steady_state() {
+
+	double mean[] = {0.05, 0.0, 0.0, 0.0, 0.2, 1.0, 3.0, 5.0};
+	double rate[] = {0.1, 0.0, 0.0, 0.0, 0.01, 0.001, 0.0001, 0.00001};
+	double fraction[] = {0.5, 0.0, 0.0, 0.0, 0.4, 0.3, 0.2, 0.0};
+	struct patch_object *patch;
+	struct world_object *world = test_world(&patch);
+	struct command_line_object command_line = test_command_line();
+	struct date date = {2005, 12, 31, 1};
+
+	set_cycle(patch, 0.01, mean, rate, fraction);
+	update_soil_spinup(world, &command_line, date);
+
+	/* x = (input + f r x of the pool above) / r, down the cascade */
+	g_assert(fabs(patch->litter_cs.litr1c - 0.1) < EPSILON);
+	g_assert(fabs(patch->soil_cs.soil1c - 0.5) < EPSILON);
+	g_assert(fabs(patch->soil_cs.soil2c - 2.0) < EPSILON);
+	g_assert(fabs(patch->soil_cs.soil3c - 6.0) < EPSILON);
+	g_assert(fabs(patch->soil_cs.soil4c - 12.0) < EPSILON);
+	/* pools that do not decay are left as they are */
+	g_assert(patch->litter_cs.litr2c == 0.0);
+	/* soil N at the fixed C:N, litter N at the litter's C:N */
+	g_assert(fabs(patch->soil_ns.soil1n - 0.5 / SOIL1_CN) < EPSILON);
+	g_assert(fabs(patch->litter_ns.litr1n - 0.1 / 40.0) < EPSILON);
+	/* the sums start again */
+	g_assert(patch->soil_spinup.days == 0.0);
+}
+
+void test_soil_spinup_within_tolerance() {
+
+	/* pools already at their steady state are not touched */
+	double mean[] = {0.1, 0.0, 0.0, 0.0, 0.5, 2.0, 6.0, 12.0};
+	double rate[] = {0.1, 0.0, 0.0, 0.0, 0.01, 0.001, 0.0001, 0.00001};
+	double fraction[] = {0.5, 0.0, 0.0, 0.0, 0.4, 0.3, 0.2, 0.0};
+	struct patch_object *patch;
+	struct world_object *world = test_world(&patch);
+	struct command_line_object command_line = test_command_line();
+	struct date date = {2005, 12, 31, 1};
+
+	set_cycle(patch, 0.01, mean, rate, fraction);
+	patch->soil_cs.soil4c += 1.0e-6;
+	update_soil_spinup(world, &command_line, date);
+	g_assert(patch->soil_cs.soil4c == 12.0 + 1.0e-6);
+	g_assert(patch->soil_spinup.days == 0.0);
+}
+
+void test_soil_spinup_partial_year() {
+
+	/* the run's first, partial year is not used */
+	double mean[] = {0.05, 0.0, 0.0, 0.0, 0.2, 1.0, 3.0, 5.0};
+	double rate[] = {0.1, 0.0, 0.0, 0.0, 0.01, 0.001, 0.0001, 0.00001};
+	double fraction[] = {0.5, 0.0, 0.0, 0.0, 0.4, 0.3, 0.2, 0.0};
+	double litr1c;
+	struct patch_object *patch;
+	struct world_object *world = test_world(&patch);
+	struct command_line_object command_line = test_command_line();
+	struct date date = {2005, 12, 31, 1};
+
+	set_cycle(patch, 0.01, mean, rate, fraction);
+	patch->soil_spinup.days = 200.0;
+	litr1c = patch->litter_cs.litr1c;
+	update_soil_spinup(world, &command_line, date);
+	g_assert(patch->litter_cs.litr1c == litr1c);
+	g_assert(patch->soil_spinup.days == 0.0);
+}
+
+int main(int argc, char **argv) {
+	g_test_init(&argc, &argv, NULL);
+
+	g_test_add_func("/set1/test soil spinup steady state", test_soil_spinup_steady_state);
+	g_test_add_func("/set1/test soil spinup within tolerance", test_soil_spinup_within_tolerance);
+	g_test_add_func("/set1/test soil spinup partial year", test_soil_spinup_partial_year);
+
+	return g_test_run();
+}
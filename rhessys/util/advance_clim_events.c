@@ -0,0 +1,100 @@
+/*--------------------------------------------------------------*/
+/* 																*/
+/*					advance_clim_events							*/
+/*																*/
+/*	NAME														*/
+/*	advance_clim_events - moves the dated event cursors of the	*/
+/*		world's base stations to the current date				*/
+/*																*/
+/*	SYNOPSIS													*/
+/*	void advance_daily_clim_events(								*/
+/*				struct world_object *world,						*/
+/*				struct date current_date)						*/
+/*	void advance_hourly_clim_events(							*/
+/*				struct world_object *world,						*/
+/*				struct date current_date)						*/
+/*																*/
+/*	OPTIONS														*/
+/*																*/
+/*	DESCRIPTION													*/
+/*																*/
+/*	Base station event sequences (dated_input, hourly_clim)		*/
+/*	keep a cursor (inx) to the first event not before the		*/
+/*	current date.  advance_daily_clim_events is called by		*/
+/*	world_daily_I and moves the dated_input cursors to the		*/
+/*	current day; advance_hourly_clim_events is called by		*/
+/*	world_hourly and moves the hourly rain and rain duration	*/
+/*	cursors to the current hour.  Zones and patches then only	*/
+/*	read the event under the cursor.							*/
+/*																*/
+/*	PROGRAMMER NOTES											*/
+/*																*/
+/*	zones and patches of different hillslopes and, with			*/
+/*	-basinparallel, of different basins share a base station;	*/
+/*	the cursors are moved here, before the parallel loops, so	*/
+/*	that those loops never write them							*/
+/*																*/
+/*	a cursor stops at the end of its sequence (edate.year 0)	*/
+/*--------------------------------------------------------------*/
+#include <stdio.h>
+#include "rhessys.h"
+
+static void advance_clim_event(
+			struct clim_event_sequence *events,
+			struct date current_date,
+			int hourly)
+{
+	long	julday(struct date);
+	double	today;
+
+	if (events[0].inx <= -999)
+		return;
+	today = julday(current_date);
+	if (hourly == 1)
+		today += current_date.hour / 24.0;
+	while ((events[0].seq[events[0].inx].edate.year != 0)
+		&& (julday(events[0].seq[events[0].inx].edate)
+		+ ((hourly == 1) ? events[0].seq[events[0].inx].edate.hour / 24.0 : 0.0)
+		< today))
+		events[0].inx += 1;
+	return;
+}
+
+void advance_daily_clim_events(
+			struct world_object *world,
+			struct date current_date)
+{
+	int	i;
+	struct	dated_input_object	*dated_input;
+
+	for (i=0; i<world[0].num_base_stations; i++) {
+		dated_input = world[0].base_stations[i][0].dated_input;
+		if (dated_input == NULL)
+			continue;
+		advance_clim_event(&(dated_input[0].fertilizer_NO3), current_date, 0);
+		advance_clim_event(&(dated_input[0].fertilizer_NH4), current_date, 0);
+		advance_clim_event(&(dated_input[0].irrigation), current_date, 0);
+		advance_clim_event(&(dated_input[0].snow_melt_input), current_date, 0);
+		advance_clim_event(&(dated_input[0].biomass_removal_percent), current_date, 0);
+		advance_clim_event(&(dated_input[0].PH), current_date, 0);
+		advance_clim_event(&(dated_input[0].grazing_Closs), current_date, 0);
+	}
+	return;
+} /*end advance_daily_clim_events*/
+
+void advance_hourly_clim_events(
+			struct world_object *world,
+			struct date current_date)
+{
+	int	i;
+	struct	hourly_clim_object	*hourly_clim;
+
+	for (i=0; i<world[0].num_base_stations; i++) {
+		hourly_clim = world[0].base_stations[i][0].hourly_clim;
+		if (hourly_clim == NULL)
+			continue;
+		advance_clim_event(&(hourly_clim[0].rain), current_date, 1);
+		advance_clim_event(&(hourly_clim[0].rain_duration), current_date, 1);
+	}
+	return;
+} /*end advance_hourly_clim_events*/
@@ -0,0 +1,90 @@
+/*--------------------------------------------------------------*/
+/* 																*/
+/*					arena_alloc									*/
+/*																*/
+/*	arena_alloc.c - allocates from the world arena				*/
+/*																*/
+/*	NAME														*/
+/*	arena_alloc.c - allocates from the world arena				*/
+/*																*/
+/*	SYNOPSIS													*/
+/*	void *arena_alloc( 											*/
+/*				struct arena_object *arena,						*/
+/*				int type,										*/
+/*				size_t size,									*/
+/*				char *array_name,								*/
+/*				char *calling_function)							*/
+/*																*/
+/*	OPTIONS														*/
+/*																*/
+/*	DESCRIPTION													*/
+/*																*/
+/*	Drop in for alloc() in the construct routines of the		*/
+/*	spatial hierarchy.  Hands out zeroed memory from the block	*/
+/*	chain of the given object type (ARENA_PATCH, ...), starting	*/
+/*	a new block when the current one is full.  Returns NULL		*/
+/*	for a request of size 0, as alloc() does.					*/
+/*																*/
+/*	Memory from the arena is never freed on its own; the whole	*/
+/*	arena is given back by release_arena in destroy_world.		*/
+/*																*/
+/*	PROGRAMMER NOTES											*/
+/*																*/
+/*	not thread safe - the world is constructed serially			*/
+/*	requests are rounded up to 16 bytes so every object keeps	*/
+/*	the alignment malloc would give it							*/
+/*--------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "rhessys.h"
+
+#define ARENA_ALIGN 16
+
+void *arena_alloc(struct arena_object *arena,
+				  int type,
+				  size_t size,
+				  char *array_name,
+				  char *calling_function)
+{
+	/*--------------------------------------------------------------*/
+	/*	Local variable definition.									*/
+	/*--------------------------------------------------------------*/
+	size_t header, block_size;
+	char *array;
+	struct arena_block_object *block;
+
+	if ( size == 0 )
+		return(NULL);
+
+	size = (size + ARENA_ALIGN - 1) / ARENA_ALIGN * ARENA_ALIGN;
+	header = (sizeof(struct arena_block_object) + ARENA_ALIGN - 1)
+		/ ARENA_ALIGN * ARENA_ALIGN;
+
+	/*--------------------------------------------------------------*/
+	/*	start a new block if the current one cannot hold the		*/
+	/*	request														*/
+	/*--------------------------------------------------------------*/
+	block = arena->blocks[type];
+	if ((block == NULL) || (block->used + size > block->size)) {
+		block_size = max(size, ARENA_BLOCK_SIZE);
+		block = (struct arena_block_object *)calloc(1, header + block_size);
+		if ( block == NULL ){
+			fprintf(stderr,
+				"FATAL ERROR: in arena_alloc, unable to allocate %s for %s\n",
+				array_name, calling_function );
+			exit(EXIT_FAILURE);
+		}
+		block->size = block_size;
+		block->used = 0;
+		block->next = arena->blocks[type];
+		arena->blocks[type] = block;
+		arena->reserved[type] += block_size;
+	}
+
+	array = (char *)block + header + block->used;
+	block->used += size;
+	arena->bytes[type] += size;
+	arena->count[type]++;
+	return((void *)array);
+} /*end arena_alloc.c*/
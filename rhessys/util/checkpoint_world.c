@@ -0,0 +1,376 @@
+/*--------------------------------------------------------------*/
+/* 																*/
+/*					checkpoint_world							*/
+/*																*/
+/*	checkpoint_world - writes or restores the objects of a world */
+/*																*/
+/*	NAME														*/
+/*	checkpoint_world - writes or restores the objects of a world */
+/*																*/
+/*	SYNOPSIS													*/
+/*	void	checkpoint_world(									*/
+/*				struct world_object *world,						*/
+/*				struct command_line_object *command_line,		*/
+/*				FILE *file,										*/
+/*				char *filename,									*/
+/*				int restoring)									*/
+/*																*/
+/*	OPTIONS														*/
+/*																*/
+/*	DESCRIPTION													*/
+/*																*/
+/*	Walks the world in construction order - for each basin the	*/
+/*	basin, its stream reaches, then each hillslope, zone,		*/
+/*	patch and canopy stratum - and writes every object whole	*/
+/*	(restoring == 0) or reads it back over the object of the	*/
+/*	same place (restoring == 1).  With each patch go its hourly	*/
+/*	object, canopy layers, shadow litter and soil stores, and	*/
+/*	its surface energy profile (-surface_energy) and shadow		*/
+/*	strata (-vegspinup) when the options build them, and the	*/
+/*	copy a patch held at its spinup targets is kept at.			*/
+/*																*/
+/*	The members of an object that belong to the structure of	*/
+/*	the world rather than its state - pointers, and the hillslope */
+/*	schedule which depends on the number of threads - are		*/
+/*	listed in the keep tables below.  They are written as zeros	*/
+/*	and the values built by construct_world are kept on			*/
+/*	restoring, so the world must be built from the same			*/
+/*	worldfile, flow tables and options.  The ID of each basin,	*/
+/*	hillslope, zone, patch and stratum is checked.				*/
+/*																*/
+/*	PROGRAMMER NOTES											*/
+/*																*/
+/*	a pointer (or thread dependent member) added to one of		*/
+/*	these objects must be added to its keep table				*/
+/*	base station climate sequences and the fire grids are		*/
+/*	not written; the first are read again for the resumed		*/
+/*	dates, the second are rebuilt by each fire event			*/
+/*--------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include "rhessys.h"
+
+struct checkpoint_keep_object
+{
+	size_t	offset;
+	size_t	size;
+};
+
+#define KEEP(type, member) { offsetof(struct type, member), sizeof(((struct type *) 0)->member) }
+
+static struct checkpoint_keep_object basin_keep[] = {
+	KEEP(basin_object, base_stations),
+	KEEP(basin_object, defaults),
+	KEEP(basin_object, hourly),
+	KEEP(basin_object, grow),
+	KEEP(basin_object, hillslopes),
+	KEEP(basin_object, outside_region),
+	KEEP(basin_object, stream_list.level_start),
+	KEEP(basin_object, stream_list.level_reaches),
+	KEEP(basin_object, stream_list.stream_network),
+	KEEP(basin_object, route_list),
+	KEEP(basin_object, surface_route_list),
+	KEEP(basin_object, schedule),
+	KEEP(basin_object, id_index)
+};
+
+static struct checkpoint_keep_object reach_keep[] = {
+	KEEP(stream_network_object, downstream_neighbours),
+	KEEP(stream_network_object, upstream_neighbours),
+	KEEP(stream_network_object, upstream_reaches),
+	KEEP(stream_network_object, lateral_inputs),
+	KEEP(stream_network_object, neighbour_hill)
+};
+
+static struct checkpoint_keep_object hillslope_keep[] = {
+	KEEP(hillslope_object, base_stations),
+	KEEP(hillslope_object, grow),
+	KEEP(hillslope_object, defaults),
+	KEEP(hillslope_object, hourly),
+	KEEP(hillslope_object, routing_order.list),
+	KEEP(hillslope_object, routing_order.state),
+	KEEP(hillslope_object, routing_order.inflow_start),
+	KEEP(hillslope_object, routing_order.inflows),
+	KEEP(hillslope_object, routing_order.outflow),
+	KEEP(hillslope_object, zones)
+};
+
+static struct checkpoint_keep_object zone_keep[] = {
+	KEEP(zone_object, base_stations),
+	KEEP(zone_object, grow),
+	KEEP(zone_object, patches),
+	KEEP(zone_object, defaults),
+	KEEP(zone_object, hourly)
+};
+
+static struct checkpoint_keep_object patch_keep[] = {
+	KEEP(patch_object, base_stations),
+	KEEP(patch_object, soil_defaults),
+	KEEP(patch_object, landuse_defaults),
+	KEEP(patch_object, fire_defaults),
+	KEEP(patch_object, surface_energy_defaults),
+	KEEP(patch_object, grow),
+	KEEP(patch_object, canopy_strata),
+	KEEP(patch_object, shadow_strata),
+	KEEP(patch_object, shadow_litter),
+	KEEP(patch_object, hourly),
+	KEEP(patch_object, layers),
+	KEEP(patch_object, innundation_list),
+	KEEP(patch_object, surface_innundation_list),
+	KEEP(patch_object, neighbours),
+	KEEP(patch_object, next_stream),
+	KEEP(patch_object, surface_energy_profile),
+	KEEP(patch_object, zone),
+	KEEP(patch_object, transmissivity_profile),
+	KEEP(patch_object, transmissivity_table),
+	KEEP(patch_object, shadow_soil_cs),
+	KEEP(patch_object, shadow_soil_ns),
+	KEEP(patch_object, shadow_litter_cs),
+	KEEP(patch_object, shadow_litter_ns),
+	KEEP(patch_object, frozen_state)
+};
+
+static struct checkpoint_keep_object stratum_keep[] = {
+	KEEP(canopy_strata_object, base_stations),
+	KEEP(canopy_strata_object, defaults),
+	KEEP(canopy_strata_object, spinup_defaults),
+	KEEP(canopy_strata_object, hourly)
+};
+
+static struct checkpoint_keep_object layer_keep[] = {
+	KEEP(layer_object, strata)
+};
+
+#define NUM_KEEP(table) ((int) (sizeof(table) / sizeof(table[0])))
+
+struct checkpoint_stream_object
+{
+	FILE	*file;
+	char	*filename;
+	int		restoring;
+	int		surface_energy_flag;
+	int		vegspinup_flag;
+	char	*buffer;
+};
+
+static void checkpoint_error(struct checkpoint_stream_object *stream, char *problem)
+{
+	fprintf(stderr,"FATAL ERROR: in checkpoint_world, %s %s\n", problem,
+		stream[0].filename);
+	exit(EXIT_FAILURE);
+}
+
+/*--------------------------------------------------------------*/
+/*	write or restore one object of size bytes, keeping the		*/
+/*	members of keep (objects with none are copied directly)		*/
+/*--------------------------------------------------------------*/
+static void checkpoint_object(struct checkpoint_stream_object *stream,
+							  void *object, size_t size,
+							  struct checkpoint_keep_object *keep, int num_keep)
+{
+	int	k;
+
+	if (num_keep == 0) {
+		if (stream[0].restoring == 0) {
+			if (fwrite(object, 1, size, stream[0].file) != size)
+				checkpoint_error(stream, "cannot write");
+		}
+		else if (fread(object, 1, size, stream[0].file) != size)
+			checkpoint_error(stream, "truncated checkpoint");
+	}
+	else if (stream[0].restoring == 0) {
+		memcpy(stream[0].buffer, object, size);
+		for (k=0; k<num_keep; k++)
+			memset(stream[0].buffer + keep[k].offset, 0, keep[k].size);
+		if (fwrite(stream[0].buffer, 1, size, stream[0].file) != size)
+			checkpoint_error(stream, "cannot write");
+	}
+	else {
+		if (fread(stream[0].buffer, 1, size, stream[0].file) != size)
+			checkpoint_error(stream, "truncated checkpoint");
+		for (k=0; k<num_keep; k++)
+			memcpy(stream[0].buffer + keep[k].offset,
+				(char *) object + keep[k].offset, keep[k].size);
+		memcpy(object, stream[0].buffer, size);
+	}
+}
+
+/*--------------------------------------------------------------*/
+/*	an ID or count restored must be the one built				*/
+/*--------------------------------------------------------------*/
+static void checkpoint_match(struct checkpoint_stream_object *stream,
+							 long live, long restored, char *what)
+{
+	if (live != restored) {
+		fprintf(stderr,
+			"FATAL ERROR: in checkpoint_world, %s %ld in the checkpoint is %ld in this world (%s)\n",
+			what, restored, live, stream[0].filename);
+		exit(EXIT_FAILURE);
+	}
+}
+
+/*--------------------------------------------------------------*/
+/*	canopy layers: the layer objects, then the strata of each	*/
+/*--------------------------------------------------------------*/
+static void checkpoint_layers(struct checkpoint_stream_object *stream,
+							  struct patch_object *patch)
+{
+	void	*alloc(size_t, char *, char *);
+	int	i;
+	size_t	size;
+
+	for (i=0; i<patch[0].num_layers; i++) {
+		checkpoint_object(stream, &(patch[0].layers[i]), sizeof(struct layer_object),
+			layer_keep, NUM_KEEP(layer_keep));
+		size = patch[0].layers[i].count * sizeof(long);
+		if (stream[0].restoring == 0) {
+			if (fwrite(patch[0].layers[i].strata, 1, size, stream[0].file) != size)
+				checkpoint_error(stream, "cannot write");
+		}
+		else {
+			patch[0].layers[i].strata = (long *) alloc(size, "strata", "checkpoint_world");
+			if (fread(patch[0].layers[i].strata, 1, size, stream[0].file) != size)
+				checkpoint_error(stream, "truncated checkpoint");
+		}
+	}
+}
+
+static void checkpoint_patch(struct checkpoint_stream_object *stream,
+							 struct patch_object *patch)
+{
+	void	*alloc(size_t, char *, char *);
+	int	i, ID, num_strata;
+
+	/*--------------------------------------------------------------*/
+	/*	the layers are rebuilt at the checkpoint's count			*/
+	/*--------------------------------------------------------------*/
+	ID = patch[0].ID;
+	num_strata = patch[0].num_canopy_strata;
+	if (stream[0].restoring == 1)
+		for (i=0; i<patch[0].num_layers; i++)
+			free(patch[0].layers[i].strata);
+	checkpoint_object(stream, patch, sizeof(struct patch_object),
+		patch_keep, NUM_KEEP(patch_keep));
+	checkpoint_match(stream, ID, patch[0].ID, "patch");
+	checkpoint_match(stream, num_strata, patch[0].num_canopy_strata, "strata of patch");
+	checkpoint_layers(stream, patch);
+
+	/*--------------------------------------------------------------*/
+	/*	the state a held spinup patch is kept at					*/
+	/*--------------------------------------------------------------*/
+	if (patch[0].frozen == 1) {
+		if (stream[0].restoring == 1) {
+			patch[0].frozen_state = (struct patch_object *) alloc(
+				sizeof(struct patch_object), "frozen_state", "checkpoint_world");
+			memcpy(patch[0].frozen_state, patch, sizeof(struct patch_object));
+		}
+		checkpoint_object(stream, patch[0].frozen_state, sizeof(struct patch_object),
+			patch_keep, NUM_KEEP(patch_keep));
+	}
+
+	checkpoint_object(stream, patch[0].hourly, sizeof(struct patch_hourly_object),
+		NULL, 0);
+	if (stream[0].surface_energy_flag == 1)
+		checkpoint_object(stream, patch[0].surface_energy_profile,
+			4 * sizeof(struct surface_energy_object), NULL, 0);
+	if (patch[0].shadow_litter_cs != NULL)
+		checkpoint_object(stream, patch[0].shadow_litter_cs,
+			sizeof(struct litter_c_object), NULL, 0);
+	if (patch[0].shadow_litter_ns != NULL)
+		checkpoint_object(stream, patch[0].shadow_litter_ns,
+			sizeof(struct litter_n_object), NULL, 0);
+	if (patch[0].shadow_soil_cs != NULL)
+		checkpoint_object(stream, patch[0].shadow_soil_cs,
+			sizeof(struct soil_c_object), NULL, 0);
+	if (patch[0].shadow_soil_ns != NULL)
+		checkpoint_object(stream, patch[0].shadow_soil_ns,
+			sizeof(struct soil_n_object), NULL, 0);
+
+	for (i=0; i<patch[0].num_canopy_strata; i++) {
+		ID = patch[0].canopy_strata[i][0].ID;
+		checkpoint_object(stream, patch[0].canopy_strata[i],
+			sizeof(struct canopy_strata_object), stratum_keep, NUM_KEEP(stratum_keep));
+		checkpoint_match(stream, ID, patch[0].canopy_strata[i][0].ID, "stratum");
+		if (stream[0].vegspinup_flag > 0)
+			checkpoint_object(stream, patch[0].shadow_strata[i],
+				sizeof(struct canopy_strata_object), stratum_keep, NUM_KEEP(stratum_keep));
+	}
+}
+
+void	checkpoint_world(struct world_object *world,
+						 struct command_line_object *command_line,
+						 FILE *file,
+						 char *filename,
+						 int restoring)
+{
+	/*--------------------------------------------------------------*/
+	/*	Local function definition.									*/
+	/*--------------------------------------------------------------*/
+	void	*alloc(size_t, char *, char *);
+	/*--------------------------------------------------------------*/
+	/*	Local variable definition.									*/
+	/*--------------------------------------------------------------*/
+	int	b, h, z, p, r, ID, count, num_reaches;
+	struct	checkpoint_stream_object	stream;
+	struct	basin_object	*basin;
+	struct	hillslope_object	*hillslope;
+	struct	zone_object	*zone;
+
+	stream.file = file;
+	stream.filename = filename;
+	stream.restoring = restoring;
+	stream.surface_energy_flag = command_line[0].surface_energy_flag;
+	stream.vegspinup_flag = command_line[0].vegspinup_flag;
+	stream.buffer = (char *) alloc(max(max(sizeof(struct patch_object),
+		sizeof(struct canopy_strata_object)), max(max(sizeof(struct basin_object),
+		sizeof(struct stream_network_object)), max(max(sizeof(struct zone_object),
+		sizeof(struct layer_object)), sizeof(struct hillslope_object)))),
+		"buffer", "checkpoint_world");
+
+	for (b=0; b<world[0].num_basin_files; b++) {
+		basin = world[0].basins[b];
+		ID = basin[0].ID;
+		count = basin[0].num_hillslopes;
+		num_reaches = basin[0].stream_list.num_reaches;
+		checkpoint_object(&stream, basin, sizeof(struct basin_object),
+			basin_keep, NUM_KEEP(basin_keep));
+		checkpoint_match(&stream, ID, basin[0].ID, "basin");
+		checkpoint_match(&stream, count, basin[0].num_hillslopes, "hillslopes of basin");
+		checkpoint_match(&stream, num_reaches, basin[0].stream_list.num_reaches,
+			"stream reaches of basin");
+		checkpoint_object(&stream, basin[0].hourly,
+			sizeof(struct basin_hourly_object), NULL, 0);
+		for (r=0; r<basin[0].stream_list.num_reaches; r++)
+			checkpoint_object(&stream, &(basin[0].stream_list.stream_network[r]),
+				sizeof(struct stream_network_object), reach_keep, NUM_KEEP(reach_keep));
+
+		for (h=0; h<basin[0].num_hillslopes; h++) {
+			hillslope = basin[0].hillslopes[h];
+			ID = hillslope[0].ID;
+			count = hillslope[0].num_zones;
+			checkpoint_object(&stream, hillslope, sizeof(struct hillslope_object),
+				hillslope_keep, NUM_KEEP(hillslope_keep));
+			checkpoint_match(&stream, ID, hillslope[0].ID, "hillslope");
+			checkpoint_match(&stream, count, hillslope[0].num_zones, "zones of hillslope");
+
+			for (z=0; z<hillslope[0].num_zones; z++) {
+				zone = hillslope[0].zones[z];
+				ID = zone[0].ID;
+				count = zone[0].num_patches;
+				checkpoint_object(&stream, zone, sizeof(struct zone_object),
+					zone_keep, NUM_KEEP(zone_keep));
+				checkpoint_match(&stream, ID, zone[0].ID, "zone");
+				checkpoint_match(&stream, count, zone[0].num_patches, "patches of zone");
+				checkpoint_object(&stream, zone[0].hourly,
+					sizeof(struct zone_hourly_object), NULL, 0);
+
+				for (p=0; p<zone[0].num_patches; p++)
+					checkpoint_patch(&stream, zone[0].patches[p]);
+			}
+		}
+	}
+	free(stream.buffer);
+	return;
+} /*end checkpoint_world*/
@@ -0,0 +1,159 @@
+/*--------------------------------------------------------------*/
+/*                                                              */
+/*		clim_cache						*/
+/*                                                              */
+/*  NAME                                                        */
+/*		clim_cache - parsed climate sequences kept	*/
+/*		next to their text files			*/
+/*                                                              */
+/*  SYNOPSIS                                                    */
+/*  void *read_clim_cache(char *file,				*/
+/*		struct clim_cache_header_object *key)		*/
+/*  void write_clim_cache(char *file,				*/
+/*		struct clim_cache_header_object *key,		*/
+/*		void *records)					*/
+/*                                                              */
+/*  OPTIONS                                                     */
+/*  -climcache							*/
+/*                                                              */
+/*  DESCRIPTION                                                 */
+/*                                                              */
+/*  key gives what the caller is about to parse from the text	*/
+/*  climate file: kind, record_size, start_date_julian,	*/
+/*  duration and clim_repeat_flag (see rhessys.h).		*/
+/*                                                              */
+/*  read_clim_cache maps <file>.cache and, if it was written	*/
+/*  for the same key from the same file (path, size and	*/
+/*  modification time), returns its records in a new array	*/
+/*  and sets key[0].num_records.  Otherwise it returns NULL and	*/
+/*  the caller parses the text file as usual, then calls	*/
+/*  write_clim_cache with the key[0].num_records records it	*/
+/*  built.							*/
+/*                                                              */
+/*  PROGRAMMER NOTES                                            */
+/*                                                              */
+/*  the cache is written to a temporary file and renamed, so	*/
+/*  runs sharing the inputs never see a partial cache		*/
+/*  a cache that cannot be written is only a warning		*/
+/*  the array is a copy, as the sequences are freed with the	*/
+/*  base stations						*/
+/*                                                              */
+/*--------------------------------------------------------------*/
+#define _XOPEN_SOURCE 700
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "rhessys.h"
+
+/*--------------------------------------------------------------*/
+/*	fill in the source file part of the key, 0 if missing	*/
+/*--------------------------------------------------------------*/
+static int clim_cache_source(char *file,
+							 struct clim_cache_header_object *key)
+{
+	struct	stat	status;
+
+	if (stat(file, &status) != 0)
+		return(0);
+	memcpy(key[0].magic, CLIM_CACHE_MAGIC, 8);
+	key[0].version = CLIM_CACHE_VERSION;
+	key[0].source_size = (int64_t) status.st_size;
+	key[0].source_mtime = (int64_t) status.st_mtim.tv_sec;
+	key[0].source_mtime_nsec = (int64_t) status.st_mtim.tv_nsec;
+	memset(key[0].source, 0, FILEPATH_LEN);
+	strncpy(key[0].source, file, FILEPATH_LEN-1);
+	return(1);
+}
+
+void *read_clim_cache(char *file, struct clim_cache_header_object *key)
+{
+	/*------------------------------------------------------*/
+	/*	Local Function Declarations.			*/
+	/*------------------------------------------------------*/
+	void	*alloc(size_t, char *, char *);
+
+	/*------------------------------------------------------*/
+	/*	Local Variable Definition. 			*/
+	/*------------------------------------------------------*/
+	int	fd;
+	int	valid;
+	char	cache_file[FILEPATH_LEN+8];
+	void	*image, *records;
+	size_t	size;
+	struct	stat	status;
+	struct	clim_cache_header_object *header;
+
+	if (clim_cache_source(file, key) == 0)
+		return(NULL);
+	snprintf(cache_file, sizeof(cache_file), "%s.cache", file);
+	if ((fd = open(cache_file, O_RDONLY)) < 0)
+		return(NULL);
+	fstat(fd, &status);
+	size = (size_t) status.st_size;
+	if (size < sizeof(struct clim_cache_header_object)) {
+		close(fd);
+		return(NULL);
+	}
+	image = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (image == MAP_FAILED)
+		return(NULL);
+
+	header = (struct clim_cache_header_object *) image;
+	valid = (memcmp(header[0].magic, CLIM_CACHE_MAGIC, 8) == 0)
+		&& (header[0].version == key[0].version)
+		&& (header[0].kind == key[0].kind)
+		&& (header[0].record_size == key[0].record_size)
+		&& (header[0].clim_repeat_flag == key[0].clim_repeat_flag)
+		&& (header[0].source_size == key[0].source_size)
+		&& (header[0].source_mtime == key[0].source_mtime)
+		&& (header[0].source_mtime_nsec == key[0].source_mtime_nsec)
+		&& (header[0].start_date_julian == key[0].start_date_julian)
+		&& (header[0].duration == key[0].duration)
+		&& (strncmp(header[0].source, key[0].source, FILEPATH_LEN) == 0)
+		&& (header[0].num_records > 0)
+		&& (size == sizeof(struct clim_cache_header_object)
+			+ (size_t) header[0].num_records * header[0].record_size);
+	records = NULL;
+	if (valid) {
+		key[0].num_records = header[0].num_records;
+		records = alloc((size_t) header[0].num_records * header[0].record_size,
+			"records", "read_clim_cache");
+		memcpy(records, (char *) image + sizeof(struct clim_cache_header_object),
+			(size_t) header[0].num_records * header[0].record_size);
+	}
+	munmap(image, size);
+	return(records);
+}
+
+void write_clim_cache(char *file, struct clim_cache_header_object *key,
+					  void *records)
+{
+	int	written;
+	char	cache_file[FILEPATH_LEN+8], temp_file[FILEPATH_LEN+32];
+	size_t	size;
+	FILE	*out;
+
+	if (clim_cache_source(file, key) == 0)
+		return;
+	snprintf(cache_file, sizeof(cache_file), "%s.cache", file);
+	snprintf(temp_file, sizeof(temp_file), "%s.%ld.tmp", cache_file,
+		(long) getpid());
+	if ((out = fopen(temp_file, "wb")) == NULL) {
+		fprintf(stderr, "WARNING: cannot write climate cache %s\n", cache_file);
+		return;
+	}
+	size = (size_t) key[0].num_records * key[0].record_size;
+	written = (fwrite(key, sizeof(struct clim_cache_header_object), 1, out) == 1)
+		&& (fwrite(records, 1, size, out) == size);
+	written = (fclose(out) == 0) && written;
+	if (!written || (rename(temp_file, cache_file) != 0)) {
+		fprintf(stderr, "WARNING: cannot write climate cache %s\n", cache_file);
+		remove(temp_file);
+	}
+	return;
+}
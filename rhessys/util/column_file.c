@@ -0,0 +1,299 @@
+/*--------------------------------------------------------------*/
+/*                                                              */
+/*		column_file						*/
+/*                                                              */
+/*  NAME                                                        */
+/*		column_file - output records kept as compressed	*/
+/*		typed columns					*/
+/*                                                              */
+/*  SYNOPSIS                                                    */
+/*  struct column_file_object *construct_column_file(		*/
+/*			char *filename)				*/
+/*  void column_file_name(struct column_file_object *, char *)	*/
+/*  void column_file_int(struct column_file_object *, int)	*/
+/*  void column_file_double(struct column_file_object *, double)*/
+/*  void column_file_end_row(struct column_file_object *)	*/
+/*  void destroy_column_file(struct column_file_object *)	*/
+/*                                                              */
+/*  OPTIONS                                                     */
+/*  -colout <levels>						*/
+/*                                                              */
+/*  DESCRIPTION                                                 */
+/*                                                              */
+/*  A row is a number of column_file_name (the header row) or	*/
+/*  column_file_int / column_file_double calls (a record)	*/
+/*  followed by column_file_end_row.  output_record makes these	*/
+/*  calls from the same format and arguments that would have	*/
+/*  been given to fprintf.					*/
+/*                                                              */
+/*  The first row fixes the number of columns, the first	*/
+/*  record their types; the file header is written then (see	*/
+/*  rhessys.h).  Records are kept until COLUMN_BLOCK_ROWS are	*/
+/*  held, then each column is byte shuffled (the first bytes	*/
+/*  of every value, then the second ...) and deflated.		*/
+/*                                                              */
+/*  PROGRAMMER NOTES                                            */
+/*                                                              */
+/*  values are written in the byte order of the machine; the	*/
+/*  file is read back with rhessys -coldump			*/
+/*  a record that does not match the first one in number or	*/
+/*  types of values is a fatal error				*/
+/*  the column arrays grow with the first row, so a header	*/
+/*  may have any number of names				*/
+/*                                                              */
+/*--------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <zlib.h>
+#include "rhessys.h"
+
+static int column_width(int type)
+{
+	return((type == COLUMN_INT) ? sizeof(int32_t) : sizeof(double));
+}
+
+/*--------------------------------------------------------------*/
+/*	make room for column c					*/
+/*--------------------------------------------------------------*/
+static void grow_columns(struct column_file_object *columns, int c)
+{
+	int	i, capacity;
+
+	if (c < columns[0].capacity)
+		return;
+	capacity = 2 * columns[0].capacity + 64;
+	columns[0].types = (int *) realloc(columns[0].types,
+		capacity * sizeof(int));
+	columns[0].names = (char **) realloc(columns[0].names,
+		capacity * sizeof(char *));
+	columns[0].values = (char **) realloc(columns[0].values,
+		capacity * sizeof(char *));
+	if ((columns[0].types == NULL) || (columns[0].names == NULL)
+		|| (columns[0].values == NULL)) {
+		fprintf(stderr,"FATAL ERROR: in column_file, out of memory for %d columns of %s\n",
+			capacity, columns[0].filename);
+		exit(EXIT_FAILURE);
+	}
+	for (i=columns[0].capacity; i<capacity; i++) {
+		columns[0].names[i] = NULL;
+		columns[0].values[i] = NULL;
+	}
+	columns[0].capacity = capacity;
+}
+
+/*--------------------------------------------------------------*/
+/*	write the magic, version and the column names and types	*/
+/*--------------------------------------------------------------*/
+static void write_column_header(struct column_file_object *columns)
+{
+	int	c;
+	int32_t	value;
+
+	fwrite(COLUMN_FILE_MAGIC, 1, 8, columns[0].file);
+	value = COLUMN_FILE_VERSION;
+	fwrite(&value, sizeof(int32_t), 1, columns[0].file);
+	value = columns[0].num_columns;
+	fwrite(&value, sizeof(int32_t), 1, columns[0].file);
+	for (c=0; c<columns[0].num_columns; c++) {
+		value = columns[0].types[c];
+		fwrite(&value, sizeof(int32_t), 1, columns[0].file);
+		value = strlen(columns[0].names[c]);
+		fwrite(&value, sizeof(int32_t), 1, columns[0].file);
+		fwrite(columns[0].names[c], 1, value, columns[0].file);
+	}
+	columns[0].header_written = 1;
+}
+
+/*--------------------------------------------------------------*/
+/*	shuffle, deflate and write the records held		*/
+/*--------------------------------------------------------------*/
+static void write_column_block(struct column_file_object *columns)
+{
+	int	c, b, r, width;
+	int32_t	num_rows;
+	uint32_t	size;
+	uLongf	compressed_size;
+	unsigned char	*values;
+
+	if (columns[0].num_rows == 0)
+		return;
+	num_rows = columns[0].num_rows;
+	fwrite(&num_rows, sizeof(int32_t), 1, columns[0].file);
+	for (c=0; c<columns[0].num_columns; c++) {
+		width = column_width(columns[0].types[c]);
+		values = (unsigned char *) columns[0].values[c];
+		for (b=0; b<width; b++)
+			for (r=0; r<num_rows; r++)
+				columns[0].shuffled[b*num_rows+r] = values[r*width+b];
+		compressed_size = columns[0].compressed_capacity;
+		if (compress2(columns[0].compressed, &compressed_size,
+			columns[0].shuffled, (uLong) num_rows*width, Z_BEST_SPEED) != Z_OK) {
+			fprintf(stderr,
+				"FATAL ERROR: in column_file, cannot compress column %s of %s\n",
+				columns[0].names[c], columns[0].filename);
+			exit(EXIT_FAILURE);
+		}
+		size = (uint32_t) compressed_size;
+		fwrite(&size, sizeof(uint32_t), 1, columns[0].file);
+		fwrite(columns[0].compressed, 1, size, columns[0].file);
+	}
+	columns[0].num_rows = 0;
+}
+
+struct column_file_object *construct_column_file(char *filename)
+{
+	/*------------------------------------------------------*/
+	/*	Local Function Declarations.			*/
+	/*------------------------------------------------------*/
+	void	*alloc(size_t, char *, char *);
+
+	/*------------------------------------------------------*/
+	/*	Local Variable Definition. 			*/
+	/*------------------------------------------------------*/
+	struct	column_file_object	*columns;
+
+	columns = (struct column_file_object *) alloc(
+		sizeof(struct column_file_object), "columns", "construct_column_file");
+	memset(columns, 0, sizeof(struct column_file_object));
+	strncpy(columns[0].filename, filename, FILEPATH_LEN-1);
+	if ((columns[0].file = fopen(filename, "wb")) == NULL) {
+		fprintf(stderr,"FATAL ERROR: in construct_column_file, cannot open %s\n",
+			filename);
+		exit(EXIT_FAILURE);
+	}
+	columns[0].compressed_capacity = compressBound(
+		COLUMN_BLOCK_ROWS * sizeof(double));
+	columns[0].shuffled = (unsigned char *) alloc(
+		COLUMN_BLOCK_ROWS * sizeof(double), "shuffled", "construct_column_file");
+	columns[0].compressed = (unsigned char *) alloc(
+		columns[0].compressed_capacity, "compressed", "construct_column_file");
+	return(columns);
+}
+
+void column_file_name(struct column_file_object *columns, char *name)
+{
+	void	*alloc(size_t, char *, char *);
+
+	if (columns[0].num_columns > 0) {
+		fprintf(stderr,
+			"FATAL ERROR: in column_file, names must be the first row (%s)\n",
+			columns[0].filename);
+		exit(EXIT_FAILURE);
+	}
+	grow_columns(columns, columns[0].num_names);
+	columns[0].names[columns[0].num_names] = (char *) alloc(strlen(name)+1,
+		"name", "column_file_name");
+	strcpy(columns[0].names[columns[0].num_names], name);
+	columns[0].num_names += 1;
+}
+
+/*--------------------------------------------------------------*/
+/*	where the next value of the row goes, checking its type	*/
+/*--------------------------------------------------------------*/
+static char *column_value(struct column_file_object *columns, int type)
+{
+	void	*alloc(size_t, char *, char *);
+	int	c;
+
+	c = columns[0].column;
+	if (columns[0].num_columns == 0) {
+		grow_columns(columns, c);
+		columns[0].types[c] = type;
+		columns[0].values[c] = (char *) alloc(COLUMN_BLOCK_ROWS * sizeof(double),
+			"values", "column_file");
+	}
+	else if ((c >= columns[0].num_columns) || (columns[0].types[c] != type)) {
+		fprintf(stderr,
+			"FATAL ERROR: in column_file, value %d of a record does not match the first record of %s\n",
+			c+1, columns[0].filename);
+		exit(EXIT_FAILURE);
+	}
+	columns[0].column += 1;
+	return(columns[0].values[c] + columns[0].num_rows*column_width(type));
+}
+
+void column_file_int(struct column_file_object *columns, int value)
+{
+	int32_t	stored;
+
+	stored = (int32_t) value;
+	memcpy(column_value(columns, COLUMN_INT), &stored, sizeof(int32_t));
+}
+
+void column_file_double(struct column_file_object *columns, double value)
+{
+	memcpy(column_value(columns, COLUMN_DOUBLE), &value, sizeof(double));
+}
+
+void column_file_end_row(struct column_file_object *columns)
+{
+	void	*alloc(size_t, char *, char *);
+	int	c;
+	char	name[32];
+
+	/*--------------------------------------------------------------*/
+	/*	a header row only keeps its names			*/
+	/*--------------------------------------------------------------*/
+	if (columns[0].column == 0)
+		return;
+	if (columns[0].num_columns == 0) {
+		if ((columns[0].num_names > 0) && (columns[0].num_names != columns[0].column)) {
+			fprintf(stderr,
+				"FATAL ERROR: in column_file, %d names but %d values in a record of %s\n",
+				columns[0].num_names, columns[0].column, columns[0].filename);
+			exit(EXIT_FAILURE);
+		}
+		for (c=columns[0].num_names; c<columns[0].column; c++) {
+			sprintf(name, "column%d", c+1);
+			columns[0].names[c] = (char *) alloc(strlen(name)+1, "name", "column_file");
+			strcpy(columns[0].names[c], name);
+		}
+		columns[0].num_names = columns[0].column;
+		columns[0].num_columns = columns[0].column;
+		write_column_header(columns);
+	}
+	else if (columns[0].column != columns[0].num_columns) {
+		fprintf(stderr,
+			"FATAL ERROR: in column_file, %d values in a record of %s, %d in the first\n",
+			columns[0].column, columns[0].filename, columns[0].num_columns);
+		exit(EXIT_FAILURE);
+	}
+	columns[0].column = 0;
+	columns[0].num_rows += 1;
+	if (columns[0].num_rows == COLUMN_BLOCK_ROWS)
+		write_column_block(columns);
+}
+
+void destroy_column_file(struct column_file_object *columns)
+{
+	int	c;
+
+	if (columns == NULL)
+		return;
+	/*--------------------------------------------------------------*/
+	/*	no record was written: keep the names as double columns	*/
+	/*--------------------------------------------------------------*/
+	if (columns[0].header_written == 0) {
+		columns[0].num_columns = columns[0].num_names;
+		for (c=0; c<columns[0].num_columns; c++)
+			columns[0].types[c] = COLUMN_DOUBLE;
+		write_column_header(columns);
+	}
+	write_column_block(columns);
+	if (fclose(columns[0].file) != 0)
+		fprintf(stderr,"WARNING: error closing column output %s\n",
+			columns[0].filename);
+	for (c=0; c<columns[0].num_names; c++)
+		free(columns[0].names[c]);
+	for (c=0; c<columns[0].capacity; c++)
+		if (columns[0].values[c] != NULL)
+			free(columns[0].values[c]);
+	free(columns[0].types);
+	free(columns[0].names);
+	free(columns[0].values);
+	free(columns[0].shuffled);
+	free(columns[0].compressed);
+	free(columns);
+}
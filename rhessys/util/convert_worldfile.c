@@ -0,0 +1,296 @@
+/*--------------------------------------------------------------*/
+/* 																*/
+/*					convert_worldfile							*/
+/*																*/
+/*	convert_worldfile.c - text <-> binary worldfile				*/
+/*																*/
+/*	NAME														*/
+/*	convert_worldfile.c - text <-> binary worldfile				*/
+/*																*/
+/*	SYNOPSIS													*/
+/*	void convert_worldfile( 									*/
+/*				char *in_filename,								*/
+/*				char *out_filename)								*/
+/*																*/
+/*	OPTIONS														*/
+/*	-w <in> -wconvert <out>										*/
+/*																*/
+/*	DESCRIPTION													*/
+/*																*/
+/*	Converts a text worldfile to the binary format described	*/
+/*	in rhessys.h, or a binary worldfile back to text, depending	*/
+/*	on the format of in_filename.								*/
+/*																*/
+/*	Text to binary: every non blank line becomes one record;	*/
+/*	the first token is the value (integer, real or, failing		*/
+/*	both, a string) and the rest of the line the label.  Reals	*/
+/*	are stored as strtod reads them, which is what fscanf("%lf")*/
+/*	gives, so a model run from the binary file is identical to	*/
+/*	one from the text file.  The inline header of a legacy		*/
+/*	worldfile (the lines before world_id) is written to			*/
+/*	<out>.hdr without its start and end dates, which			*/
+/*	construct_world ignores anyway; a separate <in>.hdr is		*/
+/*	copied there.												*/
+/*																*/
+/*	Binary to text: one "value label" line per record, reals	*/
+/*	printed with 17 digits so they read back exactly.			*/
+/*																*/
+/*	PROGRAMMER NOTES											*/
+/*																*/
+/*	labels are kept once each in the string table				*/
+/*--------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <ctype.h>
+#include <unistd.h>
+#include "rhessys.h"
+
+#define LABEL_TABLE_SIZE 4096
+#define LINE_LEN 4096
+
+struct	label_table_object
+	{
+	int32_t	offset[LABEL_TABLE_SIZE];	/* -1 for an empty slot */
+	char	*strings;
+	int64_t	size;
+	int64_t	capacity;
+	int	num_labels;
+	};
+
+/*--------------------------------------------------------------*/
+/*	string table offset of a label, adding it if new		*/
+/*--------------------------------------------------------------*/
+static int32_t find_label(struct label_table_object *table, char *label)
+{
+	unsigned long h;
+	char	*c;
+	int64_t	n;
+
+	h = 5381;
+	for (c = label; *c != '\0'; c++)
+		h = h * 33 + (unsigned char) *c;
+	h = h % LABEL_TABLE_SIZE;
+	while (table->offset[h] >= 0) {
+		if (strcmp(table->strings + table->offset[h], label) == 0)
+			return(table->offset[h]);
+		h = (h + 1) % LABEL_TABLE_SIZE;
+	}
+	if (table->num_labels >= LABEL_TABLE_SIZE - 1) {
+		fprintf(stderr,
+			"FATAL ERROR: in convert_worldfile, more than %d distinct labels\n",
+			LABEL_TABLE_SIZE - 1);
+		exit(EXIT_FAILURE);
+	}
+	n = strlen(label) + 1;
+	if (table->size + n > table->capacity) {
+		table->capacity = 2 * (table->capacity + n);
+		table->strings = realloc(table->strings, table->capacity);
+		if (table->strings == NULL) {
+			fprintf(stderr,"FATAL ERROR: in convert_worldfile, out of memory\n");
+			exit(EXIT_FAILURE);
+		}
+	}
+	memcpy(table->strings + table->size, label, n);
+	table->offset[h] = (int32_t) table->size;
+	table->size += n;
+	table->num_labels++;
+	return(table->offset[h]);
+}
+
+/*--------------------------------------------------------------*/
+/*	copy a text file (worldfile header)						*/
+/*--------------------------------------------------------------*/
+static void copy_header(char *in_filename, char *out_filename)
+{
+	char	hdr_in[FILEPATH_LEN+8], hdr_out[FILEPATH_LEN+8];
+	char	line[LINE_LEN];
+	FILE	*in, *out;
+
+	snprintf(hdr_in, sizeof(hdr_in), "%s.hdr", in_filename);
+	snprintf(hdr_out, sizeof(hdr_out), "%s.hdr", out_filename);
+	if ((in = fopen(hdr_in, "r")) == NULL)
+		return;
+	if ((out = fopen(hdr_out, "w")) == NULL) {
+		fprintf(stderr,"FATAL ERROR: Cannot open %s\n", hdr_out);
+		exit(EXIT_FAILURE);
+	}
+	while (fgets(line, LINE_LEN, in) != NULL)
+		fputs(line, out);
+	fclose(in);
+	fclose(out);
+	printf("\n Copied world file header %s to %s", hdr_in, hdr_out);
+	return;
+}
+
+static void text_to_binary(FILE *in, char *in_filename, char *out_filename)
+{
+	char	line[LINE_LEN], hdr_out[FILEPATH_LEN+8];
+	char	*value, *label, *end, *c;
+	int	in_body, header_lines;
+	FILE	*out, *header;
+	struct	label_table_object *table;
+	struct	worldfile_header_object file_header;
+	struct	worldfile_record_object record;
+
+	table = (struct label_table_object *) calloc(1, sizeof(struct label_table_object));
+	memset(table->offset, -1, sizeof(table->offset));
+	memset(&file_header, 0, sizeof(file_header));
+	memcpy(file_header.magic, WORLDFILE_MAGIC, 8);
+	file_header.version = WORLDFILE_VERSION;
+	file_header.record_size = sizeof(struct worldfile_record_object);
+
+	if ((out = fopen(out_filename, "wb")) == NULL) {
+		fprintf(stderr,"FATAL ERROR: Cannot open %s\n", out_filename);
+		exit(EXIT_FAILURE);
+	}
+	fwrite(&file_header, sizeof(file_header), 1, out);
+
+	header = NULL;
+	in_body = 0;
+	header_lines = 0;
+	while (fgets(line, LINE_LEN, in) != NULL) {
+		if (strlen(line) == LINE_LEN - 1) {
+			fprintf(stderr,"FATAL ERROR: line longer than %d in %s\n",
+				LINE_LEN - 2, in_filename);
+			exit(EXIT_FAILURE);
+		}
+		/*--------------------------------------------------------------*/
+		/*	split into value and label								*/
+		/*--------------------------------------------------------------*/
+		for (value = line; isspace((unsigned char) *value); value++);
+		if (*value == '\0')
+			continue;
+		for (label = value; (*label != '\0') && !isspace((unsigned char) *label); label++);
+		if (*label != '\0')
+			*label++ = '\0';
+		while (isspace((unsigned char) *label))
+			label++;
+		for (c = label + strlen(label); (c > label) && isspace((unsigned char) c[-1]); c--);
+		*c = '\0';
+
+		/*--------------------------------------------------------------*/
+		/*	legacy header lines go to <out>.hdr						*/
+		/*--------------------------------------------------------------*/
+		if (!in_body) {
+			if (strcasecmp(label, "world_id") == 0)
+				in_body = 1;
+			else if (header_lines++ < 8)
+				continue;
+			else {
+				if (header == NULL) {
+					snprintf(hdr_out, sizeof(hdr_out), "%s.hdr", out_filename);
+					if ((header = fopen(hdr_out, "w")) == NULL) {
+						fprintf(stderr,"FATAL ERROR: Cannot open %s\n", hdr_out);
+						exit(EXIT_FAILURE);
+					}
+					printf("\n Writing legacy world file header to %s", hdr_out);
+				}
+				fprintf(header, "%-30s %s\n", value, label);
+				continue;
+			}
+		}
+
+		/*--------------------------------------------------------------*/
+		/*	typed record											*/
+		/*--------------------------------------------------------------*/
+		memset(&record, 0, sizeof(record));
+		record.label = find_label(table, label);
+		record.value.i = strtoll(value, &end, 10);
+		if (*end == '\0')
+			record.type = WORLDFILE_INT;
+		else {
+			record.value.d = strtod(value, &end);
+			if (*end == '\0')
+				record.type = WORLDFILE_DOUBLE;
+			else {
+				record.type = WORLDFILE_STRING;
+				record.value.i = find_label(table, value);
+			}
+		}
+		fwrite(&record, sizeof(record), 1, out);
+		file_header.num_records++;
+	}
+	if (!in_body) {
+		fprintf(stderr,"FATAL ERROR: no world_id line found in %s\n", in_filename);
+		exit(EXIT_FAILURE);
+	}
+	if (header != NULL)
+		fclose(header);
+	else
+		copy_header(in_filename, out_filename);
+
+	/*--------------------------------------------------------------*/
+	/*	string table, then the final header						*/
+	/*--------------------------------------------------------------*/
+	file_header.strings_offset = sizeof(file_header)
+		+ file_header.num_records * sizeof(struct worldfile_record_object);
+	file_header.strings_size = table->size;
+	fwrite(table->strings, 1, table->size, out);
+	fseek(out, 0, SEEK_SET);
+	fwrite(&file_header, sizeof(file_header), 1, out);
+	if (fclose(out) != 0) {
+		fprintf(stderr,"FATAL ERROR: writing %s failed\n", out_filename);
+		exit(EXIT_FAILURE);
+	}
+	printf("\n Wrote binary world file %s: %ld records, %d labels\n",
+		out_filename, (long) file_header.num_records, table->num_labels);
+	free(table->strings);
+	free(table);
+	return;
+}
+
+static void binary_to_text(struct world_input_object *world_file,
+						   char *in_filename, char *out_filename)
+{
+	int64_t	i;
+	char	*label;
+	FILE	*out;
+	struct	worldfile_record_object *r;
+
+	if ((out = fopen(out_filename, "w")) == NULL) {
+		fprintf(stderr,"FATAL ERROR: Cannot open %s\n", out_filename);
+		exit(EXIT_FAILURE);
+	}
+	for (i = 0; i < world_file[0].num_records; i++) {
+		r = &(world_file[0].records[i]);
+		label = world_file[0].strings + r[0].label;
+		if (r[0].type == WORLDFILE_INT)
+			fprintf(out, "%-30ld %s\n", (long) r[0].value.i, label);
+		else if (r[0].type == WORLDFILE_DOUBLE)
+			fprintf(out, "%-30.17g %s\n", r[0].value.d, label);
+		else
+			fprintf(out, "%-30s %s\n", world_file[0].strings + r[0].value.i, label);
+	}
+	fclose(out);
+	copy_header(in_filename, out_filename);
+	printf("\n Wrote text world file %s: %ld records\n",
+		out_filename, (long) world_file[0].num_records);
+	return;
+}
+
+void convert_worldfile(char *in_filename, char *out_filename)
+{
+	/*--------------------------------------------------------------*/
+	/*	Local function definition.									*/
+	/*--------------------------------------------------------------*/
+	struct world_input_object *open_world_input(char *);
+	void close_world_input(struct world_input_object *);
+
+	/*--------------------------------------------------------------*/
+	/*	Local variable definition.									*/
+	/*--------------------------------------------------------------*/
+	struct world_input_object *world_file;
+
+	if ((world_file = open_world_input(in_filename)) == NULL) {
+		fprintf(stderr,"FATAL ERROR:  Cannot open world file %s\n", in_filename);
+		exit(EXIT_FAILURE);
+	}
+	if (world_file[0].file != NULL)
+		text_to_binary(world_file[0].file, in_filename, out_filename);
+	else
+		binary_to_text(world_file, in_filename, out_filename);
+	close_world_input(world_file);
+	return;
+} /*end convert_worldfile.c*/
@@ -1,5 +1,5 @@
 /*--------------------------------------------------------------*/
-/*                                                              */ 
+/*                                                              */
 /*		create_random_distrb					*/
 /*                                                              */
 /*  NAME                                                        */
@@ -7,121 +7,95 @@
 /*                                                              */
 /*                                                              */
 /*  SYNOPSIS                                                    */
-/*  create_random_distrb( struct world_object *world)			*/
+/*  struct random_stream_object init_random_stream(		*/
+/*			long seed, int ID, struct date date)		*/
+/*  double random_uniform(struct random_stream_object *stream)	*/
+/*  double normdist(struct random_stream_object *stream,	*/
+/*			double mean, double std)			*/
+/*  double unifdist(struct random_stream_object *stream,	*/
+/*			double min, double max)				*/
 /*                                                              */
 /*  OPTIONS                                                     */
 /*                                                              */
 /*  DESCRIPTION                                                 */
 /*                                                              */
-/*                                                              */
+/*  Counter based random numbers: draw n of a stream is a hash	*/
+/*  of (seed, entity ID, date, n), so a stream holds no state	*/
+/*  beyond its key and draw counter.  Two streams with the same	*/
+/*  key give the same numbers whatever thread runs them and in	*/
+/*  whatever order, which keeps parallel runs reproducible for	*/
+/*  a given -seed.						*/
 /*                                                              */
 /*  PROGRAMMER NOTES                                            */
 /*                                                              */
-/*                                                              */
-/* gasdev taken from Numerical Recipes in C			*/
-/* World Wide Web sample page from NUMERICAL RECIPES IN C: THE ART OF SCIENTIFIC COMPUTING (ISBN 0-521-43108-5) */
+/*  replaces the libc rand() based gasdev/unifdist, whose	*/
+/*  hidden global state was shared by all threads		*/
+/*  the hash is the splitmix64 finalizer (Steele, Lea and	*/
+/*  Flood 2014)							*/
 /*                                                              */
 /*--------------------------------------------------------------*/
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
-#include "rhessys.h" 
-#include <time.h> 
-/*--------------------------------------------------------------*/
-/* "Minimal random number generator of Park and Miller with Bays-Durham shuffle and added safeguards.  
-/* Returns a uniform random deviate between 0.0 and 1.0 (exclusive of the endpoint values).
-/* Call with idum a negative integer to initialize; thereafter, do not alther idum between succesive deviates in a sequence
-/* RNMX should approximate the largest floating value that is less than 1. */
-/*--------------------------------------------------------------*/
+#include "rhessys.h"
 
-#define IA 16807
-#define IM 2147483647
-#define AM (1.0/IM)
-#define IQ 127773
-#define IR 2836
-#define NTAB 32
-#define EDIV (1+(IM-1)/NTAB)
-#define EPS 1.2e-7
-#define RNMX (1.0-EPS)
-
-float ran1(long *idum)
+#define GOLDEN_GAMMA 0x9E3779B97F4A7C15ULL
 
+static unsigned long long mix_random_key(unsigned long long x)
 {
-	int j;
-	long k;
-	static long iy=0;
-	static long iv[NTAB];
-	float temp;
-	
-	if (*idum <= 0 || !iy) {         /*Initialize*/
-		if (-(*idum) < 1) *idum=1; /*Be sure to prevent idum=0*/
-		else *idum = -(*idum);
-		for (j=NTAB+7; j>=0; j--) { /*Load the shuffle table (after 8 warm-ups)*/
-			k=(*idum)/IQ;
-			*idum=IA*(*idum-k*IQ)-IR*k;
-			if (*idum < 0) *idum += IM;
-			if (j < NTAB) iv[j] = *idum;
-		}
-		iy=iv[0];
-	}
-	k=(*idum)/IQ;		/*Start here when not initializing*/
-	*idum=IA*(*idum-k*IQ)-IR*k;	/*Compute idum=(IS*idum) % IM without overflows by Schrage's method*/
-	if (*idum < 0) *idum += IM;
-	j=iy/EDIV;				/*Will be in the range 0..NTAB-1*/
-	iy=iv[j];				/*Output previously stored value and refill the shuffle table*/
-	iv[j] = *idum;
-
-	temp = AM*iy;
-	if ((temp=AM*iy) > RNMX) return RNMX;	
-	else return temp;
+	x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+	return(x ^ (x >> 31));
 }
 
-#include <math.h>
 /*--------------------------------------------------------------*/
-/*Returns a normally distributed deviate with zero mean and unit variance, using ran1(idum) as the source of uniform deviates*/
+/*	stream for one entity (zone, patch, ...) on one date	*/
 /*--------------------------------------------------------------*/
+struct random_stream_object init_random_stream(long seed, int ID, struct date date)
+{
+	struct random_stream_object stream;
+
+	stream.key = mix_random_key((unsigned long long)seed + GOLDEN_GAMMA);
+	stream.key = mix_random_key(stream.key ^ (unsigned long long)(unsigned int)ID);
+	stream.key = mix_random_key(stream.key ^ (unsigned long long)(date.year * 1000000
+		+ date.month * 10000 + date.day * 100 + date.hour));
+	stream.counter = 0;
+	return(stream);
+}
 
-float gasdev ()
+/*--------------------------------------------------------------*/
+/*	uniform deviate in (0,1), exclusive of the end points	*/
+/*--------------------------------------------------------------*/
+double random_uniform(struct random_stream_object *stream)
 {
-	static int iset=0;
-	static float gset;
-	float fac,rsq,v1,v2;
-	
-		if (iset == 0) {
-		do {
- /* We dont have an extra deviate handy, so pick two uniform numbers in the square extending from -1 to +1 in each direction, see if they are in the unit circle*/
-			v1=2.0*rand()/(RAND_MAX+1.0)-1.0; 
-			v2=2.0*rand()/(RAND_MAX+1.0)-1.0;
-			rsq=v1*v1+v2*v2;
-			} while (rsq >= 1.0 || rsq == 0.0);		/*and if they are not, try again*/
-			fac=sqrt(-2.0*log(rsq)/rsq);
-			/*Now make the Box-Muller transformation to get two normal deviates.  Return one and save the other for next time*/
-			gset=v1*fac;
-			iset=1;				/*set flag*/
-			return v2*fac;
-		} else {				/*We have an extra deviate handy, so unset the flag and return it*/
-			iset=0;
-			return gset;
-		}
-	}
-double normdist(double mean, double std)
+	unsigned long long x;
+
+	stream->counter++;
+	x = mix_random_key(stream->key + stream->counter * GOLDEN_GAMMA);
+	return(((double)(x >> 11) + 0.5) / 9007199254740992.0);
+}
+
+/*--------------------------------------------------------------*/
+/*	normal deviate (Box-Muller, two uniform draws)		*/
+/*--------------------------------------------------------------*/
+double normdist(struct random_stream_object *stream, double mean, double std)
 {
 	/*------------------------------------------------------*/
 	/*	Local Variable Definition. 							*/
 	/*------------------------------------------------------*/
 
-	double result;
+	double result, u1, u2;
 
-	float gasdev();
+	u1 = random_uniform(stream);
+	u2 = random_uniform(stream);
+	result = sqrt(-2.0 * log(u1)) * cos(2.0 * PI * u2) * std + mean;
 
-	result = gasdev()*std+mean;
-	
 	return(result);
 }
 
 
-double unifdist(double min, double max)
+double unifdist(struct random_stream_object *stream, double min, double max)
 {
 	/*------------------------------------------------------*/
 	/*	Local Variable Definition. 							*/
@@ -129,12 +103,10 @@ double unifdist(double min, double max)
 
 	double result, range;
 
-
-    int random_integer = rand(); 
 		range = max-min;
 
 	if (range > 0)
-		result = random_integer/(RAND_MAX+1.0)*range+min;
+		result = random_uniform(stream)*range+min;
 	else
 		result = 0;
 
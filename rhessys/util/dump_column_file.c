@@ -0,0 +1,145 @@
+/*--------------------------------------------------------------*/
+/* 																*/
+/*					dump_column_file							*/
+/*																*/
+/*	dump_column_file - prints a column output file as text		*/
+/*																*/
+/*	NAME														*/
+/*	dump_column_file - prints a column output file as text		*/
+/*																*/
+/*	SYNOPSIS													*/
+/*	void dump_column_file(char *filename)						*/
+/*																*/
+/*	OPTIONS														*/
+/*	-coldump <file>												*/
+/*																*/
+/*	DESCRIPTION													*/
+/*																*/
+/*	Reads a file written with -colout (see column_file.c) and	*/
+/*	prints it to stdout as the .daily text file: a line of		*/
+/*	column names, then one line per record with ints printed	*/
+/*	%d and doubles %lf, separated by single spaces.				*/
+/*																*/
+/*	PROGRAMMER NOTES											*/
+/*																*/
+/*	the file must come from a machine with the same byte order	*/
+/*--------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <zlib.h>
+#include "rhessys.h"
+
+static void column_file_error(char *filename, char *problem)
+{
+	fprintf(stderr,"FATAL ERROR: in dump_column_file, %s %s\n", problem, filename);
+	exit(EXIT_FAILURE);
+}
+
+void dump_column_file(char *filename)
+{
+	/*--------------------------------------------------------------*/
+	/*	local function declarations.								*/
+	/*--------------------------------------------------------------*/
+	void	*alloc(size_t, char *, char *);
+	/*--------------------------------------------------------------*/
+	/*	local variable declarations 								*/
+	/*--------------------------------------------------------------*/
+	int	c, b, r, width;
+	int32_t	version, num_columns, num_rows, length, ivalue;
+	int32_t	*types;
+	uint32_t	size;
+	uLongf	values_size;
+	double	dvalue;
+	char	magic[8];
+	char	**names;
+	unsigned char	**values;
+	unsigned char	*compressed, *shuffled;
+	FILE	*file;
+
+	if ((file = fopen(filename, "rb")) == NULL)
+		column_file_error(filename, "cannot open");
+	if ((fread(magic, 1, 8, file) != 8) || (memcmp(magic, COLUMN_FILE_MAGIC, 8) != 0)
+		|| (fread(&version, sizeof(int32_t), 1, file) != 1)
+		|| (fread(&num_columns, sizeof(int32_t), 1, file) != 1))
+		column_file_error(filename, "not a column output file:");
+	if ((version != COLUMN_FILE_VERSION) || (num_columns < 0))
+		column_file_error(filename, "unknown version or column count in");
+
+	/*--------------------------------------------------------------*/
+	/*	names and types											*/
+	/*--------------------------------------------------------------*/
+	types = (int32_t *) alloc((num_columns+1) * sizeof(int32_t),
+		"types", "dump_column_file");
+	names = (char **) alloc((num_columns+1) * sizeof(char *),
+		"names", "dump_column_file");
+	values = (unsigned char **) alloc((num_columns+1) * sizeof(unsigned char *),
+		"values", "dump_column_file");
+	for (c=0; c<num_columns; c++) {
+		if ((fread(&(types[c]), sizeof(int32_t), 1, file) != 1)
+			|| (fread(&length, sizeof(int32_t), 1, file) != 1)
+			|| (length < 0) || (length > FILEPATH_LEN))
+			column_file_error(filename, "truncated header in");
+		names[c] = (char *) alloc(length+1, "names", "dump_column_file");
+		if (fread(names[c], 1, length, file) != (size_t) length)
+			column_file_error(filename, "truncated header in");
+		names[c][length] = '\0';
+		values[c] = (unsigned char *) alloc(COLUMN_BLOCK_ROWS * sizeof(double),
+			"values", "dump_column_file");
+		printf("%s%s", (c > 0) ? " " : "", names[c]);
+	}
+	printf("\n");
+
+	/*--------------------------------------------------------------*/
+	/*	blocks														*/
+	/*--------------------------------------------------------------*/
+	shuffled = (unsigned char *) alloc(COLUMN_BLOCK_ROWS * sizeof(double),
+		"shuffled", "dump_column_file");
+	compressed = (unsigned char *) alloc(compressBound(COLUMN_BLOCK_ROWS * sizeof(double)),
+		"compressed", "dump_column_file");
+	while (fread(&num_rows, sizeof(int32_t), 1, file) == 1) {
+		if ((num_rows < 1) || (num_rows > COLUMN_BLOCK_ROWS))
+			column_file_error(filename, "bad block in");
+		for (c=0; c<num_columns; c++) {
+			width = (types[c] == COLUMN_INT) ? sizeof(int32_t) : sizeof(double);
+			if ((fread(&size, sizeof(uint32_t), 1, file) != 1)
+				|| (size > compressBound(COLUMN_BLOCK_ROWS * sizeof(double)))
+				|| (fread(compressed, 1, size, file) != size))
+				column_file_error(filename, "truncated block in");
+			values_size = (uLongf) num_rows*width;
+			if ((uncompress(shuffled, &values_size, compressed, size) != Z_OK)
+				|| (values_size != (uLongf) num_rows*width))
+				column_file_error(filename, "corrupt block in");
+			for (b=0; b<width; b++)
+				for (r=0; r<num_rows; r++)
+					values[c][r*width+b] = shuffled[b*num_rows+r];
+		}
+		for (r=0; r<num_rows; r++) {
+			for (c=0; c<num_columns; c++) {
+				if (c > 0)
+					printf(" ");
+				if (types[c] == COLUMN_INT) {
+					memcpy(&ivalue, values[c] + r*sizeof(int32_t), sizeof(int32_t));
+					printf("%d", ivalue);
+				}
+				else {
+					memcpy(&dvalue, values[c] + r*sizeof(double), sizeof(double));
+					printf("%lf", dvalue);
+				}
+			}
+			printf("\n");
+		}
+	}
+	fclose(file);
+	for (c=0; c<num_columns; c++) {
+		free(names[c]);
+		free(values[c]);
+	}
+	free(types);
+	free(names);
+	free(values);
+	free(shuffled);
+	free(compressed);
+	return;
+} /*end dump_column_file*/
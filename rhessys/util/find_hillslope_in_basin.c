@@ -32,36 +32,23 @@ struct hillslope_object *find_hillslope_in_basin(
 	/*------------------------------------------------------*/
 	/*	Local Function Definition. 							*/
 	/*------------------------------------------------------*/
+	void *find_in_id_index( struct id_index_object *, void *, int);
 	
 	/*------------------------------------------------------*/
 	/*	Local Variable Definition. 							*/
 	/*------------------------------------------------------*/
-	int i;
-	int fnd;
 	struct hillslope_object *hillslope;
 
 	/*--------------------------------------------------------------*/
-	/*	find stratum						*/
+	/*	find hillslope						*/
 	/*--------------------------------------------------------------*/
-	i = 0;
-	fnd = 0;
-	hillslope = NULL;
-	
-	while ( (fnd == 0) && (i >= 0) && (i < basin[0].num_hillslopes)) {
-		if (basin[0].hillslopes[i][0].ID == hillslope_ID) {
-			hillslope = basin[0].hillslopes[i];
-			fnd = 1;
-		}
-		else {
-			i += 1;
-		}
-	}
-	if (fnd == 0) {
+	hillslope = (struct hillslope_object *) find_in_id_index(
+		basin[0].id_index, basin, hillslope_ID);
+	if (hillslope == NULL) {
 		fprintf(stderr,
 				"Could not find hillslope %d in  basin %d. Skipping hillslope...\n",
 				hillslope_ID,
 				basin[0].ID);		
-		hillslope = NULL;
 		/*exit(EXIT_FAILURE);*/
 	}
 
@@ -0,0 +1,68 @@
+/*--------------------------------------------------------------*/
+/*                                                              */
+/*		find_in_id_index				*/
+/*                                                              */
+/*  NAME                                                        */
+/*		find_in_id_index				*/
+/*                                                              */
+/*                                                              */
+/*  SYNOPSIS                                                    */
+/*  void *find_in_id_index( struct id_index_object *index,	*/
+/*			void *parent, int ID)			*/
+/*                                                              */
+/*  OPTIONS                                                     */
+/*                                                              */
+/*  DESCRIPTION                                                 */
+/*                                                              */
+/*	returns the object with the given ID directly within	*/
+/*	parent (a hillslope of a basin, a zone of a hillslope,	*/
+/*	a patch of a zone or a stratum of a patch), or NULL	*/
+/*	if there is none					*/
+/*                                                              */
+/*  PROGRAMMER NOTES                                            */
+/*                                                              */
+/*	the index is filled by construct_id_index		*/
+/*	id_index_slot is shared with it so both hash the same	*/
+/*	way							*/
+/*                                                              */
+/*--------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdint.h>
+#include "rhessys.h"
+
+/*--------------------------------------------------------------*/
+/*	first slot to probe for (parent, ID)			*/
+/*--------------------------------------------------------------*/
+int id_index_slot( struct id_index_object *index, void *parent, int ID)
+{
+	uint64_t h;
+
+	h = ((uint64_t)(uintptr_t) parent >> 4) * 0x9E3779B97F4A7C15ULL;
+	h ^= (uint64_t)(uint32_t) ID * 0xC2B2AE3D27D4EB4FULL;
+	h ^= h >> 29;
+	return((int)(h & (uint64_t)(index[0].size - 1)));
+}
+
+void *find_in_id_index( struct id_index_object *index,
+					   void *parent,
+					   int ID)
+{
+	/*------------------------------------------------------*/
+	/*	Local Variable Definition. 							*/
+	/*------------------------------------------------------*/
+	int i;
+	struct id_index_entry_object *entry;
+
+	if ((index == NULL) || (parent == NULL))
+		return(NULL);
+	i = id_index_slot(index, parent, ID);
+	entry = &(index[0].entries[i]);
+	while (entry[0].parent != NULL) {
+		if ((entry[0].parent == parent) && (entry[0].ID == ID))
+			return(entry[0].object);
+		i = (i + 1) & (index[0].size - 1);
+		entry = &(index[0].entries[i]);
+	}
+	return(NULL);
+}/*end find_in_id_index */
@@ -33,30 +33,20 @@ struct patch_object *find_patch( int patch_ID, int zone_ID, int hill_ID,
 	/*------------------------------------------------------*/
 	/*	Local Function Definition. 							*/
 	/*------------------------------------------------------*/
+	void *find_in_id_index( struct id_index_object *, void *, int);
 	
 	/*------------------------------------------------------*/
 	/*	Local Variable Definition. 							*/
 	/*------------------------------------------------------*/
-	int i;
-	int fnd;
 	struct zone_object *zone;
 	struct hillslope_object *hillslope;
 	struct patch_object *patch;
 	/*--------------------------------------------------------------*/
 	/*	find hillslopes												*/
 	/*--------------------------------------------------------------*/
-	i = 0;
-	fnd = 0;
-	while ( (fnd == 0) && (i >= 0) && (i < basin[0].num_hillslopes)) {
-		if (basin[0].hillslopes[i][0].ID == hill_ID) {
-			hillslope = basin[0].hillslopes[i];
-			fnd = 1;
-		}
-		else {
-			i += 1;
-		}
-	}
-	if (fnd == 0){
+	hillslope = (struct hillslope_object *) find_in_id_index(
+		basin[0].id_index, basin, hill_ID);
+	if (hillslope == NULL){
 		fprintf(stderr,
 			"FATAL ERROR: Could not find hillslope %d in find_patch\n",hill_ID);
 		exit(EXIT_FAILURE);
@@ -64,18 +54,9 @@ struct patch_object *find_patch( int patch_ID, int zone_ID, int hill_ID,
 	/*--------------------------------------------------------------*/
 	/*	find zones						*/
 	/*--------------------------------------------------------------*/
-	i = 0;
-	fnd = 0;
-	while ( (fnd == 0) && (i >= 0) && (i < hillslope[0].num_zones)) {
-		if (hillslope[0].zones[i][0].ID == zone_ID) {
-			zone = hillslope[0].zones[i];
-			fnd = 1;
-		}
-		else {
-			i += 1;
-		}
-	}
-	if (fnd == 0) {
+	zone = (struct zone_object *) find_in_id_index(
+		basin[0].id_index, hillslope, zone_ID);
+	if (zone == NULL) {
 		fprintf(stderr,
 			"FATAL ERROR: Could not find zone %d in find_patch\n",zone_ID);
 		exit(EXIT_FAILURE);
@@ -83,18 +64,9 @@ struct patch_object *find_patch( int patch_ID, int zone_ID, int hill_ID,
 	/*--------------------------------------------------------------*/
 	/*	find patches						*/
 	/*--------------------------------------------------------------*/
-	i = 0;
-	fnd = 0;
-	while ( (fnd == 0) && (i >= 0) && (i < zone[0].num_patches)) {
-		if (zone[0].patches[i][0].ID == patch_ID) {
-			patch = zone[0].patches[i];
-			fnd = 1;
-		}
-		else {
-			i += 1;
-		}
-	}
-	if (fnd == 0) {
+	patch = (struct patch_object *) find_in_id_index(
+		basin[0].id_index, zone, patch_ID);
+	if (patch == NULL) {
 		fprintf(stderr,
 			"FATAL ERROR: Could not find patch %d in zone %d hill %d\n",
 			patch_ID, zone_ID, hill_ID);
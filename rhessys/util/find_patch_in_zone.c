@@ -7,7 +7,9 @@
 /*                                                              */
 /*                                                              */
 /*  SYNOPSIS                                                    */
-/*  find_patch_in_zone( struct basin_object *basin)			*/
+/*  find_patch_in_zone( int patch_ID,				*/
+/*		struct zone_object *zone,			*/
+/*		struct basin_object *basin)			*/
 /*                                                              */
 /*  OPTIONS                                                     */
 /*                                                              */
@@ -27,42 +29,23 @@
 
 struct patch_object *find_patch_in_zone(
 										  int patch_ID,
-										  struct zone_object *zone)
+										  struct zone_object *zone,
+										  struct basin_object *basin)
 {
 	/*------------------------------------------------------*/
 	/*	Local Function Definition. 							*/
 	/*------------------------------------------------------*/
+	void *find_in_id_index( struct id_index_object *, void *, int);
 	
 	/*------------------------------------------------------*/
 	/*	Local Variable Definition. 							*/
 	/*------------------------------------------------------*/
-	int i;
-	int fnd;
 	struct patch_object *patch;
 
 	/*--------------------------------------------------------------*/
-	/*	find stratum						*/
+	/*	find patch						*/
 	/*--------------------------------------------------------------*/
-	i = 0;
-	fnd = 0;
-	patch = NULL;
-	
-	while ( (fnd == 0) && (i >= 0) && (i < zone[0].num_patches)) {
-		if (zone[0].patches[i][0].ID == patch_ID) {
-			patch = zone[0].patches[i];
-			fnd = 1;
-		}
-		else {
-			i += 1;
-		}
-	}
-	if (fnd == 0) {
-		/*fprintf(stderr,
-			"FATAL ERROR: Could not find patch %d in  zone %d \n",
-			patch_ID,
-			zone[0].ID);*/
-		patch = NULL;
-		/*exit(EXIT_FAILURE);*/
-	}
+	patch = (struct patch_object *) find_in_id_index(
+		basin[0].id_index, zone, patch_ID);
 	return(patch);
 }/*end find_patch_in_zone */
@@ -38,6 +38,7 @@ struct canopy_strata_object *find_stratum(
 	/*------------------------------------------------------*/
 	/*	Local Function Definition. 							*/
 	/*------------------------------------------------------*/
+	void *find_in_id_index( struct id_index_object *, void *, int);
 	
 	/*------------------------------------------------------*/
 	/*	Local Variable Definition. 							*/
@@ -71,18 +72,9 @@ struct canopy_strata_object *find_stratum(
 	/*--------------------------------------------------------------*/
 	/*	find hillslopes												*/
 	/*--------------------------------------------------------------*/
-	i = 0;
-	fnd = 0;
-	while ( (fnd == 0) && (i >= 0) && (i < basin[0].num_hillslopes)) {
-		if (basin[0].hillslopes[i][0].ID == hill_ID) {
-			hillslope = basin[0].hillslopes[i];
-			fnd = 1;
-		}
-		else {
-			i += 1;
-		}
-	}
-	if (fnd == 0) {
+	hillslope = (struct hillslope_object *) find_in_id_index(
+		basin[0].id_index, basin, hill_ID);
+	if (hillslope == NULL) {
 		fprintf(stderr,
 			"FATAL ERROR: Could not find hillslope %d in find_stratum\n",
 			hill_ID);
@@ -91,19 +83,9 @@ struct canopy_strata_object *find_stratum(
 	/*--------------------------------------------------------------*/
 	/*	find zones						*/
 	/*--------------------------------------------------------------*/
-	i = 0;
-	fnd = 0;
-	while ( (fnd == 0) && (i >= 0) && (i < hillslope[0].num_zones)) {
-		if (hillslope[0].zones[i][0].ID == zone_ID) {
-			zone = hillslope[0].zones[i];
-			fnd = 1;
-		}
-		else {
-			i += 1;
-		}
-	}
-	// fprintf("Zone ID: %d\n",zone_ID); // ejh remove this
-	if (fnd == 0) {
+	zone = (struct zone_object *) find_in_id_index(
+		basin[0].id_index, hillslope, zone_ID);
+	if (zone == NULL) {
 		fprintf(stderr,
 			"FATAL ERROR: Could not find zone %d in find_stratum, stratum = %d \n",zone_ID, stratum_ID);
 		exit(EXIT_FAILURE);
@@ -111,18 +93,9 @@ struct canopy_strata_object *find_stratum(
 	/*--------------------------------------------------------------*/
 	/*	find patches						*/
 	/*--------------------------------------------------------------*/
-	i = 0;
-	fnd = 0;
-	while ( (fnd == 0) && (i >= 0) && (i < zone[0].num_patches)) {
-		if (zone[0].patches[i][0].ID == patch_ID) {
-			patch = zone[0].patches[i];
-			fnd = 1;
-		}
-		else {
-			i += 1;
-		}
-	}
-	if (fnd == 0) {
+	patch = (struct patch_object *) find_in_id_index(
+		basin[0].id_index, zone, patch_ID);
+	if (patch == NULL) {
 		fprintf(stderr,
 			"FATAL ERROR: Could not find patch %d in zone %d hill %d\n",
 			patch_ID,
@@ -133,18 +106,9 @@ struct canopy_strata_object *find_stratum(
 	/*--------------------------------------------------------------*/
 	/*	find stratum						*/
 	/*--------------------------------------------------------------*/
-	i = 0;
-	fnd = 0;
-	while ( (fnd == 0) && (i >= 0) && (i < patch[0].num_canopy_strata)) {
-		if (patch[0].canopy_strata[i][0].ID == stratum_ID) {
-			stratum = patch[0].canopy_strata[i];
-			fnd = 1;
-		}
-		else {
-			i += 1;
-		}
-	}
-	if (fnd == 0) {
+	stratum = (struct canopy_strata_object *) find_in_id_index(
+		basin[0].id_index, patch, stratum_ID);
+	if (stratum == NULL) {
 		fprintf(stderr,
 			"FATAL ERROR: Could not find stratum %d in  patch %d in zone %d hill %d\n",
 			stratum_ID,
@@ -7,7 +7,9 @@
 /*                                                              */
 /*                                                              */
 /*  SYNOPSIS                                                    */
-/*  find_stratum_in_patch( struct basin_object *basin)			*/
+/*  find_stratum_in_patch( int stratum_ID,			*/
+/*		struct patch_object *patch,			*/
+/*		struct basin_object *basin)			*/
 /*                                                              */
 /*  OPTIONS                                                     */
 /*                                                              */
@@ -29,42 +31,23 @@
 
 struct canopy_strata_object *find_stratum_in_patch(
 										  int stratum_ID,
-										  struct patch_object *patch)
+										  struct patch_object *patch,
+										  struct basin_object *basin)
 {
 	/*------------------------------------------------------*/
 	/*	Local Function Definition. 							*/
 	/*------------------------------------------------------*/
+	void *find_in_id_index( struct id_index_object *, void *, int);
 	
 	/*------------------------------------------------------*/
 	/*	Local Variable Definition. 							*/
 	/*------------------------------------------------------*/
-	int i;
-	int fnd;
 	struct canopy_strata_object *stratum;
 
 	/*--------------------------------------------------------------*/
 	/*	find stratum						*/
 	/*--------------------------------------------------------------*/
-	i = 0;
-	fnd = 0;
-	stratum = NULL;
-	
-	while ( (fnd == 0) && (i >= 0) && (i < patch[0].num_canopy_strata)) {
-		if (patch[0].canopy_strata[i][0].ID == stratum_ID) {
-			stratum = patch[0].canopy_strata[i];
-			fnd = 1;
-		}
-		else {
-			i += 1;
-		}
-	}
-	if (fnd == 0) {
-		/*fprintf(stderr,
-			"FATAL ERROR: Could not find stratum %d in  patch %d \n",
-			stratum_ID,
-			patch[0].ID);*/
-		stratum = NULL;
-		/*exit(EXIT_FAILURE);*/
-	}
+	stratum = (struct canopy_strata_object *) find_in_id_index(
+		basin[0].id_index, patch, stratum_ID);
 	return(stratum);
 }/*end find.stratum*/
@@ -7,7 +7,9 @@
 /*                                                              */
 /*                                                              */
 /*  SYNOPSIS                                                    */
-/*  find_zone_in_hillslope( struct basin_object *basin)			*/
+/*  find_zone_in_hillslope( int zone_ID,			*/
+/*		struct hillslope_object *hillslope,		*/
+/*		struct basin_object *basin)			*/
 /*                                                              */
 /*  OPTIONS                                                     */
 /*                                                              */
@@ -27,42 +29,23 @@
 
 struct zone_object *find_zone_in_hillslope(
 										  int zone_ID,
-										  struct hillslope_object *hillslope)
+										  struct hillslope_object *hillslope,
+										  struct basin_object *basin)
 {
 	/*------------------------------------------------------*/
 	/*	Local Function Definition. 							*/
 	/*------------------------------------------------------*/
+	void *find_in_id_index( struct id_index_object *, void *, int);
 	
 	/*------------------------------------------------------*/
 	/*	Local Variable Definition. 							*/
 	/*------------------------------------------------------*/
-	int i;
-	int fnd;
 	struct zone_object *zone;
 
 	/*--------------------------------------------------------------*/
-	/*	find stratum						*/
+	/*	find zone						*/
 	/*--------------------------------------------------------------*/
-	i = 0;
-	fnd = 0;
-	zone = NULL;
-	
-	while ( (fnd == 0) && (i >= 0) && (i < hillslope[0].num_zones)) {
-		if (hillslope[0].zones[i][0].ID == zone_ID) {
-			zone = hillslope[0].zones[i];
-			fnd = 1;
-		}
-		else {
-			i += 1;
-		}
-	}
-	if (fnd == 0) {
-		/*fprintf(stderr,
-			"FATAL ERROR: Could not find zone %d in  hillslope %d \n",
-			zone_ID,
-			hillslope[0].ID);*/
-		zone = NULL;
-		/*exit(EXIT_FAILURE);*/
-	}
+	zone = (struct zone_object *) find_in_id_index(
+		basin[0].id_index, hillslope, zone_ID);
 	return(zone);
 }/*end find_zone_in_hillslope */
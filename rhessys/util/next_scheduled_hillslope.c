@@ -0,0 +1,92 @@
+/*--------------------------------------------------------------*/
+/* 																*/
+/*					next_scheduled_hillslope					*/
+/*																*/
+/*	next_scheduled_hillslope.c - hands hillslopes to threads	*/
+/*																*/
+/*	NAME														*/
+/*	next_scheduled_hillslope.c - hands hillslopes to threads	*/
+/*																*/
+/*	SYNOPSIS													*/
+/*	int next_scheduled_hillslope( 								*/
+/*				struct hillslope_schedule_object *schedule,		*/
+/*				int h,											*/
+/*				double *start)									*/
+/*																*/
+/*	OPTIONS														*/
+/*																*/
+/*	DESCRIPTION													*/
+/*																*/
+/*	Called by every thread of an omp parallel region as			*/
+/*																*/
+/*		h = -1;													*/
+/*		while ((h = next_scheduled_hillslope(schedule, h,		*/
+/*				&start)) >= 0) { ... basin[0].hillslopes[h] ... } */
+/*																*/
+/*	Books the wall time since *start against hillslope h (the	*/
+/*	one the thread just finished) and returns the index of the	*/
+/*	next hillslope to run, or -1 when the loop is done.			*/
+/*	Threads first empty the queue(s) they own; in steal mode	*/
+/*	they then take hillslopes from the other queues.			*/
+/*																*/
+/*	PROGRAMMER NOTES											*/
+/*																*/
+/*	queue q is owned by thread q % team so no hillslope is		*/
+/*	lost if the team is smaller than the number of queues.		*/
+/*	reset_hillslope_queues must be called (outside the			*/
+/*	parallel region) before each loop.							*/
+/*--------------------------------------------------------------*/
+#include <stdio.h>
+#include <omp.h>
+#include "rhessys.h"
+
+int next_scheduled_hillslope(struct hillslope_schedule_object *schedule,
+							 int h,
+							 double *start)
+{
+	/*--------------------------------------------------------------*/
+	/*	Local variable definition.									*/
+	/*--------------------------------------------------------------*/
+	int k, q, n, pass, thread, team;
+	double now;
+
+	thread = omp_get_thread_num();
+	team = omp_get_num_threads();
+	now = omp_get_wtime();
+
+	/*--------------------------------------------------------------*/
+	/*	book the hillslope just finished			*/
+	/*--------------------------------------------------------------*/
+	if (h >= 0) {
+		schedule->wall_time[h] += now - *start;
+		if (thread < schedule->num_threads) {
+			schedule->thread_load[thread] += now - *start;
+			schedule->thread_hillslopes[thread]++;
+		}
+	}
+
+	/*--------------------------------------------------------------*/
+	/*	claim the next entry of an own queue, then (steal mode)	*/
+	/*	of any other queue						*/
+	/*--------------------------------------------------------------*/
+	for (pass = 0; pass < 2; pass++) {
+		if ((pass == 1) && (schedule->mode != HILLSLOPE_SCHEDULE_STEAL))
+			break;
+		for (k = 0; k < schedule->num_threads; k++) {
+			q = (thread + k) % schedule->num_threads;
+			if ((pass == 0) != ((q % team) == thread))
+				continue;
+			#pragma omp atomic read
+			n = schedule->queue_next[q];
+			if (n >= schedule->queue_start[q+1])
+				continue;
+			#pragma omp atomic capture
+			n = schedule->queue_next[q]++;
+			if (n < schedule->queue_start[q+1]) {
+				*start = omp_get_wtime();
+				return(schedule->order[n]);
+			}
+		}
+	}
+	return(-1);
+} /*end next_scheduled_hillslope.c*/
@@ -0,0 +1,77 @@
+/*--------------------------------------------------------------*/
+/* 																*/
+/*					order_basins_by_cost						*/
+/*																*/
+/*	order_basins_by_cost.c - sorts basins by predicted cost		*/
+/*																*/
+/*	NAME														*/
+/*	order_basins_by_cost.c - sorts basins by predicted cost		*/
+/*																*/
+/*	SYNOPSIS													*/
+/*	void order_basins_by_cost( 									*/
+/*				struct world_object *world)						*/
+/*																*/
+/*	OPTIONS														*/
+/*																*/
+/*	DESCRIPTION													*/
+/*																*/
+/*	For the -basinparallel option basins are handed to threads	*/
+/*	one at a time in world[0].basin_order.  Putting the most	*/
+/*	expensive basins first (summed hillslope cost from the		*/
+/*	hillslope schedule, see update_hillslope_schedule) keeps	*/
+/*	a large basin from starting last and holding up the day.	*/
+/*																*/
+/*	PROGRAMMER NOTES											*/
+/*																*/
+/*	ties are broken by basin index								*/
+/*--------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include "rhessys.h"
+
+struct	basin_cost_object
+	{
+	double	cost;
+	int	b;
+	};
+
+static int compare_basin_cost(const void *a, const void *b)
+{
+	const struct basin_cost_object *ca = a;
+	const struct basin_cost_object *cb = b;
+	if (ca->cost > cb->cost) return(-1);
+	if (ca->cost < cb->cost) return(1);
+	return(ca->b - cb->b);
+}
+
+void order_basins_by_cost(struct world_object *world)
+{
+	/*--------------------------------------------------------------*/
+	/*	Local function definition.									*/
+	/*--------------------------------------------------------------*/
+	void *alloc(size_t, char *, char *);
+
+	/*--------------------------------------------------------------*/
+	/*	Local variable definition.									*/
+	/*--------------------------------------------------------------*/
+	int b, h;
+	struct basin_cost_object *sorted;
+	struct hillslope_schedule_object *schedule;
+
+	sorted = (struct basin_cost_object *)alloc(max(world[0].num_basin_files, 1) *
+		sizeof(struct basin_cost_object), "sorted", "order_basins_by_cost");
+	for (b = 0; b < world[0].num_basin_files; b++) {
+		schedule = &(world[0].basins[b][0].schedule);
+		sorted[b].cost = 0.0;
+		for (h = 0; h < schedule->num_hillslopes; h++)
+			sorted[b].cost += schedule->cost[h];
+		sorted[b].b = b;
+	}
+	qsort(sorted, world[0].num_basin_files, sizeof(struct basin_cost_object),
+		compare_basin_cost);
+	for (b = 0; b < world[0].num_basin_files; b++)
+		world[0].basin_order[b] = sorted[b].b;
+
+	free(sorted);
+	return;
+} /*end order_basins_by_cost.c*/
@@ -3,31 +3,123 @@
 #include <stdlib.h>
 #include "params.h"
 
+/* A parameter array is one allocation: a paramIndex followed by the parameters.
+   The index hashes parameter names into buckets chained through param.next, so
+   the get* functions find a parameter without scanning the whole array. The
+   array grows by doubling; callers keep passing the param * and count as before
+   and must release the array with freeParams, not free. */
+
+static paramIndex * paramIndexOf(param *params)
+{
+    return ((paramIndex *) params) - 1;
+}
+
+static unsigned int hashParamName(char *paramName)
+{
+    unsigned int h = 5381;
+
+    while (*paramName != '\0')
+        h = h * 33 + (unsigned char) *paramName++;
+
+    return h % PARAM_HASH_SIZE;
+}
+
+/* Index of the first parameter named paramName, -1 if there is none */
+static int findParam(param *params, char *paramName)
+{
+    int iParam;
+
+    if (params == NULL)
+        return -1;
+
+    for (iParam = paramIndexOf(params)->bucket[hashParamName(paramName)]; iParam >= 0; iParam = params[iParam].next) {
+        if (strcmp(params[iParam].name, paramName) == 0)
+            return iParam;
+    }
+    return -1;
+}
+
+param * addParam(int *paramCnt, param **paramPtr, char *paramName, char *strVal)
+{
+
+    /* Append a parameter to the array, growing it if necessary, and index it by name.
+       A repeated name is stored (so printParams still sees it) but not indexed, so
+       lookups keep returning the first parameter of that name as they always have. */
+
+    int b;
+    int paramInd;
+    paramIndex *index;
+    param *params = *paramPtr;
+
+    if (params == NULL) {
+        index = (paramIndex *) malloc(sizeof(paramIndex) + 64 * sizeof(param));
+        if (index == NULL) {
+            fprintf(stderr, "FATAL ERROR: unable to allocate parameter array\n");
+            exit(EXIT_FAILURE);
+        }
+        index->capacity = 64;
+        for (b = 0; b < PARAM_HASH_SIZE; b++)
+            index->bucket[b] = -1;
+        params = (param *) (index + 1);
+    }
+    else if (*paramCnt >= paramIndexOf(params)->capacity) {
+        index = paramIndexOf(params);
+        index = (paramIndex *) realloc(index, sizeof(paramIndex) + 2 * index->capacity * sizeof(param));
+        if (index == NULL) {
+            fprintf(stderr, "FATAL ERROR: unable to grow parameter array\n");
+            exit(EXIT_FAILURE);
+        }
+        index->capacity *= 2;
+        params = (param *) (index + 1);
+    }
+    *paramPtr = params;
+
+    paramInd = *paramCnt;
+    strncpy(params[paramInd].name, paramName, PARAM_STR_LEN - 1);
+    params[paramInd].name[PARAM_STR_LEN - 1] = '\0';
+    strncpy(params[paramInd].strVal, strVal, PARAM_STR_LEN - 1);
+    params[paramInd].strVal[PARAM_STR_LEN - 1] = '\0';
+    params[paramInd].format[0] = '\0';
+    params[paramInd].accessed = 0;
+    params[paramInd].defaultValUsed = 0;
+    params[paramInd].next = -1;
+
+    if (findParam(params, params[paramInd].name) < 0) {
+        b = hashParamName(params[paramInd].name);
+        params[paramInd].next = paramIndexOf(params)->bucket[b];
+        paramIndexOf(params)->bucket[b] = paramInd;
+    }
+
+    (*paramCnt)++;
+    return &params[paramInd];
+}
+
+void freeParams(param *params)
+{
+    if (params != NULL)
+        free(paramIndexOf(params));
+}
+
 param * readParamFile(int *paramCnt, char *filename)
 {
 
     /* Read all parameters from the specified parameter file into a character array.
        The parameters will be accessed by the calling program via the get* functions
        that follow.
-       
+
        Parameters are of the format:
 
            <value> <name> <comment>
 
        for example:
-       
+
            0.071   epc.alloc_livewoodc_woodc               # White p.28 - Mean value. Was 0.60
 
     */
-   
-    int paramInd = -1;
-    int iParam;
 
     char line [1024];
-    char strbuf1 [128];
-    char strbuf2 [128];
-    char strbuf3 [128];
-    int argCnt;
+    char strbuf1 [PARAM_STR_LEN];
+    char strbuf2 [PARAM_STR_LEN];
     param *paramPtr = NULL;
     FILE *file;
 
@@ -37,256 +129,111 @@ param * readParamFile(int *paramCnt, char *filename)
         return NULL;
     }
 
-    //FILE *file = fopen ( filename, "r" );
-    if ( file != NULL ) {
-        while ( fgets ( line, sizeof line, file ) != NULL ) /* read a line */ {
-            // Char array that will hold parameter names and values (as strings)
-            if (*paramCnt == 0) {
-                paramPtr = (param *) malloc(sizeof(param));
-            } else {
-                paramPtr = (param *) realloc(paramPtr, (sizeof(param) * (*paramCnt + 1)));
-            }
-
-            (*paramCnt)++;
-            paramInd++;
-
-            //printf("paramInd: %d\n", paramInd);
-
-            /* Reset string buffers */
-            strbuf1[0] = '\0';
-            strbuf2[0] = '\0';
-            strbuf3[0] = '\0';
-            argCnt = sscanf (line, "%s %s %s", strbuf1, strbuf2, strbuf3);
-
-            /* Parse the parameter value */
-            strcpy(paramPtr[paramInd].strVal, strbuf1);
-
-            /* Parse the parameter name */
-            strcpy(paramPtr[paramInd].name, strbuf2);
-            paramPtr[paramInd].accessed = 0;
-            paramPtr[paramInd].defaultValUsed = 0;
-            //printf("\n%d param name: %s value %s", *paramCnt, paramPtr[paramInd].name, paramPtr[paramInd].strVal);
-        }
+    while ( fgets ( line, sizeof line, file ) != NULL ) /* read a line */ {
+        /* Reset string buffers */
+        strbuf1[0] = '\0';
+        strbuf2[0] = '\0';
+        sscanf (line, "%127s %127s", strbuf1, strbuf2);
 
-        fclose ( file );
-    }
-    else {
-        perror ( filename );
+        /* Parameter value, then name */
+        addParam(paramCnt, &paramPtr, strbuf2, strbuf1);
     }
 
+    fclose ( file );
+
     return paramPtr;
 
 }
 
-char * getStrParam(int *paramCnt, param **paramPtr, char *paramName, char *readFormat, char *defaultVal, int useDefaultVal) {
-
-    int iParam;
-    int sLen;
-    char *outStr;
-    int found = 0;
+/* Look up paramName; if it is missing and useDefaultVal is set, add it with the
+   default value (as text) so that printParams reports it. Returns the parameter,
+   or NULL if it is missing and no default may be used. */
+static param * lookupParam(int *paramCnt, param **paramPtr, char *paramName, char *readFormat, char *defaultStr, int useDefaultVal)
+{
     int paramInd;
+    param *p;
 
-    param *params;
-    params = *paramPtr;
-
-    /* Search for a parameter that matches the specified parameter name */
-    for (iParam = 0; iParam < *paramCnt; iParam++) {
-        if (strcmp(params[iParam].name, paramName) == 0) {
-            found = 1;
-            // Allocate an output string buffer that is the same size as the parameter value string
-            sLen = string_length(params[iParam].strVal);
-            outStr = (char *)malloc(sizeof(char) * sLen);
-            // Transform the string according to the specified format
-            sscanf(params[iParam].strVal, readFormat, outStr);
-            params[iParam].accessed = 1;
-            strcpy(params[iParam].format, readFormat);
-            break;
-        }
-    }
-
-    /* Return the requested parameter if found in the parameter list, otherwise return the default value. */
-    if (found) {
-        return outStr;
+    paramInd = findParam(*paramPtr, paramName);
+    if (paramInd >= 0) {
+        p = &(*paramPtr)[paramInd];
+        p->accessed = 1;
     } else if (useDefaultVal) {
         // Add this parameter to the list, as it wasn't found in the list
-        if (*paramCnt == 0) {
-            params = (param *) malloc(sizeof(param));
-            *paramPtr = params;
-        } else {
-            params = (param *) realloc(params, (sizeof(param) * (*paramCnt + 1)));
-            *paramPtr = params;
-        }
-
-        (*paramCnt)++;
-        paramInd = *paramCnt - 1;
-
-        /* Store the parameter name */
-        strcpy(params[paramInd].name, paramName);
-
-        /* Store the parameter value */
-        strcpy(params[paramInd].strVal, defaultVal);
-        params[paramInd].accessed = 1;
-        params[paramInd].defaultValUsed = 1;
-        strcpy(params[paramInd].format, readFormat);
-        // Allocate an output string buffer that is the same size as the parameter value string
-        sLen = string_length(defaultVal);
-        outStr = (char *)malloc(sizeof(char) * sLen);
-	sscanf(defaultVal,readFormat,outStr);
-        
-	return outStr;
+        p = addParam(paramCnt, paramPtr, paramName, defaultStr);
+        p->accessed = 1;
+        p->defaultValUsed = 1;
     } else {
         printf("\nNo parameter value found for %s and 'useDefault' flag set to false\n", paramName);
+        return NULL;
     }
+    strncpy(p->format, readFormat, sizeof(p->format) - 1);
+    p->format[sizeof(p->format) - 1] = '\0';
+    return p;
 }
 
-int getIntParam(int *paramCnt, param **paramPtr , char *paramName, char *readFormat, int defaultVal, int useDefaultVal) {
+char * getStrParam(int *paramCnt, param **paramPtr, char *paramName, char *readFormat, char *defaultVal, int useDefaultVal) {
 
-    int iParam;
-    int paramInd;
-    int sLen;
-    int intVal;
-    int found = 0;
-    param *params;
-    params = *paramPtr;
-
-    for (iParam = 0; iParam < *paramCnt; iParam++) {
-        if (strcmp(params[iParam].name, paramName) == 0) {
-            found = 1;
-            // Transform the string according to the specified format
-            sscanf(params[iParam].strVal, readFormat, &intVal);
-            params[iParam].accessed = 1;
-            strcpy(params[iParam].format, readFormat);
-            break;
-        }
-    }
+    /* Values are read as single tokens, so the stored string is returned as is
+       rather than copied into a new buffer. It stays valid until the next get*Param
+       call on the same array. */
 
-    if (found) {
-        return intVal;
-    } else if (useDefaultVal) {
-        // Add this parameter to the list, as it wasn't found in the list
-        if (*paramCnt == 0) {
-            params = (param *) malloc(sizeof(param));
-            *paramPtr = params;
-        } else {
-            params = (param *) realloc(params, (sizeof(param) * (*paramCnt + 1)));
-            *paramPtr = params;
-        }
+    param *p;
 
-        (*paramCnt)++;
-        paramInd = *paramCnt - 1;
+    p = lookupParam(paramCnt, paramPtr, paramName, readFormat, defaultVal, useDefaultVal);
+    if (p == NULL)
+        return defaultVal;
+    return p->strVal;
+}
 
-        /* Store the parameter name */
-        strcpy(params[paramInd].name, paramName);
+int getIntParam(int *paramCnt, param **paramPtr , char *paramName, char *readFormat, int defaultVal, int useDefaultVal) {
 
-        /* Store the parameter value */
-        sprintf(params[paramInd].strVal, "%d", defaultVal);
-        params[paramInd].accessed = 1;
-        params[paramInd].defaultValUsed = 1;
-        strcpy(params[paramInd].format, readFormat);
+    int intVal;
+    int cnt = *paramCnt;
+    char defaultStr[PARAM_STR_LEN];
+    param *p;
+
+    snprintf(defaultStr, sizeof(defaultStr), "%d", defaultVal);
+    p = lookupParam(paramCnt, paramPtr, paramName, readFormat, defaultStr, useDefaultVal);
+    if ((p == NULL) || (*paramCnt != cnt))
         return defaultVal;
-    } else {
-        printf("\nNo parameter value found for %s and 'useDefault' flag set to false\n", paramName);
-    }
+
+    // Transform the string according to the specified format
+    sscanf(p->strVal, readFormat, &intVal);
+    return intVal;
 }
 
 float getFloatParam(int *paramCnt, param **paramPtr , char *paramName, char *readFormat, float defaultVal, int useDefaultVal) {
 
-    int iParam;
-    int paramInd;
-    int sLen;
     float floatVal;
-    int found = 0;
-    param *params;
-    params = *paramPtr;
-
-    for (iParam = 0; iParam < *paramCnt; iParam++) {
-        if (strcmp(params[iParam].name, paramName) == 0) {
-            found = 1;
-            // Transform the string according to the specified format
-            sscanf(params[iParam].strVal, readFormat, &floatVal);
-            params[iParam].accessed = 1;
-            strcpy(params[iParam].format, readFormat);
-            break;
-        }
-    }
-
-    if (found) {
-        return floatVal;
-    } else if (useDefaultVal) {
-        // Add this parameter to the list, as it wasn't found in the list
-        if (*paramCnt == 0) {
-            params = (param *) malloc(sizeof(param));
-            *paramPtr = params;
-        } else {
-            params = (param *) realloc(params, (sizeof(param) * (*paramCnt + 1)));
-            *paramPtr = params;
-        }
+    int cnt = *paramCnt;
+    char defaultStr[PARAM_STR_LEN];
+    param *p;
 
-        (*paramCnt)++;
-        paramInd = *paramCnt - 1;
-
-        /* Store the parameter name */
-        strcpy(params[paramInd].name, paramName);
-
-        /* Store the parameter value */
-        sprintf(params[paramInd].strVal, "%f", defaultVal);
-        params[paramInd].accessed = 1;
-        params[paramInd].defaultValUsed = 1;
-        strcpy(params[paramInd].format, readFormat);
+    snprintf(defaultStr, sizeof(defaultStr), "%f", defaultVal);
+    p = lookupParam(paramCnt, paramPtr, paramName, readFormat, defaultStr, useDefaultVal);
+    if ((p == NULL) || (*paramCnt != cnt))
         return defaultVal;
-    } else {
-        printf("\nNo parameter value found for %s and 'useDefault' flag set to false\n", paramName);
-    }
+
+    // Transform the string according to the specified format
+    sscanf(p->strVal, readFormat, &floatVal);
+    return floatVal;
 }
 
 double getDoubleParam(int *paramCnt, param **paramPtr, char *paramName, char *readFormat, double defaultVal, int useDefaultVal) {
 
-    int iParam;
-    int paramInd;
-    int sLen;
     double doubleVal;
-    int found = 0;
-    param *params;
-    params = *paramPtr;
-
-    for (iParam = 0; iParam < *paramCnt; iParam++) {
-        if (strcmp(params[iParam].name, paramName) == 0) {
-            found = 1;
-            // Transform the string according to the specified format
-            sscanf(params[iParam].strVal, readFormat, &doubleVal);
-            params[iParam].accessed = 1;
-            strcpy(params[iParam].format, readFormat);
-            break;
-        }
-    }
+    int cnt = *paramCnt;
+    char defaultStr[PARAM_STR_LEN];
+    param *p;
 
-    if (found) {
-        return doubleVal;
-    } else if (useDefaultVal) {
-        // Add this parameter to the list, as it wasn't found in the list
-        if (*paramCnt == 0) {
-            params = (param *) malloc(sizeof(param));
-            *paramPtr = params;
-        } else {
-            params = (param *) realloc(params, (sizeof(param) * (*paramCnt + 1)));
-            *paramPtr = params;
-        }
-
-        (*paramCnt)++;
-        paramInd = *paramCnt - 1;
-
-        /* Store the parameter name */
-        strcpy(params[paramInd].name, paramName);
-
-        /* Store the parameter value */
-        sprintf(params[paramInd].strVal, "%f", defaultVal);
-        params[paramInd].accessed = 1;
-        params[paramInd].defaultValUsed = 1;
-        strcpy(params[paramInd].format, readFormat);
+    snprintf(defaultStr, sizeof(defaultStr), "%f", defaultVal);
+    p = lookupParam(paramCnt, paramPtr, paramName, readFormat, defaultStr, useDefaultVal);
+    if ((p == NULL) || (*paramCnt != cnt))
         return defaultVal;
-    } else {
-        printf("\nNo parameter value found for %s and 'useDefault' flag set to false\n", paramName);
-    }
+
+    // Transform the string according to the specified format
+    sscanf(p->strVal, readFormat, &doubleVal);
+    return doubleVal;
 }
 
 void printParams(int paramCnt, param *params, char *outFilename) {
@@ -300,7 +247,6 @@ void printParams(int paramCnt, param *params, char *outFilename) {
 
 
     int iParam;
-    char outFormat[64];
 
     FILE *outFile;
 
@@ -308,7 +254,7 @@ void printParams(int paramCnt, param *params, char *outFilename) {
     	fprintf(stderr, "FATAL ERROR:Error opening output parameter filename %s\n", outFilename);
     	exit(EXIT_FAILURE);
     }
-    
+
     for (iParam = 0; iParam < paramCnt; iParam++) {
         /* Print the parameter value with the format that was specified when the parameter was read, i.e. call to getIntParameter */
         if (params[iParam].accessed) {
@@ -322,140 +268,87 @@ void printParams(int paramCnt, param *params, char *outFilename) {
 int string_length(char *s)
 {
    int c = 0;
- 
+
    while(*(s+c))
       c++;
- 
+
    return c;
 }
 
 
 /*-----------------------------------------------------------------------------
  *  function used to read variables in worldfile
+ *
+ *  Same lookup as the get*Param functions, but a missing variable is not added
+ *  to the array; the default is simply returned.
  *-----------------------------------------------------------------------------*/
 
-char * getStrWorldfile(int *paramCnt, param **paramPtr, char *paramName, char *readFormat, char *defaultVal, int useDefaultVal) {
-
-    int iParam;
-    int sLen;
-    char *outStr;
-    int found = 0;
+static param * lookupWorldfile(param **paramPtr, char *paramName, char *readFormat, int useDefaultVal)
+{
     int paramInd;
+    param *p;
 
-    param *params;
-    params = *paramPtr;
-
-    /* Search for a parameter that matches the specified parameter name */
-    for (iParam = 0; iParam < *paramCnt; iParam++) {
-        if (strcmp(params[iParam].name, paramName) == 0) {
-            found = 1;
-            // Allocate an output string buffer that is the same size as the parameter value string
-            sLen = string_length(params[iParam].strVal);
-            outStr = (char *)malloc(sizeof(char) * sLen);
-            // Transform the string according to the specified format
-            sscanf(params[iParam].strVal, readFormat, outStr);
-            params[iParam].accessed = 1;
-            strcpy(params[iParam].format, readFormat);
-            break;
-        }
+    paramInd = findParam(*paramPtr, paramName);
+    if (paramInd < 0) {
+        if (!useDefaultVal)
+            printf("\nNo parameter value found for %s and 'useDefault' flag set to false\n", paramName);
+        return NULL;
     }
+    p = &(*paramPtr)[paramInd];
+    p->accessed = 1;
+    strncpy(p->format, readFormat, sizeof(p->format) - 1);
+    p->format[sizeof(p->format) - 1] = '\0';
+    return p;
+}
 
-    /* Return the requested parameter if found in the parameter list, otherwise return the default value. */
-    if (found) {
-        return outStr;
-    } else if (useDefaultVal) {
+char * getStrWorldfile(int *paramCnt, param **paramPtr, char *paramName, char *readFormat, char *defaultVal, int useDefaultVal) {
+
+    param *p;
+
+    p = lookupWorldfile(paramPtr, paramName, readFormat, useDefaultVal);
+    if (p == NULL)
         return defaultVal;
-    } else {
-        printf("\nNo parameter value found for %s and 'useDefault' flag set to false\n", paramName);
-    }
+    return p->strVal;
 }
 
 int getIntWorldfile(int *paramCnt, param **paramPtr , char *paramName, char *readFormat, int defaultVal, int useDefaultVal) {
 
-    int iParam;
-    int paramInd;
-    int sLen;
     int intVal;
-    int found = 0;
-    param *params;
-    params = *paramPtr;
-
-    for (iParam = 0; iParam < *paramCnt; iParam++) {
-        if (strcmp(params[iParam].name, paramName) == 0) {
-            found = 1;
-            // Transform the string according to the specified format
-            sscanf(params[iParam].strVal, readFormat, &intVal);
-            params[iParam].accessed = 1;
-            strcpy(params[iParam].format, readFormat);
-            break;
-        }
-    }
+    param *p;
 
-    if (found) {
-        return intVal;
-    } else if (useDefaultVal) {
+    p = lookupWorldfile(paramPtr, paramName, readFormat, useDefaultVal);
+    if (p == NULL)
         return defaultVal;
-    } else {
-        printf("\nNo parameter value found for %s and 'useDefault' flag set to false\n", paramName);
-    }
+
+    // Transform the string according to the specified format
+    sscanf(p->strVal, readFormat, &intVal);
+    return intVal;
 }
 
 float getFloatWorldfile(int *paramCnt, param **paramPtr , char *paramName, char *readFormat, float defaultVal, int useDefaultVal) {
 
-    int iParam;
-    int paramInd;
-    int sLen;
     float floatVal;
-    int found = 0;
-    param *params;
-    params = *paramPtr;
-
-    for (iParam = 0; iParam < *paramCnt; iParam++) {
-        if (strcmp(params[iParam].name, paramName) == 0) {
-            found = 1;
-            // Transform the string according to the specified format
-            sscanf(params[iParam].strVal, readFormat, &floatVal);
-            params[iParam].accessed = 1;
-            strcpy(params[iParam].format, readFormat);
-            break;
-        }
-    }
+    param *p;
 
-    if (found) {
-        return floatVal;
-    } else if (useDefaultVal) {
+    p = lookupWorldfile(paramPtr, paramName, readFormat, useDefaultVal);
+    if (p == NULL)
         return defaultVal;
-    } else {
-        printf("\nNo parameter value found for %s and 'useDefault' flag set to false\n", paramName);
-    }
+
+    // Transform the string according to the specified format
+    sscanf(p->strVal, readFormat, &floatVal);
+    return floatVal;
 }
 
 double getDoubleWorldfile(int *paramCnt, param **paramPtr, char *paramName, char *readFormat, double defaultVal, int useDefaultVal) {
 
-    int iParam;
-    int paramInd;
-    int sLen;
     double doubleVal;
-    int found = 0;
-    param *params;
-    params = *paramPtr;
-
-    for (iParam = 0; iParam < *paramCnt; iParam++) {
-        if (strcmp(params[iParam].name, paramName) == 0) {
-            found = 1;
-            // Transform the string according to the specified format
-            sscanf(params[iParam].strVal, readFormat, &doubleVal);
-            params[iParam].accessed = 1;
-            strcpy(params[iParam].format, readFormat);
-            break;
-        }
-    }
+    param *p;
 
-    if (found) {
-        return doubleVal;
-    } else if (useDefaultVal) {
+    p = lookupWorldfile(paramPtr, paramName, readFormat, useDefaultVal);
+    if (p == NULL)
         return defaultVal;
-    } else {
-        printf("\nNo parameter value found for %s and 'useDefault' flag set to false\n", paramName);
-    }
+
+    // Transform the string according to the specified format
+    sscanf(p->strVal, readFormat, &doubleVal);
+    return doubleVal;
 }
@@ -0,0 +1,121 @@
+/*--------------------------------------------------------------*/
+/* 																*/
+/*					read_clim_stream		 					*/
+/*																*/
+/*	read_clim_stream - reads the next days of a clim stream		*/
+/*																*/
+/*	NAME														*/
+/*	read_clim_stream - reads the next days of a clim stream		*/
+/*																*/
+/*	SYNOPSIS													*/
+/*	void read_clim_stream(struct clim_stream_object *stream,	*/
+/*				long window_days,								*/
+/*				long num_days)									*/
+/*																*/
+/*	OPTIONS														*/
+/*																*/
+/*	DESCRIPTION													*/
+/*																*/
+/*	Reads the values of the next num_days days of the			*/
+/*	stream into its read ahead window (buffer[1], or			*/
+/*	float_buffer for a netcdf grid); series s of a grid goes	*/
+/*	at s*window_days.  swap_clim_stream makes it current.		*/
+/*																*/
+/*	A sequence is read exactly as construct_clim_sequence		*/
+/*	fills its array: past the end of the file a clim_repeat	*/
+/*	run takes the value of the day after the first earlier		*/
+/*	day with the same month and day, otherwise it is an error.	*/
+/*	An ascii grid has a line of num_series values per day, as	*/
+/*	construct_ascii_grid reads it.  A netcdf grid is read by	*/
+/*	read_netcdf_clim_stream.									*/
+/*																*/
+/*	PROGRAMMER NOTES											*/
+/*																*/
+/*	the values repeat takes from are always among the first	*/
+/*	days (within about 4 years), which the stream keeps in		*/
+/*	head														*/
+/*	runs on the reading thread of update_clim_window, so it		*/
+/*	only touches the stream									*/
+/*--------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include "rhessys.h"
+
+void read_clim_stream(struct clim_stream_object *stream,
+					  long window_days,
+					  long num_days)
+{
+	/*--------------------------------------------------------------*/
+	/*	local function declarations.								*/
+	/*--------------------------------------------------------------*/
+	struct  date caldat(long);
+	void	read_netcdf_clim_stream(struct clim_stream_object *, long, long);
+	/*--------------------------------------------------------------*/
+	/*	local variable declarations 								*/
+	/*--------------------------------------------------------------*/
+	int	target_fnd;
+	int	s;
+	long	d, i, j;
+	double	*buffer;
+	struct	date	target_date, curr_date;
+
+	if (stream[0].type == CLIM_STREAM_NETCDF_GRID) {
+		read_netcdf_clim_stream(stream, window_days, num_days);
+		return;
+	}
+	buffer = stream[0].buffer[1];
+	if (stream[0].type == CLIM_STREAM_ASCII_GRID) {
+		for ( d=0 ; d<num_days ; d++ ){
+			for ( s=0 ; s<stream[0].num_series ; s++ ){
+				if ( fscanf(stream[0].file,"%lf",&(buffer[s*window_days+d])) != 1 ) {
+					fprintf(stderr,"FATAL ERROR: in read_clim_stream\n");
+					fprintf(stderr,"\n end date beyond end of clim sequence %s\n",
+						stream[0].filename);
+					exit(EXIT_FAILURE);
+				}
+			}
+			fscanf(stream[0].file,"%*[^\n]");
+			stream[0].next_day += 1;
+		}
+		return;
+	}
+
+	for ( d=0 ; d<num_days ; d++ ){
+		i = stream[0].next_day;
+		if ( fscanf(stream[0].file,"%lf",&(stream[0].value)) == EOF  ) {
+			if (stream[0].clim_repeat_flag == 0) {
+				fprintf(stderr,"FATAL ERROR: in read_clim_stream\n");
+				fprintf(stderr,"\n end date beyond end of clim sequence %s\n",
+					stream[0].filename);
+				exit(EXIT_FAILURE);
+			}
+			target_date = caldat(stream[0].start_date_julian + i);
+			target_fnd = 0;
+			j = 0;
+			while ((target_fnd == 0) && (j < i)) {
+				curr_date = caldat(stream[0].start_date_julian + j);
+				if ((curr_date.month == target_date.month)
+					&& (curr_date.day == target_date.day)) target_fnd=1;
+				j = j+1;
+			}
+			if (j >= i) {
+				fprintf(stderr,"FATAL ERROR: in read_clim_stream\n");
+				fprintf(stderr,"\n not enough data in base climate to repeat\n");
+				exit(EXIT_FAILURE);
+			}
+			if (j >= stream[0].num_head) {
+				fprintf(stderr,"FATAL ERROR: in read_clim_stream\n");
+				fprintf(stderr,"\n day %ld to repeat is beyond the %ld days kept of %s\n",
+					j, stream[0].num_head, stream[0].filename);
+				exit(EXIT_FAILURE);
+			}
+			buffer[d] = stream[0].head[j];
+		}
+		else
+			buffer[d] = stream[0].value;
+		if (i < stream[0].num_head)
+			stream[0].head[i] = buffer[d];
+		stream[0].next_day += 1;
+	}
+	return;
+} /*end read_clim_stream*/
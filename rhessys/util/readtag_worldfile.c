@@ -23,7 +23,6 @@
 #include "phys_constants.h"
 
 param *readtag_worldfile(int *paramCnt, FILE *file,char *key){
-    int paramInd = -1;
     int iParam;
 
     char line [1024];
@@ -61,31 +60,17 @@ param *readtag_worldfile(int *paramCnt, FILE *file,char *key){
     
     
     
-    paramPtr = (param *)malloc(sizeof(param) * (num_variables + 1));
-
     // Char array that will hold parameter names and values (as strings)
     //FILE *file;
         while ( fgets ( line, sizeof line, file ) != NULL ) /* read a line */ {
-            // Char array that will hold parameter names and values (as strings)
-            (*paramCnt)++;
-            paramInd++;
-
-            //printf("paramInd: %d\n", paramInd);
-
             /* Reset string buffers */
             strbuf1[0] = '\0';
             strbuf2[0] = '\0';
             strbuf3[0] = '\0';
-            argCnt = sscanf (line, "%s %s %s", strbuf1, strbuf2, strbuf3);
+            argCnt = sscanf (line, "%127s %127s %127s", strbuf1, strbuf2, strbuf3);
 	    //printf("argCnt=%d, strbuf1=%s, strbuf2=%s,strbuf3=%s\n",argCnt,strbuf1,strbuf2,strbuf3);
-            /* Parse the parameter value */
-
-            strcpy(paramPtr[paramInd].strVal, strbuf1);
-
-            /* Parse the parameter name */
-            strcpy(paramPtr[paramInd].name, strbuf2);
-            paramPtr[paramInd].accessed = 0;
-            paramPtr[paramInd].defaultValUsed = 0;
+            /* Store the parameter value under its name; the array grows as needed */
+            addParam(paramCnt, &paramPtr, strbuf2, strbuf1);
 	    if(strcmp(strbuf2,"n_basestations")==0){
 	      break;
 	    }
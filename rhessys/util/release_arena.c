@@ -0,0 +1,45 @@
+/*--------------------------------------------------------------*/
+/* 																*/
+/*					release_arena								*/
+/*																*/
+/*	release_arena.c - gives the world arena back				*/
+/*																*/
+/*	NAME														*/
+/*	release_arena.c - gives the world arena back				*/
+/*																*/
+/*	SYNOPSIS													*/
+/*	void release_arena( 										*/
+/*				struct arena_object *arena)						*/
+/*																*/
+/*	OPTIONS														*/
+/*																*/
+/*	DESCRIPTION													*/
+/*																*/
+/*	frees every block of every object type at once; all			*/
+/*	hillslope, zone, patch and stratum objects are gone after	*/
+/*	this call													*/
+/*																*/
+/*	PROGRAMMER NOTES											*/
+/*																*/
+/*--------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include "rhessys.h"
+
+void release_arena(struct arena_object *arena)
+{
+	int type;
+	struct arena_block_object *block, *next;
+
+	for (type = 0; type < NUM_ARENA_TYPES; type++) {
+		for (block = arena->blocks[type]; block != NULL; block = next) {
+			next = block->next;
+			free(block);
+		}
+		arena->blocks[type] = NULL;
+		arena->bytes[type] = 0;
+		arena->reserved[type] = 0;
+		arena->count[type] = 0;
+	}
+	return;
+} /*end release_arena.c*/
@@ -0,0 +1,36 @@
+/*--------------------------------------------------------------*/
+/* 																*/
+/*					reset_hillslope_queues						*/
+/*																*/
+/*	reset_hillslope_queues.c - rewinds the hillslope queues		*/
+/*																*/
+/*	NAME														*/
+/*	reset_hillslope_queues.c - rewinds the hillslope queues		*/
+/*																*/
+/*	SYNOPSIS													*/
+/*	void reset_hillslope_queues( 								*/
+/*				struct hillslope_schedule_object *schedule)		*/
+/*																*/
+/*	OPTIONS														*/
+/*																*/
+/*	DESCRIPTION													*/
+/*																*/
+/*	makes every hillslope of the schedule available again so	*/
+/*	the next hillslope loop can hand them out with				*/
+/*	next_scheduled_hillslope									*/
+/*																*/
+/*	PROGRAMMER NOTES											*/
+/*																*/
+/*	call outside of the parallel region							*/
+/*--------------------------------------------------------------*/
+#include <stdio.h>
+#include "rhessys.h"
+
+void reset_hillslope_queues(struct hillslope_schedule_object *schedule)
+{
+	int q;
+
+	for (q = 0; q < schedule->num_threads; q++)
+		schedule->queue_next[q] = schedule->queue_start[q];
+	return;
+} /*end reset_hillslope_queues.c*/
@@ -0,0 +1,339 @@
+/*--------------------------------------------------------------*/
+/* 																*/
+/*					run_ensemble								*/
+/*																*/
+/*	NAME														*/
+/*	run_ensemble - runs the members of a parameter ensemble		*/
+/*		from one world										*/
+/*																*/
+/*	SYNOPSIS													*/
+/*	void	run_ensemble(										*/
+/*					struct world_object *world,					*/
+/*					struct world_input_object *world_file,		*/
+/*					struct command_line_object *command_line)	*/
+/*																*/
+/*	OPTIONS														*/
+/*	-ensemble <file> [<n>]										*/
+/*																*/
+/*	DESCRIPTION													*/
+/*																*/
+/*	Called by construct_world once the default files and the	*/
+/*	climate of the base stations are read, and before the		*/
+/*	worldfile's basins.  The ensemble file has a line of column	*/
+/*	names, then one line of values per member:					*/
+/*																*/
+/*		s_m s_K s_soil_depth	-s multipliers					*/
+/*		sv_m sv_K				-sv								*/
+/*		svalt_pa svalt_po		-svalt							*/
+/*		vgsen_sla vgsen_shade	-vgsen (first two)				*/
+/*		gw_sat_to_gw gw_loss	-gw (needs -gw)					*/
+/*																*/
+/*	Columns not given keep the values of the command line.		*/
+/*	Each member is a fork of this process, so the defaults and	*/
+/*	climate already read are shared (copy on write) and not		*/
+/*	read again.  The member sets its values, scales the			*/
+/*	defaults (apply_default_sensitivity) and returns to build	*/
+/*	the rest of the world and run as usual, with the output		*/
+/*	prefix <prefix>_m<member>, its printed log in				*/
+/*	<prefix>_m<member>.log and state files named				*/
+/*	<worldfile>_m<member>.Y...state.  Up to n members (default	*/
+/*	the number of processors) run at once.						*/
+/*																*/
+/*	This process waits for them all and writes					*/
+/*	<prefix>_ensemble.txt - each member's values, exit status	*/
+/*	and run time, and with -objective its objective functions	*/
+/*	(see update_objective; NA for a member that failed) - then	*/
+/*	exits.														*/
+/*																*/
+/*	PROGRAMMER NOTES											*/
+/*																*/
+/*	the patch, hillslope and routing values derived from the	*/
+/*	soil parameters are built by each member from the			*/
+/*	worldfile and flow table, which it reads itself				*/
+/*	not with -restart, -climwindow or -dclim (the climate files	*/
+/*	are then read during the run, through descriptors the		*/
+/*	members would share)										*/
+/*	set OMP_NUM_THREADS so that n members times their threads	*/
+/*	fits the machine											*/
+/*--------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <sys/time.h>
+#include "rhessys.h"
+
+#define NUM_ENSEMBLE_COLUMNS 11
+
+static const char *ensemble_columns[NUM_ENSEMBLE_COLUMNS] = {
+	"s_m", "s_K", "s_soil_depth", "sv_m", "sv_K", "svalt_pa", "svalt_po",
+	"vgsen_sla", "vgsen_shade", "gw_sat_to_gw", "gw_loss"};
+
+/*--------------------------------------------------------------*/
+/*	a member's value of one column into the command line		*/
+/*--------------------------------------------------------------*/
+static void set_ensemble_value(struct command_line_object *command_line,
+							   int column, double value)
+{
+	switch (column) {
+	case 0: command_line[0].sen_flag = 1; command_line[0].sen[M] = value; break;
+	case 1: command_line[0].sen_flag = 1; command_line[0].sen[K] = value; break;
+	case 2: command_line[0].sen_flag = 1; command_line[0].sen[SOIL_DEPTH] = value; break;
+	case 3: command_line[0].vsen_flag = 1; command_line[0].vsen[M] = value; break;
+	case 4: command_line[0].vsen_flag = 1; command_line[0].vsen[K] = value; break;
+	case 5:
+	case 6:
+		if (command_line[0].vsen_alt_flag == 0) {
+			command_line[0].vsen_alt[PA] = 1.0;
+			command_line[0].vsen_alt[PO] = 1.0;
+			command_line[0].vsen_alt_flag = 1;
+		}
+		command_line[0].vsen_alt[(column == 5) ? PA : PO] = value;
+		break;
+	case 7: command_line[0].vgsen_flag = 1; command_line[0].veg_sen1 = value; break;
+	case 8: command_line[0].vgsen_flag = 1; command_line[0].veg_sen2 = value; break;
+	case 9: command_line[0].sat_to_gw_coeff_mult = value; break;
+	case 10: command_line[0].gw_loss_coeff_mult = value; break;
+	}
+}
+
+/*--------------------------------------------------------------*/
+/*	a member's objective functions (see output_objective), or	*/
+/*	NA if it failed or wrote none								*/
+/*--------------------------------------------------------------*/
+static void copy_ensemble_objective(FILE *summary, char *prefix, int member,
+									int status)
+{
+	int	j;
+	char	filename[FILEPATH_LEN+100], record[MAXSTR];
+	FILE	*file;
+
+	sprintf(filename, "%s_m%d.objective", prefix, member);
+	record[0] = '\0';
+	if ((status == 0) && ((file = fopen(filename, "r")) != NULL)) {
+		if ((fgets(record, MAXSTR, file) == NULL)
+			|| (fgets(record, MAXSTR, file) == NULL))
+			record[0] = '\0';
+		fclose(file);
+	}
+	record[strcspn(record, "\r\n")] = '\0';
+	if (record[0] != '\0')
+		fprintf(summary, " %s", record);
+	else
+		for (j=0; j<NUM_OBJECTIVE_COLUMNS; j++)
+			fprintf(summary, " NA");
+}
+
+static double seconds_now(void)
+{
+	struct timeval t;
+
+	gettimeofday(&t, NULL);
+	return(t.tv_sec + t.tv_usec / 1.0e6);
+}
+
+void	run_ensemble(
+					 struct world_object *world,
+					 struct world_input_object *world_file,
+					 struct command_line_object *command_line)
+{
+	/*--------------------------------------------------------------*/
+	/*	Local function definition.									*/
+	/*--------------------------------------------------------------*/
+	void	*alloc(size_t, char *, char *);
+	long	tell_world_input(struct world_input_object *);
+	void	reopen_world_input(struct world_input_object *, long);
+	void	apply_default_sensitivity(struct default_object *,
+		struct command_line_object *);
+
+	/*--------------------------------------------------------------*/
+	/*	Local variable definition.									*/
+	/*--------------------------------------------------------------*/
+	int	i, j, m, num_columns, num_members, num_running, num_failed;
+	int	column[NUM_ENSEMBLE_COLUMNS];
+	int	*status;
+	long	offset;
+	double	*values, *start, *seconds;
+	char	record[MAXSTR], *name;
+	char	filename[FILEPATH_LEN+100];
+	pid_t	pid, *pids;
+	FILE	*file;
+
+	if ((command_line[0].restart_flag == 1) || (command_line[0].clim_window_days > 0)
+		|| (command_line[0].dclim_flag == 1)) {
+		fprintf(stderr,"FATAL ERROR: -ensemble cannot be used with -restart, -climwindow or -dclim\n");
+		exit(EXIT_FAILURE);
+	}
+	if (command_line[0].output_prefix == NULL) {
+		fprintf(stderr,"FATAL ERROR: -ensemble needs an output prefix (-pre)\n");
+		exit(EXIT_FAILURE);
+	}
+
+	/*--------------------------------------------------------------*/
+	/*	column names, then a line of values per member				*/
+	/*--------------------------------------------------------------*/
+	if ((file = fopen(command_line[0].ensemble_filename, "r")) == NULL) {
+		fprintf(stderr,"FATAL ERROR: Cannot open ensemble file %s\n",
+			command_line[0].ensemble_filename);
+		exit(EXIT_FAILURE);
+	}
+	if (fgets(record, MAXSTR, file) == NULL) {
+		fprintf(stderr,"FATAL ERROR: ensemble file %s is empty\n",
+			command_line[0].ensemble_filename);
+		exit(EXIT_FAILURE);
+	}
+	num_columns = 0;
+	for (name = strtok(record, " \t\r\n"); name != NULL; name = strtok(NULL, " \t\r\n")) {
+		for (j=0; j<NUM_ENSEMBLE_COLUMNS; j++)
+			if (strcmp(name, ensemble_columns[j]) == 0)
+				break;
+		for (i=0; i<num_columns; i++)
+			if (column[i] == j)
+				j = NUM_ENSEMBLE_COLUMNS;
+		if (j == NUM_ENSEMBLE_COLUMNS) {
+			fprintf(stderr,"FATAL ERROR: unknown or repeated ensemble column %s in %s\n",
+				name, command_line[0].ensemble_filename);
+			exit(EXIT_FAILURE);
+		}
+		if ((j >= 9) && (command_line[0].gw_flag == 0)) {
+			fprintf(stderr,"FATAL ERROR: ensemble column %s needs -gw\n", name);
+			exit(EXIT_FAILURE);
+		}
+		column[num_columns++] = j;
+	}
+	num_members = 0;
+	values = NULL;
+	for (;;) {
+		values = (double *) realloc(values,
+			(num_members+1) * max(num_columns, 1) * sizeof(double));
+		for (j=0; j<num_columns; j++)
+			if (fscanf(file, "%lf", &(values[num_members*num_columns + j])) != 1)
+				break;
+		if (j == 0)
+			break;
+		if (j < num_columns) {
+			fprintf(stderr,"FATAL ERROR: member %d of ensemble file %s has %d of %d values\n",
+				num_members+1, command_line[0].ensemble_filename, j, num_columns);
+			exit(EXIT_FAILURE);
+		}
+		num_members++;
+	}
+	fclose(file);
+	if (num_members == 0) {
+		fprintf(stderr,"FATAL ERROR: ensemble file %s has no members\n",
+			command_line[0].ensemble_filename);
+		exit(EXIT_FAILURE);
+	}
+
+	/*--------------------------------------------------------------*/
+	/*	fork the members, up to ensemble_jobs at a time				*/
+	/*--------------------------------------------------------------*/
+	pids = (pid_t *) alloc(num_members * sizeof(pid_t), "pids", "run_ensemble");
+	status = (int *) alloc(num_members * sizeof(int), "status", "run_ensemble");
+	start = (double *) alloc(num_members * sizeof(double), "start", "run_ensemble");
+	seconds = (double *) alloc(num_members * sizeof(double), "seconds", "run_ensemble");
+	offset = tell_world_input(world_file);
+	printf("\nRunning %d ensemble members, %d at a time\n", num_members,
+		command_line[0].ensemble_jobs);
+	fflush(stdout);
+	fflush(stderr);
+
+	num_running = 0;
+	for (m=0; m<=num_members; m++) {
+		/*--------------------------------------------------------------*/
+		/*	wait for a member when all slots are taken (or at the end)	*/
+		/*--------------------------------------------------------------*/
+		while ((num_running > 0)
+			&& ((num_running >= command_line[0].ensemble_jobs) || (m == num_members))) {
+			pid = wait(&i);
+			for (j=0; j<m; j++)
+				if (pids[j] == pid)
+					break;
+			if (j == m)
+				continue;
+			status[j] = WIFEXITED(i) ? WEXITSTATUS(i) : -1;
+			seconds[j] = seconds_now() - start[j];
+			num_running--;
+		}
+		if (m == num_members)
+			break;
+
+		/*--------------------------------------------------------------*/
+		/*	no objective file of an earlier run is taken for this one	*/
+		/*--------------------------------------------------------------*/
+		if (command_line[0].objective_flag == 1) {
+			sprintf(filename, "%s_m%d.objective",
+				command_line[0].output_prefix, m+1);
+			unlink(filename);
+		}
+		start[m] = seconds_now();
+		if ((pid = fork()) < 0) {
+			fprintf(stderr,"FATAL ERROR: Cannot start ensemble member %d\n", m+1);
+			exit(EXIT_FAILURE);
+		}
+		if (pid > 0) {
+			pids[m] = pid;
+			num_running++;
+			continue;
+		}
+
+		/*--------------------------------------------------------------*/
+		/*	the member: its values, prefix and log, then the world		*/
+		/*--------------------------------------------------------------*/
+		for (j=0; j<num_columns; j++)
+			set_ensemble_value(command_line, column[j], values[m*num_columns + j]);
+		command_line[0].ensemble_member = m+1;
+		name = (char *) alloc(strlen(command_line[0].output_prefix) + 16,
+			"output_prefix", "run_ensemble");
+		sprintf(name, "%s_m%d", command_line[0].output_prefix, m+1);
+		command_line[0].output_prefix = name;
+		sprintf(filename, "%s.log", name);
+		if (freopen(filename, "w", stdout) == NULL) {
+			fprintf(stderr,"FATAL ERROR: Cannot open %s\n", filename);
+			exit(EXIT_FAILURE);
+		}
+		free(pids);
+		free(status);
+		free(start);
+		free(seconds);
+		free(values);
+		reopen_world_input(world_file, offset);
+		apply_default_sensitivity(world[0].defaults, command_line);
+		return;
+	}
+
+	/*--------------------------------------------------------------*/
+	/*	the summary of the members									*/
+	/*--------------------------------------------------------------*/
+	sprintf(filename, "%s_ensemble.txt", command_line[0].output_prefix);
+	if ((file = fopen(filename, "w")) == NULL) {
+		fprintf(stderr,"FATAL ERROR: Cannot open %s\n", filename);
+		exit(EXIT_FAILURE);
+	}
+	fprintf(file, "member");
+	for (j=0; j<num_columns; j++)
+		fprintf(file, " %s", ensemble_columns[column[j]]);
+	fprintf(file, " status seconds");
+	if (command_line[0].objective_flag == 1)
+		fprintf(file, " %s", OBJECTIVE_COLUMNS);
+	fprintf(file, "\n");
+	num_failed = 0;
+	for (m=0; m<num_members; m++) {
+		fprintf(file, "%d", m+1);
+		for (j=0; j<num_columns; j++)
+			fprintf(file, " %g", values[m*num_columns + j]);
+		fprintf(file, " %d %.2f", status[m], seconds[m]);
+		if (command_line[0].objective_flag == 1)
+			copy_ensemble_objective(file, command_line[0].output_prefix, m+1,
+				status[m]);
+		fprintf(file, "\n");
+		if (status[m] != 0)
+			num_failed++;
+	}
+	fclose(file);
+	printf("\nEnsemble finished: %d of %d members ran to the end (see %s_ensemble.txt)\n",
+		num_members - num_failed, num_members, command_line[0].output_prefix);
+	exit((num_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE);
+} /*end run_ensemble*/
@@ -0,0 +1,70 @@
+/*--------------------------------------------------------------*/
+/* 																*/
+/*					swap_clim_stream		 					*/
+/*																*/
+/*	swap_clim_stream - makes the window read ahead current		*/
+/*																*/
+/*	NAME														*/
+/*	swap_clim_stream - makes the window read ahead current		*/
+/*																*/
+/*	SYNOPSIS													*/
+/*	void swap_clim_stream(struct clim_stream_object *stream,	*/
+/*				long window_days,								*/
+/*				long window_start)								*/
+/*																*/
+/*	OPTIONS														*/
+/*	window_start - simulation day of element 0 of the window	*/
+/*																*/
+/*	DESCRIPTION													*/
+/*																*/
+/*	The window read_clim_stream read becomes the current one:	*/
+/*	the two buffers are swapped or, for a netcdf grid, the		*/
+/*	float window is converted into buffer[0] (K to C above		*/
+/*	kelvin_above, then times multiplier) as					*/
+/*	construct_netcdf_grid_clim converts the whole run.  Each	*/
+/*	series' daily_clim pointer is set to its part of buffer[0]	*/
+/*	and its window_start to window_start.						*/
+/*																*/
+/*	PROGRAMMER NOTES											*/
+/*																*/
+/*	called by the simulation thread only, when the reading		*/
+/*	thread is not filling the stream							*/
+/*--------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include "rhessys.h"
+
+void swap_clim_stream(struct clim_stream_object *stream,
+					  long window_days,
+					  long window_start)
+{
+	/*--------------------------------------------------------------*/
+	/*	local variable declarations 								*/
+	/*--------------------------------------------------------------*/
+	int	s;
+	long	d;
+	double	value;
+	double	*swap;
+
+	if (stream[0].type == CLIM_STREAM_NETCDF_GRID) {
+		#pragma omp parallel for private(d, value)
+		for (s = 0; s < stream[0].num_series; s++) {
+			for (d = 0; d < window_days; d++) {
+				value = (double)stream[0].float_buffer[s*window_days+d];
+				if (value > stream[0].kelvin_above)
+					value -= 273.15;
+				stream[0].buffer[0][s*window_days+d] = value * stream[0].multiplier;
+			}
+		}
+	}
+	else {
+		swap = stream[0].buffer[0];
+		stream[0].buffer[0] = stream[0].buffer[1];
+		stream[0].buffer[1] = swap;
+	}
+	for (s = 0; s < stream[0].num_series; s++) {
+		*(stream[0].series[s]) = stream[0].buffer[0] + s*window_days;
+		stream[0].daily_clim[s][0].window_start = window_start;
+	}
+	return;
+} /*end swap_clim_stream*/
@@ -0,0 +1,155 @@
+/*--------------------------------------------------------------*/
+/* 								*/
+/*		update_base_station_index			*/
+/*								*/
+/*	NAME							*/
+/*	update_base_station_index - enters new base stations	*/
+/*		in the base station index			*/
+/*								*/
+/*	SYNOPSIS						*/
+/*	void update_base_station_index(				*/
+/*			struct base_station_index_object *,	*/
+/*			int num_base_stations,			*/
+/*			struct base_station_object **)		*/
+/*	int base_station_index_cell(				*/
+/*			struct base_station_index_object *,	*/
+/*			double x, double y, double cell,	*/
+/*			int dx, int dy)				*/
+/*	int base_station_index_id(				*/
+/*			struct base_station_index_object *,	*/
+/*			int ID)					*/
+/*								*/
+/*	OPTIONS							*/
+/*								*/
+/*	DESCRIPTION						*/
+/*								*/
+/*	Enters base_stations[index->num_stations] to		*/
+/*	base_stations[num_base_stations-1] in the index (see	*/
+/*	construct_base_station_index).  When the index is full	*/
+/*	its tables are doubled and all stations entered again.	*/
+/*								*/
+/*	base_station_index_cell returns the grid bucket of the	*/
+/*	cell dx, dy cells away from the one holding (x, y);	*/
+/*	base_station_index_id the first ID table slot to probe	*/
+/*	for ID.							*/
+/*								*/
+/*	PROGRAMMER NOTES					*/
+/*								*/
+/*	only the first station with a given ID is in the ID	*/
+/*	table, the one a scan of base_stations finds		*/
+/*--------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdint.h>
+#include <math.h>
+#include "rhessys.h"
+
+int base_station_index_cell(
+			struct base_station_index_object *index,
+			double x,
+			double y,
+			double cell,
+			int dx,
+			int dy)
+{
+	uint64_t h;
+
+	h = (uint64_t)((int64_t) floor(x / cell) + dx) * 0x9E3779B97F4A7C15ULL;
+	h ^= (uint64_t)((int64_t) floor(y / cell) + dy) * 0xC2B2AE3D27D4EB4FULL;
+	h ^= h >> 29;
+	return((int)(h & (uint64_t)(index[0].grid_size - 1)));
+}
+
+int base_station_index_id(struct base_station_index_object *index,
+			  int ID)
+{
+	uint64_t h;
+
+	h = (uint64_t)(uint32_t) ID * 0x9E3779B97F4A7C15ULL;
+	h ^= h >> 29;
+	return((int)(h & (uint64_t)(index[0].id_size - 1)));
+}
+
+void update_base_station_index(
+			struct base_station_index_object *index,
+			int num_base_stations,
+			struct base_station_object **base_stations)
+{
+	/*--------------------------------------------------------------*/
+	/*	Local function definition.				*/
+	/*--------------------------------------------------------------*/
+	void	*alloc(size_t, char *, char *);
+
+	/*--------------------------------------------------------------*/
+	/*	Local variable definition.				*/
+	/*--------------------------------------------------------------*/
+	int	i, b, fnd;
+	struct	base_station_object *station;
+
+	if (num_base_stations <= index[0].num_stations)
+		return;
+
+	/*--------------------------------------------------------------*/
+	/*	grow the tables and enter all stations again		*/
+	/*--------------------------------------------------------------*/
+	if (num_base_stations > index[0].capacity) {
+		free(index[0].id_slot);
+		free(index[0].meter_bucket);
+		free(index[0].meter_next);
+		free(index[0].dd_bucket);
+		free(index[0].dd_next);
+		index[0].capacity = max(max(2 * index[0].capacity, num_base_stations), 16);
+		index[0].id_size = 16;
+		while (index[0].id_size < 2 * index[0].capacity)
+			index[0].id_size *= 2;
+		index[0].grid_size = index[0].id_size;
+		index[0].id_slot = (int *) alloc(index[0].id_size * sizeof(int),
+			"id_slot", "update_base_station_index");
+		index[0].meter_bucket = (int *) alloc(index[0].grid_size * sizeof(int),
+			"meter_bucket", "update_base_station_index");
+		index[0].dd_bucket = (int *) alloc(index[0].grid_size * sizeof(int),
+			"dd_bucket", "update_base_station_index");
+		index[0].meter_next = (int *) alloc(index[0].capacity * sizeof(int),
+			"meter_next", "update_base_station_index");
+		index[0].dd_next = (int *) alloc(index[0].capacity * sizeof(int),
+			"dd_next", "update_base_station_index");
+		for (b = 0; b < index[0].id_size; b++)
+			index[0].id_slot[b] = -1;
+		for (b = 0; b < index[0].grid_size; b++) {
+			index[0].meter_bucket[b] = -1;
+			index[0].dd_bucket[b] = -1;
+		}
+		index[0].num_stations = 0;
+	}
+
+	for (i = index[0].num_stations; i < num_base_stations; i++) {
+		station = base_stations[i];
+		/*--------------------------------------------------------------*/
+		/*	ID, unless an earlier station has it			*/
+		/*--------------------------------------------------------------*/
+		b = base_station_index_id(index, station[0].ID);
+		fnd = 0;
+		while ((fnd == 0) && (index[0].id_slot[b] >= 0)) {
+			if (base_stations[index[0].id_slot[b]][0].ID == station[0].ID)
+				fnd = 1;
+			else
+				b = (b + 1) & (index[0].id_size - 1);
+		}
+		if (fnd == 0)
+			index[0].id_slot[b] = i;
+		/*--------------------------------------------------------------*/
+		/*	locations						*/
+		/*--------------------------------------------------------------*/
+		b = base_station_index_cell(index, station[0].proj_x,
+			station[0].proj_y, index[0].cell_meter, 0, 0);
+		index[0].meter_next[i] = index[0].meter_bucket[b];
+		index[0].meter_bucket[b] = i;
+#ifdef LIU_NETCDF_READER
+		b = base_station_index_cell(index, station[0].lon,
+			station[0].lat, index[0].cell_dd, 0, 0);
+		index[0].dd_next[i] = index[0].dd_bucket[b];
+		index[0].dd_bucket[b] = i;
+#endif
+	}
+	index[0].num_stations = num_base_stations;
+	return;
+} /*end update_base_station_index*/
@@ -0,0 +1,139 @@
+/*--------------------------------------------------------------*/
+/* 																*/
+/*					update_clim_window		 					*/
+/*																*/
+/*	update_clim_window - moves streamed daily climate forward	*/
+/*																*/
+/*	NAME														*/
+/*	update_clim_window - moves streamed daily climate forward	*/
+/*																*/
+/*	SYNOPSIS													*/
+/*	void update_clim_window(struct clim_window_object *,		*/
+/*				long day)										*/
+/*																*/
+/*	OPTIONS														*/
+/*	day - simulation day about to be run (0 = start date)		*/
+/*																*/
+/*	DESCRIPTION													*/
+/*																*/
+/*	Called at the start of every simulation day.  When day		*/
+/*	leaves the current window, the window read ahead becomes	*/
+/*	the current one (swap_clim_stream): each stream points its	*/
+/*	daily_clim sequences at it and sets their window_start, so	*/
+/*	that zone_daily_I finds day at element day - window_start.	*/
+/*	The reading thread is then asked for the window after it.	*/
+/*																*/
+/*	The first call starts the reading thread, which reads one	*/
+/*	window of every stream each time it is asked.				*/
+/*																*/
+/*	PROGRAMMER NOTES											*/
+/*																*/
+/*	the simulation only waits when the thread has not finished	*/
+/*	the next window yet; that time is kept in wait_seconds		*/
+/*	day must not go backwards									*/
+/*--------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <omp.h>
+#include "rhessys.h"
+
+/*--------------------------------------------------------------*/
+/*	reading thread: fills buffer[1] of every stream			*/
+/*--------------------------------------------------------------*/
+static void *fill_clim_window(void *arg)
+{
+	void	read_clim_stream(struct clim_stream_object *, long, long);
+
+	long	fill_start;
+	struct	clim_window_object	*clim_window;
+	struct	clim_stream_object	*stream;
+
+	clim_window = (struct clim_window_object *) arg;
+	while (1) {
+		pthread_mutex_lock(&(clim_window[0].mutex));
+		while ((clim_window[0].fill_requested == 0) && (clim_window[0].quit == 0))
+			pthread_cond_wait(&(clim_window[0].cond), &(clim_window[0].mutex));
+		if (clim_window[0].fill_requested == 0) {
+			pthread_mutex_unlock(&(clim_window[0].mutex));
+			break;
+		}
+		clim_window[0].fill_requested = 0;
+		fill_start = clim_window[0].fill_start;
+		pthread_mutex_unlock(&(clim_window[0].mutex));
+
+		for (stream = clim_window[0].streams; stream != NULL; stream = stream[0].next)
+			read_clim_stream(stream, clim_window[0].window_days,
+				min(clim_window[0].window_days, clim_window[0].duration - fill_start));
+
+		pthread_mutex_lock(&(clim_window[0].mutex));
+		clim_window[0].fill_done = 1;
+		pthread_cond_broadcast(&(clim_window[0].cond));
+		pthread_mutex_unlock(&(clim_window[0].mutex));
+	}
+	return(NULL);
+}
+
+/*--------------------------------------------------------------*/
+/*	ask the reading thread for the window starting at start	*/
+/*--------------------------------------------------------------*/
+static void request_clim_window(struct clim_window_object *clim_window,
+								long start)
+{
+	if (start >= clim_window[0].duration)
+		return;
+	pthread_mutex_lock(&(clim_window[0].mutex));
+	clim_window[0].fill_start = start;
+	clim_window[0].fill_done = 0;
+	clim_window[0].fill_requested = 1;
+	pthread_cond_broadcast(&(clim_window[0].cond));
+	pthread_mutex_unlock(&(clim_window[0].mutex));
+}
+
+void update_clim_window(struct clim_window_object *clim_window,
+						long day)
+{
+	/*--------------------------------------------------------------*/
+	/*	local function declarations.								*/
+	/*--------------------------------------------------------------*/
+	void	swap_clim_stream(struct clim_stream_object *, long, long);
+	/*--------------------------------------------------------------*/
+	/*	local variable declarations 								*/
+	/*--------------------------------------------------------------*/
+	double	wait_start;
+	struct	clim_stream_object	*stream;
+
+	if ((clim_window == NULL) || (clim_window[0].streams == NULL))
+		return;
+
+	if (clim_window[0].thread_started == 0) {
+		if (pthread_create(&(clim_window[0].thread), NULL,
+			fill_clim_window, clim_window) != 0) {
+			fprintf(stderr,
+				"FATAL ERROR: in update_clim_window, cannot start the climate reading thread\n");
+			exit(EXIT_FAILURE);
+		}
+		clim_window[0].thread_started = 1;
+		request_clim_window(clim_window, clim_window[0].window_days);
+	}
+
+	if (day < clim_window[0].window_start + clim_window[0].window_days)
+		return;
+
+	/*--------------------------------------------------------------*/
+	/*	wait for the window read ahead and make it current			*/
+	/*--------------------------------------------------------------*/
+	wait_start = omp_get_wtime();
+	pthread_mutex_lock(&(clim_window[0].mutex));
+	while (clim_window[0].fill_done == 0)
+		pthread_cond_wait(&(clim_window[0].cond), &(clim_window[0].mutex));
+	pthread_mutex_unlock(&(clim_window[0].mutex));
+	clim_window[0].wait_seconds += omp_get_wtime() - wait_start;
+
+	clim_window[0].window_start += clim_window[0].window_days;
+	for (stream = clim_window[0].streams; stream != NULL; stream = stream[0].next)
+		swap_clim_stream(stream, clim_window[0].window_days,
+			clim_window[0].window_start);
+	request_clim_window(clim_window,
+		clim_window[0].window_start + clim_window[0].window_days);
+	return;
+} /*end update_clim_window*/
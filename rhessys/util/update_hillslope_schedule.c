@@ -0,0 +1,164 @@
+/*--------------------------------------------------------------*/
+/* 																*/
+/*					update_hillslope_schedule					*/
+/*																*/
+/*	update_hillslope_schedule.c - rebuilds hillslope queues		*/
+/*																*/
+/*	NAME														*/
+/*	update_hillslope_schedule.c - rebuilds hillslope queues		*/
+/*																*/
+/*	SYNOPSIS													*/
+/*	void update_hillslope_schedule( 							*/
+/*				struct hillslope_schedule_object *schedule)		*/
+/*																*/
+/*	OPTIONS														*/
+/*																*/
+/*	DESCRIPTION													*/
+/*																*/
+/*	Called at the start of each day.  The cost of a hillslope	*/
+/*	is the wall time it took over all hillslope loops of the	*/
+/*	previous day; hillslopes that have not been timed yet are	*/
+/*	costed by their patch and strata count, scaled to seconds	*/
+/*	with the timed ones.  The hillslopes are then split into	*/
+/*	one queue per thread:										*/
+/*																*/
+/*		static	- equal sized blocks in hillslope order (same	*/
+/*			  split as omp parallel for schedule(static))		*/
+/*		cost, steal - longest processing time first: hillslopes	*/
+/*			  by decreasing cost go to the queue with the		*/
+/*			  smallest total cost								*/
+/*																*/
+/*	Each queue keeps its hillslopes in decreasing cost so a		*/
+/*	thread that steals (see next_scheduled_hillslope) takes		*/
+/*	the largest remaining piece of work.						*/
+/*																*/
+/*	PROGRAMMER NOTES											*/
+/*																*/
+/*	ties are broken by hillslope index so the split does not	*/
+/*	depend on qsort													*/
+/*--------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include "rhessys.h"
+
+struct	hillslope_cost_object
+	{
+	double	cost;
+	int	h;
+	};
+
+static int compare_hillslope_cost(const void *a, const void *b)
+{
+	const struct hillslope_cost_object *ca = a;
+	const struct hillslope_cost_object *cb = b;
+	if (ca->cost > cb->cost) return(-1);
+	if (ca->cost < cb->cost) return(1);
+	return(ca->h - cb->h);
+}
+
+void update_hillslope_schedule(struct hillslope_schedule_object *schedule)
+{
+	/*--------------------------------------------------------------*/
+	/*	Local function definition.									*/
+	/*--------------------------------------------------------------*/
+	void *alloc(size_t, char *, char *);
+
+	/*--------------------------------------------------------------*/
+	/*	Local variable definition.									*/
+	/*--------------------------------------------------------------*/
+	int h, i, q, block, num_hillslopes, num_queues;
+	double time, timed_units, scale;
+	struct hillslope_cost_object *sorted;
+
+	num_hillslopes = schedule->num_hillslopes;
+	num_queues = schedule->num_threads;
+
+	/*--------------------------------------------------------------*/
+	/*	cost of each hillslope; measured time if available	*/
+	/*--------------------------------------------------------------*/
+	time = 0.0;
+	timed_units = 0.0;
+	for (h = 0; h < num_hillslopes; h++) {
+		if (schedule->wall_time[h] > 0.0) {
+			time += schedule->wall_time[h];
+			timed_units += schedule->units[h];
+		}
+	}
+	if ((time > 0.0) && (timed_units > 0.0)) {
+		scale = time / timed_units;
+		schedule->num_days++;
+	}
+	else
+		scale = 1.0;
+	for (h = 0; h < num_hillslopes; h++) {
+		if (schedule->wall_time[h] > 0.0)
+			schedule->cost[h] = schedule->wall_time[h];
+		else
+			schedule->cost[h] = schedule->units[h] * scale;
+		schedule->wall_time[h] = 0.0;
+	}
+
+	/*--------------------------------------------------------------*/
+	/*	order in which hillslopes are handed to the queues	*/
+	/*--------------------------------------------------------------*/
+	sorted = (struct hillslope_cost_object *)alloc(max(num_hillslopes, 1) *
+		sizeof(struct hillslope_cost_object), "sorted", "update_hillslope_schedule");
+	for (h = 0; h < num_hillslopes; h++) {
+		sorted[h].cost = schedule->cost[h];
+		sorted[h].h = h;
+	}
+	if (schedule->mode != HILLSLOPE_SCHEDULE_STATIC)
+		qsort(sorted, num_hillslopes, sizeof(struct hillslope_cost_object),
+			compare_hillslope_cost);
+
+	/*--------------------------------------------------------------*/
+	/*	assign hillslopes to queues					*/
+	/*--------------------------------------------------------------*/
+	for (q = 0; q < num_queues; q++) {
+		schedule->queue_cost[q] = 0.0;
+		schedule->queue_start[q] = 0;
+	}
+	block = 0;
+	q = 0;
+	for (i = 0; i < num_hillslopes; i++) {
+		h = sorted[i].h;
+		if (schedule->mode == HILLSLOPE_SCHEDULE_STATIC) {
+			while (block == num_hillslopes / num_queues
+				+ ((q < num_hillslopes % num_queues) ? 1 : 0)) {
+				q++;
+				block = 0;
+			}
+			block++;
+		}
+		else {
+			q = 0;
+			for (block = 1; block < num_queues; block++)
+				if (schedule->queue_cost[block] < schedule->queue_cost[q])
+					q = block;
+		}
+		schedule->queue_of[h] = q;
+		schedule->queue_cost[q] += schedule->cost[h];
+		schedule->queue_start[q]++;
+	}
+
+	/*--------------------------------------------------------------*/
+	/*	counts to offsets, then fill the queues			*/
+	/*--------------------------------------------------------------*/
+	for (q = num_queues; q > 0; q--)
+		schedule->queue_start[q] = schedule->queue_start[q-1];
+	schedule->queue_start[0] = 0;
+	for (q = 0; q < num_queues; q++) {
+		schedule->queue_start[q+1] += schedule->queue_start[q];
+		schedule->queue_next[q] = schedule->queue_start[q];
+	}
+	for (i = 0; i < num_hillslopes; i++) {
+		h = sorted[i].h;
+		q = schedule->queue_of[h];
+		schedule->order[schedule->queue_next[q]++] = h;
+	}
+	for (q = 0; q < num_queues; q++)
+		schedule->queue_next[q] = schedule->queue_start[q];
+
+	free(sorted);
+	return;
+} /*end update_hillslope_schedule.c*/
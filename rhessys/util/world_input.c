@@ -0,0 +1,224 @@
+/*--------------------------------------------------------------*/
+/*                                                              */
+/*		world_input						*/
+/*                                                              */
+/*  NAME                                                        */
+/*		world_input - reads text or binary worldfiles	*/
+/*                                                              */
+/*  SYNOPSIS                                                    */
+/*  struct world_input_object *open_world_input(char *filename)	*/
+/*  int read_world_int(struct world_input_object *world_file)	*/
+/*  double read_world_double(struct world_input_object *)	*/
+/*  void close_world_input(struct world_input_object *)		*/
+/*  long tell_world_input(struct world_input_object *)		*/
+/*  void reopen_world_input(struct world_input_object *, long)	*/
+/*                                                              */
+/*  OPTIONS                                                     */
+/*                                                              */
+/*  DESCRIPTION                                                 */
+/*                                                              */
+/*  open_world_input looks at the first bytes of the worldfile:	*/
+/*  a binary worldfile (WORLDFILE_MAGIC, see rhessys.h) is	*/
+/*  memory mapped, anything else is opened as a text worldfile.	*/
+/*  Returns NULL if the file cannot be opened.			*/
+/*                                                              */
+/*  read_world_int and read_world_double return the value of	*/
+/*  the next worldfile line and skip its label, i.e. they	*/
+/*  replace							*/
+/*	fscanf(world_file,"%d",&(x));				*/
+/*	read_record(world_file, record);			*/
+/*  For a binary worldfile the value is taken from the next	*/
+/*  record without any parsing.					*/
+/*                                                              */
+/*  PROGRAMMER NOTES                                            */
+/*                                                              */
+/*  records are read strictly in order - the binary file holds	*/
+/*  the text lines as they were, so the construct_* routines	*/
+/*  do not know which format they read				*/
+/*  a forked process (-ensemble) shares the offset of the text	*/
+/*  worldfile with its parent and siblings: the parent takes	*/
+/*  tell_world_input before forking and each child goes on	*/
+/*  from there with reopen_world_input (a binary worldfile is	*/
+/*  mapped, each process has its own next record)		*/
+/*  the text header of a legacy worldfile is still read from	*/
+/*  world_file[0].file, which is why binary worldfiles need a	*/
+/*  separate header (.hdr or -whdr)				*/
+/*                                                              */
+/*--------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "rhessys.h"
+
+struct world_input_object *open_world_input(char *filename)
+{
+	/*------------------------------------------------------*/
+	/*	Local Function Declarations.			*/
+	/*------------------------------------------------------*/
+	void	*alloc(size_t, char *, char *);
+
+	/*------------------------------------------------------*/
+	/*	Local Variable Definition. 			*/
+	/*------------------------------------------------------*/
+	int	fd;
+	char	magic[8];
+	struct	stat	status;
+	struct	worldfile_header_object *header;
+	struct	world_input_object *world_file;
+
+	fd = open(filename, O_RDONLY);
+	if (fd < 0)
+		return(NULL);
+
+	world_file = (struct world_input_object *) alloc(
+		sizeof(struct world_input_object), "world_file", "open_world_input");
+	strncpy(world_file[0].filename, filename, FILEPATH_LEN-1);
+
+	/*------------------------------------------------------*/
+	/*	text worldfile					*/
+	/*------------------------------------------------------*/
+	if ((read(fd, magic, 8) != 8) || (memcmp(magic, WORLDFILE_MAGIC, 8) != 0)) {
+		close(fd);
+		if ((world_file[0].file = fopen(filename, "r")) == NULL) {
+			free(world_file);
+			return(NULL);
+		}
+		return(world_file);
+	}
+
+	/*------------------------------------------------------*/
+	/*	binary worldfile				*/
+	/*------------------------------------------------------*/
+	fstat(fd, &status);
+	world_file[0].image_size = (size_t) status.st_size;
+	world_file[0].image = mmap(NULL, world_file[0].image_size, PROT_READ,
+		MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (world_file[0].image == MAP_FAILED) {
+		fprintf(stderr,"FATAL ERROR: Cannot map binary world file %s\n",
+			filename);
+		exit(EXIT_FAILURE);
+	}
+	header = (struct worldfile_header_object *) world_file[0].image;
+	if ((header[0].version != WORLDFILE_VERSION)
+		|| (header[0].record_size != sizeof(struct worldfile_record_object))) {
+		fprintf(stderr,
+			"FATAL ERROR: binary world file %s has version %d (record size %d), expected version %d (%d) - convert it again from text with -wconvert\n",
+			filename, header[0].version, header[0].record_size,
+			WORLDFILE_VERSION, (int) sizeof(struct worldfile_record_object));
+		exit(EXIT_FAILURE);
+	}
+	if ((size_t)(header[0].strings_offset + header[0].strings_size) > world_file[0].image_size) {
+		fprintf(stderr,"FATAL ERROR: binary world file %s is truncated\n",
+			filename);
+		exit(EXIT_FAILURE);
+	}
+	world_file[0].records = (struct worldfile_record_object *)
+		((char *) world_file[0].image + sizeof(struct worldfile_header_object));
+	world_file[0].num_records = header[0].num_records;
+	world_file[0].strings = (char *) world_file[0].image + header[0].strings_offset;
+	world_file[0].next = 0;
+	return(world_file);
+}
+
+/*--------------------------------------------------------------*/
+/*	next binary record, checked for end of file		*/
+/*--------------------------------------------------------------*/
+static struct worldfile_record_object *next_world_record(
+	struct world_input_object *world_file)
+{
+	if (world_file[0].next >= world_file[0].num_records) {
+		fprintf(stderr,
+			"FATAL ERROR: unexpected end of binary world file %s after %ld records\n",
+			world_file[0].filename, (long) world_file[0].num_records);
+		exit(EXIT_FAILURE);
+	}
+	return(&(world_file[0].records[world_file[0].next++]));
+}
+
+int read_world_int(struct world_input_object *world_file)
+{
+	int	value;
+	char	record[MAXSTR];
+	struct	worldfile_record_object *r;
+
+	if (world_file[0].file != NULL) {
+		value = 0;
+		fscanf(world_file[0].file,"%d",&(value));
+		read_record(world_file[0].file, record);
+		return(value);
+	}
+	r = next_world_record(world_file);
+	if (r[0].type == WORLDFILE_INT)
+		return((int) r[0].value.i);
+	if (r[0].type == WORLDFILE_DOUBLE)
+		return((int) r[0].value.d);
+	fprintf(stderr,
+		"FATAL ERROR: record %ld (%s) of world file %s is not a number\n",
+		(long) world_file[0].next, world_file[0].strings + r[0].label,
+		world_file[0].filename);
+	exit(EXIT_FAILURE);
+}
+
+double read_world_double(struct world_input_object *world_file)
+{
+	double	value;
+	char	record[MAXSTR];
+	struct	worldfile_record_object *r;
+
+	if (world_file[0].file != NULL) {
+		value = 0.0;
+		fscanf(world_file[0].file,"%lf",&(value));
+		read_record(world_file[0].file, record);
+		return(value);
+	}
+	r = next_world_record(world_file);
+	if (r[0].type == WORLDFILE_DOUBLE)
+		return(r[0].value.d);
+	if (r[0].type == WORLDFILE_INT)
+		return((double) r[0].value.i);
+	fprintf(stderr,
+		"FATAL ERROR: record %ld (%s) of world file %s is not a number\n",
+		(long) world_file[0].next, world_file[0].strings + r[0].label,
+		world_file[0].filename);
+	exit(EXIT_FAILURE);
+}
+
+void close_world_input(struct world_input_object *world_file)
+{
+	if (world_file[0].file != NULL)
+		fclose(world_file[0].file);
+	else
+		munmap(world_file[0].image, world_file[0].image_size);
+	free(world_file);
+	return;
+}
+
+long tell_world_input(struct world_input_object *world_file)
+{
+	if (world_file[0].file != NULL)
+		return(ftell(world_file[0].file));
+	return(0);
+}
+
+void reopen_world_input(struct world_input_object *world_file, long offset)
+{
+	FILE	*file;
+
+	if (world_file[0].file == NULL)
+		return;
+	if (((file = fopen(world_file[0].filename, "r")) == NULL)
+		|| (fseek(file, offset, SEEK_SET) != 0)) {
+		fprintf(stderr,"FATAL ERROR: Cannot reopen world file %s\n",
+			world_file[0].filename);
+		exit(EXIT_FAILURE);
+	}
+	fclose(world_file[0].file);
+	world_file[0].file = file;
+	return;
+}